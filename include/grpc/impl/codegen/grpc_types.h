@@ -261,9 +261,29 @@ typedef struct {
 /** The time between the first and second connection attempts, in ms */
 #define GRPC_ARG_INITIAL_RECONNECT_BACKOFF_MS \
   "grpc.initial_reconnect_backoff_ms"
+/** Maximum number of connections a subchannel may open to its address.
+    When more than 1, the subchannel opens another connection whenever every
+    existing one is at the peer's MAX_CONCURRENT_STREAMS limit, and spreads
+    new calls across its connections by number of calls in flight.
+    Int valued, defaults to 1. */
+#define GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL \
+  "grpc.max_connections_per_subchannel"
+/** Time after which a subchannel closes an additional connection (see
+    GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL) that carried no calls, in ms.
+    Defaults to 30 seconds. */
+#define GRPC_ARG_EXTRA_CONNECTION_IDLE_TIMEOUT_MS \
+  "grpc.extra_connection_idle_timeout_ms"
 /** Minimum amount of time between DNS resolutions, in ms */
 #define GRPC_ARG_DNS_MIN_TIME_BETWEEN_RESOLUTIONS_MS \
   "grpc.dns_min_time_between_resolutions_ms"
+/** How long, in ms, a DNS resolution result is shared through the
+    process-wide DNS cache with other channels that resolve the same name.
+    Defaults to 0, which disables the cache. */
+#define GRPC_ARG_DNS_CACHE_TTL_MS "grpc.dns_cache_ttl_ms"
+/** How long, in ms, after GRPC_ARG_DNS_CACHE_TTL_MS expires that a cached
+    DNS result may still be used while the channel that found it stale
+    refreshes it.  Defaults to the TTL. */
+#define GRPC_ARG_DNS_CACHE_MAX_STALE_MS "grpc.dns_cache_max_stale_ms"
 /** The timeout used on servers for finishing handshaking on an incoming
     connection.  Defaults to 120 seconds. */
 #define GRPC_ARG_SERVER_HANDSHAKE_TIMEOUT_MS "grpc.server_handshake_timeout_ms"
@@ -287,6 +307,26 @@ typedef struct {
  *        can break old binaries that don't support larger than 1MiB frame
  *        size. */
 #define GRPC_ARG_TSI_MAX_FRAME_SIZE "grpc.tsi.max_frame_size"
+/** EXPERIMENTAL. If non-zero, once a TLS handshake completes, try to hand
+ *  record encryption and decryption over to the kernel (Linux kTLS) so that the
+ *  TCP endpoint carries plaintext and no userspace frame protector is used.
+ *  This only takes effect when the TLS library, kernel, protocol version and
+ *  negotiated cipher suite support it; otherwise the connection silently keeps
+ *  using the userspace frame protector. Defaults to 0. */
+#define GRPC_ARG_TSI_KERNEL_TLS_OFFLOAD \
+  "grpc.experimental.tsi.kernel_tls_offload"
+/** EXPERIMENTAL. If non-zero, the TSI handshake steps of security handshakes,
+ *  which may verify certificates and perform private key operations, run on a
+ *  process-wide pool that runs at most one step per CPU core at a time, instead
+ *  of on the polling thread that received the handshake bytes. Handshakes that
+ *  resume a session are served first. Defaults to 0. */
+#define GRPC_ARG_TSI_HANDSHAKE_OFFLOAD "grpc.experimental.tsi.handshake_offload"
+/** EXPERIMENTAL. When GRPC_ARG_TSI_HANDSHAKE_OFFLOAD is set, the maximum number
+ *  of handshake steps that may be waiting for the pool when a new handshake
+ *  needs it. Beyond that, new handshakes fail immediately and their
+ *  connections are closed. Defaults to 1024. */
+#define GRPC_ARG_TSI_HANDSHAKE_OFFLOAD_MAX_PENDING \
+  "grpc.experimental.tsi.handshake_offload_max_pending"
 /** Maximum metadata size, in bytes. Note this limit applies to the max sum of
     all metadata key-value entries in a batch of headers. */
 #define GRPC_ARG_MAX_METADATA_SIZE "grpc.max_metadata_size"
@@ -306,6 +346,12 @@ typedef struct {
   "grpc.service_config_disable_resolution"
 /** LB policy name. */
 #define GRPC_ARG_LB_POLICY_NAME "grpc.lb_policy_name"
+/** Delay, in ms, after which pick_first starts connecting to the next
+    address while the attempts to earlier ones are still in progress, as
+    in "Happy Eyeballs" (RFC 8305).  Defaults to 250 ms.  Set it to INT_MAX
+    to try addresses strictly one at a time. */
+#define GRPC_ARG_HAPPY_EYEBALLS_CONNECTION_ATTEMPT_DELAY_MS \
+  "grpc.happy_eyeballs_connection_attempt_delay_ms"
 /** The grpc_socket_mutator instance that set the socket options. A pointer. */
 #define GRPC_ARG_SOCKET_MUTATOR "grpc.socket_mutator"
 /** The grpc_socket_factory instance to create and bind sockets. A pointer. */
@@ -320,6 +366,16 @@ typedef struct {
  * level. Disabling channelz naturally disables channel tracing. The default
  * is for channelz to be enabled. */
 #define GRPC_ARG_ENABLE_CHANNELZ "grpc.enable_channelz"
+/** Channel arg (integer) N for sampling HTTP/2 transports into channelz when
+ * channelz is enabled: one transport in every N gets its own channelz socket
+ * node, and the others get none, so they do not appear in channelz at all.
+ * The count of transports is process-wide, shared by every server and client
+ * that creates HTTP/2 transports, not kept per channel or per server.
+ * Servers that accept many short-lived connections can set this to lower the
+ * cost of channelz. Defaults to 1, which tracks every transport; 0 tracks
+ * none. */
+#define GRPC_ARG_CHANNELZ_SOCKET_SAMPLING_INTERVAL \
+  "grpc.channelz_socket_sampling_interval"
 /** If non-zero, Cronet transport will coalesce packets to fewer frames
  * when possible. */
 #define GRPC_ARG_USE_CRONET_PACKET_COALESCING \
@@ -388,21 +444,23 @@ typedef struct {
     retries are enabled when they are configured via the service config.
     For details, see:
       https://github.com/grpc/proposal/blob/master/A6-client-retries.md
-    NOTE: Hedging functionality is not yet implemented, so those
-          fields in the service config will currently be ignored.  See
-          also the GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING arg below.
+    NOTE: Hedging fields in the service config are ignored unless the
+          GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING arg below is also set.
  */
 #define GRPC_ARG_ENABLE_RETRIES "grpc.enable_retries"
 /** Enables hedging functionality, as described in:
       https://github.com/grpc/proposal/blob/master/A6-client-retries.md
-    Default is currently false, since this functionality is not yet
-    fully implemented.
+    Default is currently false, since this functionality is new.  When
+    enabled, the hedgingPolicy and the perAttemptRecvTimeout field of the
+    retryPolicy in the service config are honored.
     NOTE: This channel arg is experimental and will eventually be removed.
-          Once hedging functionality has been implemented and proves stable,
+          Once hedging functionality proves stable,
           this arg will be removed, and the hedging functionality will
           be enabled via the GRPC_ARG_ENABLE_RETRIES arg above. */
 #define GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING "grpc.experimental.enable_hedging"
-/** Per-RPC retry buffer size, in bytes. Default is 256 KiB. */
+/** Per-RPC retry buffer size, in bytes. Default is the largest allocation
+    the channel's resource quota recommends (1/16 of its size), or 256 KiB if
+    the quota has no size. */
 #define GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE "grpc.per_rpc_retry_buffer_size"
 /** Channel arg that carries the bridged objective c object for custom metrics
  * logging filter. */
@@ -454,6 +512,12 @@ typedef struct {
  * channel arg. Int valued, milliseconds. Defaults to 10 minutes.*/
 #define GRPC_ARG_SERVER_CONFIG_CHANGE_DRAIN_GRACE_TIME_MS \
   "grpc.experimental.server_config_change_drain_grace_time_ms"
+/** EXPERIMENTAL. If non-zero, a server keeps a latency histogram for each of
+ * its registered methods, from the creation of each call to its destruction.
+ * The histograms are exported alongside the core stats, for example in the
+ * core stats that the qps benchmark workers report. Defaults to 0. */
+#define GRPC_ARG_SERVER_METHOD_LATENCY_STATS \
+  "grpc.experimental.server_method_latency_stats"
 /** \} */
 
 /** Result of a grpc call. If the caller satisfies the prerequisites of a
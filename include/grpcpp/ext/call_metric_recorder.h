@@ -56,19 +56,27 @@ class CallMetricRecorder {
 
   /// Records a call metric measurement for CPU utilization.
   /// Multiple calls to this method will override the stored value.
+  /// Negative and NaN values are ignored.
   CallMetricRecorder& RecordCpuUtilizationMetric(double value);
 
   /// Records a call metric measurement for memory utilization.
   /// Multiple calls to this method will override the stored value.
+  /// Negative and NaN values are ignored.
   CallMetricRecorder& RecordMemoryUtilizationMetric(double value);
 
+  /// Records a call metric measurement for queries per second.
+  /// Multiple calls to this method will override the stored value.
+  /// The value is sent as an integer, so the fractional part is dropped.
+  /// Negative, NaN and values that do not fit in a uint64 are ignored.
+  CallMetricRecorder& RecordQpsMetric(double value);
+
   /// Records a call metric measurement for utilization.
   /// Multiple calls to this method with the same name will
-  /// override the corresponding stored value. The lifetime of the
-  /// name string needs to be longer than the lifetime of the RPC
-  /// itself, since it's going to be sent as trailers after the RPC
-  /// finishes. It is assumed the strings are common names that
-  /// are global constants.
+  /// override the corresponding stored value. Negative and NaN values
+  /// are ignored. The lifetime of the name string needs to be longer
+  /// than the lifetime of the RPC itself, since it's going to be sent
+  /// as trailers after the RPC finishes. It is assumed the strings are
+  /// common names that are global constants.
   CallMetricRecorder& RecordUtilizationMetric(string_ref name, double value);
 
   /// Records a call metric measurement for request cost.
@@ -50,6 +50,8 @@ class OrcaService : public Service {
 
   explicit OrcaService(Options options);
 
+  // Setters ignore negative and NaN values, leaving the previous value.
+
   // Sets or removes the CPU utilization value to be reported to clients.
   void SetCpuUtilization(double cpu_utilization);
   void DeleteCpuUtilization();
@@ -58,6 +60,12 @@ class OrcaService : public Service {
   void SetMemoryUtilization(double memory_utilization);
   void DeleteMemoryUtilization();
 
+  // Sets or removes the queries per second value to be reported to
+  // clients.  The value is sent as an integer; values that do not fit in
+  // a uint64 are ignored.
+  void SetQps(double qps);
+  void DeleteQps();
+
   // Sets or removed named utilization values to be reported to clients.
   void SetNamedUtilization(std::string name, double utilization);
   void DeleteNamedUtilization(const std::string& name);
@@ -73,6 +81,7 @@ class OrcaService : public Service {
   grpc::internal::Mutex mu_;
   double cpu_utilization_ ABSL_GUARDED_BY(&mu_) = -1;
   double memory_utilization_ ABSL_GUARDED_BY(&mu_) = -1;
+  double qps_ ABSL_GUARDED_BY(&mu_) = -1;
   std::map<std::string, double> named_utilization_ ABSL_GUARDED_BY(&mu_);
   absl::optional<Slice> response_slice_ ABSL_GUARDED_BY(&mu_);
 };
@@ -222,6 +222,64 @@ class ClientChannel {
     LbQueuedCall* next = nullptr;
   };
 
+  // Holds the picker used by the data plane.  The picker is replaced while
+  // holding data_plane_mu_, but picks may also read it without holding any
+  // lock, in the manner of RCU: such a reader holds a ReadLock for the
+  // duration of its pick, which counts it in one of two reader counts,
+  // selected by the current epoch.  After replacing the picker, the writer
+  // waits for the reader counts of both epochs to drop to zero, flipping the
+  // epoch before each wait so that new readers cannot delay it, and only then
+  // destroys the old picker.  Pickers are therefore always destroyed by the
+  // writer, in the control plane.
+  //
+  // Writers must be serialized by the caller.
+  class DataPlanePicker {
+   public:
+    class ReadLock {
+     public:
+      explicit ReadLock(DataPlanePicker* picker);
+      ~ReadLock();
+
+      ReadLock(const ReadLock&) = delete;
+      ReadLock& operator=(const ReadLock&) = delete;
+
+      // May be null.  Remains valid until the ReadLock is destroyed.
+      LoadBalancingPolicy::SubchannelPicker* get() const { return picker_; }
+
+     private:
+      DataPlanePicker* data_plane_picker_;
+      size_t epoch_;
+      LoadBalancingPolicy::SubchannelPicker* picker_;
+    };
+
+    DataPlanePicker() = default;
+    ~DataPlanePicker() { delete picker_.load(std::memory_order_relaxed); }
+
+    DataPlanePicker(const DataPlanePicker&) = delete;
+    DataPlanePicker& operator=(const DataPlanePicker&) = delete;
+
+    // Returns the current picker.  Callers must either hold the lock that
+    // serializes calls to Exchange() or be the writer.
+    LoadBalancingPolicy::SubchannelPicker* get() const {
+      return picker_.load(std::memory_order_relaxed);
+    }
+
+    // Replaces the picker, returning the previous one.  The previous picker
+    // must not be destroyed until WaitForReaders() has returned.
+    std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> Exchange(
+        std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker);
+
+    // Waits until all ReadLocks that may have seen a picker replaced by a
+    // previous call to Exchange() are destroyed.  Must not be called while
+    // the calling thread holds a ReadLock.
+    void WaitForReaders();
+
+   private:
+    std::atomic<LoadBalancingPolicy::SubchannelPicker*> picker_{nullptr};
+    std::atomic<size_t> epoch_{0};
+    std::atomic<size_t> readers_[2] = {{0}, {0}};
+  };
+
   ClientChannel(grpc_channel_element_args* args, grpc_error_handle* error);
   ~ClientChannel();
 
@@ -325,8 +383,9 @@ class ClientChannel {
   // Fields used in the data plane.  Guarded by data_plane_mu_.
   //
   mutable Mutex data_plane_mu_;
-  std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker_
-      ABSL_GUARDED_BY(data_plane_mu_);
+  // Replaced while holding data_plane_mu_ (and in the work_serializer), but
+  // picks may read it without the lock.
+  DataPlanePicker picker_;
   // Linked list of calls queued waiting for LB pick.
   LbQueuedCall* lb_queued_calls_ ABSL_GUARDED_BY(data_plane_mu_) = nullptr;
 
@@ -474,6 +533,12 @@ class ClientChannel::LoadBalancedCall
   void CreateSubchannelCall();
   // Invoked when a pick is completed, on both success or failure.
   static void PickDone(void* arg, grpc_error_handle error);
+  // Performs an LB pick with picker, without touching the list of queued
+  // picks.  Returns true if the pick is complete, in which case *error is
+  // set as for PickSubchannelLocked(); returns false if the call needs to
+  // wait for a new picker.
+  bool PickSubchannelImpl(LoadBalancingPolicy::SubchannelPicker* picker,
+                          grpc_error_handle* error);
   // Removes the call from the channel's list of queued picks if present.
   void MaybeRemoveCallFromLbQueuedCallsLocked()
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_);
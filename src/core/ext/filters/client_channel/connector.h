@@ -19,6 +19,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
 #include <grpc/impl/codegen/grpc_types.h>
 
 #include "src/core/lib/channel/channelz.h"
@@ -56,11 +58,14 @@ class SubchannelConnector : public InternallyRefCounted<SubchannelConnector> {
     const grpc_channel_args* channel_args = nullptr;
     // Channelz socket node of the connected transport, if any.
     RefCountedPtr<channelz::SocketNode> socket_node;
+    // Number of concurrent calls the peer allows on the transport.
+    uint32_t max_concurrent_streams = UINT32_MAX;
 
     void Reset() {
       transport = nullptr;
       channel_args = nullptr;
       socket_node.reset();
+      max_concurrent_streams = UINT32_MAX;
     }
   };
 
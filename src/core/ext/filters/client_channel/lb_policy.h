@@ -22,6 +22,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -254,9 +255,11 @@ class LoadBalancingPolicy : public InternallyRefCounted<LoadBalancingPolicy> {
   /// updates, connectivity state notifications, etc); the latter should
   /// live in the LB policy object itself.
   ///
-  /// Currently, pickers are always accessed from within the
-  /// client_channel data plane mutex, so they do not have to be
-  /// thread-safe.
+  /// Pick() may be called concurrently from any number of threads, without
+  /// any lock held, so pickers must be thread-safe.  A picker is never
+  /// destroyed while a pick is in progress, and is always destroyed in the
+  /// control plane work_serializer.  Pick() must not block on anything that
+  /// the work_serializer may hold while updating the picker.
   class SubchannelPicker {
    public:
     SubchannelPicker() = default;
@@ -400,7 +403,7 @@ class LoadBalancingPolicy : public InternallyRefCounted<LoadBalancingPolicy> {
 
    private:
     RefCountedPtr<LoadBalancingPolicy> parent_;
-    bool exit_idle_called_ = false;
+    std::atomic<bool> exit_idle_called_{false};
   };
 
   // A picker that returns PickResult::Fail for all picks.
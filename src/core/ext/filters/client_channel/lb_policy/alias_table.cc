@@ -0,0 +1,71 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/alias_table.h"
+
+#include <grpc/support/log.h>
+
+namespace grpc_core {
+
+AliasTable::AliasTable(absl::Span<const uint32_t> weights) {
+  const size_t n = weights.size();
+  GPR_ASSERT(n > 0);
+  uint64_t total = 0;
+  for (uint32_t weight : weights) total += weight;
+  GPR_ASSERT(total > 0);
+  // Work in units of total / n so that everything stays an integer: each
+  // bucket holds exactly `total` units, and index i owns weight[i] * n
+  // units overall.
+  std::vector<uint64_t> units(n);
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  for (size_t i = 0; i < n; ++i) {
+    units[i] = static_cast<uint64_t>(weights[i]) * n;
+    (units[i] < total ? small : large).push_back(static_cast<uint32_t>(i));
+  }
+  std::vector<uint64_t> kept(n, total);
+  std::vector<uint32_t> alias(n);
+  for (size_t i = 0; i < n; ++i) alias[i] = static_cast<uint32_t>(i);
+  // Fill each underfull bucket with units from an overfull index.
+  while (!small.empty() && !large.empty()) {
+    const uint32_t s = small.back();
+    small.pop_back();
+    const uint32_t l = large.back();
+    kept[s] = units[s];
+    alias[s] = l;
+    units[l] -= total - units[s];
+    if (units[l] < total) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // Any bucket left over holds exactly `total` units and keeps its own
+  // index, which is how kept and alias were initialized.
+  //
+  // Convert to thresholds out of 2^32.  Scale down first so that the shift
+  // cannot overflow; this only loses precision below 2^-32.
+  int scale = 0;
+  while ((total >> scale) >= (uint64_t(1) << 32)) ++scale;
+  buckets_.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    const uint64_t threshold = ((kept[i] >> scale) << 32) / (total >> scale);
+    buckets_.push_back({threshold, static_cast<uint32_t>(i), alias[i]});
+  }
+}
+
+}  // namespace grpc_core
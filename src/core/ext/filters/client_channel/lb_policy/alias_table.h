@@ -0,0 +1,65 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_ALIAS_TABLE_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_ALIAS_TABLE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/span.h"
+
+namespace grpc_core {
+
+// Picks an index with probability proportional to its weight in O(1),
+// using Vose's alias method.  The table is built once in O(n) and is
+// immutable afterwards, so concurrent picks need no synchronization.
+class AliasTable {
+ public:
+  // All weights must be non-negative, and at least one must be non-zero.
+  explicit AliasTable(absl::Span<const uint32_t> weights);
+
+  size_t size() const { return buckets_.size(); }
+
+  // Returns an index in [0, size()), given 64 random bits.
+  size_t Pick(uint64_t random) const {
+    // The high 32 bits choose the bucket and the low 32 bits choose
+    // between the bucket's own index and its alias.
+    const Bucket& bucket =
+        buckets_[((random >> 32) * buckets_.size()) >> 32];
+    return (random & 0xffffffffu) < bucket.threshold ? bucket.index
+                                                     : bucket.alias;
+  }
+
+ private:
+  struct Bucket {
+    // Pick index if the low 32 random bits are below threshold, alias
+    // otherwise.  A threshold of 2^32 means the bucket has no alias.
+    uint64_t threshold;
+    uint32_t index;
+    uint32_t alias;
+  };
+
+  std::vector<Bucket> buckets_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_ALIAS_TABLE_H
@@ -0,0 +1,792 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/maglev/maglev.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+
+#include <grpc/impl/codegen/connectivity_state.h>
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy/maglev/maglev_table.h"
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_factory.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/work_serializer.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_maglev_trace(false, "maglev_lb");
+
+// Helper Parser method
+void ParseMaglevLbConfig(const Json& json, uint64_t* table_size,
+                         std::vector<grpc_error_handle>* error_list) {
+  *table_size = MaglevTable::kDefaultTableSize;
+  if (json.type() != Json::Type::OBJECT) {
+    error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "maglev_experimental should be of type object"));
+    return;
+  }
+  const Json::Object& maglev = json.object_value();
+  auto it = maglev.find("table_size");
+  if (it != maglev.end()) {
+    if (it->second.type() != Json::Type::NUMBER ||
+        !absl::SimpleAtoi(it->second.string_value(), table_size)) {
+      error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:table_size error: should be of type number"));
+      return;
+    }
+  }
+  if (!MaglevTable::IsValidTableSize(*table_size)) {
+    error_list->push_back(GRPC_ERROR_CREATE_FROM_CPP_STRING(
+        absl::StrCat("field:table_size error: must be a prime number no "
+                     "larger than ",
+                     MaglevTable::kMaxTableSize)));
+  }
+}
+
+namespace {
+
+constexpr char kMaglev[] = "maglev_experimental";
+
+class MaglevLbConfig : public LoadBalancingPolicy::Config {
+ public:
+  explicit MaglevLbConfig(uint64_t table_size) : table_size_(table_size) {}
+  const char* name() const override { return kMaglev; }
+  uint64_t table_size() const { return table_size_; }
+
+ private:
+  uint64_t table_size_;
+};
+
+//
+// maglev LB policy
+//
+// Behaves like ring_hash, including the handling of subchannel connectivity
+// and the choice of a fallback when the chosen subchannel is not READY, but
+// maps request hashes to subchannels through a Maglev lookup table instead
+// of a ring.  The table has a fixed size regardless of the number and
+// weights of the endpoints, is built in time linear in its size, and is
+// indexed directly rather than binary searched.
+//
+
+class Maglev : public LoadBalancingPolicy {
+ public:
+  explicit Maglev(Args args);
+
+  const char* name() const override { return kMaglev; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  ~Maglev() override;
+
+  // Forward declarations.
+  class MaglevSubchannelList;
+  class Table;
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  class MaglevSubchannelData
+      : public SubchannelData<MaglevSubchannelList, MaglevSubchannelData> {
+   public:
+    MaglevSubchannelData(
+        SubchannelList<MaglevSubchannelList, MaglevSubchannelData>*
+            subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel)
+        : SubchannelData(subchannel_list, address, std::move(subchannel)),
+          address_(address) {}
+
+    const ServerAddress& address() const { return address_; }
+
+    grpc_connectivity_state GetConnectivityState() const {
+      return connectivity_state_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    // Performs connectivity state updates that need to be done only
+    // after we have started watching.
+    void ProcessConnectivityChangeLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state) override;
+
+    ServerAddress address_;
+
+    // Last logical connectivity state seen.
+    // Note that this may differ from the state actually reported by the
+    // subchannel in some cases; for example, once this is set to
+    // TRANSIENT_FAILURE, we do not change it again until we get READY,
+    // so we skip any interim stops in CONNECTING.
+    // Uses an atomic so that it can be accessed outside of the WorkSerializer.
+    std::atomic<grpc_connectivity_state> connectivity_state_{GRPC_CHANNEL_IDLE};
+  };
+
+  // A list of subchannels.
+  class MaglevSubchannelList
+      : public SubchannelList<MaglevSubchannelList, MaglevSubchannelData> {
+   public:
+    MaglevSubchannelList(Maglev* policy, ServerAddressList addresses,
+                         const grpc_channel_args& args)
+        : SubchannelList(policy,
+                         (GRPC_TRACE_FLAG_ENABLED(grpc_lb_maglev_trace)
+                              ? "MaglevSubchannelList"
+                              : nullptr),
+                         std::move(addresses), policy->channel_control_helper(),
+                         args),
+          num_idle_(num_subchannels()),
+          table_(MakeRefCounted<Table>(policy, Ref(DEBUG_LOCATION, "Table"))) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+    }
+
+    ~MaglevSubchannelList() override {
+      table_.reset(DEBUG_LOCATION, "~MaglevSubchannelList");
+      Maglev* p = static_cast<Maglev*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(grpc_connectivity_state old_state,
+                                   grpc_connectivity_state new_state);
+
+    // Updates the maglev policy's connectivity state based on the
+    // subchannel list's state counters, creating a new picker.
+    // The index parameter indicates the index into the list of the subchannel
+    // whose status report triggered the call to
+    // UpdateMaglevConnectivityStateLocked().
+    // connection_attempt_complete is true if the subchannel just
+    // finished a connection attempt.
+    void UpdateMaglevConnectivityStateLocked(size_t index,
+                                             bool connection_attempt_complete,
+                                             absl::Status status);
+
+   private:
+    bool AllSubchannelsSeenInitialState() {
+      for (size_t i = 0; i < num_subchannels(); ++i) {
+        if (!subchannel(i)->connectivity_state().has_value()) return false;
+      }
+      return true;
+    }
+
+    void ShutdownLocked() override {
+      table_.reset(DEBUG_LOCATION, "MaglevSubchannelList::ShutdownLocked()");
+      SubchannelList::ShutdownLocked();
+    }
+
+    size_t num_idle_;
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+
+    RefCountedPtr<Table> table_;
+
+    // The index of the subchannel currently doing an internally
+    // triggered connection attempt, if any.
+    absl::optional<size_t> internally_triggered_connection_index_;
+  };
+
+  class Table : public RefCounted<Table> {
+   public:
+    Table(Maglev* parent,
+          RefCountedPtr<MaglevSubchannelList> subchannel_list);
+
+    size_t size() const { return table_.size(); }
+    size_t Slot(uint64_t hash) const { return table_.Slot(hash); }
+
+    size_t num_subchannels() const {
+      return subchannel_list_->num_subchannels();
+    }
+    size_t num_subchannels_with_slots() const {
+      return table_.num_endpoints_with_slots();
+    }
+    size_t subchannel_index(size_t slot) const {
+      return table_.endpoint_index(slot);
+    }
+
+    MaglevSubchannelData* subchannel(size_t slot) const {
+      return subchannel_list_->subchannel(table_.endpoint_index(slot));
+    }
+
+   private:
+    static MaglevTable BuildTable(Maglev* parent,
+                                  MaglevSubchannelList* subchannel_list);
+
+    RefCountedPtr<MaglevSubchannelList> subchannel_list_;
+    MaglevTable table_;
+  };
+
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(RefCountedPtr<Maglev> parent, RefCountedPtr<Table> table)
+        : parent_(std::move(parent)), table_(std::move(table)) {}
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    // A fire-and-forget class that schedules subchannel connection attempts
+    // on the control plane WorkSerializer.
+    class SubchannelConnectionAttempter : public Orphanable {
+     public:
+      explicit SubchannelConnectionAttempter(RefCountedPtr<Maglev> maglev_lb)
+          : maglev_lb_(std::move(maglev_lb)) {
+        GRPC_CLOSURE_INIT(&closure_, RunInExecCtx, this, nullptr);
+      }
+
+      void AddSubchannel(RefCountedPtr<SubchannelInterface> subchannel) {
+        subchannels_.push_back(std::move(subchannel));
+      }
+
+      void Orphan() override {
+        // Hop into ExecCtx, so that we're not running control-plane code
+        // from within the pick.
+        ExecCtx::Run(DEBUG_LOCATION, &closure_, GRPC_ERROR_NONE);
+      }
+
+     private:
+      static void RunInExecCtx(void* arg, grpc_error_handle /*error*/) {
+        auto* self = static_cast<SubchannelConnectionAttempter*>(arg);
+        self->maglev_lb_->work_serializer()->Run(
+            [self]() {
+              if (!self->maglev_lb_->shutdown_) {
+                for (auto& subchannel : self->subchannels_) {
+                  subchannel->RequestConnection();
+                }
+              }
+              delete self;
+            },
+            DEBUG_LOCATION);
+      }
+
+      RefCountedPtr<Maglev> maglev_lb_;
+      grpc_closure closure_;
+      absl::InlinedVector<RefCountedPtr<SubchannelInterface>, 10> subchannels_;
+    };
+
+    RefCountedPtr<Maglev> parent_;
+    RefCountedPtr<Table> table_;
+  };
+
+  void ShutdownLocked() override;
+
+  // Current config from resolver.
+  RefCountedPtr<MaglevLbConfig> config_;
+
+  // list of subchannels.
+  OrphanablePtr<MaglevSubchannelList> subchannel_list_;
+  OrphanablePtr<MaglevSubchannelList> latest_pending_subchannel_list_;
+  // indicating if we are shutting down.
+  bool shutdown_ = false;
+};
+
+//
+// Maglev::Table
+//
+
+Maglev::Table::Table(Maglev* parent,
+                     RefCountedPtr<MaglevSubchannelList> subchannel_list)
+    : subchannel_list_(std::move(subchannel_list)),
+      table_(BuildTable(parent, subchannel_list_.get())) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_maglev_trace)) {
+    gpr_log(GPR_INFO,
+            "[maglev %p] created table from subchannel_list=%p "
+            "with %" PRIuPTR " slots",
+            parent, subchannel_list_.get(), table_.size());
+  }
+}
+
+MaglevTable Maglev::Table::BuildTable(Maglev* parent,
+                                      MaglevSubchannelList* subchannel_list) {
+  const size_t num_subchannels = subchannel_list->num_subchannels();
+  // The endpoint keys point into these strings, so they must stay alive
+  // until the table is built.
+  std::vector<std::string> addresses;
+  addresses.reserve(num_subchannels);
+  std::vector<MaglevTable::Endpoint> endpoints;
+  endpoints.reserve(num_subchannels);
+  for (size_t i = 0; i < num_subchannels; ++i) {
+    MaglevSubchannelData* sd = subchannel_list->subchannel(i);
+    addresses.push_back(
+        grpc_sockaddr_to_string(&sd->address().address(), false).value());
+    MaglevTable::Endpoint endpoint;
+    endpoint.key = addresses.back();
+    const ServerAddressWeightAttribute* weight_attribute = static_cast<
+        const ServerAddressWeightAttribute*>(sd->address().GetAttribute(
+        ServerAddressWeightAttribute::kServerAddressWeightAttributeKey));
+    if (weight_attribute != nullptr) {
+      GPR_ASSERT(weight_attribute->weight() != 0);
+      endpoint.weight = weight_attribute->weight();
+    }
+    endpoints.push_back(endpoint);
+  }
+  return MaglevTable(endpoints, parent->config_->table_size());
+}
+
+//
+// Maglev::Picker
+//
+
+Maglev::PickResult Maglev::Picker::Pick(PickArgs args) {
+  auto* call_state = static_cast<ClientChannel::LoadBalancedCall::LbCallState*>(
+      args.call_state);
+  auto hash = call_state->GetCallAttribute(RequestHashAttributeName());
+  uint64_t h;
+  if (!absl::SimpleAtoi(hash, &h)) {
+    return PickResult::Fail(
+        absl::InternalError("xds maglev hash value is not a number"));
+  }
+  const Table& table = *table_;
+  const size_t first_slot = table.Slot(h);
+  MaglevSubchannelData* first_subchannel = table.subchannel(first_slot);
+  OrphanablePtr<SubchannelConnectionAttempter> subchannel_connection_attempter;
+  auto ScheduleSubchannelConnectionAttempt =
+      [&](RefCountedPtr<SubchannelInterface> subchannel) {
+        if (subchannel_connection_attempter == nullptr) {
+          subchannel_connection_attempter =
+              MakeOrphanable<SubchannelConnectionAttempter>(parent_);
+        }
+        subchannel_connection_attempter->AddSubchannel(std::move(subchannel));
+      };
+  switch (first_subchannel->GetConnectivityState()) {
+    case GRPC_CHANNEL_READY:
+      return PickResult::Complete(first_subchannel->subchannel()->Ref());
+    case GRPC_CHANNEL_IDLE:
+      ScheduleSubchannelConnectionAttempt(
+          first_subchannel->subchannel()->Ref());
+      ABSL_FALLTHROUGH_INTENDED;
+    case GRPC_CHANNEL_CONNECTING:
+      return PickResult::Queue();
+    default:  // GRPC_CHANNEL_TRANSIENT_FAILURE
+      break;
+  }
+  ScheduleSubchannelConnectionAttempt(first_subchannel->subchannel()->Ref());
+  // Loop through the following slots to find a subchannel in READY, the
+  // same way ring_hash walks the ring.
+  // On the way, we make sure the right set of connection attempts
+  // will happen.
+  // Each subchannel owns many slots, so only the first slot of each one is
+  // looked at, and the loop stops once all of them have been seen instead
+  // of walking the whole table.  The set of subchannels seen is a bitset
+  // that stays inline, without allocating, for up to 256 subchannels.
+  bool found_second_subchannel = false;
+  bool found_first_non_failed = false;
+  absl::InlinedVector<uint64_t, 4> seen((table.num_subchannels() + 63) / 64);
+  auto MarkSeen = [&seen](size_t index) {
+    uint64_t& word = seen[index / 64];
+    const uint64_t bit = uint64_t{1} << (index % 64);
+    if ((word & bit) != 0) return false;
+    word |= bit;
+    return true;
+  };
+  MarkSeen(table.subchannel_index(first_slot));
+  size_t num_seen = 1;
+  for (size_t i = 1;
+       i < table.size() && num_seen < table.num_subchannels_with_slots();
+       ++i) {
+    const size_t slot = (first_slot + i) % table.size();
+    if (!MarkSeen(table.subchannel_index(slot))) continue;
+    ++num_seen;
+    MaglevSubchannelData* sd = table.subchannel(slot);
+    grpc_connectivity_state connectivity_state = sd->GetConnectivityState();
+    if (connectivity_state == GRPC_CHANNEL_READY) {
+      return PickResult::Complete(sd->subchannel()->Ref());
+    }
+    if (!found_second_subchannel) {
+      switch (connectivity_state) {
+        case GRPC_CHANNEL_IDLE:
+          ScheduleSubchannelConnectionAttempt(sd->subchannel()->Ref());
+          ABSL_FALLTHROUGH_INTENDED;
+        case GRPC_CHANNEL_CONNECTING:
+          return PickResult::Queue();
+        default:
+          break;
+      }
+      found_second_subchannel = true;
+    }
+    if (!found_first_non_failed) {
+      if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+        ScheduleSubchannelConnectionAttempt(sd->subchannel()->Ref());
+      } else {
+        if (connectivity_state == GRPC_CHANNEL_IDLE) {
+          ScheduleSubchannelConnectionAttempt(sd->subchannel()->Ref());
+        }
+        found_first_non_failed = true;
+      }
+    }
+  }
+  return PickResult::Fail(absl::UnavailableError(
+      "xds maglev found a subchannel that is in TRANSIENT_FAILURE state"));
+}
+
+//
+// Maglev::MaglevSubchannelList
+//
+
+void Maglev::MaglevSubchannelList::UpdateStateCountersLocked(
+    grpc_connectivity_state old_state, grpc_connectivity_state new_state) {
+  if (old_state == GRPC_CHANNEL_IDLE) {
+    GPR_ASSERT(num_idle_ > 0);
+    --num_idle_;
+  } else if (old_state == GRPC_CHANNEL_READY) {
+    GPR_ASSERT(num_ready_ > 0);
+    --num_ready_;
+  } else if (old_state == GRPC_CHANNEL_CONNECTING) {
+    GPR_ASSERT(num_connecting_ > 0);
+    --num_connecting_;
+  } else if (old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    GPR_ASSERT(num_transient_failure_ > 0);
+    --num_transient_failure_;
+  }
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (new_state == GRPC_CHANNEL_IDLE) {
+    ++num_idle_;
+  } else if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+void Maglev::MaglevSubchannelList::UpdateMaglevConnectivityStateLocked(
+    size_t index, bool connection_attempt_complete, absl::Status status) {
+  Maglev* p = static_cast<Maglev*>(policy());
+  // If this is latest_pending_subchannel_list_, then swap it into
+  // subchannel_list_ as soon as we get the initial connectivity state
+  // report for every subchannel in the list.
+  if (p->latest_pending_subchannel_list_.get() == this &&
+      AllSubchannelsSeenInitialState()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_maglev_trace)) {
+      gpr_log(GPR_INFO, "[maglev %p] replacing subchannel list %p with %p", p,
+              p->subchannel_list_.get(), this);
+    }
+    p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+  }
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  // The overall aggregation rules here are:
+  // 1. If there is at least one subchannel in READY state, report READY.
+  // 2. If there are 2 or more subchannels in TRANSIENT_FAILURE state, report
+  //    TRANSIENT_FAILURE.
+  // 3. If there is at least one subchannel in CONNECTING state, report
+  //    CONNECTING.
+  // 4. If there is one subchannel in TRANSIENT_FAILURE state and there is
+  //    more than one subchannel, report CONNECTING.
+  // 5. If there is at least one subchannel in IDLE state, report IDLE.
+  // 6. Otherwise, report TRANSIENT_FAILURE.
+  //
+  // We set start_connection_attempt to true if we match rules 2, 3, or 6.
+  grpc_connectivity_state state;
+  bool start_connection_attempt = false;
+  if (num_ready_ > 0) {
+    state = GRPC_CHANNEL_READY;
+  } else if (num_transient_failure_ >= 2) {
+    state = GRPC_CHANNEL_TRANSIENT_FAILURE;
+    start_connection_attempt = true;
+  } else if (num_connecting_ > 0) {
+    state = GRPC_CHANNEL_CONNECTING;
+  } else if (num_transient_failure_ == 1 && num_subchannels() > 1) {
+    state = GRPC_CHANNEL_CONNECTING;
+    start_connection_attempt = true;
+  } else if (num_idle_ > 0) {
+    state = GRPC_CHANNEL_IDLE;
+  } else {
+    state = GRPC_CHANNEL_TRANSIENT_FAILURE;
+    start_connection_attempt = true;
+  }
+  // Pass along status only in TRANSIENT_FAILURE.
+  if (state != GRPC_CHANNEL_TRANSIENT_FAILURE) status = absl::OkStatus();
+  // Generate new picker and return it to the channel.
+  // Note that we use our own picker regardless of connectivity state.
+  p->channel_control_helper()->UpdateState(
+      state, status,
+      absl::make_unique<Picker>(p->Ref(DEBUG_LOCATION, "MaglevPicker"),
+                                table_));
+  // While the maglev policy is reporting TRANSIENT_FAILURE, it will
+  // not be getting any pick requests from the priority policy.
+  // However, because the maglev policy does not attempt to
+  // reconnect to subchannels unless it is getting pick requests,
+  // it will need special handling to ensure that it will eventually
+  // recover from TRANSIENT_FAILURE state once the problem is resolved.
+  // Specifically, it will make sure that it is attempting to connect to
+  // at least one subchannel at any given time.  After a given subchannel
+  // fails a connection attempt, it will move on to the next subchannel
+  // in the list.  It will keep doing this until one of the subchannels
+  // successfully connects, at which point it will report READY and stop
+  // proactively trying to connect.  The policy will remain in
+  // TRANSIENT_FAILURE until at least one subchannel becomes connected,
+  // even if subchannels are in state CONNECTING during that time.
+  //
+  // Note that we do the same thing when the policy is in state
+  // CONNECTING, just to ensure that we don't remain in CONNECTING state
+  // indefinitely if there are no new picks coming in.
+  if (internally_triggered_connection_index_.has_value() &&
+      *internally_triggered_connection_index_ == index &&
+      connection_attempt_complete) {
+    internally_triggered_connection_index_.reset();
+  }
+  if (start_connection_attempt &&
+      !internally_triggered_connection_index_.has_value()) {
+    size_t next_index = (index + 1) % num_subchannels();
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_maglev_trace)) {
+      gpr_log(GPR_INFO,
+              "[maglev %p] triggering internal connection attempt for "
+              "subchannel %p, subchannel_list %p (index %" PRIuPTR
+              " of %" PRIuPTR ")",
+              p, subchannel(next_index)->subchannel(), this, next_index,
+              num_subchannels());
+    }
+    internally_triggered_connection_index_ = next_index;
+    subchannel(next_index)->subchannel()->RequestConnection();
+  }
+}
+
+//
+// Maglev::MaglevSubchannelData
+//
+
+void Maglev::MaglevSubchannelData::ProcessConnectivityChangeLocked(
+    absl::optional<grpc_connectivity_state> old_state,
+    grpc_connectivity_state new_state) {
+  Maglev* p = static_cast<Maglev*>(subchannel_list()->policy());
+  grpc_connectivity_state last_connectivity_state = GetConnectivityState();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_maglev_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[maglev %p] connectivity changed for subchannel %p, "
+        "subchannel_list %p (index %" PRIuPTR " of %" PRIuPTR
+        "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        ConnectivityStateName(last_connectivity_state),
+        ConnectivityStateName(new_state));
+  }
+  GPR_ASSERT(subchannel() != nullptr);
+  // If this is not the initial state notification and the new state is
+  // TRANSIENT_FAILURE or IDLE, re-resolve and attempt to reconnect.
+  // Note that we don't want to do this on the initial state
+  // notification, because that would result in an endless loop of
+  // re-resolution.
+  if (old_state.has_value() && (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
+                                new_state == GRPC_CHANNEL_IDLE)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_maglev_trace)) {
+      gpr_log(GPR_INFO,
+              "[maglev %p] Subchannel %p reported %s; requesting "
+              "re-resolution",
+              p, subchannel(), ConnectivityStateName(new_state));
+    }
+    p->channel_control_helper()->RequestReresolution();
+  }
+  const bool connection_attempt_complete = new_state != GRPC_CHANNEL_CONNECTING;
+  // Decide what state to report for the purposes of aggregation and
+  // picker behavior.
+  // If the last recorded state was TRANSIENT_FAILURE, ignore the update
+  // unless the new state is READY.
+  if (last_connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE &&
+      new_state != GRPC_CHANNEL_READY) {
+    new_state = GRPC_CHANNEL_TRANSIENT_FAILURE;
+  }
+  // Update state counters used for aggregation.
+  subchannel_list()->UpdateStateCountersLocked(last_connectivity_state,
+                                               new_state);
+  // Update last seen state, also used by picker.
+  connectivity_state_.store(new_state, std::memory_order_relaxed);
+  // Update the maglev policy's connectivity state, creating new picker.
+  subchannel_list()->UpdateMaglevConnectivityStateLocked(
+      Index(), connection_attempt_complete,
+      absl::UnavailableError("connections to backends failing"));
+}
+
+//
+// Maglev
+//
+
+Maglev::Maglev(Args args) : LoadBalancingPolicy(std::move(args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_maglev_trace)) {
+    gpr_log(GPR_INFO, "[maglev %p] Created", this);
+  }
+}
+
+Maglev::~Maglev() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_maglev_trace)) {
+    gpr_log(GPR_INFO, "[maglev %p] Destroying Maglev policy", this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void Maglev::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_maglev_trace)) {
+    gpr_log(GPR_INFO, "[maglev %p] Shutting down", this);
+  }
+  shutdown_ = true;
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+void Maglev::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+void Maglev::UpdateLocked(UpdateArgs args) {
+  config_ = std::move(args.config);
+  ServerAddressList addresses;
+  if (args.addresses.ok()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_maglev_trace)) {
+      gpr_log(GPR_INFO,
+              "[maglev %p] received update with %" PRIuPTR " addresses", this,
+              args.addresses->size());
+    }
+    // Filter out any address with weight 0.
+    addresses.reserve(args.addresses->size());
+    for (ServerAddress& address : *args.addresses) {
+      const ServerAddressWeightAttribute* weight_attribute =
+          static_cast<const ServerAddressWeightAttribute*>(address.GetAttribute(
+              ServerAddressWeightAttribute::kServerAddressWeightAttributeKey));
+      if (weight_attribute == nullptr || weight_attribute->weight() > 0) {
+        addresses.emplace_back(std::move(address));
+      }
+    }
+  } else {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_maglev_trace)) {
+      gpr_log(GPR_INFO, "[maglev %p] received update with addresses error: %s",
+              this, args.addresses.status().ToString().c_str());
+    }
+    // If we already have a subchannel list, then ignore the resolver
+    // failure and keep using the existing list.
+    if (subchannel_list_ != nullptr) return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_maglev_trace) &&
+      latest_pending_subchannel_list_ != nullptr) {
+    gpr_log(GPR_INFO, "[maglev %p] replacing latest pending subchannel list %p",
+            this, latest_pending_subchannel_list_.get());
+  }
+  latest_pending_subchannel_list_ = MakeOrphanable<MaglevSubchannelList>(
+      this, std::move(addresses), *args.args);
+  // If we have no existing list or the new list is empty, immediately
+  // promote the new list.
+  // Otherwise, do nothing; the new list will be promoted when the
+  // initial subchannel states are reported.
+  if (subchannel_list_ == nullptr ||
+      latest_pending_subchannel_list_->num_subchannels() == 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_maglev_trace) &&
+        subchannel_list_ != nullptr) {
+      gpr_log(GPR_INFO,
+              "[maglev %p] empty address list, replacing subchannel list %p",
+              this, subchannel_list_.get());
+    }
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    // If the new list is empty, report TRANSIENT_FAILURE.
+    if (subchannel_list_->num_subchannels() == 0) {
+      absl::Status status =
+          args.addresses.ok()
+              ? absl::UnavailableError(
+                    absl::StrCat("empty address list: ", args.resolution_note))
+              : args.addresses.status();
+      channel_control_helper()->UpdateState(
+          GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+          absl::make_unique<TransientFailurePicker>(status));
+    } else {
+      // Otherwise, report IDLE.
+      subchannel_list_->UpdateMaglevConnectivityStateLocked(
+          /*index=*/0, /*connection_attempt_complete=*/false, absl::OkStatus());
+    }
+  }
+}
+
+//
+// factory
+//
+
+class MaglevFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<Maglev>(std::move(args));
+  }
+
+  const char* name() const override { return kMaglev; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const Json& json, grpc_error_handle* error) const override {
+    uint64_t table_size;
+    std::vector<grpc_error_handle> error_list;
+    ParseMaglevLbConfig(json, &table_size, &error_list);
+    if (error_list.empty()) {
+      return MakeRefCounted<MaglevLbConfig>(table_size);
+    } else {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR(
+          "maglev_experimental LB policy config", &error_list);
+      return nullptr;
+    }
+  }
+};
+
+}  // namespace
+
+void GrpcLbPolicyMaglevInit() {
+  LoadBalancingPolicyRegistry::Builder::RegisterLoadBalancingPolicyFactory(
+      absl::make_unique<MaglevFactory>());
+}
+
+void GrpcLbPolicyMaglevShutdown() {}
+
+}  // namespace grpc_core
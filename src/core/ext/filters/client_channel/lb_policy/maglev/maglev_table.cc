@@ -0,0 +1,104 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/maglev/maglev_table.h"
+
+#include <algorithm>
+#include <limits>
+
+#define XXH_INLINE_ALL
+#include "xxhash.h"
+
+#include <grpc/support/log.h>
+
+namespace grpc_core {
+
+constexpr uint64_t MaglevTable::kDefaultTableSize;
+constexpr uint64_t MaglevTable::kMaxTableSize;
+
+bool MaglevTable::IsValidTableSize(uint64_t table_size) {
+  if (table_size < 2 || table_size > kMaxTableSize) return false;
+  for (uint64_t d = 2; d * d <= table_size; ++d) {
+    if (table_size % d == 0) return false;
+  }
+  return true;
+}
+
+MaglevTable::MaglevTable(absl::Span<const Endpoint> endpoints,
+                         uint64_t table_size) {
+  GPR_ASSERT(IsValidTableSize(table_size));
+  if (endpoints.empty()) return;
+  GPR_ASSERT(endpoints.size() <= std::numeric_limits<uint32_t>::max());
+  uint32_t max_weight = 0;
+  for (const Endpoint& endpoint : endpoints) {
+    max_weight = std::max(max_weight, endpoint.weight);
+  }
+  GPR_ASSERT(max_weight > 0);
+  // Per-endpoint build state.  Each endpoint walks its permutation of the
+  // table, (offset + i * skip) % table_size, which visits every slot
+  // because table_size is prime.
+  struct BuildEntry {
+    uint32_t index;
+    uint64_t next_slot;
+    uint64_t skip;
+    // Weight relative to the largest one, in (0, 1].
+    double weight;
+    double target_weight = 0;
+
+    // skip is below table_size, so this avoids a division per probe.
+    void Advance(uint64_t table_size) {
+      next_slot += skip;
+      if (next_slot >= table_size) next_slot -= table_size;
+    }
+  };
+  std::vector<BuildEntry> entries;
+  entries.reserve(endpoints.size());
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    const Endpoint& endpoint = endpoints[i];
+    if (endpoint.weight == 0) continue;
+    const uint64_t offset =
+        XXH64(endpoint.key.data(), endpoint.key.size(), 0) % table_size;
+    const uint64_t skip =
+        XXH64(endpoint.key.data(), endpoint.key.size(), 1) % (table_size - 1) +
+        1;
+    entries.push_back({static_cast<uint32_t>(i), offset, skip,
+                       static_cast<double>(endpoint.weight) / max_weight});
+  }
+  // Every endpoint claims a slot on its first turn, until the table is full.
+  num_endpoints_with_slots_ = std::min<uint64_t>(entries.size(), table_size);
+  constexpr uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+  slots_.assign(table_size, kEmpty);
+  // Take turns claiming the next free slot of each endpoint's permutation.
+  // An endpoint with the largest weight takes a turn on every iteration;
+  // one with a third of that weight takes a turn every third iteration.
+  uint64_t filled = 0;
+  for (uint64_t iteration = 1; filled < table_size; ++iteration) {
+    for (BuildEntry& entry : entries) {
+      if (iteration * entry.weight < entry.target_weight) continue;
+      entry.target_weight += 1;
+      while (slots_[entry.next_slot] != kEmpty) {
+        entry.Advance(table_size);
+      }
+      slots_[entry.next_slot] = entry.index;
+      entry.Advance(table_size);
+      if (++filled == table_size) break;
+    }
+  }
+}
+
+}  // namespace grpc_core
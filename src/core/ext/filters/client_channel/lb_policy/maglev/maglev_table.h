@@ -0,0 +1,83 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_MAGLEV_MAGLEV_TABLE_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_MAGLEV_MAGLEV_TABLE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace grpc_core {
+
+// A Maglev lookup table, as described in "Maglev: A Fast and Reliable
+// Software Network Load Balancer" (NSDI '16), extended with weights the
+// same way Envoy does it.
+//
+// Every slot of a fixed, prime-sized table is assigned to one endpoint, in
+// proportion to the endpoint weights.  Each endpoint fills slots in the
+// order of its own permutation of the table, derived from a hash of its
+// key, so that adding or removing an endpoint moves only a small fraction
+// of the slots owned by the others.  Lookups are a single modulo.
+class MaglevTable {
+ public:
+  static constexpr uint64_t kDefaultTableSize = 65537;
+  static constexpr uint64_t kMaxTableSize = 5000011;
+
+  struct Endpoint {
+    // Identifies the endpoint; usually its address.  Endpoints with equal
+    // keys get the same permutation.
+    absl::string_view key;
+    // Endpoints with weight 0 get no slots.
+    uint32_t weight = 1;
+  };
+
+  // Returns true if table_size is a prime no larger than kMaxTableSize.
+  static bool IsValidTableSize(uint64_t table_size);
+
+  // table_size must be valid, and unless the list of endpoints is empty,
+  // at least one weight must be non-zero.  No endpoints give an empty
+  // table.
+  MaglevTable(absl::Span<const Endpoint> endpoints, uint64_t table_size);
+
+  size_t size() const { return slots_.size(); }
+
+  // Returns the index in the endpoints list that owns the given slot.
+  size_t endpoint_index(size_t slot) const { return slots_[slot]; }
+
+  // Returns the number of endpoints that own at least one slot.
+  size_t num_endpoints_with_slots() const { return num_endpoints_with_slots_; }
+
+  // Returns the slot for the given request hash.
+  size_t Slot(uint64_t hash) const { return hash % slots_.size(); }
+
+  // Returns the memory used by the table, in bytes.
+  size_t MemoryUsage() const { return slots_.capacity() * sizeof(uint32_t); }
+
+ private:
+  std::vector<uint32_t> slots_;
+  size_t num_endpoints_with_slots_ = 0;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_MAGLEV_MAGLEV_TABLE_H
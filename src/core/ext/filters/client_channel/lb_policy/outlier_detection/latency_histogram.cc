@@ -0,0 +1,118 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/outlier_detection/latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "absl/numeric/bits.h"
+
+#include <grpc/support/log.h>
+
+namespace grpc_core {
+
+constexpr int LatencyHistogram::kSubBucketBits;
+constexpr int LatencyHistogram::kSubBuckets;
+constexpr int LatencyHistogram::kMaxExponent;
+constexpr size_t LatencyHistogram::kNumBuckets;
+
+namespace {
+
+// Returns the smallest latency counted in the given bucket, and sets
+// *width to the number of latencies it counts.
+uint64_t BucketLowerBound(size_t bucket, uint64_t* width) {
+  constexpr int kSubBucketBits = LatencyHistogram::kSubBucketBits;
+  constexpr int kSubBuckets = LatencyHistogram::kSubBuckets;
+  if (bucket < static_cast<size_t>(kSubBuckets)) {
+    *width = 1;
+    return bucket;
+  }
+  const int exponent = bucket / kSubBuckets + kSubBucketBits - 1;
+  const uint64_t sub_bucket = bucket % kSubBuckets;
+  *width = uint64_t(1) << (exponent - kSubBucketBits);
+  return (kSubBuckets + sub_bucket) << (exponent - kSubBucketBits);
+}
+
+}  // namespace
+
+size_t LatencyHistogram::BucketForLatency(int64_t latency_micros) {
+  constexpr uint64_t kMaxLatency = (uint64_t(1) << (kMaxExponent + 1)) - 1;
+  if (latency_micros < kSubBuckets) {
+    return std::max<int64_t>(latency_micros, 0);
+  }
+  const uint64_t latency =
+      std::min(static_cast<uint64_t>(latency_micros), kMaxLatency);
+  // The highest set bit picks the power of two, and the kSubBucketBits
+  // below it pick the bucket within it.
+  const int exponent = 63 - absl::countl_zero(latency);
+  return (exponent - kSubBucketBits + 1) * kSubBuckets +
+         ((latency >> (exponent - kSubBucketBits)) - kSubBuckets);
+}
+
+void LatencyHistogram::Reset() {
+  for (auto& count : counts_) count.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Count() const {
+  uint64_t total = 0;
+  for (const auto& count : counts_) {
+    total += count.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+double LatencyHistogram::Percentile(double percentile) const {
+  GPR_ASSERT(percentile > 0 && percentile <= 100);
+  const uint64_t total = Count();
+  if (total == 0) return 0;
+  const uint64_t rank = std::max<uint64_t>(
+      static_cast<uint64_t>(std::ceil(percentile / 100 * total)), 1);
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < kNumBuckets; ++bucket) {
+    seen += counts_[bucket].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      // Report the middle of the bucket.
+      uint64_t width;
+      const uint64_t lower_bound = BucketLowerBound(bucket, &width);
+      return lower_bound + (width - 1) / 2.0;
+    }
+  }
+  // Only reached if Record() ran concurrently with this.
+  uint64_t width;
+  return BucketLowerBound(kNumBuckets - 1, &width) + (width - 1) / 2.0;
+}
+
+double LatencyEjectionThreshold(absl::Span<const double> latencies,
+                                double stdev_factor) {
+  GPR_ASSERT(!latencies.empty());
+  double sum = 0;
+  for (double latency : latencies) sum += latency;
+  const double mean = sum / latencies.size();
+  double variance = 0;
+  for (double latency : latencies) variance += std::pow(latency - mean, 2);
+  variance /= latencies.size();
+  // Percentiles are only accurate to within half a bucket, so a spread
+  // smaller than that is noise.  Without this floor, ordinary jitter
+  // between equally healthy hosts pushes one of them past the threshold
+  // in about half of the intervals.
+  const double min_stdev = mean / (2 * LatencyHistogram::kSubBuckets);
+  return mean + std::max(std::sqrt(variance), min_stdev) * stdev_factor;
+}
+
+}  // namespace grpc_core
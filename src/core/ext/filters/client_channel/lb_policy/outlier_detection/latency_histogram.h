@@ -0,0 +1,83 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_OUTLIER_DETECTION_LATENCY_HISTOGRAM_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_OUTLIER_DETECTION_LATENCY_HISTOGRAM_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "absl/types/span.h"
+
+namespace grpc_core {
+
+// A histogram of call latencies, in microseconds, that calls can record
+// into concurrently without taking a lock.
+//
+// Each power of two of microseconds is split into kSubBuckets buckets, so
+// a percentile read back is within 1/kSubBuckets of the recorded latency,
+// and the histogram has a fixed size however many calls it counts.
+// Latencies of 2^(kMaxExponent + 1) microseconds (about 38 hours) or more
+// are counted in the last bucket.
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 2;
+  static constexpr int kSubBuckets = 1 << kSubBucketBits;
+  static constexpr int kMaxExponent = 36;
+  static constexpr size_t kNumBuckets =
+      (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+  LatencyHistogram() { Reset(); }
+
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+  void Record(int64_t latency_micros) {
+    counts_[BucketForLatency(latency_micros)].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+
+  // Not safe to call concurrently with Record().
+  void Reset();
+
+  // Returns the number of latencies recorded since the last Reset().
+  uint64_t Count() const;
+
+  // Returns the latency, in microseconds, below which the given percentage
+  // of the recorded latencies fall.  percentile must be in (0, 100].
+  // Returns 0 if nothing was recorded.
+  double Percentile(double percentile) const;
+
+  static size_t BucketForLatency(int64_t latency_micros);
+
+ private:
+  std::atomic<uint32_t> counts_[kNumBuckets];
+};
+
+// Returns the latency above which a host is an outlier: the mean of the
+// hosts' latencies plus stdev_factor times their standard deviation.  The
+// standard deviation is taken to be at least the histogram's resolution at
+// the mean.  latencies must not be empty.
+double LatencyEjectionThreshold(absl::Span<const double> latencies,
+                                double stdev_factor);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_OUTLIER_DETECTION_LATENCY_HISTOGRAM_H
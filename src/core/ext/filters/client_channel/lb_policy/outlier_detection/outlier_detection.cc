@@ -43,9 +43,11 @@
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
 
 #include "src/core/ext/filters/client_channel/lb_policy.h"
 #include "src/core/ext/filters/client_channel/lb_policy/child_policy_handler.h"
+#include "src/core/ext/filters/client_channel/lb_policy/outlier_detection/latency_histogram.h"
 #include "src/core/ext/filters/client_channel/lb_policy_factory.h"
 #include "src/core/ext/filters/client_channel/lb_policy_registry.h"
 #include "src/core/ext/filters/client_channel/subchannel_interface.h"
@@ -101,7 +103,13 @@ class OutlierDetectionLbConfig : public LoadBalancingPolicy::Config {
     return (
         outlier_detection_config_.interval != Duration::Infinity() &&
         (outlier_detection_config_.success_rate_ejection.has_value() ||
-         outlier_detection_config_.failure_percentage_ejection.has_value()));
+         outlier_detection_config_.failure_percentage_ejection.has_value() ||
+         outlier_detection_config_.latency_ejection.has_value()));
+  }
+
+  bool LatencyTrackingEnabled() const {
+    return CountingEnabled() &&
+           outlier_detection_config_.latency_ejection.has_value();
   }
 
   const OutlierDetectionConfig& outlier_detection_config() const {
@@ -223,11 +231,16 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
     struct Bucket {
       std::atomic<uint64_t> successes;
       std::atomic<uint64_t> failures;
+      // Null unless latency ejection has been configured.
+      std::unique_ptr<LatencyHistogram> latencies;
     };
 
     void RotateBucket() {
       backup_bucket_->successes = 0;
       backup_bucket_->failures = 0;
+      if (backup_bucket_->latencies != nullptr) {
+        backup_bucket_->latencies->Reset();
+      }
       current_bucket_.swap(backup_bucket_);
       active_bucket_.store(current_bucket_.get());
     }
@@ -257,6 +270,28 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
 
     void AddFailureCount() { active_bucket_.load()->failures.fetch_add(1); }
 
+    // Allocates the latency histograms, which are large enough that they
+    // are only kept when latency ejection is configured.  Must be called
+    // before any picker that tracks latency is created.  The histograms are
+    // kept even if latency ejection is later unconfigured, since older
+    // pickers may still be recording into them.
+    void EnableLatencyTracking() {
+      if (current_bucket_->latencies != nullptr) return;
+      current_bucket_->latencies = absl::make_unique<LatencyHistogram>();
+      backup_bucket_->latencies = absl::make_unique<LatencyHistogram>();
+    }
+
+    void AddLatency(int64_t latency_micros) {
+      LatencyHistogram* latencies = active_bucket_.load()->latencies.get();
+      if (latencies != nullptr) latencies->Record(latency_micros);
+    }
+
+    // Latencies of the calls that finished in the last interval, or null
+    // if latency tracking has not been enabled.
+    const LatencyHistogram* latencies() const {
+      return backup_bucket_->latencies.get();
+    }
+
     absl::optional<Timestamp> ejection_time() const { return ejection_time_; }
 
     void Eject(const Timestamp& time) {
@@ -319,7 +354,8 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
   class Picker : public SubchannelPicker {
    public:
     Picker(OutlierDetectionLb* outlier_detection_lb,
-           RefCountedPtr<RefCountedPicker> picker, bool counting_enabled);
+           RefCountedPtr<RefCountedPicker> picker, bool counting_enabled,
+           bool latency_tracking_enabled);
 
     PickResult Pick(PickArgs args) override;
 
@@ -327,6 +363,7 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
     class SubchannelCallTracker;
     RefCountedPtr<RefCountedPicker> picker_;
     bool counting_enabled_;
+    bool latency_tracking_enabled_;
   };
 
   class Helper : public ChannelControlHelper {
@@ -444,17 +481,19 @@ class OutlierDetectionLb::Picker::SubchannelCallTracker
   SubchannelCallTracker(
       std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
           original_subchannel_call_tracker,
-      RefCountedPtr<SubchannelState> subchannel_state)
+      RefCountedPtr<SubchannelState> subchannel_state, bool track_latency)
       : original_subchannel_call_tracker_(
             std::move(original_subchannel_call_tracker)),
-        subchannel_state_(std::move(subchannel_state)) {}
+        subchannel_state_(std::move(subchannel_state)),
+        track_latency_(track_latency) {}
 
   ~SubchannelCallTracker() override {
     subchannel_state_.reset(DEBUG_LOCATION, "SubchannelCallTracker");
   }
 
   void Start() override {
-    // This tracker does not care about started calls only finished calls.
+    // Started calls only matter for measuring latency.
+    if (track_latency_) start_time_ = gpr_now(GPR_CLOCK_MONOTONIC);
     // Delegate if needed.
     if (original_subchannel_call_tracker_ != nullptr) {
       original_subchannel_call_tracker_->Start();
@@ -474,6 +513,13 @@ class OutlierDetectionLb::Picker::SubchannelCallTracker
       } else {
         subchannel_state_->AddFailureCount();
       }
+      // Failed calls count too: a host that is slow enough to make calls
+      // hit their deadlines is just the kind we want to eject.
+      if (track_latency_) {
+        subchannel_state_->AddLatency(static_cast<int64_t>(
+            gpr_timespec_to_micros(gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC),
+                                                start_time_))));
+      }
     }
   }
 
@@ -481,6 +527,8 @@ class OutlierDetectionLb::Picker::SubchannelCallTracker
   std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
       original_subchannel_call_tracker_;
   RefCountedPtr<SubchannelState> subchannel_state_;
+  const bool track_latency_;
+  gpr_timespec start_time_;
 };
 
 //
@@ -489,8 +537,11 @@ class OutlierDetectionLb::Picker::SubchannelCallTracker
 
 OutlierDetectionLb::Picker::Picker(OutlierDetectionLb* outlier_detection_lb,
                                    RefCountedPtr<RefCountedPicker> picker,
-                                   bool counting_enabled)
-    : picker_(std::move(picker)), counting_enabled_(counting_enabled) {
+                                   bool counting_enabled,
+                                   bool latency_tracking_enabled)
+    : picker_(std::move(picker)),
+      counting_enabled_(counting_enabled),
+      latency_tracking_enabled_(latency_tracking_enabled) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
     gpr_log(GPR_INFO,
             "[outlier_detection_lb %p] constructed new picker %p and counting "
@@ -519,7 +570,8 @@ LoadBalancingPolicy::PickResult OutlierDetectionLb::Picker::Pick(
       complete_pick->subchannel_call_tracker =
           absl::make_unique<SubchannelCallTracker>(
               std::move(complete_pick->subchannel_call_tracker),
-              subchannel_wrapper->subchannel_state());
+              subchannel_wrapper->subchannel_state(),
+              latency_tracking_enabled_);
     }
     complete_pick->subchannel = subchannel_wrapper->wrapped_subchannel();
   }
@@ -631,6 +683,11 @@ void OutlierDetectionLb::UpdateLocked(UpdateArgs args) {
       }
     }
   }
+  if (config_->LatencyTrackingEnabled()) {
+    for (const auto& p : subchannel_state_map_) {
+      p.second->EnableLatencyTracking();
+    }
+  }
   // Construct update args.
   UpdateArgs update_args;
   update_args.addresses = std::move(args.addresses);
@@ -648,7 +705,8 @@ void OutlierDetectionLb::UpdateLocked(UpdateArgs args) {
 void OutlierDetectionLb::MaybeUpdatePickerLocked() {
   if (picker_ != nullptr) {
     auto outlier_detection_picker =
-        absl::make_unique<Picker>(this, picker_, config_->CountingEnabled());
+        absl::make_unique<Picker>(this, picker_, config_->CountingEnabled(),
+                                  config_->LatencyTrackingEnabled());
     if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
       gpr_log(GPR_INFO,
               "[outlier_detection_lb %p] updating connectivity: state=%s "
@@ -779,6 +837,7 @@ void OutlierDetectionLb::EjectionTimer::OnTimerLocked(grpc_error_handle error) {
   if (error == GRPC_ERROR_NONE && timer_pending_) {
     std::map<SubchannelState*, double> success_rate_ejection_candidates;
     std::map<SubchannelState*, double> failure_percentage_ejection_candidates;
+    std::map<SubchannelState*, double> latency_ejection_candidates;
     size_t ejected_host_count = 0;
     double success_rate_sum = 0;
     auto time_now = ExecCtx::Get()->Now();
@@ -793,6 +852,12 @@ void OutlierDetectionLb::EjectionTimer::OnTimerLocked(grpc_error_handle error) {
       if (subchannel_state->ejection_time().has_value()) {
         ++ejected_host_count;
       }
+      const LatencyHistogram* latencies = subchannel_state->latencies();
+      if (config.latency_ejection.has_value() && latencies != nullptr &&
+          latencies->Count() >= config.latency_ejection->request_volume) {
+        latency_ejection_candidates[subchannel_state] =
+            latencies->Percentile(config.latency_ejection->percentile);
+      }
       absl::optional<std::pair<double, uint64_t>> host_success_rate_and_volume =
           subchannel_state->GetSuccessRateAndVolume();
       if (!host_success_rate_and_volume.has_value()) {
@@ -875,6 +940,38 @@ void OutlierDetectionLb::EjectionTimer::OnTimerLocked(grpc_error_handle error) {
         }
       }
     }
+    // latency algorithm
+    if (!latency_ejection_candidates.empty() &&
+        latency_ejection_candidates.size() >=
+            config.latency_ejection->minimum_hosts) {
+      // calculate ejection threshold: (mean + stdev *
+      // (latency_ejection.stdev_factor / 1000))
+      std::vector<double> latencies;
+      latencies.reserve(latency_ejection_candidates.size());
+      for (auto& candidate : latency_ejection_candidates) {
+        latencies.push_back(candidate.second);
+      }
+      const double ejection_threshold = LatencyEjectionThreshold(
+          latencies,
+          static_cast<double>(config.latency_ejection->stdev_factor) / 1000);
+      for (auto& candidate : latency_ejection_candidates) {
+        // Skip backends already ejected by the other algorithms.
+        if (candidate.first->ejection_time().has_value()) continue;
+        if (candidate.second > ejection_threshold) {
+          uint32_t random_key = absl::Uniform(bit_gen_, 1, 100);
+          double current_percent = 100.0 * ejected_host_count /
+                                   parent_->subchannel_state_map_.size();
+          if (random_key < config.latency_ejection->enforcement_percentage &&
+              (ejected_host_count == 0 ||
+               (current_percent < config.max_ejection_percent))) {
+            // Eject and record the timestamp for use when ejecting addresses in
+            // this iteration.
+            candidate.first->Eject(time_now);
+            ++ejected_host_count;
+          }
+        }
+      }
+    }
     // For each address in the map:
     //   If the address is not ejected and the multiplier is greater than 0,
     //   decrease the multiplier by 1. If the address is ejected, and the
@@ -967,6 +1064,37 @@ class OutlierDetectionLbFactory : public LoadBalancingPolicyFactory {
         outlier_detection_config.failure_percentage_ejection = failure_config;
       }
     }
+    it = json.object_value().find("latencyEjection");
+    if (it != json.object_value().end()) {
+      if (it->second.type() != Json::Type::OBJECT) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:latencyEjection error:type must be object"));
+      } else {
+        OutlierDetectionConfig::LatencyEjection latency_config;
+        const Json::Object& object = it->second.object_value();
+        if (ParseJsonObjectField(object, "percentile",
+                                 &latency_config.percentile, &error_list,
+                                 /*required=*/false) &&
+            (latency_config.percentile == 0 ||
+             latency_config.percentile > 100)) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:latencyEjection.percentile error:must be in [1, 100]"));
+        }
+        ParseJsonObjectField(object, "stdevFactor",
+                             &latency_config.stdev_factor, &error_list,
+                             /*required=*/false);
+        ParseJsonObjectField(object, "enforcementPercentage",
+                             &latency_config.enforcement_percentage,
+                             &error_list, /*required=*/false);
+        ParseJsonObjectField(object, "minimumHosts",
+                             &latency_config.minimum_hosts, &error_list,
+                             /*required=*/false);
+        ParseJsonObjectField(object, "requestVolume",
+                             &latency_config.request_volume, &error_list,
+                             /*required=*/false);
+        outlier_detection_config.latency_ejection = latency_config;
+      }
+    }
     ParseJsonObjectFieldAsDuration(json.object_value(), "interval",
                                    &outlier_detection_config.interval,
                                    &error_list);
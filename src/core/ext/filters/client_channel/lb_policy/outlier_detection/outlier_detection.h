@@ -46,8 +46,18 @@ struct OutlierDetectionConfig {
     uint32_t minimum_hosts = 5;
     uint32_t request_volume = 50;
   };
+  // Ejects hosts whose latency at the given percentile is more than
+  // stdev_factor / 1000 standard deviations above the mean across hosts.
+  struct LatencyEjection {
+    uint32_t percentile = 99;
+    uint32_t stdev_factor = 1900;
+    uint32_t enforcement_percentage = 100;
+    uint32_t minimum_hosts = 5;
+    uint32_t request_volume = 100;
+  };
   absl::optional<SuccessRateEjection> success_rate_ejection;
   absl::optional<FailurePercentageEjection> failure_percentage_ejection;
+  absl::optional<LatencyEjection> latency_ejection;
 };
 }  // namespace grpc_core
 
@@ -16,12 +16,16 @@
 
 #include <grpc/support/port_platform.h>
 
+#include "src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.h"
+
 #include <inttypes.h>
+#include <limits.h>
 #include <string.h>
 
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/memory/memory.h"
@@ -39,12 +43,18 @@
 #include "src/core/ext/filters/client_channel/lb_policy_factory.h"
 #include "src/core/ext/filters/client_channel/lb_policy_registry.h"
 #include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/iomgr/work_serializer.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/resolver/server_address.h"
 #include "src/core/lib/transport/connectivity_state.h"
@@ -53,6 +63,28 @@ namespace grpc_core {
 
 TraceFlag grpc_lb_pick_first_trace(false, "pick_first");
 
+ServerAddressList InterleaveAddressFamilies(
+    const ServerAddressList& addresses) {
+  if (addresses.empty()) return {};
+  const int first_family = grpc_sockaddr_get_family(&addresses[0].address());
+  std::vector<const ServerAddress*> first;
+  std::vector<const ServerAddress*> others;
+  for (const ServerAddress& address : addresses) {
+    if (grpc_sockaddr_get_family(&address.address()) == first_family) {
+      first.push_back(&address);
+    } else {
+      others.push_back(&address);
+    }
+  }
+  ServerAddressList interleaved;
+  interleaved.reserve(addresses.size());
+  for (size_t i = 0; i < first.size() || i < others.size(); ++i) {
+    if (i < first.size()) interleaved.push_back(*first[i]);
+    if (i < others.size()) interleaved.push_back(*others[i]);
+  }
+  return interleaved;
+}
+
 namespace {
 
 //
@@ -61,6 +93,8 @@ namespace {
 
 constexpr char kPickFirst[] = "pick_first";
 
+constexpr int kDefaultConnectionAttemptDelayMs = 250;
+
 class PickFirst : public LoadBalancingPolicy {
  public:
   explicit PickFirst(Args args);
@@ -126,8 +160,9 @@ class PickFirst : public LoadBalancingPolicy {
       in_transient_failure_ = in_transient_failure;
     }
 
+    // The index of the last subchannel we started connecting to.  The
+    // attempts to the subchannels before it may still be in progress.
     size_t attempting_index() const { return attempting_index_; }
-    void set_attempting_index(size_t index) { attempting_index_ = index; }
 
     bool AllSubchannelsSeenInitialState() {
       for (size_t i = 0; i < num_subchannels(); ++i) {
@@ -136,9 +171,47 @@ class PickFirst : public LoadBalancingPolicy {
       return true;
     }
 
+    // Returns true if any subchannel up to attempting_index() is still
+    // connecting.
+    bool AnyAttemptInProgress() {
+      for (size_t i = 0; i <= attempting_index_; ++i) {
+        if (subchannel(i)->connectivity_state() == GRPC_CHANNEL_CONNECTING) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // Starts connecting to the subchannel at \a index, and if it is not
+    // the last one, arms the timer to start connecting to the next one.
+    void StartConnectionAttemptLocked(size_t index);
+
+    void CancelConnectionAttemptTimerLocked();
+
    private:
+    // A new ConnectionAttemptTimer is allocated each time the timer is
+    // armed, so that the callback of a cancelled timer that is already
+    // queued can never be taken for the one that replaced it.
+    struct ConnectionAttemptTimer {
+      ConnectionAttemptTimer(PickFirstSubchannelList* subchannel_list,
+                             size_t next_index)
+          : subchannel_list(subchannel_list), next_index(next_index) {}
+      PickFirstSubchannelList* subchannel_list;
+      // The subchannel to start connecting to when the timer fires.
+      size_t next_index;
+      grpc_timer timer;
+      grpc_closure closure;
+    };
+
+    void ShutdownLocked() override;
+
+    static void OnConnectionAttemptTimer(void* arg, grpc_error_handle error);
+    void OnConnectionAttemptTimerLocked(ConnectionAttemptTimer* timer,
+                                        grpc_error_handle error);
+
     bool in_transient_failure_ = false;
     size_t attempting_index_ = 0;
+    ConnectionAttemptTimer* connection_attempt_timer_ = nullptr;
   };
 
   class Picker : public SubchannelPicker {
@@ -158,6 +231,9 @@ class PickFirst : public LoadBalancingPolicy {
 
   void AttemptToConnectUsingLatestUpdateArgsLocked();
 
+  // How long to wait for a connection attempt before starting the next
+  // one in parallel.
+  const Duration connection_attempt_delay_;
   // Lateset update args.
   UpdateArgs latest_update_args_;
   // All our subchannels.
@@ -172,7 +248,12 @@ class PickFirst : public LoadBalancingPolicy {
   bool shutdown_ = false;
 };
 
-PickFirst::PickFirst(Args args) : LoadBalancingPolicy(std::move(args)) {
+PickFirst::PickFirst(Args args)
+    : LoadBalancingPolicy(std::move(args)),
+      connection_attempt_delay_(
+          Duration::Milliseconds(grpc_channel_args_find_integer(
+              args.args, GRPC_ARG_HAPPY_EYEBALLS_CONNECTION_ATTEMPT_DELAY_MS,
+              {kDefaultConnectionAttemptDelayMs, 0, INT_MAX}))) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
     gpr_log(GPR_INFO, "Pick First %p created.", this);
   }
@@ -217,7 +298,7 @@ void PickFirst::AttemptToConnectUsingLatestUpdateArgsLocked() {
   // Create a subchannel list from latest_update_args_.
   ServerAddressList addresses;
   if (latest_update_args_.addresses.ok()) {
-    addresses = *latest_update_args_.addresses;
+    addresses = InterleaveAddressFamilies(*latest_update_args_.addresses);
   }
   // Replace latest_pending_subchannel_list_.
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace) &&
@@ -372,13 +453,13 @@ void PickFirst::PickFirstSubchannelData::ProcessConnectivityChangeLocked(
   // the subchannels report their state.
   if (!old_state.has_value()) {
     if (subchannel_list()->AllSubchannelsSeenInitialState()) {
-      subchannel_list()->subchannel(0)->subchannel()->RequestConnection();
+      subchannel_list()->StartConnectionAttemptLocked(0);
     }
     return;
   }
-  // Ignore any other updates for subchannels we're not currently trying to
-  // connect to.
-  if (Index() != subchannel_list()->attempting_index()) return;
+  // Ignore any other updates for subchannels we haven't started trying to
+  // connect to yet.
+  if (Index() > subchannel_list()->attempting_index()) return;
   // Otherwise, process connectivity state.
   switch (new_state) {
     case GRPC_CHANNEL_READY:
@@ -386,47 +467,55 @@ void PickFirst::PickFirstSubchannelData::ProcessConnectivityChangeLocked(
       GPR_UNREACHABLE_CODE(break);
     case GRPC_CHANNEL_TRANSIENT_FAILURE:
     case GRPC_CHANNEL_IDLE: {
-      PickFirstSubchannelData* sd = this;
-      size_t next_index =
-          (sd->Index() + 1) % subchannel_list()->num_subchannels();
-      subchannel_list()->set_attempting_index(next_index);
-      sd = subchannel_list()->subchannel(next_index);
-      // If we're tried all subchannels, set state to TRANSIENT_FAILURE.
-      if (sd->Index() == 0) {
+      const size_t attempting_index = subchannel_list()->attempting_index();
+      // If the latest attempt failed, start the next one right away rather
+      // than waiting for the timer.
+      if (Index() == attempting_index &&
+          attempting_index + 1 < subchannel_list()->num_subchannels()) {
+        subchannel_list()->StartConnectionAttemptLocked(attempting_index + 1);
+        break;
+      }
+      // Otherwise, wait until every subchannel has been tried and none is
+      // still connecting.
+      if (attempting_index + 1 < subchannel_list()->num_subchannels() ||
+          subchannel_list()->AnyAttemptInProgress()) {
+        break;
+      }
+      // We've tried all subchannels, so set state to TRANSIENT_FAILURE.
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
+        gpr_log(GPR_INFO,
+                "Pick First %p subchannel list %p failed to connect to "
+                "all subchannels",
+                p, subchannel_list());
+      }
+      subchannel_list()->set_in_transient_failure(true);
+      // In case 2, swap to the new subchannel list.  This means reporting
+      // TRANSIENT_FAILURE and dropping the existing (working) connection,
+      // but we can't ignore what the control plane has told us.
+      if (subchannel_list() == p->latest_pending_subchannel_list_.get()) {
         if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
           gpr_log(GPR_INFO,
-                  "Pick First %p subchannel list %p failed to connect to "
-                  "all subchannels",
-                  p, subchannel_list());
-        }
-        subchannel_list()->set_in_transient_failure(true);
-        // In case 2, swap to the new subchannel list.  This means reporting
-        // TRANSIENT_FAILURE and dropping the existing (working) connection,
-        // but we can't ignore what the control plane has told us.
-        if (subchannel_list() == p->latest_pending_subchannel_list_.get()) {
-          if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
-            gpr_log(GPR_INFO,
-                    "Pick First %p promoting pending subchannel list %p to "
-                    "replace %p",
-                    p, p->latest_pending_subchannel_list_.get(),
-                    p->subchannel_list_.get());
-          }
-          p->selected_ = nullptr;  // owned by p->subchannel_list_
-          p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
-        }
-        // If this is the current subchannel list (either because we were
-        // in case 1 or because we were in case 2 and just promoted it to
-        // be the current list), re-resolve and report new state.
-        if (subchannel_list() == p->subchannel_list_.get()) {
-          p->channel_control_helper()->RequestReresolution();
-          absl::Status status =
-              absl::UnavailableError("failed to connect to all addresses");
-          p->channel_control_helper()->UpdateState(
-              GRPC_CHANNEL_TRANSIENT_FAILURE, status,
-              absl::make_unique<TransientFailurePicker>(status));
+                  "Pick First %p promoting pending subchannel list %p to "
+                  "replace %p",
+                  p, p->latest_pending_subchannel_list_.get(),
+                  p->subchannel_list_.get());
         }
+        p->selected_ = nullptr;  // owned by p->subchannel_list_
+        p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
       }
-      sd->subchannel()->RequestConnection();
+      // If this is the current subchannel list (either because we were
+      // in case 1 or because we were in case 2 and just promoted it to
+      // be the current list), re-resolve and report new state.
+      if (subchannel_list() == p->subchannel_list_.get()) {
+        p->channel_control_helper()->RequestReresolution();
+        absl::Status status =
+            absl::UnavailableError("failed to connect to all addresses");
+        p->channel_control_helper()->UpdateState(
+            GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+            absl::make_unique<TransientFailurePicker>(status));
+      }
+      // Start over from the first subchannel.
+      subchannel_list()->StartConnectionAttemptLocked(0);
       break;
     }
     case GRPC_CHANNEL_CONNECTING: {
@@ -478,6 +567,9 @@ void PickFirst::PickFirstSubchannelData::ProcessUnselectedReadyLocked() {
   p->channel_control_helper()->UpdateState(
       GRPC_CHANNEL_READY, absl::Status(),
       absl::make_unique<Picker>(subchannel()->Ref()));
+  // Stop racing: this also cancels the attempts still in progress, since
+  // the other subchannels are shut down below.
+  subchannel_list()->CancelConnectionAttemptTimerLocked();
   for (size_t i = 0; i < subchannel_list()->num_subchannels(); ++i) {
     if (i != Index()) {
       subchannel_list()->subchannel(i)->ShutdownLocked();
@@ -485,6 +577,75 @@ void PickFirst::PickFirstSubchannelData::ProcessUnselectedReadyLocked() {
   }
 }
 
+//
+// PickFirst::PickFirstSubchannelList
+//
+
+void PickFirst::PickFirstSubchannelList::StartConnectionAttemptLocked(
+    size_t index) {
+  PickFirst* p = static_cast<PickFirst*>(policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
+    gpr_log(GPR_INFO,
+            "Pick First %p subchannel list %p: starting connection attempt "
+            "%" PRIuPTR " of %" PRIuPTR,
+            p, this, index + 1, num_subchannels());
+  }
+  attempting_index_ = index;
+  CancelConnectionAttemptTimerLocked();
+  subchannel(index)->subchannel()->RequestConnection();
+  if (index + 1 < num_subchannels()) {
+    connection_attempt_timer_ = new ConnectionAttemptTimer(this, index + 1);
+    GRPC_CLOSURE_INIT(&connection_attempt_timer_->closure,
+                      OnConnectionAttemptTimer, connection_attempt_timer_,
+                      nullptr);
+    Ref(DEBUG_LOCATION, "ConnectionAttemptTimer").release();
+    grpc_timer_init(&connection_attempt_timer_->timer,
+                    ExecCtx::Get()->Now() + p->connection_attempt_delay_,
+                    &connection_attempt_timer_->closure);
+  }
+}
+
+void PickFirst::PickFirstSubchannelList::CancelConnectionAttemptTimerLocked() {
+  if (connection_attempt_timer_ != nullptr) {
+    // The callback will see that connection_attempt_timer_ no longer points
+    // to it.
+    grpc_timer_cancel(&connection_attempt_timer_->timer);
+    connection_attempt_timer_ = nullptr;
+  }
+}
+
+void PickFirst::PickFirstSubchannelList::ShutdownLocked() {
+  CancelConnectionAttemptTimerLocked();
+  SubchannelList::ShutdownLocked();
+}
+
+void PickFirst::PickFirstSubchannelList::OnConnectionAttemptTimer(
+    void* arg, grpc_error_handle error) {
+  auto* timer = static_cast<ConnectionAttemptTimer*>(arg);
+  auto* self = timer->subchannel_list;
+  (void)GRPC_ERROR_REF(error);  // ref owned by lambda
+  static_cast<PickFirst*>(self->policy())
+      ->work_serializer()
+      ->Run(
+          [self, timer, error]() {
+            self->OnConnectionAttemptTimerLocked(timer, error);
+          },
+          DEBUG_LOCATION);
+}
+
+void PickFirst::PickFirstSubchannelList::OnConnectionAttemptTimerLocked(
+    ConnectionAttemptTimer* timer, grpc_error_handle error) {
+  if (error == GRPC_ERROR_NONE && connection_attempt_timer_ == timer &&
+      !shutting_down()) {
+    connection_attempt_timer_ = nullptr;
+    // Keep the current attempt going, and start the next one alongside it.
+    StartConnectionAttemptLocked(timer->next_index);
+  }
+  delete timer;
+  Unref(DEBUG_LOCATION, "ConnectionAttemptTimer");
+  GRPC_ERROR_UNREF(error);
+}
+
 class PickFirstConfig : public LoadBalancingPolicy::Config {
  public:
   const char* name() const override { return kPickFirst; }
@@ -302,8 +302,8 @@ class RingHash : public LoadBalancingPolicy {
       }
 
       void Orphan() override {
-        // Hop into ExecCtx, so that we're not holding the data plane mutex
-        // while we run control-plane code.
+        // Hop into ExecCtx, so that we're not running control-plane code
+        // from within the pick.
         ExecCtx::Run(DEBUG_LOCATION, &closure_, GRPC_ERROR_NONE);
       }
 
@@ -125,6 +125,8 @@ const Duration kDefaultThrottleWindowSize = Duration::Seconds(30);
 const double kDefaultThrottleRatioForSuccesses = 2.0;
 const int kDefaultThrottlePadding = 8;
 const Duration kCacheCleanupTimerInterval = Duration::Minutes(1);
+// Fraction of the stale age after which picks refresh an entry.
+const double kCacheRefreshAheadFraction = 0.9;
 const int64_t kMaxCacheSizeBytes = 5 * 1024 * 1024;
 
 // Parsed RLS LB policy configuration.
@@ -271,7 +273,8 @@ class RlsLb : public LoadBalancingPolicy {
 
     const std::string& target() const { return target_; }
 
-    PickResult Pick(PickArgs args) ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+    PickResult Pick(PickArgs args) ABSL_LOCKS_EXCLUDED(picker_mu_) {
+      MutexLock lock(&picker_mu_);
       return picker_->Pick(args);
     }
 
@@ -288,9 +291,9 @@ class RlsLb : public LoadBalancingPolicy {
     // policy's UpdateLocked() method from MaybeFinishUpdate() while
     // holding the lock, since that would cause a deadlock: the child's
     // UpdateLocked() will call the helper's UpdateState() method, which
-    // will try to acquire the lock to set picker_.  So StartUpdate() is
-    // called while we are still holding the lock, but MaybeFinishUpdate()
-    // is called after releasing it.
+    // will try to acquire the lock to update the RLS policy's picker.
+    // So StartUpdate() is called while we are still holding the lock,
+    // but MaybeFinishUpdate() is called after releasing it.
     //
     // Both methods grab the data they need from the parent object.
     void StartUpdate() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
@@ -309,7 +312,8 @@ class RlsLb : public LoadBalancingPolicy {
     // TRANSIENT_FAILURE state instead of the actual state of the child policy
     // until the child policy reports another READY state.
     grpc_connectivity_state connectivity_state() const
-        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+        ABSL_LOCKS_EXCLUDED(picker_mu_) {
+      MutexLock lock(&picker_mu_);
       return connectivity_state_;
     }
 
@@ -346,35 +350,33 @@ class RlsLb : public LoadBalancingPolicy {
     OrphanablePtr<ChildPolicyHandler> child_policy_;
     RefCountedPtr<LoadBalancingPolicy::Config> pending_config_;
 
-    grpc_connectivity_state connectivity_state_ ABSL_GUARDED_BY(&RlsLb::mu_) =
+    // Guards the child's state and picker, so that picks for different
+    // targets do not contend with each other or with the LB policy's lock.
+    mutable Mutex picker_mu_;
+    grpc_connectivity_state connectivity_state_ ABSL_GUARDED_BY(picker_mu_) =
         GRPC_CHANNEL_IDLE;
     std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker_
-        ABSL_GUARDED_BY(&RlsLb::mu_);
-  };
-
-  // A picker that uses the cache and the request map in the LB policy
-  // (synchronized via a mutex) to determine how to route requests.
-  class Picker : public LoadBalancingPolicy::SubchannelPicker {
-   public:
-    explicit Picker(RefCountedPtr<RlsLb> lb_policy);
-    ~Picker() override;
-
-    PickResult Pick(PickArgs args) override;
-
-   private:
-    RefCountedPtr<RlsLb> lb_policy_;
-    RefCountedPtr<RlsLbConfig> config_;
-    RefCountedPtr<ChildPolicyWrapper> default_child_policy_;
+        ABSL_GUARDED_BY(picker_mu_);
   };
 
   // An LRU cache with adjustable size.
+  //
+  // The cache is split into shards by key, each with its own lock, map,
+  // and LRU list, so that picks for different keys do not contend.
+  // Picks only look up and touch entries.  Entries are added and removed
+  // only while also holding the LB policy's mutex, which also guards the
+  // total size of the cache.  The lock order is RlsLb::mu_, then a shard's
+  // mu, then a ChildPolicyWrapper's picker_mu_.
   class Cache {
    public:
     using Iterator = std::list<RequestKey>::iterator;
 
+    class Shard;
+
     class Entry : public InternallyRefCounted<Entry> {
      public:
-      Entry(RefCountedPtr<RlsLb> lb_policy, const RequestKey& key);
+      Entry(RefCountedPtr<RlsLb> lb_policy, Shard* shard,
+            const RequestKey& key) ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu);
 
       // Notify the entry when it's evicted from the cache. Performs shut down.
       // Note: We are forced to disable lock analysis here because
@@ -382,66 +384,85 @@ class RlsLb : public LoadBalancingPolicy {
       // annotations for this particular caller.
       void Orphan() override ABSL_NO_THREAD_SAFETY_ANALYSIS;
 
+      Shard* shard() const { return shard_; }
+
       const absl::Status& status() const
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu) {
         return status_;
       }
-      Timestamp backoff_time() const
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+      Timestamp backoff_time() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu) {
         return backoff_time_;
       }
       Timestamp backoff_expiration_time() const
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu) {
         return backoff_expiration_time_;
       }
       Timestamp data_expiration_time() const
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu) {
         return data_expiration_time_;
       }
       const std::string& header_data() const
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu) {
         return header_data_;
       }
-      Timestamp stale_time() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+      Timestamp stale_time() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu) {
         return stale_time_;
       }
+      Timestamp refresh_time() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu) {
+        return refresh_time_;
+      }
       Timestamp min_expiration_time() const
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu) {
         return min_expiration_time_;
       }
+      Timestamp last_used_time() const
+          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu) {
+        return last_used_time_;
+      }
 
       std::unique_ptr<BackOff> TakeBackoffState()
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu) {
         return std::move(backoff_state_);
       }
 
+      // Marks the entry as having a background refresh pending.  Returns
+      // false if one already was.
+      bool MarkRefreshPending() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu) {
+        if (refresh_pending_) return false;
+        refresh_pending_ = true;
+        return true;
+      }
+      void ClearRefreshPending() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu) {
+        refresh_pending_ = false;
+      }
+
       // Cache size of entry.
-      size_t Size() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+      size_t Size() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu);
 
       // Pick subchannel for request based on the entry's state.
-      PickResult Pick(PickArgs args) ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+      PickResult Pick(PickArgs args) ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu);
 
       // If the cache entry is in backoff state, resets the backoff and, if
       // applicable, its backoff timer. The method does not update the LB
       // policy's picker; the caller is responsible for that if necessary.
-      void ResetBackoff() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+      void ResetBackoff() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu);
 
       // Check if the entry should be removed by the clean-up timer.
-      bool ShouldRemove() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+      bool ShouldRemove() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu);
 
       // Check if the entry can be evicted from the cache, i.e. the
       // min_expiration_time_ has passed.
-      bool CanEvict() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+      bool CanEvict() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu);
 
       // Updates the entry upon reception of a new RLS response.
       // Returns a list of child policy wrappers on which FinishUpdate()
       // needs to be called after releasing the lock.
       std::vector<ChildPolicyWrapper*> OnRlsResponseLocked(
           ResponseInfo response, std::unique_ptr<BackOff> backoff_state)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_, &Shard::mu);
 
       // Moves entry to the end of the LRU list.
-      void MarkUsed() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+      void MarkUsed() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu);
 
      private:
       class BackoffTimer : public InternallyRefCounted<BackoffTimer> {
@@ -457,49 +478,74 @@ class RlsLb : public LoadBalancingPolicy {
         static void OnBackoffTimer(void* args, grpc_error_handle error);
 
         RefCountedPtr<Entry> entry_;
-        bool armed_ ABSL_GUARDED_BY(&RlsLb::mu_) = true;
+        bool armed_ ABSL_GUARDED_BY(&Shard::mu) = true;
         grpc_timer backoff_timer_;
         grpc_closure backoff_timer_callback_;
       };
 
       RefCountedPtr<RlsLb> lb_policy_;
+      Shard* const shard_;
 
-      bool is_shutdown_ ABSL_GUARDED_BY(&RlsLb::mu_) = false;
+      bool is_shutdown_ ABSL_GUARDED_BY(&Shard::mu) = false;
 
       // Backoff states
-      absl::Status status_ ABSL_GUARDED_BY(&RlsLb::mu_);
-      std::unique_ptr<BackOff> backoff_state_ ABSL_GUARDED_BY(&RlsLb::mu_);
-      Timestamp backoff_time_ ABSL_GUARDED_BY(&RlsLb::mu_) =
+      absl::Status status_ ABSL_GUARDED_BY(&Shard::mu);
+      std::unique_ptr<BackOff> backoff_state_ ABSL_GUARDED_BY(&Shard::mu);
+      Timestamp backoff_time_ ABSL_GUARDED_BY(&Shard::mu) =
           Timestamp::InfPast();
-      Timestamp backoff_expiration_time_ ABSL_GUARDED_BY(&RlsLb::mu_) =
+      Timestamp backoff_expiration_time_ ABSL_GUARDED_BY(&Shard::mu) =
           Timestamp::InfPast();
       OrphanablePtr<BackoffTimer> backoff_timer_;
 
       // RLS response states
       std::vector<RefCountedPtr<ChildPolicyWrapper>> child_policy_wrappers_
-          ABSL_GUARDED_BY(&RlsLb::mu_);
-      std::string header_data_ ABSL_GUARDED_BY(&RlsLb::mu_);
-      Timestamp data_expiration_time_ ABSL_GUARDED_BY(&RlsLb::mu_) =
+          ABSL_GUARDED_BY(&Shard::mu);
+      std::string header_data_ ABSL_GUARDED_BY(&Shard::mu);
+      Timestamp data_expiration_time_ ABSL_GUARDED_BY(&Shard::mu) =
+          Timestamp::InfPast();
+      Timestamp stale_time_ ABSL_GUARDED_BY(&Shard::mu) = Timestamp::InfPast();
+
+      // Picks after this time start a background refresh of the data, so
+      // that entries in use are refreshed before they go stale.
+      Timestamp refresh_time_ ABSL_GUARDED_BY(&Shard::mu) =
           Timestamp::InfPast();
-      Timestamp stale_time_ ABSL_GUARDED_BY(&RlsLb::mu_) = Timestamp::InfPast();
+      bool refresh_pending_ ABSL_GUARDED_BY(&Shard::mu) = false;
 
-      Timestamp min_expiration_time_ ABSL_GUARDED_BY(&RlsLb::mu_);
-      Cache::Iterator lru_iterator_ ABSL_GUARDED_BY(&RlsLb::mu_);
+      Timestamp min_expiration_time_ ABSL_GUARDED_BY(&Shard::mu);
+      Timestamp last_used_time_ ABSL_GUARDED_BY(&Shard::mu);
+      Cache::Iterator lru_iterator_ ABSL_GUARDED_BY(&Shard::mu);
+    };
+
+    // A slice of the cache.  The shard for a key is fixed.
+    class Shard {
+     public:
+      // Finds an entry from the shard that corresponds to a key. If an
+      // entry is not found, nullptr is returned. Otherwise, the entry is
+      // considered recently used and its order in the LRU list of the shard
+      // is updated.
+      Entry* Find(const RequestKey& key) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+
+      Mutex mu;
+      std::list<RequestKey> lru_list ABSL_GUARDED_BY(mu);
+      std::unordered_map<RequestKey, OrphanablePtr<Entry>,
+                         absl::Hash<RequestKey>>
+          map ABSL_GUARDED_BY(mu);
     };
 
     explicit Cache(RlsLb* lb_policy);
 
-    // Finds an entry from the cache that corresponds to a key. If an entry is
-    // not found, nullptr is returned. Otherwise, the entry is considered
-    // recently used and its order in the LRU list of the cache is updated.
-    Entry* Find(const RequestKey& key)
-        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+    // Returns the shard that holds the entry for key.
+    Shard* ShardForKey(const RequestKey& key) {
+      return &shards_[absl::Hash<RequestKey>()(key) % kNumShards];
+    }
 
     // Finds an entry from the cache that corresponds to a key. If an entry is
     // not found, an entry is created, inserted in the cache, and returned to
     // the caller. Otherwise, the entry found is returned to the caller. The
     // entry returned to the user is considered recently used and its order in
-    // the LRU list of the cache is updated.
+    // the LRU list of the cache is updated.  Since entries are only removed
+    // while holding RlsLb::mu_, the entry stays valid until the caller
+    // releases it, but the caller must lock the entry's shard to use it.
     Entry* FindOrInsert(const RequestKey& key)
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
@@ -515,13 +561,18 @@ class RlsLb : public LoadBalancingPolicy {
     void Shutdown() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
    private:
+    // Enough shards that concurrent picks rarely share one.
+    static constexpr size_t kNumShards = 16;
+
     static void OnCleanupTimer(void* arg, grpc_error_handle error);
 
     // Returns the entry size for a given key.
     static size_t EntrySizeForKey(const RequestKey& key);
 
     // Evicts oversized cache elements when the current size is greater than
-    // the specified limit.
+    // the specified limit.  Entries are evicted in approximately LRU
+    // order: each shard's LRU list is exact, and the shard to evict from
+    // is the one whose least recently used entry was used longest ago.
     void MaybeShrinkSize(size_t bytes)
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
@@ -530,13 +581,35 @@ class RlsLb : public LoadBalancingPolicy {
     size_t size_limit_ ABSL_GUARDED_BY(&RlsLb::mu_) = 0;
     size_t size_ ABSL_GUARDED_BY(&RlsLb::mu_) = 0;
 
-    std::list<RequestKey> lru_list_ ABSL_GUARDED_BY(&RlsLb::mu_);
-    std::unordered_map<RequestKey, OrphanablePtr<Entry>, absl::Hash<RequestKey>>
-        map_ ABSL_GUARDED_BY(&RlsLb::mu_);
+    Shard shards_[kNumShards];
     grpc_timer cleanup_timer_;
     grpc_closure timer_callback_;
   };
 
+  // A picker that uses the cache and the request map in the LB policy
+  // to determine how to route requests.  Picks that can be answered from
+  // the cache hold only the lock of the cache shard for their key; the
+  // LB policy's mutex is needed only to start RLS requests.
+  class Picker : public LoadBalancingPolicy::SubchannelPicker {
+   public:
+    explicit Picker(RefCountedPtr<RlsLb> lb_policy);
+    ~Picker() override;
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    // Picks using the data or the backoff state of a cache entry.
+    // Returns absl::nullopt if the entry has neither, in which case an
+    // RLS request is needed.
+    absl::optional<PickResult> PickFromEntry(Cache::Entry* entry,
+                                             PickArgs args, Timestamp now)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Cache::Shard::mu);
+
+    RefCountedPtr<RlsLb> lb_policy_;
+    RefCountedPtr<RlsLbConfig> config_;
+    RefCountedPtr<ChildPolicyWrapper> default_child_policy_;
+  };
+
   // Channel for communicating with the RLS server.
   // Contains throttling logic for RLS requests.
   class RlsChannel : public InternallyRefCounted<RlsChannel> {
@@ -686,6 +759,14 @@ class RlsLb : public LoadBalancingPolicy {
   // Updates the picker in the work serializer.
   void UpdatePickerLocked() ABSL_LOCKS_EXCLUDED(&mu_);
 
+  // Starts an RLS request for key in the background, so that a pick can
+  // keep using the entry's current data without waiting for the lock.
+  // Safe to invoke while holding the lock of the key's cache shard.
+  void RefreshCacheEntryAsync(const RequestKey& key);
+  // Takes the lock and starts the request, unless it is no longer needed.
+  static void RefreshCacheEntryCallback(void* arg, grpc_error_handle error);
+  void RefreshCacheEntry(const RequestKey& key) ABSL_LOCKS_EXCLUDED(&mu_);
+
   // The name of the server for the channel.
   std::string server_name_;
 
@@ -693,7 +774,8 @@ class RlsLb : public LoadBalancingPolicy {
   Mutex mu_;
   bool is_shutdown_ ABSL_GUARDED_BY(mu_) = false;
   bool update_in_progress_ = false;
-  Cache cache_ ABSL_GUARDED_BY(mu_);
+  // Each shard of the cache has its own lock.
+  Cache cache_;
   // Maps an RLS request key to an RlsRequest object that represents a pending
   // RLS request.
   std::unordered_map<RequestKey, OrphanablePtr<RlsRequest>,
@@ -740,6 +822,7 @@ void RlsLb::ChildPolicyWrapper::Orphan() {
                                      lb_policy_->interested_parties());
     child_policy_.reset();
   }
+  MutexLock lock(&picker_mu_);
   picker_.reset();
 }
 
@@ -804,8 +887,11 @@ void RlsLb::ChildPolicyWrapper::StartUpdate() {
               child_policy_config.Dump().c_str());
     }
     pending_config_.reset();
-    picker_ = absl::make_unique<TransientFailurePicker>(
-        grpc_error_to_absl_status(error));
+    {
+      MutexLock lock(&picker_mu_);
+      picker_ = absl::make_unique<TransientFailurePicker>(
+          grpc_error_to_absl_status(error));
+    }
     GRPC_ERROR_UNREF(error);
     child_policy_.reset();
   }
@@ -878,8 +964,8 @@ void RlsLb::ChildPolicyWrapper::ChildPolicyHelper::UpdateState(
             status.ToString().c_str(), picker.get());
   }
   {
-    MutexLock lock(&wrapper_->lb_policy_->mu_);
     if (wrapper_->is_shutdown_) return;
+    MutexLock lock(&wrapper_->picker_mu_);
     if (wrapper_->connectivity_state_ == GRPC_CHANNEL_TRANSIENT_FAILURE &&
         state != GRPC_CHANNEL_READY) {
       return;
@@ -1015,13 +1101,33 @@ LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
             lb_policy_.get(), this, key.ToString().c_str());
   }
   Timestamp now = ExecCtx::Get()->Now();
+  Cache::Shard* shard = lb_policy_->cache_.ShardForKey(key);
+  // If there is a cache entry with non-expired data, or one in backoff,
+  // the pick does not need to start an RLS request, so it needs only the
+  // lock of the key's shard.  Data that is stale, or about to be, is
+  // refreshed in the background.
+  {
+    MutexLock lock(&shard->mu);
+    Cache::Entry* entry = shard->Find(key);
+    if (entry != nullptr) {
+      if (entry->data_expiration_time() >= now &&
+          entry->refresh_time() < now && entry->backoff_time() < now &&
+          entry->MarkRefreshPending()) {
+        lb_policy_->RefreshCacheEntryAsync(key);
+      }
+      absl::optional<PickResult> result = PickFromEntry(entry, args, now);
+      if (result.has_value()) return std::move(*result);
+    }
+  }
   MutexLock lock(&lb_policy_->mu_);
   if (lb_policy_->is_shutdown_) {
     return PickResult::Fail(
         absl::UnavailableError("LB policy already shut down"));
   }
-  // Check if there's a cache entry.
-  Cache::Entry* entry = lb_policy_->cache_.Find(key);
+  // Check again, since the entry may have changed after we released the
+  // shard's lock.
+  MutexLock shard_lock(&shard->mu);
+  Cache::Entry* entry = shard->Find(key);
   // If there is no cache entry, or if the cache entry is not in backoff
   // and has a stale time in the past, and there is not already a
   // pending RLS request for this key, then try to start a new RLS request.
@@ -1059,33 +1165,8 @@ LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
   }
   // If the cache entry exists, see if it has usable data.
   if (entry != nullptr) {
-    // If the entry has non-expired data, use it.
-    if (entry->data_expiration_time() >= now) {
-      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
-        gpr_log(GPR_INFO, "[rlslb %p] picker=%p: using cache entry %p",
-                lb_policy_.get(), this, entry);
-      }
-      return entry->Pick(args);
-    }
-    // If the entry is in backoff, then use the default target if set,
-    // or else fail the pick.
-    if (entry->backoff_time() >= now) {
-      if (default_child_policy_ != nullptr) {
-        if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
-          gpr_log(
-              GPR_INFO,
-              "[rlslb %p] picker=%p: RLS call in backoff; using default target",
-              lb_policy_.get(), this);
-        }
-        return default_child_policy_->Pick(args);
-      }
-      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
-        gpr_log(GPR_INFO,
-                "[rlslb %p] picker=%p: RLS call in backoff; failing pick",
-                lb_policy_.get(), this);
-      }
-      return PickResult::Fail(entry->status());
-    }
+    absl::optional<PickResult> result = PickFromEntry(entry, args, now);
+    if (result.has_value()) return std::move(*result);
   }
   // RLS call pending.  Queue the pick.
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
@@ -1095,6 +1176,38 @@ LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
   return PickResult::Queue();
 }
 
+absl::optional<LoadBalancingPolicy::PickResult> RlsLb::Picker::PickFromEntry(
+    Cache::Entry* entry, PickArgs args, Timestamp now) {
+  // If the entry has non-expired data, use it.
+  if (entry->data_expiration_time() >= now) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
+      gpr_log(GPR_INFO, "[rlslb %p] picker=%p: using cache entry %p",
+              lb_policy_.get(), this, entry);
+    }
+    return entry->Pick(args);
+  }
+  // If the entry is in backoff, then use the default target if set,
+  // or else fail the pick.
+  if (entry->backoff_time() >= now) {
+    if (default_child_policy_ != nullptr) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
+        gpr_log(
+            GPR_INFO,
+            "[rlslb %p] picker=%p: RLS call in backoff; using default target",
+            lb_policy_.get(), this);
+      }
+      return default_child_policy_->Pick(args);
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
+      gpr_log(GPR_INFO,
+              "[rlslb %p] picker=%p: RLS call in backoff; failing pick",
+              lb_policy_.get(), this);
+    }
+    return PickResult::Fail(entry->status());
+  }
+  return absl::nullopt;
+}
+
 //
 // RlsLb::Cache::Entry::BackoffTimer
 //
@@ -1122,7 +1235,7 @@ void RlsLb::Cache::Entry::BackoffTimer::OnBackoffTimer(
       [self]() {
         RefCountedPtr<BackoffTimer> backoff_timer(self);
         {
-          MutexLock lock(&self->entry_->lb_policy_->mu_);
+          MutexLock lock(&self->entry_->shard_->mu);
           if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
             gpr_log(GPR_INFO,
                     "[rlslb %p] cache entry=%p %s, armed_=%d: "
@@ -1157,15 +1270,16 @@ std::unique_ptr<BackOff> MakeCacheEntryBackoff() {
           .set_max_backoff(kCacheBackoffMax));
 }
 
-RlsLb::Cache::Entry::Entry(RefCountedPtr<RlsLb> lb_policy,
+RlsLb::Cache::Entry::Entry(RefCountedPtr<RlsLb> lb_policy, Shard* shard,
                            const RequestKey& key)
     : InternallyRefCounted<Entry>(
           GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace) ? "CacheEntry" : nullptr),
       lb_policy_(std::move(lb_policy)),
+      shard_(shard),
       backoff_state_(MakeCacheEntryBackoff()),
       min_expiration_time_(ExecCtx::Get()->Now() + kMinExpirationTime),
-      lru_iterator_(lb_policy_->cache_.lru_list_.insert(
-          lb_policy_->cache_.lru_list_.end(), key)) {}
+      last_used_time_(ExecCtx::Get()->Now()),
+      lru_iterator_(shard_->lru_list.insert(shard_->lru_list.end(), key)) {}
 
 void RlsLb::Cache::Entry::Orphan() {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
@@ -1173,8 +1287,8 @@ void RlsLb::Cache::Entry::Orphan() {
             lb_policy_.get(), this, lru_iterator_->ToString().c_str());
   }
   is_shutdown_ = true;
-  lb_policy_->cache_.lru_list_.erase(lru_iterator_);
-  lru_iterator_ = lb_policy_->cache_.lru_list_.end();  // Just in case.
+  shard_->lru_list.erase(lru_iterator_);
+  lru_iterator_ = shard_->lru_list.end();  // Just in case.
   backoff_state_.reset();
   if (backoff_timer_ != nullptr) {
     backoff_timer_.reset();
@@ -1249,10 +1363,9 @@ bool RlsLb::Cache::Entry::CanEvict() const {
 }
 
 void RlsLb::Cache::Entry::MarkUsed() {
-  auto& lru_list = lb_policy_->cache_.lru_list_;
-  auto new_it = lru_list.insert(lru_list.end(), *lru_iterator_);
-  lru_list.erase(lru_iterator_);
-  lru_iterator_ = new_it;
+  auto& lru_list = shard_->lru_list;
+  lru_list.splice(lru_list.end(), lru_list, lru_iterator_);
+  last_used_time_ = ExecCtx::Get()->Now();
 }
 
 std::vector<RlsLb::ChildPolicyWrapper*>
@@ -1260,6 +1373,8 @@ RlsLb::Cache::Entry::OnRlsResponseLocked(
     ResponseInfo response, std::unique_ptr<BackOff> backoff_state) {
   // Move the entry to the end of the LRU list.
   MarkUsed();
+  // Any refresh in flight is done.
+  refresh_pending_ = false;
   // If the request failed, store the failed status and update the
   // backoff state.
   if (!response.status.ok()) {
@@ -1282,12 +1397,14 @@ RlsLb::Cache::Entry::OnRlsResponseLocked(
   Timestamp now = ExecCtx::Get()->Now();
   data_expiration_time_ = now + lb_policy_->config_->max_age();
   stale_time_ = now + lb_policy_->config_->stale_age();
+  refresh_time_ =
+      now + lb_policy_->config_->stale_age() * kCacheRefreshAheadFraction;
   status_ = absl::OkStatus();
   backoff_state_.reset();
   backoff_time_ = Timestamp::InfPast();
   backoff_expiration_time_ = Timestamp::InfPast();
   // Check if we need to update this list of targets.
-  bool targets_changed = [&]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+  bool targets_changed = [&]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Shard::mu) {
     if (child_policy_wrappers_.size() != response.targets.size()) return true;
     for (size_t i = 0; i < response.targets.size(); ++i) {
       if (child_policy_wrappers_[i]->target() != response.targets[i]) {
@@ -1340,6 +1457,17 @@ RlsLb::Cache::Entry::OnRlsResponseLocked(
   return child_policies_to_finish_update;
 }
 
+//
+// RlsLb::Cache::Shard
+//
+
+RlsLb::Cache::Entry* RlsLb::Cache::Shard::Find(const RequestKey& key) {
+  auto it = map.find(key);
+  if (it == map.end()) return nullptr;
+  it->second->MarkUsed();
+  return it->second.get();
+}
+
 //
 // RlsLb::Cache
 //
@@ -1352,36 +1480,34 @@ RlsLb::Cache::Cache(RlsLb* lb_policy) : lb_policy_(lb_policy) {
                   &timer_callback_);
 }
 
-RlsLb::Cache::Entry* RlsLb::Cache::Find(const RequestKey& key) {
-  auto it = map_.find(key);
-  if (it == map_.end()) return nullptr;
-  it->second->MarkUsed();
-  return it->second.get();
-}
-
 RlsLb::Cache::Entry* RlsLb::Cache::FindOrInsert(const RequestKey& key) {
-  auto it = map_.find(key);
-  // If not found, create new entry.
-  if (it == map_.end()) {
-    size_t entry_size = EntrySizeForKey(key);
-    MaybeShrinkSize(size_limit_ - std::min(size_limit_, entry_size));
-    Entry* entry =
-        new Entry(lb_policy_->Ref(DEBUG_LOCATION, "CacheEntry"), key);
-    map_.emplace(key, OrphanablePtr<Entry>(entry));
-    size_ += entry_size;
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
-      gpr_log(GPR_INFO, "[rlslb %p] key=%s: cache entry added, entry=%p",
-              lb_policy_, key.ToString().c_str(), entry);
+  Shard* shard = ShardForKey(key);
+  {
+    MutexLock lock(&shard->mu);
+    Entry* entry = shard->Find(key);
+    // Entry found, so use it.
+    if (entry != nullptr) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
+        gpr_log(GPR_INFO, "[rlslb %p] key=%s: found cache entry %p",
+                lb_policy_, key.ToString().c_str(), entry);
+      }
+      return entry;
     }
-    return entry;
   }
-  // Entry found, so use it.
+  // Not found, so create new entry.  Eviction takes the shard locks
+  // itself, so this must be done without holding any of them.
+  size_t entry_size = EntrySizeForKey(key);
+  MaybeShrinkSize(size_limit_ - std::min(size_limit_, entry_size));
+  MutexLock lock(&shard->mu);
+  Entry* entry =
+      new Entry(lb_policy_->Ref(DEBUG_LOCATION, "CacheEntry"), shard, key);
+  shard->map.emplace(key, OrphanablePtr<Entry>(entry));
+  size_ += entry_size;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
-    gpr_log(GPR_INFO, "[rlslb %p] key=%s: found cache entry %p", lb_policy_,
-            key.ToString().c_str(), it->second.get());
+    gpr_log(GPR_INFO, "[rlslb %p] key=%s: cache entry added, entry=%p",
+            lb_policy_, key.ToString().c_str(), entry);
   }
-  it->second->MarkUsed();
-  return it->second.get();
+  return entry;
 }
 
 void RlsLb::Cache::Resize(size_t bytes) {
@@ -1394,15 +1520,21 @@ void RlsLb::Cache::Resize(size_t bytes) {
 }
 
 void RlsLb::Cache::ResetAllBackoff() {
-  for (auto& p : map_) {
-    p.second->ResetBackoff();
+  for (Shard& shard : shards_) {
+    MutexLock lock(&shard.mu);
+    for (auto& p : shard.map) {
+      p.second->ResetBackoff();
+    }
   }
   lb_policy_->UpdatePickerAsync();
 }
 
 void RlsLb::Cache::Shutdown() {
-  map_.clear();
-  lru_list_.clear();
+  for (Shard& shard : shards_) {
+    MutexLock lock(&shard.mu);
+    shard.map.clear();
+    shard.lru_list.clear();
+  }
   grpc_timer_cancel(&cleanup_timer_);
 }
 
@@ -1419,13 +1551,16 @@ void RlsLb::Cache::OnCleanupTimer(void* arg, grpc_error_handle error) {
         if (error == GRPC_ERROR_CANCELLED) return;
         MutexLock lock(&lb_policy->mu_);
         if (lb_policy->is_shutdown_) return;
-        for (auto it = cache->map_.begin(); it != cache->map_.end();) {
-          if (GPR_UNLIKELY(it->second->ShouldRemove() &&
-                           it->second->CanEvict())) {
-            cache->size_ -= it->second->Size();
-            it = cache->map_.erase(it);
-          } else {
-            ++it;
+        for (Shard& shard : cache->shards_) {
+          MutexLock shard_lock(&shard.mu);
+          for (auto it = shard.map.begin(); it != shard.map.end();) {
+            if (GPR_UNLIKELY(it->second->ShouldRemove() &&
+                             it->second->CanEvict())) {
+              cache->size_ -= it->second->Size();
+              it = shard.map.erase(it);
+            } else {
+              ++it;
+            }
           }
         }
         Timestamp now = ExecCtx::Get()->Now();
@@ -1444,17 +1579,33 @@ size_t RlsLb::Cache::EntrySizeForKey(const RequestKey& key) {
 
 void RlsLb::Cache::MaybeShrinkSize(size_t bytes) {
   while (size_ > bytes) {
-    auto lru_it = lru_list_.begin();
-    if (GPR_UNLIKELY(lru_it == lru_list_.end())) break;
-    auto map_it = map_.find(*lru_it);
-    GPR_ASSERT(map_it != map_.end());
+    // Find the shard whose least recently used entry was used longest ago.
+    Shard* lru_shard = nullptr;
+    Timestamp lru_time = Timestamp::InfFuture();
+    for (Shard& shard : shards_) {
+      MutexLock lock(&shard.mu);
+      if (shard.lru_list.empty()) continue;
+      auto map_it = shard.map.find(shard.lru_list.front());
+      GPR_ASSERT(map_it != shard.map.end());
+      if (lru_shard == nullptr || map_it->second->last_used_time() < lru_time) {
+        lru_shard = &shard;
+        lru_time = map_it->second->last_used_time();
+      }
+    }
+    if (GPR_UNLIKELY(lru_shard == nullptr)) break;
+    MutexLock lock(&lru_shard->mu);
+    // A pick may have used the entry since, in which case this evicts the
+    // shard's new least recently used entry, which is nearly as old.
+    auto lru_it = lru_shard->lru_list.begin();
+    auto map_it = lru_shard->map.find(*lru_it);
+    GPR_ASSERT(map_it != lru_shard->map.end());
     if (!map_it->second->CanEvict()) break;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
       gpr_log(GPR_INFO, "[rlslb %p] LRU eviction: removing entry %p %s",
               lb_policy_, map_it->second.get(), lru_it->ToString().c_str());
     }
     size_ -= map_it->second->Size();
-    map_.erase(map_it);
+    lru_shard->map.erase(map_it);
   }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
     gpr_log(GPR_INFO,
@@ -1809,6 +1960,7 @@ void RlsLb::RlsRequest::OnRlsCallCompleteLocked(grpc_error_handle error) {
     if (lb_policy_->is_shutdown_) return;
     rls_channel_->ReportResponseLocked(response.status.ok());
     Cache::Entry* cache_entry = lb_policy_->cache_.FindOrInsert(key_);
+    MutexLock shard_lock(&cache_entry->shard()->mu);
     child_policies_to_finish_update = cache_entry->OnRlsResponseLocked(
         std::move(response), std::move(backoff_state_));
     lb_policy_->request_map_.erase(key_);
@@ -2134,6 +2286,48 @@ void RlsLb::UpdatePickerLocked() {
       state, status, absl::make_unique<Picker>(Ref(DEBUG_LOCATION, "Picker")));
 }
 
+void RlsLb::RefreshCacheEntryAsync(const RequestKey& key) {
+  // Run via the ExecCtx, since the caller may be holding a shard's lock,
+  // which must not be held when acquiring mu_.
+  auto* args = new std::pair<RefCountedPtr<RlsLb>, RequestKey>(
+      Ref(DEBUG_LOCATION, "RefreshCacheEntry"), key);
+  ExecCtx::Run(DEBUG_LOCATION,
+               GRPC_CLOSURE_CREATE(RefreshCacheEntryCallback, args,
+                                   grpc_schedule_on_exec_ctx),
+               GRPC_ERROR_NONE);
+}
+
+void RlsLb::RefreshCacheEntryCallback(void* arg, grpc_error_handle /*error*/) {
+  std::unique_ptr<std::pair<RefCountedPtr<RlsLb>, RequestKey>> args(
+      static_cast<std::pair<RefCountedPtr<RlsLb>, RequestKey>*>(arg));
+  args->first->RefreshCacheEntry(args->second);
+}
+
+void RlsLb::RefreshCacheEntry(const RequestKey& key) {
+  MutexLock lock(&mu_);
+  if (is_shutdown_) return;
+  Cache::Shard* shard = cache_.ShardForKey(key);
+  MutexLock shard_lock(&shard->mu);
+  Cache::Entry* entry = shard->Find(key);
+  // The entry was evicted; the next pick for the key will start a request.
+  if (entry == nullptr) return;
+  // A request is already in flight, and its response will clear the
+  // pending refresh.
+  if (request_map_.find(key) != request_map_.end()) return;
+  // If the data has expired, picks will start the request themselves.
+  // If the request is throttled, a later pick will try again.
+  if (entry->data_expiration_time() < ExecCtx::Get()->Now() ||
+      rls_channel_->ShouldThrottle()) {
+    entry->ClearRefreshPending();
+    return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
+    gpr_log(GPR_INFO, "[rlslb %p] key=%s: refreshing cache entry %p", this,
+            key.ToString().c_str(), entry);
+  }
+  rls_channel_->StartRlsCall(key, entry);
+}
+
 //
 // RlsLbFactory
 //
@@ -0,0 +1,88 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace grpc_core {
+
+constexpr uint16_t StaticStrideScheduler::kMaxWeight;
+constexpr double StaticStrideScheduler::kMinWeightRatio;
+
+absl::optional<StaticStrideScheduler> StaticStrideScheduler::Make(
+    absl::Span<const float> float_weights,
+    std::function<uint32_t()> next_sequence_func) {
+  if (float_weights.size() < 2) return absl::nullopt;
+  size_t num_known = 0;
+  double sum = 0;
+  for (const float weight : float_weights) {
+    if (weight > 0) {
+      ++num_known;
+      sum += weight;
+    }
+  }
+  if (num_known == 0) return absl::nullopt;
+  const double mean = sum / num_known;
+  const double min_weight = mean * kMinWeightRatio;
+  double max_weight = 0;
+  for (const float weight : float_weights) {
+    max_weight = std::max(max_weight, std::max<double>(weight, min_weight));
+  }
+  // Unknown weights are replaced by the mean, so it is a candidate for the
+  // max as well.
+  const double scaling_factor = kMaxWeight / std::max(max_weight, mean);
+  std::vector<uint16_t> weights;
+  weights.reserve(float_weights.size());
+  for (const float float_weight : float_weights) {
+    double weight = float_weight > 0 ? float_weight : mean;
+    weight = std::max(weight, min_weight);
+    const long scaled = std::lround(weight * scaling_factor);
+    weights.push_back(static_cast<uint16_t>(
+        std::min<long>(std::max<long>(scaled, 1), kMaxWeight)));
+  }
+  return StaticStrideScheduler(std::move(weights),
+                               std::move(next_sequence_func));
+}
+
+StaticStrideScheduler::StaticStrideScheduler(
+    std::vector<uint16_t> weights, std::function<uint32_t()> next_sequence_func)
+    : next_sequence_func_(std::move(next_sequence_func)),
+      weights_(std::move(weights)) {}
+
+size_t StaticStrideScheduler::Pick() const {
+  while (true) {
+    const uint32_t sequence = next_sequence_func_();
+    const size_t index = sequence % weights_.size();
+    const uint64_t round = sequence / weights_.size();
+    const uint64_t weight = weights_[index];
+    // Over kMaxWeight consecutive rounds, (weight * round) % kMaxWeight
+    // lands in the top `weight` values about `weight` times, so the backend
+    // is picked in proportion to its weight.  The per-index offset
+    // keeps backends with equal weights from being skipped in the same
+    // rounds.
+    const uint64_t offset = index * (kMaxWeight / 2);
+    if ((weight * round + offset) % kMaxWeight >= kMaxWeight - weight) {
+      return index;
+    }
+  }
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,77 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_ROUND_ROBIN_STATIC_STRIDE_SCHEDULER_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_ROUND_ROBIN_STATIC_STRIDE_SCHEDULER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "absl/types/span.h"
+
+namespace grpc_core {
+
+// Picks indices with a frequency proportional to a fixed set of weights.
+//
+// Each pick draws the next value of a shared sequence and walks the
+// backends in round-robin order, skipping a backend in a given round
+// unless its weight says it should be picked in that round.  The skip
+// decision is a multiply and a modulus, so picks take O(1) expected time,
+// and the scheduler itself is immutable, so concurrent picks only contend
+// on the sequence counter.
+class StaticStrideScheduler {
+ public:
+  // Weights are scaled so that the largest one is kMaxWeight.
+  static constexpr uint16_t kMaxWeight = UINT16_MAX;
+  // Weights are clamped to at least this fraction of the mean weight, so
+  // that a backend reporting a very high utilization still gets some
+  // traffic and can report that it has recovered.
+  static constexpr double kMinWeightRatio = 0.1;
+
+  // Returns a scheduler for the given weights, which must be
+  // non-negative.  A weight of zero means that the weight is not yet
+  // known; such backends are given the mean of the known weights.
+  // Returns nullopt if there are fewer than two weights or if none of
+  // them are known, in which case the caller should fall back to
+  // unweighted round robin.
+  //
+  // \a next_sequence_func is called once for each round-robin step.  It
+  // must be thread-safe and should return consecutive values.
+  static absl::optional<StaticStrideScheduler> Make(
+      absl::Span<const float> float_weights,
+      std::function<uint32_t()> next_sequence_func);
+
+  // Returns the index of the picked backend.
+  size_t Pick() const;
+
+ private:
+  StaticStrideScheduler(std::vector<uint16_t> weights,
+                        std::function<uint32_t()> next_sequence_func);
+
+  std::function<uint32_t()> next_sequence_func_;
+  // Weights scaled to the range [1, kMaxWeight].
+  std::vector<uint16_t> weights_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_ROUND_ROBIN_STATIC_STRIDE_SCHEDULER_H
@@ -16,8 +16,6 @@
 
 #include <grpc/support/port_platform.h>
 
-#include <stdlib.h>
-
 #include <algorithm>
 #include <cstdint>
 #include <map>
@@ -39,6 +37,7 @@
 
 #include "src/core/ext/filters/client_channel/lb_policy.h"
 #include "src/core/ext/filters/client_channel/lb_policy/address_filtering.h"
+#include "src/core/ext/filters/client_channel/lb_policy/alias_table.h"
 #include "src/core/ext/filters/client_channel/lb_policy/child_policy_handler.h"
 #include "src/core/ext/filters/client_channel/lb_policy_factory.h"
 #include "src/core/ext/filters/client_channel/lb_policy_registry.h"
@@ -47,6 +46,7 @@
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/fast_random.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -122,20 +122,21 @@ class WeightedTargetLb : public LoadBalancingPolicy {
   // child's picker.
   class WeightedPicker : public SubchannelPicker {
    public:
-    // Maintains a weighted list of pickers from each child that is in
-    // ready state. The first element in the pair represents the end of a
-    // range proportional to the child's weight. The start of the range
-    // is the previous value in the vector and is 0 for the first element.
+    // The pickers from each child that is in ready state, along with the
+    // child's weight.
     using PickerList = absl::InlinedVector<
         std::pair<uint32_t, RefCountedPtr<ChildPickerWrapper>>, 1>;
 
-    explicit WeightedPicker(PickerList pickers)
-        : pickers_(std::move(pickers)) {}
+    explicit WeightedPicker(PickerList pickers);
 
     PickResult Pick(PickArgs args) override;
 
    private:
+    static std::vector<uint32_t> GetWeights(const PickerList& pickers);
+
     PickerList pickers_;
+    // Built once from the weights in pickers_, so that each pick is O(1).
+    AliasTable alias_table_;
   };
 
   // Each WeightedChild holds a ref to its parent WeightedTargetLb.
@@ -245,28 +246,20 @@ class WeightedTargetLb : public LoadBalancingPolicy {
 // WeightedTargetLb::WeightedPicker
 //
 
+std::vector<uint32_t> WeightedTargetLb::WeightedPicker::GetWeights(
+    const PickerList& pickers) {
+  std::vector<uint32_t> weights;
+  weights.reserve(pickers.size());
+  for (const auto& p : pickers) weights.push_back(p.first);
+  return weights;
+}
+
+WeightedTargetLb::WeightedPicker::WeightedPicker(PickerList pickers)
+    : pickers_(std::move(pickers)), alias_table_(GetWeights(pickers_)) {}
+
 WeightedTargetLb::PickResult WeightedTargetLb::WeightedPicker::Pick(
     PickArgs args) {
-  // Generate a random number in [0, total weight).
-  const uint32_t key = rand() % pickers_[pickers_.size() - 1].first;
-  // Find the index in pickers_ corresponding to key.
-  size_t mid = 0;
-  size_t start_index = 0;
-  size_t end_index = pickers_.size() - 1;
-  size_t index = 0;
-  while (end_index > start_index) {
-    mid = (start_index + end_index) / 2;
-    if (pickers_[mid].first > key) {
-      end_index = mid;
-    } else if (pickers_[mid].first < key) {
-      start_index = mid + 1;
-    } else {
-      index = mid + 1;
-      break;
-    }
-  }
-  if (index == 0) index = start_index;
-  GPR_ASSERT(pickers_[index].first > key);
+  const size_t index = alias_table_.Pick(FastRandom64());
   // Delegate to the child picker.
   return pickers_[index].second->Pick(args);
 }
@@ -355,12 +348,9 @@ void WeightedTargetLb::UpdateStateLocked() {
             "connectivity state",
             this);
   }
-  // Construct a new picker which maintains a map of all child pickers
-  // that are ready. Each child is represented by a portion of the range
-  // proportional to its weight, such that the total range is the sum of the
-  // weights of all children.
+  // Construct a new picker which maintains a list of all child pickers
+  // that are ready, along with their weights.
   WeightedPicker::PickerList picker_list;
-  uint32_t end = 0;
   // Also count the number of children in each state, to determine the
   // overall state.
   size_t num_connecting = 0;
@@ -383,8 +373,8 @@ void WeightedTargetLb::UpdateStateLocked() {
     switch (child->connectivity_state()) {
       case GRPC_CHANNEL_READY: {
         GPR_ASSERT(child->weight() > 0);
-        end += child->weight();
-        picker_list.push_back(std::make_pair(end, child->picker_wrapper()));
+        picker_list.push_back(
+            std::make_pair(child->weight(), child->picker_wrapper()));
         break;
       }
       case GRPC_CHANNEL_CONNECTING: {
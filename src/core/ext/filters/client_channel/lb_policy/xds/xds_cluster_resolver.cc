@@ -42,6 +42,7 @@
 #include "src/core/ext/filters/client_channel/lb_policy.h"
 #include "src/core/ext/filters/client_channel/lb_policy/address_filtering.h"
 #include "src/core/ext/filters/client_channel/lb_policy/child_policy_handler.h"
+#include "src/core/ext/filters/client_channel/lb_policy/maglev/maglev.h"
 #include "src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.h"
 #include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
 #include "src/core/ext/filters/client_channel/lb_policy/xds/xds.h"
@@ -506,10 +507,13 @@ void XdsClusterResolverLb::LogicalDNSDiscoveryMechanism::ResolverResultHandler::
   XdsEndpointResource::Priority::Locality locality;
   locality.name = MakeRefCounted<XdsLocalityName>("", "", "");
   locality.lb_weight = 1;
-  locality.endpoints = std::move(*result.addresses);
-  XdsEndpointResource::Priority priority;
-  priority.localities.emplace(locality.name.get(), std::move(locality));
-  update.priorities.emplace_back(std::move(priority));
+  for (const ServerAddress& address : *result.addresses) {
+    locality.endpoints.Add(address.address(), /*weight=*/0);
+  }
+  auto priorities = std::make_shared<XdsEndpointResource::PriorityList>(1);
+  (*priorities)[0].localities.emplace(locality.name.get(),
+                                      std::move(locality));
+  update.priorities = std::move(priorities);
   discovery_mechanism_->parent()->OnEndpointChanged(
       discovery_mechanism_->index(), std::move(update));
 }
@@ -638,7 +642,9 @@ void XdsClusterResolverLb::OnEndpointChanged(size_t index,
   // have a child in which to create the xds_cluster_impl policy.  This ensures
   // that we properly handle the case of a discovery mechanism dropping 100% of
   // calls, the OnError() case, and the OnResourceDoesNotExist() case.
-  if (update.priorities.empty()) update.priorities.emplace_back();
+  if (update.priorities->empty()) {
+    update.priorities = std::make_shared<XdsEndpointResource::PriorityList>(1);
+  }
   // Update priority_child_numbers, reusing old child numbers in an
   // intelligent way to avoid unnecessary churn.
   // First, build some maps from locality to child number and the reverse
@@ -648,7 +654,7 @@ void XdsClusterResolverLb::OnEndpointChanged(size_t index,
   std::map<size_t, std::set<XdsLocalityName*, XdsLocalityName::Less>>
       child_locality_map;
   if (discovery_entry.latest_update.has_value()) {
-    const auto& prev_priority_list = discovery_entry.latest_update->priorities;
+    const auto& prev_priority_list = *discovery_entry.latest_update->priorities;
     for (size_t priority = 0; priority < prev_priority_list.size();
          ++priority) {
       size_t child_number = discovery_entry.priority_child_numbers[priority];
@@ -662,8 +668,8 @@ void XdsClusterResolverLb::OnEndpointChanged(size_t index,
   }
   // Construct new list of children.
   std::vector<size_t> priority_child_numbers;
-  for (size_t priority = 0; priority < update.priorities.size(); ++priority) {
-    const auto& localities = update.priorities[priority].localities;
+  for (size_t priority = 0; priority < update.priorities->size(); ++priority) {
+    const auto& localities = (*update.priorities)[priority].localities;
     absl::optional<size_t> child_number;
     // If one of the localities in this priority already existed, reuse its
     // child number.
@@ -752,10 +758,10 @@ ServerAddressList XdsClusterResolverLb::CreateChildPolicyAddressesLocked() {
   ServerAddressList addresses;
   for (const auto& discovery_entry : discovery_mechanisms_) {
     for (size_t priority = 0;
-         priority < discovery_entry.latest_update->priorities.size();
+         priority < discovery_entry.latest_update->priorities->size();
          ++priority) {
       const auto& priority_entry =
-          discovery_entry.latest_update->priorities[priority];
+          (*discovery_entry.latest_update->priorities)[priority];
       std::string priority_child_name =
           discovery_entry.GetChildPolicyName(priority);
       for (const auto& p : priority_entry.localities) {
@@ -763,27 +769,25 @@ ServerAddressList XdsClusterResolverLb::CreateChildPolicyAddressesLocked() {
         const auto& locality = p.second;
         std::vector<std::string> hierarchical_path = {
             priority_child_name, locality_name->AsHumanReadableString()};
-        for (const auto& endpoint : locality.endpoints) {
-          const ServerAddressWeightAttribute* weight_attribute = static_cast<
-              const ServerAddressWeightAttribute*>(endpoint.GetAttribute(
-              ServerAddressWeightAttribute::kServerAddressWeightAttributeKey));
-          uint32_t weight = locality.lb_weight;
-          if (weight_attribute != nullptr) {
-            weight = locality.lb_weight * weight_attribute->weight();
-          }
-          addresses.emplace_back(
-              endpoint
-                  .WithAttribute(
-                      kHierarchicalPathAttributeKey,
-                      MakeHierarchicalPathAttribute(hierarchical_path))
-                  .WithAttribute(kXdsLocalityNameAttributeKey,
-                                 absl::make_unique<XdsLocalityAttribute>(
-                                     locality_name->Ref()))
-                  .WithAttribute(
-                      ServerAddressWeightAttribute::
-                          kServerAddressWeightAttributeKey,
-                      absl::make_unique<ServerAddressWeightAttribute>(weight)));
-        }
+        locality.endpoints.ForEach(
+            [&](const XdsEndpointResource::Priority::Locality::EndpointList::
+                    Endpoint& endpoint) {
+              uint32_t weight = locality.lb_weight;
+              if (endpoint.weight != 0) weight *= endpoint.weight;
+              std::map<const char*,
+                       std::unique_ptr<ServerAddress::AttributeInterface>>
+                  attributes;
+              attributes[kHierarchicalPathAttributeKey] =
+                  MakeHierarchicalPathAttribute(hierarchical_path);
+              attributes[kXdsLocalityNameAttributeKey] =
+                  absl::make_unique<XdsLocalityAttribute>(
+                      locality_name->Ref());
+              attributes[ServerAddressWeightAttribute::
+                             kServerAddressWeightAttributeKey] =
+                  absl::make_unique<ServerAddressWeightAttribute>(weight);
+              addresses.emplace_back(endpoint.address, nullptr,
+                                     std::move(attributes));
+            });
       }
     }
   }
@@ -797,10 +801,10 @@ XdsClusterResolverLb::CreateChildPolicyConfigLocked() {
   for (const auto& discovery_entry : discovery_mechanisms_) {
     const auto& discovery_config = discovery_entry.config();
     for (size_t priority = 0;
-         priority < discovery_entry.latest_update->priorities.size();
+         priority < discovery_entry.latest_update->priorities->size();
          ++priority) {
       const auto& priority_entry =
-          discovery_entry.latest_update->priorities[priority];
+          (*discovery_entry.latest_update->priorities)[priority];
       Json child_policy;
       if (!discovery_entry.discovery_mechanism->override_child_policy()
                .empty()) {
@@ -842,6 +846,13 @@ XdsClusterResolverLb::CreateChildPolicyConfigLocked() {
           GPR_ASSERT(it != config.end());
           (*it->second.mutable_object())["targets"] =
               std::move(weighted_targets);
+        } else if (xds_lb_policy.find("MAGLEV") != xds_lb_policy.end()) {
+          child_policy = Json::Array{
+              Json::Object{
+                  {"maglev_experimental",
+                   xds_lb_policy.find("MAGLEV")->second.object_value()},
+              },
+          };
         } else {
           auto it = xds_lb_policy.find("RING_HASH");
           GPR_ASSERT(it != xds_lb_policy.end());
@@ -1107,6 +1118,12 @@ class XdsClusterResolverLbFactory : public LoadBalancingPolicyFactory {
             ParseRingHashLbConfig(policy_it->second, &min_ring_size,
                                   &max_ring_size, &error_list);
           }
+          policy_it = policy.find("MAGLEV");
+          if (policy_it != policy.end()) {
+            xds_lb_policy = array[i];
+            uint64_t table_size;
+            ParseMaglevLbConfig(policy_it->second, &table_size, &error_list);
+          }
         }
       }
     }
@@ -73,6 +73,7 @@
 
 #include "src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_balancer_addresses.h"
 #include "src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_wrapper.h"
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_cache.h"
 #include "src/core/ext/filters/client_channel/resolver/dns/dns_resolver_selection.h"
 #include "src/core/ext/filters/client_channel/resolver/polling_resolver.h"
 #include "src/core/lib/backoff/backoff.h"
@@ -104,28 +105,27 @@ class AresClientChannelDNSResolver : public PollingResolver {
   OrphanablePtr<Orphanable> StartRequest() override;
 
  private:
+  // Runs a c-ares query on behalf of the resolver, either directly or as
+  // the fetch for a DNS cache lookup.
   class AresRequestWrapper : public InternallyRefCounted<AresRequestWrapper> {
    public:
-    explicit AresRequestWrapper(
-        RefCountedPtr<AresClientChannelDNSResolver> resolver)
-        : resolver_(std::move(resolver)) {
+    AresRequestWrapper(const AresClientChannelDNSResolver* resolver,
+                       grpc_pollset_set* interested_parties,
+                       DNSCache::ResultCallback on_done)
+        : on_done_(std::move(on_done)) {
       Ref(DEBUG_LOCATION, "OnResolved").release();
       GRPC_CLOSURE_INIT(&on_resolved_, OnResolved, this, nullptr);
       request_.reset(grpc_dns_lookup_ares(
-          resolver_->authority().c_str(), resolver_->name_to_resolve().c_str(),
-          kDefaultSecurePort, resolver_->interested_parties(), &on_resolved_,
-          &addresses_,
-          resolver_->enable_srv_queries_ ? &balancer_addresses_ : nullptr,
-          resolver_->request_service_config_ ? &service_config_json_ : nullptr,
-          resolver_->query_timeout_ms_));
+          resolver->authority().c_str(), resolver->name_to_resolve().c_str(),
+          kDefaultSecurePort, interested_parties, &on_resolved_, &addresses_,
+          resolver->enable_srv_queries_ ? &balancer_addresses_ : nullptr,
+          resolver->request_service_config_ ? &service_config_json_ : nullptr,
+          resolver->query_timeout_ms_));
       GRPC_CARES_TRACE_LOG("resolver:%p Started resolving. request_:%p",
-                           resolver_.get(), request_.get());
+                           resolver, request_.get());
     }
 
-    ~AresRequestWrapper() override {
-      gpr_free(service_config_json_);
-      resolver_.reset(DEBUG_LOCATION, "dns-resolving");
-    }
+    ~AresRequestWrapper() override { gpr_free(service_config_json_); }
 
     void Orphan() override {
       grpc_cancel_ares_request(request_.get());
@@ -136,7 +136,7 @@ class AresClientChannelDNSResolver : public PollingResolver {
     static void OnResolved(void* arg, grpc_error_handle error);
     void OnResolved(grpc_error_handle error);
 
-    RefCountedPtr<AresClientChannelDNSResolver> resolver_;
+    DNSCache::ResultCallback on_done_;
     std::unique_ptr<grpc_ares_request> request_;
     grpc_closure on_resolved_;
     // Output fields from ares request.
@@ -147,12 +147,20 @@ class AresClientChannelDNSResolver : public PollingResolver {
 
   ~AresClientChannelDNSResolver() override;
 
+  // Returns the key under which results are shared through the DNS
+  // cache.  It covers everything that affects the query.
+  std::string CacheKey() const;
+
+  void OnResolved(absl::StatusOr<DNSCache::Result> result);
+
   /// whether to request the service config
   const bool request_service_config_;
   // whether or not to enable SRV DNS queries
   const bool enable_srv_queries_;
   // timeout in milliseconds for active DNS queries
   const int query_timeout_ms_;
+  // process-wide DNS cache settings
+  const DNSCache::Options cache_options_;
 };
 
 AresClientChannelDNSResolver::AresClientChannelDNSResolver(
@@ -176,7 +184,8 @@ AresClientChannelDNSResolver::AresClientChannelDNSResolver(
           channel_args, GRPC_ARG_DNS_ENABLE_SRV_QUERIES, false)),
       query_timeout_ms_(grpc_channel_args_find_integer(
           channel_args, GRPC_ARG_DNS_ARES_QUERY_TIMEOUT_MS,
-          {GRPC_DNS_ARES_DEFAULT_QUERY_TIMEOUT_MS, 0, INT_MAX})) {}
+          {GRPC_DNS_ARES_DEFAULT_QUERY_TIMEOUT_MS, 0, INT_MAX})),
+      cache_options_(DNSCache::OptionsFromChannelArgs(channel_args)) {}
 
 AresClientChannelDNSResolver::~AresClientChannelDNSResolver() {
   GRPC_CARES_TRACE_LOG("resolver:%p destroying AresClientChannelDNSResolver",
@@ -184,8 +193,31 @@ AresClientChannelDNSResolver::~AresClientChannelDNSResolver() {
 }
 
 OrphanablePtr<Orphanable> AresClientChannelDNSResolver::StartRequest() {
-  return MakeOrphanable<AresRequestWrapper>(
-      Ref(DEBUG_LOCATION, "dns-resolving"));
+  RefCountedPtr<AresClientChannelDNSResolver> self =
+      Ref(DEBUG_LOCATION, "dns-resolving");
+  auto on_done = [self](absl::StatusOr<DNSCache::Result> result) {
+    self->OnResolved(std::move(result));
+  };
+  if (cache_options_.ttl > Duration::Zero()) {
+    // Lookup() runs the fetch, if any, before it returns.
+    auto fetch = [this](grpc_pollset_set* interested_parties,
+                        DNSCache::ResultCallback on_fetched) {
+      return MakeOrphanable<AresRequestWrapper>(this, interested_parties,
+                                                std::move(on_fetched));
+    };
+    return DNSCache::Get()->Lookup(CacheKey(), cache_options_,
+                                   interested_parties(), std::move(fetch),
+                                   std::move(on_done));
+  }
+  return MakeOrphanable<AresRequestWrapper>(this, interested_parties(),
+                                            std::move(on_done));
+}
+
+std::string AresClientChannelDNSResolver::CacheKey() const {
+  return absl::StrCat("c-ares:", authority(), "/", name_to_resolve(),
+                      enable_srv_queries_ ? ";srv" : "",
+                      request_service_config_ ? ";txt" : "",
+                      ";timeout=", query_timeout_ms_);
 }
 
 bool ValueInJsonArray(const Json::Array& array, const char* value) {
@@ -197,7 +229,7 @@ bool ValueInJsonArray(const Json::Array& array, const char* value) {
   return false;
 }
 
-std::string ChooseServiceConfig(char* service_config_choice_json,
+std::string ChooseServiceConfig(absl::string_view service_config_choice_json,
                                 grpc_error_handle* error) {
   Json json = Json::Parse(service_config_choice_json, error);
   if (*error != GRPC_ERROR_NONE) return "";
@@ -285,28 +317,46 @@ void AresClientChannelDNSResolver::AresRequestWrapper::OnResolved(
 void AresClientChannelDNSResolver::AresRequestWrapper::OnResolved(
     grpc_error_handle error) {
   GRPC_CARES_TRACE_LOG("resolver:%p OnResolved()", this);
-  Result result;
-  absl::InlinedVector<grpc_arg, 1> new_args;
   // TODO(roth): Change logic to be able to report failures for addresses
   // and service config independently of each other.
   if (addresses_ != nullptr || balancer_addresses_ != nullptr) {
-    if (addresses_ != nullptr) {
-      result.addresses = std::move(*addresses_);
-    } else {
-      result.addresses = ServerAddressList();
+    DNSCache::Result result;
+    if (addresses_ != nullptr) result.addresses = std::move(*addresses_);
+    if (balancer_addresses_ != nullptr) {
+      result.balancer_addresses = std::move(*balancer_addresses_);
     }
     if (service_config_json_ != nullptr) {
+      result.service_config_json = service_config_json_;
+    }
+    on_done_(std::move(result));
+  } else {
+    GRPC_CARES_TRACE_LOG("resolver:%p dns resolution failed: %s", this,
+                         grpc_error_std_string(error).c_str());
+    std::string error_message;
+    grpc_error_get_str(error, GRPC_ERROR_STR_DESCRIPTION, &error_message);
+    on_done_(absl::UnavailableError(error_message));
+  }
+  on_done_ = nullptr;
+  Unref(DEBUG_LOCATION, "OnResolved");
+}
+
+void AresClientChannelDNSResolver::OnResolved(
+    absl::StatusOr<DNSCache::Result> dns_result) {
+  Result result;
+  absl::InlinedVector<grpc_arg, 1> new_args;
+  if (dns_result.ok()) {
+    result.addresses = std::move(dns_result->addresses);
+    if (dns_result->service_config_json.has_value()) {
       grpc_error_handle service_config_error = GRPC_ERROR_NONE;
-      std::string service_config_string =
-          ChooseServiceConfig(service_config_json_, &service_config_error);
+      std::string service_config_string = ChooseServiceConfig(
+          *dns_result->service_config_json, &service_config_error);
       RefCountedPtr<ServiceConfig> service_config;
       if (service_config_error == GRPC_ERROR_NONE &&
           !service_config_string.empty()) {
         GRPC_CARES_TRACE_LOG("resolver:%p selected service config choice: %s",
                              this, service_config_string.c_str());
-        service_config = ServiceConfigImpl::Create(resolver_->channel_args(),
-                                                   service_config_string,
-                                                   &service_config_error);
+        service_config = ServiceConfigImpl::Create(
+            channel_args(), service_config_string, &service_config_error);
       }
       if (service_config_error != GRPC_ERROR_NONE) {
         result.service_config = absl::UnavailableError(
@@ -317,25 +367,20 @@ void AresClientChannelDNSResolver::AresRequestWrapper::OnResolved(
         result.service_config = std::move(service_config);
       }
     }
-    if (balancer_addresses_ != nullptr) {
+    if (dns_result->balancer_addresses.has_value()) {
       new_args.push_back(
-          CreateGrpclbBalancerAddressesArg(balancer_addresses_.get()));
+          CreateGrpclbBalancerAddressesArg(&*dns_result->balancer_addresses));
     }
   } else {
-    GRPC_CARES_TRACE_LOG("resolver:%p dns resolution failed: %s", this,
-                         grpc_error_std_string(error).c_str());
-    std::string error_message;
-    grpc_error_get_str(error, GRPC_ERROR_STR_DESCRIPTION, &error_message);
     absl::Status status = absl::UnavailableError(
-        absl::StrCat("DNS resolution failed for ", resolver_->name_to_resolve(),
-                     ": ", error_message));
+        absl::StrCat("DNS resolution failed for ", name_to_resolve(), ": ",
+                     dns_result.status().message()));
     result.addresses = status;
     result.service_config = status;
   }
-  result.args = grpc_channel_args_copy_and_add(
-      resolver_->channel_args(), new_args.data(), new_args.size());
-  resolver_->OnRequestComplete(std::move(result));
-  Unref(DEBUG_LOCATION, "OnResolved");
+  result.args = grpc_channel_args_copy_and_add(channel_args(), new_args.data(),
+                                               new_args.size());
+  OnRequestComplete(std::move(result));
 }
 
 //
@@ -0,0 +1,285 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_cache.h"
+
+#include <limits.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_dns_cache_trace(false, "dns_cache");
+
+//
+// DNSCache::Fetch
+//
+
+// A resolution in flight, and the lookups waiting for it.  Fields other
+// than key_ and options_ are guarded by the cache's mu_.
+class DNSCache::Fetch : public RefCounted<Fetch> {
+ public:
+  Fetch(std::string key, const Options& options)
+      : key_(std::move(key)),
+        options_(options),
+        pollset_set_(grpc_pollset_set_create()) {}
+
+  ~Fetch() override { grpc_pollset_set_destroy(pollset_set_); }
+
+  const std::string& key() const { return key_; }
+  const Options& options() const { return options_; }
+  grpc_pollset_set* pollset_set() const { return pollset_set_; }
+
+  std::vector<RefCountedPtr<Waiter>> waiters;
+  OrphanablePtr<Orphanable> request;
+  bool done = false;
+
+ private:
+  const std::string key_;
+  const Options options_;
+  grpc_pollset_set* const pollset_set_;
+};
+
+//
+// DNSCache::Waiter
+//
+
+// A lookup waiting for a fetch.  While it waits, its interested_parties
+// help drive the fetch.
+class DNSCache::Waiter : public InternallyRefCounted<Waiter> {
+ public:
+  Waiter(DNSCache* cache, RefCountedPtr<Fetch> fetch,
+         grpc_pollset_set* interested_parties, ResultCallback on_done)
+      : cache_(cache),
+        fetch_(std::move(fetch)),
+        interested_parties_(interested_parties),
+        on_done_(std::move(on_done)) {
+    if (interested_parties_ != nullptr) {
+      grpc_pollset_set_add_pollset_set(fetch_->pollset_set(),
+                                       interested_parties_);
+    }
+  }
+
+  void Orphan() override {
+    if (cache_->RemoveWaiter(this)) Detach();
+    Unref();
+  }
+
+  Fetch* fetch() const { return fetch_.get(); }
+
+  // Returns a ref for the fetch to hold while the waiter waits.
+  RefCountedPtr<Waiter> RefForFetch() { return Ref(); }
+
+  // Called once the waiter has been removed from the fetch.
+  void Complete(const absl::StatusOr<Result>& result) {
+    Detach();
+    on_done_(result);
+  }
+
+ private:
+  void Detach() {
+    if (interested_parties_ != nullptr) {
+      grpc_pollset_set_del_pollset_set(fetch_->pollset_set(),
+                                       interested_parties_);
+    }
+  }
+
+  DNSCache* cache_;
+  RefCountedPtr<Fetch> fetch_;
+  grpc_pollset_set* interested_parties_;
+  ResultCallback on_done_;
+};
+
+//
+// DNSCache
+//
+
+namespace {
+
+// Returned by Lookup() when it answered from the cache.
+class CompletedLookup : public Orphanable {
+ public:
+  void Orphan() override { delete this; }
+};
+
+}  // namespace
+
+DNSCache::DNSCache() = default;
+
+DNSCache::~DNSCache() = default;
+
+DNSCache* DNSCache::Get() {
+  static DNSCache* cache = new DNSCache();
+  return cache;
+}
+
+DNSCache::Options DNSCache::OptionsFromChannelArgs(
+    const grpc_channel_args* args) {
+  Options options;
+  options.ttl = Duration::Milliseconds(grpc_channel_args_find_integer(
+      args, GRPC_ARG_DNS_CACHE_TTL_MS, {0, 0, INT_MAX}));
+  options.max_stale = Duration::Milliseconds(grpc_channel_args_find_integer(
+      args, GRPC_ARG_DNS_CACHE_MAX_STALE_MS,
+      {static_cast<int>(options.ttl.millis()), 0, INT_MAX}));
+  return options;
+}
+
+OrphanablePtr<Orphanable> DNSCache::Lookup(const std::string& key,
+                                           const Options& options,
+                                           grpc_pollset_set* interested_parties,
+                                           FetchFunction fetch,
+                                           ResultCallback on_done) {
+  const Timestamp now = ExecCtx::Get()->Now();
+  absl::optional<Result> cached_result;
+  RefCountedPtr<Fetch> fetch_to_start;
+  OrphanablePtr<Waiter> waiter;
+  {
+    MutexLock lock(&mu_);
+    Entry& entry = entries_[key];
+    const bool usable = entry.result.has_value() && now < entry.stale_until;
+    if (usable && now < entry.fresh_until) {
+      ++stats_.hits;
+      cached_result = entry.result;
+    } else if (usable && entry.fetch != nullptr &&
+               !entry.fetch->waiters.empty()) {
+      ++stats_.stale_hits;
+      cached_result = entry.result;
+    } else {
+      // A refresh always has a lookup waiting for it, so that some
+      // interested_parties drive it.
+      if (entry.fetch == nullptr) {
+        if (usable) {
+          ++stats_.refreshes;
+        } else {
+          ++stats_.misses;
+        }
+        entry.fetch = MakeRefCounted<Fetch>(key, options);
+        fetch_to_start = entry.fetch;
+      } else {
+        ++stats_.coalesced;
+      }
+      waiter = MakeOrphanable<Waiter>(this, entry.fetch, interested_parties,
+                                      std::move(on_done));
+      entry.fetch->waiters.push_back(waiter->RefForFetch());
+    }
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_dns_cache_trace)) {
+    gpr_log(GPR_INFO, "[dns_cache %p] lookup of %s: %s%s", this, key.c_str(),
+            cached_result.has_value() ? "cached" : "waiting",
+            fetch_to_start != nullptr ? ", fetching" : "");
+  }
+  if (fetch_to_start != nullptr) {
+    StartFetch(std::move(fetch_to_start), std::move(fetch));
+  }
+  if (cached_result.has_value()) {
+    on_done(std::move(*cached_result));
+    return OrphanablePtr<Orphanable>(new CompletedLookup());
+  }
+  return waiter;
+}
+
+void DNSCache::StartFetch(RefCountedPtr<Fetch> fetch,
+                          FetchFunction fetch_function) {
+  OrphanablePtr<Orphanable> request = fetch_function(
+      fetch->pollset_set(), [this, fetch](absl::StatusOr<Result> result) {
+        OnFetchDone(fetch.get(), std::move(result));
+      });
+  {
+    MutexLock lock(&mu_);
+    // If the fetch finished already, there is nothing left to keep.
+    if (!fetch->done) fetch->request = std::move(request);
+  }
+}
+
+void DNSCache::OnFetchDone(Fetch* fetch, absl::StatusOr<Result> result) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_dns_cache_trace)) {
+    gpr_log(GPR_INFO, "[dns_cache %p] fetch of %s done: %s", this,
+            fetch->key().c_str(), result.status().ToString().c_str());
+  }
+  std::vector<RefCountedPtr<Waiter>> waiters;
+  // What the waiters get: the new result, or the stale one if a refresh
+  // failed.
+  absl::StatusOr<Result> waiter_result = result;
+  // Destroyed after the lock is released.
+  OrphanablePtr<Orphanable> request;
+  {
+    MutexLock lock(&mu_);
+    fetch->done = true;
+    waiters = std::move(fetch->waiters);
+    request = std::move(fetch->request);
+    const Timestamp now = ExecCtx::Get()->Now();
+    auto it = entries_.find(fetch->key());
+    if (it != entries_.end() && it->second.fetch.get() == fetch) {
+      Entry& entry = it->second;
+      entry.fetch.reset();
+      if (result.ok()) {
+        entry.result = *result;
+        entry.fresh_until = now + fetch->options().ttl;
+        entry.stale_until = entry.fresh_until + fetch->options().max_stale;
+      } else if (entry.result.has_value() && now < entry.stale_until) {
+        waiter_result = *entry.result;
+      } else if (!entry.result.has_value()) {
+        entries_.erase(it);
+      }
+    }
+    // Drop results that can no longer be served.
+    for (it = entries_.begin(); it != entries_.end();) {
+      if (it->second.fetch == nullptr &&
+          (!it->second.result.has_value() || now >= it->second.stale_until)) {
+        it = entries_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (auto& waiter : waiters) waiter->Complete(waiter_result);
+}
+
+bool DNSCache::RemoveWaiter(Waiter* waiter) {
+  MutexLock lock(&mu_);
+  auto& waiters = waiter->fetch()->waiters;
+  auto it = std::find_if(
+      waiters.begin(), waiters.end(),
+      [waiter](const RefCountedPtr<Waiter>& w) { return w.get() == waiter; });
+  if (it == waiters.end()) return false;
+  waiters.erase(it);
+  return true;
+}
+
+DNSCache::Stats DNSCache::stats() const {
+  MutexLock lock(&mu_);
+  return stats_;
+}
+
+void DNSCache::Clear() {
+  MutexLock lock(&mu_);
+  entries_.clear();
+  stats_ = Stats();
+}
+
+}  // namespace grpc_core
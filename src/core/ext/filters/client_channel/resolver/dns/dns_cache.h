@@ -0,0 +1,142 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESOLVER_DNS_DNS_CACHE_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESOLVER_DNS_DNS_CACHE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/statusor.h"
+#include "absl/types/optional.h"
+
+#include <grpc/impl/codegen/grpc_types.h>
+
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/iomgr_fwd.h"
+#include "src/core/lib/resolver/server_address.h"
+
+namespace grpc_core {
+
+// A process-wide cache of DNS resolution results, shared by the c-ares and
+// native DNS resolvers so that channels to the same name share lookups.
+//
+// A result is fresh for a TTL after it was fetched, and lookups during
+// that time are answered from the cache.  For a while after that, the
+// result is stale: the first lookup starts a refresh and waits for it, so
+// that its interested_parties drive the refresh, and the lookups made
+// while the refresh runs are answered with the stale result.  Concurrent
+// lookups for a name that is not cached wait for the same fetch.
+// Failures are not cached, and a failed refresh leaves the stale result in
+// place and answers the lookup that started it with that result.
+class DNSCache {
+ public:
+  // What a DNS resolution returns.  The native resolver only fills in
+  // addresses.
+  struct Result {
+    ServerAddressList addresses;
+    absl::optional<ServerAddressList> balancer_addresses;
+    // Unparsed, so that each channel can choose and parse it.
+    absl::optional<std::string> service_config_json;
+  };
+
+  using ResultCallback = std::function<void(absl::StatusOr<Result>)>;
+
+  // Starts resolving a name, driven by interested_parties.  on_done must be
+  // invoked exactly once, even if the returned request is orphaned first.
+  using FetchFunction = std::function<OrphanablePtr<Orphanable>(
+      grpc_pollset_set* interested_parties, ResultCallback on_done)>;
+
+  struct Options {
+    // How long a result is fresh.  Zero disables caching.
+    Duration ttl;
+    // How long after that a result is served while it is refreshed.
+    Duration max_stale;
+  };
+
+  struct Stats {
+    // Lookups answered with a fresh result.
+    uint64_t hits = 0;
+    // Lookups answered with a stale result while it was refreshed.
+    uint64_t stale_hits = 0;
+    // Lookups that had to wait for a fetch they started.
+    uint64_t misses = 0;
+    // Lookups that waited for a fetch another lookup started.
+    uint64_t coalesced = 0;
+    // Lookups that found a stale result and waited for a refresh they
+    // started.
+    uint64_t refreshes = 0;
+  };
+
+  DNSCache();
+  ~DNSCache();
+
+  // Returns the process-wide cache.
+  static DNSCache* Get();
+
+  // Reads options from GRPC_ARG_DNS_CACHE_TTL_MS and
+  // GRPC_ARG_DNS_CACHE_MAX_STALE_MS.
+  static Options OptionsFromChannelArgs(const grpc_channel_args* args);
+
+  // Looks up key, which must identify the name and everything that affects
+  // how it is resolved.  If there is no usable result, fetch is called to
+  // get one.  on_done is invoked exactly once, possibly before Lookup()
+  // returns and possibly after the returned request is orphaned.
+  // Orphaning the request detaches interested_parties from the fetch, but
+  // does not cancel the fetch, since other lookups may be waiting for it.
+  OrphanablePtr<Orphanable> Lookup(const std::string& key,
+                                   const Options& options,
+                                   grpc_pollset_set* interested_parties,
+                                   FetchFunction fetch,
+                                   ResultCallback on_done);
+
+  Stats stats() const;
+
+  // Drops all cached results.  For tests.
+  void Clear();
+
+ private:
+  class Fetch;
+  class Waiter;
+
+  struct Entry {
+    absl::optional<Result> result;
+    Timestamp fresh_until;
+    Timestamp stale_until;
+    RefCountedPtr<Fetch> fetch;
+  };
+
+  void StartFetch(RefCountedPtr<Fetch> fetch, FetchFunction fetch_function);
+  void OnFetchDone(Fetch* fetch, absl::StatusOr<Result> result);
+  bool RemoveWaiter(Waiter* waiter);
+
+  mutable Mutex mu_;
+  std::map<std::string, Entry> entries_ ABSL_GUARDED_BY(mu_);
+  Stats stats_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESOLVER_DNS_DNS_CACHE_H
@@ -35,6 +35,7 @@
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_cache.h"
 #include "src/core/ext/filters/client_channel/resolver/dns/dns_resolver_selection.h"
 #include "src/core/ext/filters/client_channel/resolver/polling_resolver.h"
 #include "src/core/lib/backoff/backoff.h"
@@ -88,6 +89,9 @@ class NativeClientChannelDNSResolver : public PollingResolver {
 
   void OnResolved(
       absl::StatusOr<std::vector<grpc_resolved_address>> addresses_or);
+  void OnCacheLookupDone(absl::StatusOr<DNSCache::Result> result);
+
+  const DNSCache::Options cache_options_;
 };
 
 NativeClientChannelDNSResolver::NativeClientChannelDNSResolver(
@@ -104,7 +108,8 @@ NativeClientChannelDNSResolver::NativeClientChannelDNSResolver(
               .set_jitter(GRPC_DNS_RECONNECT_JITTER)
               .set_max_backoff(Duration::Milliseconds(
                   GRPC_DNS_RECONNECT_MAX_BACKOFF_SECONDS * 1000)),
-          &grpc_trace_dns_resolver) {
+          &grpc_trace_dns_resolver),
+      cache_options_(DNSCache::OptionsFromChannelArgs(channel_args)) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_dns_resolver)) {
     gpr_log(GPR_DEBUG, "[dns_resolver=%p] created", this);
   }
@@ -117,6 +122,34 @@ NativeClientChannelDNSResolver::~NativeClientChannelDNSResolver() {
 }
 
 OrphanablePtr<Orphanable> NativeClientChannelDNSResolver::StartRequest() {
+  if (cache_options_.ttl > Duration::Zero()) {
+    std::string name = name_to_resolve();
+    auto fetch = [name](grpc_pollset_set* interested_parties,
+                        DNSCache::ResultCallback on_done) {
+      GetDNSResolver()->ResolveName(
+          name, kDefaultSecurePort, interested_parties,
+          [on_done](absl::StatusOr<std::vector<grpc_resolved_address>>
+                        addresses_or) {
+            if (!addresses_or.ok()) {
+              on_done(addresses_or.status());
+              return;
+            }
+            DNSCache::Result result;
+            for (auto& addr : *addresses_or) {
+              result.addresses.emplace_back(addr, nullptr /* args */);
+            }
+            on_done(std::move(result));
+          });
+      return MakeOrphanable<Request>();
+    };
+    RefCountedPtr<NativeClientChannelDNSResolver> self =
+        Ref(DEBUG_LOCATION, "dns_cache_lookup");
+    return DNSCache::Get()->Lookup(
+        absl::StrCat("native:", name), cache_options_, interested_parties(),
+        std::move(fetch), [self](absl::StatusOr<DNSCache::Result> result) {
+          self->OnCacheLookupDone(std::move(result));
+        });
+  }
   Ref(DEBUG_LOCATION, "dns_request").release();
   auto dns_request_handle = GetDNSResolver()->ResolveName(
       name_to_resolve(), kDefaultSecurePort, interested_parties(),
@@ -152,6 +185,24 @@ void NativeClientChannelDNSResolver::OnResolved(
   Unref(DEBUG_LOCATION, "dns_request");
 }
 
+void NativeClientChannelDNSResolver::OnCacheLookupDone(
+    absl::StatusOr<DNSCache::Result> result) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_dns_resolver)) {
+    gpr_log(GPR_DEBUG, "[dns_resolver=%p] cache lookup complete, status=\"%s\"",
+            this, result.status().ToString().c_str());
+  }
+  Result resolver_result;
+  if (result.ok()) {
+    resolver_result.addresses = std::move(result->addresses);
+  } else {
+    resolver_result.addresses = absl::UnavailableError(
+        absl::StrCat("DNS resolution failed for ", name_to_resolve(), ": ",
+                     result.status().ToString()));
+  }
+  resolver_result.args = grpc_channel_args_copy(channel_args());
+  OnRequestComplete(std::move(resolver_result));
+}
+
 //
 // Factory
 //
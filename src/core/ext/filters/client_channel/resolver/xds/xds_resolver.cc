@@ -72,6 +72,7 @@
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/dual_ref_counted.h"
+#include "src/core/lib/gprpp/fast_random.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/time.h"
@@ -350,6 +351,7 @@ class XdsResolver : public Resolver {
 
     RefCountedPtr<XdsResolver> resolver_;
     RouteTable route_table_;
+    XdsRouting::RouteMatcher route_matcher_;
     std::map<absl::string_view, RefCountedPtr<ClusterState>> clusters_;
     std::vector<const grpc_channel_filter*> filters_;
   };
@@ -513,6 +515,7 @@ XdsResolver::XdsConfigSelector::XdsConfigSelector(
       }
     }
   }
+  route_matcher_ = XdsRouting::RouteMatcher(RouteListIterator(&route_table_));
   // Populate filter list.
   for (const auto& http_filter :
        resolver_->current_listener_.http_connection_manager.http_filters) {
@@ -666,9 +669,8 @@ absl::optional<uint64_t> HeaderHashHelper(
 
 ConfigSelector::CallConfig XdsResolver::XdsConfigSelector::GetCallConfig(
     GetCallConfigArgs args) {
-  auto route_index = XdsRouting::GetRouteForRequest(
-      RouteListIterator(&route_table_), StringViewFromSlice(*args.path),
-      args.initial_metadata);
+  auto route_index = route_matcher_.GetRouteForRequest(
+      StringViewFromSlice(*args.path), args.initial_metadata);
   if (!route_index.has_value()) {
     return CallConfig();
   }
@@ -697,10 +699,9 @@ ConfigSelector::CallConfig XdsResolver::XdsConfigSelector::GetCallConfig(
   } else if (route_action->action.index() ==
              XdsRouteConfigResource::Route::RouteAction::
                  kWeightedClustersIndex) {
-    const uint32_t key =
-        rand() %
+    const uint32_t key = FastRandomUniform(
         entry.weighted_cluster_state[entry.weighted_cluster_state.size() - 1]
-            .range_end;
+            .range_end);
     // Find the index in weighted clusters corresponding to key.
     size_t mid = 0;
     size_t start_index = 0;
@@ -22,6 +22,7 @@
 #include <limits.h>
 #include <stddef.h>
 
+#include <algorithm>
 #include <memory>
 #include <new>
 #include <string>
@@ -65,6 +66,8 @@
 #include "src/core/lib/iomgr/polling_entity.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
 #include "src/core/lib/service_config/service_config.h"
 #include "src/core/lib/service_config/service_config_call_data.h"
 #include "src/core/lib/slice/slice_buffer.h"
@@ -115,11 +118,17 @@
 // When constructing the "child" batches, we compare the state in the
 // CallAttempt object against the state in the CallData object to see
 // which batches need to be sent on the LB call for a given attempt.
-
-// TODO(roth): In subsequent PRs:
-// - implement hedging
-
-// By default, we buffer 256 KiB per RPC for retries.
+//
+// When the method has a hedging policy instead of a retry policy, we
+// may have several call attempts in flight at once, all of which replay
+// the same cached send ops.  A new attempt is started each time the
+// hedging delay elapses, or immediately when an attempt fails with a
+// non-fatal status.  As soon as one attempt receives a response (or
+// fails with a fatal status), we commit to it and cancel all others.
+
+// By default, an RPC may buffer as much data for retries as the channel's
+// resource quota recommends for a single allocation.  If the quota has no
+// size, we buffer 256 KiB per RPC.
 // TODO(roth): Do we have any data to suggest a better value?
 #define DEFAULT_PER_RPC_RETRY_BUFFER_SIZE (256 << 10)
 
@@ -167,16 +176,27 @@ class RetryFilter {
                              const grpc_channel_info* /*info*/) {}
 
  private:
-  static size_t GetMaxPerRpcRetryBufferSize(const grpc_channel_args* args) {
-    return static_cast<size_t>(grpc_channel_args_find_integer(
-        args, GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE,
-        {DEFAULT_PER_RPC_RETRY_BUFFER_SIZE, 0, INT_MAX}));
+  static absl::optional<size_t> GetMaxPerRpcRetryBufferSize(
+      const grpc_channel_args* args) {
+    const grpc_arg* arg =
+        grpc_channel_args_find(args, GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE);
+    if (arg == nullptr) return absl::nullopt;
+    return static_cast<size_t>(grpc_channel_arg_get_integer(
+        arg, {DEFAULT_PER_RPC_RETRY_BUFFER_SIZE, 0, INT_MAX}));
+  }
+
+  static MemoryQuotaRefPtr GetMemoryQuota(const grpc_channel_args* args) {
+    auto* resource_quota = grpc_channel_args_find_pointer<ResourceQuota>(
+        args, GRPC_ARG_RESOURCE_QUOTA);
+    if (resource_quota == nullptr) return nullptr;
+    return resource_quota->memory_quota();
   }
 
   RetryFilter(const grpc_channel_args* args, grpc_error_handle* error)
       : client_channel_(grpc_channel_args_find_pointer<ClientChannel>(
             args, GRPC_ARG_CLIENT_CHANNEL)),
         per_rpc_retry_buffer_size_(GetMaxPerRpcRetryBufferSize(args)),
+        memory_quota_(GetMemoryQuota(args)),
         service_config_parser_index_(
             internal::RetryServiceConfigParser::ParserIndex()) {
     // Get retry throttling parameters from service config.
@@ -213,8 +233,15 @@ class RetryFilter {
   const RetryMethodConfig* GetRetryPolicy(
       const grpc_call_context_element* context);
 
+  // Returns true if an RPC that has buffered bytes_buffered bytes for
+  // retries should stop buffering and commit.
+  bool RetryBufferExceeded(size_t bytes_buffered) const;
+
   ClientChannel* client_channel_;
-  size_t per_rpc_retry_buffer_size_;
+  // Set only if the application set GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE.
+  absl::optional<size_t> per_rpc_retry_buffer_size_;
+  // May be null if the channel args have no resource quota.
+  MemoryQuotaRefPtr memory_quota_;
   RefCountedPtr<ServerRetryThrottleData> retry_throttle_data_;
   const size_t service_config_parser_index_;
 };
@@ -253,17 +280,32 @@ class RetryFilter::CallData {
 
     bool lb_call_committed() const { return lb_call_committed_; }
 
+    // Returns true if any send op has been started on this attempt that
+    // has not been started on other.
+    bool HasStartedMoreSendOpsThan(const CallAttempt& other) const;
+
     // Constructs and starts whatever batches are needed on this call
     // attempt.
     void StartRetriableBatches();
 
+    // Adds whatever batches are needed on this attempt to closures.
+    void AddRetriableBatches(CallCombinerClosureList* closures);
+
     // Frees cached send ops that have already been completed after
     // committing the call.
     void FreeCachedSendOpDataAfterCommit();
 
+    // If the call is committed to this attempt, copies the peer that the
+    // transport set for this attempt to the parent call.
+    void MaybePropagatePeerString();
+
     // Cancels the call attempt.
     void CancelFromSurface(grpc_transport_stream_op_batch* cancel_batch);
 
+    // Abandons a hedged call attempt after the call was committed to
+    // another one, and adds a batch to closures to cancel it.
+    void CancelHedgedAttempt(CallCombinerClosureList* closures);
+
    private:
     // State used for starting a retryable batch on the call attempt's LB call.
     // This provides its own grpc_transport_stream_op_batch and other data
@@ -352,6 +394,14 @@ class RetryFilter::CallData {
       static void OnCompleteForCancelOp(void* arg, grpc_error_handle error);
 
       RefCountedPtr<CallAttempt> call_attempt_;
+      // Index in calld->send_messages_ of the message sent by this batch,
+      // if any.
+      size_t send_message_index_ = 0;
+      // The message sent by this batch, if any.  It holds refs to the
+      // cached slices rather than a copy of their bytes, and is separate
+      // from the cache so that filters and transports below us, which may
+      // modify or consume the message, cannot affect other attempts.
+      SliceBuffer send_message_;
       // The batch to use in the LB call.
       // Its payload field points to CallAttempt::batch_payload_.
       grpc_transport_stream_op_batch batch_;
@@ -371,7 +421,7 @@ class RetryFilter::CallData {
       void Commit() override {
         call_attempt_->lb_call_committed_ = true;
         auto* calld = call_attempt_->calld_;
-        if (calld->retry_committed_) {
+        if (calld->retry_committed_ && !call_attempt_->abandoned_) {
           auto* service_config_call_data =
               static_cast<ClientChannelServiceConfigCallData*>(
                   calld->call_context_[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA]
@@ -418,9 +468,6 @@ class RetryFilter::CallData {
     // Adds batches for pending batches to closures.
     void AddBatchesForPendingBatches(CallCombinerClosureList* closures);
 
-    // Adds whatever batches are needed on this attempt to closures.
-    void AddRetriableBatches(CallCombinerClosureList* closures);
-
     // Returns true if any send op in the batch was not yet started on this
     // attempt.
     bool PendingBatchContainsUnstartedSendOps(PendingBatch* pending);
@@ -437,6 +484,12 @@ class RetryFilter::CallData {
     bool ShouldRetry(absl::optional<grpc_status_code> status,
                      absl::optional<Duration> server_pushback_ms);
 
+    // For hedged calls, returns true if the call should continue on other
+    // call attempts after this one failed with status.  If so, schedules
+    // the next hedged attempt, if any.
+    bool ShouldContinueHedging(grpc_status_code status,
+                               absl::optional<Duration> server_pushback);
+
     // Abandons the call attempt.  Unrefs any deferred batches.
     void Abandon();
 
@@ -445,9 +498,14 @@ class RetryFilter::CallData {
     void MaybeCancelPerAttemptRecvTimer();
 
     CallData* calld_;
+    // Value of the grpc-previous-rpc-attempts header for this attempt.
+    const int num_previous_attempts_;
     AttemptDispatchController attempt_dispatch_controller_;
     OrphanablePtr<ClientChannel::LoadBalancedCall> lb_call_;
     bool lb_call_committed_ = false;
+    // Set by the transport when send_initial_metadata is sent on this
+    // attempt.
+    gpr_atm peer_string_ = 0;
 
     grpc_timer per_attempt_recv_timer_;
     grpc_closure on_per_attempt_recv_timer_;
@@ -540,8 +598,12 @@ class RetryFilter::CallData {
   void FreeAllCachedSendOpData();
 
   // Commits the call so that no further retry attempts will be performed.
+  // When hedging, also cancels all call attempts other than call_attempt.
   void RetryCommit(CallAttempt* call_attempt);
 
+  // Removes call_attempt from call_attempts_.
+  void RemoveCallAttempt(CallAttempt* call_attempt);
+
   // Starts a timer to retry after appropriate back-off.
   // If server_pushback is nullopt, retry_backoff_ is used.
   void StartRetryTimer(absl::optional<Duration> server_pushback);
@@ -553,6 +615,15 @@ class RetryFilter::CallData {
   void AddClosureToStartTransparentRetry(CallCombinerClosureList* closures);
   static void StartTransparentRetry(void* arg, grpc_error_handle error);
 
+  // Starts a timer to start the next hedged attempt after delay,
+  // replacing any previously started hedging timer.
+  void StartHedgingTimer(Duration delay);
+  void MaybeCancelHedgingTimer();
+  static void OnHedgingTimer(void* arg, grpc_error_handle error);
+  static void OnHedgingTimerLocked(void* arg, grpc_error_handle error);
+  // Returns true if another hedged attempt may be started.
+  bool CanStartHedgedAttempt();
+
   OrphanablePtr<ClientChannel::LoadBalancedCall> CreateLoadBalancedCall(
       ConfigSelector::CallDispatchController* call_dispatch_controller,
       bool is_transparent_retry);
@@ -563,6 +634,8 @@ class RetryFilter::CallData {
   grpc_polling_entity* pollent_;
   RefCountedPtr<ServerRetryThrottleData> retry_throttle_data_;
   const RetryMethodConfig* retry_policy_ = nullptr;
+  // Non-null if the call is hedged rather than retried.
+  const RetryMethodConfig::HedgingPolicy* hedging_policy_ = nullptr;
   BackOff retry_backoff_;
 
   grpc_slice path_;  // Request path.
@@ -576,10 +649,10 @@ class RetryFilter::CallData {
 
   RefCountedPtr<CallStackDestructionBarrier> call_stack_destruction_barrier_;
 
-  // TODO(roth): As part of implementing hedging, we will need to maintain a
-  // list of all pending attempts, so that we can cancel them all if the call
-  // gets cancelled.
-  RefCountedPtr<CallAttempt> call_attempt_;
+  // Call attempts that are in flight.  Without hedging, there is at most
+  // one; an abandoned attempt stays here until it is replaced.  With
+  // hedging, abandoned attempts are removed right away.
+  absl::InlinedVector<RefCountedPtr<CallAttempt>, 1> call_attempts_;
 
   // LB call used when we've committed to a call attempt and the retry
   // state for that attempt is no longer needed.  This provides a fast
@@ -606,20 +679,30 @@ class RetryFilter::CallData {
   grpc_timer retry_timer_;
   grpc_closure retry_closure_;
 
+  // Hedging state.
+  // A new HedgingTimer is allocated on the arena each time the timer is
+  // started, so that the callback of a cancelled timer never races with
+  // a new one.
+  struct HedgingTimer {
+    explicit HedgingTimer(CallData* calld) : calld(calld) {}
+    CallData* calld;
+    grpc_timer timer;
+    grpc_closure closure;
+  };
+  HedgingTimer* hedging_timer_ = nullptr;
+  // Number of hedged attempts started, not counting transparent retries.
+  int num_hedged_attempts_ = 0;
+  // Set when server push-back or retry throttling stops further hedging.
+  bool hedging_stopped_ = false;
+
   // Cached data for retrying send ops.
   // send_initial_metadata
   bool seen_send_initial_metadata_ = false;
   grpc_metadata_batch send_initial_metadata_{arena_};
   uint32_t send_initial_metadata_flags_;
-  // TODO(roth): As part of implementing hedging, we'll probably need to
-  // have the LB call set a value in CallAttempt and then propagate it
-  // from CallAttempt to the parent call when we commit.  Otherwise, we
-  // may leave this with a value for a peer other than the one we
-  // actually commit to.  Alternatively, maybe see if there's a way to
-  // change the surface API such that the peer isn't available until
-  // after initial metadata is received?  (Could even change the
-  // transport API to return this with the recv_initial_metadata op.)
-  gpr_atm* peer_string_;
+  // The surface's peer string.  Each call attempt has its own, which is
+  // copied here only once the call is committed to that attempt.
+  gpr_atm* peer_string_ = nullptr;
   // send_message
   // When we get a send_message op, we replace the original byte stream
   // with a CachingByteStream that caches the slices to a local buffer for
@@ -627,9 +710,14 @@ class RetryFilter::CallData {
   // Note: We inline the cache for the first 3 send_message ops and use
   // dynamic allocation after that.  This number was essentially picked
   // at random; it could be changed in the future to tune performance.
+  // Each call attempt sends its own refs to the cached slices, so a
+  // message may be freed while an abandoned attempt is still sending it.
+  // The cached bytes are charged to the call's memory allocator.
   struct CachedSendMessage {
     SliceBuffer* slices;
     uint32_t flags;
+    // Bytes reserved from the call's memory allocator for this message.
+    size_t reserved_bytes;
   };
   absl::InlinedVector<CachedSendMessage, 3> send_messages_;
   // send_trailing_metadata
@@ -699,6 +787,9 @@ RetryFilter::CallData::CallAttempt::CallAttempt(CallData* calld,
     : RefCounted(GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace) ? "CallAttempt"
                                                            : nullptr),
       calld_(calld),
+      num_previous_attempts_(calld->hedging_policy_ != nullptr
+                                 ? calld->num_hedged_attempts_
+                                 : calld->num_attempts_completed_),
       attempt_dispatch_controller_(this),
       batch_payload_(calld->call_context_),
       started_send_initial_metadata_(false),
@@ -719,8 +810,10 @@ RetryFilter::CallData::CallAttempt::CallAttempt(CallData* calld,
             "chand=%p calld=%p attempt=%p: created attempt, lb_call=%p",
             calld->chand_, calld, this, lb_call_.get());
   }
-  // If per_attempt_recv_timeout is set, start a timer.
-  if (calld->retry_policy_ != nullptr &&
+  // If per_attempt_recv_timeout is set, start a timer.  Not used for
+  // hedging, where a slow attempt is not cancelled; instead, the hedging
+  // delay starts another attempt alongside it.
+  if (calld->retry_policy_ != nullptr && calld->hedging_policy_ == nullptr &&
       calld->retry_policy_->per_attempt_recv_timeout().has_value()) {
     Timestamp per_attempt_recv_deadline =
         ExecCtx::Get()->Now() +
@@ -751,10 +844,8 @@ RetryFilter::CallData::CallAttempt::~CallAttempt() {
 }
 
 void RetryFilter::CallData::CallAttempt::FreeCachedSendOpDataAfterCommit() {
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
+  // Note that abandoned call attempts may still be sending some of this
+  // data.  They hold their own refs to it, so it is safe to free here.
   if (completed_send_initial_metadata_) {
     calld_->FreeCachedSendInitialMetadata();
   }
@@ -766,6 +857,15 @@ void RetryFilter::CallData::CallAttempt::FreeCachedSendOpDataAfterCommit() {
   }
 }
 
+bool RetryFilter::CallData::CallAttempt::HasStartedMoreSendOpsThan(
+    const CallAttempt& other) const {
+  if (started_send_message_count_ != other.started_send_message_count_) {
+    return started_send_message_count_ > other.started_send_message_count_;
+  }
+  return started_send_trailing_metadata_ &&
+         !other.started_send_trailing_metadata_;
+}
+
 bool RetryFilter::CallData::CallAttempt::PendingBatchContainsUnstartedSendOps(
     PendingBatch* pending) {
   if (pending->batch->on_complete == nullptr) return false;
@@ -794,12 +894,10 @@ bool RetryFilter::CallData::CallAttempt::HaveSendOpsToReplay() {
 }
 
 void RetryFilter::CallData::CallAttempt::MaybeSwitchToFastPath() {
-  // If we're not yet committed, we can't switch yet.
-  // TODO(roth): As part of implementing hedging, this logic needs to
-  // check that *this* call attempt is the one that we've committed to.
-  // Might need to replace abandoned_ with an enum indicating whether we're
-  // in flight, abandoned, or the winning call attempt.
-  if (!calld_->retry_committed_) return;
+  // If we're not yet committed, we can't switch yet.  Committing abandons
+  // all other call attempts, so if we're not abandoned, we're the one
+  // that the call is committed to.
+  if (!calld_->retry_committed_ || abandoned_) return;
   // If we've already switched to fast path, there's nothing to do here.
   if (calld_->committed_call_ != nullptr) return;
   // If the perAttemptRecvTimeout timer is pending, we can't switch yet.
@@ -817,7 +915,16 @@ void RetryFilter::CallData::CallAttempt::MaybeSwitchToFastPath() {
             calld_->chand_, calld_, this);
   }
   calld_->committed_call_ = std::move(lb_call_);
-  calld_->call_attempt_.reset(DEBUG_LOCATION, "MaybeSwitchToFastPath");
+  calld_->RemoveCallAttempt(this);
+}
+
+void RetryFilter::CallData::CallAttempt::MaybePropagatePeerString() {
+  if (calld_->peer_string_ == nullptr || !calld_->retry_committed_ ||
+      abandoned_) {
+    return;
+  }
+  gpr_atm peer_string = gpr_atm_acq_load(&peer_string_);
+  if (peer_string != 0) gpr_atm_rel_store(calld_->peer_string_, peer_string);
 }
 
 // If there are any cached send ops that need to be replayed on the
@@ -1126,6 +1233,16 @@ void RetryFilter::CallData::CallAttempt::CancelFromSurface(
   lb_call_->StartTransportStreamOpBatch(cancel_batch);
 }
 
+void RetryFilter::CallData::CallAttempt::CancelHedgedAttempt(
+    CallCombinerClosureList* closures) {
+  Abandon();
+  MaybeAddBatchForCancelOp(
+      grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                             "call committed to another hedged attempt"),
+                         GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_CANCELLED),
+      closures);
+}
+
 bool RetryFilter::CallData::CallAttempt::ShouldRetry(
     absl::optional<grpc_status_code> status,
     absl::optional<Duration> server_pushback) {
@@ -1227,6 +1344,70 @@ bool RetryFilter::CallData::CallAttempt::ShouldRetry(
   return true;
 }
 
+bool RetryFilter::CallData::CallAttempt::ShouldContinueHedging(
+    grpc_status_code status, absl::optional<Duration> server_pushback) {
+  if (GPR_LIKELY(status == GRPC_STATUS_OK)) {
+    if (calld_->retry_throttle_data_ != nullptr) {
+      calld_->retry_throttle_data_->RecordSuccess();
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p attempt=%p: call succeeded",
+              calld_->chand_, calld_, this);
+    }
+    return false;
+  }
+  // A fatal status is returned to the application right away.
+  if (!calld_->hedging_policy_->non_fatal_status_codes.Contains(status)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p attempt=%p: status %s is fatal for hedging",
+              calld_->chand_, calld_, this, grpc_status_code_to_string(status));
+    }
+    return false;
+  }
+  // Record the failure.  If hedged attempts are now throttled, or if the
+  // server asked us not to retry, we do not start any more attempts, but
+  // the ones already in flight continue.
+  if (calld_->retry_throttle_data_ != nullptr) {
+    calld_->retry_throttle_data_->RecordFailure();
+  }
+  if (server_pushback.has_value() && *server_pushback < Duration::Zero()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p attempt=%p: not hedging further due to "
+              "server push-back",
+              calld_->chand_, calld_, this);
+    }
+    calld_->hedging_stopped_ = true;
+    calld_->MaybeCancelHedgingTimer();
+  }
+  // Check whether the call is committed.
+  if (calld_->retry_committed_) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p attempt=%p: retries already committed",
+              calld_->chand_, calld_, this);
+    }
+    return false;
+  }
+  const bool can_start_attempt = calld_->CanStartHedgedAttempt();
+  // If this is the last attempt, its status is the status of the call.
+  if (!can_start_attempt && calld_->call_attempts_.size() == 1) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p attempt=%p: no more hedged attempts",
+              calld_->chand_, calld_, this);
+    }
+    return false;
+  }
+  // A non-fatal status means that the next hedged attempt is started right
+  // away instead of after the hedging delay, unless the server pushed back.
+  if (can_start_attempt) {
+    calld_->StartHedgingTimer(server_pushback.value_or(Duration::Zero()));
+  }
+  return true;
+}
+
 void RetryFilter::CallData::CallAttempt::Abandon() {
   abandoned_ = true;
   // Unref batches for deferred completion callbacks that will now never
@@ -1283,9 +1464,8 @@ void RetryFilter::CallData::CallAttempt::OnPerAttemptRecvTimerLocked(
   if (error == GRPC_ERROR_NONE &&
       call_attempt->per_attempt_recv_timer_pending_) {
     call_attempt->per_attempt_recv_timer_pending_ = false;
-    // Cancel this attempt.
-    // TODO(roth): When implementing hedging, we should not cancel the
-    // current attempt.
+    // Cancel this attempt.  (The timer is never started for hedging.)
+    GPR_DEBUG_ASSERT(calld->hedging_policy_ == nullptr);
     call_attempt->MaybeAddBatchForCancelOp(
         grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
                                "retry perAttemptRecvTimeout exceeded"),
@@ -1367,16 +1547,11 @@ RetryFilter::CallData::CallAttempt::BatchData::~BatchData() {
 void RetryFilter::CallData::CallAttempt::BatchData::
     FreeCachedSendOpDataForCompletedBatch() {
   auto* calld = call_attempt_->calld_;
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
   if (batch_.send_initial_metadata) {
     calld->FreeCachedSendInitialMetadata();
   }
   if (batch_.send_message) {
-    calld->FreeCachedSendMessage(call_attempt_->completed_send_message_count_ -
-                                 1);
+    calld->FreeCachedSendMessage(send_message_index_);
   }
   if (batch_.send_trailing_metadata) {
     calld->FreeCachedSendTrailingMetadata();
@@ -1777,7 +1952,12 @@ void RetryFilter::CallData::CallAttempt::BatchData::RecvTrailingMetadataReady(
   }
   // Check if we should retry.
   if (!is_lb_drop) {  // Never retry on LB drops.
-    enum { kNoRetry, kTransparentRetry, kConfigurableRetry } retry = kNoRetry;
+    enum {
+      kNoRetry,
+      kTransparentRetry,
+      kConfigurableRetry,
+      kContinueHedging
+    } retry = kNoRetry;
     // Handle transparent retries.
     if (stream_network_state.has_value() && !calld->retry_committed_) {
       // If not sent on wire, then always retry.
@@ -1791,10 +1971,16 @@ void RetryFilter::CallData::CallAttempt::BatchData::RecvTrailingMetadataReady(
         retry = kTransparentRetry;
       }
     }
-    // If not transparently retrying, check for configurable retry.
-    if (retry == kNoRetry &&
-        call_attempt->ShouldRetry(status, server_pushback)) {
-      retry = kConfigurableRetry;
+    // If not transparently retrying, check for configurable retry or,
+    // for hedged calls, whether other attempts can still succeed.
+    if (retry == kNoRetry) {
+      if (calld->hedging_policy_ != nullptr) {
+        if (call_attempt->ShouldContinueHedging(status, server_pushback)) {
+          retry = kContinueHedging;
+        }
+      } else if (call_attempt->ShouldRetry(status, server_pushback)) {
+        retry = kConfigurableRetry;
+      }
     }
     // If we're retrying, do so.
     if (retry != kNoRetry) {
@@ -1808,15 +1994,21 @@ void RetryFilter::CallData::CallAttempt::BatchData::RecvTrailingMetadataReady(
               : GRPC_ERROR_REF(error),
           &closures);
       // For transparent retries, add a closure to immediately start a new
-      // call attempt.
+      // call attempt.  When hedging, the new attempt replaces this one
+      // without affecting when the next hedged attempt starts.
       // For configurable retries, start retry timer.
+      // When continuing to hedge, ShouldContinueHedging() has already
+      // scheduled the next attempt, if any.
       if (retry == kTransparentRetry) {
         calld->AddClosureToStartTransparentRetry(&closures);
-      } else {
+      } else if (retry == kConfigurableRetry) {
         calld->StartRetryTimer(server_pushback);
       }
       // Record that this attempt has been abandoned.
       call_attempt->Abandon();
+      if (calld->hedging_policy_ != nullptr) {
+        calld->RemoveCallAttempt(call_attempt);
+      }
       // Yields call combiner.
       closures.RunClosures(calld->call_combiner_);
       return;
@@ -1940,6 +2132,7 @@ void RetryFilter::CallData::CallAttempt::BatchData::OnComplete(
   // Update bookkeeping in call_attempt.
   if (batch_data->batch_.send_initial_metadata) {
     call_attempt->completed_send_initial_metadata_ = true;
+    call_attempt->MaybePropagatePeerString();
   }
   if (batch_data->batch_.send_message) {
     ++call_attempt->completed_send_message_count_;
@@ -2000,12 +2193,13 @@ void RetryFilter::CallData::CallAttempt::BatchData::
   // the filters in the subchannel stack may modify this batch, and we don't
   // want those modifications to be passed forward to subsequent attempts.
   //
-  // If we've already completed one or more attempts, add the
-  // grpc-retry-attempts header.
+  // If this is not the first attempt, add the grpc-previous-rpc-attempts
+  // header.
   call_attempt_->send_initial_metadata_ = calld->send_initial_metadata_.Copy();
-  if (GPR_UNLIKELY(calld->num_attempts_completed_ > 0)) {
-    call_attempt_->send_initial_metadata_.Set(GrpcPreviousRpcAttemptsMetadata(),
-                                              calld->num_attempts_completed_);
+  if (GPR_UNLIKELY(call_attempt_->num_previous_attempts_ > 0)) {
+    call_attempt_->send_initial_metadata_.Set(
+        GrpcPreviousRpcAttemptsMetadata(),
+        call_attempt_->num_previous_attempts_);
   } else {
     call_attempt_->send_initial_metadata_.Remove(
         GrpcPreviousRpcAttemptsMetadata());
@@ -2016,7 +2210,8 @@ void RetryFilter::CallData::CallAttempt::BatchData::
       &call_attempt_->send_initial_metadata_;
   batch_.payload->send_initial_metadata.send_initial_metadata_flags =
       calld->send_initial_metadata_flags_;
-  batch_.payload->send_initial_metadata.peer_string = calld->peer_string_;
+  batch_.payload->send_initial_metadata.peer_string =
+      calld->peer_string_ == nullptr ? nullptr : &call_attempt_->peer_string_;
 }
 
 void RetryFilter::CallData::CallAttempt::BatchData::
@@ -2030,11 +2225,12 @@ void RetryFilter::CallData::CallAttempt::BatchData::
         calld->chand_, calld, call_attempt_.get(),
         call_attempt_->started_send_message_count_);
   }
-  CachedSendMessage cache =
-      calld->send_messages_[call_attempt_->started_send_message_count_];
+  send_message_index_ = call_attempt_->started_send_message_count_;
+  CachedSendMessage& cache = calld->send_messages_[send_message_index_];
   ++call_attempt_->started_send_message_count_;
   batch_.send_message = true;
-  batch_.payload->send_message.send_message = cache.slices;
+  send_message_ = cache.slices->Copy();
+  batch_.payload->send_message.send_message = &send_message_;
   batch_.payload->send_message.flags = cache.flags;
 }
 
@@ -2161,11 +2357,29 @@ const RetryMethodConfig* RetryFilter::GetRetryPolicy(
       svc_cfg_call_data->GetMethodParsedConfig(service_config_parser_index_));
 }
 
+bool RetryFilter::RetryBufferExceeded(size_t bytes_buffered) const {
+  size_t limit = DEFAULT_PER_RPC_RETRY_BUFFER_SIZE;
+  if (per_rpc_retry_buffer_size_.has_value()) {
+    limit = *per_rpc_retry_buffer_size_;
+  } else if (memory_quota_ != nullptr) {
+    limit = memory_quota_->MaxRecommendedAllocationSize().value_or(limit);
+  }
+  if (bytes_buffered > limit) return true;
+  // Under memory pressure, give up on retries rather than hold on to
+  // memory that is needed elsewhere.
+  return bytes_buffered > 0 && memory_quota_ != nullptr &&
+         memory_quota_->IsMemoryPressureHigh();
+}
+
 RetryFilter::CallData::CallData(RetryFilter* chand,
                                 const grpc_call_element_args& args)
     : chand_(chand),
       retry_throttle_data_(chand->retry_throttle_data_),
       retry_policy_(chand->GetRetryPolicy(args.context)),
+      hedging_policy_(retry_policy_ != nullptr &&
+                              retry_policy_->hedging_policy().has_value()
+                          ? &*retry_policy_->hedging_policy()
+                          : nullptr),
       retry_backoff_(
           BackOff::Options()
               .set_initial_backoff(retry_policy_ == nullptr
@@ -2240,16 +2454,13 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
     // If we have a current call attempt, commit the call, then send
     // the cancellation down to that attempt.  When the call fails, it
     // will not be retried, because we have committed it here.
-    if (call_attempt_ != nullptr) {
-      RetryCommit(call_attempt_.get());
-      // TODO(roth): When implementing hedging, this will get more
-      // complex, because instead of just passing the batch down to a
-      // single call attempt, we'll need to cancel multiple call
-      // attempts and wait for the cancellation on_complete from each call
-      // attempt before we propagate the on_complete from this batch
-      // back to the surface.
+    // When hedging, committing cancels all of the other call attempts
+    // internally, so the batch only needs to go down to one of them.
+    if (!call_attempts_.empty()) {
+      RefCountedPtr<CallAttempt> call_attempt = call_attempts_.front();
+      RetryCommit(call_attempt.get());
       // Note: This will release the call combiner.
-      call_attempt_->CancelFromSurface(batch);
+      call_attempt->CancelFromSurface(batch);
       return;
     }
     // Cancel retry timer if needed.
@@ -2262,6 +2473,11 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
       grpc_timer_cancel(&retry_timer_);
       FreeAllCachedSendOpData();
     }
+    // Likewise for a hedged call that is waiting to start its next attempt.
+    if (hedging_timer_ != nullptr) {
+      MaybeCancelHedgingTimer();
+      FreeAllCachedSendOpData();
+    }
     // We have no call attempt, so there's nowhere to send the cancellation
     // batch.  Return it back to the surface immediately.
     // Note: This will release the call combiner.
@@ -2271,15 +2487,23 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
   }
   // Add the batch to the pending list.
   PendingBatch* pending = PendingBatchesAdd(batch);
+  // When hedging, cache send ops right away.  Any call attempt may
+  // complete this batch, including one that has not started its send ops
+  // yet because it is still replaying earlier ones.
+  if (hedging_policy_ != nullptr && !retry_committed_) {
+    MaybeCacheSendOpsForBatch(pending);
+  }
   // If the timer is pending, yield the call combiner and wait for it to
   // run, since we don't want to start another call attempt until it does.
-  if (retry_timer_pending_) {
+  // The same goes for a hedged call with no attempts in flight.
+  if (retry_timer_pending_ ||
+      (call_attempts_.empty() && hedging_timer_ != nullptr)) {
     GRPC_CALL_COMBINER_STOP(call_combiner_,
                             "added pending batch while retry timer pending");
     return;
   }
   // If we do not yet have a call attempt, create one.
-  if (call_attempt_ == nullptr) {
+  if (call_attempts_.empty()) {
     // If this is the first batch and retries are already committed
     // (e.g., if this batch put the call above the buffer size limit), then
     // immediately create an LB call and delegate the batch to it.  This
@@ -2325,12 +2549,27 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
     CreateCallAttempt(/*is_transparent_retry=*/false);
     return;
   }
-  // Send batches to call attempt.
+  // Send batches to call attempts.
+  if (call_attempts_.size() == 1) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p: starting batch on attempt=%p",
+              chand_, this, call_attempts_.front().get());
+    }
+    call_attempts_.front()->StartRetriableBatches();
+    return;
+  }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
-    gpr_log(GPR_INFO, "chand=%p calld=%p: starting batch on attempt=%p", chand_,
-            this, call_attempt_.get());
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: starting batch on %" PRIuPTR
+            " hedged attempts",
+            chand_, this, call_attempts_.size());
   }
-  call_attempt_->StartRetriableBatches();
+  CallCombinerClosureList closures;
+  for (auto& call_attempt : call_attempts_) {
+    call_attempt->AddRetriableBatches(&closures);
+  }
+  // Note: This will yield the call combiner.
+  closures.RunClosures(call_combiner_);
 }
 
 OrphanablePtr<ClientChannel::LoadBalancedCall>
@@ -2349,8 +2588,25 @@ RetryFilter::CallData::CreateLoadBalancedCall(
 }
 
 void RetryFilter::CallData::CreateCallAttempt(bool is_transparent_retry) {
-  call_attempt_ = MakeRefCounted<CallAttempt>(this, is_transparent_retry);
-  call_attempt_->StartRetriableBatches();
+  // Without hedging, the new attempt replaces the previous one.
+  if (hedging_policy_ == nullptr) call_attempts_.clear();
+  RefCountedPtr<CallAttempt> call_attempt =
+      MakeRefCounted<CallAttempt>(this, is_transparent_retry);
+  call_attempts_.push_back(call_attempt);
+  // When hedging, start the timer for the next attempt.  A transparent
+  // retry replaces an attempt that never reached the server, so it does
+  // not count against maxAttempts, and the timer of the attempt it
+  // replaces, if any, is still pending.  No timer is needed once the call
+  // is committed, e.g. because its first batch exceeded the retry buffer.
+  if (hedging_policy_ != nullptr && !is_transparent_retry &&
+      !retry_committed_) {
+    ++num_hedged_attempts_;
+    if (!hedging_stopped_ &&
+        num_hedged_attempts_ < retry_policy_->max_attempts()) {
+      StartHedgingTimer(hedging_policy_->hedging_delay);
+    }
+  }
+  call_attempt->StartRetriableBatches();
 }
 
 //
@@ -2375,7 +2631,13 @@ void RetryFilter::CallData::MaybeCacheSendOpsForBatch(PendingBatch* pending) {
   if (batch->send_message) {
     SliceBuffer* cache = arena_->New<SliceBuffer>(std::move(
         *absl::exchange(batch->payload->send_message.send_message, nullptr)));
-    send_messages_.push_back({cache, batch->payload->send_message.flags});
+    const size_t reserved_bytes =
+        std::min(cache->Length(), MemoryRequest::max_allowed_size());
+    if (reserved_bytes > 0) {
+      arena_->memory_allocator()->Reserve(MemoryRequest(reserved_bytes));
+    }
+    send_messages_.push_back(
+        {cache, batch->payload->send_message.flags, reserved_bytes});
   }
   // Save metadata batch for send_trailing_metadata ops.
   if (batch->send_trailing_metadata) {
@@ -2395,13 +2657,18 @@ void RetryFilter::CallData::FreeCachedSendInitialMetadata() {
 }
 
 void RetryFilter::CallData::FreeCachedSendMessage(size_t idx) {
-  if (send_messages_[idx].slices != nullptr) {
+  CachedSendMessage& cache = send_messages_[idx];
+  if (cache.slices != nullptr) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
       gpr_log(GPR_INFO,
               "chand=%p calld=%p: destroying send_messages[%" PRIuPTR "]",
               chand_, this, idx);
     }
-    Destruct(absl::exchange(send_messages_[idx].slices, nullptr));
+    Destruct(absl::exchange(cache.slices, nullptr));
+    if (cache.reserved_bytes > 0) {
+      arena_->memory_allocator()->Release(
+          absl::exchange(cache.reserved_bytes, 0));
+    }
   }
 }
 
@@ -2470,17 +2737,22 @@ RetryFilter::CallData::PendingBatch* RetryFilter::CallData::PendingBatchesAdd(
   if (batch->send_trailing_metadata) {
     pending_send_trailing_metadata_ = true;
   }
-  // TODO(roth): When we implement hedging, if there are currently attempts
-  // in flight, we will need to pick the one on which the max number of send
-  // ops have already been sent, and we commit to that attempt.
-  if (GPR_UNLIKELY(bytes_buffered_for_retry_ >
-                   chand_->per_rpc_retry_buffer_size_)) {
+  if (GPR_UNLIKELY(chand_->RetryBufferExceeded(bytes_buffered_for_retry_))) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
       gpr_log(GPR_INFO,
               "chand=%p calld=%p: exceeded retry buffer size, committing",
               chand_, this);
     }
-    RetryCommit(call_attempt_.get());
+    // If several hedged attempts are in flight, commit to the one on
+    // which the most send ops have been started.
+    CallAttempt* call_attempt = nullptr;
+    for (auto& attempt : call_attempts_) {
+      if (call_attempt == nullptr ||
+          attempt->HasStartedMoreSendOpsThan(*call_attempt)) {
+        call_attempt = attempt.get();
+      }
+    }
+    RetryCommit(call_attempt);
   }
   return pending;
 }
@@ -2603,13 +2875,47 @@ void RetryFilter::CallData::RetryCommit(CallAttempt* call_attempt) {
     }
     // Free cached send ops.
     call_attempt->FreeCachedSendOpDataAfterCommit();
+    // Report the peer of the attempt we committed to.
+    call_attempt->MaybePropagatePeerString();
+  }
+  // When hedging, stop starting new attempts and cancel all attempts
+  // other than the one we committed to.
+  if (hedging_policy_ != nullptr) {
+    MaybeCancelHedgingTimer();
+    CallCombinerClosureList closures;
+    for (auto& attempt : call_attempts_) {
+      if (attempt.get() == call_attempt) continue;
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+        gpr_log(GPR_INFO,
+                "chand=%p calld=%p: cancelling hedged attempt=%p; committed "
+                "to attempt=%p",
+                chand_, this, attempt.get(), call_attempt);
+      }
+      attempt->CancelHedgedAttempt(&closures);
+    }
+    call_attempts_.erase(
+        std::remove_if(call_attempts_.begin(), call_attempts_.end(),
+                       [call_attempt](const RefCountedPtr<CallAttempt>& a) {
+                         return a.get() != call_attempt;
+                       }),
+        call_attempts_.end());
+    closures.RunClosuresWithoutYielding(call_combiner_);
+  }
+}
+
+void RetryFilter::CallData::RemoveCallAttempt(CallAttempt* call_attempt) {
+  for (auto it = call_attempts_.begin(); it != call_attempts_.end(); ++it) {
+    if (it->get() == call_attempt) {
+      call_attempts_.erase(it);
+      return;
+    }
   }
 }
 
 void RetryFilter::CallData::StartRetryTimer(
     absl::optional<Duration> server_pushback) {
   // Reset call attempt.
-  call_attempt_.reset(DEBUG_LOCATION, "StartRetryTimer");
+  call_attempts_.clear();
   // Compute backoff delay.
   Timestamp next_attempt_time;
   if (server_pushback.has_value()) {
@@ -2656,23 +2962,111 @@ void RetryFilter::CallData::AddClosureToStartTransparentRetry(
     gpr_log(GPR_INFO, "chand=%p calld=%p: scheduling transparent retry", chand_,
             this);
   }
+  // Several hedged attempts may be retried transparently at the same time,
+  // so each of them gets its own closure.
+  grpc_closure* closure = hedging_policy_ != nullptr
+                              ? arena_->New<grpc_closure>()
+                              : &retry_closure_;
   GRPC_CALL_STACK_REF(owning_call_, "OnRetryTimer");
-  GRPC_CLOSURE_INIT(&retry_closure_, StartTransparentRetry, this, nullptr);
-  closures->Add(&retry_closure_, GRPC_ERROR_NONE, "start transparent retry");
+  GRPC_CLOSURE_INIT(closure, StartTransparentRetry, this, nullptr);
+  closures->Add(closure, GRPC_ERROR_NONE, "start transparent retry");
 }
 
 void RetryFilter::CallData::StartTransparentRetry(void* arg,
                                                   grpc_error_handle /*error*/) {
   auto* calld = static_cast<CallData*>(arg);
-  if (calld->cancelled_from_surface_ == GRPC_ERROR_NONE) {
+  // A hedged call may have been committed to another attempt meanwhile.
+  if (calld->cancelled_from_surface_ == GRPC_ERROR_NONE &&
+      (calld->hedging_policy_ == nullptr || !calld->retry_committed_)) {
     calld->CreateCallAttempt(/*is_transparent_retry=*/true);
   } else {
     GRPC_CALL_COMBINER_STOP(calld->call_combiner_,
-                            "call cancelled before transparent retry");
+                            "not starting transparent retry");
   }
   GRPC_CALL_STACK_UNREF(calld->owning_call_, "OnRetryTimer");
 }
 
+void RetryFilter::CallData::StartHedgingTimer(Duration delay) {
+  MaybeCancelHedgingTimer();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: starting next hedged attempt in %" PRId64
+            " ms",
+            chand_, this, delay.millis());
+  }
+  hedging_timer_ = arena_->New<HedgingTimer>(this);
+  GRPC_CLOSURE_INIT(&hedging_timer_->closure, OnHedgingTimer, hedging_timer_,
+                    nullptr);
+  GRPC_CALL_STACK_REF(owning_call_, "OnHedgingTimer");
+  grpc_timer_init(&hedging_timer_->timer, ExecCtx::Get()->Now() + delay,
+                  &hedging_timer_->closure);
+}
+
+void RetryFilter::CallData::MaybeCancelHedgingTimer() {
+  if (hedging_timer_ != nullptr) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p: cancelling hedging timer", chand_,
+              this);
+    }
+    // The callback will see that hedging_timer_ no longer points to it.
+    grpc_timer_cancel(&absl::exchange(hedging_timer_, nullptr)->timer);
+  }
+}
+
+void RetryFilter::CallData::OnHedgingTimer(void* arg,
+                                           grpc_error_handle error) {
+  auto* hedging_timer = static_cast<HedgingTimer*>(arg);
+  GRPC_CLOSURE_INIT(&hedging_timer->closure, OnHedgingTimerLocked,
+                    hedging_timer, nullptr);
+  GRPC_CALL_COMBINER_START(hedging_timer->calld->call_combiner_,
+                           &hedging_timer->closure, GRPC_ERROR_REF(error),
+                           "hedging timer fired");
+}
+
+void RetryFilter::CallData::OnHedgingTimerLocked(void* arg,
+                                                 grpc_error_handle error) {
+  auto* hedging_timer = static_cast<HedgingTimer*>(arg);
+  auto* calld = hedging_timer->calld;
+  if (error == GRPC_ERROR_NONE && calld->hedging_timer_ == hedging_timer) {
+    calld->hedging_timer_ = nullptr;
+    // If no attempts are in flight, the decision to start another one was
+    // made when the last one failed, so we don't check again here.
+    if (calld->cancelled_from_surface_ == GRPC_ERROR_NONE &&
+        (calld->call_attempts_.empty() || calld->CanStartHedgedAttempt())) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+        gpr_log(GPR_INFO, "chand=%p calld=%p: starting hedged attempt %d",
+                calld->chand_, calld, calld->num_hedged_attempts_ + 1);
+      }
+      calld->CreateCallAttempt(/*is_transparent_retry=*/false);
+    } else {
+      GRPC_CALL_COMBINER_STOP(calld->call_combiner_,
+                              "not starting hedged attempt");
+    }
+  } else {
+    GRPC_CALL_COMBINER_STOP(calld->call_combiner_, "hedging timer cancelled");
+  }
+  GRPC_CALL_STACK_UNREF(calld->owning_call_, "OnHedgingTimer");
+}
+
+bool RetryFilter::CallData::CanStartHedgedAttempt() {
+  if (retry_committed_ || hedging_stopped_ ||
+      num_hedged_attempts_ >= retry_policy_->max_attempts()) {
+    return false;
+  }
+  // Hedged attempts are not sent while retries are throttled.
+  if (retry_throttle_data_ != nullptr && retry_throttle_data_->IsThrottled()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p: hedging throttled", chand_, this);
+    }
+    return false;
+  }
+  // Check with call dispatch controller.
+  auto* service_config_call_data =
+      static_cast<ClientChannelServiceConfigCallData*>(
+          call_context_[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA].value);
+  return service_config_call_data->call_dispatch_controller()->ShouldRetry();
+}
+
 }  // namespace
 
 const grpc_channel_filter kRetryFilterVtable = {
@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
 #include "absl/types/optional.h"
 
 #include <grpc/status.h>
@@ -155,39 +156,79 @@ RetryServiceConfigParser::ParseGlobalParams(const grpc_channel_args* /*args*/,
 
 namespace {
 
-grpc_error_handle ParseRetryPolicy(
-    const grpc_channel_args* args, const Json& json, int* max_attempts,
-    Duration* initial_backoff, Duration* max_backoff, float* backoff_multiplier,
-    StatusCodeSet* retryable_status_codes,
-    absl::optional<Duration>* per_attempt_recv_timeout) {
-  if (json.type() != Json::Type::OBJECT) {
-    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-        "field:retryPolicy error:should be of type object");
-  }
-  std::vector<grpc_error_handle> error_list;
-  // Parse maxAttempts.
+bool HedgingEnabled(const grpc_channel_args* args) {
+  return grpc_channel_args_find_bool(args, GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING,
+                                     false);
+}
+
+// Parses maxAttempts, which is used by both retryPolicy and hedgingPolicy.
+void ParseMaxAttempts(const Json& json, const char* policy_name,
+                      int* max_attempts,
+                      std::vector<grpc_error_handle>* error_list) {
   auto it = json.object_value().find("maxAttempts");
   if (it == json.object_value().end()) {
-    error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+    error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
         "field:maxAttempts error:required field missing"));
   } else {
     if (it->second.type() != Json::Type::NUMBER) {
-      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
           "field:maxAttempts error:should be of type number"));
     } else {
       *max_attempts =
           gpr_parse_nonnegative_int(it->second.string_value().c_str());
       if (*max_attempts <= 1) {
-        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
             "field:maxAttempts error:should be at least 2"));
       } else if (*max_attempts > MAX_MAX_RETRY_ATTEMPTS) {
-        gpr_log(GPR_ERROR,
-                "service config: clamped retryPolicy.maxAttempts at %d",
-                MAX_MAX_RETRY_ATTEMPTS);
+        gpr_log(GPR_ERROR, "service config: clamped %s.maxAttempts at %d",
+                policy_name, MAX_MAX_RETRY_ATTEMPTS);
         *max_attempts = MAX_MAX_RETRY_ATTEMPTS;
       }
     }
   }
+}
+
+// Parses an optional list of status codes, such as retryableStatusCodes.
+void ParseStatusCodes(const Json& json, absl::string_view field_name,
+                      StatusCodeSet* status_codes,
+                      std::vector<grpc_error_handle>* error_list) {
+  auto it = json.object_value().find(std::string(field_name));
+  if (it == json.object_value().end()) return;
+  if (it->second.type() != Json::Type::ARRAY) {
+    error_list->push_back(GRPC_ERROR_CREATE_FROM_CPP_STRING(
+        absl::StrCat("field:", field_name, " error:must be of type array")));
+    return;
+  }
+  for (const Json& element : it->second.array_value()) {
+    if (element.type() != Json::Type::STRING) {
+      error_list->push_back(GRPC_ERROR_CREATE_FROM_CPP_STRING(
+          absl::StrCat("field:", field_name,
+                       " error:status codes should be of type string")));
+      continue;
+    }
+    grpc_status_code status;
+    if (!grpc_status_code_from_string(element.string_value().c_str(),
+                                      &status)) {
+      error_list->push_back(GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrCat(
+          "field:", field_name, " error:failed to parse status code")));
+      continue;
+    }
+    status_codes->Add(status);
+  }
+}
+
+grpc_error_handle ParseRetryPolicy(
+    const grpc_channel_args* args, const Json& json, int* max_attempts,
+    Duration* initial_backoff, Duration* max_backoff, float* backoff_multiplier,
+    StatusCodeSet* retryable_status_codes,
+    absl::optional<Duration>* per_attempt_recv_timeout) {
+  if (json.type() != Json::Type::OBJECT) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "field:retryPolicy error:should be of type object");
+  }
+  std::vector<grpc_error_handle> error_list;
+  // Parse maxAttempts.
+  ParseMaxAttempts(json, "retryPolicy", max_attempts, &error_list);
   // Parse initialBackoff.
   if (ParseJsonObjectFieldAsDuration(json.object_value(), "initialBackoff",
                                      initial_backoff, &error_list) &&
@@ -203,7 +244,7 @@ grpc_error_handle ParseRetryPolicy(
         "field:maxBackoff error:must be greater than 0"));
   }
   // Parse backoffMultiplier.
-  it = json.object_value().find("backoffMultiplier");
+  auto it = json.object_value().find("backoffMultiplier");
   if (it == json.object_value().end()) {
     error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
         "field:backoffMultiplier error:required field missing"));
@@ -223,33 +264,10 @@ grpc_error_handle ParseRetryPolicy(
     }
   }
   // Parse retryableStatusCodes.
-  it = json.object_value().find("retryableStatusCodes");
-  if (it != json.object_value().end()) {
-    if (it->second.type() != Json::Type::ARRAY) {
-      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-          "field:retryableStatusCodes error:must be of type array"));
-    } else {
-      for (const Json& element : it->second.array_value()) {
-        if (element.type() != Json::Type::STRING) {
-          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-              "field:retryableStatusCodes error:status codes should be of type "
-              "string"));
-          continue;
-        }
-        grpc_status_code status;
-        if (!grpc_status_code_from_string(element.string_value().c_str(),
-                                          &status)) {
-          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-              "field:retryableStatusCodes error:failed to parse status code"));
-          continue;
-        }
-        retryable_status_codes->Add(status);
-      }
-    }
-  }
+  ParseStatusCodes(json, "retryableStatusCodes", retryable_status_codes,
+                   &error_list);
   // Parse perAttemptRecvTimeout.
-  if (grpc_channel_args_find_bool(args, GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING,
-                                  false)) {
+  if (HedgingEnabled(args)) {
     it = json.object_value().find("perAttemptRecvTimeout");
     if (it != json.object_value().end()) {
       Duration per_attempt_recv_timeout_value;
@@ -284,6 +302,26 @@ grpc_error_handle ParseRetryPolicy(
   return GRPC_ERROR_CREATE_FROM_VECTOR("retryPolicy", &error_list);
 }
 
+grpc_error_handle ParseHedgingPolicy(
+    const Json& json, int* max_attempts,
+    RetryMethodConfig::HedgingPolicy* hedging_policy) {
+  if (json.type() != Json::Type::OBJECT) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "field:hedgingPolicy error:should be of type object");
+  }
+  std::vector<grpc_error_handle> error_list;
+  // Parse maxAttempts.
+  ParseMaxAttempts(json, "hedgingPolicy", max_attempts, &error_list);
+  // Parse hedgingDelay.  If unset, all attempts are sent at once.
+  ParseJsonObjectFieldAsDuration(json.object_value(), "hedgingDelay",
+                                 &hedging_policy->hedging_delay, &error_list,
+                                 /*required=*/false);
+  // Parse nonFatalStatusCodes.
+  ParseStatusCodes(json, "nonFatalStatusCodes",
+                   &hedging_policy->non_fatal_status_codes, &error_list);
+  return GRPC_ERROR_CREATE_FROM_VECTOR("hedgingPolicy", &error_list);
+}
+
 }  // namespace
 
 std::unique_ptr<ServiceConfigParser::ParsedConfig>
@@ -291,8 +329,23 @@ RetryServiceConfigParser::ParsePerMethodParams(const grpc_channel_args* args,
                                                const Json& json,
                                                grpc_error_handle* error) {
   GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+  // Parse hedging policy, if hedging is enabled.
+  auto it = json.object_value().find("hedgingPolicy");
+  if (it != json.object_value().end() && HedgingEnabled(args)) {
+    if (json.object_value().find("retryPolicy") != json.object_value().end()) {
+      *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:hedgingPolicy error:retryPolicy and hedgingPolicy are "
+          "mutually exclusive");
+      return nullptr;
+    }
+    int max_attempts = 0;
+    RetryMethodConfig::HedgingPolicy hedging_policy;
+    *error = ParseHedgingPolicy(it->second, &max_attempts, &hedging_policy);
+    if (*error != GRPC_ERROR_NONE) return nullptr;
+    return absl::make_unique<RetryMethodConfig>(max_attempts, hedging_policy);
+  }
   // Parse retry policy.
-  auto it = json.object_value().find("retryPolicy");
+  it = json.object_value().find("retryPolicy");
   if (it == json.object_value().end()) return nullptr;
   int max_attempts = 0;
   Duration initial_backoff;
@@ -50,6 +50,12 @@ class ServerRetryThrottleData : public RefCounted<ServerRetryThrottleData> {
   /// Records a success.
   void RecordSuccess();
 
+  /// Returns true if retries are currently throttled, without changing
+  /// the token count.  Checked before each hedged attempt is started; the
+  /// attempts themselves record successes and non-fatal failures as they
+  /// complete, so failed hedged attempts can throttle later ones.
+  bool IsThrottled();
+
   intptr_t max_milli_tokens() const { return max_milli_tokens_; }
   intptr_t milli_token_ratio() const { return milli_token_ratio_; }
 
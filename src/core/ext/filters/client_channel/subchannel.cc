@@ -72,6 +72,10 @@
 #define GRPC_SUBCHANNEL_RECONNECT_MAX_BACKOFF_SECONDS 120
 #define GRPC_SUBCHANNEL_RECONNECT_JITTER 0.2
 
+// Additional connection parameters.
+#define GRPC_SUBCHANNEL_EXTRA_CONNECTION_IDLE_TIMEOUT_MS 30000
+#define GRPC_SUBCHANNEL_EXTRA_CONNECTION_RETRY_DELAY_SECONDS 1
+
 // Conversion between subchannel call and call stack.
 #define SUBCHANNEL_CALL_TO_CALL_STACK(call) \
   (grpc_call_stack*)((char*)(call) +        \
@@ -91,14 +95,17 @@ DebugOnlyTraceFlag grpc_trace_subchannel_refcount(false, "subchannel_refcount");
 
 ConnectedSubchannel::ConnectedSubchannel(
     grpc_channel_stack* channel_stack, const grpc_channel_args* args,
-    RefCountedPtr<channelz::SubchannelNode> channelz_subchannel)
+    RefCountedPtr<channelz::SubchannelNode> channelz_subchannel,
+    uint32_t max_concurrent_streams, bool count_calls)
     : RefCounted<ConnectedSubchannel>(
           GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel_refcount)
               ? "ConnectedSubchannel"
               : nullptr),
       channel_stack_(channel_stack),
       args_(grpc_channel_args_copy(args)),
-      channelz_subchannel_(std::move(channelz_subchannel)) {}
+      channelz_subchannel_(std::move(channelz_subchannel)),
+      max_concurrent_streams_(max_concurrent_streams),
+      count_calls_(count_calls) {}
 
 ConnectedSubchannel::~ConnectedSubchannel() {
   grpc_channel_args_destroy(args_);
@@ -131,6 +138,17 @@ size_t ConnectedSubchannel::GetInitialCallSizeEstimate() const {
          channel_stack_->call_stack_size;
 }
 
+void ConnectedSubchannel::CallStarted() {
+  if (!count_calls_) return;
+  active_calls_.fetch_add(1, std::memory_order_relaxed);
+  calls_started_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ConnectedSubchannel::CallFinished() {
+  if (!count_calls_) return;
+  active_calls_.fetch_sub(1, std::memory_order_relaxed);
+}
+
 //
 // SubchannelCall
 //
@@ -147,6 +165,9 @@ RefCountedPtr<SubchannelCall> SubchannelCall::Create(Args args,
 SubchannelCall::SubchannelCall(Args args, grpc_error_handle* error)
     : connected_subchannel_(std::move(args.connected_subchannel)),
       deadline_(args.deadline) {
+  // Balanced in Destroy(), which runs even if the call stack fails to
+  // initialize.
+  connected_subchannel_->CallStarted();
   grpc_call_stack* callstk = SUBCHANNEL_CALL_TO_CALL_STACK(this);
   const grpc_call_element_args call_args = {
       callstk,             /* call_stack */
@@ -218,6 +239,7 @@ void SubchannelCall::Destroy(void* arg, grpc_error_handle /*error*/) {
   grpc_closure* after_call_stack_destroy = self->after_call_stack_destroy_;
   RefCountedPtr<ConnectedSubchannel> connected_subchannel =
       std::move(self->connected_subchannel_);
+  connected_subchannel->CallFinished();
   // Destroy the subchannel call.
   self->~SubchannelCall();
   // Destroy the call stack. This should be after destroying the subchannel
@@ -303,8 +325,9 @@ class Subchannel::ConnectedSubchannelStateWatcher
     : public AsyncConnectivityStateWatcherInterface {
  public:
   // Must be instantiated while holding c->mu.
-  explicit ConnectedSubchannelStateWatcher(WeakRefCountedPtr<Subchannel> c)
-      : subchannel_(std::move(c)) {}
+  ConnectedSubchannelStateWatcher(WeakRefCountedPtr<Subchannel> c,
+                                  uint64_t connection_id)
+      : subchannel_(std::move(c)), connection_id_(connection_id) {}
 
   ~ConnectedSubchannelStateWatcher() override {
     subchannel_.reset(DEBUG_LOCATION, "state_watcher");
@@ -315,6 +338,14 @@ class Subchannel::ConnectedSubchannelStateWatcher
                                  const absl::Status& status) override {
     Subchannel* c = subchannel_.get();
     MutexLock lock(&c->mu_);
+    if (c->connection_id_ != connection_id_) {
+      // One of the additional connections.
+      if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
+          new_state == GRPC_CHANNEL_SHUTDOWN) {
+        c->RemoveExtraConnectionLocked(connection_id_);
+      }
+      return;
+    }
     // If we're either shutting down or have already seen this connection
     // failure (i.e., c->connected_subchannel_ is null), do nothing.
     //
@@ -333,6 +364,9 @@ class Subchannel::ConnectedSubchannelStateWatcher
                 ConnectivityStateName(new_state), status.ToString().c_str());
       }
       c->connected_subchannel_.reset();
+      // Additional connections only exist alongside this one.  Calls in
+      // flight on them hold their own refs and finish normally.
+      c->extra_connections_.clear();
       if (c->channelz_node() != nullptr) {
         c->channelz_node()->SetChildSocket(nullptr);
       }
@@ -346,6 +380,7 @@ class Subchannel::ConnectedSubchannelStateWatcher
   }
 
   WeakRefCountedPtr<Subchannel> subchannel_;
+  const uint64_t connection_id_;
 };
 
 // Asynchronously notifies the \a watcher of a change in the connectvity state
@@ -648,6 +683,13 @@ Subchannel::Subchannel(SubchannelKey key,
   GRPC_CLOSURE_INIT(&on_connecting_finished_, OnConnectingFinished, this,
                     grpc_schedule_on_exec_ctx);
   GRPC_CLOSURE_INIT(&on_retry_timer_, OnRetryTimer, this, nullptr);
+  GRPC_CLOSURE_INIT(&on_extra_idle_timer_, OnExtraIdleTimer, this, nullptr);
+  max_connections_ = grpc_channel_args_find_integer(
+      args, GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL, {1, 1, INT_MAX});
+  extra_connection_idle_timeout_ =
+      Duration::Milliseconds(grpc_channel_args_find_integer(
+          args, GRPC_ARG_EXTRA_CONNECTION_IDLE_TIMEOUT_MS,
+          {GRPC_SUBCHANNEL_EXTRA_CONNECTION_IDLE_TIMEOUT_MS, 1, INT_MAX}));
   // Check proxy mapper to determine address to connect to and channel
   // args to use.
   address_for_connect_ = key_.address();
@@ -774,6 +816,31 @@ void Subchannel::CancelConnectivityStateWatch(
   }
 }
 
+RefCountedPtr<ConnectedSubchannel> Subchannel::GetConnectedSubchannelForCall() {
+  MutexLock lock(&mu_);
+  if (max_connections_ == 1 || connected_subchannel_ == nullptr) {
+    return connected_subchannel_;
+  }
+  // Pick the connection with the most room under its stream limit.
+  auto room = [](const ConnectedSubchannel* connection) {
+    return static_cast<int64_t>(connection->max_concurrent_streams()) -
+           connection->active_calls();
+  };
+  ConnectedSubchannel* best = connected_subchannel_.get();
+  int64_t best_room = room(best);
+  for (const ExtraConnection& extra : extra_connections_) {
+    const int64_t extra_room = room(extra.connected_subchannel.get());
+    if (extra_room > best_room) {
+      best = extra.connected_subchannel.get();
+      best_room = extra_room;
+    }
+  }
+  // If there is none, this call will wait in the transport for a stream to
+  // free up; open another connection for the ones after it.
+  if (best_room <= 0) MaybeStartExtraConnectionLocked();
+  return best->Ref();
+}
+
 void Subchannel::RequestConnection() {
   MutexLock lock(&mu_);
   if (state_ == GRPC_CHANNEL_IDLE) {
@@ -805,6 +872,8 @@ void Subchannel::Orphan() {
   shutdown_ = true;
   connector_.reset();
   connected_subchannel_.reset();
+  extra_connections_.clear();
+  if (extra_idle_timer_pending_) grpc_timer_cancel(&extra_idle_timer_);
   health_watcher_map_.ShutdownLocked();
 }
 
@@ -903,6 +972,12 @@ void Subchannel::StartConnectingLocked() {
   next_attempt_time_ = backoff_.NextAttemptTime();
   // Report CONNECTING.
   SetConnectivityStateLocked(GRPC_CHANNEL_CONNECTING, absl::OkStatus());
+  // If an additional connection is still being connected, take it over
+  // instead; connector_ supports only one attempt at a time.
+  if (extra_connect_in_flight_) {
+    extra_connect_in_flight_ = false;
+    return;
+  }
   // Start connection attempt.
   SubchannelConnector::Args args;
   args.address = &address_for_connect_;
@@ -930,6 +1005,11 @@ void Subchannel::OnConnectingFinishedLocked(grpc_error_handle error) {
     (void)GRPC_ERROR_UNREF(error);
     return;
   }
+  if (extra_connect_in_flight_) {
+    extra_connect_in_flight_ = false;
+    OnExtraConnectingFinishedLocked(error);
+    return;
+  }
   // If we didn't get a transport or we fail to publish it, report
   // TRANSIENT_FAILURE and start the retry timer.
   // Note that if the connection attempt took longer than the backoff
@@ -952,12 +1032,38 @@ void Subchannel::OnConnectingFinishedLocked(grpc_error_handle error) {
 }
 
 bool Subchannel::PublishTransportLocked() {
+  RefCountedPtr<channelz::SocketNode> socket;
+  RefCountedPtr<ConnectedSubchannel> connected_subchannel =
+      CreateConnectedSubchannelLocked(&socket);
+  if (connected_subchannel == nullptr) return false;
+  // Publish.
+  connected_subchannel_ = std::move(connected_subchannel);
+  connection_id_ = next_connection_id_++;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+    gpr_log(GPR_INFO, "subchannel %p %s: new connected subchannel at %p", this,
+            key_.ToString().c_str(), connected_subchannel_.get());
+  }
+  if (channelz_node_ != nullptr) {
+    channelz_node_->SetChildSocket(std::move(socket));
+  }
+  // Start watching connected subchannel.
+  connected_subchannel_->StartWatch(
+      pollset_set_,
+      MakeOrphanable<ConnectedSubchannelStateWatcher>(
+          WeakRef(DEBUG_LOCATION, "state_watcher"), connection_id_));
+  // Report initial state.
+  SetConnectivityStateLocked(GRPC_CHANNEL_READY, absl::Status());
+  return true;
+}
+
+RefCountedPtr<ConnectedSubchannel> Subchannel::CreateConnectedSubchannelLocked(
+    RefCountedPtr<channelz::SocketNode>* socket) {
   // Construct channel stack.
   ChannelStackBuilderImpl builder("subchannel", GRPC_CLIENT_SUBCHANNEL);
   builder.SetChannelArgs(ChannelArgs::FromC(connecting_result_.channel_args))
       .SetTransport(connecting_result_.transport);
   if (!CoreConfiguration::Get().channel_init().CreateStack(&builder)) {
-    return false;
+    return nullptr;
   }
   absl::StatusOr<RefCountedPtr<grpc_channel_stack>> stk = builder.Build();
   if (!stk.ok()) {
@@ -967,29 +1073,143 @@ bool Subchannel::PublishTransportLocked() {
             "subchannel %p %s: error initializing subchannel stack: %s", this,
             key_.ToString().c_str(), grpc_error_std_string(error).c_str());
     GRPC_ERROR_UNREF(error);
-    return false;
+    return nullptr;
   }
-  RefCountedPtr<channelz::SocketNode> socket =
-      std::move(connecting_result_.socket_node);
+  *socket = std::move(connecting_result_.socket_node);
+  const uint32_t max_concurrent_streams =
+      connecting_result_.max_concurrent_streams;
   connecting_result_.Reset();
-  if (shutdown_) return false;
-  // Publish.
-  connected_subchannel_.reset(
-      new ConnectedSubchannel(stk->release(), args_, channelz_node_));
+  if (shutdown_) return nullptr;
+  return MakeRefCounted<ConnectedSubchannel>(
+      stk->release(), args_, channelz_node_, max_concurrent_streams,
+      /*count_calls=*/max_connections_ > 1);
+}
+
+void Subchannel::MaybeStartExtraConnectionLocked() {
+  if (extra_connect_in_flight_ ||
+      extra_connections_.size() + 1 >= static_cast<size_t>(max_connections_)) {
+    return;
+  }
+  const Timestamp now = ExecCtx::Get()->Now();
+  if (now < next_extra_attempt_time_) return;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
-    gpr_log(GPR_INFO, "subchannel %p %s: new connected subchannel at %p", this,
-            key_.ToString().c_str(), connected_subchannel_.get());
+    gpr_log(GPR_INFO,
+            "subchannel %p %s: all %" PRIuPTR
+            " connections at their stream limit, opening another one",
+            this, key_.ToString().c_str(), extra_connections_.size() + 1);
   }
-  if (channelz_node_ != nullptr) {
-    channelz_node_->SetChildSocket(std::move(socket));
+  extra_connect_in_flight_ = true;
+  SubchannelConnector::Args args;
+  args.address = &address_for_connect_;
+  args.interested_parties = pollset_set_;
+  args.deadline = now + min_connect_timeout_;
+  args.channel_args = args_;
+  WeakRef(DEBUG_LOCATION, "Connect").release();  // Ref held by callback.
+  connector_->Connect(args, &connecting_result_, &on_connecting_finished_);
+}
+
+void Subchannel::OnExtraConnectingFinishedLocked(grpc_error_handle error) {
+  // If the primary connection went away while this one was being
+  // connected, and nothing has asked for a new one yet, use this one in
+  // its place.
+  if (state_ != GRPC_CHANNEL_READY) {
+    if (connecting_result_.transport != nullptr) PublishTransportLocked();
+    (void)GRPC_ERROR_UNREF(error);
+    return;
   }
-  // Start watching connected subchannel.
-  connected_subchannel_->StartWatch(
-      pollset_set_, MakeOrphanable<ConnectedSubchannelStateWatcher>(
-                        WeakRef(DEBUG_LOCATION, "state_watcher")));
-  // Report initial state.
-  SetConnectivityStateLocked(GRPC_CHANNEL_READY, absl::Status());
-  return true;
+  RefCountedPtr<channelz::SocketNode> socket;
+  RefCountedPtr<ConnectedSubchannel> connected_subchannel;
+  if (connecting_result_.transport != nullptr) {
+    connected_subchannel = CreateConnectedSubchannelLocked(&socket);
+  }
+  if (connected_subchannel == nullptr) {
+    gpr_log(GPR_INFO,
+            "subchannel %p %s: additional connection failed (%s), not "
+            "retrying for %d s",
+            this, key_.ToString().c_str(), grpc_error_std_string(error).c_str(),
+            GRPC_SUBCHANNEL_EXTRA_CONNECTION_RETRY_DELAY_SECONDS);
+    next_extra_attempt_time_ =
+        ExecCtx::Get()->Now() +
+        Duration::Seconds(GRPC_SUBCHANNEL_EXTRA_CONNECTION_RETRY_DELAY_SECONDS);
+    (void)GRPC_ERROR_UNREF(error);
+    return;
+  }
+  (void)GRPC_ERROR_UNREF(error);
+  const uint64_t connection_id = next_connection_id_++;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+    gpr_log(GPR_INFO,
+            "subchannel %p %s: new additional connected subchannel at %p", this,
+            key_.ToString().c_str(), connected_subchannel.get());
+  }
+  connected_subchannel->StartWatch(
+      pollset_set_,
+      MakeOrphanable<ConnectedSubchannelStateWatcher>(
+          WeakRef(DEBUG_LOCATION, "state_watcher"), connection_id));
+  extra_connections_.push_back(
+      {std::move(connected_subchannel), connection_id});
+  if (!extra_idle_timer_pending_) {
+    extra_idle_timer_pending_ = true;
+    WeakRef(DEBUG_LOCATION, "ExtraIdleTimer").release();
+    grpc_timer_init(&extra_idle_timer_,
+                    ExecCtx::Get()->Now() + extra_connection_idle_timeout_,
+                    &on_extra_idle_timer_);
+  }
+}
+
+void Subchannel::RemoveExtraConnectionLocked(uint64_t connection_id) {
+  for (auto it = extra_connections_.begin(); it != extra_connections_.end();
+       ++it) {
+    if (it->id == connection_id) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+        gpr_log(GPR_INFO,
+                "subchannel %p %s: additional connected subchannel %p closed",
+                this, key_.ToString().c_str(),
+                it->connected_subchannel.get());
+      }
+      extra_connections_.erase(it);
+      return;
+    }
+  }
+}
+
+void Subchannel::OnExtraIdleTimer(void* arg, grpc_error_handle error) {
+  WeakRefCountedPtr<Subchannel> c(static_cast<Subchannel*>(arg));
+  {
+    MutexLock lock(&c->mu_);
+    c->extra_idle_timer_pending_ = false;
+    if (error == GRPC_ERROR_NONE && !c->shutdown_) c->OnExtraIdleTimerLocked();
+  }
+  c.reset(DEBUG_LOCATION, "ExtraIdleTimer");
+}
+
+void Subchannel::OnExtraIdleTimerLocked() {
+  // Close the additional connections that had no call in flight and none
+  // started during the last period.
+  auto idle = [](ExtraConnection& extra) {
+    const uint64_t calls_started = extra.connected_subchannel->calls_started();
+    const bool unused = extra.connected_subchannel->active_calls() == 0 &&
+                        calls_started == extra.calls_started_at_last_tick;
+    extra.calls_started_at_last_tick = calls_started;
+    return unused;
+  };
+  const size_t size_before = extra_connections_.size();
+  extra_connections_.erase(std::remove_if(extra_connections_.begin(),
+                                          extra_connections_.end(), idle),
+                           extra_connections_.end());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel) &&
+      extra_connections_.size() != size_before) {
+    gpr_log(GPR_INFO,
+            "subchannel %p %s: closed %" PRIuPTR
+            " idle additional connection(s)",
+            this, key_.ToString().c_str(),
+            size_before - extra_connections_.size());
+  }
+  if (extra_connections_.empty()) return;
+  extra_idle_timer_pending_ = true;
+  WeakRef(DEBUG_LOCATION, "ExtraIdleTimer").release();
+  grpc_timer_init(&extra_idle_timer_,
+                  ExecCtx::Get()->Now() + extra_connection_idle_timeout_,
+                  &on_extra_idle_timer_);
 }
 
 }  // namespace grpc_core
@@ -20,10 +20,13 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <atomic>
 #include <deque>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/status/status.h"
@@ -66,9 +69,12 @@ class SubchannelCall;
 
 class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
  public:
+  // If count_calls is true, the calls in flight on this connection are
+  // tracked, for the subchannel to spread calls across its connections.
   ConnectedSubchannel(
       grpc_channel_stack* channel_stack, const grpc_channel_args* args,
-      RefCountedPtr<channelz::SubchannelNode> channelz_subchannel);
+      RefCountedPtr<channelz::SubchannelNode> channelz_subchannel,
+      uint32_t max_concurrent_streams = UINT32_MAX, bool count_calls = false);
   ~ConnectedSubchannel() override;
 
   void StartWatch(grpc_pollset_set* interested_parties,
@@ -84,12 +90,32 @@ class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
 
   size_t GetInitialCallSizeEstimate() const;
 
+  // Number of concurrent calls the peer allows on this connection.
+  uint32_t max_concurrent_streams() const { return max_concurrent_streams_; }
+  // Number of calls in flight and number of calls ever started on this
+  // connection.  Both are always 0 unless count_calls was set.
+  uint32_t active_calls() const {
+    return active_calls_.load(std::memory_order_relaxed);
+  }
+  uint64_t calls_started() const {
+    return calls_started_.load(std::memory_order_relaxed);
+  }
+
  private:
+  friend class SubchannelCall;
+
+  void CallStarted();
+  void CallFinished();
+
   grpc_channel_stack* channel_stack_;
   grpc_channel_args* args_;
   // ref counted pointer to the channelz node in this connected subchannel's
   // owning subchannel.
   RefCountedPtr<channelz::SubchannelNode> channelz_subchannel_;
+  const uint32_t max_concurrent_streams_;
+  const bool count_calls_;
+  std::atomic<uint32_t> active_calls_{0};
+  std::atomic<uint64_t> calls_started_{0};
 };
 
 // Implements the interface of RefCounted<>.
@@ -265,6 +291,14 @@ class Subchannel : public DualRefCounted<Subchannel> {
     return connected_subchannel_;
   }
 
+  // Returns the connection to start a new call on, or null if the
+  // subchannel is not connected.  When GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL
+  // allows more than one connection, this is the connection with the most
+  // room under its peer's stream limit, and another connection is started
+  // if none has any room left.
+  RefCountedPtr<ConnectedSubchannel> GetConnectedSubchannelForCall()
+      ABSL_LOCKS_EXCLUDED(mu_);
+
   // Attempt to connect to the backend.  Has no effect if already connected.
   void RequestConnection() ABSL_LOCKS_EXCLUDED(mu_);
 
@@ -364,6 +398,19 @@ class Subchannel : public DualRefCounted<Subchannel> {
   void OnConnectingFinishedLocked(grpc_error_handle error)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   bool PublishTransportLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  RefCountedPtr<ConnectedSubchannel> CreateConnectedSubchannelLocked(
+      RefCountedPtr<channelz::SocketNode>* socket)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Methods for additional connections.
+  void MaybeStartExtraConnectionLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void OnExtraConnectingFinishedLocked(grpc_error_handle error)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void RemoveExtraConnectionLocked(uint64_t connection_id)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  static void OnExtraIdleTimer(void* arg, grpc_error_handle error)
+      ABSL_LOCKS_EXCLUDED(mu_);
+  void OnExtraIdleTimerLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   // The subchannel pool this subchannel is in.
   RefCountedPtr<SubchannelPoolInterface> subchannel_pool_;
@@ -380,6 +427,10 @@ class Subchannel : public DualRefCounted<Subchannel> {
   RefCountedPtr<channelz::SubchannelNode> channelz_node_;
   // Minimum connection timeout.
   Duration min_connect_timeout_;
+  // Maximum number of connections, including connected_subchannel_.
+  int max_connections_;
+  // Time after which an unused additional connection is closed.
+  Duration extra_connection_idle_timeout_;
 
   // Connection state.
   OrphanablePtr<SubchannelConnector> connector_;
@@ -410,6 +461,31 @@ class Subchannel : public DualRefCounted<Subchannel> {
 
   // Active connection, or null.
   RefCountedPtr<ConnectedSubchannel> connected_subchannel_ ABSL_GUARDED_BY(mu_);
+  // Identifies connected_subchannel_ to its state watcher.  Connections are
+  // numbered rather than compared by address, since a new connection may
+  // be allocated where a closed one was.
+  uint64_t connection_id_ ABSL_GUARDED_BY(mu_) = 0;
+  uint64_t next_connection_id_ ABSL_GUARDED_BY(mu_) = 1;
+
+  // Additional connections, opened while connected_subchannel_ is set and
+  // every connection is at its stream limit.  They are closed along with
+  // connected_subchannel_, or once they go unused for
+  // extra_connection_idle_timeout_.
+  struct ExtraConnection {
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel;
+    uint64_t id;
+    // connected_subchannel->calls_started() at the last idle timer tick.
+    uint64_t calls_started_at_last_tick = 0;
+  };
+  std::vector<ExtraConnection> extra_connections_ ABSL_GUARDED_BY(mu_);
+  // True while connector_ is connecting an additional connection.  If the
+  // subchannel starts connecting in the meantime, the attempt is adopted as
+  // the subchannel's own connection attempt instead.
+  bool extra_connect_in_flight_ ABSL_GUARDED_BY(mu_) = false;
+  Timestamp next_extra_attempt_time_ ABSL_GUARDED_BY(mu_);
+  bool extra_idle_timer_pending_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_timer extra_idle_timer_ ABSL_GUARDED_BY(mu_);
+  grpc_closure on_extra_idle_timer_ ABSL_GUARDED_BY(mu_);
 
   // Backoff state.
   BackOff backoff_ ABSL_GUARDED_BY(mu_);
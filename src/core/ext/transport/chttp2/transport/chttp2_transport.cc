@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <new>
 #include <string>
@@ -277,10 +278,21 @@ grpc_chttp2_transport::~grpc_chttp2_transport() {
 
 static const grpc_transport_vtable* get_vtable(void);
 
+// Returns true if this transport should get a channelz socket node, given
+// GRPC_ARG_CHANNELZ_SOCKET_SAMPLING_INTERVAL.
+static bool sample_channelz_socket(int sampling_interval) {
+  static std::atomic<uint64_t> transport_count{0};
+  if (sampling_interval <= 1) return sampling_interval == 1;
+  return transport_count.fetch_add(1, std::memory_order_relaxed) %
+             sampling_interval ==
+         0;
+}
+
 static void read_channel_args(grpc_chttp2_transport* t,
                               const grpc_channel_args* channel_args,
                               bool is_client) {
   bool channelz_enabled = GRPC_ENABLE_CHANNELZ_DEFAULT;
+  int channelz_socket_sampling_interval = 1;
   size_t i;
   int j;
 
@@ -362,6 +374,10 @@ static void read_channel_args(grpc_chttp2_transport* t,
                strcmp(channel_args->args[i].key, GRPC_ARG_ENABLE_CHANNELZ)) {
       channelz_enabled = grpc_channel_arg_get_bool(
           &channel_args->args[i], GRPC_ENABLE_CHANNELZ_DEFAULT);
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_CHANNELZ_SOCKET_SAMPLING_INTERVAL)) {
+      channelz_socket_sampling_interval =
+          grpc_channel_arg_get_integer(&channel_args->args[i], {1, 0, INT_MAX});
     } else {
       static const struct {
         const char* channel_arg_name;
@@ -412,7 +428,8 @@ static void read_channel_args(grpc_chttp2_transport* t,
       }
     }
   }
-  if (channelz_enabled) {
+  if (channelz_enabled &&
+      sample_channelz_socket(channelz_socket_sampling_interval)) {
     t->channelz_socket =
         grpc_core::MakeRefCounted<grpc_core::channelz::SocketNode>(
             std::string(grpc_endpoint_get_local_address(t->ep)), t->peer_string,
@@ -884,6 +901,7 @@ void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
   switch (t->write_state) {
     case GRPC_CHTTP2_WRITE_STATE_IDLE:
       inc_initiate_write_reason(reason);
+      t->write_initiated_at = grpc_stats_start_timer();
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING,
                       grpc_chttp2_initiate_write_reason_string(reason));
       GRPC_CHTTP2_REF_TRANSPORT(t, "writing");
@@ -1013,6 +1031,8 @@ static void write_action_end_locked(void* tp, grpc_error_handle error) {
     }
   }
 
+  GRPC_STATS_INC_HTTP2_WRITE_FLUSH_DELAY_US(
+      grpc_stats_micros_since(t->write_initiated_at));
   switch (t->write_state) {
     case GRPC_CHTTP2_WRITE_STATE_IDLE:
       GPR_UNREACHABLE_CODE(break);
@@ -1023,6 +1043,7 @@ static void write_action_end_locked(void* tp, grpc_error_handle error) {
     case GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE:
       GPR_TIMER_MARK("state=writing_stale_no_poller", 0);
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING, "continue writing");
+      t->write_initiated_at = grpc_stats_start_timer();
       GRPC_CHTTP2_REF_TRANSPORT(t, "writing");
       // If the transport is closed, we will retry writing on the endpoint
       // and next write may contain part of the currently serialized frames.
@@ -3084,6 +3105,13 @@ grpc_chttp2_transport_get_socket_node(grpc_transport* transport) {
   return t->channelz_socket;
 }
 
+uint32_t grpc_chttp2_transport_peer_max_concurrent_streams(
+    grpc_transport* transport) {
+  grpc_chttp2_transport* t =
+      reinterpret_cast<grpc_chttp2_transport*>(transport);
+  return t->peer_max_concurrent_streams.load(std::memory_order_relaxed);
+}
+
 grpc_transport* grpc_create_chttp2_transport(
     const grpc_channel_args* channel_args, grpc_endpoint* ep, bool is_client) {
   auto t = new grpc_chttp2_transport(channel_args, ep, is_client);
@@ -21,6 +21,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/slice.h>
 
@@ -46,6 +48,11 @@ grpc_transport* grpc_create_chttp2_transport(
 grpc_core::RefCountedPtr<grpc_core::channelz::SocketNode>
 grpc_chttp2_transport_get_socket_node(grpc_transport* transport);
 
+/// Returns the peer's SETTINGS_MAX_CONCURRENT_STREAMS, as of the last
+/// SETTINGS frame received; UINT32_MAX (unlimited) before the first one.
+uint32_t grpc_chttp2_transport_peer_max_concurrent_streams(
+    grpc_transport* transport);
+
 /// Takes ownership of \a read_buffer, which (if non-NULL) contains
 /// leftover bytes previously read from the endpoint (e.g., by handshakers).
 /// If non-null, \a notify_on_receive_settings will be scheduled when
@@ -24,6 +24,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <string>
 
 #include "absl/strings/string_view.h"
@@ -46,6 +47,7 @@
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/bitset.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -256,6 +258,8 @@ struct grpc_chttp2_transport {
 
   /** write execution state of the transport */
   grpc_chttp2_write_state write_state = GRPC_CHTTP2_WRITE_STATE_IDLE;
+  /** when the current write was initiated, for the write flush delay stat */
+  gpr_cycle_counter write_initiated_at = 0;
 
   /** is the transport destroying itself? */
   uint8_t destroying = false;
@@ -323,6 +327,9 @@ struct grpc_chttp2_transport {
   uint32_t force_send_settings = 1 << GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE;
   /** settings values */
   uint32_t settings[GRPC_NUM_SETTING_SETS][GRPC_CHTTP2_NUM_SETTINGS];
+  /** the peer's MAX_CONCURRENT_STREAMS setting, readable outside the
+      combiner */
+  std::atomic<uint32_t> peer_max_concurrent_streams{UINT32_MAX};
 
   /** what is the next stream id to be allocated by this peer?
       copied to next_stream_id in parsing when parsing commences */
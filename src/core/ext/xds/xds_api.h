@@ -62,6 +62,8 @@ class XdsApi {
       std::string version;
       std::string nonce;
       size_t num_resources;
+      // Delta xDS only.
+      size_t num_removed_resources = 0;
     };
 
     virtual ~AdsResponseParserInterface() = default;
@@ -72,9 +74,19 @@ class XdsApi {
     virtual absl::Status ProcessAdsResponseFields(AdsResponseFields fields) = 0;
 
     // Called to parse each individual resource in the ADS response.
+    // If the resource was wrapped in a Resource message, resource_name is
+    // the name given there, which lets the parser skip the resource without
+    // decoding it; otherwise, it is empty.  For Delta xDS, resource_version
+    // is the version of the individual resource; otherwise, it is empty.
     virtual void ParseResource(const XdsEncodingContext& context, size_t idx,
                                absl::string_view type_url,
-                               absl::string_view serialized_resource) = 0;
+                               absl::string_view resource_name,
+                               absl::string_view serialized_resource,
+                               absl::string_view resource_version) = 0;
+
+    // Called for each resource that a Delta xDS response removes.
+    virtual void RemoveResource(size_t idx,
+                                absl::string_view resource_name) = 0;
   };
 
   struct ClusterLoadReport {
@@ -157,12 +169,28 @@ class XdsApi {
                               const std::vector<std::string>& resource_names,
                               grpc_error_handle error, bool populate_node);
 
+  // Creates a Delta ADS request.  initial_resource_versions is sent only
+  // in the first request for a resource type on a stream.
+  // Takes ownership of \a error.
+  grpc_slice CreateDeltaAdsRequest(
+      const XdsBootstrap::XdsServer& server, absl::string_view type_url,
+      absl::string_view nonce,
+      const std::vector<std::string>& resource_names_subscribe,
+      const std::vector<std::string>& resource_names_unsubscribe,
+      const std::map<std::string, std::string>& initial_resource_versions,
+      grpc_error_handle error, bool populate_node);
+
   // Returns non-OK when failing to deserialize response message.
   // Otherwise, all events are reported to the parser.
   absl::Status ParseAdsResponse(const XdsBootstrap::XdsServer& server,
                                 const grpc_slice& encoded_response,
                                 AdsResponseParserInterface* parser);
 
+  // Same as ParseAdsResponse(), but for a Delta ADS response.
+  absl::Status ParseDeltaAdsResponse(const XdsBootstrap::XdsServer& server,
+                                     const grpc_slice& encoded_response,
+                                     AdsResponseParserInterface* parser);
+
   // Creates an initial LRS request.
   grpc_slice CreateLrsInitialRequest(const XdsBootstrap::XdsServer& server);
 
@@ -76,6 +76,9 @@ class XdsBootstrap {
     Json::Object ToJson() const;
 
     bool ShouldUseV3() const;
+    // True if the server speaks the incremental (Delta) variant of ADS.
+    // Requires xDS v3.
+    bool ShouldUseDelta() const;
   };
 
   struct Authority {
@@ -23,8 +23,10 @@
 #include <string.h>
 
 #include <algorithm>
+#include <iterator>
 
 #include "absl/container/inlined_vector.h"
+#include "absl/hash/hash.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -189,7 +191,12 @@ class XdsClient::ChannelState::AdsCallState
 
     void ParseResource(const XdsEncodingContext& context, size_t idx,
                        absl::string_view type_url,
-                       absl::string_view serialized_resource) override
+                       absl::string_view resource_name,
+                       absl::string_view serialized_resource,
+                       absl::string_view resource_version) override
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    void RemoveResource(size_t idx, absl::string_view resource_name) override
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
 
     Result TakeResult() { return std::move(result_); }
@@ -197,6 +204,33 @@ class XdsClient::ChannelState::AdsCallState
    private:
     XdsClient* xds_client() const { return ads_call_state_->xds_client(); }
 
+    bool delta() const {
+      return ads_call_state_->chand()->server_.ShouldUseDelta();
+    }
+
+    // Cancels the resource-does-not-exist timer for the resource, if any.
+    void MaybeCancelResourceTimer(const XdsResourceName& resource_name)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    // Returns the state of the resource, or null if we don't have a
+    // subscription for it.
+    ResourceState* FindResourceState(const XdsResourceName& resource_name)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    // If the resource is byte-identical to the one we already have,
+    // records that we've seen it and returns true, so that the caller can
+    // skip decoding it.
+    bool MaybeSkipUnchangedResource(const XdsResourceName& resource_name,
+                                    size_t hash,
+                                    absl::string_view serialized_resource,
+                                    const std::string& version,
+                                    ResourceState* resource_state)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    // Records that we've seen the resource, if needed.
+    void RecordResourceSeen(const XdsResourceName& resource_name)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
     AdsCallState* ads_call_state_;
     const Timestamp update_time_ = ExecCtx::Get()->Now();
     Result result_;
@@ -315,11 +349,25 @@ class XdsClient::ChannelState::AdsCallState
     std::map<std::string /*authority*/,
              std::map<XdsResourceKey, OrphanablePtr<ResourceTimer>>>
         subscribed_resources;
+
+    // Delta xDS only: the resource names that the server has been told
+    // we are subscribed to on this stream, and whether any request for
+    // this type has been sent on this stream yet.
+    std::set<std::string> delta_subscribed_names;
+    bool delta_request_sent = false;
   };
 
   void SendMessageLocked(const XdsResourceType* type)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
 
+  // Creates the next Delta ADS request for type, containing only the
+  // changes since the last one.  Returns false if there is nothing to
+  // send.
+  bool CreateDeltaRequestLocked(const XdsResourceType* type,
+                                ResourceTypeState* state,
+                                grpc_slice* request_payload_slice)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
   static void OnRequestSent(void* arg, grpc_error_handle error);
   void OnRequestSentLocked(grpc_error_handle error)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
@@ -766,11 +814,12 @@ absl::Status XdsClient::ChannelState::AdsCallState::AdsResponseParser::
     gpr_log(
         GPR_INFO,
         "[xds_client %p] xds server %s: received ADS response: type_url=%s, "
-        "version=%s, nonce=%s, num_resources=%" PRIuPTR,
+        "version=%s, nonce=%s, num_resources=%" PRIuPTR
+        ", num_removed_resources=%" PRIuPTR,
         ads_call_state_->xds_client(),
         ads_call_state_->chand()->server_.server_uri.c_str(),
         fields.type_url.c_str(), fields.version.c_str(), fields.nonce.c_str(),
-        fields.num_resources);
+        fields.num_resources, fields.num_removed_resources);
   }
   result_.type =
       ads_call_state_->xds_client()->GetResourceTypeLocked(fields.type_url);
@@ -810,9 +859,86 @@ void UpdateResourceMetadataNacked(const std::string& version,
 
 }  // namespace
 
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    MaybeCancelResourceTimer(const XdsResourceName& resource_name) {
+  auto timer_it = ads_call_state_->state_map_.find(result_.type);
+  if (timer_it != ads_call_state_->state_map_.end()) {
+    auto it =
+        timer_it->second.subscribed_resources.find(resource_name.authority);
+    if (it != timer_it->second.subscribed_resources.end()) {
+      auto res_it = it->second.find(resource_name.key);
+      if (res_it != it->second.end()) {
+        res_it->second->MaybeCancelTimer();
+      }
+    }
+  }
+}
+
+XdsClient::ResourceState*
+XdsClient::ChannelState::AdsCallState::AdsResponseParser::FindResourceState(
+    const XdsResourceName& resource_name) {
+  // Lookup the authority in the cache.
+  auto authority_it =
+      xds_client()->authority_state_map_.find(resource_name.authority);
+  if (authority_it == xds_client()->authority_state_map_.end()) {
+    return nullptr;
+  }
+  // Found authority, so look up type.
+  AuthorityState& authority_state = authority_it->second;
+  auto type_it = authority_state.resource_map.find(result_.type);
+  if (type_it == authority_state.resource_map.end()) return nullptr;
+  auto& type_map = type_it->second;
+  // Found type, so look up resource key.
+  auto it = type_map.find(resource_name.key);
+  if (it == type_map.end()) return nullptr;
+  return &it->second;
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    RecordResourceSeen(const XdsResourceName& resource_name) {
+  if (!ads_call_state_->chand()->server_.ShouldUseDelta() &&
+      result_.type->AllResourcesRequiredInSotW()) {
+    result_.resources_seen[resource_name.authority].insert(resource_name.key);
+  }
+}
+
+bool XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    MaybeSkipUnchangedResource(const XdsResourceName& resource_name,
+                               size_t hash,
+                               absl::string_view serialized_resource,
+                               const std::string& version,
+                               ResourceState* resource_state) {
+  if (resource_state->resource == nullptr ||
+      resource_state->serialized_proto_hash != hash ||
+      resource_state->meta.serialized_proto != serialized_resource) {
+    return false;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+    gpr_log(GPR_INFO,
+            "[xds_client %p] %s resource %s unchanged, skipping decode.",
+            xds_client(), result_.type_url.c_str(),
+            ConstructFullXdsResourceName(resource_name.authority,
+                                         result_.type->type_url(),
+                                         resource_name.key)
+                .c_str());
+  }
+  MaybeCancelResourceTimer(resource_name);
+  RecordResourceSeen(resource_name);
+  result_.have_valid_resources = true;
+  // With Delta xDS, keep the version current, so that it is what we
+  // report when we resubscribe on a new stream.
+  if (delta()) resource_state->meta.version = version;
+  return true;
+}
+
 void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
     const XdsEncodingContext& context, size_t idx, absl::string_view type_url,
-    absl::string_view serialized_resource) {
+    absl::string_view resource_name, absl::string_view serialized_resource,
+    absl::string_view resource_version) {
+  // With Delta xDS, each resource has its own version.
+  const std::string version = resource_version.empty()
+                                  ? result_.version
+                                  : std::string(resource_version);
   // Check the type_url of the resource.
   bool is_v2 = false;
   if (!result_.type->IsType(type_url, &is_v2)) {
@@ -821,6 +947,39 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
                      type_url, " (should be ", result_.type_url, ")"));
     return;
   }
+  // Most resources in a response are usually the same as the ones we
+  // already have, so before decoding the resource, see whether we can
+  // tell that it is unchanged or that no one is watching it.
+  const size_t hash = absl::Hash<absl::string_view>()(serialized_resource);
+  if (!resource_name.empty()) {
+    auto parsed_name =
+        xds_client()->ParseXdsResourceName(resource_name, result_.type);
+    if (parsed_name.ok()) {
+      ResourceState* resource_state = FindResourceState(*parsed_name);
+      if (resource_state == nullptr) {
+        // Skip resource -- we don't have a subscription for it.
+        MaybeCancelResourceTimer(*parsed_name);
+        return;
+      }
+      if (MaybeSkipUnchangedResource(*parsed_name, hash, serialized_resource,
+                                     version, resource_state)) {
+        return;
+      }
+    }
+  } else {
+    auto index_it = xds_client()->resource_hash_index_.find(result_.type);
+    if (index_it != xds_client()->resource_hash_index_.end()) {
+      auto it = index_it->second.find(hash);
+      if (it != index_it->second.end()) {
+        ResourceState* resource_state = FindResourceState(it->second);
+        if (resource_state != nullptr &&
+            MaybeSkipUnchangedResource(it->second, hash, serialized_resource,
+                                       version, resource_state)) {
+          return;
+        }
+      }
+    }
+  }
   // Parse the resource.
   absl::StatusOr<XdsResourceType::DecodeResult> result =
       result_.type->Decode(context, serialized_resource, is_v2);
@@ -830,84 +989,65 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
     return;
   }
   // Check the resource name.
-  auto resource_name =
+  auto parsed_name =
       xds_client()->ParseXdsResourceName(result->name, result_.type);
-  if (!resource_name.ok()) {
+  if (!parsed_name.ok()) {
     result_.errors.emplace_back(absl::StrCat(
         "resource index ", idx, ": Cannot parse xDS resource name \"",
         result->name, "\""));
     return;
   }
   // Cancel resource-does-not-exist timer, if needed.
-  auto timer_it = ads_call_state_->state_map_.find(result_.type);
-  if (timer_it != ads_call_state_->state_map_.end()) {
-    auto it =
-        timer_it->second.subscribed_resources.find(resource_name->authority);
-    if (it != timer_it->second.subscribed_resources.end()) {
-      auto res_it = it->second.find(resource_name->key);
-      if (res_it != it->second.end()) {
-        res_it->second->MaybeCancelTimer();
-      }
-    }
-  }
-  // Lookup the authority in the cache.
-  auto authority_it =
-      xds_client()->authority_state_map_.find(resource_name->authority);
-  if (authority_it == xds_client()->authority_state_map_.end()) {
+  MaybeCancelResourceTimer(*parsed_name);
+  ResourceState* resource_state = FindResourceState(*parsed_name);
+  if (resource_state == nullptr) {
     return;  // Skip resource -- we don't have a subscription for it.
   }
-  // Found authority, so look up type.
-  AuthorityState& authority_state = authority_it->second;
-  auto type_it = authority_state.resource_map.find(result_.type);
-  if (type_it == authority_state.resource_map.end()) {
-    return;  // Skip resource -- we don't have a subscription for it.
-  }
-  auto& type_map = type_it->second;
-  // Found type, so look up resource key.
-  auto it = type_map.find(resource_name->key);
-  if (it == type_map.end()) {
-    return;  // Skip resource -- we don't have a subscription for it.
-  }
-  ResourceState& resource_state = it->second;
   // If needed, record that we've seen this resource.
-  if (result_.type->AllResourcesRequiredInSotW()) {
-    result_.resources_seen[resource_name->authority].insert(resource_name->key);
-  }
+  RecordResourceSeen(*parsed_name);
   // Update resource state based on whether the resource is valid.
   if (!result->resource.ok()) {
     result_.errors.emplace_back(absl::StrCat(
         "resource index ", idx, ": ", result->name,
         ": validation error: ", result->resource.status().ToString()));
     xds_client()->NotifyWatchersOnErrorLocked(
-        resource_state.watchers,
+        resource_state->watchers,
         absl::UnavailableError(absl::StrCat(
             "invalid resource: ", result->resource.status().ToString())));
-    UpdateResourceMetadataNacked(result_.version,
-                                 result->resource.status().ToString(),
-                                 update_time_, &resource_state.meta);
+    UpdateResourceMetadataNacked(version, result->resource.status().ToString(),
+                                 update_time_, &resource_state->meta);
     return;
   }
   // Resource is valid.
   result_.have_valid_resources = true;
   // If it didn't change, ignore it.
-  if (resource_state.resource != nullptr &&
-      result_.type->ResourcesEqual(resource_state.resource.get(),
+  if (resource_state->resource != nullptr &&
+      result_.type->ResourcesEqual(resource_state->resource.get(),
                                    result->resource->get())) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
       gpr_log(GPR_INFO,
               "[xds_client %p] %s resource %s identical to current, ignoring.",
               xds_client(), result_.type_url.c_str(), result->name.c_str());
     }
+    // With Delta xDS, keep the version current, so that it is what we
+    // report when we resubscribe on a new stream.  State-of-the-world
+    // resources keep the version at which they last changed.
+    if (delta()) resource_state->meta.version = version;
     return;
   }
   // Update the resource state.
-  resource_state.resource = std::move(*result->resource);
-  resource_state.meta = CreateResourceMetadataAcked(
-      std::string(serialized_resource), result_.version, update_time_);
+  xds_client()->RemoveFromResourceHashIndexLocked(result_.type,
+                                                  *resource_state);
+  resource_state->resource = std::move(*result->resource);
+  resource_state->meta = CreateResourceMetadataAcked(
+      std::string(serialized_resource), version, update_time_);
+  resource_state->serialized_proto_hash = hash;
+  xds_client()->resource_hash_index_[result_.type][hash] =
+      std::move(*parsed_name);
   // Notify watchers.
-  auto& watchers_list = resource_state.watchers;
+  auto& watchers_list = resource_state->watchers;
   auto* value =
-      result_.type->CopyResource(resource_state.resource.get()).release();
+      result_.type->CopyResource(resource_state->resource.get()).release();
   xds_client()->work_serializer_.Schedule(
       [watchers_list, value]()
           ABSL_EXCLUSIVE_LOCKS_REQUIRED(&xds_client()->work_serializer_) {
@@ -919,6 +1059,39 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
       DEBUG_LOCATION);
 }
 
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::RemoveResource(
+    size_t idx, absl::string_view resource_name) {
+  auto parsed_name = xds_client()->ParseXdsResourceName(
+      std::string(resource_name), result_.type);
+  if (!parsed_name.ok()) {
+    result_.errors.emplace_back(
+        absl::StrCat("removed resource index ", idx,
+                     ": Cannot parse xDS resource name \"", resource_name,
+                     "\""));
+    return;
+  }
+  MaybeCancelResourceTimer(*parsed_name);
+  ResourceState* resource_state = FindResourceState(*parsed_name);
+  if (resource_state == nullptr) return;
+  if (resource_state->resource == nullptr &&
+      resource_state->meta.client_status ==
+          XdsApi::ResourceMetadata::DOES_NOT_EXIST) {
+    return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+    gpr_log(GPR_INFO, "[xds_client %p] %s resource %s removed by server",
+            xds_client(), result_.type_url.c_str(),
+            std::string(resource_name).c_str());
+  }
+  xds_client()->RemoveFromResourceHashIndexLocked(result_.type,
+                                                  *resource_state);
+  resource_state->resource.reset();
+  resource_state->meta = XdsApi::ResourceMetadata();
+  resource_state->meta.client_status =
+      XdsApi::ResourceMetadata::DOES_NOT_EXIST;
+  xds_client()->NotifyWatchersOnResourceDoesNotExist(resource_state->watchers);
+}
+
 //
 // XdsClient::ChannelState::AdsCallState
 //
@@ -936,7 +1109,10 @@ XdsClient::ChannelState::AdsCallState::AdsCallState(
   GPR_ASSERT(xds_client() != nullptr);
   // Create a call with the specified method name.
   const char* method =
-      chand()->server_.ShouldUseV3()
+      chand()->server_.ShouldUseDelta()
+          ? "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
+            "DeltaAggregatedResources"
+      : chand()->server_.ShouldUseV3()
           ? "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
             "StreamAggregatedResources"
           : "/envoy.service.discovery.v2.AggregatedDiscoveryService/"
@@ -1061,12 +1237,19 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
   }
   auto& state = state_map_[type];
   grpc_slice request_payload_slice;
-  request_payload_slice = xds_client()->api_.CreateAdsRequest(
-      chand()->server_,
-      chand()->server_.ShouldUseV3() ? type->type_url() : type->v2_type_url(),
-      chand()->resource_type_version_map_[type], state.nonce,
-      ResourceNamesForRequest(type), GRPC_ERROR_REF(state.error),
-      !sent_initial_message_);
+  const bool delta = chand()->server_.ShouldUseDelta();
+  if (delta) {
+    if (!CreateDeltaRequestLocked(type, &state, &request_payload_slice)) {
+      return;
+    }
+  } else {
+    request_payload_slice = xds_client()->api_.CreateAdsRequest(
+        chand()->server_,
+        chand()->server_.ShouldUseV3() ? type->type_url() : type->v2_type_url(),
+        chand()->resource_type_version_map_[type], state.nonce,
+        ResourceNamesForRequest(type), GRPC_ERROR_REF(state.error),
+        !sent_initial_message_);
+  }
   sent_initial_message_ = true;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
     gpr_log(GPR_INFO,
@@ -1079,6 +1262,8 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
   }
   GRPC_ERROR_UNREF(state.error);
   state.error = GRPC_ERROR_NONE;
+  // With Delta xDS, the nonce is only sent to ACK or NACK a response.
+  if (delta) state.nonce.clear();
   // Create message payload.
   send_message_payload_ =
       grpc_raw_byte_buffer_create(&request_payload_slice, 1);
@@ -1103,6 +1288,59 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
   }
 }
 
+bool XdsClient::ChannelState::AdsCallState::CreateDeltaRequestLocked(
+    const XdsResourceType* type, ResourceTypeState* state,
+    grpc_slice* request_payload_slice) {
+  std::vector<std::string> resource_names = ResourceNamesForRequest(type);
+  std::set<std::string> current_names(resource_names.begin(),
+                                      resource_names.end());
+  std::vector<std::string> subscribe;
+  std::set_difference(current_names.begin(), current_names.end(),
+                      state->delta_subscribed_names.begin(),
+                      state->delta_subscribed_names.end(),
+                      std::back_inserter(subscribe));
+  std::vector<std::string> unsubscribe;
+  std::set_difference(state->delta_subscribed_names.begin(),
+                      state->delta_subscribed_names.end(),
+                      current_names.begin(), current_names.end(),
+                      std::back_inserter(unsubscribe));
+  // If there is nothing to tell the server, don't send anything.  This
+  // also keeps us from sending an empty first request, which the server
+  // would take as a wildcard subscription.
+  if (subscribe.empty() && unsubscribe.empty() && state->nonce.empty() &&
+      state->error == GRPC_ERROR_NONE) {
+    return false;
+  }
+  // In the first request on the stream, tell the server which versions
+  // we already have, so that it does not need to resend them.
+  std::map<std::string, std::string> initial_resource_versions;
+  if (!state->delta_request_sent) {
+    for (const auto& a : state->subscribed_resources) {
+      const std::string& authority = a.first;
+      auto authority_it = xds_client()->authority_state_map_.find(authority);
+      if (authority_it == xds_client()->authority_state_map_.end()) continue;
+      auto type_it = authority_it->second.resource_map.find(type);
+      if (type_it == authority_it->second.resource_map.end()) continue;
+      for (const auto& p : a.second) {
+        auto it = type_it->second.find(p.first);
+        if (it == type_it->second.end() || it->second.resource == nullptr ||
+            it->second.meta.version.empty()) {
+          continue;
+        }
+        initial_resource_versions[XdsClient::ConstructFullXdsResourceName(
+            authority, type->type_url(), p.first)] = it->second.meta.version;
+      }
+    }
+  }
+  *request_payload_slice = xds_client()->api_.CreateDeltaAdsRequest(
+      chand()->server_, type->type_url(), state->nonce, subscribe, unsubscribe,
+      initial_resource_versions, GRPC_ERROR_REF(state->error),
+      !sent_initial_message_);
+  state->delta_subscribed_names = std::move(current_names);
+  state->delta_request_sent = true;
+  return true;
+}
+
 void XdsClient::ChannelState::AdsCallState::SubscribeLocked(
     const XdsResourceType* type, const XdsResourceName& name, bool delay_send) {
   auto& state = state_map_[type].subscribed_resources[name.authority][name.key];
@@ -1156,10 +1394,13 @@ void XdsClient::ChannelState::AdsCallState::OnRequestSentLocked(
     // order of resource types. We need to fix this if we are seeing some
     // resource type(s) starved due to frequent requests of other resource
     // type(s).
-    auto it = buffered_requests_.begin();
-    if (it != buffered_requests_.end()) {
-      SendMessageLocked(*it);
+    // With Delta xDS, a buffered request may turn out to have nothing
+    // to send, in which case we move on to the next one.
+    while (send_message_payload_ == nullptr && !buffered_requests_.empty()) {
+      auto it = buffered_requests_.begin();
+      const XdsResourceType* type = *it;
       buffered_requests_.erase(it);
+      SendMessageLocked(type);
     }
   }
   GRPC_ERROR_UNREF(error);
@@ -1191,8 +1432,12 @@ bool XdsClient::ChannelState::AdsCallState::OnResponseReceivedLocked() {
   recv_message_payload_ = nullptr;
   // Parse and validate the response.
   AdsResponseParser parser(this);
-  absl::Status status = xds_client()->api_.ParseAdsResponse(
-      chand()->server_, response_slice, &parser);
+  absl::Status status =
+      chand()->server_.ShouldUseDelta()
+          ? xds_client()->api_.ParseDeltaAdsResponse(chand()->server_,
+                                                     response_slice, &parser)
+          : xds_client()->api_.ParseAdsResponse(chand()->server_,
+                                                response_slice, &parser);
   grpc_slice_unref_internal(response_slice);
   if (!status.ok()) {
     // Ignore unparsable response.
@@ -1222,8 +1467,10 @@ bool XdsClient::ChannelState::AdsCallState::OnResponseReceivedLocked() {
                                        GRPC_ERROR_INT_GRPC_STATUS,
                                        GRPC_STATUS_UNAVAILABLE);
     }
-    // Delete resources not seen in update if needed.
-    if (result.type->AllResourcesRequiredInSotW()) {
+    // Delete resources not seen in update if needed.  With Delta xDS,
+    // the server tells us about deletions explicitly instead.
+    if (!chand()->server_.ShouldUseDelta() &&
+        result.type->AllResourcesRequiredInSotW()) {
       for (auto& a : xds_client()->authority_state_map_) {
         const std::string& authority = a.first;
         AuthorityState& authority_state = a.second;
@@ -1248,6 +1495,8 @@ bool XdsClient::ChannelState::AdsCallState::OnResponseReceivedLocked() {
             // does not exist.  For that case, we rely on the request timeout
             // instead.
             if (resource_state.resource == nullptr) continue;
+            xds_client()->RemoveFromResourceHashIndexLocked(result.type,
+                                                            resource_state);
             resource_state.resource.reset();
             xds_client()->NotifyWatchersOnResourceDoesNotExist(
                 resource_state.watchers);
@@ -1990,6 +2239,7 @@ void XdsClient::CancelResourceWatch(const XdsResourceType* type,
   if (resource_state.watchers.empty()) {
     authority_state.channel_state->UnsubscribeLocked(type, *resource_name,
                                                      delay_unsubscription);
+    RemoveFromResourceHashIndexLocked(type, resource_state);
     type_map.erase(resource_it);
     if (type_map.empty()) {
       authority_state.resource_map.erase(type_it);
@@ -2256,6 +2506,15 @@ void XdsClient::NotifyWatchersOnResourceDoesNotExist(
       DEBUG_LOCATION);
 }
 
+void XdsClient::RemoveFromResourceHashIndexLocked(
+    const XdsResourceType* type, const ResourceState& resource_state) {
+  if (resource_state.resource == nullptr) return;
+  auto index_it = resource_hash_index_.find(type);
+  if (index_it == resource_hash_index_.end()) return;
+  index_it->second.erase(resource_state.serialized_proto_hash);
+  if (index_it->second.empty()) resource_hash_index_.erase(index_it);
+}
+
 XdsApi::ClusterLoadReportMap XdsClient::BuildLoadReportSnapshotLocked(
     const XdsBootstrap::XdsServer& xds_server, bool send_all_clusters,
     const std::set<std::string>& clusters) {
@@ -27,6 +27,7 @@
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
@@ -247,6 +248,8 @@ class XdsClient : public DualRefCounted<XdsClient> {
     // The latest data seen for the resource.
     std::unique_ptr<XdsResourceType::ResourceData> resource;
     XdsApi::ResourceMetadata meta;
+    // Hash of meta.serialized_proto.
+    size_t serialized_proto_hash = 0;
   };
 
   struct AuthorityState {
@@ -292,6 +295,11 @@ class XdsClient : public DualRefCounted<XdsClient> {
       const std::map<ResourceWatcherInterface*,
                      RefCountedPtr<ResourceWatcherInterface>>& watchers);
 
+  // Drops the resource from resource_hash_index_.
+  void RemoveFromResourceHashIndexLocked(const XdsResourceType* type,
+                                         const ResourceState& resource_state)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   void MaybeRegisterResourceTypeLocked(const XdsResourceType* resource_type)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
@@ -337,6 +345,15 @@ class XdsClient : public DualRefCounted<XdsClient> {
   std::map<std::string /*authority*/, AuthorityState> authority_state_map_
       ABSL_GUARDED_BY(mu_);
 
+  // Maps a hash of the serialized form of each cached resource to the
+  // resource's name, so that a resource that the server sends again
+  // unchanged can be recognized without decoding it.  Entries may refer to
+  // resources that changed since, so a hit must be checked against the
+  // cached bytes.
+  std::map<const XdsResourceType*,
+           absl::flat_hash_map<size_t /*hash*/, XdsResourceName>>
+      resource_hash_index_ ABSL_GUARDED_BY(mu_);
+
   std::map<XdsBootstrap::XdsServer, LoadReportServer>
       xds_load_report_server_map_ ABSL_GUARDED_BY(mu_);
 
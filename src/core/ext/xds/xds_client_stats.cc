@@ -20,6 +20,11 @@
 
 #include "src/core/ext/xds/xds_client_stats.h"
 
+#include <set>
+#include <tuple>
+
+#include "absl/strings/string_view.h"
+
 #include <grpc/support/log.h>
 
 #include "src/core/ext/xds/xds_client.h"
@@ -34,8 +39,79 @@ uint64_t GetAndResetCounter(std::atomic<uint64_t>* from) {
   return from->exchange(0, std::memory_order_relaxed);
 }
 
+// The parts of a locality name, used to look up an interned name without
+// building a new one.
+using LocalityNameKey =
+    std::tuple<absl::string_view, absl::string_view, absl::string_view>;
+
+LocalityNameKey MakeKey(const XdsLocalityName* name) {
+  return LocalityNameKey(name->region(), name->zone(), name->sub_zone());
+}
+
+struct LocalityNameLess {
+  using is_transparent = void;
+
+  bool operator()(const XdsLocalityName* lhs,
+                  const XdsLocalityName* rhs) const {
+    return lhs->Compare(*rhs) < 0;
+  }
+  bool operator()(const XdsLocalityName* lhs,
+                  const LocalityNameKey& rhs) const {
+    return MakeKey(lhs) < rhs;
+  }
+  bool operator()(const LocalityNameKey& lhs,
+                  const XdsLocalityName* rhs) const {
+    return lhs < MakeKey(rhs);
+  }
+};
+
+// Interned locality names.  The set does not hold refs: each interned
+// name removes itself when it is destroyed.
+struct LocalityNameTable {
+  Mutex mu;
+  std::set<XdsLocalityName*, LocalityNameLess> names ABSL_GUARDED_BY(mu);
+};
+
+LocalityNameTable* GetLocalityNameTable() {
+  static LocalityNameTable* table = new LocalityNameTable();
+  return table;
+}
+
 }  // namespace
 
+//
+// XdsLocalityName
+//
+
+XdsLocalityName::~XdsLocalityName() {
+  if (!interned_) return;
+  LocalityNameTable* table = GetLocalityNameTable();
+  MutexLock lock(&table->mu);
+  auto it = table->names.find(this);
+  // The entry may already have been replaced by a new name, if this one
+  // was looked up after its last ref went away.
+  if (it != table->names.end() && *it == this) table->names.erase(it);
+}
+
+RefCountedPtr<XdsLocalityName> XdsLocalityName::Intern(std::string region,
+                                                       std::string zone,
+                                                       std::string sub_zone) {
+  LocalityNameTable* table = GetLocalityNameTable();
+  MutexLock lock(&table->mu);
+  auto it = table->names.find(LocalityNameKey(region, zone, sub_zone));
+  if (it != table->names.end()) {
+    RefCountedPtr<XdsLocalityName> existing = (*it)->RefIfNonZero();
+    if (existing != nullptr) return existing;
+    // The existing name is being destroyed, so replace it.
+    table->names.erase(it);
+  }
+  auto name = MakeRefCounted<XdsLocalityName>(
+      std::move(region), std::move(zone), std::move(sub_zone));
+  name->interned_ = true;
+  table->names.insert(name.get());
+  return name;
+}
+
 //
 // XdsClusterDropStats
 //
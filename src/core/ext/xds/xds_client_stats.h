@@ -61,7 +61,19 @@ class XdsLocalityName : public RefCounted<XdsLocalityName> {
   XdsLocalityName(std::string region, std::string zone, std::string sub_zone)
       : region_(std::move(region)),
         zone_(std::move(zone)),
-        sub_zone_(std::move(sub_zone)) {}
+        sub_zone_(std::move(sub_zone)),
+        human_readable_string_(
+            absl::StrFormat("{region=\"%s\", zone=\"%s\", sub_zone=\"%s\"}",
+                            region_, zone_, sub_zone_)) {}
+
+  ~XdsLocalityName() override;
+
+  // Returns a name with the given parts that is shared by everyone who
+  // asks for the same name while it is alive, so that the many copies of
+  // a large EDS resource don't each hold their own copy of every name.
+  static RefCountedPtr<XdsLocalityName> Intern(std::string region,
+                                               std::string zone,
+                                               std::string sub_zone);
 
   bool operator==(const XdsLocalityName& other) const {
     return region_ == other.region_ && zone_ == other.zone_ &&
@@ -84,20 +96,17 @@ class XdsLocalityName : public RefCounted<XdsLocalityName> {
   const std::string& zone() const { return zone_; }
   const std::string& sub_zone() const { return sub_zone_; }
 
-  const std::string& AsHumanReadableString() {
-    if (human_readable_string_.empty()) {
-      human_readable_string_ =
-          absl::StrFormat("{region=\"%s\", zone=\"%s\", sub_zone=\"%s\"}",
-                          region_, zone_, sub_zone_);
-    }
+  const std::string& AsHumanReadableString() const {
     return human_readable_string_;
   }
 
  private:
-  std::string region_;
-  std::string zone_;
-  std::string sub_zone_;
-  std::string human_readable_string_;
+  const std::string region_;
+  const std::string zone_;
+  const std::string sub_zone_;
+  // Computed up front, since interned names are shared across threads.
+  const std::string human_readable_string_;
+  bool interned_ = false;
 };
 
 // Drop stats for an xds cluster.
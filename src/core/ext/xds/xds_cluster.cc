@@ -46,17 +46,30 @@
 #include "upb/text_encode.h"
 #include "upb/upb.h"
 
+#include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/filters/client_channel/lb_policy/maglev/maglev_table.h"
 #include "src/core/ext/xds/xds_common_types.h"
 #include "src/core/ext/xds/xds_resource_type.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/env.h"
+#include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/host_port.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/error.h"
 
 namespace grpc_core {
 
+// TODO(roth): Remove once maglev is no longer experimental
+bool XdsMaglevEnabled() {
+  char* value = gpr_getenv("GRPC_EXPERIMENTAL_XDS_MAGLEV_LB");
+  bool parsed_value;
+  bool parse_succeeded = gpr_parse_bool_value(value, &parsed_value);
+  gpr_free(value);
+  return parse_succeeded && parsed_value;
+}
+
 //
 // XdsClusterResource
 //
@@ -93,6 +106,8 @@ std::string XdsClusterResource::ToString() const {
   if (lb_policy == "RING_HASH") {
     contents.push_back(absl::StrCat("min_ring_size=", min_ring_size));
     contents.push_back(absl::StrCat("max_ring_size=", max_ring_size));
+  } else if (lb_policy == "MAGLEV") {
+    contents.push_back(absl::StrCat("maglev_table_size=", maglev_table_size));
   }
   contents.push_back(
       absl::StrFormat("max_concurrent_requests=%d", max_concurrent_requests));
@@ -345,6 +360,26 @@ grpc_error_handle CdsResourceParse(
             "ring hash lb config has invalid hash function."));
       }
     }
+  } else if (XdsMaglevEnabled() &&
+             envoy_config_cluster_v3_Cluster_lb_policy(cluster) ==
+                 envoy_config_cluster_v3_Cluster_MAGLEV) {
+    cds_update->lb_policy = "MAGLEV";
+    auto* maglev_config =
+        envoy_config_cluster_v3_Cluster_maglev_lb_config(cluster);
+    if (maglev_config != nullptr) {
+      const google_protobuf_UInt64Value* table_size =
+          envoy_config_cluster_v3_Cluster_MaglevLbConfig_table_size(
+              maglev_config);
+      if (table_size != nullptr) {
+        cds_update->maglev_table_size =
+            google_protobuf_UInt64Value_value(table_size);
+        if (!MaglevTable::IsValidTableSize(cds_update->maglev_table_size)) {
+          errors.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "maglev table_size is not a prime number no larger than "
+              "5000011."));
+        }
+      }
+    }
   } else {
     errors.push_back(
         GRPC_ERROR_CREATE_FROM_STATIC_STRING("LB policy is not supported."));
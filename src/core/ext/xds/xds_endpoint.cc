@@ -18,7 +18,7 @@
 
 #include "src/core/ext/xds/xds_endpoint.h"
 
-#include <stdlib.h>
+#include <string.h>
 
 #include <algorithm>
 #include <type_traits>
@@ -43,24 +43,62 @@
 #include "src/core/ext/xds/upb_utils.h"
 #include "src/core/ext/xds/xds_resource_type.h"
 #include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/fast_random.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/resolved_address.h"
 
 namespace grpc_core {
 
+//
+// XdsEndpointResource::Priority::Locality::EndpointList
+//
+
+// Each endpoint is packed as the length of its address (one byte), its
+// weight (four bytes), and then the address itself.
+static_assert(GRPC_MAX_SOCKADDR_SIZE <= UINT8_MAX,
+              "address length does not fit in one byte");
+
+void XdsEndpointResource::Priority::Locality::EndpointList::Add(
+    const grpc_resolved_address& address, uint32_t weight) {
+  const size_t offset = buffer_.size();
+  buffer_.resize(offset + 1 + sizeof(weight) + address.len);
+  buffer_[offset] = static_cast<uint8_t>(address.len);
+  memcpy(&buffer_[offset + 1], &weight, sizeof(weight));
+  memcpy(&buffer_[offset + 1 + sizeof(weight)], address.addr, address.len);
+  ++size_;
+}
+
+size_t XdsEndpointResource::Priority::Locality::EndpointList::Unpack(
+    size_t offset, Endpoint* endpoint) const {
+  endpoint->address.len = buffer_[offset];
+  memcpy(&endpoint->weight, &buffer_[offset + 1], sizeof(endpoint->weight));
+  memcpy(endpoint->address.addr, &buffer_[offset + 1 + sizeof(uint32_t)],
+         endpoint->address.len);
+  return offset + 1 + sizeof(uint32_t) + endpoint->address.len;
+}
+
+std::string XdsEndpointResource::Priority::Locality::EndpointList::ToString()
+    const {
+  std::vector<std::string> endpoint_strings;
+  ForEach([&](const Endpoint& endpoint) {
+    auto address = grpc_sockaddr_to_string(&endpoint.address, false);
+    endpoint_strings.emplace_back(absl::StrCat(
+        address.ok() ? *address : address.status().ToString(),
+        " weight=", endpoint.weight));
+  });
+  return absl::StrCat("[", absl::StrJoin(endpoint_strings, ", "), "]");
+}
+
 //
 // XdsEndpointResource
 //
 
 std::string XdsEndpointResource::Priority::Locality::ToString() const {
-  std::vector<std::string> endpoint_strings;
-  for (const ServerAddress& endpoint : endpoints) {
-    endpoint_strings.emplace_back(endpoint.ToString());
-  }
   return absl::StrCat("{name=", name->AsHumanReadableString(),
-                      ", lb_weight=", lb_weight, ", endpoints=[",
-                      absl::StrJoin(endpoint_strings, ", "), "]}");
+                      ", lb_weight=", lb_weight,
+                      ", endpoints=", endpoints.ToString(), "}");
 }
 
 bool XdsEndpointResource::Priority::operator==(const Priority& other) const {
@@ -89,7 +127,7 @@ bool XdsEndpointResource::DropConfig::ShouldDrop(
   for (size_t i = 0; i < drop_category_list_.size(); ++i) {
     const auto& drop_category = drop_category_list_[i];
     // Generate a random number in [0, 1000000).
-    const uint32_t random = static_cast<uint32_t>(rand()) % 1000000;
+    const uint32_t random = FastRandomUniform(1000000);
     if (random < drop_category.parts_per_million) {
       *category_name = &drop_category.name;
       return true;
@@ -110,8 +148,8 @@ std::string XdsEndpointResource::DropConfig::ToString() const {
 
 std::string XdsEndpointResource::ToString() const {
   std::vector<std::string> priority_strings;
-  for (size_t i = 0; i < priorities.size(); ++i) {
-    const Priority& priority = priorities[i];
+  for (size_t i = 0; i < priorities->size(); ++i) {
+    const Priority& priority = (*priorities)[i];
     priority_strings.emplace_back(
         absl::StrCat("priority ", i, ": ", priority.ToString()));
   }
@@ -140,9 +178,9 @@ void MaybeLogClusterLoadAssignment(
   }
 }
 
-grpc_error_handle ServerAddressParseAndAppend(
+grpc_error_handle EndpointParseAndAppend(
     const envoy_config_endpoint_v3_LbEndpoint* lb_endpoint,
-    ServerAddressList* list) {
+    XdsEndpointResource::Priority::Locality::EndpointList* list) {
   // If health_status is not HEALTHY or UNKNOWN, skip this endpoint.
   const int32_t health_status =
       envoy_config_endpoint_v3_LbEndpoint_health_status(lb_endpoint);
@@ -180,11 +218,7 @@ grpc_error_handle ServerAddressParseAndAppend(
       grpc_string_to_sockaddr(&addr, address_str.c_str(), port);
   if (error != GRPC_ERROR_NONE) return error;
   // Append the address to the list.
-  std::map<const char*, std::unique_ptr<ServerAddress::AttributeInterface>>
-      attributes;
-  attributes[ServerAddressWeightAttribute::kServerAddressWeightAttributeKey] =
-      absl::make_unique<ServerAddressWeightAttribute>(weight);
-  list->emplace_back(addr, nullptr, std::move(attributes));
+  list->Add(addr, weight);
   return GRPC_ERROR_NONE;
 }
 
@@ -215,7 +249,7 @@ grpc_error_handle LocalityParse(
       UpbStringToStdString(envoy_config_core_v3_Locality_zone(locality));
   std::string sub_zone =
       UpbStringToStdString(envoy_config_core_v3_Locality_sub_zone(locality));
-  output_locality->name = MakeRefCounted<XdsLocalityName>(
+  output_locality->name = XdsLocalityName::Intern(
       std::move(region), std::move(zone), std::move(sub_zone));
   // Parse the addresses.
   size_t size;
@@ -223,10 +257,11 @@ grpc_error_handle LocalityParse(
       envoy_config_endpoint_v3_LocalityLbEndpoints_lb_endpoints(
           locality_lb_endpoints, &size);
   for (size_t i = 0; i < size; ++i) {
-    grpc_error_handle error = ServerAddressParseAndAppend(
-        lb_endpoints[i], &output_locality->endpoints);
+    grpc_error_handle error =
+        EndpointParseAndAppend(lb_endpoints[i], &output_locality->endpoints);
     if (error != GRPC_ERROR_NONE) return error;
   }
+  output_locality->endpoints.ShrinkToFit();
   // Parse the priority.
   *priority = envoy_config_endpoint_v3_LocalityLbEndpoints_priority(
       locality_lb_endpoints);
@@ -278,6 +313,7 @@ grpc_error_handle EdsResourceParse(
         cluster_load_assignment,
     bool /*is_v2*/, XdsEndpointResource* eds_update) {
   std::vector<grpc_error_handle> errors;
+  auto priorities = std::make_shared<XdsEndpointResource::PriorityList>();
   // Get the endpoints.
   size_t locality_size;
   const envoy_config_endpoint_v3_LocalityLbEndpoints* const* endpoints =
@@ -295,10 +331,8 @@ grpc_error_handle EdsResourceParse(
     if (locality.lb_weight == 0) continue;
     // Make sure prorities is big enough. Note that they might not
     // arrive in priority order.
-    if (eds_update->priorities.size() < priority + 1) {
-      eds_update->priorities.resize(priority + 1);
-    }
-    auto& locality_map = eds_update->priorities[priority].localities;
+    if (priorities->size() < priority + 1) priorities->resize(priority + 1);
+    auto& locality_map = (*priorities)[priority].localities;
     auto it = locality_map.find(locality.name.get());
     if (it != locality_map.end()) {
       errors.push_back(GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrCat(
@@ -308,12 +342,13 @@ grpc_error_handle EdsResourceParse(
       locality_map.emplace(locality.name.get(), std::move(locality));
     }
   }
-  for (const auto& priority : eds_update->priorities) {
+  for (const auto& priority : *priorities) {
     if (priority.localities.empty()) {
       errors.push_back(
           GRPC_ERROR_CREATE_FROM_STATIC_STRING("sparse priority list"));
     }
   }
+  eds_update->priorities = std::move(priorities);
   // Get the drop config.
   eds_update->drop_config = MakeRefCounted<XdsEndpointResource::DropConfig>();
   const envoy_config_endpoint_v3_ClusterLoadAssignment_Policy* policy =
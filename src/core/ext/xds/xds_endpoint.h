@@ -25,6 +25,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/status/statusor.h"
@@ -37,16 +38,59 @@
 #include "src/core/ext/xds/xds_resource_type_impl.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
-#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/iomgr/resolved_address.h"
 
 namespace grpc_core {
 
 struct XdsEndpointResource {
   struct Priority {
     struct Locality {
+      // The endpoints of a locality, packed into a single buffer.  Each
+      // endpoint takes only the bytes of its socket address and its
+      // weight, rather than a ServerAddress with its own attribute map.
+      class EndpointList {
+       public:
+        struct Endpoint {
+          grpc_resolved_address address;
+          // Zero if not set.
+          uint32_t weight;
+        };
+
+        void Add(const grpc_resolved_address& address, uint32_t weight);
+        // Releases memory reserved for endpoints that were never added.
+        void ShrinkToFit() { buffer_.shrink_to_fit(); }
+
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        // Bytes used by the endpoints.
+        size_t memory_usage() const { return buffer_.capacity(); }
+
+        // Invokes f(const Endpoint&) for each endpoint, in order.
+        template <typename F>
+        void ForEach(F f) const {
+          Endpoint endpoint;
+          for (size_t offset = 0; offset < buffer_.size();) {
+            offset = Unpack(offset, &endpoint);
+            f(static_cast<const Endpoint&>(endpoint));
+          }
+        }
+
+        bool operator==(const EndpointList& other) const {
+          return buffer_ == other.buffer_;
+        }
+        std::string ToString() const;
+
+       private:
+        // Unpacks the endpoint at offset and returns the offset of the next.
+        size_t Unpack(size_t offset, Endpoint* endpoint) const;
+
+        std::vector<uint8_t> buffer_;
+        size_t size_ = 0;
+      };
+
       RefCountedPtr<XdsLocalityName> name;
       uint32_t lb_weight;
-      ServerAddressList endpoints;
+      EndpointList endpoints;
 
       bool operator==(const Locality& other) const {
         return *name == *other.name && lb_weight == other.lb_weight &&
@@ -109,11 +153,17 @@ struct XdsEndpointResource {
     bool drop_all_ = false;
   };
 
-  PriorityList priorities;
+  // Shared by all copies of the resource, from the one in the XdsClient's
+  // cache to the ones handed to each watcher, since it is not modified
+  // once the resource is decoded.
+  std::shared_ptr<const PriorityList> priorities =
+      std::make_shared<PriorityList>();
   RefCountedPtr<DropConfig> drop_config;
 
   bool operator==(const XdsEndpointResource& other) const {
-    return priorities == other.priorities && *drop_config == *other.drop_config;
+    return (priorities == other.priorities ||
+            *priorities == *other.priorities) &&
+           *drop_config == *other.drop_config;
   }
   std::string ToString() const;
 };
@@ -27,8 +27,10 @@
 #include <cctype>
 #include <utility>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 
@@ -175,6 +177,140 @@ absl::optional<size_t> XdsRouting::GetRouteForRequest(
   return absl::nullopt;
 }
 
+//
+// XdsRouting::RouteMatcher
+//
+
+XdsRouting::RouteMatcher::PathTrie::PathTrie() : nodes_(1) {}
+
+void XdsRouting::RouteMatcher::PathTrie::Insert(absl::string_view path,
+                                                bool is_prefix,
+                                                size_t route_index) {
+  size_t node = 0;
+  for (char c : path) {
+    auto it = nodes_[node].children.find(c);
+    if (it == nodes_[node].children.end()) {
+      // Do not hold a reference into nodes_ across the emplace_back().
+      nodes_.emplace_back();
+      it = nodes_[node].children.emplace(c, nodes_.size() - 1).first;
+    }
+    node = it->second;
+  }
+  if (is_prefix) {
+    nodes_[node].prefix_routes.push_back(route_index);
+  } else {
+    nodes_[node].exact_routes.push_back(route_index);
+  }
+}
+
+template <typename IndexList>
+void XdsRouting::RouteMatcher::PathTrie::Lookup(
+    absl::string_view path, bool ignore_case, IndexList* route_indexes) const {
+  const Node* node = &nodes_[0];
+  for (char c : path) {
+    route_indexes->insert(route_indexes->end(), node->prefix_routes.begin(),
+                          node->prefix_routes.end());
+    auto it = node->children.find(ignore_case ? absl::ascii_tolower(c) : c);
+    if (it == node->children.end()) return;
+    node = &nodes_[it->second];
+  }
+  route_indexes->insert(route_indexes->end(), node->prefix_routes.begin(),
+                        node->prefix_routes.end());
+  route_indexes->insert(route_indexes->end(), node->exact_routes.begin(),
+                        node->exact_routes.end());
+}
+
+XdsRouting::RouteMatcher::RouteMatcher(
+    const RouteListIterator& route_list_iterator) {
+  std::map<absl::string_view, size_t> header_name_indexes;
+  std::vector<StringMatcher> other_paths;
+  routes_.resize(route_list_iterator.Size());
+  for (size_t i = 0; i < routes_.size(); ++i) {
+    const XdsRouteConfigResource::Route::Matchers& matchers =
+        route_list_iterator.GetMatchersForRoute(i);
+    const StringMatcher& path_matcher = matchers.path_matcher;
+    switch (path_matcher.type()) {
+      case StringMatcher::Type::kExact:
+      case StringMatcher::Type::kPrefix: {
+        const bool is_prefix =
+            path_matcher.type() == StringMatcher::Type::kPrefix;
+        if (path_matcher.case_sensitive()) {
+          case_sensitive_paths_.Insert(path_matcher.string_matcher(),
+                                       is_prefix, i);
+        } else {
+          case_insensitive_paths_.Insert(
+              absl::AsciiStrToLower(path_matcher.string_matcher()), is_prefix,
+              i);
+        }
+        break;
+      }
+      default:
+        other_paths.push_back(path_matcher);
+        other_path_routes_.push_back(i);
+    }
+    Route& route = routes_[i];
+    for (const HeaderMatcher& header_matcher : matchers.header_matchers) {
+      auto it = header_name_indexes.find(header_matcher.name());
+      if (it == header_name_indexes.end()) {
+        header_names_.push_back(header_matcher.name());
+        it = header_name_indexes
+                 .emplace(header_matcher.name(), header_names_.size() - 1)
+                 .first;
+      }
+      route.header_matchers.emplace_back(it->second, header_matcher);
+    }
+    route.fraction_per_million = matchers.fraction_per_million;
+  }
+  other_paths_ = StringMatcherSet(std::move(other_paths));
+}
+
+absl::optional<size_t> XdsRouting::RouteMatcher::GetRouteForRequest(
+    absl::string_view path, grpc_metadata_batch* initial_metadata) const {
+  // Find the routes whose path matcher matches.
+  absl::InlinedVector<size_t, 8> candidates;
+  case_sensitive_paths_.Lookup(path, /*ignore_case=*/false, &candidates);
+  case_insensitive_paths_.Lookup(path, /*ignore_case=*/true, &candidates);
+  if (other_paths_.size() > 0) {
+    for (size_t index : other_paths_.Match(path)) {
+      candidates.push_back(other_path_routes_[index]);
+    }
+  }
+  // Check the rest of each candidate in route order, so that the first
+  // route that matches wins and fractions are drawn for the same routes
+  // as in a linear scan.
+  std::sort(candidates.begin(), candidates.end());
+  // Header values, read on first use.
+  struct HeaderValue {
+    bool fetched = false;
+    absl::optional<absl::string_view> value;
+    std::string concatenated_value;
+  };
+  std::vector<HeaderValue> header_values;
+  for (size_t i : candidates) {
+    const Route& route = routes_[i];
+    bool headers_match = true;
+    for (const auto& p : route.header_matchers) {
+      if (header_values.empty()) header_values.resize(header_names_.size());
+      HeaderValue& header_value = header_values[p.first];
+      if (!header_value.fetched) {
+        header_value.value =
+            GetHeaderValue(initial_metadata, header_names_[p.first],
+                           &header_value.concatenated_value);
+        header_value.fetched = true;
+      }
+      if (!p.second.Match(header_value.value)) {
+        headers_match = false;
+        break;
+      }
+    }
+    if (headers_match && (!route.fraction_per_million.has_value() ||
+                          UnderFraction(*route.fraction_per_million))) {
+      return i;
+    }
+  }
+  return absl::nullopt;
+}
+
 bool XdsRouting::IsValidDomainPattern(absl::string_view domain_pattern) {
   return DomainPatternMatchType(domain_pattern) != INVALID_MATCH;
 }
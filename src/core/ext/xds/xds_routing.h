@@ -25,6 +25,7 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/strings/string_view.h"
@@ -35,6 +36,7 @@
 #include "src/core/ext/xds/xds_listener.h"
 #include "src/core/ext/xds/xds_route_config.h"
 #include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/matchers/matchers.h"
 #include "src/core/lib/transport/metadata_batch.h"
 
 namespace grpc_core {
@@ -61,6 +63,66 @@ class XdsRouting {
         size_t index) const = 0;
   };
 
+  // A route list compiled at config-update time, so that a request does
+  // not have to be checked against every route in turn.  Exact and prefix
+  // path matchers are looked up in a trie, and the other path matchers,
+  // including regexes, are evaluated together as a StringMatcherSet.
+  // Header matchers, which are grouped by header name so that each header
+  // is read at most once, and fractions are then checked in route order
+  // for only the routes whose path matched.  The route selected is always
+  // the one that GetRouteForRequest() would select for the same list.
+  class RouteMatcher {
+   public:
+    RouteMatcher() = default;
+    explicit RouteMatcher(const RouteListIterator& route_list_iterator);
+
+    RouteMatcher(RouteMatcher&&) = default;
+    RouteMatcher& operator=(RouteMatcher&&) = default;
+
+    // Returns the index of the route to use for a request with the
+    // specified path and metadata, or nullopt if no route matches.
+    absl::optional<size_t> GetRouteForRequest(
+        absl::string_view path, grpc_metadata_batch* initial_metadata) const;
+
+   private:
+    // Exact and prefix path matchers, keyed by the path they match.
+    class PathTrie {
+     public:
+      PathTrie();
+
+      void Insert(absl::string_view path, bool is_prefix, size_t route_index);
+      // Appends the index of every route that matches path.  If
+      // ignore_case is true, the paths inserted must be in lower case.
+      template <typename IndexList>
+      void Lookup(absl::string_view path, bool ignore_case,
+                  IndexList* route_indexes) const;
+
+     private:
+      struct Node {
+        std::map<char, size_t> children;
+        std::vector<size_t> prefix_routes;
+        std::vector<size_t> exact_routes;
+      };
+
+      std::vector<Node> nodes_;  // nodes_[0] is the root.
+    };
+
+    struct Route {
+      // Pairs of index into header_names_ and matcher for that header.
+      std::vector<std::pair<size_t, HeaderMatcher>> header_matchers;
+      absl::optional<uint32_t> fraction_per_million;
+    };
+
+    std::vector<Route> routes_;
+    std::vector<std::string> header_names_;
+    PathTrie case_sensitive_paths_;
+    PathTrie case_insensitive_paths_;
+    // Path matchers other than exact and prefix, and the route index for
+    // each matcher in the set.
+    StringMatcherSet other_paths_;
+    std::vector<size_t> other_path_routes_;
+  };
+
   // Returns the index of the selected virtual host in the list.
   static absl::optional<size_t> FindVirtualHostForDomain(
       const VirtualHostListIterator& vhost_iterator, absl::string_view domain);
@@ -338,6 +338,7 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
 
     std::vector<std::string> domains;
     std::vector<Route> routes;
+    XdsRouting::RouteMatcher route_matcher;
   };
 
   class VirtualHostListIterator : public XdsRouting::VirtualHostListIterator {
@@ -1174,6 +1175,8 @@ XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
       }
       grpc_channel_args_destroy(result.args);
     }
+    virtual_host.route_matcher = XdsRouting::RouteMatcher(
+        VirtualHost::RouteListIterator(&virtual_host.routes));
   }
   return config_selector;
 }
@@ -1206,8 +1209,8 @@ ServerConfigSelector::CallConfig XdsServerConfigFetcher::ListenerWatcher::
     return call_config;
   }
   auto& virtual_host = virtual_hosts_[vhost_index.value()];
-  auto route_index = XdsRouting::GetRouteForRequest(
-      VirtualHost::RouteListIterator(&virtual_host.routes), path, metadata);
+  auto route_index =
+      virtual_host.route_matcher.GetRouteForRequest(path, metadata);
   if (route_index.has_value()) {
     auto& route = virtual_host.routes[route_index.value()];
     // Found the matching route
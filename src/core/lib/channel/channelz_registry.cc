@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <cstring>
 #include <utility>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 
@@ -40,7 +41,7 @@ namespace grpc_core {
 namespace channelz {
 namespace {
 
-const int kPaginationLimit = 100;
+const size_t kPaginationLimit = 100;
 
 }  // anonymous namespace
 
@@ -50,57 +51,74 @@ ChannelzRegistry* ChannelzRegistry::Default() {
 }
 
 void ChannelzRegistry::InternalRegister(BaseNode* node) {
-  MutexLock lock(&mu_);
-  node->uuid_ = ++uuid_generator_;
-  node_map_[node->uuid_] = node;
+  node->uuid_ = uuid_generator_.fetch_add(1, std::memory_order_relaxed) + 1;
+  Shard& shard = ShardForUuid(node->uuid_);
+  MutexLock lock(&shard.mu);
+  shard.node_map[node->uuid_] = node;
 }
 
 void ChannelzRegistry::InternalUnregister(intptr_t uuid) {
   GPR_ASSERT(uuid >= 1);
-  MutexLock lock(&mu_);
-  GPR_ASSERT(uuid <= uuid_generator_);
-  node_map_.erase(uuid);
+  GPR_ASSERT(uuid <= uuid_generator_.load(std::memory_order_relaxed));
+  Shard& shard = ShardForUuid(uuid);
+  MutexLock lock(&shard.mu);
+  shard.node_map.erase(uuid);
 }
 
 RefCountedPtr<BaseNode> ChannelzRegistry::InternalGet(intptr_t uuid) {
-  MutexLock lock(&mu_);
-  if (uuid < 1 || uuid > uuid_generator_) {
+  if (uuid < 1 || uuid > uuid_generator_.load(std::memory_order_relaxed)) {
     return nullptr;
   }
-  auto it = node_map_.find(uuid);
-  if (it == node_map_.end()) return nullptr;
+  Shard& shard = ShardForUuid(uuid);
+  MutexLock lock(&shard.mu);
+  auto it = shard.node_map.find(uuid);
+  if (it == shard.node_map.end()) return nullptr;
   // Found node.  Return only if its refcount is not zero (i.e., when we
   // know that there is no other thread about to destroy it).
   BaseNode* node = it->second;
   return node->RefIfNonZero();
 }
 
-std::string ChannelzRegistry::InternalGetTopChannels(
-    intptr_t start_channel_id) {
-  absl::InlinedVector<RefCountedPtr<BaseNode>, 10> top_level_channels;
-  RefCountedPtr<BaseNode> node_after_pagination_limit;
-  {
-    MutexLock lock(&mu_);
-    for (auto it = node_map_.lower_bound(start_channel_id);
-         it != node_map_.end(); ++it) {
+std::vector<RefCountedPtr<BaseNode>> ChannelzRegistry::InternalGetNodes(
+    BaseNode::EntityType type, intptr_t start_id, size_t max_nodes) {
+  std::vector<RefCountedPtr<BaseNode>> nodes;
+  // The first max_nodes nodes overall are among the first max_nodes nodes
+  // of each shard.
+  for (Shard& shard : shards_) {
+    MutexLock lock(&shard.mu);
+    size_t shard_nodes = 0;
+    for (auto it = shard.node_map.lower_bound(start_id);
+         it != shard.node_map.end() && shard_nodes < max_nodes; ++it) {
       BaseNode* node = it->second;
       RefCountedPtr<BaseNode> node_ref;
-      if (node->type() == BaseNode::EntityType::kTopLevelChannel &&
+      if (node->type() == type &&
           (node_ref = node->RefIfNonZero()) != nullptr) {
-        // Check if we are over pagination limit to determine if we need to set
-        // the "end" element. If we don't go through this block, we know that
-        // when the loop terminates, we have <= to kPaginationLimit.
-        // Note that because we have already increased this node's
-        // refcount, we need to decrease it, but we can't unref while
-        // holding the lock, because this may lead to a deadlock.
-        if (top_level_channels.size() == kPaginationLimit) {
-          node_after_pagination_limit = std::move(node_ref);
-          break;
-        }
-        top_level_channels.emplace_back(std::move(node_ref));
+        nodes.emplace_back(std::move(node_ref));
+        ++shard_nodes;
       }
     }
   }
+  // The refs are only dropped here, after the shard locks are released,
+  // because dropping the last ref unregisters the node, which may deadlock
+  // while holding the lock of its shard.
+  std::sort(nodes.begin(), nodes.end(),
+            [](const RefCountedPtr<BaseNode>& a,
+               const RefCountedPtr<BaseNode>& b) {
+              return a->uuid() < b->uuid();
+            });
+  if (nodes.size() > max_nodes) nodes.resize(max_nodes);
+  return nodes;
+}
+
+std::string ChannelzRegistry::InternalGetTopChannels(
+    intptr_t start_channel_id) {
+  // Fetch one node past the pagination limit to determine if we need to set
+  // the "end" element.
+  std::vector<RefCountedPtr<BaseNode>> top_level_channels =
+      InternalGetNodes(BaseNode::EntityType::kTopLevelChannel,
+                       start_channel_id, kPaginationLimit + 1);
+  const bool end = top_level_channels.size() <= kPaginationLimit;
+  if (!end) top_level_channels.pop_back();
   Json::Object object;
   if (!top_level_channels.empty()) {
     // Create list of channels.
@@ -110,36 +128,18 @@ std::string ChannelzRegistry::InternalGetTopChannels(
     }
     object["channel"] = std::move(array);
   }
-  if (node_after_pagination_limit == nullptr) object["end"] = true;
+  if (end) object["end"] = true;
   Json json(std::move(object));
   return json.Dump();
 }
 
 std::string ChannelzRegistry::InternalGetServers(intptr_t start_server_id) {
-  absl::InlinedVector<RefCountedPtr<BaseNode>, 10> servers;
-  RefCountedPtr<BaseNode> node_after_pagination_limit;
-  {
-    MutexLock lock(&mu_);
-    for (auto it = node_map_.lower_bound(start_server_id);
-         it != node_map_.end(); ++it) {
-      BaseNode* node = it->second;
-      RefCountedPtr<BaseNode> node_ref;
-      if (node->type() == BaseNode::EntityType::kServer &&
-          (node_ref = node->RefIfNonZero()) != nullptr) {
-        // Check if we are over pagination limit to determine if we need to set
-        // the "end" element. If we don't go through this block, we know that
-        // when the loop terminates, we have <= to kPaginationLimit.
-        // Note that because we have already increased this node's
-        // refcount, we need to decrease it, but we can't unref while
-        // holding the lock, because this may lead to a deadlock.
-        if (servers.size() == kPaginationLimit) {
-          node_after_pagination_limit = std::move(node_ref);
-          break;
-        }
-        servers.emplace_back(std::move(node_ref));
-      }
-    }
-  }
+  // Fetch one node past the pagination limit to determine if we need to set
+  // the "end" element.
+  std::vector<RefCountedPtr<BaseNode>> servers = InternalGetNodes(
+      BaseNode::EntityType::kServer, start_server_id, kPaginationLimit + 1);
+  const bool end = servers.size() <= kPaginationLimit;
+  if (!end) servers.pop_back();
   Json::Object object;
   if (!servers.empty()) {
     // Create list of servers.
@@ -149,22 +149,27 @@ std::string ChannelzRegistry::InternalGetServers(intptr_t start_server_id) {
     }
     object["server"] = std::move(array);
   }
-  if (node_after_pagination_limit == nullptr) object["end"] = true;
+  if (end) object["end"] = true;
   Json json(std::move(object));
   return json.Dump();
 }
 
 void ChannelzRegistry::InternalLogAllEntities() {
   absl::InlinedVector<RefCountedPtr<BaseNode>, 10> nodes;
-  {
-    MutexLock lock(&mu_);
-    for (auto& p : node_map_) {
+  for (Shard& shard : shards_) {
+    MutexLock lock(&shard.mu);
+    for (auto& p : shard.node_map) {
       RefCountedPtr<BaseNode> node = p.second->RefIfNonZero();
       if (node != nullptr) {
         nodes.emplace_back(std::move(node));
       }
     }
   }
+  std::sort(nodes.begin(), nodes.end(),
+            [](const RefCountedPtr<BaseNode>& a,
+               const RefCountedPtr<BaseNode>& b) {
+              return a->uuid() < b->uuid();
+            });
   for (size_t i = 0; i < nodes.size(); ++i) {
     std::string json = nodes[i]->RenderJsonString();
     gpr_log(GPR_INFO, "%s", json.c_str());
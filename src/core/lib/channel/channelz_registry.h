@@ -21,9 +21,11 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -34,6 +36,9 @@ namespace channelz {
 
 // singleton registry object to track all objects that are needed to support
 // channelz bookkeeping. All objects share globally distributed uuids.
+// Uuids are allocated without locking, and nodes are sharded by uuid so that
+// registering and unregistering nodes on many threads at once, as servers
+// that accept many connections do, does not contend on a single lock.
 class ChannelzRegistry {
  public:
   static void Register(BaseNode* node) {
@@ -63,9 +68,11 @@ class ChannelzRegistry {
   // Test only helper function to reset to initial state.
   static void TestOnlyReset() {
     auto* p = Default();
-    MutexLock lock(&p->mu_);
-    p->node_map_.clear();
-    p->uuid_generator_ = 0;
+    for (Shard& shard : p->shards_) {
+      MutexLock lock(&shard.mu);
+      shard.node_map.clear();
+    }
+    p->uuid_generator_.store(0, std::memory_order_relaxed);
   }
 
  private:
@@ -86,12 +93,25 @@ class ChannelzRegistry {
   std::string InternalGetTopChannels(intptr_t start_channel_id);
   std::string InternalGetServers(intptr_t start_server_id);
 
+  // Returns refs to up to max_nodes nodes of the given type whose uuid is at
+  // least start_id, in order of uuid.
+  std::vector<RefCountedPtr<BaseNode>> InternalGetNodes(
+      BaseNode::EntityType type, intptr_t start_id, size_t max_nodes);
+
   void InternalLogAllEntities();
 
-  // protects members
-  Mutex mu_;
-  std::map<intptr_t, BaseNode*> node_map_;
-  intptr_t uuid_generator_ = 0;
+  static constexpr size_t kNumShards = 16;
+
+  struct Shard {
+    // protects node_map
+    Mutex mu;
+    std::map<intptr_t, BaseNode*> node_map ABSL_GUARDED_BY(mu);
+  };
+
+  Shard& ShardForUuid(intptr_t uuid) { return shards_[uuid % kNumShards]; }
+
+  std::atomic<intptr_t> uuid_generator_{0};
+  Shard shards_[kNumShards];
 };
 
 }  // namespace channelz
@@ -23,6 +23,9 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include <algorithm>
+#include <map>
+#include <set>
 #include <vector>
 
 #include "absl/strings/str_format.h"
@@ -33,17 +36,31 @@
 
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/combiner.h"
 
 grpc_stats_data* grpc_stats_per_cpu_storage = nullptr;
 static size_t g_num_cores;
 
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+static void record_combiner_wait(double wait_us) {
+  GRPC_STATS_INC_COMBINER_WAIT_US(wait_us);
+}
+#endif
+
 void grpc_stats_init(void) {
   g_num_cores = std::max(1u, gpr_cpu_num_cores());
   grpc_stats_per_cpu_storage = static_cast<grpc_stats_data*>(
       gpr_zalloc(sizeof(grpc_stats_data) * g_num_cores));
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_combiner_set_wait_observer(record_combiner_wait);
+#endif
 }
 
-void grpc_stats_shutdown(void) { gpr_free(grpc_stats_per_cpu_storage); }
+void grpc_stats_shutdown(void) {
+  grpc_combiner_set_wait_observer(nullptr);
+  gpr_free(grpc_stats_per_cpu_storage);
+}
 
 void grpc_stats_collect(grpc_stats_data* output) {
   memset(output, 0, sizeof(*output));
@@ -59,6 +76,86 @@ void grpc_stats_collect(grpc_stats_data* output) {
   }
 }
 
+namespace {
+
+// Every live MethodLatencyStats, for CollectMethodLatency().
+struct MethodLatencyRegistry {
+  grpc_core::Mutex mu;
+  std::set<const grpc_core::MethodLatencyStats*> stats ABSL_GUARDED_BY(mu);
+};
+
+MethodLatencyRegistry* GetMethodLatencyRegistry() {
+  static MethodLatencyRegistry* registry = new MethodLatencyRegistry();
+  return registry;
+}
+
+}  // namespace
+
+namespace grpc_core {
+
+MethodLatencyStats::MethodLatencyStats(std::string method)
+    : method_(std::move(method)),
+      per_cpu_buckets_(
+          new gpr_atm[g_num_cores *
+                      GRPC_STATS_HISTOGRAM_SERVER_CALL_LATENCY_US_BUCKETS]()) {
+  MethodLatencyRegistry* registry = GetMethodLatencyRegistry();
+  MutexLock lock(&registry->mu);
+  registry->stats.insert(this);
+}
+
+MethodLatencyStats::~MethodLatencyStats() {
+  MethodLatencyRegistry* registry = GetMethodLatencyRegistry();
+  MutexLock lock(&registry->mu);
+  registry->stats.erase(this);
+}
+
+void MethodLatencyStats::Record(double latency_us) {
+  const int* boundaries = grpc_stats_histo_bucket_boundaries
+      [GRPC_STATS_HISTOGRAM_SERVER_CALL_LATENCY_US];
+  const int num_buckets = GRPC_STATS_HISTOGRAM_SERVER_CALL_LATENCY_US_BUCKETS;
+  const int value = static_cast<int>(
+      Clamp(latency_us, 0.0, static_cast<double>(boundaries[num_buckets])));
+  const size_t bucket =
+      std::upper_bound(boundaries, boundaries + num_buckets, value) -
+      boundaries - 1;
+  gpr_atm_no_barrier_fetch_add(
+      &per_cpu_buckets_[ExecCtx::Get()->starting_cpu() * num_buckets + bucket],
+      1);
+}
+
+void MethodLatencyStats::Collect(gpr_atm* buckets) const {
+  for (size_t core = 0; core < g_num_cores; core++) {
+    for (size_t i = 0; i < GRPC_STATS_HISTOGRAM_SERVER_CALL_LATENCY_US_BUCKETS;
+         i++) {
+      buckets[i] += gpr_atm_no_barrier_load(
+          &per_cpu_buckets_
+              [core * GRPC_STATS_HISTOGRAM_SERVER_CALL_LATENCY_US_BUCKETS + i]);
+    }
+  }
+}
+
+std::vector<MethodLatency> CollectMethodLatency() {
+  std::map<std::string, MethodLatency> by_method;
+  {
+    MethodLatencyRegistry* registry = GetMethodLatencyRegistry();
+    MutexLock lock(&registry->mu);
+    for (const MethodLatencyStats* stats : registry->stats) {
+      auto it = by_method.find(stats->method());
+      if (it == by_method.end()) {
+        it = by_method.emplace(stats->method(), MethodLatency()).first;
+        it->second.method = stats->method();
+      }
+      stats->Collect(it->second.buckets);
+    }
+  }
+  std::vector<MethodLatency> result;
+  result.reserve(by_method.size());
+  for (auto& p : by_method) result.push_back(std::move(p.second));
+  return result;
+}
+
+}  // namespace grpc_core
+
 void grpc_stats_diff(const grpc_stats_data* b, const grpc_stats_data* a,
                      grpc_stats_data* c) {
   for (size_t i = 0; i < GRPC_STATS_COUNTER_COUNT; i++) {
@@ -21,11 +21,14 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <grpc/support/atm.h>
 
 #include "src/core/lib/debug/stats_data.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
 typedef struct grpc_stats_data {
@@ -53,6 +56,67 @@ extern grpc_stats_data* grpc_stats_per_cpu_storage;
 #define GRPC_STATS_INC_HISTOGRAM(histogram, index)
 #endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
 
+/* Returns the start of a stage timed for a latency histogram, to be passed to
+ * grpc_stats_micros_since(). Reads the clock only when stats are collected.
+ */
+inline gpr_cycle_counter grpc_stats_start_timer(void) {
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  return gpr_get_cycle_counter();
+#else
+  return 0;
+#endif
+}
+
+/* Returns the microseconds elapsed since start. */
+inline double grpc_stats_micros_since(gpr_cycle_counter start) {
+  return gpr_timespec_to_micros(
+      gpr_cycle_counter_sub(gpr_get_cycle_counter(), start));
+}
+
+namespace grpc_core {
+
+// The latency histogram of one server method.  Like grpc_stats_data it is
+// kept per CPU, and it has the buckets of the server_call_latency_us
+// histogram.  Unlike the process-wide stats, it is recorded in every build:
+// servers create one for each registered method only when
+// GRPC_ARG_SERVER_METHOD_LATENCY_STATS is set.
+class MethodLatencyStats {
+ public:
+  explicit MethodLatencyStats(std::string method);
+  ~MethodLatencyStats();
+
+  MethodLatencyStats(const MethodLatencyStats&) = delete;
+  MethodLatencyStats& operator=(const MethodLatencyStats&) = delete;
+
+  const std::string& method() const { return method_; }
+
+  // Records a call that took latency_us microseconds.  Must be called with
+  // an ExecCtx on the stack.
+  void Record(double latency_us);
+
+  // Adds the counts of all CPUs to buckets, which has
+  // GRPC_STATS_HISTOGRAM_SERVER_CALL_LATENCY_US_BUCKETS entries.
+  void Collect(gpr_atm* buckets) const;
+
+ private:
+  const std::string method_;
+  // GRPC_STATS_HISTOGRAM_SERVER_CALL_LATENCY_US_BUCKETS counts for each CPU.
+  std::unique_ptr<gpr_atm[]> per_cpu_buckets_;
+};
+
+// The latency histogram of a server method, merged over every live
+// MethodLatencyStats with that method name.
+struct MethodLatency {
+  std::string method;
+  gpr_atm buckets[GRPC_STATS_HISTOGRAM_SERVER_CALL_LATENCY_US_BUCKETS] = {};
+};
+
+// Collects the latency histograms of all methods of live servers that record
+// them, merging those of methods with the same name, sorted by method.
+std::vector<MethodLatency> CollectMethodLatency();
+
+}  // namespace grpc_core
+
 void grpc_stats_init(void);
 void grpc_stats_shutdown(void);
 void grpc_stats_collect(grpc_stats_data* output);
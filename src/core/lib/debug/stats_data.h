@@ -125,6 +125,9 @@ typedef enum {
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES,
+  GRPC_STATS_COUNTER_HANDSHAKE_OFFLOAD_SCHEDULED,
+  GRPC_STATS_COUNTER_HANDSHAKE_OFFLOAD_RESUMED_SCHEDULED,
+  GRPC_STATS_COUNTER_HANDSHAKE_OFFLOAD_REJECTED,
   GRPC_STATS_COUNTER_COUNT
 } grpc_stats_counters;
 extern const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT];
@@ -142,7 +145,12 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_FLUSH_DELAY_US,
+  GRPC_STATS_HISTOGRAM_COMBINER_WAIT_US,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
+  GRPC_STATS_HISTOGRAM_SERVER_QUEUE_WAIT_US,
+  GRPC_STATS_HISTOGRAM_SERVER_CALL_LATENCY_US,
+  GRPC_STATS_HISTOGRAM_HANDSHAKE_OFFLOAD_QUEUE_DELAY_US,
   GRPC_STATS_HISTOGRAM_COUNT
 } grpc_stats_histograms;
 extern const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT];
@@ -172,9 +180,19 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE_BUCKETS = 64,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_FIRST_SLOT = 768,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 832,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_FLUSH_DELAY_US_FIRST_SLOT = 832,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_FLUSH_DELAY_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_COMBINER_WAIT_US_FIRST_SLOT = 896,
+  GRPC_STATS_HISTOGRAM_COMBINER_WAIT_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 960,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_BUCKETS = 8,
-  GRPC_STATS_HISTOGRAM_BUCKETS = 840
+  GRPC_STATS_HISTOGRAM_SERVER_QUEUE_WAIT_US_FIRST_SLOT = 968,
+  GRPC_STATS_HISTOGRAM_SERVER_QUEUE_WAIT_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_SERVER_CALL_LATENCY_US_FIRST_SLOT = 1032,
+  GRPC_STATS_HISTOGRAM_SERVER_CALL_LATENCY_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_HANDSHAKE_OFFLOAD_QUEUE_DELAY_US_FIRST_SLOT = 1096,
+  GRPC_STATS_HISTOGRAM_HANDSHAKE_OFFLOAD_QUEUE_DELAY_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_BUCKETS = 1160
 } grpc_stats_histogram_constants;
 #if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED() \
@@ -394,6 +412,12 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES)
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES)
+#define GRPC_STATS_INC_HANDSHAKE_OFFLOAD_SCHEDULED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HANDSHAKE_OFFLOAD_SCHEDULED)
+#define GRPC_STATS_INC_HANDSHAKE_OFFLOAD_RESUMED_SCHEDULED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HANDSHAKE_OFFLOAD_RESUMED_SCHEDULED)
+#define GRPC_STATS_INC_HANDSHAKE_OFFLOAD_REJECTED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HANDSHAKE_OFFLOAD_REJECTED)
 #define GRPC_STATS_INC_CALL_INITIAL_SIZE(value) \
   grpc_stats_inc_call_initial_size((int)(value))
 void grpc_stats_inc_call_initial_size(int x);
@@ -430,9 +454,24 @@ void grpc_stats_inc_http2_send_trailing_metadata_per_write(int x);
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value) \
   grpc_stats_inc_http2_send_flowctl_per_write((int)(value))
 void grpc_stats_inc_http2_send_flowctl_per_write(int x);
+#define GRPC_STATS_INC_HTTP2_WRITE_FLUSH_DELAY_US(value) \
+  grpc_stats_inc_http2_write_flush_delay_us((int)(value))
+void grpc_stats_inc_http2_write_flush_delay_us(int x);
+#define GRPC_STATS_INC_COMBINER_WAIT_US(value) \
+  grpc_stats_inc_combiner_wait_us((int)(value))
+void grpc_stats_inc_combiner_wait_us(int x);
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value) \
   grpc_stats_inc_server_cqs_checked((int)(value))
 void grpc_stats_inc_server_cqs_checked(int x);
+#define GRPC_STATS_INC_SERVER_QUEUE_WAIT_US(value) \
+  grpc_stats_inc_server_queue_wait_us((int)(value))
+void grpc_stats_inc_server_queue_wait_us(int x);
+#define GRPC_STATS_INC_SERVER_CALL_LATENCY_US(value) \
+  grpc_stats_inc_server_call_latency_us((int)(value))
+void grpc_stats_inc_server_call_latency_us(int x);
+#define GRPC_STATS_INC_HANDSHAKE_OFFLOAD_QUEUE_DELAY_US(value) \
+  grpc_stats_inc_handshake_offload_queue_delay_us((int)(value))
+void grpc_stats_inc_handshake_offload_queue_delay_us(int x);
 #else
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED()
 #define GRPC_STATS_INC_SERVER_CALLS_CREATED()
@@ -531,6 +570,9 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES()
+#define GRPC_STATS_INC_HANDSHAKE_OFFLOAD_SCHEDULED()
+#define GRPC_STATS_INC_HANDSHAKE_OFFLOAD_RESUMED_SCHEDULED()
+#define GRPC_STATS_INC_HANDSHAKE_OFFLOAD_REJECTED()
 #define GRPC_STATS_INC_CALL_INITIAL_SIZE(value)
 #define GRPC_STATS_INC_POLL_EVENTS_RETURNED(value)
 #define GRPC_STATS_INC_TCP_WRITE_SIZE(value)
@@ -543,11 +585,16 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HTTP2_SEND_MESSAGE_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_TRAILING_METADATA_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value)
+#define GRPC_STATS_INC_HTTP2_WRITE_FLUSH_DELAY_US(value)
+#define GRPC_STATS_INC_COMBINER_WAIT_US(value)
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value)
+#define GRPC_STATS_INC_SERVER_QUEUE_WAIT_US(value)
+#define GRPC_STATS_INC_SERVER_CALL_LATENCY_US(value)
+#define GRPC_STATS_INC_HANDSHAKE_OFFLOAD_QUEUE_DELAY_US(value)
 #endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
-extern const int grpc_stats_histo_buckets[13];
-extern const int grpc_stats_histo_start[13];
-extern const int* const grpc_stats_histo_bucket_boundaries[13];
-extern void (*const grpc_stats_inc_histogram[13])(int x);
+extern const int grpc_stats_histo_buckets[18];
+extern const int grpc_stats_histo_start[18];
+extern const int* const grpc_stats_histo_bucket_boundaries[18];
+extern void (*const grpc_stats_inc_histogram[18])(int x);
 
 #endif /* GRPC_CORE_LIB_DEBUG_STATS_DATA_H */
@@ -94,4 +94,7 @@ server_requested_calls_per_iteration:FLOAT,
 server_slowpath_requests_queued_per_iteration:FLOAT,
 cq_ev_queue_trylock_failures_per_iteration:FLOAT,
 cq_ev_queue_trylock_successes_per_iteration:FLOAT,
-cq_ev_queue_transient_pop_failures_per_iteration:FLOAT
+cq_ev_queue_transient_pop_failures_per_iteration:FLOAT,
+handshake_offload_scheduled_per_iteration:FLOAT,
+handshake_offload_resumed_scheduled_per_iteration:FLOAT,
+handshake_offload_rejected_per_iteration:FLOAT
@@ -0,0 +1,72 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_LIB_GPRPP_FAST_RANDOM_H
+#define GRPC_CORE_LIB_GPRPP_FAST_RANDOM_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gpr/tls.h"
+
+namespace grpc_core {
+
+namespace fast_random_detail {
+
+// One step of splitmix64: advances *state and returns a well-mixed value.
+inline uint64_t SplitMix64(uint64_t* state) {
+  uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+}  // namespace fast_random_detail
+
+// Returns a pseudo-random 64-bit value from a per-thread splitmix64
+// generator.  Unlike rand(3), this takes no lock and is safe to call from
+// concurrent LB picks.  Not suitable for anything security sensitive.
+inline uint64_t FastRandom64() {
+  static GPR_THREAD_LOCAL(uint64_t) g_state;
+  uint64_t state = g_state;
+  if (GPR_UNLIKELY(state == 0)) {
+    // Seed each thread differently, even if threads start at the same time.
+    static std::atomic<uint64_t> g_seed_sequence{0};
+    uint64_t seed =
+        static_cast<uint64_t>(gpr_now(GPR_CLOCK_PRECISE).tv_nsec) ^
+        (g_seed_sequence.fetch_add(1, std::memory_order_relaxed) << 32);
+    state = fast_random_detail::SplitMix64(&seed) | 1;
+  }
+  const uint64_t value = fast_random_detail::SplitMix64(&state);
+  g_state = state == 0 ? 1 : state;
+  return value;
+}
+
+// Returns a pseudo-random value in [0, range), using FastRandom64().
+// Uses a multiply and shift rather than a modulus; the bias is at most
+// range / 2^32.
+inline uint32_t FastRandomUniform(uint32_t range) {
+  return static_cast<uint32_t>(((FastRandom64() >> 32) * range) >> 32);
+}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_GPRPP_FAST_RANDOM_H
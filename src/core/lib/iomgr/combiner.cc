@@ -24,6 +24,8 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include <atomic>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
@@ -43,6 +45,8 @@ grpc_core::DebugOnlyTraceFlag grpc_combiner_trace(false, "combiner");
 #define STATE_UNORPHANED 1
 #define STATE_ELEM_COUNT_LOW_BIT 2
 
+static std::atomic<grpc_combiner_wait_observer> g_wait_observer{nullptr};
+
 static void combiner_exec(grpc_core::Combiner* lock, grpc_closure* closure,
                           grpc_error_handle error);
 static void combiner_finally_exec(grpc_core::Combiner* lock,
@@ -102,6 +106,16 @@ grpc_core::Combiner* grpc_combiner_ref(
   return lock;
 }
 
+void grpc_combiner_set_wait_observer(grpc_combiner_wait_observer observer) {
+  g_wait_observer.store(observer, std::memory_order_relaxed);
+}
+
+static void start_wait(grpc_core::Combiner* lock) {
+  if (g_wait_observer.load(std::memory_order_relaxed) != nullptr) {
+    lock->wait_start = gpr_get_cycle_counter();
+  }
+}
+
 static void push_last_on_exec_ctx(grpc_core::Combiner* lock) {
   lock->next_combiner_on_this_exec_ctx = nullptr;
   if (grpc_core::ExecCtx::Get()->combiner_data()->active_combiner == nullptr) {
@@ -131,6 +145,7 @@ static void combiner_exec(grpc_core::Combiner* lock, grpc_closure* cl,
                               "C:%p grpc_combiner_execute c=%p last=%" PRIdPTR,
                               lock, cl, last));
   if (last == 1) {
+    start_wait(lock);
     gpr_atm_no_barrier_store(
         &lock->initiating_exec_ctx_or_null,
         reinterpret_cast<gpr_atm>(grpc_core::ExecCtx::Get()));
@@ -174,10 +189,22 @@ static void offload(void* arg, grpc_error_handle /*error*/) {
 
 static void queue_offload(grpc_core::Combiner* lock) {
   move_next();
+  start_wait(lock);
   GRPC_COMBINER_TRACE(gpr_log(GPR_INFO, "C:%p queue_offload", lock));
   grpc_core::Executor::Run(&lock->offload, GRPC_ERROR_NONE);
 }
 
+static void end_wait(grpc_core::Combiner* lock) {
+  if (lock->wait_start == 0) return;
+  grpc_combiner_wait_observer observer =
+      g_wait_observer.load(std::memory_order_relaxed);
+  if (observer != nullptr) {
+    observer(gpr_timespec_to_micros(
+        gpr_cycle_counter_sub(gpr_get_cycle_counter(), lock->wait_start)));
+  }
+  lock->wait_start = 0;
+}
+
 bool grpc_combiner_continue_exec_ctx() {
   grpc_core::Combiner* lock =
       grpc_core::ExecCtx::Get()->combiner_data()->active_combiner;
@@ -224,6 +251,7 @@ bool grpc_combiner_continue_exec_ctx() {
       queue_offload(lock);
       return true;
     }
+    end_wait(lock);
     grpc_closure* cl = reinterpret_cast<grpc_closure*>(n);
 #ifndef NDEBUG
     cl->scheduled = false;
@@ -241,6 +269,7 @@ bool grpc_combiner_continue_exec_ctx() {
     GRPC_ERROR_UNREF(cl_err);
 #endif
   } else {
+    end_wait(lock);
     grpc_closure* c = lock->final_list.head;
     GPR_ASSERT(c != nullptr);
     grpc_closure_list_init(&lock->final_list);
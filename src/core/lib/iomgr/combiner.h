@@ -26,6 +26,7 @@
 #include <grpc/support/atm.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
 namespace grpc_core {
@@ -48,6 +49,9 @@ class Combiner {
   // other bits - number of items queued on the lock (STATE_ELEM_COUNT_LOW_BIT)
   gpr_atm state;
   bool time_to_execute_final_list = false;
+  // when the lock, idle or offloaded, was last given work to run; zero once
+  // it has run a closure, or if there is no wait observer
+  gpr_cycle_counter wait_start = 0;
   grpc_closure_list final_list;
   grpc_closure offload;
   gpr_refcount refs;
@@ -84,6 +88,13 @@ void grpc_combiner_unref(grpc_core::Combiner* lock GRPC_COMBINER_DEBUG_ARGS);
 
 bool grpc_combiner_continue_exec_ctx();
 
+// Sets a function to be called with the microseconds each combiner lock
+// waited, from being given work while idle (or being offloaded to another
+// thread) until it ran its next closure.  Combiners read the clock only while
+// an observer is set; nullptr, the default, unsets it.
+typedef void (*grpc_combiner_wait_observer)(double wait_us);
+void grpc_combiner_set_wait_observer(grpc_combiner_wait_observer observer);
+
 extern grpc_core::DebugOnlyTraceFlag grpc_combiner_trace;
 
 #endif /* GRPC_CORE_LIB_IOMGR_COMBINER_H */
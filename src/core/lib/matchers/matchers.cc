@@ -16,7 +16,10 @@
 
 #include "src/core/lib/matchers/matchers.h"
 
+#include <algorithm>
+
 #include "absl/memory/memory.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
@@ -324,4 +327,178 @@ std::string HeaderMatcher::ToString() const {
   }
 }
 
+//
+// StringMatcherSet::LiteralAutomaton
+//
+
+void StringMatcherSet::LiteralAutomaton::Add(absl::string_view literal,
+                                             uint32_t matcher_index) {
+  uint32_t node = 0;
+  for (char c : literal) {
+    uint32_t child = FindChild(node, c);
+    if (child == kNone) {
+      child = nodes_.size();
+      auto& children = nodes_[node].children;
+      children.insert(
+          std::lower_bound(children.begin(), children.end(),
+                           std::make_pair(c, uint32_t(0))),
+          {c, child});
+      nodes_.emplace_back();
+      nodes_[child].depth = nodes_[node].depth + 1;
+    }
+    node = child;
+  }
+  nodes_[node].outputs.push_back(matcher_index);
+}
+
+void StringMatcherSet::LiteralAutomaton::Compile() {
+  // Visit the nodes breadth-first, so that each node's failure link is set
+  // before those of its children.
+  std::vector<uint32_t> queue;
+  for (const auto& child : nodes_[0].children) queue.push_back(child.second);
+  for (size_t i = 0; i < queue.size(); ++i) {
+    const uint32_t node = queue[i];
+    for (const auto& child : nodes_[node].children) {
+      uint32_t fail = nodes_[node].fail;
+      uint32_t target;
+      while ((target = FindChild(fail, child.first)) == kNone && fail != 0) {
+        fail = nodes_[fail].fail;
+      }
+      Node& child_node = nodes_[child.second];
+      child_node.fail = target == kNone ? 0 : target;
+      const Node& fail_node = nodes_[child_node.fail];
+      child_node.output_link =
+          fail_node.outputs.empty() ? fail_node.output_link : child_node.fail;
+      queue.push_back(child.second);
+    }
+  }
+}
+
+void StringMatcherSet::LiteralAutomaton::Match(
+    absl::string_view value, const std::vector<StringMatcher>& matchers,
+    std::vector<bool>* matched) const {
+  uint32_t state = 0;
+  for (size_t i = 0; i < value.size(); ++i) {
+    uint32_t next;
+    while ((next = FindChild(state, value[i])) == kNone && state != 0) {
+      state = nodes_[state].fail;
+    }
+    state = next == kNone ? 0 : next;
+    const size_t end = i + 1;
+    for (uint32_t node = nodes_[state].outputs.empty()
+                             ? nodes_[state].output_link
+                             : state;
+         node != kNone; node = nodes_[node].output_link) {
+      const size_t start = end - nodes_[node].depth;
+      for (uint32_t index : nodes_[node].outputs) {
+        switch (matchers[index].type()) {
+          case StringMatcher::Type::kExact:
+            if (start != 0 || end != value.size()) continue;
+            break;
+          case StringMatcher::Type::kPrefix:
+            if (start != 0) continue;
+            break;
+          case StringMatcher::Type::kSuffix:
+            if (end != value.size()) continue;
+            break;
+          case StringMatcher::Type::kContains:
+            break;
+          default:
+            continue;
+        }
+        (*matched)[index] = true;
+      }
+    }
+  }
+}
+
+uint32_t StringMatcherSet::LiteralAutomaton::FindChild(uint32_t node,
+                                                       char c) const {
+  const auto& children = nodes_[node].children;
+  auto it = std::lower_bound(children.begin(), children.end(),
+                             std::make_pair(c, uint32_t(0)));
+  if (it == children.end() || it->first != c) return kNone;
+  return it->second;
+}
+
+//
+// StringMatcherSet
+//
+
+StringMatcherSet::StringMatcherSet(std::vector<StringMatcher> matchers)
+    : matchers_(std::move(matchers)) {
+  for (uint32_t i = 0; i < matchers_.size(); ++i) {
+    const StringMatcher& matcher = matchers_[i];
+    if (matcher.type() == StringMatcher::Type::kSafeRegex) {
+      regex_matchers_.push_back(i);
+    } else if (matcher.string_matcher().empty()) {
+      empty_literals_.push_back(i);
+    } else if (matcher.case_sensitive()) {
+      case_sensitive_literals_.Add(matcher.string_matcher(), i);
+    } else {
+      case_insensitive_literals_.Add(
+          absl::AsciiStrToLower(matcher.string_matcher()), i);
+    }
+  }
+  case_sensitive_literals_.Compile();
+  case_insensitive_literals_.Compile();
+  if (regex_matchers_.empty()) return;
+  // StringMatcher matches regexes with RE2::FullMatch() and the default
+  // options, which is what a set anchored at both ends does.
+  regex_set_ = absl::make_unique<RE2::Set>(RE2::Options(), RE2::ANCHOR_BOTH);
+  for (uint32_t index : regex_matchers_) {
+    std::string error;
+    if (regex_set_->Add(matchers_[index].regex_matcher()->pattern(), &error) <
+        0) {
+      regex_set_.reset();
+      return;
+    }
+  }
+  // The regexes are each valid, but together may be too large for one
+  // RE2::Set.  If so, they are matched one at a time.
+  if (!regex_set_->Compile()) regex_set_.reset();
+}
+
+StringMatcherSet::StringMatcherSet(StringMatcherSet&& other) noexcept =
+    default;
+
+StringMatcherSet& StringMatcherSet::operator=(
+    StringMatcherSet&& other) noexcept = default;
+
+std::vector<size_t> StringMatcherSet::Match(absl::string_view value) const {
+  std::vector<bool> matched(matchers_.size());
+  for (uint32_t index : empty_literals_) {
+    matched[index] =
+        matchers_[index].type() != StringMatcher::Type::kExact || value.empty();
+  }
+  if (!case_sensitive_literals_.empty()) {
+    case_sensitive_literals_.Match(value, matchers_, &matched);
+  }
+  if (!case_insensitive_literals_.empty()) {
+    case_insensitive_literals_.Match(absl::AsciiStrToLower(value), matchers_,
+                                     &matched);
+  }
+  if (!regex_matchers_.empty()) {
+    std::vector<int> regex_matches;
+    RE2::Set::ErrorInfo error_info;
+    if (regex_set_ == nullptr ||
+        (!regex_set_->Match(re2::StringPiece(value.data(), value.size()),
+                            &regex_matches, &error_info) &&
+         error_info.kind != RE2::Set::kNoError)) {
+      // The regexes could not be compiled together, or RE2 ran out of
+      // memory for the combined automaton; match them one at a time.
+      for (uint32_t index : regex_matchers_) {
+        if (matchers_[index].Match(value)) matched[index] = true;
+      }
+    } else {
+      for (int index : regex_matches) matched[regex_matchers_[index]] = true;
+    }
+  }
+  std::vector<size_t> result;
+  for (size_t i = 0; i < matched.size(); ++i) {
+    if (matched[i]) result.push_back(i);
+  }
+  return result;
+}
+
 }  // namespace grpc_core
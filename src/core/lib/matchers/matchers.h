@@ -17,13 +17,17 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 #include "re2/re2.h"
+#include "re2/set.h"
 
 namespace grpc_core {
 
@@ -155,6 +159,75 @@ class HeaderMatcher {
   bool invert_match_ = false;
 };
 
+// Matches a value against many StringMatchers at once.  Literal matchers
+// (exact, prefix, suffix and contains) are compiled into one Aho-Corasick
+// automaton, with a second one for case-insensitive matchers, and regex
+// matchers into one RE2::Set, so that a value is scanned a fixed number of
+// times however many matchers there are.  If the regexes are too large for
+// one RE2::Set, they are matched one at a time instead.
+class StringMatcherSet {
+ public:
+  StringMatcherSet() = default;
+  explicit StringMatcherSet(std::vector<StringMatcher> matchers);
+
+  StringMatcherSet(StringMatcherSet&& other) noexcept;
+  StringMatcherSet& operator=(StringMatcherSet&& other) noexcept;
+
+  // Returns the indices of the matchers that match value, in increasing
+  // order.
+  std::vector<size_t> Match(absl::string_view value) const;
+
+  size_t size() const { return matchers_.size(); }
+
+  const StringMatcher& matcher(size_t index) const {
+    return matchers_[index];
+  }
+
+ private:
+  // An Aho-Corasick automaton over the strings of literal matchers.
+  class LiteralAutomaton {
+   public:
+    void Add(absl::string_view literal, uint32_t matcher_index);
+    // Computes the failure links.  Must be called after the last Add().
+    void Compile();
+    // Sets matched[i] for each matcher i whose literal matches value, as
+    // its type requires.
+    void Match(absl::string_view value,
+               const std::vector<StringMatcher>& matchers,
+               std::vector<bool>* matched) const;
+
+    bool empty() const { return nodes_.size() <= 1; }
+
+   private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+
+    struct Node {
+      // Sorted by character.
+      std::vector<std::pair<char, uint32_t>> children;
+      uint32_t fail = 0;
+      // The nearest node along the failure links that has outputs.
+      uint32_t output_link = kNone;
+      uint32_t depth = 0;
+      // Matchers whose literal ends at this node.
+      std::vector<uint32_t> outputs;
+    };
+
+    uint32_t FindChild(uint32_t node, char c) const;
+
+    std::vector<Node> nodes_ = std::vector<Node>(1);
+  };
+
+  std::vector<StringMatcher> matchers_;
+  LiteralAutomaton case_sensitive_literals_;
+  LiteralAutomaton case_insensitive_literals_;
+  // Literal matchers for the empty string, which the automata cannot report.
+  std::vector<uint32_t> empty_literals_;
+  // Null if the regexes could not be compiled into one set.
+  std::unique_ptr<RE2::Set> regex_set_;
+  // Maps the indices of regex_set_ to indices of matchers_.
+  std::vector<uint32_t> regex_matchers_;
+};
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_LIB_MATCHERS_MATCHERS_H */
@@ -80,6 +80,10 @@ class Arena {
     return t;
   }
 
+  // Returns the allocator that memory owned by this arena's user should be
+  // charged to.
+  MemoryAllocator* memory_allocator() const { return memory_allocator_; }
+
  private:
   struct Zone {
     Zone* prev;
@@ -245,6 +245,11 @@ class BasicMemoryQuota final
   // Instantaneous memory pressure approximation.
   std::pair<double, size_t>
   InstantaneousPressureAndMaxRecommendedAllocationSize() const;
+  // Returns true if the quota was given a size.
+  bool IsBounded() const {
+    return quota_size_.load(std::memory_order_relaxed) !=
+           static_cast<size_t>(kInitialSize);
+  }
   // Get a reclamation queue
   ReclaimerQueue* reclaimer_queue(size_t i) { return &reclaimers_[i]; }
 
@@ -447,6 +452,14 @@ class MemoryQuota final
                .first > kMemoryPressureHighThreshold;
   }
 
+  // Returns the largest single allocation recommended from this quota, or
+  // nullopt if the quota has no size.
+  absl::optional<size_t> MaxRecommendedAllocationSize() const {
+    if (!memory_quota_->IsBounded()) return absl::nullopt;
+    return memory_quota_->InstantaneousPressureAndMaxRecommendedAllocationSize()
+        .second;
+  }
+
  private:
   friend class MemoryOwner;
   std::shared_ptr<BasicMemoryQuota> memory_quota_;
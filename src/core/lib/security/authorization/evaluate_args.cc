@@ -60,6 +60,38 @@ EvaluateArgs::PerChannelArgs::Address ParseEndpointUri(
 
 }  // namespace
 
+std::shared_ptr<const EvaluateArgs::ConnectionCache::Results>
+EvaluateArgs::ConnectionCache::GetOrCompute(
+    uint64_t engine_id, const std::function<Results()>& compute) {
+  {
+    MutexLock lock(&mu_);
+    auto results = FindLocked(engine_id);
+    if (results != nullptr) return results;
+  }
+  // Computed without holding the lock, since it may evaluate many matchers.
+  // If another call raced with this one, the first result stored wins.
+  auto results = std::make_shared<const Results>(compute());
+  MutexLock lock(&mu_);
+  auto existing = FindLocked(engine_id);
+  if (existing != nullptr) return existing;
+  if (results_.size() >= kMaxEngines) {
+    results_.erase(lru_list_.front());
+    lru_list_.pop_front();
+  }
+  Entry& entry = results_[engine_id];
+  entry.results = std::move(results);
+  entry.lru_iterator = lru_list_.insert(lru_list_.end(), engine_id);
+  return entry.results;
+}
+
+std::shared_ptr<const EvaluateArgs::ConnectionCache::Results>
+EvaluateArgs::ConnectionCache::FindLocked(uint64_t engine_id) {
+  auto it = results_.find(engine_id);
+  if (it == results_.end()) return nullptr;
+  lru_list_.splice(lru_list_.end(), lru_list_, it->second.lru_iterator);
+  return it->second.results;
+}
+
 EvaluateArgs::PerChannelArgs::PerChannelArgs(grpc_auth_context* auth_context,
                                              grpc_endpoint* endpoint) {
   if (auth_context != nullptr) {
@@ -209,4 +241,11 @@ absl::string_view EvaluateArgs::GetSubject() const {
   return channel_args_->subject;
 }
 
+EvaluateArgs::ConnectionCache* EvaluateArgs::GetConnectionCache() const {
+  if (channel_args_ == nullptr) {
+    return nullptr;
+  }
+  return channel_args_->connection_cache.get();
+}
+
 }  // namespace grpc_core
@@ -17,10 +17,18 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
+#include <functional>
+#include <list>
 #include <map>
+#include <memory>
+#include <vector>
 
+#include "absl/memory/memory.h"
 #include "absl/types/optional.h"
 
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/security/context/security_context.h"
@@ -30,6 +38,39 @@ namespace grpc_core {
 
 class EvaluateArgs {
  public:
+  // Results that an authorization engine computes from the per-channel args
+  // alone, so that they are computed once per connection rather than on
+  // every call.  Keyed by an id that is unique to the engine.
+  class ConnectionCache {
+   public:
+    using Results = std::vector<bool>;
+
+    // Engines are replaced when policies change, so once this many engines
+    // have results, the results of the least recently used one are dropped.
+    static constexpr size_t kMaxEngines = 16;
+
+    // Returns the results cached for engine_id, computing them with compute
+    // if there are none yet.
+    std::shared_ptr<const Results> GetOrCompute(
+        uint64_t engine_id, const std::function<Results()>& compute);
+
+   private:
+    struct Entry {
+      std::shared_ptr<const Results> results;
+      std::list<uint64_t>::iterator lru_iterator;
+    };
+
+    // Returns the results cached for engine_id, if any, and marks them as
+    // the most recently used.
+    std::shared_ptr<const Results> FindLocked(uint64_t engine_id)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+    Mutex mu_;
+    std::map<uint64_t, Entry> results_ ABSL_GUARDED_BY(mu_);
+    // Engine ids, from least to most recently used.
+    std::list<uint64_t> lru_list_ ABSL_GUARDED_BY(mu_);
+  };
+
   // Caller is responsible for ensuring auth_context outlives PerChannelArgs
   // struct.
   struct PerChannelArgs {
@@ -51,6 +92,8 @@ class EvaluateArgs {
     absl::string_view subject;
     Address local_address;
     Address peer_address;
+    std::unique_ptr<ConnectionCache> connection_cache =
+        absl::make_unique<ConnectionCache>();
   };
 
   EvaluateArgs(grpc_metadata_batch* metadata, PerChannelArgs* channel_args)
@@ -81,6 +124,8 @@ class EvaluateArgs {
   std::vector<absl::string_view> GetDnsSans() const;
   absl::string_view GetCommonName() const;
   absl::string_view GetSubject() const;
+  // Returns nullptr if there are no per-channel args.
+  ConnectionCache* GetConnectionCache() const;
 
  private:
   grpc_metadata_batch* metadata_;
@@ -16,36 +16,361 @@
 
 #include "src/core/lib/security/authorization/grpc_authorization_engine.h"
 
+#include <algorithm>
+#include <atomic>
+
+#include "absl/container/inlined_vector.h"
+
+#include <grpc/support/log.h>
+
 namespace grpc_core {
 
+namespace {
+
+std::atomic<uint64_t> g_next_engine_id{1};
+
+const std::vector<std::unique_ptr<Rbac::Permission>>& Children(
+    const Rbac::Permission& permission) {
+  return permission.permissions;
+}
+
+const std::vector<std::unique_ptr<Rbac::Principal>>& Children(
+    const Rbac::Principal& principal) {
+  return principal.principals;
+}
+
+const StringMatcher& PathMatcher(const Rbac::Permission& permission) {
+  return permission.string_matcher;
+}
+
+const StringMatcher& PathMatcher(const Rbac::Principal& principal) {
+  return *principal.string_matcher;
+}
+
+// Returns true if the rule depends only on the connection and not on the
+// call, so that its result can be cached per connection.
+template <typename Rule>
+bool IsConnectionRule(const Rule& rule) {
+  switch (rule.type) {
+    case Rule::RuleType::kAnd:
+    case Rule::RuleType::kOr:
+    case Rule::RuleType::kNot:
+      for (const auto& child : Children(rule)) {
+        if (!IsConnectionRule(*child)) return false;
+      }
+      return true;
+    case Rule::RuleType::kHeader:
+    case Rule::RuleType::kPath:
+      return false;
+    default:
+      return true;
+  }
+}
+
+// If the rule can only match a call whose path matches one of a set of
+// case-sensitive exact or prefix matchers, adds those matchers to paths and
+// returns true.  Otherwise, returns false without changing paths.
+template <typename Rule>
+bool GetRequiredPaths(const Rule& rule,
+                      std::vector<const StringMatcher*>* paths) {
+  switch (rule.type) {
+    case Rule::RuleType::kAnd:
+      // Any one of the rules constrains the path.
+      for (const auto& child : Children(rule)) {
+        if (GetRequiredPaths(*child, paths)) return true;
+      }
+      return false;
+    case Rule::RuleType::kOr: {
+      // Each of the rules must constrain the path.
+      std::vector<const StringMatcher*> child_paths;
+      for (const auto& child : Children(rule)) {
+        if (!GetRequiredPaths(*child, &child_paths)) return false;
+      }
+      paths->insert(paths->end(), child_paths.begin(), child_paths.end());
+      return true;
+    }
+    case Rule::RuleType::kPath: {
+      const StringMatcher& matcher = PathMatcher(rule);
+      if (!matcher.case_sensitive() ||
+          (matcher.type() != StringMatcher::Type::kExact &&
+           matcher.type() != StringMatcher::Type::kPrefix)) {
+        return false;
+      }
+      paths->push_back(&matcher);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+struct CompareTrieChild {
+  bool operator()(const std::pair<char, uint32_t>& child, char c) const {
+    return child.first < c;
+  }
+};
+
+}  // namespace
+
+//
+// GrpcAuthorizationEngine::CallState
+//
+
+// The state of evaluating one call.
+class GrpcAuthorizationEngine::CallState {
+ public:
+  CallState(const EvaluateArgs& args, size_t num_headers,
+            const EvaluateArgs::ConnectionCache::Results* connection_results)
+      : args_(args),
+        path_(args.GetPath()),
+        connection_results_(connection_results),
+        headers_(num_headers) {}
+
+  absl::string_view path() const { return path_; }
+
+  bool connection_result(size_t index) const {
+    return (*connection_results_)[index];
+  }
+
+  // Looks each header up in the metadata at most once per call.
+  absl::optional<absl::string_view> GetHeaderValue(size_t index,
+                                                   const std::string& name) {
+    HeaderValue& header = headers_[index];
+    if (!header.fetched) {
+      header.value = args_.GetHeaderValue(name, &header.concatenated_value);
+      header.fetched = true;
+    }
+    return header.value;
+  }
+
+ private:
+  struct HeaderValue {
+    bool fetched = false;
+    absl::optional<absl::string_view> value;
+    std::string concatenated_value;
+  };
+
+  const EvaluateArgs& args_;
+  const absl::string_view path_;
+  const EvaluateArgs::ConnectionCache::Results* connection_results_;
+  // Sized once, so that values keep pointing into concatenated_value.
+  absl::InlinedVector<HeaderValue, 4> headers_;
+};
+
+//
+// GrpcAuthorizationEngine
+//
+
+GrpcAuthorizationEngine::GrpcAuthorizationEngine(Rbac::Action action)
+    : action_(action), id_(g_next_engine_id.fetch_add(1)) {}
+
 GrpcAuthorizationEngine::GrpcAuthorizationEngine(Rbac policy)
-    : action_(policy.action) {
+    : action_(policy.action), id_(g_next_engine_id.fetch_add(1)) {
   for (auto& sub_policy : policy.policies) {
-    Policy policy;
-    policy.name = sub_policy.first;
-    policy.matcher = absl::make_unique<PolicyAuthorizationMatcher>(
-        std::move(sub_policy.second));
-    policies_.push_back(std::move(policy));
+    const uint32_t policy_index = policies_.size();
+    std::vector<const StringMatcher*> paths;
+    if (GetRequiredPaths(sub_policy.second.permissions, &paths) ||
+        GetRequiredPaths(sub_policy.second.principals, &paths)) {
+      for (const StringMatcher* path : paths) {
+        AddToPathTrie(path->string_matcher(),
+                      path->type() == StringMatcher::Type::kExact,
+                      policy_index);
+      }
+    } else {
+      unconstrained_policies_.push_back(policy_index);
+    }
+    Policy compiled_policy;
+    compiled_policy.name = sub_policy.first;
+    compiled_policy.root = nodes_.size();
+    nodes_.push_back({Node::Op::kAnd, 0, 0});
+    CompileRule(std::move(sub_policy.second.permissions));
+    CompileRule(std::move(sub_policy.second.principals));
+    nodes_[compiled_policy.root].end = nodes_.size();
+    policies_.push_back(std::move(compiled_policy));
   }
 }
 
 GrpcAuthorizationEngine::GrpcAuthorizationEngine(
     GrpcAuthorizationEngine&& other) noexcept
-    : action_(other.action_), policies_(std::move(other.policies_)) {}
+    : action_(other.action_), id_(other.id_) {
+  *this = std::move(other);
+}
 
 GrpcAuthorizationEngine& GrpcAuthorizationEngine::operator=(
     GrpcAuthorizationEngine&& other) noexcept {
   action_ = other.action_;
+  id_ = other.id_;
   policies_ = std::move(other.policies_);
+  nodes_ = std::move(other.nodes_);
+  path_matchers_ = std::move(other.path_matchers_);
+  header_matchers_ = std::move(other.header_matchers_);
+  header_names_ = std::move(other.header_names_);
+  connection_matchers_ = std::move(other.connection_matchers_);
+  unconstrained_policies_ = std::move(other.unconstrained_policies_);
+  path_trie_ = std::move(other.path_trie_);
   return *this;
 }
 
+template <typename Rule>
+void GrpcAuthorizationEngine::CompileRule(Rule rule) {
+  const uint32_t index = nodes_.size();
+  if (IsConnectionRule(rule)) {
+    nodes_.push_back({Node::Op::kConnection, index + 1,
+                      static_cast<uint32_t>(connection_matchers_.size())});
+    connection_matchers_.push_back(
+        AuthorizationMatcher::Create(std::move(rule)));
+    return;
+  }
+  switch (rule.type) {
+    case Rule::RuleType::kAnd:
+    case Rule::RuleType::kOr:
+    case Rule::RuleType::kNot:
+      nodes_.push_back({rule.type == Rule::RuleType::kAnd  ? Node::Op::kAnd
+                        : rule.type == Rule::RuleType::kOr ? Node::Op::kOr
+                                                           : Node::Op::kNot,
+                        0, 0});
+      for (const auto& child : Children(rule)) {
+        CompileRule(std::move(*child));
+      }
+      nodes_[index].end = nodes_.size();
+      return;
+    case Rule::RuleType::kHeader: {
+      const std::string& name = rule.header_matcher.name();
+      auto it = std::find(header_names_.begin(), header_names_.end(), name);
+      const size_t name_index = it - header_names_.begin();
+      if (it == header_names_.end()) header_names_.push_back(name);
+      nodes_.push_back({Node::Op::kHeader, index + 1,
+                        static_cast<uint32_t>(header_matchers_.size())});
+      header_matchers_.push_back({name_index, std::move(rule.header_matcher)});
+      return;
+    }
+    case Rule::RuleType::kPath:
+      nodes_.push_back({Node::Op::kPath, index + 1,
+                        static_cast<uint32_t>(path_matchers_.size())});
+      path_matchers_.push_back(PathMatcher(rule));
+      return;
+    default:
+      // Every other rule depends only on the connection.
+      GPR_UNREACHABLE_CODE(return);
+  }
+}
+
+void GrpcAuthorizationEngine::AddToPathTrie(const std::string& path,
+                                            bool exact,
+                                            uint32_t policy_index) {
+  if (path_trie_.empty()) path_trie_.emplace_back();
+  uint32_t node = 0;
+  for (char c : path) {
+    auto& children = path_trie_[node].children;
+    auto it = std::lower_bound(children.begin(), children.end(), c,
+                               CompareTrieChild());
+    if (it != children.end() && it->first == c) {
+      node = it->second;
+      continue;
+    }
+    const uint32_t child = path_trie_.size();
+    children.insert(it, {c, child});
+    path_trie_.emplace_back();
+    node = child;
+  }
+  PathTrieNode& trie_node = path_trie_[node];
+  std::vector<uint32_t>& policies =
+      exact ? trie_node.exact_policies : trie_node.prefix_policies;
+  // A policy may require several paths that share a node.
+  if (policies.empty() || policies.back() != policy_index) {
+    policies.push_back(policy_index);
+  }
+}
+
+EvaluateArgs::ConnectionCache::Results
+GrpcAuthorizationEngine::EvaluateConnectionMatchers(
+    const EvaluateArgs& args) const {
+  EvaluateArgs::ConnectionCache::Results results;
+  results.reserve(connection_matchers_.size());
+  for (const auto& matcher : connection_matchers_) {
+    results.push_back(matcher->Matches(args));
+  }
+  return results;
+}
+
+bool GrpcAuthorizationEngine::EvaluateNode(uint32_t index,
+                                           CallState* state) const {
+  const Node& node = nodes_[index];
+  switch (node.op) {
+    case Node::Op::kAnd:
+      for (uint32_t child = index + 1; child < node.end;
+           child = nodes_[child].end) {
+        if (!EvaluateNode(child, state)) return false;
+      }
+      return true;
+    case Node::Op::kOr:
+      for (uint32_t child = index + 1; child < node.end;
+           child = nodes_[child].end) {
+        if (EvaluateNode(child, state)) return true;
+      }
+      return false;
+    case Node::Op::kNot:
+      return !EvaluateNode(index + 1, state);
+    case Node::Op::kPath:
+      if (state->path().empty()) return false;
+      return path_matchers_[node.index].Match(state->path());
+    case Node::Op::kHeader: {
+      const HeaderMatcherEntry& entry = header_matchers_[node.index];
+      return entry.matcher.Match(state->GetHeaderValue(
+          entry.name_index, header_names_[entry.name_index]));
+    }
+    case Node::Op::kConnection:
+      return state->connection_result(node.index);
+  }
+  GPR_UNREACHABLE_CODE(return false);
+}
+
 AuthorizationEngine::Decision GrpcAuthorizationEngine::Evaluate(
     const EvaluateArgs& args) const {
+  std::shared_ptr<const EvaluateArgs::ConnectionCache::Results>
+      connection_results;
+  if (!connection_matchers_.empty()) {
+    EvaluateArgs::ConnectionCache* cache = args.GetConnectionCache();
+    if (cache != nullptr) {
+      connection_results = cache->GetOrCompute(
+          id_, [this, &args]() { return EvaluateConnectionMatchers(args); });
+    } else {
+      connection_results =
+          std::make_shared<const EvaluateArgs::ConnectionCache::Results>(
+              EvaluateConnectionMatchers(args));
+    }
+  }
+  CallState state(args, header_names_.size(), connection_results.get());
+  // Gather the policies that can match this path, in order.
+  absl::InlinedVector<uint32_t, 16> candidates(
+      unconstrained_policies_.begin(), unconstrained_policies_.end());
+  if (!path_trie_.empty()) {
+    absl::string_view path = state.path();
+    uint32_t node = 0;
+    for (size_t depth = 0;; ++depth) {
+      const PathTrieNode& trie_node = path_trie_[node];
+      candidates.insert(candidates.end(), trie_node.prefix_policies.begin(),
+                        trie_node.prefix_policies.end());
+      if (depth == path.size()) {
+        candidates.insert(candidates.end(), trie_node.exact_policies.begin(),
+                          trie_node.exact_policies.end());
+        break;
+      }
+      auto it = std::lower_bound(trie_node.children.begin(),
+                                 trie_node.children.end(), path[depth],
+                                 CompareTrieChild());
+      if (it == trie_node.children.end() || it->first != path[depth]) break;
+      node = it->second;
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                     candidates.end());
+  }
   Decision decision;
   bool matches = false;
-  for (const auto& policy : policies_) {
-    if (policy.matcher->Matches(args)) {
+  for (uint32_t policy_index : candidates) {
+    const Policy& policy = policies_[policy_index];
+    if (EvaluateNode(policy.root, &state)) {
       matches = true;
       decision.matching_policy_name = policy.name;
       break;
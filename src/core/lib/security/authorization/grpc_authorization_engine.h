@@ -17,6 +17,12 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "src/core/lib/security/authorization/authorization_engine.h"
 #include "src/core/lib/security/authorization/matchers.h"
 #include "src/core/lib/security/authorization/rbac_policy.h"
@@ -29,10 +35,16 @@ namespace grpc_core {
 // engine type. This engine ignores condition field in RBAC config. It is the
 // caller's responsibility to provide RBAC policies that are compatible with
 // this engine.
+//
+// Policies are compiled into a flat program when the engine is built.  Rules
+// that depend only on the connection (peer identity, addresses, ports) are
+// evaluated once per connection and cached in the per-channel args, and a
+// trie over the literal paths that policies require picks the policies that
+// can match a call before any of them is evaluated.
 class GrpcAuthorizationEngine : public AuthorizationEngine {
  public:
   // Builds GrpcAuthorizationEngine without any policies.
-  explicit GrpcAuthorizationEngine(Rbac::Action action) : action_(action) {}
+  explicit GrpcAuthorizationEngine(Rbac::Action action);
   // Builds GrpcAuthorizationEngine with allow/deny RBAC policy.
   explicit GrpcAuthorizationEngine(Rbac policy);
 
@@ -49,12 +61,71 @@ class GrpcAuthorizationEngine : public AuthorizationEngine {
   Decision Evaluate(const EvaluateArgs& args) const override;
 
  private:
+  // A node of the compiled program.  The nodes of a rule are laid out in
+  // pre-order, so the children of a node follow it, up to its end.
+  struct Node {
+    enum class Op {
+      kAnd,
+      kOr,
+      kNot,
+      // Matches path_matchers_[index] against the path.
+      kPath,
+      // Matches header_matchers_[index] against its header.
+      kHeader,
+      // Looks up the result of connection_matchers_[index].
+      kConnection,
+    };
+    Op op;
+    // One past the last node of this node's subtree.
+    uint32_t end;
+    uint32_t index;
+  };
+
+  struct HeaderMatcherEntry {
+    // Index into header_names_.
+    size_t name_index;
+    HeaderMatcher matcher;
+  };
+
   struct Policy {
     std::string name;
-    std::unique_ptr<AuthorizationMatcher> matcher;
+    // The root node, which requires both permissions and principals.
+    uint32_t root;
   };
+
+  struct PathTrieNode {
+    // Sorted by character.
+    std::vector<std::pair<char, uint32_t>> children;
+    // Policies that require the path to start with this node's prefix.
+    std::vector<uint32_t> prefix_policies;
+    // Policies that require the path to equal this node's prefix.
+    std::vector<uint32_t> exact_policies;
+  };
+
+  class CallState;
+
+  template <typename Rule>
+  void CompileRule(Rule rule);
+  void AddToPathTrie(const std::string& path, bool exact,
+                     uint32_t policy_index);
+
+  EvaluateArgs::ConnectionCache::Results EvaluateConnectionMatchers(
+      const EvaluateArgs& args) const;
+  bool EvaluateNode(uint32_t index, CallState* state) const;
+
   Rbac::Action action_;
+  // Identifies this engine's results in connection caches.
+  uint64_t id_;
   std::vector<Policy> policies_;
+  std::vector<Node> nodes_;
+  std::vector<StringMatcher> path_matchers_;
+  std::vector<HeaderMatcherEntry> header_matchers_;
+  std::vector<std::string> header_names_;
+  std::vector<std::unique_ptr<AuthorizationMatcher>> connection_matchers_;
+  // Policies that may match whatever the path is, in order.
+  std::vector<uint32_t> unconstrained_policies_;
+  // The root is at index 0, if there are any constrained policies.
+  std::vector<PathTrieNode> path_trie_;
 };
 
 }  // namespace grpc_core
@@ -20,6 +20,7 @@
 
 #include "src/core/lib/security/security_connector/ssl_utils.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "absl/strings/str_cat.h"
@@ -92,6 +93,12 @@ const char* grpc_get_ssl_cipher_suites(void) {
   return cipher_suites;
 }
 
+size_t grpc_get_ssl_cert_cache_size(void) {
+  static const size_t cert_cache_size = static_cast<size_t>(
+      std::max(GPR_GLOBAL_CONFIG_GET(grpc_ssl_cert_cache_size), 0));
+  return cert_cache_size;
+}
+
 tsi_client_certificate_request_type
 grpc_get_tsi_client_certificate_request_type(
     grpc_ssl_client_certificate_request_type grpc_request_type) {
@@ -453,6 +460,7 @@ grpc_security_status grpc_ssl_tsi_client_handshaker_factory_init(
   options.min_tls_version = min_tls_version;
   options.max_tls_version = max_tls_version;
   options.crl_directory = crl_directory;
+  options.cert_cache_capacity = grpc_get_ssl_cert_cache_size();
   const tsi_result result =
       tsi_create_ssl_client_handshaker_factory_with_options(&options,
                                                             handshaker_factory);
@@ -489,6 +497,7 @@ grpc_security_status grpc_ssl_tsi_server_handshaker_factory_init(
   options.max_tls_version = max_tls_version;
   options.key_logger = tls_session_key_logger;
   options.crl_directory = crl_directory;
+  options.cert_cache_capacity = grpc_get_ssl_cert_cache_size();
   const tsi_result result =
       tsi_create_ssl_server_handshaker_factory_with_options(&options,
                                                             handshaker_factory);
@@ -63,6 +63,10 @@ absl::Status SslCheckCallHost(absl::string_view host,
 /* Return HTTP2-compliant cipher suites that gRPC accepts by default. */
 const char* grpc_get_ssl_cipher_suites(void);
 
+/* Return the number of peer certificate chains each SSL handshaker factory
+   caches, as configured by GRPC_SSL_CERT_CACHE_SIZE. */
+size_t grpc_get_ssl_cert_cache_size(void);
+
 /* Map from grpc_ssl_client_certificate_request_type to
  * tsi_client_certificate_request_type. */
 tsi_client_certificate_request_type
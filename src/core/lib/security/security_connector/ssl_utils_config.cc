@@ -30,3 +30,11 @@ GPR_GLOBAL_CONFIG_DEFINE_STRING(grpc_default_ssl_roots_file_path, "",
     certificates from the OS trust store. */
 GPR_GLOBAL_CONFIG_DEFINE_BOOL(grpc_not_use_system_ssl_roots, false,
                               "Disable loading system root certificates.");
+
+/** Config variable for the number of peer certificate chains whose
+    verification outcome and peer properties are cached by each SSL handshaker
+    factory. Caching is disabled when it is not positive. */
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_ssl_cert_cache_size, 0,
+    "Number of peer certificate chains cached by each SSL handshaker factory. "
+    "0 disables the cache.");
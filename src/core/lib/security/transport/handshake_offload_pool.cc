@@ -0,0 +1,119 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/security/transport/handshake_offload_pool.h"
+
+#include <algorithm>
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/executor.h"
+
+namespace grpc_core {
+
+class HandshakeOffloadPool::Step {
+ public:
+  Step(HandshakeOffloadPool* pool, grpc_closure* closure)
+      : pool_(pool),
+        closure_(closure),
+        enqueue_time_(gpr_now(GPR_CLOCK_MONOTONIC)) {
+    GRPC_CLOSURE_INIT(&run_, &Step::RunFn, this, nullptr);
+  }
+
+  grpc_closure* run_closure() { return &run_; }
+
+ private:
+  static void RunFn(void* arg, grpc_error_handle /*error*/) {
+    Step* self = static_cast<Step*>(arg);
+    GRPC_STATS_INC_HANDSHAKE_OFFLOAD_QUEUE_DELAY_US(gpr_timespec_to_micros(
+        gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), self->enqueue_time_)));
+    HandshakeOffloadPool* pool = self->pool_;
+    grpc_closure* closure = self->closure_;
+    delete self;
+    Closure::Run(DEBUG_LOCATION, closure, GRPC_ERROR_NONE);
+    pool->Finish();
+  }
+
+  HandshakeOffloadPool* pool_;
+  grpc_closure* closure_;
+  gpr_timespec enqueue_time_;
+  grpc_closure run_;
+};
+
+HandshakeOffloadPool* HandshakeOffloadPool::Get() {
+  static HandshakeOffloadPool* pool =
+      new HandshakeOffloadPool(gpr_cpu_num_cores());
+  return pool;
+}
+
+HandshakeOffloadPool::HandshakeOffloadPool(size_t max_concurrency)
+    : max_concurrency_(std::max<size_t>(max_concurrency, 1)) {}
+
+bool HandshakeOffloadPool::Run(grpc_closure* closure, bool high_priority,
+                               size_t max_queued) {
+  Step* step;
+  {
+    MutexLock lock(&mu_);
+    if (high_priority_queue_.size() + queue_.size() >= max_queued) {
+      GRPC_STATS_INC_HANDSHAKE_OFFLOAD_REJECTED();
+      return false;
+    }
+    GRPC_STATS_INC_HANDSHAKE_OFFLOAD_SCHEDULED();
+    step = new Step(this, closure);
+    if (running_ >= max_concurrency_) {
+      (high_priority ? high_priority_queue_ : queue_).push_back(step);
+      return true;
+    }
+    ++running_;
+  }
+  Start(step);
+  return true;
+}
+
+size_t HandshakeOffloadPool::queued() {
+  MutexLock lock(&mu_);
+  return high_priority_queue_.size() + queue_.size();
+}
+
+void HandshakeOffloadPool::Start(Step* step) {
+  Executor::Run(step->run_closure(), GRPC_ERROR_NONE, ExecutorType::DEFAULT,
+                ExecutorJobType::LONG);
+}
+
+void HandshakeOffloadPool::Finish() {
+  Step* next = nullptr;
+  {
+    MutexLock lock(&mu_);
+    std::deque<Step*>* queue =
+        !high_priority_queue_.empty() ? &high_priority_queue_ : &queue_;
+    if (queue->empty()) {
+      --running_;
+      return;
+    }
+    next = queue->front();
+    queue->pop_front();
+  }
+  Start(next);
+}
+
+}  // namespace grpc_core
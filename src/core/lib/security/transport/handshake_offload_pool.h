@@ -0,0 +1,82 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_SECURITY_TRANSPORT_HANDSHAKE_OFFLOAD_POOL_H
+#define GRPC_CORE_LIB_SECURITY_TRANSPORT_HANDSHAKE_OFFLOAD_POOL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <deque>
+#include <limits>
+
+#include "absl/base/thread_annotations.h"
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+
+namespace grpc_core {
+
+/// Runs TSI handshake steps, which may verify certificates and perform private
+/// key operations, on the executor instead of on the polling thread that
+/// received the handshake bytes.
+///
+/// At most \a max_concurrency steps run at a time. Queued high priority steps
+/// (steps of handshakes that resume a session, or of handshakes that are
+/// already under way) start before other steps. Steps can be shed when too
+/// many are already waiting, so that a reconnect storm is rejected early
+/// instead of delaying every handshake.
+class HandshakeOffloadPool {
+ public:
+  /// Returns the process-wide pool, which runs one step per CPU core.
+  static HandshakeOffloadPool* Get();
+
+  explicit HandshakeOffloadPool(size_t max_concurrency);
+
+  HandshakeOffloadPool(const HandshakeOffloadPool&) = delete;
+  HandshakeOffloadPool& operator=(const HandshakeOffloadPool&) = delete;
+
+  /// Schedules \a closure. Returns false, without scheduling it, if
+  /// \a max_queued steps are already waiting for the pool.
+  /// The pool counts \a closure as running until it returns, so it must do its
+  /// work synchronously.
+  bool Run(grpc_closure* closure, bool high_priority,
+           size_t max_queued = std::numeric_limits<size_t>::max());
+
+  /// Number of steps waiting for the pool.
+  size_t queued();
+
+ private:
+  class Step;
+
+  // Starts step on the executor.
+  static void Start(Step* step);
+  // Called when a step is done; starts the next queued step, if any.
+  void Finish();
+
+  const size_t max_concurrency_;
+  Mutex mu_;
+  size_t running_ ABSL_GUARDED_BY(mu_) = 0;
+  std::deque<Step*> high_priority_queue_ ABSL_GUARDED_BY(mu_);
+  std::deque<Step*> queue_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_SECURITY_TRANSPORT_HANDSHAKE_OFFLOAD_POOL_H */
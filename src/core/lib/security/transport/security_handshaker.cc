@@ -32,8 +32,11 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/security/context/security_context.h"
+#include "src/core/lib/security/transport/handshake_offload_pool.h"
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/security/transport/tsi_error.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -41,6 +44,7 @@
 #include "src/core/tsi/transport_security_grpc.h"
 
 #define GRPC_INITIAL_HANDSHAKE_BUFFER_SIZE 256
+#define GRPC_DEFAULT_HANDSHAKE_OFFLOAD_MAX_PENDING 1024
 
 namespace grpc_core {
 
@@ -61,6 +65,9 @@ class SecurityHandshaker : public Handshaker {
  private:
   grpc_error_handle DoHandshakerNextLocked(const unsigned char* bytes_received,
                                            size_t bytes_received_size);
+  grpc_error_handle CallHandshakerNextLocked(
+      const unsigned char* bytes_received, size_t bytes_received_size);
+  grpc_error_handle OffloadHandshakerNextLocked(size_t bytes_received_size);
 
   grpc_error_handle OnHandshakeNextDoneLocked(
       tsi_result result, const unsigned char* bytes_to_send,
@@ -75,6 +82,7 @@ class SecurityHandshaker : public Handshaker {
       void* arg, grpc_error_handle error);
   static void OnHandshakeDataSentToPeerFnScheduler(void* arg,
                                                    grpc_error_handle error);
+  static void OnHandshakerNextOffloadedFn(void* arg, grpc_error_handle error);
   static void OnHandshakeNextDoneGrpcWrapper(
       tsi_result result, void* user_data, const unsigned char* bytes_to_send,
       size_t bytes_to_send_size, tsi_handshaker_result* handshaker_result);
@@ -82,6 +90,7 @@ class SecurityHandshaker : public Handshaker {
   void OnPeerCheckedInner(grpc_error_handle error);
   size_t MoveReadBufferIntoHandshakeBuffer();
   grpc_error_handle CheckPeerLocked();
+  grpc_error_handle MaybeOffloadRecordProtectionLocked(bool* offloaded);
 
   // State set at creation time.
   tsi_handshaker* handshaker_;
@@ -107,6 +116,13 @@ class SecurityHandshaker : public Handshaker {
   RefCountedPtr<grpc_auth_context> auth_context_;
   tsi_handshaker_result* handshaker_result_ = nullptr;
   size_t max_frame_size_ = 0;
+  bool kernel_tls_offload_ = false;
+  // Handshake offload state.
+  bool handshake_offload_ = false;
+  size_t handshake_offload_max_pending_;
+  bool handshake_offload_admitted_ = false;
+  size_t offloaded_bytes_size_ = 0;
+  grpc_closure on_handshaker_next_offloaded_;
 };
 
 SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
@@ -119,7 +135,15 @@ SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
           static_cast<uint8_t*>(gpr_malloc(handshake_buffer_size_))),
       max_frame_size_(grpc_channel_args_find_integer(
           args, GRPC_ARG_TSI_MAX_FRAME_SIZE,
-          {0, 0, std::numeric_limits<int>::max()})) {
+          {0, 0, std::numeric_limits<int>::max()})),
+      kernel_tls_offload_(grpc_channel_args_find_bool(
+          args, GRPC_ARG_TSI_KERNEL_TLS_OFFLOAD, false)),
+      handshake_offload_(grpc_channel_args_find_bool(
+          args, GRPC_ARG_TSI_HANDSHAKE_OFFLOAD, false)),
+      handshake_offload_max_pending_(grpc_channel_args_find_integer(
+          args, GRPC_ARG_TSI_HANDSHAKE_OFFLOAD_MAX_PENDING,
+          {GRPC_DEFAULT_HANDSHAKE_OFFLOAD_MAX_PENDING, 0,
+           std::numeric_limits<int>::max()})) {
   grpc_slice_buffer_init(&outgoing_);
   GRPC_CLOSURE_INIT(&on_peer_checked_, &SecurityHandshaker::OnPeerCheckedFn,
                     this, grpc_schedule_on_exec_ctx);
@@ -223,6 +247,36 @@ MakeChannelzSecurityFromAuthContext(grpc_auth_context* auth_context) {
 
 }  // namespace
 
+// If enabled, try to have the kernel protect records on the underlying socket
+// instead of wrapping the endpoint in a secure endpoint.
+grpc_error_handle SecurityHandshaker::MaybeOffloadRecordProtectionLocked(
+    bool* offloaded) {
+  *offloaded = false;
+  if (!kernel_tls_offload_) return GRPC_ERROR_NONE;
+  int fd = grpc_endpoint_get_fd(args_->endpoint);
+  if (fd < 0) return GRPC_ERROR_NONE;
+  tsi_result result =
+      tsi_handshaker_result_offload_record_protection(handshaker_result_, fd);
+  switch (result) {
+    case TSI_OK:
+      *offloaded = true;
+      return GRPC_ERROR_NONE;
+    case TSI_UNIMPLEMENTED:
+    case TSI_FAILED_PRECONDITION:
+      // Nothing changed on the socket, so fall back to a frame protector.
+      gpr_log(GPR_DEBUG,
+              "Kernel TLS offload not possible for %s (%s), using userspace "
+              "frame protection",
+              std::string(grpc_endpoint_get_peer(args_->endpoint)).c_str(),
+              tsi_result_to_string(result));
+      return GRPC_ERROR_NONE;
+    default:
+      return grpc_set_tsi_error_result(
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("Kernel TLS offload failed"),
+          result);
+  }
+}
+
 void SecurityHandshaker::OnPeerCheckedInner(grpc_error_handle error) {
   MutexLock lock(&mu_);
   if (error != GRPC_ERROR_NONE || is_shutdown_) {
@@ -241,10 +295,22 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error_handle error) {
         result));
     return;
   }
+  // Check whether the kernel can protect records for us. This is only possible
+  // when there are no unused bytes left to unprotect in userspace.
+  bool kernel_tls_offloaded = false;
+  if (unused_bytes_size == 0) {
+    error = MaybeOffloadRecordProtectionLocked(&kernel_tls_offloaded);
+    if (error != GRPC_ERROR_NONE) {
+      HandshakeFailedLocked(error);
+      return;
+    }
+  }
   // Check whether we need to wrap the endpoint.
-  tsi_frame_protector_type frame_protector_type;
-  result = tsi_handshaker_result_get_frame_protector_type(
-      handshaker_result_, &frame_protector_type);
+  tsi_frame_protector_type frame_protector_type = TSI_FRAME_PROTECTOR_NONE;
+  if (!kernel_tls_offloaded) {
+    result = tsi_handshaker_result_get_frame_protector_type(
+        handshaker_result_, &frame_protector_type);
+  }
   if (result != TSI_OK) {
     HandshakeFailedLocked(grpc_set_tsi_error_result(
         GRPC_ERROR_CREATE_FROM_STATIC_STRING(
@@ -317,8 +383,9 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error_handle error) {
       grpc_auth_context_to_arg(auth_context_.get()),
   };
   RefCountedPtr<channelz::SocketNode::Security> channelz_security;
-  // Add channelz channel args only if frame protector is created.
-  if (has_frame_protector) {
+  // Add channelz channel args only if frame protector is created or the kernel
+  // protects records.
+  if (has_frame_protector || kernel_tls_offloaded) {
     channelz_security =
         MakeChannelzSecurityFromAuthContext(auth_context_.get());
     args_to_add.push_back(channelz_security->MakeChannelArg());
@@ -427,6 +494,66 @@ void SecurityHandshaker::OnHandshakeNextDoneGrpcWrapper(
 
 grpc_error_handle SecurityHandshaker::DoHandshakerNextLocked(
     const unsigned char* bytes_received, size_t bytes_received_size) {
+  // Steps without received bytes only hand out what the TSI handshaker has
+  // already prepared, so they are cheap enough to run inline.
+  if (handshake_offload_ && bytes_received_size > 0) {
+    GPR_ASSERT(bytes_received == handshake_buffer_);
+    return OffloadHandshakerNextLocked(bytes_received_size);
+  }
+  return CallHandshakerNextLocked(bytes_received, bytes_received_size);
+}
+
+// Schedules the next TSI handshaker step on the handshake offload pool. The
+// first offloaded step of a handshake is rejected if too many steps are
+// already waiting. Once admitted, the remaining steps of the handshake are
+// never rejected and run before those of new handshakes.
+grpc_error_handle SecurityHandshaker::OffloadHandshakerNextLocked(
+    size_t bytes_received_size) {
+  offloaded_bytes_size_ = bytes_received_size;
+  GRPC_CLOSURE_INIT(&on_handshaker_next_offloaded_,
+                    &SecurityHandshaker::OnHandshakerNextOffloadedFn, this,
+                    nullptr);
+  if (handshake_offload_admitted_) {
+    HandshakeOffloadPool::Get()->Run(&on_handshaker_next_offloaded_,
+                                     /*high_priority=*/true);
+    return GRPC_ERROR_NONE;
+  }
+  // Resumed sessions skip most of the expensive crypto, so favor them.
+  bool is_resumption = false;
+  tsi_handshaker_is_resumption(handshaker_, handshake_buffer_,
+                               bytes_received_size, &is_resumption);
+  if (!HandshakeOffloadPool::Get()->Run(&on_handshaker_next_offloaded_,
+                                        is_resumption,
+                                        handshake_offload_max_pending_)) {
+    return grpc_error_set_int(
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Handshake rejected: too many pending handshakes"),
+        GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_RESOURCE_EXHAUSTED);
+  }
+  if (is_resumption) GRPC_STATS_INC_HANDSHAKE_OFFLOAD_RESUMED_SCHEDULED();
+  handshake_offload_admitted_ = true;
+  return GRPC_ERROR_NONE;
+}
+
+void SecurityHandshaker::OnHandshakerNextOffloadedFn(
+    void* arg, grpc_error_handle /*error*/) {
+  RefCountedPtr<SecurityHandshaker> h(static_cast<SecurityHandshaker*>(arg));
+  MutexLock lock(&h->mu_);
+  if (h->is_shutdown_) {
+    h->HandshakeFailedLocked(GRPC_ERROR_NONE);
+    return;
+  }
+  grpc_error_handle error = h->CallHandshakerNextLocked(
+      h->handshake_buffer_, h->offloaded_bytes_size_);
+  if (error != GRPC_ERROR_NONE) {
+    h->HandshakeFailedLocked(error);
+  } else {
+    h.release();  // Avoid unref
+  }
+}
+
+grpc_error_handle SecurityHandshaker::CallHandshakerNextLocked(
+    const unsigned char* bytes_received, size_t bytes_received_size) {
   // Invoke TSI handshaker.
   const unsigned char* bytes_to_send = nullptr;
   size_t bytes_to_send_size = 0;
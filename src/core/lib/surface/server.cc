@@ -139,6 +139,8 @@ struct Server::RegisteredMethod {
   const uint32_t flags;
   // One request matcher per method.
   std::unique_ptr<RequestMatcherInterface> matcher;
+  // Set when the server records per-method latency.
+  std::unique_ptr<MethodLatencyStats> latency_stats;
 };
 
 //
@@ -539,7 +541,10 @@ RefCountedPtr<channelz::ServerNode> CreateChannelzNode(ChannelArgs args) {
 }  // namespace
 
 Server::Server(ChannelArgs args)
-    : channel_args_(args.ToC()), channelz_node_(CreateChannelzNode(args)) {}
+    : channel_args_(args.ToC()),
+      channelz_node_(CreateChannelzNode(args)),
+      method_latency_stats_enabled_(
+          args.GetBool(GRPC_ARG_SERVER_METHOD_LATENCY_STATS).value_or(false)) {}
 
 Server::~Server() {
   grpc_channel_args_destroy(channel_args_);
@@ -579,6 +584,9 @@ void Server::Start() {
     if (rm->matcher == nullptr) {
       rm->matcher = absl::make_unique<RealRequestMatcher>(this);
     }
+    if (method_latency_stats_enabled_) {
+      rm->latency_stats = absl::make_unique<MethodLatencyStats>(rm->method);
+    }
   }
   {
     MutexLock lock(&mu_global_);
@@ -1183,7 +1191,10 @@ Server::CallData::CallData(grpc_call_element* elem,
                            RefCountedPtr<Server> server)
     : server_(std::move(server)),
       call_(grpc_call_from_top_element(elem)),
-      call_combiner_(args.call_combiner) {
+      call_combiner_(args.call_combiner),
+      call_start_(server_->method_latency_stats_enabled_
+                      ? gpr_get_cycle_counter()
+                      : grpc_stats_start_timer()) {
   GRPC_CLOSURE_INIT(&recv_initial_metadata_ready_, RecvInitialMetadataReady,
                     elem, grpc_schedule_on_exec_ctx);
   GRPC_CLOSURE_INIT(&recv_trailing_metadata_ready_, RecvTrailingMetadataReady,
@@ -1192,6 +1203,12 @@ Server::CallData::CallData(grpc_call_element* elem,
 
 Server::CallData::~CallData() {
   GPR_ASSERT(state_.load(std::memory_order_relaxed) != CallState::PENDING);
+  if (published_) {
+    GRPC_STATS_INC_SERVER_CALL_LATENCY_US(grpc_stats_micros_since(call_start_));
+    if (latency_stats_ != nullptr) {
+      latency_stats_->Record(grpc_stats_micros_since(call_start_));
+    }
+  }
   GRPC_ERROR_UNREF(recv_initial_metadata_error_);
   grpc_metadata_array_destroy(&initial_metadata_);
   grpc_byte_buffer_destroy(payload_);
@@ -1237,6 +1254,8 @@ void Server::CallData::Start(grpc_call_element* elem) {
 }
 
 void Server::CallData::Publish(size_t cq_idx, RequestedCall* rc) {
+  GRPC_STATS_INC_SERVER_QUEUE_WAIT_US(grpc_stats_micros_since(queued_at_));
+  published_ = true;
   grpc_call_set_completion_queue(call_, rc->cq_bound_to_call);
   *rc->call = call_;
   cq_new_ = server_->cqs_[cq_idx];
@@ -1278,6 +1297,7 @@ void Server::CallData::PublishNewRpc(void* arg, grpc_error_handle error) {
     calld->KillZombie();
     return;
   }
+  calld->queued_at_ = grpc_stats_start_timer();
   rm->MatchOrQueue(chand->cq_idx(), calld);
 }
 
@@ -1312,6 +1332,7 @@ void Server::CallData::StartNewRpc(grpc_call_element* elem) {
     if (rm != nullptr) {
       matcher_ = rm->server_registered_method->matcher.get();
       payload_handling = rm->server_registered_method->payload_handling;
+      latency_stats_ = rm->server_registered_method->latency_stats.get();
     }
   }
   // Start recv_message op if needed.
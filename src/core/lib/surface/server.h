@@ -46,7 +46,9 @@
 #include "src/core/lib/channel/channel_fwd.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/cpp_impl_of.h"
 #include "src/core/lib/gprpp/dual_ref_counted.h"
 #include "src/core/lib/gprpp/orphanable.h"
@@ -354,6 +356,13 @@ class Server : public InternallyRefCounted<Server>,
     grpc_closure publish_;
 
     CallCombiner* call_combiner_;
+
+    // When the call was created, and when it reached its request matcher.
+    // Read only when latency stats are recorded.
+    const gpr_cycle_counter call_start_;
+    gpr_cycle_counter queued_at_ = 0;
+    MethodLatencyStats* latency_stats_ = nullptr;
+    bool published_ = false;
   };
 
   struct Listener {
@@ -445,6 +454,7 @@ class Server : public InternallyRefCounted<Server>,
 
   const grpc_channel_args* const channel_args_;
   RefCountedPtr<channelz::ServerNode> channelz_node_;
+  const bool method_latency_stats_enabled_;
   std::unique_ptr<grpc_server_config_fetcher> config_fetcher_;
 
   std::vector<grpc_completion_queue*> cqs_;
@@ -260,7 +260,9 @@ static const tsi_handshaker_result_vtable result_vtable = {
     handshaker_result_create_zero_copy_grpc_protector,
     handshaker_result_create_frame_protector,
     handshaker_result_get_unused_bytes,
-    handshaker_result_destroy};
+    handshaker_result_destroy,
+    nullptr, /* handshaker_result_offload_record_protection */
+};
 
 tsi_result alts_tsi_handshaker_result_create(grpc_gcp_HandshakerResp* resp,
                                              bool is_client,
@@ -618,7 +620,8 @@ static const tsi_handshaker_vtable handshaker_vtable = {
     nullptr,         nullptr,
     nullptr,         nullptr,
     nullptr,         handshaker_destroy,
-    handshaker_next, handshaker_shutdown};
+    handshaker_next, handshaker_shutdown,
+    nullptr};
 
 static const tsi_handshaker_vtable handshaker_vtable_dedicated = {
     nullptr,
@@ -628,7 +631,8 @@ static const tsi_handshaker_vtable handshaker_vtable_dedicated = {
     nullptr,
     handshaker_destroy,
     handshaker_next_dedicated,
-    handshaker_shutdown};
+    handshaker_shutdown,
+    nullptr};
 
 bool alts_tsi_handshaker_has_shutdown(alts_tsi_handshaker* handshaker) {
   GPR_ASSERT(handshaker != nullptr);
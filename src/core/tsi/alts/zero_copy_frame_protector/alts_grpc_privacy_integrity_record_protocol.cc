@@ -115,10 +115,134 @@ static tsi_result alts_grpc_privacy_integrity_unprotect(
   return TSI_OK;
 }
 
+static tsi_result alts_grpc_privacy_integrity_protect_frames(
+    alts_grpc_record_protocol* rp, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_data_size, grpc_slice_buffer* protected_slices) {
+  /* Input sanity check.  */
+  if (rp == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr || max_unprotected_data_size == 0) {
+    gpr_log(GPR_ERROR,
+            "Invalid arguments to alts_grpc_record_protocol protect frames.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  /* Allocates a single buffer holding all protected frames, so that frames are
+   * sealed back to back without per-frame allocation or slice bookkeeping.  */
+  size_t data_length = unprotected_slices->length;
+  size_t num_frames =
+      std::max<size_t>(1, (data_length + max_unprotected_data_size - 1) /
+                              max_unprotected_data_size);
+  size_t frame_overhead = rp->header_length + rp->tag_length;
+  grpc_slice protected_slice =
+      GRPC_SLICE_MALLOC(data_length + num_frames * frame_overhead);
+  uint8_t* protected_frame = GRPC_SLICE_START_PTR(protected_slice);
+  size_t index = 0;
+  size_t offset = 0;
+  for (size_t i = 0; i < num_frames; i++) {
+    size_t frame_data_length = std::min(data_length, max_unprotected_data_size);
+    data_length -= frame_data_length;
+    size_t iovec_count =
+        alts_grpc_record_protocol_convert_slice_buffer_range_to_iovec(
+            rp, unprotected_slices, frame_data_length, &index, &offset);
+    iovec_t protected_iovec = {protected_frame,
+                               frame_data_length + frame_overhead};
+    /* Calls alts_iovec_record_protocol protect.  */
+    char* error_details = nullptr;
+    grpc_status_code status =
+        alts_iovec_record_protocol_privacy_integrity_protect(
+            rp->iovec_rp, rp->iovec_buf, iovec_count, protected_iovec,
+            &error_details);
+    if (status != GRPC_STATUS_OK) {
+      gpr_log(GPR_ERROR, "Failed to protect, %s", error_details);
+      gpr_free(error_details);
+      grpc_slice_unref_internal(protected_slice);
+      return TSI_INTERNAL_ERROR;
+    }
+    protected_frame += protected_iovec.iov_len;
+  }
+  GPR_ASSERT(protected_frame == GRPC_SLICE_END_PTR(protected_slice));
+  grpc_slice_buffer_add(protected_slices, protected_slice);
+  grpc_slice_buffer_reset_and_unref_internal(unprotected_slices);
+  return TSI_OK;
+}
+
+static tsi_result alts_grpc_privacy_integrity_unprotect_frames(
+    alts_grpc_record_protocol* rp, grpc_slice_buffer* protected_slices,
+    size_t num_frames, grpc_slice_buffer* unprotected_slices) {
+  /* Input sanity check.  */
+  if (rp == nullptr || protected_slices == nullptr ||
+      unprotected_slices == nullptr || num_frames == 0) {
+    gpr_log(GPR_ERROR,
+            "Invalid arguments to alts_grpc_record_protocol unprotect frames.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  size_t frame_overhead = rp->header_length + rp->tag_length;
+  if (protected_slices->length < num_frames * frame_overhead) {
+    gpr_log(GPR_ERROR, "Protected slices do not have sufficient data.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  /* Allocates a single buffer holding the unprotected data of all frames.  */
+  size_t unprotected_size =
+      protected_slices->length - num_frames * frame_overhead;
+  grpc_slice unprotected_slice = GRPC_SLICE_MALLOC(unprotected_size);
+  uint8_t* unprotected_data = GRPC_SLICE_START_PTR(unprotected_slice);
+  size_t remaining = protected_slices->length;
+  size_t index = 0;
+  size_t offset = 0;
+  for (size_t i = 0; i < num_frames; i++) {
+    if (remaining < rp->header_length) {
+      gpr_log(GPR_ERROR, "Failed to unprotect, truncated frame header.");
+      grpc_slice_unref_internal(unprotected_slice);
+      return TSI_DATA_CORRUPTED;
+    }
+    iovec_t header_iovec = alts_grpc_record_protocol_get_header_iovec_at(
+        rp, protected_slices, &index, &offset);
+    remaining -= rp->header_length;
+    size_t frame_data_length =
+        alts_grpc_record_protocol_get_frame_data_length(header_iovec);
+    if (frame_data_length < rp->tag_length || frame_data_length > remaining ||
+        frame_data_length - rp->tag_length >
+            static_cast<size_t>(GRPC_SLICE_END_PTR(unprotected_slice) -
+                                unprotected_data)) {
+      gpr_log(GPR_ERROR, "Failed to unprotect, bad frame length.");
+      grpc_slice_unref_internal(unprotected_slice);
+      return TSI_DATA_CORRUPTED;
+    }
+    remaining -= frame_data_length;
+    size_t iovec_count =
+        alts_grpc_record_protocol_convert_slice_buffer_range_to_iovec(
+            rp, protected_slices, frame_data_length, &index, &offset);
+    iovec_t unprotected_iovec = {unprotected_data,
+                                 frame_data_length - rp->tag_length};
+    /* Calls alts_iovec_record_protocol unprotect.  */
+    char* error_details = nullptr;
+    grpc_status_code status =
+        alts_iovec_record_protocol_privacy_integrity_unprotect(
+            rp->iovec_rp, header_iovec, rp->iovec_buf, iovec_count,
+            unprotected_iovec, &error_details);
+    if (status != GRPC_STATUS_OK) {
+      gpr_log(GPR_ERROR, "Failed to unprotect, %s", error_details);
+      gpr_free(error_details);
+      grpc_slice_unref_internal(unprotected_slice);
+      return TSI_INTERNAL_ERROR;
+    }
+    unprotected_data += unprotected_iovec.iov_len;
+  }
+  if (remaining != 0) {
+    gpr_log(GPR_ERROR, "Failed to unprotect, trailing bytes after last frame.");
+    grpc_slice_unref_internal(unprotected_slice);
+    return TSI_DATA_CORRUPTED;
+  }
+  grpc_slice_buffer_reset_and_unref_internal(protected_slices);
+  grpc_slice_buffer_add(unprotected_slices, unprotected_slice);
+  return TSI_OK;
+}
+
 static const alts_grpc_record_protocol_vtable
     alts_grpc_privacy_integrity_record_protocol_vtable = {
         alts_grpc_privacy_integrity_protect,
-        alts_grpc_privacy_integrity_unprotect, nullptr};
+        alts_grpc_privacy_integrity_unprotect, nullptr,
+        alts_grpc_privacy_integrity_protect_frames,
+        alts_grpc_privacy_integrity_unprotect_frames};
 
 tsi_result alts_grpc_privacy_integrity_record_protocol_create(
     gsec_aead_crypter* crypter, size_t overflow_size, bool is_client,
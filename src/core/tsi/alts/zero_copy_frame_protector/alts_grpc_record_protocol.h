@@ -68,6 +68,47 @@ tsi_result alts_grpc_record_protocol_unprotect(
     alts_grpc_record_protocol* self, grpc_slice_buffer* protected_slices,
     grpc_slice_buffer* unprotected_slices);
 
+/**
+ * This method splits unprotected data into as few frames as possible, each
+ * carrying at most max_unprotected_data_size bytes, and appends all protected
+ * frames to protected_slices. Implementations may seal all frames in a single
+ * pass into one output buffer. An empty input produces one empty frame. The
+ * input unprotected data slice buffer will be cleared, although the actual
+ * unprotected data bytes are not modified.
+ *
+ * - self: an alts_grpc_record_protocol instance.
+ * - unprotected_slices: the unprotected data to be protected.
+ * - max_unprotected_data_size: maximum unprotected data size of one frame, as
+ *   returned by alts_grpc_record_protocol_max_unprotected_data_size().
+ * - protected_slices: slice buffer where the protected frames are appended.
+ *
+ * This method returns TSI_OK in case of success or a specific error code in
+ * case of failure.
+ */
+tsi_result alts_grpc_record_protocol_protect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_data_size, grpc_slice_buffer* protected_slices);
+
+/**
+ * This method performs unprotect operation on num_frames consecutive full
+ * frames of protected data and appends unprotected data to unprotected_slices.
+ * Implementations may open all frames in a single pass into one output buffer.
+ * It is the caller's responsibility to make sure protected_slices contains
+ * exactly num_frames full frames. The input protected slice buffer will be
+ * cleared, although the actual protected data bytes are not modified.
+ *
+ * - self: an alts_grpc_record_protocol instance.
+ * - protected_slices: num_frames full frames of protected data in grpc slices.
+ * - num_frames: number of frames in protected_slices.
+ * - unprotected_slices: slice buffer where unprotected data is appended.
+ *
+ * This method returns TSI_OK in case of success or a specific error code in
+ * case of failure.
+ */
+tsi_result alts_grpc_record_protocol_unprotect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* protected_slices,
+    size_t num_frames, grpc_slice_buffer* unprotected_slices);
+
 /**
  * This method returns maximum allowed unprotected data size, given maximum
  * protected frame size.
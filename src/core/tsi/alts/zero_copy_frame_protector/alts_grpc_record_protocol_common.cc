@@ -57,6 +57,32 @@ void alts_grpc_record_protocol_convert_slice_buffer_to_iovec(
   }
 }
 
+size_t alts_grpc_record_protocol_convert_slice_buffer_range_to_iovec(
+    alts_grpc_record_protocol* rp, const grpc_slice_buffer* sb, size_t length,
+    size_t* index, size_t* offset) {
+  GPR_ASSERT(rp != nullptr && sb != nullptr);
+  GPR_ASSERT(index != nullptr && offset != nullptr);
+  ensure_iovec_buf_size(rp, sb);
+  size_t iovec_count = 0;
+  while (length > 0) {
+    GPR_ASSERT(*index < sb->count);
+    size_t slice_length = GRPC_SLICE_LENGTH(sb->slices[*index]);
+    if (*offset == slice_length) {
+      (*index)++;
+      *offset = 0;
+      continue;
+    }
+    size_t bytes = std::min(length, slice_length - *offset);
+    rp->iovec_buf[iovec_count].iov_base =
+        GRPC_SLICE_START_PTR(sb->slices[*index]) + *offset;
+    rp->iovec_buf[iovec_count].iov_len = bytes;
+    iovec_count++;
+    *offset += bytes;
+    length -= bytes;
+  }
+  return iovec_count;
+}
+
 void alts_grpc_record_protocol_copy_slice_buffer(const grpc_slice_buffer* src,
                                                  unsigned char* dst) {
   GPR_ASSERT(src != nullptr && dst != nullptr);
@@ -85,6 +111,47 @@ iovec_t alts_grpc_record_protocol_get_header_iovec(
   return header_iovec;
 }
 
+iovec_t alts_grpc_record_protocol_get_header_iovec_at(
+    alts_grpc_record_protocol* rp, const grpc_slice_buffer* sb, size_t* index,
+    size_t* offset) {
+  iovec_t header_iovec = {nullptr, 0};
+  if (rp == nullptr || sb == nullptr) {
+    return header_iovec;
+  }
+  size_t iovec_count =
+      alts_grpc_record_protocol_convert_slice_buffer_range_to_iovec(
+          rp, sb, rp->header_length, index, offset);
+  header_iovec.iov_len = rp->header_length;
+  if (iovec_count == 1) {
+    header_iovec.iov_base = rp->iovec_buf[0].iov_base;
+  } else {
+    /* Frame header spans multiple slices, copies the header bytes to a single
+     * flat buffer.  */
+    unsigned char* dst = rp->header_buf;
+    for (size_t i = 0; i < iovec_count; i++) {
+      memcpy(dst, rp->iovec_buf[i].iov_base, rp->iovec_buf[i].iov_len);
+      dst += rp->iovec_buf[i].iov_len;
+    }
+    header_iovec.iov_base = rp->header_buf;
+  }
+  return header_iovec;
+}
+
+size_t alts_grpc_record_protocol_get_frame_data_length(iovec_t header) {
+  GPR_ASSERT(header.iov_base != nullptr &&
+             header.iov_len >= kZeroCopyFrameLengthFieldSize);
+  const unsigned char* buf = static_cast<unsigned char*>(header.iov_base);
+  /* Frame length field is little-endian.  */
+  size_t frame_length = (static_cast<size_t>(buf[3]) << 24) |
+                        (static_cast<size_t>(buf[2]) << 16) |
+                        (static_cast<size_t>(buf[1]) << 8) |
+                        static_cast<size_t>(buf[0]);
+  if (frame_length < kZeroCopyFrameMessageTypeFieldSize) {
+    return 0;
+  }
+  return frame_length - kZeroCopyFrameMessageTypeFieldSize;
+}
+
 tsi_result alts_grpc_record_protocol_init(alts_grpc_record_protocol* rp,
                                           gsec_aead_crypter* crypter,
                                           size_t overflow_size, bool is_client,
@@ -148,6 +215,88 @@ tsi_result alts_grpc_record_protocol_unprotect(
   return self->vtable->unprotect(self, protected_slices, unprotected_slices);
 }
 
+tsi_result alts_grpc_record_protocol_protect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_data_size, grpc_slice_buffer* protected_slices) {
+  if (grpc_core::ExecCtx::Get() == nullptr || self == nullptr ||
+      self->vtable == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr || max_unprotected_data_size == 0) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  if (self->vtable->protect_frames != nullptr) {
+    return self->vtable->protect_frames(self, unprotected_slices,
+                                        max_unprotected_data_size,
+                                        protected_slices);
+  }
+  if (self->vtable->protect == nullptr) {
+    return TSI_UNIMPLEMENTED;
+  }
+  /* Protects one frame at a time.  */
+  grpc_slice_buffer frame_sb;
+  grpc_slice_buffer_init(&frame_sb);
+  tsi_result result = TSI_OK;
+  while (result == TSI_OK &&
+         unprotected_slices->length > max_unprotected_data_size) {
+    grpc_slice_buffer_move_first(unprotected_slices, max_unprotected_data_size,
+                                 &frame_sb);
+    result = self->vtable->protect(self, &frame_sb, protected_slices);
+  }
+  if (result == TSI_OK) {
+    result = self->vtable->protect(self, unprotected_slices, protected_slices);
+  }
+  grpc_slice_buffer_destroy_internal(&frame_sb);
+  return result;
+}
+
+tsi_result alts_grpc_record_protocol_unprotect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* protected_slices,
+    size_t num_frames, grpc_slice_buffer* unprotected_slices) {
+  if (grpc_core::ExecCtx::Get() == nullptr || self == nullptr ||
+      self->vtable == nullptr || protected_slices == nullptr ||
+      unprotected_slices == nullptr || num_frames == 0) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  if (self->vtable->unprotect_frames != nullptr) {
+    return self->vtable->unprotect_frames(self, protected_slices, num_frames,
+                                          unprotected_slices);
+  }
+  if (self->vtable->unprotect == nullptr) {
+    return TSI_UNIMPLEMENTED;
+  }
+  /* Unprotects one frame at a time.  */
+  grpc_slice_buffer frame_sb;
+  grpc_slice_buffer_init(&frame_sb);
+  tsi_result result = TSI_OK;
+  for (size_t i = 0; result == TSI_OK && i + 1 < num_frames; i++) {
+    if (protected_slices->length < self->header_length) {
+      result = TSI_DATA_CORRUPTED;
+      break;
+    }
+    size_t index = 0;
+    size_t offset = 0;
+    size_t frame_size =
+        self->header_length +
+        alts_grpc_record_protocol_get_frame_data_length(
+            alts_grpc_record_protocol_get_header_iovec_at(
+                self, protected_slices, &index, &offset));
+    if (frame_size > protected_slices->length) {
+      result = TSI_DATA_CORRUPTED;
+      break;
+    }
+    grpc_slice_buffer_reset_and_unref_internal(&frame_sb);
+    grpc_slice_buffer_move_first(protected_slices, frame_size, &frame_sb);
+    result = self->vtable->unprotect(self, &frame_sb, unprotected_slices);
+  }
+  if (result == TSI_OK) {
+    result =
+        self->vtable->unprotect(self, protected_slices, unprotected_slices);
+  } else {
+    grpc_slice_buffer_reset_and_unref_internal(protected_slices);
+  }
+  grpc_slice_buffer_destroy_internal(&frame_sb);
+  return result;
+}
+
 void alts_grpc_record_protocol_destroy(alts_grpc_record_protocol* self) {
   if (self == nullptr) {
     return;
@@ -39,6 +39,16 @@ struct alts_grpc_record_protocol_vtable {
                           grpc_slice_buffer* protected_slices,
                           grpc_slice_buffer* unprotected_slices);
   void (*destruct)(alts_grpc_record_protocol* self);
+  /* Optional multi-frame operations. If nullptr, they are emulated by calling
+   * protect and unprotect once per frame.  */
+  tsi_result (*protect_frames)(alts_grpc_record_protocol* self,
+                               grpc_slice_buffer* unprotected_slices,
+                               size_t max_unprotected_data_size,
+                               grpc_slice_buffer* protected_slices);
+  tsi_result (*unprotect_frames)(alts_grpc_record_protocol* self,
+                                 grpc_slice_buffer* protected_slices,
+                                 size_t num_frames,
+                                 grpc_slice_buffer* unprotected_slices);
 };
 /* Main struct for alts_grpc_record_protocol implementation, shared by both
  * integrity-only record protocol and privacy-integrity record protocol.
@@ -63,6 +73,16 @@ struct alts_grpc_record_protocol {
 void alts_grpc_record_protocol_convert_slice_buffer_to_iovec(
     alts_grpc_record_protocol* rp, const grpc_slice_buffer* sb);
 
+/**
+ * Converts length bytes of input sb, starting at byte *offset of slice
+ * *index, into iovec_t's and puts the result into rp->iovec_buf. On return,
+ * *index and *offset point to the first byte after the converted range. Only
+ * pointers and lengths are copied. Returns the number of iovec_t's written.
+ */
+size_t alts_grpc_record_protocol_convert_slice_buffer_range_to_iovec(
+    alts_grpc_record_protocol* rp, const grpc_slice_buffer* sb, size_t length,
+    size_t* index, size_t* offset);
+
 /**
  * Copies bytes from slice buffer to destination buffer. Caller is responsible
  * for allocating enough memory of destination buffer. This method is used for
@@ -81,6 +101,24 @@ void alts_grpc_record_protocol_copy_slice_buffer(const grpc_slice_buffer* src,
 iovec_t alts_grpc_record_protocol_get_header_iovec(
     alts_grpc_record_protocol* rp);
 
+/**
+ * Same as alts_grpc_record_protocol_get_header_iovec, but for a frame header
+ * stored in input sb at byte *offset of slice *index. On return, *index and
+ * *offset point to the first byte after the frame header. The caller needs to
+ * make sure sb has enough bytes left for a frame header.
+ */
+iovec_t alts_grpc_record_protocol_get_header_iovec_at(
+    alts_grpc_record_protocol* rp, const grpc_slice_buffer* sb, size_t* index,
+    size_t* offset);
+
+/**
+ * Returns the number of bytes following the frame header, i.e. the protected
+ * data plus tag length, as announced by the frame length field of the frame
+ * header pointed to by header. Returns zero if the frame length field is too
+ * small to hold a message type.
+ */
+size_t alts_grpc_record_protocol_get_frame_data_length(iovec_t header);
+
 /**
  * Initializes an alts_grpc_record_protocol object, given a gsec_aead_crypter
  * instance, the overflow size of the counter in bytes, a flag indicating if the
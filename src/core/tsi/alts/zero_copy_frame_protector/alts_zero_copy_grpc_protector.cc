@@ -36,7 +36,7 @@
 #include "src/core/tsi/transport_security_grpc.h"
 
 constexpr size_t kMinFrameLength = 1024;
-constexpr size_t kDefaultFrameLength = 16 * 1024;
+constexpr size_t kDefaultFrameLength = 64 * 1024;
 constexpr size_t kMaxFrameLength = 16 * 1024 * 1024;
 
 /**
@@ -52,7 +52,6 @@ typedef struct alts_zero_copy_grpc_protector {
   alts_grpc_record_protocol* unrecord_protocol;
   size_t max_protected_frame_size;
   size_t max_unprotected_data_size;
-  grpc_slice_buffer unprotected_staging_sb;
   grpc_slice_buffer protected_sb;
   grpc_slice_buffer protected_staging_sb;
   uint32_t parsed_frame_size;
@@ -156,20 +155,10 @@ static tsi_result alts_zero_copy_grpc_protector_protect(
   }
   alts_zero_copy_grpc_protector* protector =
       reinterpret_cast<alts_zero_copy_grpc_protector*>(self);
-  /* Calls alts_grpc_record_protocol protect repeatly.  */
-  while (unprotected_slices->length > protector->max_unprotected_data_size) {
-    grpc_slice_buffer_move_first(unprotected_slices,
-                                 protector->max_unprotected_data_size,
-                                 &protector->unprotected_staging_sb);
-    tsi_result status = alts_grpc_record_protocol_protect(
-        protector->record_protocol, &protector->unprotected_staging_sb,
-        protected_slices);
-    if (status != TSI_OK) {
-      return status;
-    }
-  }
-  return alts_grpc_record_protocol_protect(
-      protector->record_protocol, unprotected_slices, protected_slices);
+  /* Seals all frames of this write in one pass.  */
+  return alts_grpc_record_protocol_protect_frames(
+      protector->record_protocol, unprotected_slices,
+      protector->max_unprotected_data_size, protected_slices);
 }
 
 static tsi_result alts_zero_copy_grpc_protector_unprotect(
@@ -184,38 +173,45 @@ static tsi_result alts_zero_copy_grpc_protector_unprotect(
   alts_zero_copy_grpc_protector* protector =
       reinterpret_cast<alts_zero_copy_grpc_protector*>(self);
   grpc_slice_buffer_move_into(protected_slices, &protector->protected_sb);
-  /* Keep unprotecting each frame if possible.  */
+  /* Collects every complete frame into protected_staging_sb.  */
+  size_t num_frames = 0;
   while (protector->protected_sb.length >= kZeroCopyFrameLengthFieldSize) {
     if (protector->parsed_frame_size == 0) {
       /* We have not parsed frame size yet. Parses frame size.  */
       if (!read_frame_size(&protector->protected_sb,
                            &protector->parsed_frame_size)) {
         grpc_slice_buffer_reset_and_unref_internal(&protector->protected_sb);
+        grpc_slice_buffer_reset_and_unref_internal(
+            &protector->protected_staging_sb);
         return TSI_DATA_CORRUPTED;
       }
     }
     if (protector->protected_sb.length < protector->parsed_frame_size) break;
     /* At this point, protected_sb contains at least one frame of data.  */
-    tsi_result status;
     if (protector->protected_sb.length == protector->parsed_frame_size) {
-      status = alts_grpc_record_protocol_unprotect(protector->unrecord_protocol,
-                                                   &protector->protected_sb,
-                                                   unprotected_slices);
+      grpc_slice_buffer_move_into(&protector->protected_sb,
+                                  &protector->protected_staging_sb);
     } else {
       grpc_slice_buffer_move_first(&protector->protected_sb,
                                    protector->parsed_frame_size,
                                    &protector->protected_staging_sb);
-      status = alts_grpc_record_protocol_unprotect(
-          protector->unrecord_protocol, &protector->protected_staging_sb,
-          unprotected_slices);
     }
     protector->parsed_frame_size = 0;
-    if (status != TSI_OK) {
-      grpc_slice_buffer_reset_and_unref_internal(&protector->protected_sb);
-      return status;
-    }
+    num_frames++;
   }
-  return TSI_OK;
+  if (num_frames == 0) {
+    return TSI_OK;
+  }
+  /* Opens all complete frames in one pass.  */
+  tsi_result status = alts_grpc_record_protocol_unprotect_frames(
+      protector->unrecord_protocol, &protector->protected_staging_sb,
+      num_frames, unprotected_slices);
+  if (status != TSI_OK) {
+    grpc_slice_buffer_reset_and_unref_internal(&protector->protected_sb);
+    grpc_slice_buffer_reset_and_unref_internal(
+        &protector->protected_staging_sb);
+  }
+  return status;
 }
 
 static void alts_zero_copy_grpc_protector_destroy(
@@ -227,7 +223,6 @@ static void alts_zero_copy_grpc_protector_destroy(
       reinterpret_cast<alts_zero_copy_grpc_protector*>(self);
   alts_grpc_record_protocol_destroy(protector->record_protocol);
   alts_grpc_record_protocol_destroy(protector->unrecord_protocol);
-  grpc_slice_buffer_destroy_internal(&protector->unprotected_staging_sb);
   grpc_slice_buffer_destroy_internal(&protector->protected_sb);
   grpc_slice_buffer_destroy_internal(&protector->protected_staging_sb);
   gpr_free(protector);
@@ -289,7 +284,6 @@ tsi_result alts_zero_copy_grpc_protector_create(
               impl->record_protocol, max_protected_frame_size_to_set);
       GPR_ASSERT(impl->max_unprotected_data_size > 0);
       /* Allocates internal slice buffers.  */
-      grpc_slice_buffer_init(&impl->unprotected_staging_sb);
       grpc_slice_buffer_init(&impl->protected_sb);
       grpc_slice_buffer_init(&impl->protected_staging_sb);
       impl->parsed_frame_size = 0;
@@ -563,6 +563,7 @@ static const tsi_handshaker_result_vtable handshaker_result_vtable = {
     fake_handshaker_result_create_frame_protector,
     fake_handshaker_result_get_unused_bytes,
     fake_handshaker_result_destroy,
+    nullptr, /* offload_record_protection */
 };
 
 static tsi_result fake_handshaker_result_create(
@@ -761,6 +762,7 @@ static const tsi_handshaker_vtable handshaker_vtable = {
     fake_handshaker_destroy,
     fake_handshaker_next,
     nullptr, /* shutdown */
+    nullptr, /* is_resumption */
 };
 
 tsi_handshaker* tsi_create_fake_handshaker(int is_client) {
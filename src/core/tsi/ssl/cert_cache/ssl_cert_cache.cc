@@ -0,0 +1,123 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/tsi/ssl/cert_cache/ssl_cert_cache.h"
+
+#include <algorithm>
+
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+namespace tsi {
+
+namespace {
+
+int64_t NowSeconds() {
+  return static_cast<int64_t>(gpr_now(GPR_CLOCK_REALTIME).tv_sec);
+}
+
+}  // namespace
+
+constexpr int64_t SslCertCache::kMaxVerificationLifetimeSeconds;
+
+SslCertCache::SslCertCache(size_t capacity) : capacity_(capacity) {
+  GPR_ASSERT(capacity > 0);
+}
+
+size_t SslCertCache::Size() {
+  grpc_core::MutexLock lock(&mu_);
+  return entries_.size();
+}
+
+SslCertCache::Entry* SslCertCache::FindLocked(const std::string& fingerprint) {
+  auto it = entry_by_fingerprint_.find(fingerprint);
+  if (it == entry_by_fingerprint_.end()) {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return &entries_.front();
+}
+
+SslCertCache::Entry* SslCertCache::FindOrAddLocked(
+    const std::string& fingerprint) {
+  Entry* entry = FindLocked(fingerprint);
+  if (entry != nullptr) {
+    return entry;
+  }
+  if (entries_.size() >= capacity_) {
+    entry_by_fingerprint_.erase(entries_.back().fingerprint);
+    entries_.pop_back();
+  }
+  entries_.emplace_front(fingerprint);
+  entry_by_fingerprint_.emplace(fingerprint, entries_.begin());
+  return &entries_.front();
+}
+
+bool SslCertCache::GetVerification(const std::string& fingerprint,
+                                   int* verify_error) {
+  grpc_core::MutexLock lock(&mu_);
+  Entry* entry = FindLocked(fingerprint);
+  if (entry == nullptr || !entry->has_verification ||
+      entry->verification_expiration <= NowSeconds()) {
+    stats_.misses++;
+    return false;
+  }
+  stats_.hits++;
+  *verify_error = entry->verify_error;
+  return true;
+}
+
+void SslCertCache::PutVerification(const std::string& fingerprint,
+                                   int verify_error, int64_t expiration) {
+  grpc_core::MutexLock lock(&mu_);
+  Entry* entry = FindOrAddLocked(fingerprint);
+  entry->has_verification = true;
+  entry->verify_error = verify_error;
+  entry->verification_expiration = std::min(
+      expiration, NowSeconds() + kMaxVerificationLifetimeSeconds);
+}
+
+bool SslCertCache::GetPeerProperties(const std::string& fingerprint,
+                                     PeerProperties* properties) {
+  grpc_core::MutexLock lock(&mu_);
+  Entry* entry = FindLocked(fingerprint);
+  if (entry == nullptr || !entry->has_peer_properties) {
+    stats_.misses++;
+    return false;
+  }
+  stats_.hits++;
+  *properties = entry->peer_properties;
+  return true;
+}
+
+void SslCertCache::PutPeerProperties(const std::string& fingerprint,
+                                     PeerProperties properties) {
+  grpc_core::MutexLock lock(&mu_);
+  Entry* entry = FindOrAddLocked(fingerprint);
+  entry->has_peer_properties = true;
+  entry->peer_properties = std::move(properties);
+}
+
+SslCertCache::Stats SslCertCache::GetStats() {
+  grpc_core::MutexLock lock(&mu_);
+  return stats_;
+}
+
+}  // namespace tsi
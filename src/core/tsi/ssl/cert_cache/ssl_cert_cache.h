@@ -0,0 +1,144 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_TSI_SSL_CERT_CACHE_SSL_CERT_CACHE_H
+#define GRPC_CORE_TSI_SSL_CERT_CACHE_SSL_CERT_CACHE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+
+/// Cache of what handshakes learn from the certificate chains their peers
+/// present, so that connections presenting the same chain do not process it
+/// again.
+///
+/// Chains are identified by a fingerprint computed by the caller, typically the
+/// digests of all the certificates of the chain. For each chain, the cache
+/// keeps the outcome of verifying it, which expires, and the peer properties
+/// extracted from it.
+///
+/// Verification outcomes are only meaningful for the root certificates the
+/// chain was verified against, so a cache must not outlive them: handshaker
+/// factories own their cache, and a new factory, with an empty cache, is
+/// created whenever the root certificates change.
+///
+/// Least recently used chains are evicted once capacity is reached.
+///
+/// This class is thread safe.
+
+namespace tsi {
+
+class SslCertCache : public grpc_core::RefCounted<SslCertCache> {
+ public:
+  /// Peer properties extracted from a chain, as (name, value) pairs.
+  using PeerProperties = std::vector<std::pair<std::string, std::string>>;
+
+  /// Verification outcomes are kept for at most this many seconds, so that
+  /// changes in how chains are verified (e.g. newly revoked intermediates)
+  /// eventually apply to all connections.
+  static constexpr int64_t kMaxVerificationLifetimeSeconds = 600;
+
+  struct Stats {
+    /// Number of lookups that found what they were looking for.
+    uint64_t hits = 0;
+    /// Number of lookups that did not.
+    uint64_t misses = 0;
+  };
+
+  /// Create new cache with the given capacity.
+  static grpc_core::RefCountedPtr<SslCertCache> Create(size_t capacity) {
+    return grpc_core::MakeRefCounted<SslCertCache>(capacity);
+  }
+
+  // Use Create function instead of using this directly.
+  explicit SslCertCache(size_t capacity);
+
+  // Not copyable nor movable.
+  SslCertCache(const SslCertCache&) = delete;
+  SslCertCache& operator=(const SslCertCache&) = delete;
+
+  /// Returns current number of chains in the cache.
+  size_t Size();
+
+  /// Looks up the outcome of verifying the chain with \a fingerprint. Returns
+  /// false if it is unknown or expired; otherwise sets \a verify_error to the
+  /// X509_V_* code of the verification, X509_V_OK if it succeeded.
+  bool GetVerification(const std::string& fingerprint, int* verify_error);
+  /// Records the outcome of verifying the chain with \a fingerprint. It
+  /// expires at \a expiration, in seconds since the epoch, or
+  /// kMaxVerificationLifetimeSeconds from now, whichever comes first.
+  void PutVerification(const std::string& fingerprint, int verify_error,
+                       int64_t expiration);
+
+  /// Copies the peer properties of the chain with \a fingerprint to
+  /// \a properties. Returns false if they are not in the cache.
+  bool GetPeerProperties(const std::string& fingerprint,
+                         PeerProperties* properties);
+  /// Records the peer properties of the chain with \a fingerprint.
+  void PutPeerProperties(const std::string& fingerprint,
+                         PeerProperties properties);
+
+  /// Returns hit and miss counters accumulated since creation.
+  Stats GetStats();
+
+ private:
+  struct Entry {
+    explicit Entry(std::string fp) : fingerprint(std::move(fp)) {}
+
+    std::string fingerprint;
+    bool has_verification = false;
+    int verify_error = 0;
+    int64_t verification_expiration = 0;
+    bool has_peer_properties = false;
+    PeerProperties peer_properties;
+  };
+  using EntryList = std::list<Entry>;
+
+  // Returns the entry for fingerprint, marking it as most recently used, or
+  // null if there is none.
+  Entry* FindLocked(const std::string& fingerprint)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Same as FindLocked, but adds the entry if there is none.
+  Entry* FindOrAddLocked(const std::string& fingerprint)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const size_t capacity_;
+  grpc_core::Mutex mu_;
+  // Most recently used entries first.
+  EntryList entries_ ABSL_GUARDED_BY(mu_);
+  std::map<std::string, EntryList::iterator> entry_by_fingerprint_
+      ABSL_GUARDED_BY(mu_);
+  Stats stats_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace tsi
+
+#endif /* GRPC_CORE_TSI_SSL_CERT_CACHE_SSL_CERT_CACHE_H */
@@ -0,0 +1,325 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/tsi/ssl/ktls/ssl_ktls.h"
+
+// Kernel TLS needs the Linux uapi header (kernel 4.13+ headers) and the
+// BoringSSL APIs for exporting the record-layer state of a connection.
+#if defined(GPR_LINUX) && defined(OPENSSL_IS_BORINGSSL) && \
+    defined(__has_include)
+#if __has_include(<linux/tls.h>)
+#define TSI_SSL_KTLS_SUPPORTED 1
+#endif
+#endif
+
+#ifdef TSI_SSL_KTLS_SUPPORTED
+
+#include <errno.h>
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+
+#include <string>
+#include <vector>
+
+#include <openssl/digest.h>
+#include <openssl/hkdf.h>
+#include <openssl/mem.h>
+#include <openssl/nid.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/support/log.h>
+
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+
+namespace tsi {
+
+namespace {
+
+constexpr size_t kMaxKeySize = 32;
+constexpr size_t kMaxIvSize = 12;
+
+// Record protection state for one direction of the connection.
+struct RecordState {
+  uint8_t key[kMaxKeySize];
+  size_t key_size = 0;
+  // For AES-GCM in TLS 1.2 this is the 4-byte implicit salt; otherwise the
+  // full 12-byte static IV.
+  uint8_t iv[kMaxIvSize];
+  size_t iv_size = 0;
+  uint64_t sequence = 0;
+
+  ~RecordState() {
+    OPENSSL_cleanse(key, sizeof(key));
+    OPENSSL_cleanse(iv, sizeof(iv));
+  }
+};
+
+union KernelCryptoInfo {
+  tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+#ifdef TLS_CIPHER_AES_GCM_256
+  tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+  tls12_crypto_info_chacha20_poly1305 chacha20_poly1305;
+#endif
+};
+
+void StoreBigEndian64(uint64_t value, uint8_t out[8]) {
+  for (int i = 7; i >= 0; --i) {
+    out[i] = static_cast<uint8_t>(value & 0xff);
+    value >>= 8;
+  }
+}
+
+// Returns the kernel cipher type for |cipher_nid|, or 0 if the kernel (as
+// known at compile time) cannot handle it.
+int KernelCipherType(int cipher_nid, size_t* key_size) {
+  switch (cipher_nid) {
+    case NID_aes_128_gcm:
+      *key_size = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+      return TLS_CIPHER_AES_GCM_128;
+#ifdef TLS_CIPHER_AES_GCM_256
+    case NID_aes_256_gcm:
+      *key_size = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+      return TLS_CIPHER_AES_GCM_256;
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case NID_chacha20_poly1305:
+      *key_size = TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE;
+      return TLS_CIPHER_CHACHA20_POLY1305;
+#endif
+    default:
+      return 0;
+  }
+}
+
+// HKDF-Expand-Label from RFC 8446, section 7.1, with an empty context.
+bool HkdfExpandLabel(const EVP_MD* digest, const uint8_t* secret,
+                     size_t secret_size, absl::string_view label, uint8_t* out,
+                     size_t out_size) {
+  std::string full_label = absl::StrCat("tls13 ", label);
+  std::vector<uint8_t> info;
+  info.reserve(4 + full_label.size());
+  info.push_back(static_cast<uint8_t>(out_size >> 8));
+  info.push_back(static_cast<uint8_t>(out_size & 0xff));
+  info.push_back(static_cast<uint8_t>(full_label.size()));
+  info.insert(info.end(), full_label.begin(), full_label.end());
+  info.push_back(0);
+  return HKDF_expand(out, out_size, digest, secret, secret_size, info.data(),
+                     info.size()) == 1;
+}
+
+bool DeriveTls13RecordState(const EVP_MD* digest,
+                            bssl::Span<const uint8_t> secret, size_t key_size,
+                            RecordState* state) {
+  state->key_size = key_size;
+  state->iv_size = kMaxIvSize;
+  return HkdfExpandLabel(digest, secret.data(), secret.size(), "key",
+                         state->key, state->key_size) &&
+         HkdfExpandLabel(digest, secret.data(), secret.size(), "iv", state->iv,
+                         state->iv_size);
+}
+
+// The TLS 1.2 AEAD key block is laid out as
+//   client_write_key | server_write_key | client_write_iv | server_write_iv
+// since AEAD ciphers have no MAC keys.
+bool DeriveTls12RecordStates(SSL* ssl, size_t key_size, RecordState* tx,
+                             RecordState* rx) {
+  size_t key_block_size = SSL_get_key_block_len(ssl);
+  if (key_block_size <= 2 * key_size) return false;
+  size_t iv_size = (key_block_size - 2 * key_size) / 2;
+  if (iv_size > kMaxIvSize || 2 * (key_size + iv_size) != key_block_size) {
+    return false;
+  }
+  std::vector<uint8_t> key_block(key_block_size);
+  if (SSL_generate_key_block(ssl, key_block.data(), key_block.size()) != 1) {
+    return false;
+  }
+  const uint8_t* client_key = key_block.data();
+  const uint8_t* server_key = client_key + key_size;
+  const uint8_t* client_iv = server_key + key_size;
+  const uint8_t* server_iv = client_iv + iv_size;
+  bool is_server = SSL_is_server(ssl);
+  memcpy(tx->key, is_server ? server_key : client_key, key_size);
+  memcpy(rx->key, is_server ? client_key : server_key, key_size);
+  memcpy(tx->iv, is_server ? server_iv : client_iv, iv_size);
+  memcpy(rx->iv, is_server ? client_iv : server_iv, iv_size);
+  tx->key_size = rx->key_size = key_size;
+  tx->iv_size = rx->iv_size = iv_size;
+  OPENSSL_cleanse(key_block.data(), key_block.size());
+  return true;
+}
+
+// Fills |info| from |state|. Returns the number of bytes of |info| to hand to
+// the kernel, or 0 on failure.
+size_t FillKernelCryptoInfo(uint16_t version, int cipher_type,
+                            const RecordState& state, KernelCryptoInfo* info) {
+  memset(info, 0, sizeof(*info));
+  uint8_t record_sequence[8];
+  StoreBigEndian64(state.sequence, record_sequence);
+  switch (cipher_type) {
+    case TLS_CIPHER_AES_GCM_128: {
+      tls12_crypto_info_aes_gcm_128* aes = &info->aes_gcm_128;
+      aes->info.version = version;
+      aes->info.cipher_type = TLS_CIPHER_AES_GCM_128;
+      memcpy(aes->key, state.key, TLS_CIPHER_AES_GCM_128_KEY_SIZE);
+      memcpy(aes->salt, state.iv, TLS_CIPHER_AES_GCM_128_SALT_SIZE);
+      // In TLS 1.3 the remainder of the static IV is XORed with the sequence
+      // number; in TLS 1.2 the kernel uses |iv| as the first explicit nonce.
+      if (state.iv_size == kMaxIvSize) {
+        memcpy(aes->iv, state.iv + TLS_CIPHER_AES_GCM_128_SALT_SIZE,
+               TLS_CIPHER_AES_GCM_128_IV_SIZE);
+      } else {
+        memcpy(aes->iv, record_sequence, TLS_CIPHER_AES_GCM_128_IV_SIZE);
+      }
+      memcpy(aes->rec_seq, record_sequence,
+             TLS_CIPHER_AES_GCM_128_REC_SEQ_SIZE);
+      return sizeof(*aes);
+    }
+#ifdef TLS_CIPHER_AES_GCM_256
+    case TLS_CIPHER_AES_GCM_256: {
+      tls12_crypto_info_aes_gcm_256* aes = &info->aes_gcm_256;
+      aes->info.version = version;
+      aes->info.cipher_type = TLS_CIPHER_AES_GCM_256;
+      memcpy(aes->key, state.key, TLS_CIPHER_AES_GCM_256_KEY_SIZE);
+      memcpy(aes->salt, state.iv, TLS_CIPHER_AES_GCM_256_SALT_SIZE);
+      if (state.iv_size == kMaxIvSize) {
+        memcpy(aes->iv, state.iv + TLS_CIPHER_AES_GCM_256_SALT_SIZE,
+               TLS_CIPHER_AES_GCM_256_IV_SIZE);
+      } else {
+        memcpy(aes->iv, record_sequence, TLS_CIPHER_AES_GCM_256_IV_SIZE);
+      }
+      memcpy(aes->rec_seq, record_sequence,
+             TLS_CIPHER_AES_GCM_256_REC_SEQ_SIZE);
+      return sizeof(*aes);
+    }
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case TLS_CIPHER_CHACHA20_POLY1305: {
+      if (state.iv_size != TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE) return 0;
+      tls12_crypto_info_chacha20_poly1305* chacha = &info->chacha20_poly1305;
+      chacha->info.version = version;
+      chacha->info.cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+      memcpy(chacha->key, state.key, TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE);
+      memcpy(chacha->iv, state.iv, TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE);
+      memcpy(chacha->rec_seq, record_sequence,
+             TLS_CIPHER_CHACHA20_POLY1305_REC_SEQ_SIZE);
+      return sizeof(*chacha);
+    }
+#endif
+    default:
+      return 0;
+  }
+}
+
+}  // namespace
+
+bool SslKernelTlsOffloadSupported() { return true; }
+
+tsi_result SslOffloadRecordProtectionToKernel(SSL* ssl, int fd) {
+  if (ssl == nullptr || fd < 0) return TSI_INVALID_ARGUMENT;
+  if (SSL_has_pending(ssl)) return TSI_FAILED_PRECONDITION;
+  uint16_t kernel_version;
+  switch (SSL_version(ssl)) {
+    case TLS1_2_VERSION:
+      kernel_version = TLS_1_2_VERSION;
+      break;
+#ifdef TLS_1_3_VERSION
+    case TLS1_3_VERSION:
+      if (!SSL_is_server(ssl)) return TSI_UNIMPLEMENTED;
+      kernel_version = TLS_1_3_VERSION;
+      break;
+#endif
+    default:
+      return TSI_UNIMPLEMENTED;
+  }
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (cipher == nullptr) return TSI_UNIMPLEMENTED;
+  size_t key_size = 0;
+  int cipher_type =
+      KernelCipherType(SSL_CIPHER_get_cipher_nid(cipher), &key_size);
+  if (cipher_type == 0) return TSI_UNIMPLEMENTED;
+  RecordState tx;
+  RecordState rx;
+  if (kernel_version == TLS_1_2_VERSION) {
+    if (!DeriveTls12RecordStates(ssl, key_size, &tx, &rx)) {
+      return TSI_UNIMPLEMENTED;
+    }
+  } else {
+    const EVP_MD* digest =
+        EVP_get_digestbynid(SSL_CIPHER_get_prf_nid(cipher));
+    bssl::Span<const uint8_t> read_secret;
+    bssl::Span<const uint8_t> write_secret;
+    if (digest == nullptr ||
+        !bssl::SSL_get_traffic_secrets(ssl, &read_secret, &write_secret) ||
+        !DeriveTls13RecordState(digest, write_secret, key_size, &tx) ||
+        !DeriveTls13RecordState(digest, read_secret, key_size, &rx)) {
+      return TSI_UNIMPLEMENTED;
+    }
+  }
+  tx.sequence = SSL_get_write_sequence(ssl);
+  rx.sequence = SSL_get_read_sequence(ssl);
+  KernelCryptoInfo tx_info;
+  KernelCryptoInfo rx_info;
+  size_t tx_info_size =
+      FillKernelCryptoInfo(kernel_version, cipher_type, tx, &tx_info);
+  size_t rx_info_size =
+      FillKernelCryptoInfo(kernel_version, cipher_type, rx, &rx_info);
+  if (tx_info_size == 0 || rx_info_size == 0) return TSI_UNIMPLEMENTED;
+  tsi_result result = TSI_OK;
+  // Attaching the ULP fails with ENOENT when the tls module is unavailable.
+  // Until crypto state is installed, the ULP passes data through untouched,
+  // so failures up to and including the first TLS_TX are recoverable.
+  if (setsockopt(fd, IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")) != 0) {
+    gpr_log(GPR_DEBUG, "kTLS: cannot attach tls ULP: %s", strerror(errno));
+    result = TSI_UNIMPLEMENTED;
+  } else if (setsockopt(fd, SOL_TLS, TLS_TX, &tx_info, tx_info_size) != 0) {
+    gpr_log(GPR_DEBUG, "kTLS: cannot install TX state: %s", strerror(errno));
+    result = TSI_UNIMPLEMENTED;
+  } else if (setsockopt(fd, SOL_TLS, TLS_RX, &rx_info, rx_info_size) != 0) {
+    gpr_log(GPR_ERROR, "kTLS: installed TX state but not RX state: %s",
+            strerror(errno));
+    result = TSI_INTERNAL_ERROR;
+  }
+  OPENSSL_cleanse(&tx_info, sizeof(tx_info));
+  OPENSSL_cleanse(&rx_info, sizeof(rx_info));
+  return result;
+}
+
+}  // namespace tsi
+
+#else  // TSI_SSL_KTLS_SUPPORTED
+
+namespace tsi {
+
+bool SslKernelTlsOffloadSupported() { return false; }
+
+tsi_result SslOffloadRecordProtectionToKernel(SSL* /*ssl*/, int /*fd*/) {
+  return TSI_UNIMPLEMENTED;
+}
+
+}  // namespace tsi
+
+#endif  // TSI_SSL_KTLS_SUPPORTED
@@ -0,0 +1,55 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_TSI_SSL_KTLS_SSL_KTLS_H
+#define GRPC_CORE_TSI_SSL_KTLS_SSL_KTLS_H
+
+#include <grpc/support/port_platform.h>
+
+#include <openssl/ssl.h>
+
+#include "src/core/tsi/transport_security_interface.h"
+
+namespace tsi {
+
+// Returns true if this build knows how to hand TLS record protection over to
+// the kernel (Linux kTLS with BoringSSL). Whether the running kernel supports
+// it is only known once SslOffloadRecordProtectionToKernel() is attempted.
+bool SslKernelTlsOffloadSupported();
+
+// Moves the record layer of the established TLS connection |ssl| into the
+// kernel TLS ULP of the connected TCP socket |fd|. On success, the kernel
+// encrypts everything written to |fd| and decrypts everything read from it,
+// so the caller must exchange plaintext over |fd| and must not use |ssl| for
+// record protection anymore.
+//
+// Only TLS 1.2 and TLS 1.3 with AES-GCM or ChaCha20-Poly1305 are offloaded.
+// TLS 1.3 clients are never offloaded, since the peer may still send
+// post-handshake messages (e.g. NewSessionTicket) that the kernel would not
+// process.
+//
+// Returns:
+// - TSI_OK if record protection was offloaded.
+// - TSI_UNIMPLEMENTED if the platform, TLS library, kernel, protocol version
+//   or cipher suite does not support offloading. |fd| is left in a state
+//   where userspace record protection keeps working.
+// - TSI_FAILED_PRECONDITION if |ssl| still has buffered records, in which
+//   case |fd| is untouched.
+// - Any other error if the kernel accepted only part of the state; the
+//   connection can no longer be used and must be closed.
+tsi_result SslOffloadRecordProtectionToKernel(SSL* ssl, int fd);
+
+}  // namespace tsi
+
+#endif  // GRPC_CORE_TSI_SSL_KTLS_SSL_KTLS_H
@@ -20,21 +20,66 @@
 
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
 
+#include <deque>
+#include <functional>
+
+#include "absl/memory/memory.h"
+
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/time.h>
 
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/ssl/session_cache/ssl_session.h"
 
 namespace tsi {
 
-/// Node for single cached session.
+namespace {
+
+// Caches with fewer entries per shard than this are not split.
+constexpr size_t kMinShardCapacity = 64;
+constexpr size_t kMaxShards = 16;
+
+// Returns the time, in seconds since the epoch, after which \a session should
+// no longer be offered for resumption.
+int64_t SessionExpiration(const SSL_SESSION* session) {
+  int64_t lifetime = static_cast<int64_t>(SSL_SESSION_get_timeout(session));
+#if defined(OPENSSL_IS_BORINGSSL) || OPENSSL_VERSION_NUMBER >= 0x10100000L
+  // Servers may ask clients to drop tickets earlier than the session timeout.
+  int64_t lifetime_hint =
+      static_cast<int64_t>(SSL_SESSION_get_ticket_lifetime_hint(session));
+  if (lifetime_hint > 0 && (lifetime <= 0 || lifetime_hint < lifetime)) {
+    lifetime = lifetime_hint;
+  }
+#endif
+  return static_cast<int64_t>(SSL_SESSION_get_time(session)) + lifetime;
+}
+
+// Returns true if \a session is a TLS 1.3 session, whose tickets should
+// preferably be used only once.
+bool IsSingleUseSession(const SSL_SESSION* session) {
+#if defined(OPENSSL_IS_BORINGSSL) || OPENSSL_VERSION_NUMBER >= 0x10101000L
+  return SSL_SESSION_get_protocol_version(session) == TLS1_3_VERSION;
+#else
+  (void)session;
+  return false;
+#endif
+}
+
+int64_t NowSeconds() {
+  return static_cast<int64_t>(gpr_now(GPR_CLOCK_REALTIME).tv_sec);
+}
+
+}  // namespace
+
+constexpr size_t SslSessionLRUCache::kMaxSessionsPerKey;
+
+/// Node for cached sessions of a single key.
 class SslSessionLRUCache::Node {
  public:
-  Node(const std::string& key, SslSessionPtr session) : key_(key) {
-    SetSession(std::move(session));
-  }
+  explicit Node(const std::string& key) : key_(key) {}
 
   // Not copyable nor movable.
   Node(const Node&) = delete;
@@ -42,43 +87,197 @@ class SslSessionLRUCache::Node {
 
   const std::string& key() const { return key_; }
 
-  /// Returns a copy of the node's cache session.
-  SslSessionPtr CopySession() const { return session_->CopySession(); }
+  /// Add the \a session (which is moved) to the node. TLS 1.3 sessions are
+  /// kept alongside other TLS 1.3 sessions, others replace existing sessions.
+  void AddSession(SslSessionPtr session) {
+    Entry entry;
+    entry.expiration = SessionExpiration(session.get());
+    entry.single_use = IsSingleUseSession(session.get());
+    entry.session = SslCachedSession::Create(std::move(session));
+    if (!entry.single_use ||
+        (!sessions_.empty() && !sessions_.front().single_use)) {
+      sessions_.clear();
+    }
+    sessions_.push_front(std::move(entry));
+    if (sessions_.size() > kMaxSessionsPerKey) {
+      sessions_.pop_back();
+    }
+  }
 
-  /// Set the \a session (which is moved) for the node.
-  void SetSession(SslSessionPtr session) {
-    session_ = SslCachedSession::Create(std::move(session));
+  /// Drops sessions expired at \a now and returns how many were dropped.
+  size_t RemoveExpiredSessions(int64_t now) {
+    size_t expired = 0;
+    for (auto it = sessions_.begin(); it != sessions_.end();) {
+      if (it->expiration <= now) {
+        it = sessions_.erase(it);
+        expired++;
+      } else {
+        ++it;
+      }
+    }
+    return expired;
   }
 
+  /// Returns the most recent session. Single-use sessions are removed from
+  /// the node unless it is the last one.
+  SslSessionPtr TakeSession() {
+    GPR_ASSERT(!sessions_.empty());
+    SslSessionPtr session = sessions_.front().session->CopySession();
+    if (sessions_.front().single_use && sessions_.size() > 1) {
+      sessions_.pop_front();
+    }
+    return session;
+  }
+
+  bool empty() const { return sessions_.empty(); }
+
  private:
-  friend class SslSessionLRUCache;
+  friend class SslSessionLRUCache::Shard;
+
+  struct Entry {
+    std::unique_ptr<SslCachedSession> session;
+    int64_t expiration;
+    bool single_use;
+  };
 
   std::string key_;
-  std::unique_ptr<SslCachedSession> session_;
+  // Most recent session first.
+  std::deque<Entry> sessions_;
 
   Node* next_ = nullptr;
   Node* prev_ = nullptr;
 };
 
-SslSessionLRUCache::SslSessionLRUCache(size_t capacity) : capacity_(capacity) {
+/// LRU cache of a subset of keys.
+class SslSessionLRUCache::Shard {
+ public:
+  explicit Shard(size_t capacity) : capacity_(capacity) {
+    GPR_ASSERT(capacity > 0);
+  }
+
+  ~Shard() {
+    Node* node = use_order_list_head_;
+    while (node) {
+      Node* next = node->next_;
+      delete node;
+      node = next;
+    }
+  }
+
+  size_t Size() {
+    grpc_core::MutexLock lock(&lock_);
+    return use_order_list_size_;
+  }
+
+  void Put(const std::string& key, SslSessionPtr session) {
+    grpc_core::MutexLock lock(&lock_);
+    Node* node = FindLocked(key);
+    if (node != nullptr) {
+      node->AddSession(std::move(session));
+      return;
+    }
+    node = new Node(key);
+    node->AddSession(std::move(session));
+    PushFront(node);
+    entry_by_key_.emplace(key, node);
+    AssertInvariants();
+    if (use_order_list_size_ > capacity_) {
+      GPR_ASSERT(use_order_list_tail_);
+      EraseLocked(use_order_list_tail_);
+    }
+  }
+
+  SslSessionPtr Get(const std::string& key) {
+    grpc_core::MutexLock lock(&lock_);
+    Node* node = FindLocked(key);
+    if (node != nullptr) {
+      stats_.expired += node->RemoveExpiredSessions(NowSeconds());
+      if (node->empty()) {
+        EraseLocked(node);
+        node = nullptr;
+      }
+    }
+    if (node == nullptr) {
+      stats_.misses++;
+      return nullptr;
+    }
+    stats_.hits++;
+    return node->TakeSession();
+  }
+
+  void AddStats(Stats* stats) {
+    grpc_core::MutexLock lock(&lock_);
+    stats->hits += stats_.hits;
+    stats->misses += stats_.misses;
+    stats->expired += stats_.expired;
+  }
+
+ private:
+  Node* FindLocked(const std::string& key)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void EraseLocked(Node* node) ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void Remove(Node* node) ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void PushFront(Node* node) ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void AssertInvariants() ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  grpc_core::Mutex lock_;
+  const size_t capacity_;
+
+  Node* use_order_list_head_ ABSL_GUARDED_BY(lock_) = nullptr;
+  Node* use_order_list_tail_ ABSL_GUARDED_BY(lock_) = nullptr;
+  size_t use_order_list_size_ ABSL_GUARDED_BY(lock_) = 0;
+  std::map<std::string, Node*> entry_by_key_ ABSL_GUARDED_BY(lock_);
+  Stats stats_ ABSL_GUARDED_BY(lock_);
+};
+
+SslSessionLRUCache::SslSessionLRUCache(size_t capacity) {
   GPR_ASSERT(capacity > 0);
+  size_t num_shards =
+      grpc_core::Clamp(capacity / kMinShardCapacity, size_t(1), kMaxShards);
+  shards_.reserve(num_shards);
+  for (size_t i = 0; i < num_shards; i++) {
+    // Spread capacity so that shard capacities add up to \a capacity.
+    shards_.push_back(absl::make_unique<Shard>(capacity / num_shards +
+                                               (i < capacity % num_shards)));
+  }
 }
 
-SslSessionLRUCache::~SslSessionLRUCache() {
-  Node* node = use_order_list_head_;
-  while (node) {
-    Node* next = node->next_;
-    delete node;
-    node = next;
-  }
+SslSessionLRUCache::~SslSessionLRUCache() = default;
+
+SslSessionLRUCache::Shard* SslSessionLRUCache::ShardForKey(
+    const std::string& key) {
+  if (shards_.size() == 1) return shards_[0].get();
+  return shards_[std::hash<std::string>()(key) % shards_.size()].get();
 }
 
 size_t SslSessionLRUCache::Size() {
-  grpc_core::MutexLock lock(&lock_);
-  return use_order_list_size_;
+  size_t size = 0;
+  for (auto& shard : shards_) {
+    size += shard->Size();
+  }
+  return size;
+}
+
+void SslSessionLRUCache::Put(const char* key, SslSessionPtr session) {
+  std::string key_str(key);
+  ShardForKey(key_str)->Put(key_str, std::move(session));
+}
+
+SslSessionPtr SslSessionLRUCache::Get(const char* key) {
+  // Key is only used for lookups.
+  std::string key_str(key);
+  return ShardForKey(key_str)->Get(key_str);
+}
+
+SslSessionLRUCache::Stats SslSessionLRUCache::GetStats() {
+  Stats stats;
+  for (auto& shard : shards_) {
+    shard->AddStats(&stats);
+  }
+  return stats;
 }
 
-SslSessionLRUCache::Node* SslSessionLRUCache::FindLocked(
+SslSessionLRUCache::Node* SslSessionLRUCache::Shard::FindLocked(
     const std::string& key) {
   auto it = entry_by_key_.find(key);
   if (it == entry_by_key_.end()) {
@@ -92,39 +291,15 @@ SslSessionLRUCache::Node* SslSessionLRUCache::FindLocked(
   return node;
 }
 
-void SslSessionLRUCache::Put(const char* key, SslSessionPtr session) {
-  grpc_core::MutexLock lock(&lock_);
-  Node* node = FindLocked(key);
-  if (node != nullptr) {
-    node->SetSession(std::move(session));
-    return;
-  }
-  node = new Node(key, std::move(session));
-  PushFront(node);
-  entry_by_key_.emplace(key, node);
+void SslSessionLRUCache::Shard::EraseLocked(SslSessionLRUCache::Node* node) {
+  Remove(node);
+  // Order matters, key is destroyed after deleting node.
+  entry_by_key_.erase(node->key());
+  delete node;
   AssertInvariants();
-  if (use_order_list_size_ > capacity_) {
-    GPR_ASSERT(use_order_list_tail_);
-    node = use_order_list_tail_;
-    Remove(node);
-    // Order matters, key is destroyed after deleting node.
-    entry_by_key_.erase(node->key());
-    delete node;
-    AssertInvariants();
-  }
-}
-
-SslSessionPtr SslSessionLRUCache::Get(const char* key) {
-  grpc_core::MutexLock lock(&lock_);
-  // Key is only used for lookups.
-  Node* node = FindLocked(key);
-  if (node == nullptr) {
-    return nullptr;
-  }
-  return node->CopySession();
 }
 
-void SslSessionLRUCache::Remove(SslSessionLRUCache::Node* node) {
+void SslSessionLRUCache::Shard::Remove(SslSessionLRUCache::Node* node) {
   if (node->prev_ == nullptr) {
     use_order_list_head_ = node->next_;
   } else {
@@ -139,7 +314,7 @@ void SslSessionLRUCache::Remove(SslSessionLRUCache::Node* node) {
   use_order_list_size_--;
 }
 
-void SslSessionLRUCache::PushFront(SslSessionLRUCache::Node* node) {
+void SslSessionLRUCache::Shard::PushFront(SslSessionLRUCache::Node* node) {
   if (use_order_list_head_ == nullptr) {
     use_order_list_head_ = node;
     use_order_list_tail_ = node;
@@ -155,7 +330,7 @@ void SslSessionLRUCache::PushFront(SslSessionLRUCache::Node* node) {
 }
 
 #ifndef NDEBUG
-void SslSessionLRUCache::AssertInvariants() {
+void SslSessionLRUCache::Shard::AssertInvariants() {
   size_t size = 0;
   Node* prev = nullptr;
   Node* current = use_order_list_head_;
@@ -173,7 +348,7 @@ void SslSessionLRUCache::AssertInvariants() {
   GPR_ASSERT(entry_by_key_.size() == use_order_list_size_);
 }
 #else
-void SslSessionLRUCache::AssertInvariants() {}
+void SslSessionLRUCache::Shard::AssertInvariants() {}
 #endif
 
 }  // namespace tsi
@@ -22,6 +22,9 @@
 #include <grpc/support/port_platform.h>
 
 #include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include <openssl/ssl.h>
 
@@ -40,12 +43,34 @@
 /// name. Note that servers are required to share session ticket encryption keys
 /// in order for cache to be effective.
 ///
+/// Large caches are split into independently locked shards by key, so that
+/// many connections can look up sessions concurrently. LRU order and capacity
+/// are maintained per shard.
+///
+/// Sessions expire once their lifetime, bounded by the server's ticket
+/// lifetime hint, has elapsed. Since TLS 1.3 tickets are meant to be used
+/// once, up to kMaxSessionsPerKey TLS 1.3 sessions are kept for each key and
+/// handed out to different connections; the most recent one is reused once it
+/// is the only one left.
+///
 /// This class is thread safe.
 
 namespace tsi {
 
 class SslSessionLRUCache : public grpc_core::RefCounted<SslSessionLRUCache> {
  public:
+  /// Maximum number of TLS 1.3 sessions kept for a single key.
+  static constexpr size_t kMaxSessionsPerKey = 4;
+
+  struct Stats {
+    /// Number of lookups that returned a session.
+    uint64_t hits = 0;
+    /// Number of lookups that did not find any usable session.
+    uint64_t misses = 0;
+    /// Number of sessions discarded because they expired.
+    uint64_t expired = 0;
+  };
+
   /// Create new LRU cache with the given capacity.
   static grpc_core::RefCountedPtr<SslSessionLRUCache> Create(size_t capacity) {
     return grpc_core::MakeRefCounted<SslSessionLRUCache>(capacity);
@@ -59,7 +84,7 @@ class SslSessionLRUCache : public grpc_core::RefCounted<SslSessionLRUCache> {
   SslSessionLRUCache(const SslSessionLRUCache&) = delete;
   SslSessionLRUCache& operator=(const SslSessionLRUCache&) = delete;
 
-  /// Returns current number of sessions in the cache.
+  /// Returns current number of keys in the cache.
   size_t Size();
   /// Add \a session in the cache using \a key. This operation may discard older
   /// sessions.
@@ -67,22 +92,16 @@ class SslSessionLRUCache : public grpc_core::RefCounted<SslSessionLRUCache> {
   /// Returns the session from the cache associated with \a key or null if not
   /// found.
   SslSessionPtr Get(const char* key);
+  /// Returns hit, miss and expiry counters accumulated since creation.
+  Stats GetStats();
 
  private:
   class Node;
+  class Shard;
 
-  Node* FindLocked(const std::string& key);
-  void Remove(Node* node);
-  void PushFront(Node* node);
-  void AssertInvariants();
-
-  grpc_core::Mutex lock_;
-  size_t capacity_;
+  Shard* ShardForKey(const std::string& key);
 
-  Node* use_order_list_head_ = nullptr;
-  Node* use_order_list_tail_ = nullptr;
-  size_t use_order_list_size_ = 0;
-  std::map<std::string, Node*> entry_by_key_;
+  std::vector<std::unique_ptr<Shard>> shards_;
 };
 
 }  // namespace tsi
@@ -21,6 +21,7 @@
 #include "src/core/tsi/ssl_transport_security.h"
 
 #include <limits.h>
+#include <stdint.h>
 #include <string.h>
 
 /* TODO(jboeuf): refactor inet_ntop into a portability header. */
@@ -33,7 +34,9 @@
 #include <sys/socket.h>
 #endif
 
+#include <algorithm>
 #include <string>
+#include <utility>
 
 #include <openssl/bio.h>
 #include <openssl/crypto.h> /* For OPENSSL_free */
@@ -53,9 +56,12 @@
 #include <grpc/support/string_util.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/thd_id.h>
+#include <grpc/support/time.h>
 
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/tsi/ssl/key_logging/ssl_key_logging.h"
+#include "src/core/tsi/ssl/ktls/ssl_ktls.h"
+#include "src/core/tsi/ssl/cert_cache/ssl_cert_cache.h"
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
 #include "src/core/tsi/ssl_types.h"
 #include "src/core/tsi/transport_security.h"
@@ -97,6 +103,7 @@ struct tsi_ssl_client_handshaker_factory {
   size_t alpn_protocol_list_length;
   grpc_core::RefCountedPtr<tsi::SslSessionLRUCache> session_cache;
   grpc_core::RefCountedPtr<TlsSessionKeyLogger> key_logger;
+  grpc_core::RefCountedPtr<tsi::SslCertCache> cert_cache;
 };
 
 struct tsi_ssl_server_handshaker_factory {
@@ -110,6 +117,7 @@ struct tsi_ssl_server_handshaker_factory {
   unsigned char* alpn_protocol_list;
   size_t alpn_protocol_list_length;
   grpc_core::RefCountedPtr<TlsSessionKeyLogger> key_logger;
+  grpc_core::RefCountedPtr<tsi::SslCertCache> cert_cache;
 };
 
 struct tsi_ssl_handshaker {
@@ -120,6 +128,7 @@ struct tsi_ssl_handshaker {
   unsigned char* outgoing_bytes_buffer;
   size_t outgoing_bytes_buffer_size;
   tsi_ssl_handshaker_factory* factory_ref;
+  bool session_offered;
 };
 struct tsi_ssl_handshaker_result {
   tsi_handshaker_result base;
@@ -127,6 +136,7 @@ struct tsi_ssl_handshaker_result {
   BIO* network_io;
   unsigned char* unused_bytes;
   size_t unused_bytes_size;
+  tsi::SslCertCache* cert_cache;
 };
 struct tsi_ssl_frame_protector {
   tsi_frame_protector base;
@@ -140,6 +150,7 @@ struct tsi_ssl_frame_protector {
 
 static gpr_once g_init_openssl_once = GPR_ONCE_INIT;
 static int g_ssl_ctx_ex_factory_index = -1;
+static int g_ssl_ctx_ex_cert_cache_index = -1;
 static const unsigned char kSslSessionIdContext[] = {'g', 'r', 'p', 'c'};
 #if !defined(OPENSSL_IS_BORINGSSL) && !defined(OPENSSL_NO_ENGINE)
 static const char kSslEnginePrefix[] = "engine:";
@@ -190,6 +201,9 @@ static void init_openssl(void) {
   g_ssl_ctx_ex_factory_index =
       SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
   GPR_ASSERT(g_ssl_ctx_ex_factory_index != -1);
+  g_ssl_ctx_ex_cert_cache_index =
+      SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  GPR_ASSERT(g_ssl_ctx_ex_cert_cache_index != -1);
 }
 
 /* --- Ssl utils. ---*/
@@ -1049,6 +1063,16 @@ void tsi_ssl_session_cache_unref(tsi_ssl_session_cache* cache) {
   reinterpret_cast<tsi::SslSessionLRUCache*>(cache)->Unref();
 }
 
+void tsi_ssl_session_cache_get_stats(tsi_ssl_session_cache* cache,
+                                     tsi_ssl_session_cache_stats* stats) {
+  GPR_ASSERT(stats != nullptr);
+  tsi::SslSessionLRUCache::Stats cache_stats =
+      reinterpret_cast<tsi::SslSessionLRUCache*>(cache)->GetStats();
+  stats->hits = cache_stats.hits;
+  stats->misses = cache_stats.misses;
+  stats->expired = cache_stats.expired;
+}
+
 /* --- tsi_frame_protector methods implementation. ---*/
 
 static tsi_result ssl_protector_protect(tsi_frame_protector* self,
@@ -1266,6 +1290,96 @@ tsi_result tsi_ssl_get_cert_chain_contents(STACK_OF(X509) * peer_chain,
   return result;
 }
 
+/* Appends the SHA-256 digest of cert to fingerprint. */
+static bool ssl_append_cert_digest(X509* cert, std::string* fingerprint) {
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int digest_size = 0;
+  if (!X509_digest(cert, EVP_sha256(), digest, &digest_size)) return false;
+  fingerprint->append(reinterpret_cast<const char*>(digest), digest_size);
+  return true;
+}
+
+/* Sets fingerprint to a key identifying leaf and the other certificates of
+   chain, which may or may not contain leaf itself. */
+static bool ssl_cert_chain_fingerprint(X509* leaf, STACK_OF(X509) * chain,
+                                       std::string* fingerprint) {
+  fingerprint->clear();
+  if (leaf == nullptr || !ssl_append_cert_digest(leaf, fingerprint)) {
+    return false;
+  }
+  const auto chain_len = chain == nullptr ? 0 : sk_X509_num(chain);
+  for (auto i = decltype(chain_len){0}; i < chain_len; i++) {
+    X509* cert = sk_X509_value(chain, i);
+    if (X509_cmp(cert, leaf) == 0) continue;
+    if (!ssl_append_cert_digest(cert, fingerprint)) return false;
+  }
+  return true;
+}
+
+/* Sets peer to the properties of the peer's certificate chain: the ones
+   extracted from peer_cert and the PEM encoding of peer_chain. */
+static tsi_result ssl_peer_from_cert_chain(X509* peer_cert,
+                                           STACK_OF(X509) * peer_chain,
+                                           tsi_peer* peer) {
+  if (peer_cert != nullptr) {
+    tsi_result result = peer_from_x509(peer_cert, 1, peer);
+    if (result != TSI_OK) return result;
+  }
+  if (peer_chain != nullptr) {
+    tsi_peer_property* new_properties = static_cast<tsi_peer_property*>(
+        gpr_zalloc(sizeof(*new_properties) * (peer->property_count + 1)));
+    for (size_t i = 0; i < peer->property_count; i++) {
+      new_properties[i] = peer->properties[i];
+    }
+    if (peer->properties != nullptr) gpr_free(peer->properties);
+    peer->properties = new_properties;
+    if (tsi_ssl_get_cert_chain_contents(
+            peer_chain, &peer->properties[peer->property_count]) == TSI_OK) {
+      peer->property_count++;
+    }
+  }
+  return TSI_OK;
+}
+
+/* Same as ssl_peer_from_cert_chain, but reuses the properties cached for the
+   same chain, if any, and caches them otherwise. */
+static tsi_result ssl_peer_from_cert_chain_cached(tsi::SslCertCache* cache,
+                                                  X509* peer_cert,
+                                                  STACK_OF(X509) * peer_chain,
+                                                  tsi_peer* peer) {
+  std::string fingerprint;
+  if (cache == nullptr ||
+      !ssl_cert_chain_fingerprint(peer_cert, peer_chain, &fingerprint)) {
+    return ssl_peer_from_cert_chain(peer_cert, peer_chain, peer);
+  }
+  tsi::SslCertCache::PeerProperties properties;
+  if (cache->GetPeerProperties(fingerprint, &properties)) {
+    tsi_result result = tsi_construct_peer(properties.size(), peer);
+    if (result != TSI_OK) return result;
+    for (size_t i = 0; i < properties.size(); i++) {
+      result = tsi_construct_string_peer_property(
+          properties[i].first.c_str(), properties[i].second.data(),
+          properties[i].second.size(), &peer->properties[i]);
+      if (result != TSI_OK) {
+        tsi_peer_destruct(peer);
+        return result;
+      }
+    }
+    return TSI_OK;
+  }
+  tsi_result result = ssl_peer_from_cert_chain(peer_cert, peer_chain, peer);
+  if (result != TSI_OK) return result;
+  properties.reserve(peer->property_count);
+  for (size_t i = 0; i < peer->property_count; i++) {
+    const tsi_peer_property& property = peer->properties[i];
+    properties.emplace_back(
+        property.name,
+        std::string(property.value.data, property.value.length));
+  }
+  cache->PutPeerProperties(fingerprint, std::move(properties));
+  return TSI_OK;
+}
+
 /* --- tsi_handshaker_result methods implementation. ---*/
 static tsi_result ssl_handshaker_result_extract_peer(
     const tsi_handshaker_result* self, tsi_peer* peer) {
@@ -1275,11 +1389,14 @@ static tsi_result ssl_handshaker_result_extract_peer(
   const tsi_ssl_handshaker_result* impl =
       reinterpret_cast<const tsi_ssl_handshaker_result*>(self);
   X509* peer_cert = SSL_get_peer_certificate(impl->ssl);
-  if (peer_cert != nullptr) {
-    result = peer_from_x509(peer_cert, 1, peer);
-    X509_free(peer_cert);
-    if (result != TSI_OK) return result;
-  }
+  // When called on the client side, the stack also contains the
+  // peer's certificate; When called on the server side,
+  // the peer's certificate is not present in the stack
+  STACK_OF(X509)* peer_chain = SSL_get_peer_cert_chain(impl->ssl);
+  result = ssl_peer_from_cert_chain_cached(impl->cert_cache, peer_cert,
+                                           peer_chain, peer);
+  if (peer_cert != nullptr) X509_free(peer_cert);
+  if (result != TSI_OK) return result;
 #if TSI_OPENSSL_ALPN_SUPPORT
   SSL_get0_alpn_selected(impl->ssl, &alpn_selected, &alpn_selected_len);
 #endif /* TSI_OPENSSL_ALPN_SUPPORT */
@@ -1288,14 +1405,9 @@ static tsi_result ssl_handshaker_result_extract_peer(
     SSL_get0_next_proto_negotiated(impl->ssl, &alpn_selected,
                                    &alpn_selected_len);
   }
-  // When called on the client side, the stack also contains the
-  // peer's certificate; When called on the server side,
-  // the peer's certificate is not present in the stack
-  STACK_OF(X509)* peer_chain = SSL_get_peer_cert_chain(impl->ssl);
   // 1 is for session reused property.
   size_t new_property_count = peer->property_count + 3;
   if (alpn_selected != nullptr) new_property_count++;
-  if (peer_chain != nullptr) new_property_count++;
   tsi_peer_property* new_properties = static_cast<tsi_peer_property*>(
       gpr_zalloc(sizeof(*new_properties) * new_property_count));
   for (size_t i = 0; i < peer->property_count; i++) {
@@ -1303,12 +1415,6 @@ static tsi_result ssl_handshaker_result_extract_peer(
   }
   if (peer->properties != nullptr) gpr_free(peer->properties);
   peer->properties = new_properties;
-  // Add peer chain if available
-  if (peer_chain != nullptr) {
-    result = tsi_ssl_get_cert_chain_contents(
-        peer_chain, &peer->properties[peer->property_count]);
-    if (result == TSI_OK) peer->property_count++;
-  }
   if (alpn_selected != nullptr) {
     result = tsi_construct_string_peer_property(
         TSI_SSL_ALPN_SELECTED_PROTOCOL,
@@ -1396,12 +1502,25 @@ static tsi_result ssl_handshaker_result_get_unused_bytes(
   return TSI_OK;
 }
 
+static tsi_result ssl_handshaker_result_offload_record_protection(
+    const tsi_handshaker_result* self, int fd) {
+  const tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<const tsi_ssl_handshaker_result*>(self);
+  /* The SSL object has been handed over to a frame protector already. */
+  if (impl->ssl == nullptr) return TSI_FAILED_PRECONDITION;
+  /* Unused bytes are records the kernel will never see, so they would have to
+     be unprotected in userspace first. */
+  if (impl->unused_bytes_size > 0) return TSI_FAILED_PRECONDITION;
+  return tsi::SslOffloadRecordProtectionToKernel(impl->ssl, fd);
+}
+
 static void ssl_handshaker_result_destroy(tsi_handshaker_result* self) {
   tsi_ssl_handshaker_result* impl =
       reinterpret_cast<tsi_ssl_handshaker_result*>(self);
   SSL_free(impl->ssl);
   BIO_free(impl->network_io);
   gpr_free(impl->unused_bytes);
+  if (impl->cert_cache != nullptr) impl->cert_cache->Unref();
   gpr_free(impl);
 }
 
@@ -1412,6 +1531,7 @@ static const tsi_handshaker_result_vtable handshaker_result_vtable = {
     ssl_handshaker_result_create_frame_protector,
     ssl_handshaker_result_get_unused_bytes,
     ssl_handshaker_result_destroy,
+    ssl_handshaker_result_offload_record_protection,
 };
 
 static tsi_result ssl_handshaker_result_create(
@@ -1432,6 +1552,12 @@ static tsi_result ssl_handshaker_result_create(
   /* Transfer ownership of |unused_bytes| to the handshaker result. */
   result->unused_bytes = unused_bytes;
   result->unused_bytes_size = unused_bytes_size;
+  /* The certificate cache is owned by the factory, which may be destroyed
+     before the handshaker result. */
+  tsi::SslCertCache* cert_cache = static_cast<tsi::SslCertCache*>(
+      SSL_CTX_get_ex_data(SSL_get_SSL_CTX(result->ssl),
+                          g_ssl_ctx_ex_cert_cache_index));
+  if (cert_cache != nullptr) result->cert_cache = cert_cache->Ref().release();
   *handshaker_result = &result->base;
   return TSI_OK;
 }
@@ -1641,6 +1767,65 @@ static tsi_result ssl_handshaker_next(
   return status;
 }
 
+// Skips a vector with a big-endian length prefix of length_size bytes.
+static bool ssl_skip_vector(const unsigned char** p, const unsigned char* end,
+                            size_t length_size) {
+  if (static_cast<size_t>(end - *p) < length_size) return false;
+  size_t length = 0;
+  for (size_t i = 0; i < length_size; ++i) length = (length << 8) | (*p)[i];
+  *p += length_size;
+  if (static_cast<size_t>(end - *p) < length) return false;
+  *p += length;
+  return true;
+}
+
+// Returns whether the ClientHello at the start of bytes offers to resume a
+// session, i.e. carries a non-empty session ticket or a TLS 1.3 pre-shared
+// key. Truncated or malformed input is reported as a full handshake.
+static bool ssl_client_hello_offers_session(const unsigned char* bytes,
+                                            size_t bytes_size) {
+  const uint16_t kSessionTicketExtension = 35;
+  const uint16_t kPreSharedKeyExtension = 41;
+  // Record header: content type, legacy version and length.
+  if (bytes_size < 5 || bytes[0] != SSL3_RT_HANDSHAKE) return false;
+  size_t record_length = (static_cast<size_t>(bytes[3]) << 8) | bytes[4];
+  const unsigned char* p = bytes + 5;
+  const unsigned char* end = p + std::min(record_length, bytes_size - 5);
+  // Handshake header, legacy version and random.
+  if (end - p < 4 + 2 + 32 || p[0] != SSL3_MT_CLIENT_HELLO) return false;
+  p += 4 + 2 + 32;
+  // Legacy session id, cipher suites and compression methods.
+  if (!ssl_skip_vector(&p, end, 1) || !ssl_skip_vector(&p, end, 2) ||
+      !ssl_skip_vector(&p, end, 1) || end - p < 2) {
+    return false;
+  }
+  p += 2;
+  while (end - p >= 4) {
+    uint16_t type = static_cast<uint16_t>((p[0] << 8) | p[1]);
+    size_t length = (static_cast<size_t>(p[2]) << 8) | p[3];
+    if (type == kPreSharedKeyExtension ||
+        (type == kSessionTicketExtension && length > 0)) {
+      return true;
+    }
+    p += 2;
+    if (!ssl_skip_vector(&p, end, 2)) return false;
+  }
+  return false;
+}
+
+static tsi_result ssl_handshaker_is_resumption(
+    tsi_handshaker* self, const unsigned char* received_bytes,
+    size_t received_bytes_size, bool* is_resumption) {
+  tsi_ssl_handshaker* impl = reinterpret_cast<tsi_ssl_handshaker*>(self);
+  if (!SSL_is_server(impl->ssl)) {
+    *is_resumption = impl->session_offered;
+  } else {
+    *is_resumption =
+        ssl_client_hello_offers_session(received_bytes, received_bytes_size);
+  }
+  return TSI_OK;
+}
+
 static const tsi_handshaker_vtable handshaker_vtable = {
     nullptr, /* get_bytes_to_send_to_peer -- deprecated */
     nullptr, /* process_bytes_from_peer   -- deprecated */
@@ -1650,21 +1835,23 @@ static const tsi_handshaker_vtable handshaker_vtable = {
     ssl_handshaker_destroy,
     ssl_handshaker_next,
     nullptr, /* shutdown */
+    ssl_handshaker_is_resumption,
 };
 
 /* --- tsi_ssl_handshaker_factory common methods. --- */
 
-static void tsi_ssl_handshaker_resume_session(
+static bool tsi_ssl_handshaker_resume_session(
     SSL* ssl, tsi::SslSessionLRUCache* session_cache) {
   const char* server_name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
   if (server_name == nullptr) {
-    return;
+    return false;
   }
   tsi::SslSessionPtr session = session_cache->Get(server_name);
-  if (session != nullptr) {
-    // SSL_set_session internally increments reference counter.
-    SSL_set_session(ssl, session.get());
+  if (session == nullptr) {
+    return false;
   }
+  // SSL_set_session internally increments reference counter.
+  return SSL_set_session(ssl, session.get()) == 1;
 }
 
 static tsi_result create_tsi_ssl_handshaker(SSL_CTX* ctx, int is_client,
@@ -1677,6 +1864,7 @@ static tsi_result create_tsi_ssl_handshaker(SSL_CTX* ctx, int is_client,
   BIO* network_io = nullptr;
   BIO* ssl_io = nullptr;
   tsi_ssl_handshaker* impl = nullptr;
+  bool session_offered = false;
   *handshaker = nullptr;
   if (ctx == nullptr) {
     gpr_log(GPR_ERROR, "SSL Context is null. Should never happen.");
@@ -1709,8 +1897,8 @@ static tsi_result create_tsi_ssl_handshaker(SSL_CTX* ctx, int is_client,
     tsi_ssl_client_handshaker_factory* client_factory =
         reinterpret_cast<tsi_ssl_client_handshaker_factory*>(factory);
     if (client_factory->session_cache != nullptr) {
-      tsi_ssl_handshaker_resume_session(ssl,
-                                        client_factory->session_cache.get());
+      session_offered = tsi_ssl_handshaker_resume_session(
+          ssl, client_factory->session_cache.get());
     }
     ERR_clear_error();
     ssl_result = SSL_do_handshake(ssl);
@@ -1737,6 +1925,7 @@ static tsi_result create_tsi_ssl_handshaker(SSL_CTX* ctx, int is_client,
       static_cast<unsigned char*>(gpr_zalloc(impl->outgoing_bytes_buffer_size));
   impl->base.vtable = &handshaker_vtable;
   impl->factory_ref = tsi_ssl_handshaker_factory_ref(factory);
+  impl->session_offered = session_offered;
   *handshaker = &impl->base;
   return TSI_OK;
 }
@@ -1795,6 +1984,7 @@ static void tsi_ssl_client_handshaker_factory_destroy(
   if (self->alpn_protocol_list != nullptr) gpr_free(self->alpn_protocol_list);
   self->session_cache.reset();
   self->key_logger.reset();
+  self->cert_cache.reset();
   gpr_free(self);
 }
 
@@ -1845,6 +2035,7 @@ static void tsi_ssl_server_handshaker_factory_destroy(
   }
   if (self->alpn_protocol_list != nullptr) gpr_free(self->alpn_protocol_list);
   self->key_logger.reset();
+  self->cert_cache.reset();
   gpr_free(self);
 }
 
@@ -1984,6 +2175,75 @@ static int verify_cb(int ok, X509_STORE_CTX* ctx) {
   return ok;
 }
 
+#if OPENSSL_VERSION_NUMBER >= 0x10100000
+// Verifies the peer's certificate chain, unless the outcome of verifying the
+// same chain is cached.
+static int ssl_cert_cache_verify_callback(X509_STORE_CTX* ctx, void* arg) {
+  tsi::SslCertCache* cache = static_cast<tsi::SslCertCache*>(arg);
+  std::string fingerprint;
+  if (!ssl_cert_chain_fingerprint(X509_STORE_CTX_get0_cert(ctx),
+                                  X509_STORE_CTX_get0_untrusted(ctx),
+                                  &fingerprint)) {
+    return X509_verify_cert(ctx);
+  }
+  int verify_error = X509_V_OK;
+  if (cache->GetVerification(fingerprint, &verify_error)) {
+    X509_STORE_CTX_set_error(ctx, verify_error);
+    return verify_error == X509_V_OK ? 1 : 0;
+  }
+  int ok = X509_verify_cert(ctx);
+  if (ok < 0) return ok;
+  verify_error = X509_STORE_CTX_get_error(ctx);
+  if (ok == 1) {
+    if (verify_error != X509_V_OK) return ok;
+    // The outcome holds until the first certificate of the chain expires.
+    int64_t expiration = INT64_MAX;
+    STACK_OF(X509)* verified_chain = X509_STORE_CTX_get0_chain(ctx);
+    const auto chain_len =
+        verified_chain == nullptr ? 0 : sk_X509_num(verified_chain);
+    const int64_t now = gpr_now(GPR_CLOCK_REALTIME).tv_sec;
+    for (auto i = decltype(chain_len){0}; i < chain_len; i++) {
+      X509* cert = sk_X509_value(verified_chain, i);
+      int days = 0;
+      int seconds = 0;
+      if (!ASN1_TIME_diff(&days, &seconds, nullptr, X509_get0_notAfter(cert))) {
+        return ok;
+      }
+      expiration = std::min(expiration, now + int64_t{days} * 86400 + seconds);
+    }
+    cache->PutVerification(fingerprint, X509_V_OK, expiration);
+  } else if (verify_error != X509_V_OK) {
+    cache->PutVerification(fingerprint, verify_error, INT64_MAX);
+  }
+  return ok;
+}
+#endif
+
+// Makes handshakes on ssl_context use cache. If verify is true, the outcome of
+// verifying the peer's certificate chain is cached too.
+static void ssl_ctx_use_cert_cache(SSL_CTX* ssl_context,
+                                   tsi::SslCertCache* cache, bool verify) {
+  SSL_CTX_set_ex_data(ssl_context, g_ssl_ctx_ex_cert_cache_index, cache);
+#if OPENSSL_VERSION_NUMBER >= 0x10100000
+  if (verify) {
+    SSL_CTX_set_cert_verify_callback(ssl_context,
+                                     ssl_cert_cache_verify_callback, cache);
+  }
+#else
+  (void)verify;
+#endif
+}
+
+// Returns whether crl_directory enables CRL checking.
+static bool ssl_crl_checking_enabled(const char* crl_directory) {
+#if OPENSSL_VERSION_NUMBER >= 0x10100000
+  return crl_directory != nullptr && strcmp(crl_directory, "") != 0;
+#else
+  (void)crl_directory;
+  return false;
+#endif
+}
+
 /* --- tsi_ssl_handshaker_factory constructors. --- */
 
 static tsi_ssl_handshaker_factory_vtable client_handshaker_factory_vtable = {
@@ -2119,6 +2379,13 @@ tsi_result tsi_create_ssl_client_handshaker_factory_with_options(
   } else {
     SSL_CTX_set_verify(ssl_context, SSL_VERIFY_PEER, nullptr);
   }
+  if (options->cert_cache_capacity > 0) {
+    impl->cert_cache = tsi::SslCertCache::Create(options->cert_cache_capacity);
+    ssl_ctx_use_cert_cache(
+        ssl_context, impl->cert_cache.get(),
+        !options->skip_server_certificate_verification &&
+            !ssl_crl_checking_enabled(options->crl_directory));
+  }
 
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
   if (options->crl_directory != nullptr &&
@@ -2222,6 +2489,16 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
     impl->key_logger = options->key_logger->Ref();
   }
 
+  if (options->cert_cache_capacity > 0) {
+    impl->cert_cache = tsi::SslCertCache::Create(options->cert_cache_capacity);
+  }
+  const bool cache_verification =
+      (options->client_certificate_request ==
+           TSI_REQUEST_CLIENT_CERTIFICATE_AND_VERIFY ||
+       options->client_certificate_request ==
+           TSI_REQUEST_AND_REQUIRE_CLIENT_CERTIFICATE_AND_VERIFY) &&
+      !ssl_crl_checking_enabled(options->crl_directory);
+
   for (i = 0; i < options->num_key_cert_pairs; i++) {
     do {
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
@@ -2326,6 +2603,11 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
           &impl->ssl_context_x509_subject_names[i]);
       if (result != TSI_OK) break;
 
+      if (impl->cert_cache != nullptr) {
+        ssl_ctx_use_cert_cache(impl->ssl_contexts[i], impl->cert_cache.get(),
+                               cache_verification);
+      }
+
       SSL_CTX_set_tlsext_servername_callback(
           impl->ssl_contexts[i],
           ssl_server_handshaker_factory_servername_callback);
@@ -2415,3 +2697,15 @@ const tsi_ssl_handshaker_factory_vtable* tsi_ssl_handshaker_factory_swap_vtable(
   factory->vtable = new_vtable;
   return orig_vtable;
 }
+
+tsi::SslCertCache* tsi_ssl_client_handshaker_factory_get_cert_cache(
+    tsi_ssl_client_handshaker_factory* factory) {
+  GPR_ASSERT(factory != nullptr);
+  return factory->cert_cache.get();
+}
+
+tsi::SslCertCache* tsi_ssl_server_handshaker_factory_get_cert_cache(
+    tsi_ssl_server_handshaker_factory* factory) {
+  GPR_ASSERT(factory != nullptr);
+  return factory->cert_cache.get();
+}
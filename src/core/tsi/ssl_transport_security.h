@@ -27,6 +27,7 @@
 
 #include <grpc/grpc_security_constants.h>
 
+#include "src/core/tsi/ssl/cert_cache/ssl_cert_cache.h"
 #include "src/core/tsi/ssl/key_logging/ssl_key_logging.h"
 #include "src/core/tsi/transport_security_interface.h"
 
@@ -76,6 +77,20 @@ void tsi_ssl_session_cache_ref(tsi_ssl_session_cache* cache);
 /* Decrement reference counter of \a cache.  */
 void tsi_ssl_session_cache_unref(tsi_ssl_session_cache* cache);
 
+/* Counters of session lookups in a tsi_ssl_session_cache.  */
+typedef struct {
+  /* Lookups that returned a session to resume.  */
+  uint64_t hits;
+  /* Lookups that found no usable session, leading to a full handshake.  */
+  uint64_t misses;
+  /* Sessions dropped because their lifetime elapsed.  */
+  uint64_t expired;
+} tsi_ssl_session_cache_stats;
+
+/* Fill \a stats with the counters of \a cache accumulated since creation.  */
+void tsi_ssl_session_cache_get_stats(tsi_ssl_session_cache* cache,
+                                     tsi_ssl_session_cache_stats* stats);
+
 /* --- tsi_ssl_key_logger object ---
 
    Experimental SSL Key logging functionality to enable decryption of
@@ -179,6 +194,14 @@ struct tsi_ssl_client_handshaker_options {
      > 1.1 is supported for CRL checking*/
   const char* crl_directory;
 
+  /* cert_cache_capacity is the number of server certificate chains whose
+     verification outcome and peer properties are cached by the factory, so
+     that connections to servers presenting the same chain skip verifying and
+     parsing it again. 0 disables the cache. Verification outcomes are not
+     cached when crl_directory is set. Only OpenSSL version >= 1.1 is
+     supported. */
+  size_t cert_cache_capacity;
+
   tsi_ssl_client_handshaker_options()
       : pem_key_cert_pair(nullptr),
         pem_root_certs(nullptr),
@@ -191,7 +214,8 @@ struct tsi_ssl_client_handshaker_options {
         skip_server_certificate_verification(false),
         min_tls_version(tsi_tls_version::TSI_TLS1_2),
         max_tls_version(tsi_tls_version::TSI_TLS1_3),
-        crl_directory(nullptr) {}
+        crl_directory(nullptr),
+        cert_cache_capacity(0) {}
 };
 
 /* Creates a client handshaker factory.
@@ -322,6 +346,14 @@ struct tsi_ssl_server_handshaker_options {
    * crl checking. Only OpenSSL version > 1.1 is supported for CRL checking */
   const char* crl_directory;
 
+  /* cert_cache_capacity is the number of client certificate chains whose
+     verification outcome and peer properties are cached by the factory, so
+     that connections from clients presenting the same chain skip verifying and
+     parsing it again. 0 disables the cache. Verification outcomes are not
+     cached when crl_directory is set. Only OpenSSL version >= 1.1 is
+     supported. */
+  size_t cert_cache_capacity;
+
   tsi_ssl_server_handshaker_options()
       : pem_key_cert_pairs(nullptr),
         num_key_cert_pairs(0),
@@ -335,7 +367,8 @@ struct tsi_ssl_server_handshaker_options {
         min_tls_version(tsi_tls_version::TSI_TLS1_2),
         max_tls_version(tsi_tls_version::TSI_TLS1_3),
         key_logger(nullptr),
-        crl_directory(nullptr) {}
+        crl_directory(nullptr),
+        cert_cache_capacity(0) {}
 };
 
 /* Creates a server handshaker factory.
@@ -402,4 +435,11 @@ tsi_result tsi_ssl_extract_x509_subject_names_from_pem_cert(
 tsi_result tsi_ssl_get_cert_chain_contents(STACK_OF(X509) * peer_chain,
                                            tsi_peer_property* property);
 
+/* Exposed for testing only. Return the certificate cache of the factory, or
+   nullptr if it was created with a cert_cache_capacity of 0. */
+tsi::SslCertCache* tsi_ssl_client_handshaker_factory_get_cert_cache(
+    tsi_ssl_client_handshaker_factory* factory);
+tsi::SslCertCache* tsi_ssl_server_handshaker_factory_get_cert_cache(
+    tsi_ssl_server_handshaker_factory* factory);
+
 #endif /* GRPC_CORE_TSI_SSL_TRANSPORT_SECURITY_H */
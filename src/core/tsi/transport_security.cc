@@ -226,6 +226,22 @@ tsi_result tsi_handshaker_next(
                             handshaker_result, cb, user_data);
 }
 
+tsi_result tsi_handshaker_is_resumption(tsi_handshaker* self,
+                                        const unsigned char* received_bytes,
+                                        size_t received_bytes_size,
+                                        bool* is_resumption) {
+  if (self == nullptr || self->vtable == nullptr || is_resumption == nullptr ||
+      (received_bytes_size > 0 && received_bytes == nullptr)) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  *is_resumption = false;
+  if (self->handshaker_result_created) return TSI_FAILED_PRECONDITION;
+  if (self->handshake_shutdown) return TSI_HANDSHAKE_SHUTDOWN;
+  if (self->vtable->is_resumption == nullptr) return TSI_UNIMPLEMENTED;
+  return self->vtable->is_resumption(self, received_bytes, received_bytes_size,
+                                     is_resumption);
+}
+
 void tsi_handshaker_shutdown(tsi_handshaker* self) {
   if (self == nullptr || self->vtable == nullptr) return;
   if (self->vtable->shutdown != nullptr) {
@@ -285,6 +301,17 @@ tsi_result tsi_handshaker_result_get_unused_bytes(
   return self->vtable->get_unused_bytes(self, bytes, bytes_size);
 }
 
+tsi_result tsi_handshaker_result_offload_record_protection(
+    const tsi_handshaker_result* self, int fd) {
+  if (self == nullptr || self->vtable == nullptr || fd < 0) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  if (self->vtable->offload_record_protection == nullptr) {
+    return TSI_UNIMPLEMENTED;
+  }
+  return self->vtable->offload_record_protection(self, fd);
+}
+
 void tsi_handshaker_result_destroy(tsi_handshaker_result* self) {
   if (self == nullptr) return;
   self->vtable->destroy(self);
@@ -80,6 +80,10 @@ struct tsi_handshaker_vtable {
                      tsi_handshaker_result** handshaker_result,
                      tsi_handshaker_on_next_done_cb cb, void* user_data);
   void (*shutdown)(tsi_handshaker* self);
+  /* May be null if the TSI impl cannot tell resumed sessions apart. */
+  tsi_result (*is_resumption)(tsi_handshaker* self,
+                              const unsigned char* received_bytes,
+                              size_t received_bytes_size, bool* is_resumption);
 };
 struct tsi_handshaker {
   const tsi_handshaker_vtable* vtable;
@@ -117,6 +121,10 @@ struct tsi_handshaker_result_vtable {
                                  const unsigned char** bytes,
                                  size_t* bytes_size);
   void (*destroy)(tsi_handshaker_result* self);
+  /* May be null if the TSI impl cannot hand record protection over to the
+     kernel. */
+  tsi_result (*offload_record_protection)(const tsi_handshaker_result* self,
+                                          int fd);
 };
 struct tsi_handshaker_result {
   const tsi_handshaker_result_vtable* vtable;
@@ -277,6 +277,17 @@ tsi_result tsi_handshaker_result_get_unused_bytes(
     const tsi_handshaker_result* self, const unsigned char** bytes,
     size_t* bytes_size);
 
+/* This method attempts to move record protection for the established
+   connection into the kernel, for the connected socket |fd|. It returns
+   TSI_OK if, from now on, the kernel protects all bytes written to and read
+   from |fd|; in that case the caller must neither create a frame protector nor
+   send the unused bytes through one, and exchanges plaintext over |fd|.
+   TSI_UNIMPLEMENTED and TSI_FAILED_PRECONDITION mean that nothing changed and
+   the caller should create a frame protector as usual. Any other result means
+   the connection is unusable.  */
+tsi_result tsi_handshaker_result_offload_record_protection(
+    const tsi_handshaker_result* self, int fd);
+
 /* This method releases the tsi_handshaker_handshaker object. After this method
    is called, no other method can be called on the object.  */
 void tsi_handshaker_result_destroy(tsi_handshaker_result* self);
@@ -488,6 +499,17 @@ tsi_result tsi_handshaker_next(
     size_t* bytes_to_send_size, tsi_handshaker_result** handshaker_result,
     tsi_handshaker_on_next_done_cb cb, void* user_data);
 
+/* This method tells whether the handshake is expected to resume a previous
+   session, and thus to skip the certificate verification and private key
+   operations of a full handshake. It may be called before the first call to
+   tsi_handshaker_next() that will pass received_bytes, and must not consume
+   them. The answer is a best-effort hint that callers may use to schedule
+   handshakes; TSI_UNIMPLEMENTED means that the implementation cannot tell.  */
+tsi_result tsi_handshaker_is_resumption(tsi_handshaker* self,
+                                        const unsigned char* received_bytes,
+                                        size_t received_bytes_size,
+                                        bool* is_resumption);
+
 /* This method shuts down a TSI handshake that is in progress.
  *
  * This method will be invoked when TSI handshake should be terminated before
@@ -37,6 +37,18 @@
 namespace grpc {
 namespace experimental {
 
+namespace {
+
+// Utilizations must be non-negative.  This also rejects NaN.
+bool IsValidUtilization(double value) { return value >= 0; }
+
+// QPS is sent as a uint64, so it must also be small enough to convert.
+bool IsValidQps(double value) {
+  return value >= 0 && value < 18446744073709551616.0 /* 2^64 */;
+}
+
+}  // namespace
+
 CallMetricRecorder::CallMetricRecorder(grpc_core::Arena* arena)
     : backend_metric_data_(arena->New<grpc_core::BackendMetricData>()) {}
 
@@ -46,6 +58,7 @@ CallMetricRecorder::~CallMetricRecorder() {
 
 CallMetricRecorder& CallMetricRecorder::RecordCpuUtilizationMetric(
     double value) {
+  if (!IsValidUtilization(value)) return *this;
   internal::MutexLock lock(&mu_);
   backend_metric_data_->cpu_utilization = value;
   return *this;
@@ -53,13 +66,22 @@ CallMetricRecorder& CallMetricRecorder::RecordCpuUtilizationMetric(
 
 CallMetricRecorder& CallMetricRecorder::RecordMemoryUtilizationMetric(
     double value) {
+  if (!IsValidUtilization(value)) return *this;
   internal::MutexLock lock(&mu_);
   backend_metric_data_->mem_utilization = value;
   return *this;
 }
 
+CallMetricRecorder& CallMetricRecorder::RecordQpsMetric(double value) {
+  if (!IsValidQps(value)) return *this;
+  internal::MutexLock lock(&mu_);
+  backend_metric_data_->qps = value;
+  return *this;
+}
+
 CallMetricRecorder& CallMetricRecorder::RecordUtilizationMetric(
     grpc::string_ref name, double value) {
+  if (!IsValidUtilization(value)) return *this;
   internal::MutexLock lock(&mu_);
   absl::string_view name_sv(name.data(), name.length());
   backend_metric_data_->utilization[name_sv] = value;
@@ -79,6 +101,7 @@ absl::optional<std::string> CallMetricRecorder::CreateSerializedReport() {
   internal::MutexLock lock(&mu_);
   bool has_data = backend_metric_data_->cpu_utilization != -1 ||
                   backend_metric_data_->mem_utilization != -1 ||
+                  backend_metric_data_->qps != -1 ||
                   !backend_metric_data_->utilization.empty() ||
                   !backend_metric_data_->request_cost.empty();
   if (!has_data) {
@@ -94,6 +117,10 @@ absl::optional<std::string> CallMetricRecorder::CreateSerializedReport() {
     xds_data_orca_v3_OrcaLoadReport_set_mem_utilization(
         response, backend_metric_data_->mem_utilization);
   }
+  if (backend_metric_data_->qps != -1) {
+    xds_data_orca_v3_OrcaLoadReport_set_rps(
+        response, static_cast<uint64_t>(backend_metric_data_->qps));
+  }
   for (const auto& p : backend_metric_data_->request_cost) {
     xds_data_orca_v3_OrcaLoadReport_request_cost_set(
         response,
@@ -53,6 +53,18 @@
 namespace grpc {
 namespace experimental {
 
+namespace {
+
+// Utilizations must be non-negative.  This also rejects NaN.
+bool IsValidUtilization(double value) { return value >= 0; }
+
+// QPS is sent as a uint64, so it must also be small enough to convert.
+bool IsValidQps(double value) {
+  return value >= 0 && value < 18446744073709551616.0 /* 2^64 */;
+}
+
+}  // namespace
+
 //
 // OrcaService::Reactor
 //
@@ -175,6 +187,7 @@ OrcaService::OrcaService(OrcaService::Options options)
 }
 
 void OrcaService::SetCpuUtilization(double cpu_utilization) {
+  if (!IsValidUtilization(cpu_utilization)) return;
   grpc::internal::MutexLock lock(&mu_);
   cpu_utilization_ = cpu_utilization;
   response_slice_.reset();
@@ -187,6 +200,7 @@ void OrcaService::DeleteCpuUtilization() {
 }
 
 void OrcaService::SetMemoryUtilization(double memory_utilization) {
+  if (!IsValidUtilization(memory_utilization)) return;
   grpc::internal::MutexLock lock(&mu_);
   memory_utilization_ = memory_utilization;
   response_slice_.reset();
@@ -198,7 +212,21 @@ void OrcaService::DeleteMemoryUtilization() {
   response_slice_.reset();
 }
 
+void OrcaService::SetQps(double qps) {
+  if (!IsValidQps(qps)) return;
+  grpc::internal::MutexLock lock(&mu_);
+  qps_ = qps;
+  response_slice_.reset();
+}
+
+void OrcaService::DeleteQps() {
+  grpc::internal::MutexLock lock(&mu_);
+  qps_ = -1;
+  response_slice_.reset();
+}
+
 void OrcaService::SetNamedUtilization(std::string name, double utilization) {
+  if (!IsValidUtilization(utilization)) return;
   grpc::internal::MutexLock lock(&mu_);
   named_utilization_[std::move(name)] = utilization;
   response_slice_.reset();
@@ -212,6 +240,13 @@ void OrcaService::DeleteNamedUtilization(const std::string& name) {
 
 void OrcaService::SetAllNamedUtilization(
     std::map<std::string, double> named_utilization) {
+  for (auto it = named_utilization.begin(); it != named_utilization.end();) {
+    if (IsValidUtilization(it->second)) {
+      ++it;
+    } else {
+      it = named_utilization.erase(it);
+    }
+  }
   grpc::internal::MutexLock lock(&mu_);
   named_utilization_ = std::move(named_utilization);
   response_slice_.reset();
@@ -231,6 +266,10 @@ Slice OrcaService::GetOrCreateSerializedResponse() {
       xds_data_orca_v3_OrcaLoadReport_set_mem_utilization(response,
                                                           memory_utilization_);
     }
+    if (qps_ != -1) {
+      xds_data_orca_v3_OrcaLoadReport_set_rps(response,
+                                              static_cast<uint64_t>(qps_));
+    }
     for (const auto& p : named_utilization_) {
       xds_data_orca_v3_OrcaLoadReport_utilization_set(
           response,
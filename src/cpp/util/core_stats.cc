@@ -22,6 +22,8 @@
 
 #include <string>
 
+#include "absl/strings/str_cat.h"
+
 #include <grpc/support/atm.h>
 #include <grpc/support/log.h>
 
@@ -54,6 +56,22 @@ void CoreStatsToProto(const grpc_stats_data& core, Stats* proto) {
   }
 }
 
+void MethodLatencyToProto(
+    const std::vector<grpc_core::MethodLatency>& core, Stats* proto) {
+  const int histogram = GRPC_STATS_HISTOGRAM_SERVER_CALL_LATENCY_US;
+  for (const grpc_core::MethodLatency& method : core) {
+    Metric* m = proto->add_metrics();
+    m->set_name(absl::StrCat(grpc_stats_histogram_name[histogram], ":",
+                             method.method));
+    Histogram* h = m->mutable_histogram();
+    for (int j = 0; j < grpc_stats_histo_buckets[histogram]; j++) {
+      Bucket* b = h->add_buckets();
+      b->set_start(grpc_stats_histo_bucket_boundaries[histogram][j]);
+      b->set_count(method.buckets[j]);
+    }
+  }
+}
+
 void ProtoToCoreStats(const grpc::core::Stats& proto, grpc_stats_data* core) {
   memset(core, 0, sizeof(*core));
   for (const auto& m : proto.metrics()) {
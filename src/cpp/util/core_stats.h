@@ -19,6 +19,8 @@
 #ifndef GRPC_INTERNAL_CPP_UTIL_CORE_STATS_H
 #define GRPC_INTERNAL_CPP_UTIL_CORE_STATS_H
 
+#include <vector>
+
 #include "src/core/lib/debug/stats.h"
 #include "src/proto/grpc/core/stats.pb.h"
 
@@ -26,6 +28,11 @@ namespace grpc {
 
 void CoreStatsToProto(const grpc_stats_data& core, grpc::core::Stats* proto);
 void ProtoToCoreStats(const grpc::core::Stats& proto, grpc_stats_data* core);
+// Adds a histogram metric named "server_call_latency_us:<method>" for each
+// method.  ProtoToCoreStats() ignores these metrics.
+void MethodLatencyToProto(
+    const std::vector<grpc_core::MethodLatency>& core,
+    grpc::core::Stats* proto);
 
 }  // namespace grpc
 
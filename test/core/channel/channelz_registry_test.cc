@@ -21,6 +21,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <grpc/grpc.h>
@@ -137,6 +139,28 @@ TEST_F(ChannelzRegistryTest, TestUnregistration) {
   }
 }
 
+TEST_F(ChannelzRegistryTest, ConcurrentRegistrationAndUnregistration) {
+  const int kNumThreads = 8;
+  const int kNodesPerThread = 1000;
+  std::vector<std::thread> threads;
+  threads.reserve(kNumThreads);
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([]() {
+      std::vector<RefCountedPtr<BaseNode>> nodes;
+      for (int i = 0; i < kNodesPerThread; ++i) {
+        nodes.push_back(CreateTestNode());
+        EXPECT_EQ(ChannelzRegistry::Get(nodes.back()->uuid()), nodes.back());
+        // Unregister every other node while other threads register theirs.
+        if (i % 2 == 1) nodes.pop_back();
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  // Every uuid was allocated exactly once.
+  RefCountedPtr<BaseNode> node = CreateTestNode();
+  EXPECT_EQ(node->uuid(), kNumThreads * kNodesPerThread + 1);
+}
+
 }  // namespace testing
 }  // namespace channelz
 }  // namespace grpc_core
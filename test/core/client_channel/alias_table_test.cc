@@ -0,0 +1,120 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/lb_policy/alias_table.h"
+
+#include <stdint.h>
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/core/lib/gprpp/fast_random.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Returns how often each index is picked when every bucket and every
+// position within a bucket is tried once, with the given number of
+// positions per bucket.  This is the exact distribution of the table, up
+// to the resolution of the step.
+std::vector<uint64_t> SweepPicks(const AliasTable& table, uint32_t steps) {
+  std::vector<uint64_t> counts(table.size());
+  for (size_t bucket = 0; bucket < table.size(); ++bucket) {
+    // Smallest high word that lands in this bucket.
+    const uint64_t high =
+        ((static_cast<uint64_t>(bucket) << 32) + table.size() - 1) /
+        table.size();
+    for (uint32_t i = 0; i < steps; ++i) {
+      const uint64_t low = (static_cast<uint64_t>(i) << 32) / steps;
+      ++counts[table.Pick((high << 32) | low)];
+    }
+  }
+  return counts;
+}
+
+TEST(AliasTableTest, SingleWeight) {
+  const uint32_t weights[] = {7};
+  AliasTable table(weights);
+  EXPECT_EQ(table.size(), 1u);
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(table.Pick(FastRandom64()), 0u);
+}
+
+TEST(AliasTableTest, EqualWeights) {
+  const uint32_t weights[] = {5, 5, 5, 5};
+  AliasTable table(weights);
+  const std::vector<uint64_t> counts = SweepPicks(table, 1000);
+  for (uint64_t count : counts) EXPECT_EQ(count, 1000u);
+}
+
+TEST(AliasTableTest, ExactProportions) {
+  const uint32_t weights[] = {1, 2, 3, 4};
+  AliasTable table(weights);
+  const std::vector<uint64_t> counts = SweepPicks(table, 1000);
+  // 4000 picks in total, split 1:2:3:4.
+  EXPECT_EQ(counts[0], 400u);
+  EXPECT_EQ(counts[1], 800u);
+  EXPECT_EQ(counts[2], 1200u);
+  EXPECT_EQ(counts[3], 1600u);
+}
+
+TEST(AliasTableTest, ZeroWeightIsNeverPicked) {
+  const uint32_t weights[] = {3, 0, 1};
+  AliasTable table(weights);
+  const std::vector<uint64_t> counts = SweepPicks(table, 1000);
+  EXPECT_EQ(counts[0], 2250u);
+  EXPECT_EQ(counts[1], 0u);
+  EXPECT_EQ(counts[2], 750u);
+}
+
+TEST(AliasTableTest, LargeWeightsDoNotOverflow) {
+  const uint32_t weights[] = {UINT32_MAX, UINT32_MAX, UINT32_MAX / 2};
+  AliasTable table(weights);
+  const std::vector<uint64_t> counts = SweepPicks(table, 1000);
+  EXPECT_NEAR(counts[0], 1200, 1);
+  EXPECT_NEAR(counts[1], 1200, 1);
+  EXPECT_NEAR(counts[2], 600, 1);
+}
+
+TEST(AliasTableTest, RandomPicksFollowWeights) {
+  std::vector<uint32_t> weights;
+  uint64_t total = 0;
+  for (uint32_t i = 1; i <= 100; ++i) {
+    weights.push_back(i);
+    total += i;
+  }
+  AliasTable table(weights);
+  constexpr int kNumPicks = 1000000;
+  std::vector<int> counts(weights.size());
+  for (int i = 0; i < kNumPicks; ++i) ++counts[table.Pick(FastRandom64())];
+  for (size_t i = 0; i < weights.size(); ++i) {
+    const double expected = static_cast<double>(kNumPicks) * weights[i] / total;
+    // Allow five standard deviations.
+    EXPECT_NEAR(counts[i], expected, 5 * std::sqrt(expected) + 1)
+        << "index " << i;
+  }
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
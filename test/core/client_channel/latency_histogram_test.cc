@@ -0,0 +1,218 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/lb_policy/outlier_detection/latency_histogram.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Returns the exact percentile of the given latencies, using the same
+// nearest-rank definition as LatencyHistogram.
+double ExactPercentile(std::vector<int64_t> latencies, double percentile) {
+  std::sort(latencies.begin(), latencies.end());
+  size_t rank = static_cast<size_t>(
+      std::ceil(percentile / 100 * latencies.size()));
+  return latencies[std::max<size_t>(rank, 1) - 1];
+}
+
+// Draws call latencies, in microseconds, from a log-normal distribution,
+// which is a common model of RPC latency.  The normal samples come from a
+// Box-Muller transform rather than std::normal_distribution, whose output
+// differs between standard libraries.
+std::vector<int64_t> LogNormalLatencies(std::mt19937* rng, double median_micros,
+                                        double sigma, size_t count) {
+  auto uniform = [rng]() { return ((*rng)() + 0.5) / 4294967296.0; };
+  std::vector<int64_t> latencies;
+  for (size_t i = 0; i < count; ++i) {
+    const double normal = std::sqrt(-2 * std::log(uniform())) *
+                          std::cos(2 * M_PI * uniform());
+    latencies.push_back(
+        static_cast<int64_t>(median_micros * std::exp(sigma * normal)));
+  }
+  return latencies;
+}
+
+TEST(LatencyHistogramTest, BucketForLatency) {
+  // Small latencies get a bucket each.
+  for (int64_t latency = 0; latency < LatencyHistogram::kSubBuckets;
+       ++latency) {
+    EXPECT_EQ(LatencyHistogram::BucketForLatency(latency), latency);
+  }
+  EXPECT_EQ(LatencyHistogram::BucketForLatency(-5), 0);
+  // Above that, each power of two is split into kSubBuckets buckets.
+  EXPECT_EQ(LatencyHistogram::BucketForLatency(7), 7);
+  EXPECT_EQ(LatencyHistogram::BucketForLatency(8), 8);
+  EXPECT_EQ(LatencyHistogram::BucketForLatency(9), 8);
+  EXPECT_EQ(LatencyHistogram::BucketForLatency(10), 9);
+  EXPECT_EQ(LatencyHistogram::BucketForLatency(15), 11);
+  EXPECT_EQ(LatencyHistogram::BucketForLatency(16), 12);
+  // Huge latencies go in the last bucket.
+  EXPECT_EQ(LatencyHistogram::BucketForLatency(INT64_MAX),
+            LatencyHistogram::kNumBuckets - 1);
+  // Buckets never decrease as latencies grow.
+  size_t last_bucket = 0;
+  for (int64_t latency = 0; latency < 1000000; latency += 7) {
+    const size_t bucket = LatencyHistogram::BucketForLatency(latency);
+    EXPECT_GE(bucket, last_bucket);
+    EXPECT_LT(bucket, LatencyHistogram::kNumBuckets);
+    last_bucket = bucket;
+  }
+}
+
+TEST(LatencyHistogramTest, EmptyHistogram) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Count(), 0);
+  EXPECT_EQ(histogram.Percentile(99), 0);
+}
+
+TEST(LatencyHistogramTest, ResetClearsCounts) {
+  LatencyHistogram histogram;
+  for (int64_t latency = 1; latency <= 100; ++latency) {
+    histogram.Record(latency);
+  }
+  EXPECT_EQ(histogram.Count(), 100);
+  histogram.Reset();
+  EXPECT_EQ(histogram.Count(), 0);
+  histogram.Record(5000);
+  EXPECT_EQ(histogram.Count(), 1);
+  EXPECT_NEAR(histogram.Percentile(50), 5000, 5000.0 / 8);
+}
+
+TEST(LatencyHistogramTest, PercentilesOfUniformLatencies) {
+  LatencyHistogram histogram;
+  for (int64_t latency = 1; latency <= 10000; ++latency) {
+    histogram.Record(latency);
+  }
+  EXPECT_EQ(histogram.Count(), 10000);
+  for (double percentile : {1.0, 10.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+    const double expected = percentile * 100;
+    EXPECT_NEAR(histogram.Percentile(percentile), expected, expected / 8)
+        << "percentile " << percentile;
+  }
+}
+
+TEST(LatencyHistogramTest, PercentilesOfLogNormalLatencies) {
+  std::mt19937 rng(1);
+  const std::vector<int64_t> latencies =
+      LogNormalLatencies(&rng, /*median_micros=*/20000, /*sigma=*/0.8, 50000);
+  LatencyHistogram histogram;
+  for (int64_t latency : latencies) histogram.Record(latency);
+  for (double percentile : {50.0, 90.0, 99.0, 99.9}) {
+    const double expected = ExactPercentile(latencies, percentile);
+    EXPECT_NEAR(histogram.Percentile(percentile), expected, expected / 8)
+        << "percentile " << percentile;
+  }
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecords) {
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&histogram]() {
+      for (int64_t latency = 0; latency < 10000; ++latency) {
+        histogram.Record(latency);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(histogram.Count(), 40000);
+}
+
+TEST(LatencyEjectionThresholdTest, MeanPlusStdevs) {
+  // Mean 5, standard deviation 2.
+  const std::vector<double> latencies = {2, 4, 4, 4, 5, 5, 7, 9};
+  EXPECT_DOUBLE_EQ(LatencyEjectionThreshold(latencies, 0), 5);
+  EXPECT_DOUBLE_EQ(LatencyEjectionThreshold(latencies, 1.9), 8.8);
+}
+
+TEST(LatencyEjectionThresholdTest, SpreadBelowResolutionIsIgnored) {
+  // The standard deviation is taken to be at least 1/8 of the mean, half
+  // the width of a histogram bucket.
+  const std::vector<double> latencies = {1000, 1000, 1000, 1000, 1100};
+  EXPECT_DOUBLE_EQ(LatencyEjectionThreshold(latencies, 2), 1020 + 1020 / 4.0);
+}
+
+struct Host {
+  double median_micros;
+  double sigma;
+};
+
+// Simulates an interval of calls to a cluster and returns the hosts whose
+// p99 latency is above the ejection threshold, the way outlier detection
+// compares them.
+std::vector<size_t> FindSlowHosts(const std::vector<Host>& hosts,
+                                  double stdev_factor) {
+  std::mt19937 rng(2);
+  std::vector<double> p99s;
+  for (const Host& host : hosts) {
+    LatencyHistogram histogram;
+    for (int64_t latency :
+         LogNormalLatencies(&rng, host.median_micros, host.sigma, 2000)) {
+      histogram.Record(latency);
+    }
+    p99s.push_back(histogram.Percentile(99));
+  }
+  const double threshold = LatencyEjectionThreshold(p99s, stdev_factor);
+  std::vector<size_t> slow_hosts;
+  for (size_t i = 0; i < p99s.size(); ++i) {
+    if (p99s[i] > threshold) slow_hosts.push_back(i);
+  }
+  return slow_hosts;
+}
+
+TEST(LatencyEjectionThresholdTest, FindsSlowHost) {
+  // Ten hosts with a 10 ms median, except for one that is five times
+  // slower.
+  std::vector<Host> hosts(10, {10000, 0.5});
+  hosts[3].median_micros = 50000;
+  EXPECT_EQ(FindSlowHosts(hosts, /*stdev_factor=*/1.9),
+            std::vector<size_t>({3}));
+}
+
+TEST(LatencyEjectionThresholdTest, FindsHostWithSlowTail) {
+  // Same median everywhere, but one host has a much longer tail, the way
+  // a host pausing for garbage collection does.
+  std::vector<Host> hosts(10, {10000, 0.3});
+  hosts[7].sigma = 1.2;
+  EXPECT_EQ(FindSlowHosts(hosts, /*stdev_factor=*/1.9),
+            std::vector<size_t>({7}));
+}
+
+TEST(LatencyEjectionThresholdTest, NoSlowHostInUniformCluster) {
+  const std::vector<Host> hosts(10, {10000, 0.5});
+  EXPECT_TRUE(FindSlowHosts(hosts, /*stdev_factor=*/1.9).empty());
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,157 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/lb_policy/maglev/maglev_table.h"
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+std::vector<std::string> MakeKeys(size_t num_endpoints) {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < num_endpoints; ++i) {
+    keys.push_back(absl::StrCat("10.0.", i / 256, ".", i % 256, ":443"));
+  }
+  return keys;
+}
+
+std::vector<MaglevTable::Endpoint> MakeEndpoints(
+    const std::vector<std::string>& keys,
+    const std::vector<uint32_t>& weights = {}) {
+  std::vector<MaglevTable::Endpoint> endpoints;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    endpoints.push_back({keys[i], weights.empty() ? 1 : weights[i]});
+  }
+  return endpoints;
+}
+
+std::vector<size_t> CountSlots(const MaglevTable& table,
+                               size_t num_endpoints) {
+  std::vector<size_t> counts(num_endpoints);
+  for (size_t slot = 0; slot < table.size(); ++slot) {
+    ++counts[table.endpoint_index(slot)];
+  }
+  return counts;
+}
+
+TEST(MaglevTableTest, ValidTableSizes) {
+  EXPECT_FALSE(MaglevTable::IsValidTableSize(0));
+  EXPECT_FALSE(MaglevTable::IsValidTableSize(1));
+  EXPECT_TRUE(MaglevTable::IsValidTableSize(2));
+  EXPECT_TRUE(MaglevTable::IsValidTableSize(251));
+  EXPECT_FALSE(MaglevTable::IsValidTableSize(65536));
+  EXPECT_TRUE(MaglevTable::IsValidTableSize(MaglevTable::kDefaultTableSize));
+  EXPECT_TRUE(MaglevTable::IsValidTableSize(MaglevTable::kMaxTableSize));
+  // The next prime after the maximum.
+  EXPECT_FALSE(MaglevTable::IsValidTableSize(5000077));
+}
+
+TEST(MaglevTableTest, SingleEndpointOwnsEverySlot) {
+  const auto keys = MakeKeys(1);
+  MaglevTable table(MakeEndpoints(keys), 251);
+  EXPECT_EQ(table.size(), 251u);
+  EXPECT_EQ(CountSlots(table, 1)[0], 251u);
+}
+
+TEST(MaglevTableTest, EqualWeightsSpreadEvenly) {
+  const auto keys = MakeKeys(10);
+  MaglevTable table(MakeEndpoints(keys), MaglevTable::kDefaultTableSize);
+  for (size_t count : CountSlots(table, keys.size())) {
+    EXPECT_NEAR(count, MaglevTable::kDefaultTableSize / 10, 1);
+  }
+}
+
+TEST(MaglevTableTest, SlotsFollowWeights) {
+  const auto keys = MakeKeys(4);
+  MaglevTable table(MakeEndpoints(keys, {1, 2, 3, 4}),
+                    MaglevTable::kDefaultTableSize);
+  const std::vector<size_t> counts = CountSlots(table, keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_NEAR(counts[i], MaglevTable::kDefaultTableSize * (i + 1) / 10, 4)
+        << "endpoint " << i;
+  }
+}
+
+TEST(MaglevTableTest, ZeroWeightGetsNoSlots) {
+  const auto keys = MakeKeys(3);
+  MaglevTable table(MakeEndpoints(keys, {1, 0, 1}), 251);
+  const std::vector<size_t> counts = CountSlots(table, keys.size());
+  EXPECT_EQ(counts[1], 0u);
+  EXPECT_EQ(counts[0] + counts[2], 251u);
+}
+
+TEST(MaglevTableTest, NumEndpointsWithSlots) {
+  const auto keys = MakeKeys(10);
+  MaglevTable table(MakeEndpoints(keys, {1, 0, 1, 1, 100, 1, 0, 1, 1, 1}),
+                    251);
+  const std::vector<size_t> counts = CountSlots(table, keys.size());
+  size_t num_with_slots = 0;
+  for (size_t count : counts) {
+    if (count > 0) ++num_with_slots;
+  }
+  EXPECT_EQ(num_with_slots, 8u);
+  EXPECT_EQ(table.num_endpoints_with_slots(), 8u);
+  // More endpoints than slots: each slot has a different owner.
+  MaglevTable small_table(MakeEndpoints(MakeKeys(20)), 7);
+  EXPECT_EQ(small_table.num_endpoints_with_slots(), 7u);
+}
+
+TEST(MaglevTableTest, SameEndpointsGiveSameTable) {
+  const auto keys = MakeKeys(100);
+  MaglevTable table1(MakeEndpoints(keys), 65537);
+  MaglevTable table2(MakeEndpoints(keys), 65537);
+  for (size_t slot = 0; slot < table1.size(); ++slot) {
+    ASSERT_EQ(table1.endpoint_index(slot), table2.endpoint_index(slot));
+  }
+}
+
+TEST(MaglevTableTest, RemovingAnEndpointMovesFewOtherSlots) {
+  const auto keys = MakeKeys(100);
+  MaglevTable before(MakeEndpoints(keys), MaglevTable::kDefaultTableSize);
+  std::vector<std::string> remaining_keys = keys;
+  remaining_keys.erase(remaining_keys.begin() + 42);
+  MaglevTable after(MakeEndpoints(remaining_keys),
+                    MaglevTable::kDefaultTableSize);
+  size_t moved = 0;
+  for (size_t slot = 0; slot < before.size(); ++slot) {
+    const std::string& old_key = keys[before.endpoint_index(slot)];
+    if (old_key == keys[42]) continue;
+    if (remaining_keys[after.endpoint_index(slot)] != old_key) ++moved;
+  }
+  // The removed endpoint's 1% of the slots must move.  Maglev trades a
+  // little more disruption than a ring for an even spread, but the other
+  // endpoints should lose only a small fraction of their slots.
+  EXPECT_LT(moved, before.size() * 2 / 100);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,188 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/gpr/env.h"
+#include "src/core/lib/service_config/service_config_impl.h"
+#include "test/core/util/test_config.h"
+
+// A regular expression to enter referenced or child errors.
+#ifdef GRPC_ERROR_IS_ABSEIL_STATUS
+#define CHILD_ERROR_TAG ".*children.*"
+#else
+#define CHILD_ERROR_TAG ".*referenced_errors.*"
+#endif
+
+namespace grpc_core {
+namespace {
+
+class OutlierDetectionConfigParsingTest : public ::testing::Test {
+ public:
+  static void SetUpTestSuite() {
+    gpr_setenv("GRPC_EXPERIMENTAL_ENABLE_OUTLIER_DETECTION", "true");
+    grpc_init();
+  }
+
+  static void TearDownTestSuite() {
+    grpc_shutdown_blocking();
+    gpr_unsetenv("GRPC_EXPERIMENTAL_ENABLE_OUTLIER_DETECTION");
+  }
+
+ protected:
+  // Returns a service config with an outlier_detection_experimental policy
+  // that has the given latencyEjection field.
+  static std::string ServiceConfigWithLatencyEjection(
+      const std::string& latency_ejection) {
+    return absl::StrCat(
+        "{\n"
+        "  \"loadBalancingConfig\":[{\n"
+        "    \"outlier_detection_experimental\":{\n"
+        "      \"interval\":\"10s\",\n"
+        "      \"latencyEjection\":",
+        latency_ejection,
+        ",\n"
+        "      \"childPolicy\":[{\"round_robin\":{}}]\n"
+        "    }\n"
+        "  }]\n"
+        "}\n");
+  }
+};
+
+TEST_F(OutlierDetectionConfigParsingTest, LatencyEjectionValidConfig) {
+  const std::string service_config_json = ServiceConfigWithLatencyEjection(
+      "{\n"
+      "  \"percentile\":90,\n"
+      "  \"stdevFactor\":1000,\n"
+      "  \"enforcementPercentage\":50,\n"
+      "  \"minimumHosts\":3,\n"
+      "  \"requestVolume\":10\n"
+      "}");
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto service_config = ServiceConfigImpl::Create(
+      /*args=*/nullptr, service_config_json, &error);
+  EXPECT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_NE(service_config, nullptr);
+}
+
+TEST_F(OutlierDetectionConfigParsingTest, LatencyEjectionAllFieldsOptional) {
+  const std::string service_config_json =
+      ServiceConfigWithLatencyEjection("{}");
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto service_config = ServiceConfigImpl::Create(
+      /*args=*/nullptr, service_config_json, &error);
+  EXPECT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_NE(service_config, nullptr);
+}
+
+TEST_F(OutlierDetectionConfigParsingTest, LatencyEjectionWrongType) {
+  const std::string service_config_json =
+      ServiceConfigWithLatencyEjection("1");
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto service_config = ServiceConfigImpl::Create(
+      /*args=*/nullptr, service_config_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "outlier_detection_experimental LB policy "
+                  "config" CHILD_ERROR_TAG
+                  "field:latencyEjection error:type must be object"));
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST_F(OutlierDetectionConfigParsingTest, LatencyEjectionFieldsWrongTypes) {
+  const std::string service_config_json = ServiceConfigWithLatencyEjection(
+      "{\n"
+      "  \"percentile\":true,\n"
+      "  \"stdevFactor\":true,\n"
+      "  \"enforcementPercentage\":true,\n"
+      "  \"minimumHosts\":true,\n"
+      "  \"requestVolume\":true\n"
+      "}");
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto service_config = ServiceConfigImpl::Create(
+      /*args=*/nullptr, service_config_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "outlier_detection_experimental LB policy "
+                  "config" CHILD_ERROR_TAG
+                  "field:percentile error:type should be NUMBER or STRING.*"
+                  "field:stdevFactor error:type should be NUMBER or STRING.*"
+                  "field:enforcementPercentage error:type should be NUMBER "
+                  "or STRING.*"
+                  "field:minimumHosts error:type should be NUMBER or STRING.*"
+                  "field:requestVolume error:type should be NUMBER or "
+                  "STRING"));
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST_F(OutlierDetectionConfigParsingTest, LatencyEjectionPercentileZero) {
+  const std::string service_config_json =
+      ServiceConfigWithLatencyEjection("{\"percentile\":0}");
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto service_config = ServiceConfigImpl::Create(
+      /*args=*/nullptr, service_config_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "outlier_detection_experimental LB policy "
+                  "config" CHILD_ERROR_TAG
+                  "field:latencyEjection.percentile error:must be in "
+                  "\\[1, 100\\]"));
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST_F(OutlierDetectionConfigParsingTest, LatencyEjectionPercentileTooLarge) {
+  const std::string service_config_json =
+      ServiceConfigWithLatencyEjection("{\"percentile\":101}");
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto service_config = ServiceConfigImpl::Create(
+      /*args=*/nullptr, service_config_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "outlier_detection_experimental LB policy "
+                  "config" CHILD_ERROR_TAG
+                  "field:latencyEjection.percentile error:must be in "
+                  "\\[1, 100\\]"));
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST_F(OutlierDetectionConfigParsingTest, LatencyEjectionPercentileBounds) {
+  for (const char* percentile : {"1", "100"}) {
+    const std::string service_config_json = ServiceConfigWithLatencyEjection(
+        absl::StrCat("{\"percentile\":", percentile, "}"));
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    auto service_config = ServiceConfigImpl::Create(
+        /*args=*/nullptr, service_config_json, &error);
+    EXPECT_EQ(error, GRPC_ERROR_NONE)
+        << percentile << ": " << grpc_error_std_string(error);
+    EXPECT_NE(service_config, nullptr) << percentile;
+  }
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,95 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.h"
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "absl/strings/match.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+ServerAddressList MakeAddresses(const std::vector<std::string>& hostports) {
+  ServerAddressList addresses;
+  for (const std::string& hostport : hostports) {
+    grpc_resolved_address address;
+    if (absl::StartsWith(hostport, "[")) {
+      GPR_ASSERT(grpc_parse_ipv6_hostport(hostport, &address,
+                                          /*log_errors=*/true));
+    } else {
+      GPR_ASSERT(grpc_parse_ipv4_hostport(hostport, &address,
+                                          /*log_errors=*/true));
+    }
+    addresses.emplace_back(address, nullptr);
+  }
+  return addresses;
+}
+
+std::vector<std::string> ToStrings(const ServerAddressList& addresses) {
+  std::vector<std::string> hostports;
+  for (const ServerAddress& address : addresses) {
+    hostports.push_back(
+        grpc_sockaddr_to_string(&address.address(), false).value());
+  }
+  return hostports;
+}
+
+TEST(InterleaveAddressFamiliesTest, Empty) {
+  EXPECT_TRUE(InterleaveAddressFamilies({}).empty());
+}
+
+TEST(InterleaveAddressFamiliesTest, SingleFamilyKeepsOrder) {
+  const std::vector<std::string> hostports = {"127.0.0.3:443", "127.0.0.1:443",
+                                              "127.0.0.2:443"};
+  EXPECT_EQ(ToStrings(InterleaveAddressFamilies(MakeAddresses(hostports))),
+            hostports);
+}
+
+TEST(InterleaveAddressFamiliesTest, StartsWithFamilyOfFirstAddress) {
+  EXPECT_THAT(
+      ToStrings(InterleaveAddressFamilies(MakeAddresses(
+          {"[::1]:1", "[::2]:2", "[::3]:3", "127.0.0.1:4", "127.0.0.2:5"}))),
+      ::testing::ElementsAre("[::1]:1", "127.0.0.1:4", "[::2]:2",
+                             "127.0.0.2:5", "[::3]:3"));
+  EXPECT_THAT(
+      ToStrings(InterleaveAddressFamilies(MakeAddresses(
+          {"127.0.0.1:1", "[::1]:2", "[::2]:3", "[::3]:4", "127.0.0.2:5"}))),
+      ::testing::ElementsAre("127.0.0.1:1", "[::1]:2", "127.0.0.2:5",
+                             "[::2]:3", "[::3]:4"));
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,198 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_cache.h"
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_resolver_selection.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/iomgr/resolve_address.h"
+#include "src/core/lib/iomgr/work_serializer.h"
+#include "src/core/lib/resolver/resolver.h"
+#include "src/core/lib/resolver/resolver_registry.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+DNSResolver* g_default_dns_resolver;
+std::atomic<int> g_resolution_count{0};
+
+// Counts the system-level resolutions that the native resolver starts.
+class CountingDNSResolver : public DNSResolver {
+ public:
+  TaskHandle ResolveName(
+      absl::string_view name, absl::string_view default_port,
+      grpc_pollset_set* interested_parties,
+      std::function<void(absl::StatusOr<std::vector<grpc_resolved_address>>)>
+          on_done) override {
+    ++g_resolution_count;
+    return g_default_dns_resolver->ResolveName(
+        name, default_port, interested_parties, std::move(on_done));
+  }
+
+  absl::StatusOr<std::vector<grpc_resolved_address>> ResolveNameBlocking(
+      absl::string_view name, absl::string_view default_port) override {
+    return g_default_dns_resolver->ResolveNameBlocking(name, default_port);
+  }
+
+  bool Cancel(TaskHandle handle) override {
+    return g_default_dns_resolver->Cancel(handle);
+  }
+};
+
+class NativeDNSCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    DNSCache::Get()->Clear();
+    g_resolution_count = 0;
+    pollset_ = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(pollset_, &mu_);
+    pollset_set_ = grpc_pollset_set_create();
+    grpc_pollset_set_add_pollset(pollset_set_, pollset_);
+    work_serializer_ = std::make_shared<WorkSerializer>();
+  }
+
+  void TearDown() override {
+    ExecCtx exec_ctx;
+    grpc_pollset_set_del_pollset(pollset_set_, pollset_);
+    grpc_pollset_set_destroy(pollset_set_);
+    grpc_closure on_shutdown;
+    GRPC_CLOSURE_INIT(
+        &on_shutdown, [](void*, grpc_error_handle) {}, nullptr,
+        grpc_schedule_on_exec_ctx);
+    grpc_pollset_shutdown(pollset_, &on_shutdown);
+    ExecCtx::Get()->Flush();
+    grpc_pollset_destroy(pollset_);
+    gpr_free(pollset_);
+  }
+
+  // Resolves localhost with a new native resolver, and returns whether it
+  // found any addresses.
+  absl::Status Resolve(const grpc_channel_args* args) {
+    struct State {
+      gpr_mu* mu;
+      grpc_pollset* pollset;
+      std::atomic<bool> done{false};
+      absl::Status status;
+    } state;
+    state.mu = mu_;
+    state.pollset = pollset_;
+    class ResultHandler : public Resolver::ResultHandler {
+     public:
+      explicit ResultHandler(State* state) : state_(state) {}
+
+      void ReportResult(Resolver::Result result) override {
+        if (state_->done) return;
+        if (!result.addresses.ok()) {
+          state_->status = result.addresses.status();
+        } else if (result.addresses->empty()) {
+          state_->status = absl::NotFoundError("no addresses");
+        }
+        state_->done = true;
+        gpr_mu_lock(state_->mu);
+        GRPC_LOG_IF_ERROR("pollset_kick",
+                          grpc_pollset_kick(state_->pollset, nullptr));
+        gpr_mu_unlock(state_->mu);
+      }
+
+     private:
+      State* state_;
+    };
+    ExecCtx exec_ctx;
+    OrphanablePtr<Resolver> resolver =
+        CoreConfiguration::Get().resolver_registry().CreateResolver(
+            "dns:///localhost:443", args, pollset_set_, work_serializer_,
+            absl::make_unique<ResultHandler>(&state));
+    work_serializer_->Run([&resolver]() { resolver->StartLocked(); },
+                          DEBUG_LOCATION);
+    ExecCtx::Get()->Flush();
+    const Timestamp deadline = ExecCtx::Get()->Now() + Duration::Seconds(10);
+    while (!state.done) {
+      EXPECT_LT(ExecCtx::Get()->Now(), deadline);
+      if (ExecCtx::Get()->Now() >= deadline) break;
+      grpc_pollset_worker* worker = nullptr;
+      gpr_mu_lock(mu_);
+      GRPC_LOG_IF_ERROR(
+          "pollset_work",
+          grpc_pollset_work(pollset_, &worker,
+                            ExecCtx::Get()->Now() + Duration::Seconds(1)));
+      gpr_mu_unlock(mu_);
+      ExecCtx::Get()->Flush();
+    }
+    work_serializer_->Run([&resolver]() { resolver.reset(); }, DEBUG_LOCATION);
+    ExecCtx::Get()->Flush();
+    return state.status;
+  }
+
+  gpr_mu* mu_;
+  grpc_pollset* pollset_;
+  grpc_pollset_set* pollset_set_;
+  std::shared_ptr<WorkSerializer> work_serializer_;
+};
+
+TEST_F(NativeDNSCacheTest, ResolversShareLookups) {
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_DNS_CACHE_TTL_MS), 60000);
+  grpc_channel_args args = {1, &arg};
+  for (int i = 0; i < 3; ++i) {
+    absl::Status status = Resolve(&args);
+    ASSERT_TRUE(status.ok()) << status;
+  }
+  EXPECT_EQ(g_resolution_count.load(), 1);
+  DNSCache::Stats stats = DNSCache::Get()->stats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, 2);
+}
+
+TEST_F(NativeDNSCacheTest, CacheIsOffByDefault) {
+  for (int i = 0; i < 3; ++i) {
+    absl::Status status = Resolve(nullptr);
+    ASSERT_TRUE(status.ok()) << status;
+  }
+  EXPECT_EQ(g_resolution_count.load(), 3);
+  EXPECT_EQ(DNSCache::Get()->stats().misses, 0);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  GPR_GLOBAL_CONFIG_SET(grpc_dns_resolver, "native");
+  grpc_init();
+  grpc_core::testing::g_default_dns_resolver = grpc_core::GetDNSResolver();
+  grpc_core::SetDNSResolver(new grpc_core::testing::CountingDNSResolver());
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,467 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_cache.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_format.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_resolver_selection.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/iomgr/work_serializer.h"
+#include "src/core/lib/resolver/resolver.h"
+#include "src/core/lib/resolver/resolver_registry.h"
+#include "test/core/util/fake_udp_and_tcp_server.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+//
+// DNSCache tests, with fetches that the tests finish by hand
+//
+
+class NoopRequest : public Orphanable {
+ public:
+  void Orphan() override { delete this; }
+};
+
+// Records the fetches that the cache starts, so that tests can finish them.
+class FakeFetcher {
+ public:
+  DNSCache::FetchFunction fetch_function() {
+    return [this](grpc_pollset_set* /*interested_parties*/,
+                  DNSCache::ResultCallback on_done) {
+      pending_.push_back(std::move(on_done));
+      ++num_started_;
+      return OrphanablePtr<Orphanable>(new NoopRequest());
+    };
+  }
+
+  size_t num_started() const { return num_started_; }
+  size_t num_pending() const { return pending_.size(); }
+
+  // Finishes the oldest pending fetch.
+  void Finish(absl::StatusOr<DNSCache::Result> result) {
+    ASSERT_FALSE(pending_.empty());
+    DNSCache::ResultCallback on_done = std::move(pending_.front());
+    pending_.pop_front();
+    on_done(std::move(result));
+  }
+
+ private:
+  std::deque<DNSCache::ResultCallback> pending_;
+  size_t num_started_ = 0;
+};
+
+// The service config is unused by the cache, so tests use it to tell
+// results apart.
+DNSCache::Result MakeResult(const std::string& tag) {
+  DNSCache::Result result;
+  result.service_config_json = tag;
+  return result;
+}
+
+struct LookupResult {
+  bool done = false;
+  absl::StatusOr<DNSCache::Result> result;
+
+  // Returns the tag of the result, or the error.
+  std::string tag() const {
+    if (!result.ok()) return result.status().ToString();
+    return result->service_config_json.value_or("");
+  }
+};
+
+class DNSCacheTest : public ::testing::Test {
+ protected:
+  OrphanablePtr<Orphanable> Lookup(const std::string& key,
+                                   const DNSCache::Options& options,
+                                   LookupResult* lookup_result) {
+    return cache_.Lookup(key, options, /*interested_parties=*/nullptr,
+                         fetcher_.fetch_function(),
+                         [lookup_result](absl::StatusOr<DNSCache::Result> r) {
+                           lookup_result->done = true;
+                           lookup_result->result = std::move(r);
+                         });
+  }
+
+  static DNSCache::Options Options(int ttl_ms, int max_stale_ms) {
+    DNSCache::Options options;
+    options.ttl = Duration::Milliseconds(ttl_ms);
+    options.max_stale = Duration::Milliseconds(max_stale_ms);
+    return options;
+  }
+
+  // Moves the time that the cache sees forward, without sleeping.
+  void AdvanceClock(Duration duration) {
+    exec_ctx_.TestOnlySetNow(exec_ctx_.Now() + duration);
+  }
+
+  ExecCtx exec_ctx_;
+  DNSCache cache_;
+  FakeFetcher fetcher_;
+};
+
+TEST_F(DNSCacheTest, FreshResultIsShared) {
+  LookupResult first;
+  auto request = Lookup("name", Options(60000, 0), &first);
+  EXPECT_FALSE(first.done);
+  fetcher_.Finish(MakeResult("v1"));
+  EXPECT_TRUE(first.done);
+  EXPECT_EQ(first.tag(), "v1");
+  LookupResult second;
+  request = Lookup("name", Options(60000, 0), &second);
+  EXPECT_TRUE(second.done);
+  EXPECT_EQ(second.tag(), "v1");
+  EXPECT_EQ(fetcher_.num_started(), 1);
+  DNSCache::Stats stats = cache_.stats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, 1);
+}
+
+TEST_F(DNSCacheTest, KeysAreIndependent) {
+  LookupResult a;
+  LookupResult b;
+  auto request_a = Lookup("a", Options(60000, 0), &a);
+  auto request_b = Lookup("b", Options(60000, 0), &b);
+  EXPECT_EQ(fetcher_.num_started(), 2);
+  fetcher_.Finish(MakeResult("a"));
+  fetcher_.Finish(MakeResult("b"));
+  EXPECT_EQ(a.tag(), "a");
+  EXPECT_EQ(b.tag(), "b");
+}
+
+TEST_F(DNSCacheTest, ConcurrentLookupsShareFetch) {
+  LookupResult results[3];
+  std::vector<OrphanablePtr<Orphanable>> requests;
+  for (LookupResult& result : results) {
+    requests.push_back(Lookup("name", Options(60000, 0), &result));
+  }
+  EXPECT_EQ(fetcher_.num_started(), 1);
+  for (LookupResult& result : results) EXPECT_FALSE(result.done);
+  fetcher_.Finish(MakeResult("v1"));
+  for (LookupResult& result : results) EXPECT_EQ(result.tag(), "v1");
+  DNSCache::Stats stats = cache_.stats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.coalesced, 2);
+}
+
+TEST_F(DNSCacheTest, StaleResultIsServedWhileRefreshing) {
+  LookupResult result;
+  auto request = Lookup("name", Options(50, 60000), &result);
+  fetcher_.Finish(MakeResult("v1"));
+  AdvanceClock(Duration::Milliseconds(100));
+  // The first lookup starts a refresh and waits for it, and the second
+  // gets the stale result at once.
+  LookupResult refreshing;
+  auto refreshing_request = Lookup("name", Options(50, 60000), &refreshing);
+  EXPECT_FALSE(refreshing.done);
+  LookupResult stale;
+  request = Lookup("name", Options(50, 60000), &stale);
+  EXPECT_EQ(stale.tag(), "v1");
+  EXPECT_EQ(fetcher_.num_started(), 2);
+  fetcher_.Finish(MakeResult("v2"));
+  EXPECT_EQ(refreshing.tag(), "v2");
+  LookupResult fresh;
+  request = Lookup("name", Options(50, 60000), &fresh);
+  EXPECT_EQ(fresh.tag(), "v2");
+  EXPECT_EQ(fetcher_.num_started(), 2);
+  DNSCache::Stats stats = cache_.stats();
+  EXPECT_EQ(stats.stale_hits, 1);
+  EXPECT_EQ(stats.refreshes, 1);
+  EXPECT_EQ(stats.hits, 1);
+}
+
+TEST_F(DNSCacheTest, RefreshWithoutWaitersIsJoined) {
+  LookupResult result;
+  auto request = Lookup("name", Options(50, 60000), &result);
+  fetcher_.Finish(MakeResult("v1"));
+  AdvanceClock(Duration::Milliseconds(100));
+  LookupResult orphaned;
+  request = Lookup("name", Options(50, 60000), &orphaned);
+  request.reset();
+  // Nothing drives the refresh any more, so the next lookup waits for it
+  // rather than getting the stale result.
+  LookupResult joined;
+  request = Lookup("name", Options(50, 60000), &joined);
+  EXPECT_FALSE(joined.done);
+  EXPECT_EQ(fetcher_.num_started(), 2);
+  fetcher_.Finish(MakeResult("v2"));
+  EXPECT_FALSE(orphaned.done);
+  EXPECT_EQ(joined.tag(), "v2");
+  DNSCache::Stats stats = cache_.stats();
+  EXPECT_EQ(stats.stale_hits, 0);
+  EXPECT_EQ(stats.coalesced, 1);
+}
+
+TEST_F(DNSCacheTest, ExpiredResultIsNotServed) {
+  LookupResult result;
+  auto request = Lookup("name", Options(50, 0), &result);
+  fetcher_.Finish(MakeResult("v1"));
+  AdvanceClock(Duration::Milliseconds(100));
+  LookupResult expired;
+  request = Lookup("name", Options(50, 0), &expired);
+  EXPECT_FALSE(expired.done);
+  EXPECT_EQ(fetcher_.num_pending(), 1);
+  fetcher_.Finish(MakeResult("v2"));
+  EXPECT_EQ(expired.tag(), "v2");
+}
+
+TEST_F(DNSCacheTest, FailuresAreNotCached) {
+  LookupResult failed;
+  auto request = Lookup("name", Options(60000, 0), &failed);
+  fetcher_.Finish(absl::UnavailableError("no such name"));
+  EXPECT_TRUE(failed.done);
+  EXPECT_FALSE(failed.result.ok());
+  LookupResult retried;
+  request = Lookup("name", Options(60000, 0), &retried);
+  EXPECT_FALSE(retried.done);
+  EXPECT_EQ(fetcher_.num_started(), 2);
+  fetcher_.Finish(MakeResult("v1"));
+  EXPECT_EQ(retried.tag(), "v1");
+}
+
+TEST_F(DNSCacheTest, FailedRefreshKeepsStaleResult) {
+  LookupResult result;
+  auto request = Lookup("name", Options(50, 60000), &result);
+  fetcher_.Finish(MakeResult("v1"));
+  AdvanceClock(Duration::Milliseconds(100));
+  LookupResult refreshing;
+  request = Lookup("name", Options(50, 60000), &refreshing);
+  fetcher_.Finish(absl::UnavailableError("server down"));
+  // The lookup that started the refresh gets the stale result, and the
+  // next lookup tries again.
+  EXPECT_EQ(refreshing.tag(), "v1");
+  LookupResult refreshing_again;
+  request = Lookup("name", Options(50, 60000), &refreshing_again);
+  EXPECT_FALSE(refreshing_again.done);
+  EXPECT_EQ(fetcher_.num_started(), 3);
+  fetcher_.Finish(MakeResult("v2"));
+  EXPECT_EQ(refreshing_again.tag(), "v2");
+}
+
+TEST_F(DNSCacheTest, OrphanedLookupDoesNotCancelFetch) {
+  LookupResult orphaned;
+  LookupResult waiting;
+  auto orphaned_request = Lookup("name", Options(60000, 0), &orphaned);
+  auto waiting_request = Lookup("name", Options(60000, 0), &waiting);
+  orphaned_request.reset();
+  fetcher_.Finish(MakeResult("v1"));
+  EXPECT_FALSE(orphaned.done);
+  EXPECT_EQ(waiting.tag(), "v1");
+  // The result was cached even though one of its lookups went away.
+  LookupResult cached;
+  waiting_request = Lookup("name", Options(60000, 0), &cached);
+  EXPECT_EQ(cached.tag(), "v1");
+  EXPECT_EQ(fetcher_.num_started(), 1);
+}
+
+//
+// End-to-end tests of the c-ares resolver against a fake DNS server
+//
+
+// Answers every A query with 10.0.0.1, and every other query with no
+// records, and counts the A queries.
+std::string AnswerDnsQuery(absl::string_view query,
+                           std::atomic<int>* num_a_queries) {
+  // A 12-byte header, then one question: a name, a type and a class.
+  if (query.size() < 12) return "";
+  size_t pos = 12;
+  while (pos < query.size() && query[pos] != 0) {
+    pos += static_cast<uint8_t>(query[pos]) + 1;
+  }
+  pos += 1;
+  if (pos + 4 > query.size()) return "";
+  const int qtype = (static_cast<uint8_t>(query[pos]) << 8) |
+                    static_cast<uint8_t>(query[pos + 1]);
+  pos += 4;
+  const bool is_a = qtype == 1;
+  if (is_a) num_a_queries->fetch_add(1);
+  std::string response(query.substr(0, pos));
+  // A response, recursion desired and available, no error.
+  response[2] = '\x81';
+  response[3] = '\x80';
+  // One answer for A queries, and no authority or additional records.
+  response[6] = 0;
+  response[7] = is_a ? 1 : 0;
+  for (size_t i = 8; i < 12; ++i) response[i] = 0;
+  if (is_a) {
+    // The question's name, type A, class IN, a TTL of 60 seconds and the
+    // address.
+    const char answer[] = {'\xc0', 0x0c, 0, 1, 0, 1,  0, 0,
+                           0,      60,   0, 4, 10, 0, 0, 1};
+    response.append(answer, sizeof(answer));
+  }
+  return response;
+}
+
+class AresDNSCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    DNSCache::Get()->Clear();
+    pollset_ = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(pollset_, &mu_);
+    pollset_set_ = grpc_pollset_set_create();
+    grpc_pollset_set_add_pollset(pollset_set_, pollset_);
+    work_serializer_ = std::make_shared<WorkSerializer>();
+  }
+
+  void TearDown() override {
+    ExecCtx exec_ctx;
+    grpc_pollset_set_del_pollset(pollset_set_, pollset_);
+    grpc_pollset_set_destroy(pollset_set_);
+    grpc_closure on_shutdown;
+    GRPC_CLOSURE_INIT(
+        &on_shutdown, [](void*, grpc_error_handle) {}, nullptr,
+        grpc_schedule_on_exec_ctx);
+    grpc_pollset_shutdown(pollset_, &on_shutdown);
+    ExecCtx::Get()->Flush();
+    grpc_pollset_destroy(pollset_);
+    gpr_free(pollset_);
+  }
+
+  // Resolves name on the fake DNS server with a new resolver, and returns
+  // how many addresses it found.
+  absl::StatusOr<size_t> Resolve(const std::string& name,
+                                 const grpc_channel_args* args) {
+    struct State {
+      gpr_mu* mu;
+      grpc_pollset* pollset;
+      std::atomic<bool> done{false};
+      absl::StatusOr<size_t> num_addresses;
+    } state;
+    state.mu = mu_;
+    state.pollset = pollset_;
+    class ResultHandler : public Resolver::ResultHandler {
+     public:
+      explicit ResultHandler(State* state) : state_(state) {}
+
+      void ReportResult(Resolver::Result result) override {
+        if (state_->done) return;
+        if (result.addresses.ok()) {
+          state_->num_addresses = result.addresses->size();
+        } else {
+          state_->num_addresses = result.addresses.status();
+        }
+        state_->done = true;
+        gpr_mu_lock(state_->mu);
+        GRPC_LOG_IF_ERROR("pollset_kick",
+                          grpc_pollset_kick(state_->pollset, nullptr));
+        gpr_mu_unlock(state_->mu);
+      }
+
+     private:
+      State* state_;
+    };
+    ExecCtx exec_ctx;
+    std::string target = absl::StrFormat("dns://[::1]:%d/%s:443",
+                                         fake_dns_server_.port(), name);
+    OrphanablePtr<Resolver> resolver =
+        CoreConfiguration::Get().resolver_registry().CreateResolver(
+            target.c_str(), args, pollset_set_, work_serializer_,
+            absl::make_unique<ResultHandler>(&state));
+    work_serializer_->Run([&resolver]() { resolver->StartLocked(); },
+                          DEBUG_LOCATION);
+    ExecCtx::Get()->Flush();
+    const Timestamp deadline = ExecCtx::Get()->Now() + Duration::Seconds(10);
+    while (!state.done) {
+      EXPECT_LT(ExecCtx::Get()->Now(), deadline);
+      if (ExecCtx::Get()->Now() >= deadline) break;
+      grpc_pollset_worker* worker = nullptr;
+      gpr_mu_lock(mu_);
+      GRPC_LOG_IF_ERROR(
+          "pollset_work",
+          grpc_pollset_work(pollset_, &worker,
+                            ExecCtx::Get()->Now() + Duration::Seconds(1)));
+      gpr_mu_unlock(mu_);
+      ExecCtx::Get()->Flush();
+    }
+    work_serializer_->Run([&resolver]() { resolver.reset(); }, DEBUG_LOCATION);
+    ExecCtx::Get()->Flush();
+    return state.num_addresses;
+  }
+
+  std::atomic<int> num_a_queries_{0};
+  FakeUdpAndTcpServer fake_dns_server_{
+      FakeUdpAndTcpServer::AcceptMode::kWaitForClientToSendFirstBytes,
+      FakeUdpAndTcpServer::CloseSocketUponCloseFromPeer,
+      [this](absl::string_view query) {
+        return AnswerDnsQuery(query, &num_a_queries_);
+      }};
+  gpr_mu* mu_;
+  grpc_pollset* pollset_;
+  grpc_pollset_set* pollset_set_;
+  std::shared_ptr<WorkSerializer> work_serializer_;
+};
+
+TEST_F(AresDNSCacheTest, ResolversShareLookups) {
+  grpc_arg arg =
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_DNS_CACHE_TTL_MS), 60000);
+  grpc_channel_args args = {1, &arg};
+  for (int i = 0; i < 3; ++i) {
+    absl::StatusOr<size_t> num_addresses = Resolve("cached.test.com", &args);
+    ASSERT_TRUE(num_addresses.ok()) << num_addresses.status();
+    EXPECT_EQ(*num_addresses, 1);
+  }
+  EXPECT_EQ(num_a_queries_.load(), 1);
+  DNSCache::Stats stats = DNSCache::Get()->stats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, 2);
+}
+
+TEST_F(AresDNSCacheTest, CacheIsOffByDefault) {
+  for (int i = 0; i < 3; ++i) {
+    absl::StatusOr<size_t> num_addresses =
+        Resolve("uncached.test.com", nullptr);
+    ASSERT_TRUE(num_addresses.ok()) << num_addresses.status();
+    EXPECT_EQ(*num_addresses, 1);
+  }
+  EXPECT_EQ(num_a_queries_.load(), 3);
+  EXPECT_EQ(DNSCache::Get()->stats().misses, 0);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  GPR_GLOBAL_CONFIG_SET(grpc_dns_resolver, "ares");
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -65,6 +65,26 @@ TEST(ServerRetryThrottleData, Basic) {
   EXPECT_TRUE(throttle_data->RecordFailure());
 }
 
+TEST(ServerRetryThrottleData, IsThrottled) {
+  // Max token count is 4, so threshold for retrying is 2.
+  // Token count starts at 4.
+  // Each failure decrements by 1.  Each success increments by 1.
+  auto throttle_data =
+      MakeRefCounted<ServerRetryThrottleData>(4000, 1000, nullptr);
+  EXPECT_FALSE(throttle_data->IsThrottled());
+  // Failure: token_count=3.  Above threshold.
+  EXPECT_TRUE(throttle_data->RecordFailure());
+  EXPECT_FALSE(throttle_data->IsThrottled());
+  // Failure: token_count=2.  At threshold, so no retries.
+  EXPECT_FALSE(throttle_data->RecordFailure());
+  EXPECT_TRUE(throttle_data->IsThrottled());
+  // Checking does not change the token count.
+  EXPECT_TRUE(throttle_data->IsThrottled());
+  // Success: token_count=3.  Above threshold.
+  throttle_data->RecordSuccess();
+  EXPECT_FALSE(throttle_data->IsThrottled());
+}
+
 TEST(ServerRetryThrottleData, Replacement) {
   // Create old throttle data.
   // Max token count is 4, so threshold for retrying is 2.
@@ -0,0 +1,131 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// Returns a sequence function that counts up from zero.
+std::function<uint32_t()> MakeSequence(uint32_t* sequence) {
+  return [sequence]() { return (*sequence)++; };
+}
+
+// Returns the number of times each index is picked in \a num_picks picks.
+std::vector<size_t> CountPicks(const StaticStrideScheduler& scheduler,
+                               size_t num_backends, size_t num_picks) {
+  std::vector<size_t> counts(num_backends);
+  for (size_t i = 0; i < num_picks; ++i) ++counts[scheduler.Pick()];
+  return counts;
+}
+
+TEST(StaticStrideSchedulerTest, EmptyWeights) {
+  uint32_t sequence = 0;
+  EXPECT_FALSE(StaticStrideScheduler::Make({}, MakeSequence(&sequence))
+                   .has_value());
+}
+
+TEST(StaticStrideSchedulerTest, OneBackend) {
+  uint32_t sequence = 0;
+  const std::vector<float> weights = {1};
+  EXPECT_FALSE(StaticStrideScheduler::Make(weights, MakeSequence(&sequence))
+                   .has_value());
+}
+
+TEST(StaticStrideSchedulerTest, AllWeightsUnknown) {
+  uint32_t sequence = 0;
+  const std::vector<float> weights = {0, 0, 0};
+  EXPECT_FALSE(StaticStrideScheduler::Make(weights, MakeSequence(&sequence))
+                   .has_value());
+}
+
+TEST(StaticStrideSchedulerTest, EqualWeightsPickInRoundRobinOrder) {
+  uint32_t sequence = 0;
+  const std::vector<float> weights = {5, 5, 5};
+  auto scheduler = StaticStrideScheduler::Make(weights, MakeSequence(&sequence));
+  ASSERT_TRUE(scheduler.has_value());
+  for (size_t i = 0; i < 30; ++i) EXPECT_EQ(scheduler->Pick(), i % 3);
+}
+
+TEST(StaticStrideSchedulerTest, PicksInProportionToWeights) {
+  uint32_t sequence = 0;
+  const std::vector<float> weights = {1, 2, 4};
+  auto scheduler = StaticStrideScheduler::Make(weights, MakeSequence(&sequence));
+  ASSERT_TRUE(scheduler.has_value());
+  const std::vector<size_t> counts = CountPicks(*scheduler, 3, 70000);
+  EXPECT_NEAR(counts[0], 10000, 100);
+  EXPECT_NEAR(counts[1], 20000, 100);
+  EXPECT_NEAR(counts[2], 40000, 100);
+}
+
+TEST(StaticStrideSchedulerTest, UnknownWeightUsesMean) {
+  uint32_t sequence = 0;
+  const std::vector<float> weights = {1, 0, 3};
+  auto scheduler = StaticStrideScheduler::Make(weights, MakeSequence(&sequence));
+  ASSERT_TRUE(scheduler.has_value());
+  const std::vector<size_t> counts = CountPicks(*scheduler, 3, 60000);
+  EXPECT_NEAR(counts[0], 10000, 100);
+  EXPECT_NEAR(counts[1], 20000, 100);
+  EXPECT_NEAR(counts[2], 30000, 100);
+}
+
+TEST(StaticStrideSchedulerTest, TinyWeightIsClampedToMinRatio) {
+  uint32_t sequence = 0;
+  // The mean is ~50, so the first weight is raised to 5.
+  const std::vector<float> weights = {0.001f, 100};
+  auto scheduler = StaticStrideScheduler::Make(weights, MakeSequence(&sequence));
+  ASSERT_TRUE(scheduler.has_value());
+  const std::vector<size_t> counts = CountPicks(*scheduler, 2, 105000);
+  EXPECT_NEAR(counts[0], 5000, 100);
+  EXPECT_NEAR(counts[1], 100000, 100);
+}
+
+TEST(StaticStrideSchedulerTest, SpreadsPicksOfLightBackend) {
+  uint32_t sequence = 0;
+  const std::vector<float> weights = {1, 9};
+  auto scheduler = StaticStrideScheduler::Make(weights, MakeSequence(&sequence));
+  ASSERT_TRUE(scheduler.has_value());
+  // The light backend should not get a burst of consecutive picks.
+  size_t consecutive = 0;
+  for (size_t i = 0; i < 10000; ++i) {
+    if (scheduler->Pick() == 0) {
+      ++consecutive;
+      EXPECT_LE(consecutive, 1);
+    } else {
+      consecutive = 0;
+    }
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -19,7 +19,9 @@
 #include "src/core/lib/debug/stats.h"
 
 #include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -82,6 +84,48 @@ static int FindExpectedBucket(int i, int j) {
          grpc_stats_histo_bucket_boundaries[i] - 1;
 }
 
+static const grpc_core::MethodLatency* FindMethod(
+    const std::vector<grpc_core::MethodLatency>& latency,
+    const std::string& method) {
+  for (const auto& m : latency) {
+    if (m.method == method) return &m;
+  }
+  return nullptr;
+}
+
+TEST(StatsTest, MethodLatency) {
+  const int kHistogram = GRPC_STATS_HISTOGRAM_SERVER_CALL_LATENCY_US;
+  {
+    // Two servers may register the same method: their histograms are merged.
+    grpc_core::MethodLatencyStats a("/test.Service/A");
+    grpc_core::MethodLatencyStats a2("/test.Service/A");
+    grpc_core::MethodLatencyStats b("/test.Service/B");
+    {
+      grpc_core::ExecCtx exec_ctx;
+      a.Record(0);
+      a2.Record(0);
+      b.Record(1000);
+      b.Record(1e12);
+    }
+    std::vector<grpc_core::MethodLatency> latency =
+        grpc_core::CollectMethodLatency();
+    const grpc_core::MethodLatency* a_latency =
+        FindMethod(latency, "/test.Service/A");
+    ASSERT_NE(a_latency, nullptr);
+    EXPECT_EQ(a_latency->buckets[0], 2);
+    const grpc_core::MethodLatency* b_latency =
+        FindMethod(latency, "/test.Service/B");
+    ASSERT_NE(b_latency, nullptr);
+    EXPECT_EQ(b_latency->buckets[FindExpectedBucket(kHistogram, 1000)], 1);
+    EXPECT_EQ(b_latency->buckets[grpc_stats_histo_buckets[kHistogram] - 1], 1);
+  }
+  // Destroyed histograms are no longer reported.
+  std::vector<grpc_core::MethodLatency> latency =
+      grpc_core::CollectMethodLatency();
+  EXPECT_EQ(FindMethod(latency, "/test.Service/A"), nullptr);
+  EXPECT_EQ(FindMethod(latency, "/test.Service/B"), nullptr);
+}
+
 class HistogramTest : public ::testing::TestWithParam<int> {};
 
 TEST_P(HistogramTest, IncHistogram) {
@@ -85,6 +85,16 @@ extern void graceful_server_shutdown(grpc_end2end_test_config config);
 extern void graceful_server_shutdown_pre_init(void);
 extern void grpc_authz(grpc_end2end_test_config config);
 extern void grpc_authz_pre_init(void);
+extern void hedging(grpc_end2end_test_config config);
+extern void hedging_pre_init(void);
+extern void hedging_non_fatal_status(grpc_end2end_test_config config);
+extern void hedging_non_fatal_status_pre_init(void);
+extern void hedging_server_pushback(grpc_end2end_test_config config);
+extern void hedging_server_pushback_pre_init(void);
+extern void hedging_throttled(grpc_end2end_test_config config);
+extern void hedging_throttled_pre_init(void);
+extern void hedging_too_many_attempts(grpc_end2end_test_config config);
+extern void hedging_too_many_attempts_pre_init(void);
 extern void high_initial_seqno(grpc_end2end_test_config config);
 extern void high_initial_seqno_pre_init(void);
 extern void hpack_size(grpc_end2end_test_config config);
@@ -129,6 +139,8 @@ extern void resource_quota_server(grpc_end2end_test_config config);
 extern void resource_quota_server_pre_init(void);
 extern void retry(grpc_end2end_test_config config);
 extern void retry_pre_init(void);
+extern void retry_buffer_resource_quota(grpc_end2end_test_config config);
+extern void retry_buffer_resource_quota_pre_init(void);
 extern void retry_cancel_after_first_attempt_starts(grpc_end2end_test_config config);
 extern void retry_cancel_after_first_attempt_starts_pre_init(void);
 extern void retry_cancel_during_delay(grpc_end2end_test_config config);
@@ -249,6 +261,11 @@ void grpc_end2end_tests_pre_init(void) {
   filtered_metadata_pre_init();
   graceful_server_shutdown_pre_init();
   grpc_authz_pre_init();
+  hedging_pre_init();
+  hedging_non_fatal_status_pre_init();
+  hedging_server_pushback_pre_init();
+  hedging_throttled_pre_init();
+  hedging_too_many_attempts_pre_init();
   high_initial_seqno_pre_init();
   hpack_size_pre_init();
   invoke_large_request_pre_init();
@@ -271,6 +288,7 @@ void grpc_end2end_tests_pre_init(void) {
   request_with_payload_pre_init();
   resource_quota_server_pre_init();
   retry_pre_init();
+  retry_buffer_resource_quota_pre_init();
   retry_cancel_after_first_attempt_starts_pre_init();
   retry_cancel_during_delay_pre_init();
   retry_cancel_with_multiple_send_batches_pre_init();
@@ -353,6 +371,11 @@ void grpc_end2end_tests(int argc, char **argv,
     filtered_metadata(config);
     graceful_server_shutdown(config);
     grpc_authz(config);
+    hedging(config);
+    hedging_non_fatal_status(config);
+    hedging_server_pushback(config);
+    hedging_throttled(config);
+    hedging_too_many_attempts(config);
     high_initial_seqno(config);
     hpack_size(config);
     invoke_large_request(config);
@@ -375,6 +398,7 @@ void grpc_end2end_tests(int argc, char **argv,
     request_with_payload(config);
     resource_quota_server(config);
     retry(config);
+    retry_buffer_resource_quota(config);
     retry_cancel_after_first_attempt_starts(config);
     retry_cancel_during_delay(config);
     retry_cancel_with_multiple_send_batches(config);
@@ -535,6 +559,26 @@ void grpc_end2end_tests(int argc, char **argv,
       grpc_authz(config);
       continue;
     }
+    if (0 == strcmp("hedging", argv[i])) {
+      hedging(config);
+      continue;
+    }
+    if (0 == strcmp("hedging_non_fatal_status", argv[i])) {
+      hedging_non_fatal_status(config);
+      continue;
+    }
+    if (0 == strcmp("hedging_server_pushback", argv[i])) {
+      hedging_server_pushback(config);
+      continue;
+    }
+    if (0 == strcmp("hedging_throttled", argv[i])) {
+      hedging_throttled(config);
+      continue;
+    }
+    if (0 == strcmp("hedging_too_many_attempts", argv[i])) {
+      hedging_too_many_attempts(config);
+      continue;
+    }
     if (0 == strcmp("high_initial_seqno", argv[i])) {
       high_initial_seqno(config);
       continue;
@@ -623,6 +667,10 @@ void grpc_end2end_tests(int argc, char **argv,
       retry(config);
       continue;
     }
+    if (0 == strcmp("retry_buffer_resource_quota", argv[i])) {
+      retry_buffer_resource_quota(config);
+      continue;
+    }
     if (0 == strcmp("retry_cancel_after_first_attempt_starts", argv[i])) {
       retry_cancel_after_first_attempt_starts(config);
       continue;
@@ -226,6 +226,11 @@ END2END_TESTS = {
     "filtered_metadata": _test_options(),
     "graceful_server_shutdown": _test_options(exclude_inproc = True),
     "grpc_authz": _test_options(secure = True),
+    "hedging": _test_options(needs_client_channel = True, needs_retry = True),
+    "hedging_non_fatal_status": _test_options(needs_client_channel = True, needs_retry = True),
+    "hedging_server_pushback": _test_options(needs_client_channel = True, needs_retry = True),
+    "hedging_throttled": _test_options(needs_client_channel = True, needs_retry = True),
+    "hedging_too_many_attempts": _test_options(needs_client_channel = True, needs_retry = True),
     "hpack_size": _test_options(
         proxyable = False,
         traceable = False,
@@ -258,6 +263,11 @@ END2END_TESTS = {
     "request_with_flags": _test_options(proxyable = False),
     "request_with_payload": _test_options(),
     "retry": _test_options(needs_client_channel = True, needs_retry = True),
+    "retry_buffer_resource_quota": _test_options(
+        needs_client_channel = True,
+        needs_retry = True,
+        exclude_1byte = True,
+    ),
     "retry_cancellation": _test_options(needs_client_channel = True, needs_retry = True),
     "retry_cancel_during_delay": _test_options(needs_client_channel = True, needs_retry = True),
     "retry_cancel_with_multiple_send_batches": _test_options(
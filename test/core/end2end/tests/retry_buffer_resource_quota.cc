@@ -0,0 +1,429 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "absl/types/optional.h"
+
+#include <grpc/byte_buffer.h>
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "test/core/end2end/cq_verifier.h"
+#include "test/core/end2end/end2end_tests.h"
+
+static void* tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+static grpc_end2end_test_fixture begin_test(grpc_end2end_test_config config,
+                                            const char* test_name,
+                                            grpc_channel_args* client_args,
+                                            grpc_channel_args* server_args) {
+  grpc_end2end_test_fixture f;
+  gpr_log(GPR_INFO, "Running test: %s/%s", test_name, config.name);
+  f = config.create_fixture(client_args, server_args);
+  config.init_server(&f, server_args);
+  config.init_client(&f, client_args);
+  return f;
+}
+
+static gpr_timespec n_seconds_from_now(int n) {
+  return grpc_timeout_seconds_to_deadline(n);
+}
+
+static gpr_timespec five_seconds_from_now(void) {
+  return n_seconds_from_now(5);
+}
+
+static void drain_cq(grpc_completion_queue* cq) {
+  grpc_event ev;
+  do {
+    ev = grpc_completion_queue_next(cq, five_seconds_from_now(), nullptr);
+  } while (ev.type != GRPC_QUEUE_SHUTDOWN);
+}
+
+static void shutdown_server(grpc_end2end_test_fixture* f) {
+  if (!f->server) return;
+  grpc_server_shutdown_and_notify(f->server, f->cq, tag(1000));
+  grpc_event ev;
+  do {
+    ev = grpc_completion_queue_next(f->cq, grpc_timeout_seconds_to_deadline(5),
+                                    nullptr);
+  } while (ev.type != GRPC_OP_COMPLETE || ev.tag != tag(1000));
+  grpc_server_destroy(f->server);
+  f->server = nullptr;
+}
+
+static void shutdown_client(grpc_end2end_test_fixture* f) {
+  if (!f->client) return;
+  grpc_channel_destroy(f->client);
+  f->client = nullptr;
+}
+
+static void end_test(grpc_end2end_test_fixture* f) {
+  shutdown_server(f);
+  shutdown_client(f);
+
+  grpc_completion_queue_shutdown(f->cq);
+  drain_cq(f->cq);
+  grpc_completion_queue_destroy(f->cq);
+}
+
+// 1 retry allowed for ABORTED status.
+static const char* kRetryServiceConfig =
+    "{\n"
+    "  \"methodConfig\": [ {\n"
+    "    \"name\": [\n"
+    "      { \"service\": \"service\", \"method\": \"method\" }\n"
+    "    ],\n"
+    "    \"retryPolicy\": {\n"
+    "      \"maxAttempts\": 2,\n"
+    "      \"initialBackoff\": \"1s\",\n"
+    "      \"maxBackoff\": \"120s\",\n"
+    "      \"backoffMultiplier\": 1.6,\n"
+    "      \"retryableStatusCodes\": [ \"ABORTED\" ]\n"
+    "    }\n"
+    "  } ]\n"
+    "}";
+
+static grpc_byte_buffer* make_payload(size_t size) {
+  grpc_slice slice = grpc_slice_malloc(size);
+  memset(GRPC_SLICE_START_PTR(slice), 'a', size);
+  grpc_byte_buffer* payload = grpc_raw_byte_buffer_create(&slice, 1);
+  grpc_slice_unref(slice);
+  return payload;
+}
+
+// Returns the number of bytes in use in the quota of the given size.
+static double quota_usage(grpc_resource_quota* resource_quota,
+                          size_t quota_size) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::MemoryOwner owner = grpc_core::ResourceQuota::FromC(resource_quota)
+                                     ->memory_quota()
+                                     ->CreateMemoryOwner("quota_usage");
+  return owner.InstantaneousPressure() * quota_size;
+}
+
+// Sends one message of message_size bytes on a call whose first attempt
+// fails with ABORTED, and checks whether the call was retried.
+// If usage_quota is set, also checks that the message is charged to it
+// while the call buffers it for retries, and released once the call
+// commits.
+static void run_call(grpc_end2end_test_fixture* f, size_t message_size,
+                     bool expect_retry,
+                     grpc_resource_quota* usage_quota = nullptr,
+                     size_t usage_quota_size = 0) {
+  grpc_call* c;
+  grpc_call* s;
+  grpc_op ops[6];
+  grpc_op* op;
+  grpc_metadata_array initial_metadata_recv;
+  grpc_metadata_array trailing_metadata_recv;
+  grpc_metadata_array request_metadata_recv;
+  grpc_call_details call_details;
+  grpc_byte_buffer* request_payload = make_payload(message_size);
+  grpc_byte_buffer* request_payload_recv = nullptr;
+  grpc_status_code status;
+  grpc_call_error error;
+  grpc_slice details;
+  int was_cancelled = 2;
+
+  cq_verifier* cqv = cq_verifier_create(f->cq);
+  const double usage_before =
+      usage_quota == nullptr ? 0 : quota_usage(usage_quota, usage_quota_size);
+
+  gpr_timespec deadline = n_seconds_from_now(10);
+  c = grpc_channel_create_call(f->client, nullptr, GRPC_PROPAGATE_DEFAULTS,
+                               f->cq,
+                               grpc_slice_from_static_string("/service/method"),
+                               nullptr, deadline, nullptr);
+  GPR_ASSERT(c);
+
+  grpc_metadata_array_init(&initial_metadata_recv);
+  grpc_metadata_array_init(&trailing_metadata_recv);
+  grpc_metadata_array_init(&request_metadata_recv);
+  grpc_call_details_init(&call_details);
+  grpc_slice status_details = grpc_slice_from_static_string("xyz");
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op->data.send_initial_metadata.count = 0;
+  op++;
+  op->op = GRPC_OP_SEND_MESSAGE;
+  op->data.send_message.send_message = request_payload;
+  op++;
+  op->op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  op++;
+  op->op = GRPC_OP_RECV_INITIAL_METADATA;
+  op->data.recv_initial_metadata.recv_initial_metadata = &initial_metadata_recv;
+  op++;
+  op->op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  op->data.recv_status_on_client.trailing_metadata = &trailing_metadata_recv;
+  op->data.recv_status_on_client.status = &status;
+  op->data.recv_status_on_client.status_details = &details;
+  op++;
+  error = grpc_call_start_batch(c, ops, static_cast<size_t>(op - ops), tag(1),
+                                nullptr);
+  GPR_ASSERT(GRPC_CALL_OK == error);
+
+  // The first attempt reads the message and fails with ABORTED.
+  error =
+      grpc_server_request_call(f->server, &s, &call_details,
+                               &request_metadata_recv, f->cq, f->cq, tag(101));
+  GPR_ASSERT(GRPC_CALL_OK == error);
+  CQ_EXPECT_COMPLETION(cqv, tag(101), true);
+  cq_verify(cqv);
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_RECV_MESSAGE;
+  op->data.recv_message.recv_message = &request_payload_recv;
+  op++;
+  error = grpc_call_start_batch(s, ops, static_cast<size_t>(op - ops), tag(102),
+                                nullptr);
+  GPR_ASSERT(GRPC_CALL_OK == error);
+  CQ_EXPECT_COMPLETION(cqv, tag(102), true);
+  cq_verify(cqv);
+  GPR_ASSERT(request_payload_recv != nullptr);
+  GPR_ASSERT(grpc_byte_buffer_length(request_payload_recv) == message_size);
+  grpc_byte_buffer_destroy(request_payload_recv);
+  request_payload_recv = nullptr;
+
+  // The call has not committed yet, so it still holds the message.  The
+  // channel's allocator may already have had up to a megabyte free.
+  double usage_while_buffered = 0;
+  if (usage_quota != nullptr) {
+    usage_while_buffered = quota_usage(usage_quota, usage_quota_size);
+    gpr_log(GPR_INFO, "quota usage: %f before the call, %f while buffered",
+            usage_before, usage_while_buffered);
+    GPR_ASSERT(usage_while_buffered >= usage_before + message_size -
+                                           grpc_core::kMaxQuotaBufferSize);
+  }
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op->data.send_initial_metadata.count = 0;
+  op++;
+  op->op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  op->data.send_status_from_server.trailing_metadata_count = 0;
+  op->data.send_status_from_server.status = GRPC_STATUS_ABORTED;
+  op->data.send_status_from_server.status_details = &status_details;
+  op++;
+  op->op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  op->data.recv_close_on_server.cancelled = &was_cancelled;
+  op++;
+  error = grpc_call_start_batch(s, ops, static_cast<size_t>(op - ops), tag(103),
+                                nullptr);
+  GPR_ASSERT(GRPC_CALL_OK == error);
+  CQ_EXPECT_COMPLETION(cqv, tag(103), true);
+
+  if (expect_retry) {
+    cq_verify(cqv);
+    grpc_call_unref(s);
+    grpc_metadata_array_destroy(&request_metadata_recv);
+    grpc_metadata_array_init(&request_metadata_recv);
+    grpc_call_details_destroy(&call_details);
+    grpc_call_details_init(&call_details);
+    // The second attempt replays the message and succeeds.
+    error = grpc_server_request_call(f->server, &s, &call_details,
+                                     &request_metadata_recv, f->cq, f->cq,
+                                     tag(201));
+    GPR_ASSERT(GRPC_CALL_OK == error);
+    CQ_EXPECT_COMPLETION(cqv, tag(201), true);
+    cq_verify(cqv);
+
+    memset(ops, 0, sizeof(ops));
+    op = ops;
+    op->op = GRPC_OP_RECV_MESSAGE;
+    op->data.recv_message.recv_message = &request_payload_recv;
+    op++;
+    op->op = GRPC_OP_SEND_INITIAL_METADATA;
+    op->data.send_initial_metadata.count = 0;
+    op++;
+    op->op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+    op->data.send_status_from_server.trailing_metadata_count = 0;
+    op->data.send_status_from_server.status = GRPC_STATUS_OK;
+    op->data.send_status_from_server.status_details = &status_details;
+    op++;
+    op->op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+    op->data.recv_close_on_server.cancelled = &was_cancelled;
+    op++;
+    error = grpc_call_start_batch(s, ops, static_cast<size_t>(op - ops),
+                                  tag(202), nullptr);
+    GPR_ASSERT(GRPC_CALL_OK == error);
+    CQ_EXPECT_COMPLETION(cqv, tag(202), true);
+  }
+  CQ_EXPECT_COMPLETION(cqv, tag(1), true);
+  cq_verify(cqv);
+
+  GPR_ASSERT(status == (expect_retry ? GRPC_STATUS_OK : GRPC_STATUS_ABORTED));
+  GPR_ASSERT(0 == grpc_slice_str_cmp(details, "xyz"));
+  GPR_ASSERT(was_cancelled == 0);
+  if (expect_retry) {
+    GPR_ASSERT(request_payload_recv != nullptr);
+    GPR_ASSERT(grpc_byte_buffer_length(request_payload_recv) == message_size);
+  }
+
+  // The call has committed and freed the message, but is still alive.
+  // The allocator keeps up to half a megabyte for reuse and gives the rest
+  // back to the quota; reads since then may have taken a little more.
+  if (usage_quota != nullptr) {
+    const double usage_after_commit =
+        quota_usage(usage_quota, usage_quota_size);
+    gpr_log(GPR_INFO, "quota usage: %f after commit", usage_after_commit);
+    GPR_ASSERT(usage_after_commit <= usage_while_buffered - message_size +
+                                         grpc_core::kMaxQuotaBufferSize);
+  }
+
+  grpc_slice_unref(details);
+  grpc_metadata_array_destroy(&initial_metadata_recv);
+  grpc_metadata_array_destroy(&trailing_metadata_recv);
+  grpc_metadata_array_destroy(&request_metadata_recv);
+  grpc_call_details_destroy(&call_details);
+  grpc_byte_buffer_destroy(request_payload);
+  grpc_byte_buffer_destroy(request_payload_recv);
+
+  grpc_call_unref(c);
+  grpc_call_unref(s);
+
+  cq_verifier_destroy(cqv);
+}
+
+// Without GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE and with a quota that has no
+// size, the retry buffer is limited to 256 KiB.
+static void test_default_limit_without_quota_size(
+    grpc_end2end_test_config config) {
+  grpc_arg args[] = {
+      grpc_channel_arg_string_create(const_cast<char*>(GRPC_ARG_SERVICE_CONFIG),
+                                     const_cast<char*>(kRetryServiceConfig)),
+  };
+  grpc_channel_args client_args = {GPR_ARRAY_SIZE(args), args};
+  grpc_end2end_test_fixture f =
+      begin_test(config, "retry_buffer_default_limit_without_quota_size",
+                 &client_args, nullptr);
+  run_call(&f, 128 * 1024, /*expect_retry=*/true);
+  run_call(&f, 256 * 1024 + 1, /*expect_retry=*/false);
+  end_test(&f);
+  config.tear_down_data(&f);
+}
+
+// Without GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE, the retry buffer is limited
+// to the largest allocation the quota recommends, 1/16 of its size.
+static void test_default_limit_from_quota(grpc_end2end_test_config config) {
+  const size_t kQuotaSize = 16 * 1024 * 1024;
+  grpc_resource_quota* resource_quota =
+      grpc_resource_quota_create("retry_buffer_default_limit_from_quota");
+  grpc_resource_quota_resize(resource_quota, kQuotaSize);
+  grpc_arg args[] = {
+      grpc_channel_arg_string_create(const_cast<char*>(GRPC_ARG_SERVICE_CONFIG),
+                                     const_cast<char*>(kRetryServiceConfig)),
+      grpc_channel_arg_pointer_create(
+          const_cast<char*>(GRPC_ARG_RESOURCE_QUOTA), resource_quota,
+          grpc_resource_quota_arg_vtable()),
+  };
+  grpc_channel_args client_args = {GPR_ARRAY_SIZE(args), args};
+  grpc_end2end_test_fixture f = begin_test(
+      config, "retry_buffer_default_limit_from_quota", &client_args, nullptr);
+  run_call(&f, kQuotaSize / 32, /*expect_retry=*/true);
+  run_call(&f, kQuotaSize / 16 + 1, /*expect_retry=*/false);
+  end_test(&f);
+  config.tear_down_data(&f);
+  grpc_resource_quota_unref(resource_quota);
+}
+
+// A call commits instead of buffering for retries while the quota is under
+// high memory pressure, however small its messages.
+static void test_commits_under_memory_pressure(
+    grpc_end2end_test_config config) {
+  const size_t kQuotaSize = 16 * 1024 * 1024;
+  grpc_resource_quota* resource_quota =
+      grpc_resource_quota_create("retry_buffer_commits_under_memory_pressure");
+  grpc_resource_quota_resize(resource_quota, kQuotaSize);
+  grpc_arg args[] = {
+      grpc_channel_arg_string_create(const_cast<char*>(GRPC_ARG_SERVICE_CONFIG),
+                                     const_cast<char*>(kRetryServiceConfig)),
+      grpc_channel_arg_pointer_create(
+          const_cast<char*>(GRPC_ARG_RESOURCE_QUOTA), resource_quota,
+          grpc_resource_quota_arg_vtable()),
+  };
+  grpc_channel_args client_args = {GPR_ARRAY_SIZE(args), args};
+  grpc_end2end_test_fixture f = begin_test(
+      config, "retry_buffer_commits_under_memory_pressure", &client_args,
+      nullptr);
+  auto memory_quota =
+      grpc_core::ResourceQuota::FromC(resource_quota)->memory_quota();
+  absl::optional<grpc_core::MemoryAllocator> pressure;
+  {
+    grpc_core::ExecCtx exec_ctx;
+    pressure.emplace(memory_quota->CreateMemoryAllocator("pressure"));
+    pressure->Reserve(grpc_core::MemoryRequest(kQuotaSize * 15 / 16));
+  }
+  GPR_ASSERT(memory_quota->IsMemoryPressureHigh());
+  run_call(&f, 1024, /*expect_retry=*/false);
+  {
+    grpc_core::ExecCtx exec_ctx;
+    pressure->Release(kQuotaSize * 15 / 16);
+    pressure.reset();
+  }
+  // The same call is retried once the pressure is gone.
+  GPR_ASSERT(!memory_quota->IsMemoryPressureHigh());
+  run_call(&f, 1024, /*expect_retry=*/true);
+  end_test(&f);
+  config.tear_down_data(&f);
+  grpc_resource_quota_unref(resource_quota);
+}
+
+// Buffered messages are charged to the call's memory allocator, and given
+// back when the call commits.
+static void test_buffer_charged_to_quota(grpc_end2end_test_config config) {
+  const size_t kQuotaSize = 64 * 1024 * 1024;
+  grpc_resource_quota* resource_quota =
+      grpc_resource_quota_create("retry_buffer_charged_to_quota");
+  grpc_resource_quota_resize(resource_quota, kQuotaSize);
+  grpc_arg args[] = {
+      grpc_channel_arg_string_create(const_cast<char*>(GRPC_ARG_SERVICE_CONFIG),
+                                     const_cast<char*>(kRetryServiceConfig)),
+      grpc_channel_arg_pointer_create(
+          const_cast<char*>(GRPC_ARG_RESOURCE_QUOTA), resource_quota,
+          grpc_resource_quota_arg_vtable()),
+  };
+  grpc_channel_args client_args = {GPR_ARRAY_SIZE(args), args};
+  grpc_end2end_test_fixture f = begin_test(
+      config, "retry_buffer_charged_to_quota", &client_args, nullptr);
+  run_call(&f, 2 * 1024 * 1024, /*expect_retry=*/true, resource_quota,
+           kQuotaSize);
+  end_test(&f);
+  config.tear_down_data(&f);
+  grpc_resource_quota_unref(resource_quota);
+}
+
+void retry_buffer_resource_quota(grpc_end2end_test_config config) {
+  GPR_ASSERT(config.feature_mask & FEATURE_MASK_SUPPORTS_CLIENT_CHANNEL);
+  test_default_limit_without_quota_size(config);
+  test_default_limit_from_quota(config);
+  test_commits_under_memory_pressure(config);
+  test_buffer_charged_to_quota(config);
+}
+
+void retry_buffer_resource_quota_pre_init(void) {}
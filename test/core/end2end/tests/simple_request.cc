@@ -96,6 +96,32 @@ static void check_peer(char* peer_name) {
   }
 }
 
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+/* Returns whether the count of histogram has risen above its count in before.
+ * Polls for a few seconds, since some stages are recorded only once the calls
+ * are destroyed. */
+static bool histogram_count_rises(grpc_end2end_test_fixture f,
+                                  const grpc_stats_data* before,
+                                  grpc_stats_histograms histogram) {
+  grpc_stats_data* now =
+      static_cast<grpc_stats_data*>(gpr_malloc(sizeof(grpc_stats_data)));
+  gpr_timespec deadline = five_seconds_from_now();
+  bool rose = false;
+  while (true) {
+    grpc_stats_collect(now);
+    rose = grpc_stats_histo_count(now, histogram) >
+           grpc_stats_histo_count(before, histogram);
+    if (rose || gpr_time_cmp(gpr_now(deadline.clock_type), deadline) >= 0) {
+      break;
+    }
+    grpc_completion_queue_next(f.cq, grpc_timeout_milliseconds_to_deadline(10),
+                               nullptr);
+  }
+  gpr_free(now);
+  return rose;
+}
+#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+
 static void simple_request_body(grpc_end2end_test_config config,
                                 grpc_end2end_test_fixture f) {
   grpc_call* c;
@@ -254,6 +280,18 @@ static void simple_request_body(grpc_end2end_test_config config,
   GPR_ASSERT(after->counters[GRPC_STATS_COUNTER_SERVER_CALLS_CREATED] -
                  before->counters[GRPC_STATS_COUNTER_SERVER_CALLS_CREATED] ==
              expected_calls);
+
+  GPR_ASSERT(histogram_count_rises(f, before,
+                                   GRPC_STATS_HISTOGRAM_SERVER_QUEUE_WAIT_US));
+  GPR_ASSERT(histogram_count_rises(
+      f, before, GRPC_STATS_HISTOGRAM_SERVER_CALL_LATENCY_US));
+  // Only the chttp2 transport runs on a combiner and flushes writes.
+  if (strncmp(config.name, "chttp2/", strlen("chttp2/")) == 0) {
+    GPR_ASSERT(histogram_count_rises(f, before,
+                                     GRPC_STATS_HISTOGRAM_COMBINER_WAIT_US));
+    GPR_ASSERT(histogram_count_rises(
+        f, before, GRPC_STATS_HISTOGRAM_HTTP2_WRITE_FLUSH_DELAY_US));
+  }
 #endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
   gpr_free(before);
   gpr_free(after);
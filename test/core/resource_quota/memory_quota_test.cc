@@ -113,6 +113,13 @@ TEST(MemoryQuotaTest, ReserveRangeNoPressure) {
   memory_allocator.Release(total);
 }
 
+TEST(MemoryQuotaTest, MaxRecommendedAllocationSize) {
+  MemoryQuota memory_quota("foo");
+  EXPECT_EQ(memory_quota.MaxRecommendedAllocationSize(), absl::nullopt);
+  memory_quota.SetSize(1024 * 1024);
+  EXPECT_EQ(memory_quota.MaxRecommendedAllocationSize(), 1024 * 1024 / 16);
+}
+
 TEST(MemoryQuotaTest, MakeSlice) {
   MemoryQuota memory_quota("foo");
   auto memory_allocator = memory_quota.CreateMemoryAllocator("bar");
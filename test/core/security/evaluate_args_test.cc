@@ -179,6 +179,62 @@ TEST_F(EvaluateArgsTest, GetSubjectFailDuplicateProperty) {
   EXPECT_TRUE(args.GetSubject().empty());
 }
 
+TEST(ConnectionCacheTest, ComputesResultsOncePerEngine) {
+  EvaluateArgs::ConnectionCache cache;
+  int num_computes = 0;
+  auto compute = [&]() {
+    ++num_computes;
+    return EvaluateArgs::ConnectionCache::Results{true, false};
+  };
+  auto results1 = cache.GetOrCompute(1, compute);
+  auto results2 = cache.GetOrCompute(1, compute);
+  EXPECT_EQ(num_computes, 1);
+  EXPECT_EQ(results1, results2);
+  EXPECT_THAT(*results1, ::testing::ElementsAre(true, false));
+  cache.GetOrCompute(2, compute);
+  EXPECT_EQ(num_computes, 2);
+}
+
+TEST(ConnectionCacheTest, EvictsLeastRecentlyUsedEngine) {
+  constexpr size_t kMaxEngines = EvaluateArgs::ConnectionCache::kMaxEngines;
+  EvaluateArgs::ConnectionCache cache;
+  std::vector<uint64_t> computed;
+  auto get = [&](uint64_t engine_id) {
+    return cache.GetOrCompute(engine_id, [&]() {
+      computed.push_back(engine_id);
+      return EvaluateArgs::ConnectionCache::Results{engine_id % 2 == 0};
+    });
+  };
+  for (uint64_t engine_id = 0; engine_id < kMaxEngines; ++engine_id) {
+    get(engine_id);
+  }
+  EXPECT_EQ(computed.size(), kMaxEngines);
+  // Engine 0 is used again, so engine 1 becomes the least recently used.
+  get(0);
+  EXPECT_EQ(computed.size(), kMaxEngines);
+  computed.clear();
+  // Each new engine evicts only the least recently used one.
+  get(kMaxEngines);
+  get(kMaxEngines + 1);
+  EXPECT_THAT(computed, ::testing::ElementsAre(kMaxEngines, kMaxEngines + 1));
+  computed.clear();
+  for (uint64_t engine_id = 3; engine_id < kMaxEngines + 2; ++engine_id) {
+    get(engine_id);
+  }
+  get(0);
+  EXPECT_TRUE(computed.empty());
+  // Engines 1 and 2 were evicted, and computing them again evicts the
+  // least recently used of the others.
+  auto results = get(1);
+  EXPECT_THAT(*results, ::testing::ElementsAre(false));
+  get(2);
+  EXPECT_THAT(computed, ::testing::ElementsAre(1, 2));
+  computed.clear();
+  get(3);
+  get(4);
+  EXPECT_THAT(computed, ::testing::ElementsAre(3, 4));
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
@@ -16,9 +16,15 @@
 
 #include "src/core/lib/security/authorization/grpc_authorization_engine.h"
 
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <grpc/grpc_security_constants.h>
+
+#include "test/core/util/evaluate_args_test_util.h"
+
 namespace grpc_core {
 
 TEST(GrpcAuthorizationEngineTest, AllowEngineWithMatchingPolicy) {
@@ -103,6 +109,126 @@ TEST(GrpcAuthorizationEngineTest, DenyEngineWithEmptyPolicies) {
   EXPECT_TRUE(decision.matching_policy_name.empty());
 }
 
+Rbac::Policy MakePathPolicy(StringMatcher::Type type, absl::string_view path) {
+  return Rbac::Policy(
+      Rbac::Permission::MakePathPermission(
+          StringMatcher::Create(type, path).value()),
+      Rbac::Principal::MakeAnyPrincipal());
+}
+
+TEST(GrpcAuthorizationEngineTest, PathConstrainedPoliciesMatchInOrder) {
+  std::map<std::string, Rbac::Policy> policies;
+  policies["policy1"] =
+      MakePathPolicy(StringMatcher::Type::kExact, "/pkg.Service/Method");
+  policies["policy2"] =
+      MakePathPolicy(StringMatcher::Type::kPrefix, "/pkg.Service/");
+  // Not constrained by the trie, since it is a suffix match.
+  policies["policy3"] = MakePathPolicy(StringMatcher::Type::kSuffix, "Other");
+  policies["policy4"] = MakePathPolicy(StringMatcher::Type::kPrefix, "/pkg.");
+  Rbac rbac(Rbac::Action::kAllow, std::move(policies));
+  GrpcAuthorizationEngine engine(std::move(rbac));
+  struct {
+    const char* path;
+    const char* matching_policy_name;
+  } cases[] = {
+      {"/pkg.Service/Method", "policy1"}, {"/pkg.Service/Method2", "policy2"},
+      {"/pkg.Service", "policy4"},        {"/pkg.Other", "policy3"},
+      {"/other.Service/Method", ""},      {"/pkg", ""},
+  };
+  for (const auto& c : cases) {
+    EvaluateArgsTestUtil util;
+    util.AddPairToMetadata(":path", c.path);
+    AuthorizationEngine::Decision decision =
+        engine.Evaluate(util.MakeEvaluateArgs());
+    EXPECT_EQ(decision.matching_policy_name, c.matching_policy_name)
+        << c.path;
+  }
+}
+
+TEST(GrpcAuthorizationEngineTest, HeaderMatchersShareHeaderLookup) {
+  std::map<std::string, Rbac::Policy> policies;
+  policies["policy1"] = Rbac::Policy(
+      Rbac::Permission::MakeHeaderPermission(
+          HeaderMatcher::Create("key", HeaderMatcher::Type::kExact, "foo")
+              .value()),
+      Rbac::Principal::MakeAnyPrincipal());
+  policies["policy2"] = Rbac::Policy(
+      Rbac::Permission::MakeHeaderPermission(
+          HeaderMatcher::Create("key", HeaderMatcher::Type::kExact, "foo,bar")
+              .value()),
+      Rbac::Principal::MakeAnyPrincipal());
+  Rbac rbac(Rbac::Action::kDeny, std::move(policies));
+  GrpcAuthorizationEngine engine(std::move(rbac));
+  EvaluateArgsTestUtil util;
+  util.AddPairToMetadata("key", "foo");
+  util.AddPairToMetadata("key", "bar");
+  AuthorizationEngine::Decision decision =
+      engine.Evaluate(util.MakeEvaluateArgs());
+  EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kDeny);
+  EXPECT_EQ(decision.matching_policy_name, "policy2");
+}
+
+TEST(GrpcAuthorizationEngineTest, EnginesKeepSeparateConnectionResults) {
+  auto make_engine = [](absl::string_view principal_name) {
+    std::map<std::string, Rbac::Policy> policies;
+    policies["policy"] = Rbac::Policy(
+        Rbac::Permission::MakeAnyPermission(),
+        Rbac::Principal::MakeAuthenticatedPrincipal(
+            StringMatcher::Create(StringMatcher::Type::kExact, principal_name)
+                .value()));
+    return GrpcAuthorizationEngine(
+        Rbac(Rbac::Action::kAllow, std::move(policies)));
+  };
+  GrpcAuthorizationEngine foo_engine = make_engine("spiffe://foo.abc");
+  GrpcAuthorizationEngine bar_engine = make_engine("spiffe://bar.abc");
+  EvaluateArgsTestUtil util;
+  util.AddPropertyToAuthContext(GRPC_TRANSPORT_SECURITY_TYPE_PROPERTY_NAME,
+                                GRPC_TLS_TRANSPORT_SECURITY_TYPE);
+  util.AddPropertyToAuthContext(GRPC_PEER_URI_PROPERTY_NAME,
+                                "spiffe://foo.abc");
+  // Both engines evaluate calls on the same connection, twice each, so the
+  // second call of each is answered from the connection cache.
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(foo_engine.Evaluate(args).type,
+              AuthorizationEngine::Decision::Type::kAllow);
+    EXPECT_EQ(bar_engine.Evaluate(args).type,
+              AuthorizationEngine::Decision::Type::kDeny);
+  }
+}
+
+TEST(GrpcAuthorizationEngineTest, MoreEnginesThanConnectionCacheHolds) {
+  std::vector<GrpcAuthorizationEngine> engines;
+  for (size_t i = 0; i < EvaluateArgs::ConnectionCache::kMaxEngines + 4;
+       ++i) {
+    std::map<std::string, Rbac::Policy> policies;
+    policies["policy"] = Rbac::Policy(
+        Rbac::Permission::MakeAnyPermission(),
+        Rbac::Principal::MakeAuthenticatedPrincipal(
+            StringMatcher::Create(StringMatcher::Type::kExact,
+                                  i % 2 == 0 ? "spiffe://foo.abc"
+                                             : "spiffe://bar.abc")
+                .value()));
+    engines.emplace_back(Rbac(Rbac::Action::kAllow, std::move(policies)));
+  }
+  EvaluateArgsTestUtil util;
+  util.AddPropertyToAuthContext(GRPC_TRANSPORT_SECURITY_TYPE_PROPERTY_NAME,
+                                GRPC_TLS_TRANSPORT_SECURITY_TYPE);
+  util.AddPropertyToAuthContext(GRPC_PEER_URI_PROPERTY_NAME,
+                                "spiffe://foo.abc");
+  // Cycling through the engines evicts each one's cached results before it
+  // is used again, and every decision must still be right.
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  for (int round = 0; round < 2; ++round) {
+    for (size_t i = 0; i < engines.size(); ++i) {
+      EXPECT_EQ(engines[i].Evaluate(args).type,
+                i % 2 == 0 ? AuthorizationEngine::Decision::Type::kAllow
+                           : AuthorizationEngine::Decision::Type::kDeny)
+          << "engine " << i << " round " << round;
+    }
+  }
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
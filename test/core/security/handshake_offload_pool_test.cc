@@ -0,0 +1,314 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/security/transport/handshake_offload_pool.h"
+
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/thd_id.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/security/credentials/fake/fake_credentials.h"
+#include "src/core/lib/security/security_connector/fake/fake_security_connector.h"
+#include "src/core/lib/security/transport/security_handshaker.h"
+#include "src/core/lib/transport/handshaker.h"
+#include "src/core/tsi/fake_transport_security.h"
+#include "src/core/tsi/transport_security.h"
+#include "test/core/util/mock_endpoint.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+gpr_timespec Deadline() { return grpc_timeout_seconds_to_deadline(10); }
+
+// A step that records when it starts and then blocks until released.
+class BlockingStep {
+ public:
+  BlockingStep(int id, Mutex* mu, std::vector<int>* order, gpr_event* release)
+      : id_(id), mu_(mu), order_(order), release_(release) {
+    gpr_event_init(&started_);
+    gpr_event_init(&done_);
+    GRPC_CLOSURE_INIT(&closure_, Run, this, nullptr);
+  }
+
+  grpc_closure* closure() { return &closure_; }
+  bool WaitStarted() {
+    return gpr_event_wait(&started_, Deadline()) != nullptr;
+  }
+  bool WaitDone() { return gpr_event_wait(&done_, Deadline()) != nullptr; }
+  bool started() { return gpr_event_get(&started_) != nullptr; }
+
+ private:
+  static void Run(void* arg, grpc_error_handle /*error*/) {
+    BlockingStep* self = static_cast<BlockingStep*>(arg);
+    {
+      MutexLock lock(self->mu_);
+      self->order_->push_back(self->id_);
+    }
+    gpr_event_set(&self->started_, reinterpret_cast<void*>(1));
+    GPR_ASSERT(gpr_event_wait(self->release_, Deadline()) != nullptr);
+    gpr_event_set(&self->done_, reinterpret_cast<void*>(1));
+  }
+
+  const int id_;
+  Mutex* mu_;
+  std::vector<int>* order_;
+  gpr_event* release_;
+  gpr_event started_;
+  gpr_event done_;
+  grpc_closure closure_;
+};
+
+// Pools are never destroyed: a pool may still be finishing a step on an
+// executor thread after the step's closure has returned.
+HandshakeOffloadPool* NewPool(size_t max_concurrency) {
+  return new HandshakeOffloadPool(max_concurrency);
+}
+
+TEST(HandshakeOffloadPoolTest, QueuesBeyondMaxConcurrency) {
+  static HandshakeOffloadPool* pool = NewPool(2);
+  Mutex mu;
+  std::vector<int> order;
+  gpr_event release;
+  gpr_event_init(&release);
+  std::vector<std::unique_ptr<BlockingStep>> steps;
+  for (int i = 0; i < 3; ++i) {
+    steps.push_back(absl::make_unique<BlockingStep>(i, &mu, &order, &release));
+  }
+  {
+    ExecCtx exec_ctx;
+    for (auto& step : steps) {
+      EXPECT_TRUE(pool->Run(step->closure(), /*high_priority=*/false));
+    }
+  }
+  EXPECT_TRUE(steps[0]->WaitStarted());
+  EXPECT_TRUE(steps[1]->WaitStarted());
+  EXPECT_FALSE(steps[2]->started());
+  EXPECT_EQ(pool->queued(), 1);
+  gpr_event_set(&release, reinterpret_cast<void*>(1));
+  for (auto& step : steps) EXPECT_TRUE(step->WaitDone());
+  EXPECT_EQ(pool->queued(), 0);
+}
+
+TEST(HandshakeOffloadPoolTest, HighPriorityStepsRunFirst) {
+  static HandshakeOffloadPool* pool = NewPool(1);
+  Mutex mu;
+  std::vector<int> order;
+  gpr_event release;
+  gpr_event_init(&release);
+  std::vector<std::unique_ptr<BlockingStep>> steps;
+  for (int i = 0; i < 4; ++i) {
+    steps.push_back(absl::make_unique<BlockingStep>(i, &mu, &order, &release));
+  }
+  ExecCtx exec_ctx;
+  // Occupy the pool, so that the other steps are queued.
+  EXPECT_TRUE(pool->Run(steps[0]->closure(), /*high_priority=*/false));
+  EXPECT_TRUE(steps[0]->WaitStarted());
+  EXPECT_TRUE(pool->Run(steps[1]->closure(), /*high_priority=*/false));
+  EXPECT_TRUE(pool->Run(steps[2]->closure(), /*high_priority=*/true));
+  EXPECT_TRUE(pool->Run(steps[3]->closure(), /*high_priority=*/false));
+  EXPECT_EQ(pool->queued(), 3);
+  gpr_event_set(&release, reinterpret_cast<void*>(1));
+  for (auto& step : steps) EXPECT_TRUE(step->WaitDone());
+  MutexLock lock(&mu);
+  EXPECT_THAT(order, ::testing::ElementsAre(0, 2, 1, 3));
+}
+
+TEST(HandshakeOffloadPoolTest, RejectsWhenTooManyQueued) {
+  static HandshakeOffloadPool* pool = NewPool(1);
+  Mutex mu;
+  std::vector<int> order;
+  gpr_event release;
+  gpr_event_init(&release);
+  BlockingStep running(0, &mu, &order, &release);
+  BlockingStep queued(1, &mu, &order, &release);
+  BlockingStep rejected(2, &mu, &order, &release);
+  ExecCtx exec_ctx;
+  EXPECT_TRUE(pool->Run(running.closure(), /*high_priority=*/false,
+                        /*max_queued=*/1));
+  EXPECT_TRUE(running.WaitStarted());
+  // Nothing is waiting yet, so this step is admitted.
+  EXPECT_TRUE(pool->Run(queued.closure(), /*high_priority=*/false,
+                        /*max_queued=*/1));
+  // One step is waiting now.
+  EXPECT_FALSE(pool->Run(rejected.closure(), /*high_priority=*/true,
+                         /*max_queued=*/1));
+  EXPECT_EQ(pool->queued(), 1);
+  gpr_event_set(&release, reinterpret_cast<void*>(1));
+  EXPECT_TRUE(running.WaitDone());
+  EXPECT_TRUE(queued.WaitDone());
+  MutexLock lock(&mu);
+  EXPECT_THAT(order, ::testing::ElementsAre(0, 1));
+}
+
+//
+// SecurityHandshaker with GRPC_ARG_TSI_HANDSHAKE_OFFLOAD
+//
+
+// Wraps a fake TSI handshaker and records the thread of each step that
+// processes bytes received from the peer.
+struct ThreadRecordingHandshaker {
+  tsi_handshaker base;
+  tsi_handshaker* wrapped;
+  gpr_thd_id thread;
+  gpr_event received_bytes_processed;
+};
+
+tsi_result ThreadRecordingNext(tsi_handshaker* self,
+                               const unsigned char* received_bytes,
+                               size_t received_bytes_size,
+                               const unsigned char** bytes_to_send,
+                               size_t* bytes_to_send_size,
+                               tsi_handshaker_result** handshaker_result,
+                               tsi_handshaker_on_next_done_cb cb,
+                               void* user_data) {
+  ThreadRecordingHandshaker* handshaker =
+      reinterpret_cast<ThreadRecordingHandshaker*>(self);
+  tsi_result result = tsi_handshaker_next(
+      handshaker->wrapped, received_bytes, received_bytes_size, bytes_to_send,
+      bytes_to_send_size, handshaker_result, cb, user_data);
+  if (received_bytes_size > 0 &&
+      gpr_event_get(&handshaker->received_bytes_processed) == nullptr) {
+    handshaker->thread = gpr_thd_currentid();
+    gpr_event_set(&handshaker->received_bytes_processed,
+                  reinterpret_cast<void*>(1));
+  }
+  return result;
+}
+
+void ThreadRecordingShutdown(tsi_handshaker* self) {
+  tsi_handshaker_shutdown(
+      reinterpret_cast<ThreadRecordingHandshaker*>(self)->wrapped);
+}
+
+void ThreadRecordingDestroy(tsi_handshaker* self) {
+  ThreadRecordingHandshaker* handshaker =
+      reinterpret_cast<ThreadRecordingHandshaker*>(self);
+  tsi_handshaker_destroy(handshaker->wrapped);
+  delete handshaker;
+}
+
+const tsi_handshaker_vtable kThreadRecordingHandshakerVtable = {
+    nullptr,                  // get_bytes_to_send_to_peer
+    nullptr,                  // process_bytes_from_peer
+    nullptr,                  // get_result
+    nullptr,                  // extract_peer
+    nullptr,                  // create_frame_protector
+    ThreadRecordingDestroy,   // destroy
+    ThreadRecordingNext,      // next
+    ThreadRecordingShutdown,  // shutdown
+    nullptr,                  // is_resumption
+};
+
+void DiscardWrite(grpc_slice /*slice*/) {}
+
+void OnHandshakeDone(void* arg, grpc_error_handle /*error*/) {
+  HandshakerArgs* args = static_cast<HandshakerArgs*>(arg);
+  gpr_event_set(static_cast<gpr_event*>(args->user_data),
+                reinterpret_cast<void*>(1));
+}
+
+// Runs the server side of a fake handshake until it has processed the
+// client's first message, and returns the thread that processed it.  Reads
+// complete on the calling thread, when it flushes its ExecCtx.
+gpr_thd_id ThreadProcessingClientHello(bool offload) {
+  // The client's first message.
+  tsi_handshaker* client = tsi_create_fake_handshaker(/*is_client=*/1);
+  const unsigned char* client_hello = nullptr;
+  size_t client_hello_size = 0;
+  tsi_handshaker_result* client_result = nullptr;
+  GPR_ASSERT(tsi_handshaker_next(client, nullptr, 0, &client_hello,
+                                 &client_hello_size, &client_result, nullptr,
+                                 nullptr) == TSI_OK);
+  GPR_ASSERT(client_hello_size > 0);
+  grpc_slice client_hello_slice = grpc_slice_from_copied_buffer(
+      reinterpret_cast<const char*>(client_hello), client_hello_size);
+  tsi_handshaker_destroy(client);
+  // The server handshaker.
+  ThreadRecordingHandshaker* handshaker = new ThreadRecordingHandshaker();
+  handshaker->base.vtable = &kThreadRecordingHandshakerVtable;
+  handshaker->wrapped = tsi_create_fake_handshaker(/*is_client=*/0);
+  gpr_event_init(&handshaker->received_bytes_processed);
+  grpc_server_credentials* creds =
+      grpc_fake_transport_security_server_credentials_create();
+  gpr_event done;
+  gpr_event_init(&done);
+  gpr_thd_id thread;
+  {
+    ExecCtx exec_ctx;
+    RefCountedPtr<grpc_server_security_connector> connector =
+        grpc_fake_server_security_connector_create(creds->Ref());
+    grpc_arg arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_TSI_HANDSHAKE_OFFLOAD), offload);
+    grpc_channel_args args = {1, &arg};
+    auto handshake_mgr = MakeRefCounted<HandshakeManager>();
+    handshake_mgr->Add(
+        SecurityHandshakerCreate(&handshaker->base, connector.get(), &args));
+    grpc_endpoint* endpoint = grpc_mock_endpoint_create(DiscardWrite);
+    grpc_mock_endpoint_put_read(endpoint, client_hello_slice);
+    handshake_mgr->DoHandshake(endpoint, &args,
+                               Duration::Seconds(10) + ExecCtx::Get()->Now(),
+                               /*acceptor=*/nullptr, OnHandshakeDone, &done);
+    ExecCtx::Get()->Flush();
+    GPR_ASSERT(gpr_event_wait(&handshaker->received_bytes_processed,
+                              Deadline()) != nullptr);
+    thread = handshaker->thread;
+    // The client never answers, so end the handshake.
+    handshake_mgr->Shutdown(
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Test is done"));
+    ExecCtx::Get()->Flush();
+    GPR_ASSERT(gpr_event_wait(&done, Deadline()) != nullptr);
+    connector.reset(DEBUG_LOCATION, "test");
+  }
+  grpc_server_credentials_release(creds);
+  return thread;
+}
+
+TEST(SecurityHandshakerOffloadTest, WithoutOffloadRunsOnReadingThread) {
+  EXPECT_EQ(ThreadProcessingClientHello(/*offload=*/false),
+            gpr_thd_currentid());
+}
+
+TEST(SecurityHandshakerOffloadTest, WithOffloadRunsOnPoolThread) {
+  EXPECT_NE(ThreadProcessingClientHello(/*offload=*/true),
+            gpr_thd_currentid());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
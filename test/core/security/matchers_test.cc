@@ -14,8 +14,13 @@
 
 #include "src/core/lib/matchers/matchers.h"
 
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include "absl/strings/str_cat.h"
+
 namespace grpc_core {
 
 TEST(StringMatcherTest, ExactMatchCaseSensitive) {
@@ -242,6 +247,105 @@ TEST(HeaderMatcherTest, PresentMatcherFalseWithInvertMatch) {
   EXPECT_FALSE(header_matcher->Match(absl::nullopt));
 }
 
+std::vector<StringMatcher> MakeStringMatchers(
+    const std::vector<std::pair<StringMatcher::Type, std::string>>& specs,
+    bool case_sensitive = true) {
+  std::vector<StringMatcher> matchers;
+  for (const auto& spec : specs) {
+    matchers.push_back(
+        StringMatcher::Create(spec.first, spec.second, case_sensitive).value());
+  }
+  return matchers;
+}
+
+TEST(StringMatcherSetTest, EmptySet) {
+  StringMatcherSet matcher_set{std::vector<StringMatcher>()};
+  EXPECT_EQ(matcher_set.size(), 0);
+  EXPECT_TRUE(matcher_set.Match("value").empty());
+}
+
+TEST(StringMatcherSetTest, MatchesEachType) {
+  StringMatcherSet matcher_set(MakeStringMatchers({
+      {StringMatcher::Type::kExact, "/pkg.Service/Method"},
+      {StringMatcher::Type::kPrefix, "/pkg.Service/"},
+      {StringMatcher::Type::kSuffix, "/Method"},
+      {StringMatcher::Type::kContains, "Service"},
+      {StringMatcher::Type::kSafeRegex, "/pkg\\..*/Meth.*"},
+      {StringMatcher::Type::kExact, "/pkg.Service"},
+      {StringMatcher::Type::kSafeRegex, "Service"},
+  }));
+  EXPECT_EQ(matcher_set.Match("/pkg.Service/Method"),
+            std::vector<size_t>({0, 1, 2, 3, 4}));
+  EXPECT_EQ(matcher_set.Match("/pkg.Service/Method2"),
+            std::vector<size_t>({1, 3, 4}));
+  EXPECT_EQ(matcher_set.Match("/pkg.Service"), std::vector<size_t>({3, 5}));
+  EXPECT_EQ(matcher_set.Match("Service"), std::vector<size_t>({3, 6}));
+  EXPECT_TRUE(matcher_set.Match("/other/Meth").empty());
+}
+
+TEST(StringMatcherSetTest, OverlappingLiterals) {
+  StringMatcherSet matcher_set(MakeStringMatchers({
+      {StringMatcher::Type::kContains, "he"},
+      {StringMatcher::Type::kContains, "she"},
+      {StringMatcher::Type::kContains, "his"},
+      {StringMatcher::Type::kContains, "hers"},
+      {StringMatcher::Type::kSuffix, "he"},
+      {StringMatcher::Type::kPrefix, "us"},
+  }));
+  EXPECT_EQ(matcher_set.Match("ushers"), std::vector<size_t>({0, 1, 3, 5}));
+  EXPECT_EQ(matcher_set.Match("ushe"), std::vector<size_t>({0, 1, 4, 5}));
+  EXPECT_EQ(matcher_set.Match("this"), std::vector<size_t>({2}));
+}
+
+TEST(StringMatcherSetTest, CaseInsensitiveLiterals) {
+  auto matchers = MakeStringMatchers(
+      {
+          {StringMatcher::Type::kExact, "Exact"},
+          {StringMatcher::Type::kPrefix, "Pre"},
+      },
+      /*case_sensitive=*/false);
+  matchers.push_back(
+      StringMatcher::Create(StringMatcher::Type::kSuffix, "Fix").value());
+  StringMatcherSet matcher_set(std::move(matchers));
+  EXPECT_EQ(matcher_set.Match("EXACT"), std::vector<size_t>({0}));
+  EXPECT_EQ(matcher_set.Match("prefix"), std::vector<size_t>({1}));
+  EXPECT_EQ(matcher_set.Match("PREFIX"), std::vector<size_t>({1}));
+  EXPECT_EQ(matcher_set.Match("preFix"), std::vector<size_t>({1, 2}));
+}
+
+TEST(StringMatcherSetTest, EmptyLiterals) {
+  StringMatcherSet matcher_set(MakeStringMatchers({
+      {StringMatcher::Type::kExact, ""},
+      {StringMatcher::Type::kPrefix, ""},
+      {StringMatcher::Type::kContains, ""},
+  }));
+  EXPECT_EQ(matcher_set.Match(""), std::vector<size_t>({0, 1, 2}));
+  EXPECT_EQ(matcher_set.Match("value"), std::vector<size_t>({1, 2}));
+}
+
+TEST(StringMatcherSetTest, RegexesTooLargeForOneSet) {
+  // Each regex compiles on its own, but together they exceed the memory
+  // budget of one RE2::Set, so they are matched one at a time.
+  constexpr size_t kNumRegexes = 200;
+  std::vector<std::pair<StringMatcher::Type, std::string>> specs;
+  for (size_t i = 0; i < kNumRegexes; ++i) {
+    specs.emplace_back(StringMatcher::Type::kSafeRegex,
+                       absl::StrCat("m", i, "_[a-z]{1000}"));
+  }
+  specs.emplace_back(StringMatcher::Type::kPrefix, "m1");
+  StringMatcherSet matcher_set(MakeStringMatchers(specs));
+  EXPECT_EQ(matcher_set.size(), kNumRegexes + 1);
+  const std::string suffix(1000, 'x');
+  EXPECT_EQ(matcher_set.Match(absl::StrCat("m7_", suffix)),
+            std::vector<size_t>({7}));
+  EXPECT_EQ(matcher_set.Match(absl::StrCat("m123_", suffix)),
+            std::vector<size_t>({123, kNumRegexes}));
+  EXPECT_EQ(matcher_set.Match(absl::StrCat("m1_", suffix)),
+            std::vector<size_t>({1, kNumRegexes}));
+  EXPECT_TRUE(matcher_set.Match(absl::StrCat("m7_", suffix, "x")).empty());
+  EXPECT_TRUE(matcher_set.Match("m7_x").empty());
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
@@ -0,0 +1,183 @@
+//
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/iomgr/endpoint_pair.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/surface/completion_queue.h"
+#include "src/core/lib/surface/server.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+// Connects pairs of client and server chttp2 transports, with the server
+// side set up on a server, and records which transports get a channelz
+// socket node.
+class ChannelzSocketSamplingTest : public ::testing::Test {
+ protected:
+  ~ChannelzSocketSamplingTest() override {
+    {
+      ExecCtx exec_ctx;
+      for (grpc_transport* transport : client_transports_) {
+        grpc_transport_destroy(transport);
+      }
+    }
+    grpc_server_shutdown_and_notify(server_, cq_, Tag(1));
+    grpc_event ev;
+    do {
+      ev = grpc_completion_queue_next(cq_, grpc_timeout_seconds_to_deadline(5),
+                                      nullptr);
+    } while (ev.type != GRPC_OP_COMPLETE || ev.tag != Tag(1));
+    grpc_server_destroy(server_);
+    grpc_completion_queue_shutdown(cq_);
+    while (grpc_completion_queue_next(cq_, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq_);
+  }
+
+  void StartServer(int sampling_interval) {
+    grpc_arg args[] = {
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_ENABLE_CHANNELZ), true),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_CHANNELZ_SOCKET_SAMPLING_INTERVAL),
+            sampling_interval)};
+    grpc_channel_args channel_args = {GPR_ARRAY_SIZE(args), args};
+    cq_ = grpc_completion_queue_create_for_next(nullptr);
+    server_ = grpc_server_create(&channel_args, nullptr);
+    grpc_server_register_completion_queue(server_, cq_, nullptr);
+    grpc_server_start(server_);
+  }
+
+  // Creates num_pairs connected client and server transports, using the
+  // server's channel args for both.
+  void AddTransportPairs(size_t num_pairs) {
+    ExecCtx exec_ctx;
+    Server* core_server = Server::FromC(server_);
+    for (size_t i = 0; i < num_pairs; ++i) {
+      grpc_endpoint_pair fds =
+          grpc_iomgr_create_endpoint_pair("fixture", nullptr);
+      grpc_transport* client_transport = grpc_create_chttp2_transport(
+          core_server->channel_args(), fds.client, true);
+      client_transports_.push_back(client_transport);
+      if (grpc_chttp2_transport_get_socket_node(client_transport) != nullptr) {
+        ++num_client_socket_nodes_;
+      }
+      grpc_transport* server_transport = grpc_create_chttp2_transport(
+          core_server->channel_args(), fds.server, false);
+      RefCountedPtr<channelz::SocketNode> socket_node =
+          grpc_chttp2_transport_get_socket_node(server_transport);
+      if (socket_node != nullptr) {
+        server_socket_ids_.insert(socket_node->uuid());
+      }
+      grpc_endpoint_add_to_pollset(fds.server, grpc_cq_pollset(cq_));
+      ASSERT_EQ(core_server->SetupTransport(server_transport, nullptr,
+                                            core_server->channel_args(),
+                                            socket_node),
+                GRPC_ERROR_NONE);
+      grpc_chttp2_transport_start_reading(server_transport, nullptr, nullptr,
+                                          nullptr);
+    }
+  }
+
+  // Returns the ids of the sockets that channelz lists for the server.
+  std::set<intptr_t> ListServerSockets() {
+    channelz::ServerNode* server_node = Server::FromC(server_)->channelz_node();
+    EXPECT_NE(server_node, nullptr);
+    if (server_node == nullptr) return {};
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    Json json = Json::Parse(server_node->RenderServerSockets(0, 0), &error);
+    EXPECT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+    GRPC_ERROR_UNREF(error);
+    EXPECT_TRUE(json.object_value().count("end"));
+    std::set<intptr_t> ids;
+    auto it = json.object_value().find("socketRef");
+    if (it == json.object_value().end()) return ids;
+    for (const Json& socket_ref : it->second.array_value()) {
+      ids.insert(
+          std::stoll(socket_ref.object_value().at("socketId").string_value()));
+    }
+    return ids;
+  }
+
+  grpc_completion_queue* cq_ = nullptr;
+  grpc_server* server_ = nullptr;
+  std::vector<grpc_transport*> client_transports_;
+  size_t num_client_socket_nodes_ = 0;
+  std::set<intptr_t> server_socket_ids_;
+};
+
+TEST_F(ChannelzSocketSamplingTest, IntervalZeroTracksNoTransports) {
+  StartServer(/*sampling_interval=*/0);
+  AddTransportPairs(4);
+  EXPECT_EQ(num_client_socket_nodes_, 0);
+  EXPECT_TRUE(server_socket_ids_.empty());
+  EXPECT_TRUE(ListServerSockets().empty());
+}
+
+TEST_F(ChannelzSocketSamplingTest, IntervalOneTracksEveryTransport) {
+  StartServer(/*sampling_interval=*/1);
+  AddTransportPairs(4);
+  EXPECT_EQ(num_client_socket_nodes_, 4);
+  EXPECT_EQ(server_socket_ids_.size(), 4);
+  EXPECT_EQ(ListServerSockets(), server_socket_ids_);
+}
+
+TEST_F(ChannelzSocketSamplingTest, IntervalNTracksOneTransportInN) {
+  constexpr int kSamplingInterval = 3;
+  constexpr size_t kNumPairs = 3 * kSamplingInterval;
+  StartServer(kSamplingInterval);
+  // Client and server transports share one process-wide count, so one in
+  // every kSamplingInterval transports of either kind gets a socket node.
+  AddTransportPairs(kNumPairs);
+  EXPECT_EQ(num_client_socket_nodes_ + server_socket_ids_.size(),
+            2 * kNumPairs / kSamplingInterval);
+  // Only the sampled server transports are listed as the server's sockets.
+  EXPECT_EQ(ListServerSockets(), server_socket_ids_);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -33,6 +33,7 @@ constexpr size_t kMaxSliceLength = 256;
 constexpr size_t kMaxSlices = 10;
 constexpr size_t kSealRepeatTimes = 5;
 constexpr size_t kTagLength = 16;
+constexpr size_t kMaxFrameDataLength = 100;
 
 /* Test fixtures for each test cases.  */
 struct alts_grpc_record_protocol_test_fixture {
@@ -317,6 +318,32 @@ static void empty_seal_unseal(alts_grpc_record_protocol* sender,
   grpc_core::ExecCtx::Get()->Flush();
 }
 
+static void multi_frame_seal_unseal(alts_grpc_record_protocol* sender,
+                                    alts_grpc_record_protocol* receiver) {
+  grpc_core::ExecCtx exec_ctx;
+  for (size_t i = 0; i < kSealRepeatTimes; i++) {
+    alts_grpc_record_protocol_test_var* var =
+        alts_grpc_record_protocol_test_var_create();
+    /* Seals into multiple frames and then unseals all frames at once.  */
+    size_t data_length = var->original_sb.length;
+    size_t num_frames =
+        (data_length + kMaxFrameDataLength - 1) / kMaxFrameDataLength;
+    tsi_result status = alts_grpc_record_protocol_protect_frames(
+        sender, &var->original_sb, kMaxFrameDataLength, &var->protected_sb);
+    GPR_ASSERT(status == TSI_OK);
+    GPR_ASSERT(var->protected_sb.length ==
+               data_length +
+                   num_frames * (var->header_length + var->tag_length));
+    status = alts_grpc_record_protocol_unprotect_frames(
+        receiver, &var->protected_sb, num_frames, &var->unprotected_sb);
+    GPR_ASSERT(status == TSI_OK);
+    GPR_ASSERT(
+        are_slice_buffers_equal(&var->unprotected_sb, &var->duplicate_sb));
+    alts_grpc_record_protocol_test_var_destroy(var);
+  }
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
 static void unsync_seal_unseal(alts_grpc_record_protocol* sender,
                                alts_grpc_record_protocol* receiver) {
   grpc_core::ExecCtx exec_ctx;
@@ -406,6 +433,12 @@ static void alts_grpc_record_protocol_empty_seal_unseal_tests(
   empty_seal_unseal(fixture->server_protect, fixture->client_unprotect);
 }
 
+static void alts_grpc_record_protocol_multi_frame_seal_unseal_tests(
+    alts_grpc_record_protocol_test_fixture* fixture) {
+  multi_frame_seal_unseal(fixture->client_protect, fixture->server_unprotect);
+  multi_frame_seal_unseal(fixture->server_protect, fixture->client_unprotect);
+}
+
 static void alts_grpc_record_protocol_unsync_seal_unseal_tests(
     alts_grpc_record_protocol_test_fixture* fixture) {
   unsync_seal_unseal(fixture->client_protect, fixture->server_unprotect);
@@ -444,6 +477,10 @@ static void alts_grpc_record_protocol_tests(
   auto* fixture_5 = fixture_create();
   alts_grpc_record_protocol_input_check_tests(fixture_5);
   alts_grpc_record_protocol_test_fixture_destroy(fixture_5);
+
+  auto* fixture_6 = fixture_create();
+  alts_grpc_record_protocol_multi_frame_seal_unseal_tests(fixture_6);
+  alts_grpc_record_protocol_test_fixture_destroy(fixture_6);
 }
 
 int main(int argc, char** argv) {
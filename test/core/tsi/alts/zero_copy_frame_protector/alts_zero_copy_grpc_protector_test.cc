@@ -239,6 +239,30 @@ static void seal_unseal_large_buffer(tsi_zero_copy_grpc_protector* sender,
   grpc_core::ExecCtx::Get()->Flush();
 }
 
+static void seal_unseal_large_buffer_at_once(
+    tsi_zero_copy_grpc_protector* sender,
+    tsi_zero_copy_grpc_protector* receiver) {
+  grpc_core::ExecCtx exec_ctx;
+  for (size_t i = 0; i < kSealRepeatTimes; i++) {
+    alts_zero_copy_grpc_protector_test_var* var =
+        alts_zero_copy_grpc_protector_test_var_create();
+    /* Creates a random large slice buffer and calls protect().  */
+    create_random_slice_buffer(&var->original_sb, &var->duplicate_sb,
+                               kLargeBufferSize);
+    GPR_ASSERT(tsi_zero_copy_grpc_protector_protect(
+                   sender, &var->original_sb, &var->protected_sb) == TSI_OK);
+    /* Receiver unprotects all frames with a single call.  */
+    GPR_ASSERT(tsi_zero_copy_grpc_protector_unprotect(
+                   receiver, &var->protected_sb, &var->unprotected_sb) ==
+               TSI_OK);
+    GPR_ASSERT(var->protected_sb.length == 0);
+    GPR_ASSERT(
+        are_slice_buffers_equal(&var->unprotected_sb, &var->duplicate_sb));
+    alts_zero_copy_grpc_protector_test_var_destroy(var);
+  }
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
 /* --- Test cases. --- */
 
 static void alts_zero_copy_protector_seal_unseal_small_buffer_tests(
@@ -297,6 +321,34 @@ static void alts_zero_copy_protector_seal_unseal_large_buffer_tests(
   alts_zero_copy_grpc_protector_test_fixture_destroy(fixture);
 }
 
+static void alts_zero_copy_protector_seal_unseal_large_buffer_at_once_tests(
+    bool enable_extra_copy) {
+  alts_zero_copy_grpc_protector_test_fixture* fixture =
+      alts_zero_copy_grpc_protector_test_fixture_create(
+          /*rekey=*/false, /*integrity_only=*/true, enable_extra_copy);
+  seal_unseal_large_buffer_at_once(fixture->client, fixture->server);
+  seal_unseal_large_buffer_at_once(fixture->server, fixture->client);
+  alts_zero_copy_grpc_protector_test_fixture_destroy(fixture);
+
+  fixture = alts_zero_copy_grpc_protector_test_fixture_create(
+      /*rekey=*/false, /*integrity_only=*/false, enable_extra_copy);
+  seal_unseal_large_buffer_at_once(fixture->client, fixture->server);
+  seal_unseal_large_buffer_at_once(fixture->server, fixture->client);
+  alts_zero_copy_grpc_protector_test_fixture_destroy(fixture);
+
+  fixture = alts_zero_copy_grpc_protector_test_fixture_create(
+      /*rekey=*/true, /*integrity_only=*/true, enable_extra_copy);
+  seal_unseal_large_buffer_at_once(fixture->client, fixture->server);
+  seal_unseal_large_buffer_at_once(fixture->server, fixture->client);
+  alts_zero_copy_grpc_protector_test_fixture_destroy(fixture);
+
+  fixture = alts_zero_copy_grpc_protector_test_fixture_create(
+      /*rekey=*/true, /*integrity_only=*/false, enable_extra_copy);
+  seal_unseal_large_buffer_at_once(fixture->client, fixture->server);
+  seal_unseal_large_buffer_at_once(fixture->server, fixture->client);
+  alts_zero_copy_grpc_protector_test_fixture_destroy(fixture);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   grpc_init();
@@ -308,6 +360,10 @@ int main(int argc, char** argv) {
       /*enable_extra_copy=*/false);
   alts_zero_copy_protector_seal_unseal_large_buffer_tests(
       /*enable_extra_copy=*/true);
+  alts_zero_copy_protector_seal_unseal_large_buffer_at_once_tests(
+      /*enable_extra_copy=*/false);
+  alts_zero_copy_protector_seal_unseal_large_buffer_at_once_tests(
+      /*enable_extra_copy=*/true);
   grpc_shutdown();
   return 0;
 }
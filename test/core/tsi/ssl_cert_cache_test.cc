@@ -0,0 +1,120 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/tsi/ssl/cert_cache/ssl_cert_cache.h"
+
+#include <stdint.h>
+#include <time.h>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Verification error codes are opaque to the cache.
+constexpr int kVerifyOk = 0;
+constexpr int kVerifyError = 10;
+
+TEST(SslCertCacheTest, InitialState) {
+  RefCountedPtr<tsi::SslCertCache> cache = tsi::SslCertCache::Create(16);
+  EXPECT_EQ(cache->Size(), 0);
+  int verify_error = kVerifyOk;
+  EXPECT_FALSE(cache->GetVerification("chain", &verify_error));
+  tsi::SslCertCache::PeerProperties properties;
+  EXPECT_FALSE(cache->GetPeerProperties("chain", &properties));
+  tsi::SslCertCache::Stats stats = cache->GetStats();
+  EXPECT_EQ(stats.hits, 0);
+  EXPECT_EQ(stats.misses, 2);
+}
+
+TEST(SslCertCacheTest, VerificationOutcomesAreCached) {
+  RefCountedPtr<tsi::SslCertCache> cache = tsi::SslCertCache::Create(16);
+  cache->PutVerification("good.chain", kVerifyOk, INT64_MAX);
+  cache->PutVerification("bad.chain", kVerifyError, INT64_MAX);
+  EXPECT_EQ(cache->Size(), 2);
+  int verify_error = kVerifyError;
+  ASSERT_TRUE(cache->GetVerification("good.chain", &verify_error));
+  EXPECT_EQ(verify_error, kVerifyOk);
+  ASSERT_TRUE(cache->GetVerification("bad.chain", &verify_error));
+  EXPECT_EQ(verify_error, kVerifyError);
+  EXPECT_EQ(cache->GetStats().hits, 2);
+}
+
+TEST(SslCertCacheTest, ExpiredVerificationOutcomesAreIgnored) {
+  RefCountedPtr<tsi::SslCertCache> cache = tsi::SslCertCache::Create(16);
+  cache->PutVerification("expired.chain", kVerifyOk, time(nullptr) - 1);
+  int verify_error = kVerifyOk;
+  EXPECT_FALSE(cache->GetVerification("expired.chain", &verify_error));
+  // A new outcome replaces the expired one.
+  cache->PutVerification("expired.chain", kVerifyError, INT64_MAX);
+  EXPECT_TRUE(cache->GetVerification("expired.chain", &verify_error));
+  EXPECT_EQ(verify_error, kVerifyError);
+  EXPECT_EQ(cache->Size(), 1);
+}
+
+TEST(SslCertCacheTest, PeerPropertiesAreCached) {
+  RefCountedPtr<tsi::SslCertCache> cache = tsi::SslCertCache::Create(16);
+  tsi::SslCertCache::PeerProperties properties = {
+      {"x509_subject_alternative_name", "foo.test.google.fr"},
+      {"x509_pem_cert", std::string("binary\0value", 12)}};
+  cache->PutPeerProperties("chain", properties);
+  // Properties and verification outcomes of a chain share an entry.
+  cache->PutVerification("chain", kVerifyOk, INT64_MAX);
+  EXPECT_EQ(cache->Size(), 1);
+  tsi::SslCertCache::PeerProperties cached;
+  ASSERT_TRUE(cache->GetPeerProperties("chain", &cached));
+  EXPECT_EQ(cached, properties);
+  EXPECT_FALSE(cache->GetPeerProperties("other.chain", &cached));
+}
+
+TEST(SslCertCacheTest, LruCache) {
+  RefCountedPtr<tsi::SslCertCache> cache = tsi::SslCertCache::Create(3);
+  for (int i = 0; i < 3; i++) {
+    cache->PutVerification(std::to_string(i) + ".chain", kVerifyOk,
+                           INT64_MAX);
+  }
+  EXPECT_EQ(cache->Size(), 3);
+  int verify_error;
+  // Makes 0 the most recently used chain.
+  EXPECT_TRUE(cache->GetVerification("0.chain", &verify_error));
+  cache->PutVerification("3.chain", kVerifyOk, INT64_MAX);
+  EXPECT_EQ(cache->Size(), 3);
+  EXPECT_TRUE(cache->GetVerification("0.chain", &verify_error));
+  EXPECT_FALSE(cache->GetVerification("1.chain", &verify_error));
+  EXPECT_TRUE(cache->GetVerification("2.chain", &verify_error));
+  EXPECT_TRUE(cache->GetVerification("3.chain", &verify_error));
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -18,6 +18,8 @@
 
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
 
+#include <time.h>
+
 #include <string>
 #include <unordered_set>
 
@@ -142,6 +144,95 @@ TEST(SslSessionCacheTest, LruCache) {
   EXPECT_EQ(tracker.AliveCount(), 0);
 }
 
+// Returns a session identified by \a id for the given protocol \a version,
+// created \a age seconds ago and valid for \a timeout seconds.
+tsi::SslSessionPtr NewIdentifiedSession(SessionTracker* tracker, uint8_t id,
+                                        int version, long age = 0,
+                                        long timeout = 300) {
+  tsi::SslSessionPtr session = tracker->NewSession(id);
+  EXPECT_EQ(SSL_SESSION_set1_id(session.get(), &id, 1), 1);
+  EXPECT_EQ(SSL_SESSION_set_protocol_version(session.get(), version), 1);
+  SSL_SESSION_set_time(session.get(), time(nullptr) - age);
+  SSL_SESSION_set_timeout(session.get(), timeout);
+  return session;
+}
+
+// Returns the id of a session created by NewIdentifiedSession, or -1 if
+// \a session is null.
+int SessionId(const tsi::SslSessionPtr& session) {
+  if (session == nullptr) return -1;
+  unsigned int length = 0;
+  const unsigned char* id = SSL_SESSION_get_id(session.get(), &length);
+  EXPECT_EQ(length, 1);
+  return id[0];
+}
+
+TEST(SslSessionCacheTest, ExpiredSessionsAreDropped) {
+  SessionTracker tracker;
+  RefCountedPtr<tsi::SslSessionLRUCache> cache =
+      tsi::SslSessionLRUCache::Create(3);
+  cache->Put("expired.domain",
+             NewIdentifiedSession(&tracker, 1, TLS1_2_VERSION, /*age=*/100,
+                                  /*timeout=*/10));
+  cache->Put("valid.domain", NewIdentifiedSession(&tracker, 2, TLS1_2_VERSION,
+                                                  /*age=*/100,
+                                                  /*timeout=*/1000));
+  EXPECT_EQ(cache->Size(), 2);
+  EXPECT_EQ(cache->Get("expired.domain"), nullptr);
+  EXPECT_EQ(SessionId(cache->Get("valid.domain")), 2);
+  EXPECT_EQ(cache->Get("unknown.domain"), nullptr);
+  EXPECT_EQ(cache->Size(), 1);
+  tsi::SslSessionLRUCache::Stats stats = cache->GetStats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 2);
+  EXPECT_EQ(stats.expired, 1);
+}
+
+TEST(SslSessionCacheTest, Tls13SessionsAreHandedOutOnce) {
+  SessionTracker tracker;
+  RefCountedPtr<tsi::SslSessionLRUCache> cache =
+      tsi::SslSessionLRUCache::Create(3);
+  for (uint8_t id = 1; id <= tsi::SslSessionLRUCache::kMaxSessionsPerKey + 1;
+       id++) {
+    cache->Put("tls13.domain", NewIdentifiedSession(&tracker, id,
+                                                    TLS1_3_VERSION));
+  }
+  EXPECT_EQ(cache->Size(), 1);
+  // Most recent sessions are handed out first, each one only once, except for
+  // the last one which keeps being reused. The oldest one was discarded.
+  for (int id = tsi::SslSessionLRUCache::kMaxSessionsPerKey + 1; id > 2;
+       id--) {
+    EXPECT_EQ(SessionId(cache->Get("tls13.domain")), id);
+  }
+  EXPECT_EQ(SessionId(cache->Get("tls13.domain")), 2);
+  EXPECT_EQ(SessionId(cache->Get("tls13.domain")), 2);
+  // A TLS 1.2 session replaces all TLS 1.3 sessions.
+  cache->Put("tls13.domain", NewIdentifiedSession(&tracker, 10,
+                                                  TLS1_2_VERSION));
+  EXPECT_EQ(SessionId(cache->Get("tls13.domain")), 10);
+  EXPECT_EQ(SessionId(cache->Get("tls13.domain")), 10);
+  EXPECT_EQ(cache->GetStats().hits,
+            tsi::SslSessionLRUCache::kMaxSessionsPerKey + 3);
+}
+
+TEST(SslSessionCacheTest, ShardedCacheKeepsCapacity) {
+  SessionTracker tracker;
+  constexpr size_t kCapacity = 1024;
+  RefCountedPtr<tsi::SslSessionLRUCache> cache =
+      tsi::SslSessionLRUCache::Create(kCapacity);
+  for (size_t id = 0; id < 2 * kCapacity; id++) {
+    std::string domain = std::to_string(id) + ".random.domain";
+    cache->Put(domain.c_str(),
+               NewIdentifiedSession(&tracker, static_cast<uint8_t>(id),
+                                    TLS1_2_VERSION));
+    // The most recent session is always found.
+    EXPECT_NE(cache->Get(domain.c_str()), nullptr);
+  }
+  EXPECT_LE(cache->Size(), kCapacity);
+  EXPECT_GT(cache->Size(), kCapacity / 2);
+  EXPECT_EQ(cache->GetStats().hits, 2 * kCapacity);
+}
+
 }  // namespace
 }  // namespace grpc_core
 
@@ -22,6 +22,16 @@
 #include <stdio.h>
 #include <string.h>
 
+#ifdef GPR_LINUX
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#include <string>
+
 #include <openssl/crypto.h>
 #include <openssl/err.h>
 #include <openssl/pem.h>
@@ -101,6 +111,7 @@ typedef struct ssl_tsi_test_fixture {
   size_t session_ticket_key_size;
   size_t network_bio_buf_size;
   size_t ssl_bio_buf_size;
+  size_t cert_cache_capacity;
   tsi_ssl_server_handshaker_factory* server_handshaker_factory;
   tsi_ssl_client_handshaker_factory* client_handshaker_factory;
 } ssl_tsi_test_fixture;
@@ -135,9 +146,13 @@ static void ssl_test_setup_handshakers(tsi_test_fixture* fixture) {
   }
   client_options.min_tls_version = test_tls_version;
   client_options.max_tls_version = test_tls_version;
-  GPR_ASSERT(tsi_create_ssl_client_handshaker_factory_with_options(
-                 &client_options, &ssl_fixture->client_handshaker_factory) ==
-             TSI_OK);
+  client_options.cert_cache_capacity = ssl_fixture->cert_cache_capacity;
+  /* Factories handed over by a previous fixture are reused. */
+  if (ssl_fixture->client_handshaker_factory == nullptr) {
+    GPR_ASSERT(tsi_create_ssl_client_handshaker_factory_with_options(
+                   &client_options, &ssl_fixture->client_handshaker_factory) ==
+               TSI_OK);
+  }
   /* Create server handshaker factory. */
   tsi_ssl_server_handshaker_options server_options;
   if (alpn_lib->alpn_mode == ALPN_SERVER_NO_CLIENT ||
@@ -169,9 +184,12 @@ static void ssl_test_setup_handshakers(tsi_test_fixture* fixture) {
   server_options.session_ticket_key_size = ssl_fixture->session_ticket_key_size;
   server_options.min_tls_version = test_tls_version;
   server_options.max_tls_version = test_tls_version;
-  GPR_ASSERT(tsi_create_ssl_server_handshaker_factory_with_options(
-                 &server_options, &ssl_fixture->server_handshaker_factory) ==
-             TSI_OK);
+  server_options.cert_cache_capacity = ssl_fixture->cert_cache_capacity;
+  if (ssl_fixture->server_handshaker_factory == nullptr) {
+    GPR_ASSERT(tsi_create_ssl_server_handshaker_factory_with_options(
+                   &server_options, &ssl_fixture->server_handshaker_factory) ==
+               TSI_OK);
+  }
   /* Create server and client handshakers. */
   GPR_ASSERT(tsi_ssl_client_handshaker_factory_create_handshaker(
                  ssl_fixture->client_handshaker_factory,
@@ -779,6 +797,108 @@ void ssl_tsi_test_do_handshake_session_cache() {
   tsi_ssl_session_cache_unref(session_cache);
 }
 
+// Runs a handshake with certificate caches, then a second one on the same pair
+// of factories, and checks that the second one is served from the caches, for
+// good and bad client certificates.
+void ssl_tsi_test_do_handshake_with_cert_cache() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_do_handshake_with_cert_cache");
+  for (bool use_bad_client_cert : {false, true}) {
+    tsi_ssl_client_handshaker_factory* client_handshaker_factory = nullptr;
+    tsi_ssl_server_handshaker_factory* server_handshaker_factory = nullptr;
+    tsi::SslCertCache::Stats client_stats;
+    tsi::SslCertCache::Stats server_stats;
+    for (int i = 0; i < 2; i++) {
+      tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+      ssl_tsi_test_fixture* ssl_fixture =
+          reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
+      ssl_fixture->force_client_auth = true;
+      ssl_fixture->key_cert_lib->use_bad_client_cert = use_bad_client_cert;
+      ssl_fixture->cert_cache_capacity = 16;
+      ssl_fixture->client_handshaker_factory = client_handshaker_factory;
+      ssl_fixture->server_handshaker_factory = server_handshaker_factory;
+      tsi_test_do_handshake(fixture);
+      // Take the factories back before the fixture releases them.
+      client_handshaker_factory = ssl_fixture->client_handshaker_factory;
+      server_handshaker_factory = ssl_fixture->server_handshaker_factory;
+      ssl_fixture->client_handshaker_factory = nullptr;
+      ssl_fixture->server_handshaker_factory = nullptr;
+      tsi_test_fixture_destroy(fixture);
+      tsi::SslCertCache* client_cache =
+          tsi_ssl_client_handshaker_factory_get_cert_cache(
+              client_handshaker_factory);
+      tsi::SslCertCache* server_cache =
+          tsi_ssl_server_handshaker_factory_get_cert_cache(
+              server_handshaker_factory);
+      GPR_ASSERT(client_cache != nullptr);
+      GPR_ASSERT(server_cache != nullptr);
+      if (i == 0) {
+        client_stats = client_cache->GetStats();
+        server_stats = server_cache->GetStats();
+        continue;
+      }
+#if OPENSSL_VERSION_NUMBER >= 0x10100000
+      // The outcomes of verifying the chains, failed or not, are looked up
+      // rather than computed again.
+      GPR_ASSERT(client_cache->GetStats().hits > client_stats.hits);
+      GPR_ASSERT(server_cache->GetStats().hits > server_stats.hits);
+#endif
+    }
+    tsi_ssl_client_handshaker_factory_unref(client_handshaker_factory);
+    tsi_ssl_server_handshaker_factory_unref(server_handshaker_factory);
+  }
+}
+
+// Checks that both sides can tell from the ClientHello whether a session is
+// being resumed, before the server starts the handshake.
+void ssl_tsi_test_handshaker_is_resumption() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_handshaker_is_resumption");
+  tsi_ssl_session_cache* session_cache = tsi_ssl_session_cache_create_lru(16);
+  auto create_fixture = [&session_cache]() {
+    tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+    ssl_tsi_test_fixture* ssl_fixture =
+        reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
+    ssl_fixture->server_name_indication =
+        const_cast<char*>("waterzooi.test.google.be");
+    tsi_ssl_session_cache_ref(session_cache);
+    ssl_fixture->session_cache = session_cache;
+    return fixture;
+  };
+  auto check_client_hello = [&create_fixture](bool expect_resumption) {
+    tsi_test_fixture* fixture = create_fixture();
+    ssl_test_setup_handshakers(fixture);
+    const unsigned char* client_hello = nullptr;
+    size_t client_hello_size = 0;
+    tsi_handshaker_result* result = nullptr;
+    GPR_ASSERT(tsi_handshaker_next(fixture->client_handshaker, nullptr, 0,
+                                   &client_hello, &client_hello_size, &result,
+                                   nullptr, nullptr) == TSI_OK);
+    GPR_ASSERT(client_hello_size > 0);
+    bool is_resumption = !expect_resumption;
+    GPR_ASSERT(tsi_handshaker_is_resumption(fixture->client_handshaker,
+                                            nullptr, 0,
+                                            &is_resumption) == TSI_OK);
+    GPR_ASSERT(is_resumption == expect_resumption);
+    is_resumption = !expect_resumption;
+    GPR_ASSERT(tsi_handshaker_is_resumption(
+                   fixture->server_handshaker, client_hello,
+                   client_hello_size, &is_resumption) == TSI_OK);
+    GPR_ASSERT(is_resumption == expect_resumption);
+    // A truncated ClientHello is reported as a full handshake.
+    GPR_ASSERT(tsi_handshaker_is_resumption(fixture->server_handshaker,
+                                            client_hello, 16,
+                                            &is_resumption) == TSI_OK);
+    GPR_ASSERT(!is_resumption);
+    tsi_test_fixture_destroy(fixture);
+  };
+  check_client_hello(false);
+  // Fill the session cache.
+  tsi_test_fixture* fixture = create_fixture();
+  tsi_test_do_round_trip(fixture);
+  tsi_test_fixture_destroy(fixture);
+  check_client_hello(true);
+  tsi_ssl_session_cache_unref(session_cache);
+}
+
 static const tsi_ssl_handshaker_factory_vtable* original_vtable;
 static bool handshaker_factory_destructor_called;
 
@@ -1053,6 +1173,133 @@ void ssl_tsi_test_do_handshake_with_custom_bio_pair() {
   tsi_test_fixture_destroy(fixture);
 }
 
+#ifdef GPR_LINUX
+// Connects two loopback TCP sockets: fds[0] is the client and fds[1] is the
+// server end.
+static void ktls_test_create_tcp_pair(int fds[2]) {
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(listener >= 0);
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addr_len = sizeof(addr);
+  GPR_ASSERT(bind(listener, reinterpret_cast<sockaddr*>(&addr), addr_len) ==
+             0);
+  GPR_ASSERT(listen(listener, 1) == 0);
+  GPR_ASSERT(getsockname(listener, reinterpret_cast<sockaddr*>(&addr),
+                         &addr_len) == 0);
+  fds[0] = socket(AF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(fds[0] >= 0);
+  GPR_ASSERT(connect(fds[0], reinterpret_cast<sockaddr*>(&addr), addr_len) ==
+             0);
+  fds[1] = accept(listener, nullptr, nullptr);
+  GPR_ASSERT(fds[1] >= 0);
+  close(listener);
+  // Never hang the test if the kernel swallows a record.
+  struct timeval timeout = {10, 0};
+  for (int i = 0; i < 2; ++i) {
+    GPR_ASSERT(setsockopt(fds[i], SOL_SOCKET, SO_RCVTIMEO, &timeout,
+                          sizeof(timeout)) == 0);
+  }
+}
+
+static void ktls_test_unprotect(tsi_frame_protector* protector,
+                                const unsigned char* bytes, size_t size,
+                                std::string* message) {
+  unsigned char buffer[4096];
+  size_t produced;
+  do {
+    size_t consumed = size;
+    produced = sizeof(buffer);
+    GPR_ASSERT(tsi_frame_protector_unprotect(protector, bytes, &consumed,
+                                             buffer, &produced) == TSI_OK);
+    message->append(reinterpret_cast<char*>(buffer), produced);
+    bytes += consumed;
+    size -= consumed;
+  } while (size > 0 || produced > 0);
+}
+
+// Hands record protection of the server side to the kernel and checks that it
+// interoperates with userspace record protection on the client side.
+void ssl_tsi_test_offload_record_protection_to_kernel() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_offload_record_protection_to_kernel");
+  tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+  // Unused bytes cannot be offloaded, so do not inject any.
+  fixture->test_unused_bytes = false;
+  tsi_test_do_handshake(fixture);
+  int fds[2];
+  ktls_test_create_tcp_pair(fds);
+  tsi_result result = tsi_handshaker_result_offload_record_protection(
+      fixture->server_result, fds[1]);
+  if (result == TSI_UNIMPLEMENTED) {
+    gpr_log(GPR_INFO, "Kernel TLS offload is not supported here, skipping");
+    close(fds[0]);
+    close(fds[1]);
+    tsi_test_fixture_destroy(fixture);
+    return;
+  }
+  GPR_ASSERT(result == TSI_OK);
+  tsi_frame_protector* client_protector = nullptr;
+  GPR_ASSERT(tsi_handshaker_result_create_frame_protector(
+                 fixture->client_result, nullptr, &client_protector) == TSI_OK);
+  // Post-handshake records the server wrote before the offload (e.g. TLS 1.3
+  // session tickets) are still in the test channel.
+  tsi_test_channel* channel = fixture->channel;
+  std::string received;
+  ktls_test_unprotect(
+      client_protector,
+      channel->client_channel + channel->bytes_read_from_client_channel,
+      channel->bytes_written_to_client_channel -
+          channel->bytes_read_from_client_channel,
+      &received);
+  GPR_ASSERT(received.empty());
+  // Kernel-protected server -> userspace-protected client.
+  const std::string server_message = "Hello from the kernel";
+  GPR_ASSERT(write(fds[1], server_message.data(), server_message.size()) ==
+             static_cast<ssize_t>(server_message.size()));
+  while (received.size() < server_message.size()) {
+    unsigned char ciphertext[4096];
+    ssize_t n = read(fds[0], ciphertext, sizeof(ciphertext));
+    GPR_ASSERT(n > 0);
+    ktls_test_unprotect(client_protector, ciphertext, static_cast<size_t>(n),
+                        &received);
+  }
+  GPR_ASSERT(received == server_message);
+  // Userspace-protected client -> kernel-protected server.
+  const std::string client_message = "Hello from userspace";
+  unsigned char ciphertext[4096];
+  size_t unprotected_size = client_message.size();
+  size_t protected_size = sizeof(ciphertext);
+  GPR_ASSERT(tsi_frame_protector_protect(
+                 client_protector,
+                 reinterpret_cast<const unsigned char*>(client_message.data()),
+                 &unprotected_size, ciphertext, &protected_size) == TSI_OK);
+  GPR_ASSERT(unprotected_size == client_message.size());
+  size_t still_pending_size = 0;
+  size_t flushed_size = sizeof(ciphertext) - protected_size;
+  GPR_ASSERT(tsi_frame_protector_protect_flush(
+                 client_protector, ciphertext + protected_size, &flushed_size,
+                 &still_pending_size) == TSI_OK);
+  GPR_ASSERT(still_pending_size == 0);
+  protected_size += flushed_size;
+  GPR_ASSERT(write(fds[0], ciphertext, protected_size) ==
+             static_cast<ssize_t>(protected_size));
+  std::string plaintext;
+  while (plaintext.size() < client_message.size()) {
+    char buffer[4096];
+    ssize_t n = read(fds[1], buffer, sizeof(buffer));
+    GPR_ASSERT(n > 0);
+    plaintext.append(buffer, static_cast<size_t>(n));
+  }
+  GPR_ASSERT(plaintext == client_message);
+  tsi_frame_protector_destroy(client_protector);
+  close(fds[0]);
+  close(fds[1]);
+  tsi_test_fixture_destroy(fixture);
+}
+#endif  // GPR_LINUX
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   grpc_init();
@@ -1082,6 +1329,8 @@ int main(int argc, char** argv) {
     ssl_tsi_test_do_handshake_alpn_server_no_client();
     ssl_tsi_test_do_handshake_alpn_client_server_ok();
     ssl_tsi_test_do_handshake_session_cache();
+    ssl_tsi_test_do_handshake_with_cert_cache();
+    ssl_tsi_test_handshaker_is_resumption();
     ssl_tsi_test_do_round_trip_for_all_configs();
     ssl_tsi_test_do_round_trip_with_error_on_stack();
     ssl_tsi_test_do_round_trip_odd_buffer_size();
@@ -1090,6 +1339,9 @@ int main(int argc, char** argv) {
     ssl_tsi_test_extract_x509_subject_names();
     ssl_tsi_test_extract_cert_chain();
     ssl_tsi_test_do_handshake_with_custom_bio_pair();
+#ifdef GPR_LINUX
+    ssl_tsi_test_offload_record_protection_to_kernel();
+#endif
   }
   grpc_shutdown();
   return 0;
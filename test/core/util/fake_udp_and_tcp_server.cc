@@ -58,8 +58,11 @@ bool ErrorIsRetryable(int error) {
 FakeUdpAndTcpServer::FakeUdpAndTcpServer(
     AcceptMode accept_mode,
     std::function<FakeUdpAndTcpServer::ProcessReadResult(int, int, int)>
-        process_read_cb)
-    : accept_mode_(accept_mode), process_read_cb_(std::move(process_read_cb)) {
+        process_read_cb,
+    std::function<std::string(absl::string_view)> process_udp_read_cb)
+    : accept_mode_(accept_mode),
+      process_read_cb_(std::move(process_read_cb)),
+      process_udp_read_cb_(std::move(process_udp_read_cb)) {
   port_ = grpc_pick_unused_port_or_die();
   udp_socket_ = socket(AF_INET6, SOCK_DGRAM, 0);
   if (udp_socket_ == BAD_SOCKET_RETURN_VAL) {
@@ -230,8 +233,20 @@ void FakeUdpAndTcpServer::FakeUdpAndTcpServerPeer::
 }
 
 void FakeUdpAndTcpServer::ReadFromUdpSocket() {
-  char buf[100];
-  recvfrom(udp_socket_, buf, sizeof(buf), 0, nullptr, nullptr);
+  char buf[512];
+  sockaddr_in6 peer;
+  socklen_t peer_len = sizeof(peer);
+  int bytes_received =
+      recvfrom(udp_socket_, buf, sizeof(buf), 0,
+               reinterpret_cast<sockaddr*>(&peer), &peer_len);
+  if (bytes_received <= 0 || process_udp_read_cb_ == nullptr) return;
+  std::string response =
+      process_udp_read_cb_(absl::string_view(buf, bytes_received));
+  if (response.empty()) return;
+  if (sendto(udp_socket_, response.data(), response.size(), 0,
+             reinterpret_cast<const sockaddr*>(&peer), peer_len) < 0) {
+    gpr_log(GPR_ERROR, "Failed to send UDP response: %d", ERRNO);
+  }
 }
 
 void FakeUdpAndTcpServer::RunServerLoop() {
@@ -22,6 +22,7 @@
 #include <thread>
 
 #include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
 
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
@@ -83,9 +84,14 @@ class FakeUdpAndTcpServer {
                            // ALTS handshake servers)
   };
 
+  // If process_udp_read_cb is set, it is called with each datagram the
+  // server receives, and whatever it returns, if not empty, is sent back
+  // to the sender.  This is enough to emulate a DNS server.
   explicit FakeUdpAndTcpServer(
       AcceptMode accept_mode,
-      std::function<ProcessReadResult(int, int, int)> process_read_cb);
+      std::function<ProcessReadResult(int, int, int)> process_read_cb,
+      std::function<std::string(absl::string_view)> process_udp_read_cb =
+          nullptr);
 
   ~FakeUdpAndTcpServer();
 
@@ -131,6 +137,7 @@ class FakeUdpAndTcpServer {
   std::unique_ptr<std::thread> run_server_loop_thd_;
   const AcceptMode accept_mode_;
   std::function<ProcessReadResult(int, int, int)> process_read_cb_;
+  std::function<std::string(absl::string_view)> process_udp_read_cb_;
 };
 
 }  // namespace testing
@@ -0,0 +1,223 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/xds/xds_endpoint.h"
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "absl/strings/match.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/xds/xds_client_stats.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/iomgr/port.h"
+#include "src/core/lib/uri/uri_parser.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+using EndpointList = XdsEndpointResource::Priority::Locality::EndpointList;
+
+grpc_resolved_address MakeAddress(absl::string_view address_str) {
+  grpc_resolved_address address;
+  if (absl::StartsWith(address_str, "unix:")) {
+    absl::StatusOr<URI> uri = URI::Parse(address_str);
+    GPR_ASSERT(uri.ok());
+    GPR_ASSERT(grpc_parse_unix(*uri, &address));
+  } else if (absl::StartsWith(address_str, "[")) {
+    GPR_ASSERT(grpc_parse_ipv6_hostport(address_str, &address,
+                                        /*log_errors=*/true));
+  } else {
+    GPR_ASSERT(grpc_parse_ipv4_hostport(address_str, &address,
+                                        /*log_errors=*/true));
+  }
+  return address;
+}
+
+std::vector<EndpointList::Endpoint> GetEndpoints(
+    const EndpointList& endpoints) {
+  std::vector<EndpointList::Endpoint> result;
+  endpoints.ForEach([&](const EndpointList::Endpoint& endpoint) {
+    result.push_back(endpoint);
+  });
+  return result;
+}
+
+void ExpectSameAddress(const grpc_resolved_address& actual,
+                       const grpc_resolved_address& expected) {
+  ASSERT_EQ(actual.len, expected.len);
+  EXPECT_EQ(memcmp(actual.addr, expected.addr, expected.len), 0);
+}
+
+TEST(EndpointListTest, Empty) {
+  EndpointList endpoints;
+  EXPECT_TRUE(endpoints.empty());
+  EXPECT_EQ(endpoints.size(), 0);
+  EXPECT_TRUE(GetEndpoints(endpoints).empty());
+  EXPECT_EQ(endpoints.ToString(), "[]");
+}
+
+TEST(EndpointListTest, RoundTripsAddressesAndWeights) {
+  const std::vector<std::pair<std::string, uint32_t>> inputs = {
+      {"127.0.0.1:443", 1},
+      {"[2001:db8::1]:8080", 0},
+      {"10.0.0.2:80", 4294967295u},
+      {"[::1]:1", 7},
+  };
+  EndpointList endpoints;
+  for (const auto& input : inputs) {
+    endpoints.Add(MakeAddress(input.first), input.second);
+  }
+  endpoints.ShrinkToFit();
+  EXPECT_FALSE(endpoints.empty());
+  EXPECT_EQ(endpoints.size(), inputs.size());
+  std::vector<EndpointList::Endpoint> output = GetEndpoints(endpoints);
+  ASSERT_EQ(output.size(), inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    SCOPED_TRACE(inputs[i].first);
+    ExpectSameAddress(output[i].address, MakeAddress(inputs[i].first));
+    EXPECT_EQ(output[i].weight, inputs[i].second);
+  }
+  EXPECT_EQ(endpoints.ToString(),
+            "[127.0.0.1:443 weight=1, [2001:db8::1]:8080 weight=0, "
+            "10.0.0.2:80 weight=4294967295, [::1]:1 weight=7]");
+}
+
+#ifdef GRPC_HAVE_UNIX_SOCKET
+
+TEST(EndpointListTest, RoundTripsUnixAddresses) {
+  EndpointList endpoints;
+  endpoints.Add(MakeAddress("127.0.0.1:443"), 1);
+  endpoints.Add(MakeAddress("unix:/tmp/xds_endpoint_test.sock"), 2);
+  endpoints.Add(MakeAddress("[::1]:443"), 3);
+  std::vector<EndpointList::Endpoint> output = GetEndpoints(endpoints);
+  ASSERT_EQ(output.size(), 3);
+  ExpectSameAddress(output[1].address,
+                    MakeAddress("unix:/tmp/xds_endpoint_test.sock"));
+  EXPECT_EQ(output[1].weight, 2);
+  EXPECT_EQ(grpc_sockaddr_to_uri(&output[1].address).value(),
+            "unix:/tmp/xds_endpoint_test.sock");
+  ExpectSameAddress(output[2].address, MakeAddress("[::1]:443"));
+  EXPECT_EQ(output[2].weight, 3);
+  EXPECT_EQ(endpoints.ToString(),
+            "[127.0.0.1:443 weight=1, /tmp/xds_endpoint_test.sock weight=2, "
+            "[::1]:443 weight=3]");
+}
+
+#endif  // GRPC_HAVE_UNIX_SOCKET
+
+TEST(EndpointListTest, MaximumAddressLength) {
+  grpc_resolved_address address;
+  for (size_t i = 0; i < GRPC_MAX_SOCKADDR_SIZE; ++i) {
+    address.addr[i] = static_cast<char>(i * 7 + 3);
+  }
+  address.len = GRPC_MAX_SOCKADDR_SIZE;
+  EndpointList endpoints;
+  endpoints.Add(address, 1);
+  // An address of the longest length must not disturb its neighbours.
+  endpoints.Add(MakeAddress("127.0.0.1:443"), 2);
+  endpoints.Add(address, 3);
+  std::vector<EndpointList::Endpoint> output = GetEndpoints(endpoints);
+  ASSERT_EQ(output.size(), 3);
+  ExpectSameAddress(output[0].address, address);
+  EXPECT_EQ(output[0].weight, 1);
+  ExpectSameAddress(output[1].address, MakeAddress("127.0.0.1:443"));
+  EXPECT_EQ(output[1].weight, 2);
+  ExpectSameAddress(output[2].address, address);
+  EXPECT_EQ(output[2].weight, 3);
+}
+
+TEST(EndpointListTest, Equality) {
+  EndpointList endpoints1;
+  endpoints1.Add(MakeAddress("127.0.0.1:443"), 1);
+  EndpointList endpoints2;
+  endpoints2.Add(MakeAddress("127.0.0.1:443"), 1);
+  EXPECT_TRUE(endpoints1 == endpoints2);
+  EndpointList endpoints3;
+  endpoints3.Add(MakeAddress("127.0.0.1:443"), 2);
+  EXPECT_FALSE(endpoints1 == endpoints3);
+  EndpointList endpoints4;
+  endpoints4.Add(MakeAddress("127.0.0.1:444"), 1);
+  EXPECT_FALSE(endpoints1 == endpoints4);
+}
+
+TEST(XdsLocalityNameTest, InternReturnsSameNameForEqualParts) {
+  RefCountedPtr<XdsLocalityName> name1 =
+      XdsLocalityName::Intern("region", "zone", "sub_zone");
+  RefCountedPtr<XdsLocalityName> name2 =
+      XdsLocalityName::Intern("region", "zone", "sub_zone");
+  EXPECT_EQ(name1.get(), name2.get());
+  EXPECT_EQ(name1->AsHumanReadableString(),
+            "{region=\"region\", zone=\"zone\", sub_zone=\"sub_zone\"}");
+  // Names that differ in any part are distinct.
+  RefCountedPtr<XdsLocalityName> name3 =
+      XdsLocalityName::Intern("region", "zone", "other");
+  RefCountedPtr<XdsLocalityName> name4 =
+      XdsLocalityName::Intern("region", "other", "sub_zone");
+  RefCountedPtr<XdsLocalityName> name5 =
+      XdsLocalityName::Intern("other", "zone", "sub_zone");
+  EXPECT_NE(name1.get(), name3.get());
+  EXPECT_NE(name1.get(), name4.get());
+  EXPECT_NE(name1.get(), name5.get());
+  EXPECT_NE(name3.get(), name4.get());
+  EXPECT_EQ(name3->sub_zone(), "other");
+  EXPECT_EQ(name4->zone(), "other");
+  EXPECT_EQ(name5->region(), "other");
+}
+
+TEST(XdsLocalityNameTest, InternAfterLastRefIsDropped) {
+  RefCountedPtr<XdsLocalityName> name =
+      XdsLocalityName::Intern("region", "zone", "dropped");
+  name.reset();
+  // The destroyed name is no longer returned; a new one takes its place.
+  name = XdsLocalityName::Intern("region", "zone", "dropped");
+  ASSERT_NE(name, nullptr);
+  EXPECT_EQ(name->region(), "region");
+  EXPECT_EQ(name->zone(), "zone");
+  EXPECT_EQ(name->sub_zone(), "dropped");
+  RefCountedPtr<XdsLocalityName> name2 =
+      XdsLocalityName::Intern("region", "zone", "dropped");
+  EXPECT_EQ(name.get(), name2.get());
+  // Dropping the new name's refs one at a time keeps it interned until
+  // the last one goes.
+  name.reset();
+  RefCountedPtr<XdsLocalityName> name3 =
+      XdsLocalityName::Intern("region", "zone", "dropped");
+  EXPECT_EQ(name2.get(), name3.get());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
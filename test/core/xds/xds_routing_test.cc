@@ -0,0 +1,218 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/xds/xds_routing.h"
+
+#include <stdlib.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+using Matchers = XdsRouteConfigResource::Route::Matchers;
+
+class RouteList : public XdsRouting::RouteListIterator {
+ public:
+  explicit RouteList(const std::vector<Matchers>* routes) : routes_(routes) {}
+
+  size_t Size() const override { return routes_->size(); }
+
+  const Matchers& GetMatchersForRoute(size_t index) const override {
+    return (*routes_)[index];
+  }
+
+ private:
+  const std::vector<Matchers>* routes_;
+};
+
+Matchers PathMatcher(StringMatcher::Type type, absl::string_view path,
+                     bool case_sensitive = true) {
+  Matchers matchers;
+  auto path_matcher = StringMatcher::Create(type, path, case_sensitive);
+  GPR_ASSERT(path_matcher.ok());
+  matchers.path_matcher = std::move(*path_matcher);
+  return matchers;
+}
+
+HeaderMatcher MakeHeaderMatcher(absl::string_view name,
+                                HeaderMatcher::Type type,
+                                absl::string_view matcher,
+                                bool present_match = false,
+                                bool invert_match = false) {
+  auto header_matcher = HeaderMatcher::Create(
+      name, type, matcher, /*range_start=*/0, /*range_end=*/0, present_match,
+      invert_match);
+  GPR_ASSERT(header_matcher.ok());
+  return std::move(*header_matcher);
+}
+
+class XdsRoutingTest : public ::testing::Test {
+ protected:
+  // Returns the route that both the linear scan and RouteMatcher select
+  // for the request, after checking that they agree.  Both start from the
+  // same seed, so fractions draw the same numbers for the same routes.
+  absl::optional<size_t> GetRoute(
+      const std::vector<Matchers>& routes, absl::string_view path,
+      const std::vector<std::pair<std::string, std::string>>& headers = {},
+      unsigned int seed = 0) {
+    RouteList route_list(&routes);
+    XdsRouting::RouteMatcher route_matcher(route_list);
+    auto arena = MakeScopedArena(1024, &memory_allocator_);
+    grpc_metadata_batch initial_metadata(arena.get());
+    for (const auto& header : headers) {
+      initial_metadata.Append(
+          header.first, Slice::FromCopiedString(header.second),
+          [](absl::string_view, const Slice&) { GPR_ASSERT(false); });
+    }
+    srand(seed);
+    absl::optional<size_t> expected =
+        XdsRouting::GetRouteForRequest(route_list, path, &initial_metadata);
+    srand(seed);
+    absl::optional<size_t> actual =
+        route_matcher.GetRouteForRequest(path, &initial_metadata);
+    EXPECT_EQ(actual, expected) << "path " << path << ", seed " << seed;
+    return actual;
+  }
+
+  MemoryAllocator memory_allocator_ = MemoryAllocator(
+      ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator("test"));
+};
+
+TEST_F(XdsRoutingTest, CaseInsensitiveExactAndPrefixPaths) {
+  std::vector<Matchers> routes = {
+      PathMatcher(StringMatcher::Type::kExact, "/Svc/Method",
+                  /*case_sensitive=*/false),
+      PathMatcher(StringMatcher::Type::kPrefix, "/svc/",
+                  /*case_sensitive=*/true),
+      PathMatcher(StringMatcher::Type::kPrefix, "/SVC/",
+                  /*case_sensitive=*/false),
+      PathMatcher(StringMatcher::Type::kExact, "/other/Method",
+                  /*case_sensitive=*/true),
+      PathMatcher(StringMatcher::Type::kPrefix, "",
+                  /*case_sensitive=*/false),
+  };
+  EXPECT_EQ(GetRoute(routes, "/svc/method"), 0);
+  EXPECT_EQ(GetRoute(routes, "/SVC/METHOD"), 0);
+  EXPECT_EQ(GetRoute(routes, "/svc/other"), 1);
+  EXPECT_EQ(GetRoute(routes, "/Svc/other"), 2);
+  EXPECT_EQ(GetRoute(routes, "/other/Method"), 3);
+  EXPECT_EQ(GetRoute(routes, "/other/method"), 4);
+  EXPECT_EQ(GetRoute(routes, "/svc/method/extra"), 1);
+}
+
+TEST_F(XdsRoutingTest, RegexPaths) {
+  std::vector<Matchers> routes = {
+      PathMatcher(StringMatcher::Type::kSafeRegex, "/svc/[a-c]+"),
+      PathMatcher(StringMatcher::Type::kExact, "/svc/abc"),
+      PathMatcher(StringMatcher::Type::kSafeRegex, "/svc/.*"),
+      PathMatcher(StringMatcher::Type::kSuffix, "/method"),
+  };
+  EXPECT_EQ(GetRoute(routes, "/svc/abc"), 0);
+  EXPECT_EQ(GetRoute(routes, "/svc/abcd"), 2);
+  // Regexes must match the whole path.
+  EXPECT_EQ(GetRoute(routes, "/x/svc/abc"), absl::nullopt);
+  EXPECT_EQ(GetRoute(routes, "/other/method"), 3);
+}
+
+TEST_F(XdsRoutingTest, HeaderMatchersWithInvertAndPresent) {
+  std::vector<Matchers> routes(4, PathMatcher(StringMatcher::Type::kPrefix,
+                                              "/svc/"));
+  routes[0].header_matchers.push_back(
+      MakeHeaderMatcher("env", HeaderMatcher::Type::kExact, "prod",
+                        /*present_match=*/false, /*invert_match=*/true));
+  routes[0].header_matchers.push_back(
+      MakeHeaderMatcher("user", HeaderMatcher::Type::kPresent, "",
+                        /*present_match=*/true));
+  routes[1].header_matchers.push_back(
+      MakeHeaderMatcher("user", HeaderMatcher::Type::kPresent, "",
+                        /*present_match=*/false));
+  routes[2].header_matchers.push_back(
+      MakeHeaderMatcher("env", HeaderMatcher::Type::kPrefix, "pr"));
+  routes[2].header_matchers.push_back(
+      MakeHeaderMatcher("user", HeaderMatcher::Type::kPresent, "",
+                        /*present_match=*/true, /*invert_match=*/true));
+  EXPECT_EQ(GetRoute(routes, "/svc/m", {{"env", "dev"}, {"user", "a"}}), 0);
+  EXPECT_EQ(GetRoute(routes, "/svc/m", {{"env", "prod"}, {"user", "a"}}),
+            3);
+  EXPECT_EQ(GetRoute(routes, "/svc/m", {{"env", "dev"}}), 1);
+  EXPECT_EQ(GetRoute(routes, "/svc/m", {}), 1);
+  EXPECT_EQ(GetRoute(routes, "/svc/m", {{"env", "prod"}}), 1);
+  routes.erase(routes.begin() + 1);
+  EXPECT_EQ(GetRoute(routes, "/svc/m", {{"env", "prod"}}), 1);
+  EXPECT_EQ(GetRoute(routes, "/other", {{"env", "dev"}, {"user", "a"}}),
+            absl::nullopt);
+}
+
+TEST_F(XdsRoutingTest, RuntimeFractions) {
+  std::vector<Matchers> routes = {
+      PathMatcher(StringMatcher::Type::kPrefix, "/svc/"),
+      PathMatcher(StringMatcher::Type::kSafeRegex, "/svc/.*"),
+      PathMatcher(StringMatcher::Type::kPrefix, "/other/"),
+      PathMatcher(StringMatcher::Type::kPrefix, "/"),
+  };
+  routes[0].fraction_per_million = 300000;
+  routes[0].header_matchers.push_back(
+      MakeHeaderMatcher("env", HeaderMatcher::Type::kExact, "prod"));
+  routes[1].fraction_per_million = 500000;
+  routes[2].fraction_per_million = 1000000;
+  routes[3].fraction_per_million = 500000;
+  size_t counts[4] = {};
+  size_t num_unmatched = 0;
+  for (unsigned int seed = 0; seed < 1000; ++seed) {
+    absl::optional<size_t> route =
+        GetRoute(routes, "/svc/m", {{"env", "prod"}}, seed);
+    if (route.has_value()) {
+      ++counts[*route];
+    } else {
+      ++num_unmatched;
+    }
+    // A route whose headers do not match draws no number.
+    GetRoute(routes, "/svc/m", {{"env", "dev"}}, seed);
+    GetRoute(routes, "/other/m", {}, seed);
+  }
+  // Each route that matches the path gets a share of the requests.
+  EXPECT_GT(counts[0], 0);
+  EXPECT_GT(counts[1], 0);
+  EXPECT_EQ(counts[2], 0);
+  EXPECT_GT(counts[3], 0);
+  EXPECT_GT(num_unmatched, 0);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -12,10 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <limits.h>
+
 #include <algorithm>
+#include <cmath>
 #include <deque>
+#include <limits>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <random>
 #include <set>
 #include <string>
@@ -28,6 +34,9 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "absl/types/optional.h"
 
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
@@ -105,7 +114,21 @@ class MyTestServiceImpl : public TestServiceImpl {
       for (const auto& p : load_report_.utilization()) {
         recorder->RecordUtilizationMetric(p.first, p.second);
       }
+    } else {
+      grpc::internal::MutexLock lock(&mu_);
+      if (call_qps_ > 0) {
+        auto* recorder = context->ExperimentalGetCallMetricRecorder();
+        EXPECT_NE(recorder, nullptr);
+        recorder->RecordQpsMetric(call_qps_).RecordCpuUtilizationMetric(
+            call_cpu_utilization_);
+      }
+    }
+    absl::Duration response_delay;
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      response_delay = response_delay_;
     }
+    if (response_delay > absl::ZeroDuration()) absl::SleepFor(response_delay);
     return TestServiceImpl::Echo(context, request, response);
   }
 
@@ -119,6 +142,20 @@ class MyTestServiceImpl : public TestServiceImpl {
     request_count_ = 0;
   }
 
+  // Sets the backend metrics reported by calls that do not request
+  // metrics of their own.
+  void SetCallMetrics(double qps, double cpu_utilization) {
+    grpc::internal::MutexLock lock(&mu_);
+    call_qps_ = qps;
+    call_cpu_utilization_ = cpu_utilization;
+  }
+
+  // Delays every response by the given time.
+  void SetResponseDelay(absl::Duration delay) {
+    grpc::internal::MutexLock lock(&mu_);
+    response_delay_ = delay;
+  }
+
   std::set<std::string> clients() {
     grpc::internal::MutexLock lock(&clients_mu_);
     return clients_;
@@ -132,6 +169,9 @@ class MyTestServiceImpl : public TestServiceImpl {
 
   grpc::internal::Mutex mu_;
   int request_count_ = 0;
+  double call_qps_ = 0;
+  double call_cpu_utilization_ = 0;
+  absl::Duration response_delay_;
   grpc::internal::Mutex clients_mu_;
   std::set<std::string> clients_;
   // For strings storage.
@@ -360,6 +400,8 @@ class ClientLbEnd2endTest : public ::testing::Test {
     MyTestServiceImpl service_;
     experimental::OrcaService orca_service_;
     std::unique_ptr<std::thread> thread_;
+    // If non-zero, the server's MAX_CONCURRENT_STREAMS setting.
+    int max_concurrent_streams_ = 0;
 
     grpc::internal::Mutex mu_;
     grpc::internal::CondVar cond_;
@@ -393,6 +435,10 @@ class ClientLbEnd2endTest : public ::testing::Test {
       builder.AddListeningPort(server_address.str(), std::move(creds));
       builder.RegisterService(&service_);
       builder.RegisterService(&orca_service_);
+      if (max_concurrent_streams_ > 0) {
+        builder.AddChannelArgument(GRPC_ARG_MAX_CONCURRENT_STREAMS,
+                                   max_concurrent_streams_);
+      }
       server_ = builder.BuildAndStart();
       grpc::internal::MutexLock lock(&mu_);
       server_ready_ = true;
@@ -1422,6 +1468,173 @@ TEST_F(PickFirstTest,
   CheckRpcSendOk(stub, DEBUG_LOCATION);
 }
 
+class PickFirstHappyEyeballsTest : public ClientLbEnd2endTest {
+ protected:
+  // Holds connection attempts to blackholed ports until destroyed, the way
+  // an unroutable address leaves them hanging until the connect timeout,
+  // and delays attempts to other ports if asked to.  Records when the first
+  // attempt to each port was made.
+  class ConnectionInjector : public ConnectionAttemptInjector {
+   public:
+    ~ConnectionInjector() override {
+      grpc_core::ExecCtx exec_ctx;
+      grpc_core::MutexLock lock(&mu_);
+      for (auto& attempt : held_attempts_) {
+        attempt->Fail(GRPC_ERROR_CREATE_FROM_STATIC_STRING("blackholed"));
+      }
+    }
+
+    // Must be called before Start().
+    void Blackhole(int port) { blackholed_ports_.insert(port); }
+    void Delay(int port, grpc_core::Duration delay) { delays_[port] = delay; }
+
+    absl::optional<absl::Time> FirstAttemptTime(int port) {
+      grpc_core::MutexLock lock(&mu_);
+      auto it = first_attempt_times_.find(port);
+      if (it == first_attempt_times_.end()) return absl::nullopt;
+      return it->second;
+    }
+
+    void HandleConnection(grpc_closure* closure, grpc_endpoint** ep,
+                          grpc_pollset_set* interested_parties,
+                          const grpc_channel_args* channel_args,
+                          const grpc_resolved_address* addr,
+                          grpc_core::Timestamp deadline) override {
+      const int port = grpc_sockaddr_get_port(addr);
+      {
+        grpc_core::MutexLock lock(&mu_);
+        first_attempt_times_.emplace(port, absl::Now());
+      }
+      if (blackholed_ports_.count(port) > 0) {
+        gpr_log(GPR_INFO, "*** HOLDING CONNECTION ATTEMPT TO PORT %d", port);
+        grpc_core::MutexLock lock(&mu_);
+        held_attempts_.push_back(absl::make_unique<QueuedAttempt>(
+            closure, ep, interested_parties, channel_args, addr, deadline));
+        return;
+      }
+      auto it = delays_.find(port);
+      if (it != delays_.end()) {
+        new InjectedDelay(it->second, closure, ep, interested_parties,
+                          channel_args, addr, deadline);
+        return;
+      }
+      AttemptConnection(closure, ep, interested_parties, channel_args, addr,
+                        deadline);
+    }
+
+   private:
+    std::set<int> blackholed_ports_;
+    std::map<int, grpc_core::Duration> delays_;
+    grpc_core::Mutex mu_;
+    std::vector<std::unique_ptr<QueuedAttempt>> held_attempts_
+        ABSL_GUARDED_BY(mu_);
+    std::map<int, absl::Time> first_attempt_times_ ABSL_GUARDED_BY(mu_);
+  };
+};
+
+TEST_F(PickFirstHappyEyeballsTest, RacesPastUnroutableAddress) {
+  StartServers(1);
+  const int unroutable_port = grpc_pick_unused_port_or_die();
+  ConnectionInjector injector;
+  injector.Blackhole(unroutable_port);
+  injector.Start();
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("pick_first", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution({unroutable_port, servers_[0]->port_});
+  const absl::Time start = absl::Now();
+  CheckRpcSendOk(stub, DEBUG_LOCATION, /*wait_for_ready=*/true,
+                 /*load_report=*/nullptr,
+                 /*timeout_ms=*/10000 * grpc_test_slowdown_factor());
+  // The second address is tried 250 ms after the first one, instead of
+  // once the first attempt times out 20 seconds later.
+  const absl::Duration elapsed = absl::Now() - start;
+  gpr_log(GPR_INFO, "connected in %s", absl::FormatDuration(elapsed).c_str());
+  EXPECT_LT(elapsed, absl::Seconds(2 * grpc_test_slowdown_factor()));
+  EXPECT_EQ(servers_[0]->service_.request_count(), 1);
+}
+
+TEST_F(PickFirstHappyEyeballsTest, WithoutRacingWaitsOnUnroutableAddress) {
+  StartServers(1);
+  const int unroutable_port = grpc_pick_unused_port_or_die();
+  ConnectionInjector injector;
+  injector.Blackhole(unroutable_port);
+  injector.Start();
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_HAPPY_EYEBALLS_CONNECTION_ATTEMPT_DELAY_MS, INT_MAX);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("pick_first", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution({unroutable_port, servers_[0]->port_});
+  // Trying one address at a time, the RPC is stuck behind the first
+  // attempt.
+  Status status;
+  EXPECT_FALSE(SendRpc(stub, nullptr, 2000 * grpc_test_slowdown_factor(),
+                       &status, /*wait_for_ready=*/true));
+  EXPECT_EQ(status.error_code(), StatusCode::DEADLINE_EXCEEDED);
+  EXPECT_EQ(servers_[0]->service_.request_count(), 0);
+}
+
+TEST_F(PickFirstHappyEyeballsTest, KeepsEarlierAttemptsGoing) {
+  StartServers(2);
+  // The attempt to the first address takes longer than the attempt delay,
+  // and the one to the second address never finishes.
+  ConnectionInjector injector;
+  injector.Delay(servers_[0]->port_, grpc_core::Duration::Milliseconds(
+                                         500 * grpc_test_slowdown_factor()));
+  injector.Blackhole(servers_[1]->port_);
+  injector.Start();
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_HAPPY_EYEBALLS_CONNECTION_ATTEMPT_DELAY_MS, 100);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("pick_first", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  CheckRpcSendOk(stub, DEBUG_LOCATION, /*wait_for_ready=*/true,
+                 /*load_report=*/nullptr,
+                 /*timeout_ms=*/10000 * grpc_test_slowdown_factor());
+  EXPECT_EQ(servers_[0]->service_.request_count(), 1);
+}
+
+TEST_F(PickFirstHappyEyeballsTest, WaitsAttemptDelayBetweenAttempts) {
+  StartServers(1);
+  const int unroutable_port0 = grpc_pick_unused_port_or_die();
+  const int unroutable_port1 = grpc_pick_unused_port_or_die();
+  ConnectionInjector injector;
+  injector.Blackhole(unroutable_port0);
+  injector.Blackhole(unroutable_port1);
+  injector.Start();
+  const int kDelayMs = 500 * grpc_test_slowdown_factor();
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_HAPPY_EYEBALLS_CONNECTION_ATTEMPT_DELAY_MS, kDelayMs);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("pick_first", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      {unroutable_port0, unroutable_port1, servers_[0]->port_});
+  CheckRpcSendOk(stub, DEBUG_LOCATION, /*wait_for_ready=*/true,
+                 /*load_report=*/nullptr,
+                 /*timeout_ms=*/10000 * grpc_test_slowdown_factor());
+  // Each address is tried one attempt delay after the one before it, since
+  // the earlier attempts neither fail nor succeed.
+  const std::vector<int> ports = {unroutable_port0, unroutable_port1,
+                                  servers_[0]->port_};
+  for (size_t i = 1; i < ports.size(); ++i) {
+    const auto previous = injector.FirstAttemptTime(ports[i - 1]);
+    const auto current = injector.FirstAttemptTime(ports[i]);
+    ASSERT_TRUE(previous.has_value()) << "port " << ports[i - 1];
+    ASSERT_TRUE(current.has_value()) << "port " << ports[i];
+    const absl::Duration gap = *current - *previous;
+    gpr_log(GPR_INFO, "attempt %" PRIuPTR " started %s after attempt %" PRIuPTR,
+            i, absl::FormatDuration(gap).c_str(), i - 1);
+    // Timer deadlines are computed from the ExecCtx's cached time, which
+    // may lag a little behind the real clock.
+    EXPECT_GE(gap, absl::Milliseconds(kDelayMs * 0.9)) << "attempt " << i;
+    EXPECT_LT(gap, absl::Milliseconds(kDelayMs * 2)) << "attempt " << i;
+  }
+  EXPECT_EQ(servers_[0]->service_.request_count(), 1);
+}
+
 //
 // round_robin tests
 //
@@ -2433,6 +2646,30 @@ TEST_F(ClientLbInterceptTrailingMetadataTest, BackendMetricData) {
   EXPECT_EQ(kNumRpcs, trailers_intercepted());
 }
 
+TEST_F(ClientLbInterceptTrailingMetadataTest,
+       BackendMetricDataIgnoresInvalidValues) {
+  StartServers(1);
+  xds::data::orca::v3::OrcaLoadReport load_report;
+  load_report.set_cpu_utilization(-0.5);
+  load_report.set_mem_utilization(0.75);
+  auto* utilization = load_report.mutable_utilization();
+  (*utilization)["baz"] = std::numeric_limits<double>::quiet_NaN();
+  (*utilization)["quux"] = 0.9;
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel =
+      BuildChannel("intercept_trailing_metadata_lb", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  CheckRpcSendOk(stub, DEBUG_LOCATION, false, &load_report);
+  auto actual = backend_load_report();
+  ASSERT_TRUE(actual.has_value());
+  // The negative CPU utilization and the NaN utilization were not sent.
+  EXPECT_EQ(actual->cpu_utilization(), 0);
+  EXPECT_EQ(actual->mem_utilization(), 0.75);
+  EXPECT_THAT(actual->utilization(),
+              ::testing::UnorderedElementsAre(::testing::Pair("quux", 0.9)));
+}
+
 //
 // tests that address attributes from the resolver are visible to the LB policy
 //
@@ -2619,6 +2856,337 @@ TEST_F(OobBackendMetricTest, Basic) {
   }
 }
 
+//
+// tests weighted_round_robin LB policy
+//
+
+class WeightedRoundRobinTest : public ClientLbEnd2endTest {
+ protected:
+  // Sends batches of RPCs until each server's share of a batch is within
+  // 20% of its share of \a expected_weights.
+  void WaitForWeightedDistribution(
+      const std::unique_ptr<grpc::testing::EchoTestService::Stub>& stub,
+      const std::vector<int>& expected_weights,
+      const grpc_core::DebugLocation& location) {
+    const int total_weight = std::accumulate(expected_weights.begin(),
+                                             expected_weights.end(), 0);
+    const int num_rpcs = total_weight * 20;
+    auto deadline =
+        absl::Now() + (absl::Seconds(30) * grpc_test_slowdown_factor());
+    while (true) {
+      ResetCounters();
+      for (int i = 0; i < num_rpcs; ++i) CheckRpcSendOk(stub, location);
+      bool matched = true;
+      for (size_t i = 0; i < expected_weights.size(); ++i) {
+        const double expected = num_rpcs * expected_weights[i] /
+                                static_cast<double>(total_weight);
+        const int actual = servers_[i]->service_.request_count();
+        gpr_log(GPR_INFO, "server %" PRIuPTR ": expected %f, actual %d", i,
+                expected, actual);
+        if (std::abs(actual - expected) > expected * 0.2) matched = false;
+      }
+      if (matched) break;
+      ASSERT_LT(absl::Now(), deadline)
+          << "From " << location.file() << ":" << location.line()
+          << ": timed out waiting for weighted distribution";
+    }
+  }
+};
+
+TEST_F(WeightedRoundRobinTest, PerCallLoadReports) {
+  StartServers(3);
+  // Each server handles the same qps at a different CPU cost, so their
+  // weights are 4:2:1.
+  servers_[0]->service_.SetCallMetrics(100, 0.1);
+  servers_[1]->service_.SetCallMetrics(100, 0.2);
+  servers_[2]->service_.SetCallMetrics(100, 0.4);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"weighted_round_robin\": {"
+      "\"blackoutPeriod\": \"0s\", \"weightUpdatePeriod\": \"0.1s\"}}]}");
+  WaitForWeightedDistribution(stub, {4, 2, 1}, DEBUG_LOCATION);
+  EXPECT_EQ("weighted_round_robin", channel->GetLoadBalancingPolicyName());
+}
+
+TEST_F(WeightedRoundRobinTest, OobLoadReports) {
+  StartServers(3);
+  for (size_t i = 0; i < servers_.size(); ++i) {
+    servers_[i]->orca_service_.SetQps(100);
+  }
+  servers_[0]->orca_service_.SetCpuUtilization(0.1);
+  servers_[1]->orca_service_.SetCpuUtilization(0.2);
+  servers_[2]->orca_service_.SetCpuUtilization(0.4);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"weighted_round_robin\": {"
+      "\"enableOobLoadReport\": true, \"oobReportingPeriod\": \"0.1s\", "
+      "\"blackoutPeriod\": \"0s\", \"weightUpdatePeriod\": \"0.1s\"}}]}");
+  WaitForWeightedDistribution(stub, {4, 2, 1}, DEBUG_LOCATION);
+}
+
+TEST_F(WeightedRoundRobinTest, NoWeightsDuringBlackoutPeriod) {
+  StartServers(3);
+  servers_[0]->service_.SetCallMetrics(100, 0.1);
+  servers_[1]->service_.SetCallMetrics(100, 0.2);
+  servers_[2]->service_.SetCallMetrics(100, 0.4);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"weighted_round_robin\": {"
+      "\"blackoutPeriod\": \"3600s\", \"weightUpdatePeriod\": \"0.1s\"}}]}");
+  WaitForServers(stub, 0, servers_.size(), DEBUG_LOCATION);
+  // The reported weights are not used yet, so traffic stays uniform.
+  ResetCounters();
+  for (size_t i = 0; i < 300; ++i) CheckRpcSendOk(stub, DEBUG_LOCATION);
+  for (size_t i = 0; i < servers_.size(); ++i) {
+    EXPECT_NEAR(servers_[i]->service_.request_count(), 100, 2)
+        << "server " << i;
+  }
+}
+
+TEST_F(WeightedRoundRobinTest, WeightsExpireWhenReportsStop) {
+  StartServers(3);
+  servers_[0]->service_.SetCallMetrics(100, 0.1);
+  servers_[1]->service_.SetCallMetrics(100, 0.2);
+  servers_[2]->service_.SetCallMetrics(100, 0.4);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"weighted_round_robin\": {"
+      "\"blackoutPeriod\": \"0s\", \"weightUpdatePeriod\": \"0.1s\", "
+      "\"weightExpirationPeriod\": \"1s\"}}]}");
+  WaitForWeightedDistribution(stub, {4, 2, 1}, DEBUG_LOCATION);
+  // Once the servers stop reporting, their weights expire and traffic
+  // becomes uniform again.
+  for (size_t i = 0; i < servers_.size(); ++i) {
+    servers_[i]->service_.SetCallMetrics(0, 0);
+  }
+  WaitForWeightedDistribution(stub, {1, 1, 1}, DEBUG_LOCATION);
+  // When reports resume, the weights are used again.
+  servers_[0]->service_.SetCallMetrics(100, 0.4);
+  servers_[1]->service_.SetCallMetrics(100, 0.2);
+  servers_[2]->service_.SetCallMetrics(100, 0.1);
+  WaitForWeightedDistribution(stub, {1, 2, 4}, DEBUG_LOCATION);
+}
+
+//
+// tests least_request LB policy
+//
+
+using LeastRequestTest = ClientLbEnd2endTest;
+
+TEST_F(LeastRequestTest, Basic) {
+  StartServers(3);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(), "{\"loadBalancingConfig\": [{\"least_request\": {}}]}");
+  // All servers get traffic.
+  WaitForServers(stub, 0, servers_.size(), DEBUG_LOCATION);
+  EXPECT_EQ("least_request", channel->GetLoadBalancingPolicyName());
+}
+
+TEST_F(LeastRequestTest, AvoidsBusyBackend) {
+  StartServers(2);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  // With 10 choices, a pick lands on the busy backend only if all 10
+  // samples hit it, which happens for about 0.1% of picks.
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"least_request\": {\"choiceCount\": 10}}]}");
+  WaitForServers(stub, 0, servers_.size(), DEBUG_LOCATION);
+  ResetCounters();
+  // Keep one slow RPC in flight.
+  std::thread slow_rpc([&]() {
+    EchoRequest request;
+    request.mutable_param()->set_server_sleep_us(
+        3 * 1000 * 1000 * grpc_test_slowdown_factor());
+    Status status;
+    SendRpc(stub, nullptr, 10000 * grpc_test_slowdown_factor(), &status,
+            /*wait_for_ready=*/false, &request);
+    EXPECT_TRUE(status.ok()) << status.error_message();
+  });
+  size_t busy_index = 0;
+  while (true) {
+    if (servers_[0]->service_.request_count() > 0) break;
+    if (servers_[1]->service_.request_count() > 0) {
+      busy_index = 1;
+      break;
+    }
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+  }
+  // Fast RPCs go to the idle backend.
+  for (size_t i = 0; i < 20; ++i) CheckRpcSendOk(stub, DEBUG_LOCATION);
+  EXPECT_LE(servers_[busy_index]->service_.request_count(), 2);
+  EXPECT_GE(servers_[1 - busy_index]->service_.request_count(), 19);
+  slow_rpc.join();
+}
+
+//
+// tests outlier_detection LB policy
+//
+
+using OutlierDetectionTest = ClientLbEnd2endTest;
+
+TEST_F(OutlierDetectionTest, LatencyEjectionEjectsSlowBackend) {
+  StartServers(3);
+  servers_[0]->service_.SetResponseDelay(absl::Milliseconds(100));
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  // The slow backend's median is more than one standard deviation above
+  // the mean of the three medians, and the fast ones are below it.
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"outlier_detection_experimental\": {\n"
+      "  \"interval\": \"1s\",\n"
+      "  \"maxEjectionPercent\": 50,\n"
+      "  \"latencyEjection\": {\n"
+      "    \"percentile\": 50,\n"
+      "    \"stdevFactor\": 1000,\n"
+      "    \"enforcementPercentage\": 100,\n"
+      "    \"minimumHosts\": 3,\n"
+      "    \"requestVolume\": 5\n"
+      "  },\n"
+      "  \"childPolicy\": [{\"round_robin\": {}}]\n"
+      "}}]}");
+  WaitForServers(stub, 0, servers_.size(), DEBUG_LOCATION);
+  // Keep sending RPCs until the slow backend stops getting any.
+  const absl::Time deadline =
+      absl::Now() + absl::Seconds(30) * grpc_test_slowdown_factor();
+  while (true) {
+    ResetCounters();
+    for (int i = 0; i < 30; ++i) CheckRpcSendOk(stub, DEBUG_LOCATION);
+    gpr_log(GPR_INFO, "slow backend got %d of 30 RPCs",
+            servers_[0]->service_.request_count());
+    if (servers_[0]->service_.request_count() == 0) break;
+    ASSERT_LT(absl::Now(), deadline)
+        << "timed out waiting for the slow backend to be ejected";
+  }
+  // The fast backends share the traffic.
+  EXPECT_EQ(servers_[1]->service_.request_count(), 15);
+  EXPECT_EQ(servers_[2]->service_.request_count(), 15);
+}
+
+//
+// tests multiple connections per subchannel
+//
+
+class SubchannelConnectionPoolTest : public ClientLbEnd2endTest {
+ protected:
+  static constexpr int kRpcSleepMs = 500;
+
+  // Sends \a num_rpcs RPCs at once, each taking kRpcSleepMs on the server,
+  // and returns how long it took for all of them to finish.
+  absl::Duration SendConcurrentSlowRpcs(
+      const std::unique_ptr<grpc::testing::EchoTestService::Stub>& stub,
+      int num_rpcs) {
+    const absl::Time start = absl::Now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_rpcs; ++i) {
+      threads.emplace_back([&]() {
+        EchoRequest request;
+        request.mutable_param()->set_server_sleep_us(
+            kRpcSleepMs * 1000 * grpc_test_slowdown_factor());
+        Status status;
+        SendRpc(stub, nullptr, 30000 * grpc_test_slowdown_factor(), &status,
+                /*wait_for_ready=*/false, &request);
+        EXPECT_TRUE(status.ok()) << status.error_message();
+      });
+    }
+    for (std::thread& thread : threads) thread.join();
+    return absl::Now() - start;
+  }
+
+  size_t NumClientConnections() {
+    return servers_[0]->service_.clients().size();
+  }
+};
+
+TEST_F(SubchannelConnectionPoolTest, ThroughputScalesWithConnections) {
+  constexpr int kMaxConnections = 4;
+  CreateServers(1);
+  servers_[0]->max_concurrent_streams_ = 1;
+  StartServer(0);
+  // With a single connection, the server runs the RPCs one at a time.
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  const absl::Duration single_connection_time =
+      SendConcurrentSlowRpcs(stub, kMaxConnections);
+  EXPECT_GE(single_connection_time,
+            absl::Milliseconds(kMaxConnections * kRpcSleepMs *
+                               grpc_test_slowdown_factor()));
+  EXPECT_EQ(NumClientConnections(), 1);
+  // Each round of RPCs that finds every connection of the pool at its
+  // stream limit opens one more connection, up to the limit.
+  auto pool_response_generator = BuildResolverResponseGenerator();
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL, kMaxConnections);
+  auto pool_channel = BuildChannel("", pool_response_generator, args);
+  auto pool_stub = BuildStub(pool_channel);
+  pool_response_generator.SetNextResolution(GetServersPorts());
+  for (int i = 0;
+       i < 2 * kMaxConnections && NumClientConnections() < 1 + kMaxConnections;
+       ++i) {
+    SendConcurrentSlowRpcs(pool_stub, kMaxConnections);
+  }
+  ASSERT_EQ(NumClientConnections(), 1 + kMaxConnections);
+  // Now the RPCs run side by side.
+  const absl::Duration pool_time =
+      SendConcurrentSlowRpcs(pool_stub, kMaxConnections);
+  gpr_log(GPR_INFO, "single connection: %s, pool: %s",
+          absl::FormatDuration(single_connection_time).c_str(),
+          absl::FormatDuration(pool_time).c_str());
+  EXPECT_LT(pool_time, single_connection_time / 2);
+  // No connections beyond the limit.
+  SendConcurrentSlowRpcs(pool_stub, 2 * kMaxConnections);
+  EXPECT_EQ(NumClientConnections(), 1 + kMaxConnections);
+}
+
+TEST_F(SubchannelConnectionPoolTest, ClosesIdleExtraConnections) {
+  CreateServers(1);
+  servers_[0]->max_concurrent_streams_ = 1;
+  StartServer(0);
+  auto response_generator = BuildResolverResponseGenerator();
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL, 2);
+  args.SetInt(GRPC_ARG_EXTRA_CONNECTION_IDLE_TIMEOUT_MS,
+              200 * grpc_test_slowdown_factor());
+  auto channel = BuildChannel("", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  for (int i = 0; i < 5 && NumClientConnections() < 2; ++i) {
+    SendConcurrentSlowRpcs(stub, 2);
+  }
+  ASSERT_EQ(NumClientConnections(), 2);
+  // Sequential RPCs stay on the first connection, so the second one goes
+  // idle and is closed.
+  for (int i = 0; i < 10; ++i) CheckRpcSendOk(stub, DEBUG_LOCATION);
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(
+      1000 * grpc_test_slowdown_factor()));
+  // Saturating the first connection again then needs a new connection,
+  // which comes from a new client port.
+  for (int i = 0; i < 5 && NumClientConnections() < 3; ++i) {
+    SendConcurrentSlowRpcs(stub, 2);
+  }
+  EXPECT_EQ(NumClientConnections(), 3);
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc
@@ -2626,6 +3194,8 @@ TEST_F(OobBackendMetricTest, Basic) {
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   grpc::testing::TestEnvironment env(&argc, argv);
+  // Registers the outlier_detection policy, which is read at init.
+  gpr_setenv("GRPC_EXPERIMENTAL_ENABLE_OUTLIER_DETECTION", "true");
   grpc_init();
   grpc::testing::ConnectionAttemptInjector::Init();
   const auto result = RUN_ALL_TESTS();
@@ -0,0 +1,230 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/impl/codegen/sync.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+
+#include "src/core/ext/filters/client_channel/backup_poller.h"
+#include "src/core/ext/filters/client_channel/resolver/fake/fake_resolver.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/service_config/service_config_impl.h"
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/resolve_localhost_ip46.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/end2end/test_service_impl.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+constexpr int kSlowBackendDelayMs = 200;
+constexpr int kNumRpcs = 50;
+
+const char kHedgingServiceConfig[] =
+    "{\n"
+    "  \"loadBalancingConfig\": [ { \"round_robin\": {} } ],\n"
+    "  \"methodConfig\": [ {\n"
+    "    \"name\": [ { \"service\": \"grpc.testing.EchoTestService\" } ],\n"
+    "    \"hedgingPolicy\": {\n"
+    "      \"maxAttempts\": 2,\n"
+    "      \"hedgingDelay\": \"0.02s\"\n"
+    "    }\n"
+    "  } ]\n"
+    "}";
+
+// Echo service that delays every response by a fixed amount.
+class DelayedEchoServiceImpl : public TestServiceImpl {
+ public:
+  explicit DelayedEchoServiceImpl(int delay_ms) : delay_ms_(delay_ms) {}
+
+  Status Echo(ServerContext* context, const EchoRequest* request,
+              EchoResponse* response) override {
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      ++request_count_;
+    }
+    if (delay_ms_ > 0) {
+      gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(delay_ms_));
+    }
+    return TestServiceImpl::Echo(context, request, response);
+  }
+
+  int request_count() {
+    grpc::internal::MutexLock lock(&mu_);
+    return request_count_;
+  }
+
+ private:
+  const int delay_ms_;
+  grpc::internal::Mutex mu_;
+  int request_count_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+class HedgingEnd2endTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    GPR_GLOBAL_CONFIG_SET(grpc_client_channel_backup_poll_interval_ms, 1);
+  }
+
+  void SetUp() override {
+    grpc_init();
+    bool localhost_resolves_to_ipv4 = false;
+    bool localhost_resolves_to_ipv6 = false;
+    grpc_core::LocalhostResolves(&localhost_resolves_to_ipv4,
+                                 &localhost_resolves_to_ipv6);
+    ipv6_only_ = !localhost_resolves_to_ipv4 && localhost_resolves_to_ipv6;
+    // Backend 0 is slow, backend 1 responds right away.
+    servers_.emplace_back(absl::make_unique<ServerData>(kSlowBackendDelayMs));
+    servers_.emplace_back(absl::make_unique<ServerData>(0));
+  }
+
+  void TearDown() override {
+    for (auto& server : servers_) server->server_->Shutdown();
+    servers_.clear();
+    response_generator_.reset();
+    grpc_shutdown();
+  }
+
+  // Sets the resolution for the next channel.  The service config is
+  // parsed with hedging enabled only if \a enable_hedging is true.
+  void SetNextResolution(bool enable_hedging) {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_core::Resolver::Result result;
+    result.addresses = grpc_core::ServerAddressList();
+    for (const auto& server : servers_) {
+      absl::StatusOr<grpc_core::URI> uri = grpc_core::URI::Parse(absl::StrCat(
+          ipv6_only_ ? "ipv6:[::1]:" : "ipv4:127.0.0.1:", server->port_));
+      GPR_ASSERT(uri.ok());
+      grpc_resolved_address address;
+      GPR_ASSERT(grpc_parse_uri(*uri, &address));
+      result.addresses->emplace_back(address.addr, address.len, nullptr);
+    }
+    grpc_arg arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING),
+        enable_hedging);
+    grpc_channel_args args = {1, &arg};
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    result.service_config = grpc_core::ServiceConfigImpl::Create(
+        &args, kHedgingServiceConfig, &error);
+    ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+    response_generator_->SetResponse(std::move(result));
+  }
+
+  std::unique_ptr<EchoTestService::Stub> BuildStub(bool enable_hedging) {
+    // Each channel gets its own fake resolver.
+    response_generator_ =
+        grpc_core::MakeRefCounted<grpc_core::FakeResolverResponseGenerator>();
+    SetNextResolution(enable_hedging);
+    ChannelArguments args;
+    args.SetPointer(GRPC_ARG_FAKE_RESOLVER_RESPONSE_GENERATOR,
+                    response_generator_.get());
+    args.SetInt(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING, enable_hedging);
+    return EchoTestService::NewStub(
+        grpc::CreateCustomChannel("fake:///", InsecureChannelCredentials(),
+                                  args));
+  }
+
+  // Sends kNumRpcs sequential RPCs and returns their p99 latency.
+  grpc_core::Duration SendRpcsAndGetP99(EchoTestService::Stub* stub) {
+    std::vector<grpc_core::Duration> latencies;
+    for (int i = 0; i < kNumRpcs; ++i) {
+      EchoRequest request;
+      request.set_message("hedge me");
+      EchoResponse response;
+      ClientContext context;
+      context.set_deadline(grpc_timeout_seconds_to_deadline(5));
+      context.set_wait_for_ready(true);
+      const gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+      Status status = stub->Echo(&context, request, &response);
+      latencies.push_back(grpc_core::Duration::FromTimespec(
+          gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start)));
+      EXPECT_TRUE(status.ok()) << status.error_code() << ": "
+                               << status.error_message();
+    }
+    std::sort(latencies.begin(), latencies.end());
+    return latencies[latencies.size() * 99 / 100];
+  }
+
+  struct ServerData {
+    const int port_;
+    DelayedEchoServiceImpl service_;
+    std::unique_ptr<Server> server_;
+
+    explicit ServerData(int delay_ms)
+        : port_(grpc_pick_unused_port_or_die()), service_(delay_ms) {
+      ServerBuilder builder;
+      builder.AddListeningPort(absl::StrCat("localhost:", port_),
+                               InsecureServerCredentials());
+      builder.RegisterService(&service_);
+      server_ = builder.BuildAndStart();
+    }
+  };
+
+  bool ipv6_only_ = false;
+  std::vector<std::unique_ptr<ServerData>> servers_;
+  grpc_core::RefCountedPtr<grpc_core::FakeResolverResponseGenerator>
+      response_generator_;
+};
+
+TEST_F(HedgingEnd2endTest, HedgingReducesTailLatency) {
+  // Without hedging, half of the RPCs go to the slow backend.
+  auto stub = BuildStub(/*enable_hedging=*/false);
+  grpc_core::Duration p99 = SendRpcsAndGetP99(stub.get());
+  gpr_log(GPR_INFO, "p99 without hedging: %s", p99.ToString().c_str());
+  EXPECT_GE(p99, grpc_core::Duration::Milliseconds(kSlowBackendDelayMs));
+  // With hedging, an RPC stuck on the slow backend gets a second attempt
+  // on the fast backend after the hedging delay.
+  stub = BuildStub(/*enable_hedging=*/true);
+  p99 = SendRpcsAndGetP99(stub.get());
+  gpr_log(GPR_INFO, "p99 with hedging: %s", p99.ToString().c_str());
+  EXPECT_LT(p99, grpc_core::Duration::Milliseconds(kSlowBackendDelayMs));
+  // The fast backend saw half of the RPCs without hedging and all of
+  // them with hedging.
+  EXPECT_GE(servers_[1]->service_.request_count(), kNumRpcs);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  return RUN_ALL_TESTS();
+}
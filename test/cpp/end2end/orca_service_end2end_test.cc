@@ -14,6 +14,8 @@
 // limitations under the License.
 //
 
+#include <limits>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -190,6 +192,46 @@ TEST_F(OrcaServiceEnd2endTest, Basic) {
   });
 }
 
+TEST_F(OrcaServiceEnd2endTest, IgnoresInvalidValues) {
+  constexpr char kMetricName1[] = "foo";
+  constexpr char kMetricName2[] = "bar";
+  const double kNaN = std::numeric_limits<double>::quiet_NaN();
+  Stream stream(stub_.get(), grpc_core::Duration::Milliseconds(1000));
+  // Skip the initial response, which may race with the values set below.
+  stream.ReadResponse();
+  orca_service_.SetCpuUtilization(0.5);
+  orca_service_.SetMemoryUtilization(0.4);
+  orca_service_.SetQps(100);
+  orca_service_.SetNamedUtilization(kMetricName1, 0.3);
+  OrcaLoadReport response = stream.ReadResponse();
+  EXPECT_EQ(response.cpu_utilization(), 0.5);
+  EXPECT_EQ(response.mem_utilization(), 0.4);
+  EXPECT_EQ(response.rps(), 100);
+  EXPECT_THAT(response.utilization(), ::testing::UnorderedElementsAre(
+                                          ::testing::Pair(kMetricName1, 0.3)));
+  // Negative and NaN values, and qps too large for a uint64, leave the
+  // previous values in place.
+  orca_service_.SetCpuUtilization(-0.5);
+  orca_service_.SetMemoryUtilization(kNaN);
+  orca_service_.SetQps(-2);
+  orca_service_.SetQps(kNaN);
+  orca_service_.SetQps(1e20);
+  orca_service_.SetNamedUtilization(kMetricName1, -1);
+  orca_service_.SetNamedUtilization(kMetricName2, kNaN);
+  response = stream.ReadResponse();
+  EXPECT_EQ(response.cpu_utilization(), 0.5);
+  EXPECT_EQ(response.mem_utilization(), 0.4);
+  EXPECT_EQ(response.rps(), 100);
+  EXPECT_THAT(response.utilization(), ::testing::UnorderedElementsAre(
+                                          ::testing::Pair(kMetricName1, 0.3)));
+  // Invalid entries are dropped from a whole map.
+  orca_service_.SetAllNamedUtilization(
+      {{kMetricName1, 0.6}, {kMetricName2, kNaN}});
+  response = stream.ReadResponse();
+  EXPECT_THAT(response.utilization(), ::testing::UnorderedElementsAre(
+                                          ::testing::Pair(kMetricName1, 0.6)));
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc
@@ -1112,6 +1112,83 @@ TEST_F(RlsEnd2endTest, StaleCacheEntryWithHeaderData) {
   EXPECT_EQ(rls_server_->service_.response_count(), 2);
 }
 
+TEST_F(RlsEnd2endTest, CacheEntryRefreshedBeforeStaleAge) {
+  const grpc_core::Duration kStaleAge = grpc_core::Duration::Seconds(10);
+  const grpc_core::Duration kRlsResponseDelay =
+      grpc_core::Duration::Seconds(2) * grpc_test_slowdown_factor();
+  StartBackends(1);
+  SetNextResolution(
+      MakeServiceConfigBuilder()
+          .AddKeyBuilder(absl::StrFormat("\"names\":[{"
+                                         "  \"service\":\"%s\","
+                                         "  \"method\":\"%s\""
+                                         "}],"
+                                         "\"headers\":["
+                                         "  {"
+                                         "    \"key\":\"%s\","
+                                         "    \"names\":["
+                                         "      \"key1\""
+                                         "    ]"
+                                         "  }"
+                                         "]",
+                                         kServiceValue, kMethodValue, kTestKey))
+          .set_max_age(grpc_core::Duration::Seconds(20))
+          .set_stale_age(kStaleAge)
+          .Build());
+  rls_server_->service_.SetResponse(
+      BuildRlsRequest({{kTestKey, kTestValue}}),
+      BuildRlsResponse({TargetStringForPort(backends_[0]->port_)}));
+  // Send one RPC.  RLS server gets a request, and RPC goes to backend.
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", kTestValue}}));
+  // The entry was filled before this, so it goes stale before stale_time.
+  const gpr_timespec stale_time =
+      grpc_timeout_milliseconds_to_deadline(kStaleAge.millis());
+  EXPECT_EQ(rls_server_->service_.request_count(), 1);
+  EXPECT_EQ(rls_server_->service_.response_count(), 1);
+  // Update RLS server to expect a stale request, and to answer it slowly.
+  rls_server_->service_.RemoveResponse(
+      BuildRlsRequest({{kTestKey, kTestValue}}));
+  rls_server_->service_.SetResponse(
+      BuildRlsRequest({{kTestKey, kTestValue}},
+                      RouteLookupRequest::REASON_STALE),
+      BuildRlsResponse({TargetStringForPort(backends_[0]->port_)}),
+      kRlsResponseDelay);
+  // Wait until 95% of the stale age has passed, which is after the entry
+  // should be refreshed but before it is stale.
+  gpr_sleep_until(
+      grpc_timeout_milliseconds_to_deadline((kStaleAge * 0.95).millis()));
+  // This RPC should use the cached data and start the refresh.
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", kTestValue}}));
+  // While the refresh is in flight, RPCs are not queued behind it.
+  for (size_t i = 0; i < 5; ++i) {
+    const gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+    CheckRpcSendOk(DEBUG_LOCATION,
+                   RpcOptions().set_metadata({{"key1", kTestValue}}));
+    EXPECT_LT(gpr_time_cmp(gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start),
+                           gpr_time_from_millis(kRlsResponseDelay.millis() / 2,
+                                                GPR_TIMESPAN)),
+              0)
+        << "RPC " << i << " waited for the RLS request";
+  }
+  EXPECT_EQ(backends_[0]->service_.request_count(), 7);
+  // The RLS server gets the stale request before the entry goes stale.
+  while (rls_server_->service_.request_count() < 2 &&
+         gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), stale_time) < 0) {
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+  }
+  EXPECT_EQ(rls_server_->service_.request_count(), 2);
+  EXPECT_LT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), stale_time), 0);
+  EXPECT_THAT(rls_server_->service_.GetUnmatchedRequests(),
+              ::testing::IsEmpty());
+  // Wait for the RLS server to answer it.
+  gpr_sleep_until(gpr_time_add(
+      gpr_now(GPR_CLOCK_MONOTONIC),
+      gpr_time_from_millis((kRlsResponseDelay * 2).millis(), GPR_TIMESPAN)));
+  EXPECT_EQ(rls_server_->service_.response_count(), 2);
+}
+
 TEST_F(RlsEnd2endTest, ExpiredCacheEntry) {
   StartBackends(1);
   SetNextResolution(
@@ -1227,6 +1304,66 @@ TEST_F(RlsEnd2endTest, CacheSizeLimit) {
   EXPECT_EQ(backends_[1]->service_.request_count(), 2);
 }
 
+TEST_F(RlsEnd2endTest, CacheSizeLimitAcrossShards) {
+  // Enough keys that their entries are spread across the cache's shards.
+  const size_t kNumKeys = 16;
+  StartBackends(1);
+  SetNextResolution(
+      MakeServiceConfigBuilder()
+          .AddKeyBuilder(absl::StrFormat("\"names\":[{"
+                                         "  \"service\":\"%s\","
+                                         "  \"method\":\"%s\""
+                                         "}],"
+                                         "\"headers\":["
+                                         "  {"
+                                         "    \"key\":\"%s\","
+                                         "    \"names\":["
+                                         "      \"key1\""
+                                         "    ]"
+                                         "  }"
+                                         "]",
+                                         kServiceValue, kMethodValue, kTestKey))
+          .set_cache_size_bytes(1)  // Not even big enough for one entry.
+          .Build());
+  std::vector<std::string> values;
+  for (size_t i = 0; i <= kNumKeys; ++i) {
+    values.push_back(absl::StrCat("test_value_", i));
+    rls_server_->service_.SetResponse(
+        BuildRlsRequest({{kTestKey, values.back()}}),
+        BuildRlsResponse({TargetStringForPort(backends_[0]->port_)}));
+  }
+  // Send an RPC for each of the first kNumKeys values.  Each gets its own
+  // RLS request.
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    CheckRpcSendOk(DEBUG_LOCATION,
+                   RpcOptions().set_metadata({{"key1", values[i]}}));
+  }
+  EXPECT_EQ(rls_server_->service_.request_count(), kNumKeys);
+  // The entries are held by min_eviction_time, so the cache stays over its
+  // size limit and they are all still used.
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    CheckRpcSendOk(DEBUG_LOCATION,
+                   RpcOptions().set_metadata({{"key1", values[i]}}));
+  }
+  EXPECT_EQ(rls_server_->service_.request_count(), kNumKeys);
+  // Wait for min_eviction_time to elapse.
+  gpr_sleep_until(grpc_timeout_seconds_to_deadline(6));
+  // Adding an entry for the last value evicts the entries in every shard.
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", values[kNumKeys]}}));
+  EXPECT_EQ(rls_server_->service_.request_count(), kNumKeys + 1);
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    CheckRpcSendOk(DEBUG_LOCATION,
+                   RpcOptions().set_metadata({{"key1", values[i]}}));
+  }
+  EXPECT_EQ(rls_server_->service_.request_count(), 2 * kNumKeys + 1);
+  // The entry for the last value is still held by min_eviction_time.
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", values[kNumKeys]}}));
+  EXPECT_EQ(rls_server_->service_.request_count(), 2 * kNumKeys + 1);
+  EXPECT_EQ(rls_server_->service_.response_count(), 2 * kNumKeys + 1);
+}
+
 TEST_F(RlsEnd2endTest, MultipleTargets) {
   StartBackends(1);
   SetNextResolution(
@@ -65,6 +65,27 @@ TEST_P(XdsClientTest, ResourceWrappedInResourceMessage) {
             channel_->GetLoadBalancingPolicyName());
 }
 
+// Tests that the client keeps accepting updates after the server resends
+// resources that it already has, which it does not decode again.
+TEST_P(XdsClientTest, UpdateAfterUnchangedResourceIsResent) {
+  CreateAndStartBackends(2);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends(0, 1)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION, 0, 1);
+  // Resend the same CDS and EDS resources in a new version.
+  balancer_->ads_service()->SetCdsResource(default_cluster_);
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  CheckRpcSendOk(DEBUG_LOCATION, 10);
+  // The client should ACK the new version.
+  auto response_state = balancer_->ads_service()->eds_response_state();
+  ASSERT_TRUE(response_state.has_value());
+  EXPECT_EQ(response_state->state, AdsServiceImpl::ResponseState::ACKED);
+  // Now change the EDS resource.
+  args = EdsResourceArgs({{"locality0", CreateEndpointsForBackends(1, 2)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION, 1, 2);
+}
+
 TEST_P(XdsClientTest, ResourceTypeVersionPersistsAcrossStreamRestarts) {
   CreateAndStartBackends(2);
   EdsResourceArgs args({{"locality0", CreateEndpointsForBackends(0, 1)}});
@@ -217,6 +238,161 @@ TEST_P(XdsClientTest, XdsStreamErrorPropagation) {
               ::testing::HasSubstr("(node ID:xds_end2end_test)"));
 }
 
+//
+// DeltaXdsTest - tests for the incremental variant of the ADS protocol
+//
+
+using DeltaXdsTest = XdsEnd2endTest;
+
+INSTANTIATE_TEST_SUITE_P(XdsTest, DeltaXdsTest,
+                         ::testing::Values(XdsTestType().set_use_delta_xds()),
+                         &XdsTestType::Name);
+
+TEST_P(DeltaXdsTest, Basic) {
+  CreateAndStartBackends(2);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends(0, 1)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION, 0, 1);
+  EXPECT_TRUE(balancer_->ads_service()->seen_delta_client());
+  // An update to one resource reaches the client.
+  args = EdsResourceArgs({{"locality0", CreateEndpointsForBackends(1, 2)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION, 1, 2);
+  auto response_state = balancer_->ads_service()->eds_response_state();
+  ASSERT_TRUE(response_state.has_value());
+  EXPECT_EQ(response_state->state, AdsServiceImpl::ResponseState::ACKED);
+}
+
+// Tests that a resource in removed_resources is treated as deleted.
+TEST_P(DeltaXdsTest, RemovedResource) {
+  CreateAndStartBackends(1);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends()}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION);
+  // Unset CDS resource.
+  balancer_->ads_service()->UnsetResource(kCdsTypeUrl, kDefaultClusterName);
+  // Wait for RPCs to start failing.
+  do {
+  } while (SendRpc(RpcOptions(), nullptr).ok());
+  // Make sure RPCs are still failing.
+  CheckRpcSendFailure(DEBUG_LOCATION,
+                      CheckRpcSendFailureOptions().set_times(100));
+}
+
+// Tests that the client resubscribes, sending the versions it has, when
+// the ADS stream is restarted.
+TEST_P(DeltaXdsTest, ResubscribesUponReconnection) {
+  CreateAndStartBackends(2);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends(0, 1)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION, 0, 1);
+  // Send the same endpoints again at a new version, and wait for the
+  // client to ACK both responses.
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  size_t num_acks = 0;
+  const absl::Time deadline = absl::Now() + absl::Seconds(30);
+  while (num_acks < 2 && absl::Now() < deadline) {
+    CheckRpcSendOk(DEBUG_LOCATION);
+    while (auto response_state =
+               balancer_->ads_service()->eds_response_state()) {
+      EXPECT_EQ(response_state->state, AdsServiceImpl::ResponseState::ACKED);
+      ++num_acks;
+    }
+  }
+  ASSERT_EQ(num_acks, 2);
+  balancer_->Shutdown();
+  balancer_->Start();
+  // Make sure things are still working.
+  CheckRpcSendOk(DEBUG_LOCATION, 100);
+  // The client resubscribed with the latest version of each resource,
+  // even though the last EDS response did not change the endpoints.
+  EXPECT_THAT(
+      balancer_->ads_service()->delta_initial_resource_versions(kCdsTypeUrl),
+      ::testing::ElementsAre(::testing::Pair(kDefaultClusterName, "1")));
+  EXPECT_THAT(
+      balancer_->ads_service()->delta_initial_resource_versions(kEdsTypeUrl),
+      ::testing::ElementsAre(::testing::Pair(kDefaultEdsServiceName, "2")));
+  // Make sure updates still reach the client.
+  args = EdsResourceArgs({{"locality0", CreateEndpointsForBackends(1, 2)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION, 1, 2);
+}
+
+// Tests that an invalid resource is NACKed, and that a valid one sent
+// afterwards is accepted.
+TEST_P(DeltaXdsTest, NacksInvalidResource) {
+  CreateAndStartBackends(1);
+  EdsResourceArgs args({
+      {"locality0", {MakeNonExistantEndpoint()}, kDefaultLocalityWeight, 1},
+  });
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  const auto response_state = WaitForEdsNack(DEBUG_LOCATION);
+  ASSERT_TRUE(response_state.has_value()) << "timed out waiting for NACK";
+  EXPECT_THAT(response_state->error_message,
+              ::testing::HasSubstr("sparse priority list"));
+  args = EdsResourceArgs({{"locality0", CreateEndpointsForBackends()}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION);
+  absl::optional<AdsServiceImpl::ResponseState> last_response_state;
+  while (auto state = balancer_->ads_service()->eds_response_state()) {
+    last_response_state = std::move(state);
+  }
+  ASSERT_TRUE(last_response_state.has_value());
+  EXPECT_EQ(last_response_state->state, AdsServiceImpl::ResponseState::ACKED);
+}
+
+// Tests that the client unsubscribes from resources it no longer uses,
+// after which their removal does not affect it.
+TEST_P(DeltaXdsTest, UnsubscribesFromUnusedResources) {
+  CreateAndStartBackends(2);
+  const char* kNewClusterName = "new_cluster_name";
+  const char* kNewEdsServiceName = "new_eds_service_name";
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends(0, 1)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION, 0, 1);
+  // Populate new CDS and EDS resources.
+  args = EdsResourceArgs({{"locality0", CreateEndpointsForBackends(1, 2)}});
+  balancer_->ads_service()->SetEdsResource(
+      BuildEdsResource(args, kNewEdsServiceName));
+  Cluster new_cluster = default_cluster_;
+  new_cluster.set_name(kNewClusterName);
+  new_cluster.mutable_eds_cluster_config()->set_service_name(
+      kNewEdsServiceName);
+  balancer_->ads_service()->SetCdsResource(new_cluster);
+  // Change RDS resource to point to new cluster.
+  RouteConfiguration new_route_config = default_route_config_;
+  new_route_config.mutable_virtual_hosts(0)
+      ->mutable_routes(0)
+      ->mutable_route()
+      ->set_cluster(kNewClusterName);
+  SetRouteConfiguration(balancer_.get(), new_route_config);
+  WaitForAllBackends(DEBUG_LOCATION, 1, 2);
+  // Wait for the client to unsubscribe from the old resources.
+  auto unsubscribed = [&]() {
+    return balancer_->ads_service()
+                   ->delta_unsubscribed_names(kCdsTypeUrl)
+                   .count(kDefaultClusterName) > 0 &&
+           balancer_->ads_service()
+                   ->delta_unsubscribed_names(kEdsTypeUrl)
+                   .count(kDefaultEdsServiceName) > 0;
+  };
+  const absl::Time deadline = absl::Now() + absl::Seconds(30);
+  while (!unsubscribed() && absl::Now() < deadline) {
+    CheckRpcSendOk(DEBUG_LOCATION);
+  }
+  EXPECT_THAT(balancer_->ads_service()->delta_unsubscribed_names(kCdsTypeUrl),
+              ::testing::ElementsAre(kDefaultClusterName));
+  EXPECT_THAT(balancer_->ads_service()->delta_unsubscribed_names(kEdsTypeUrl),
+              ::testing::ElementsAre(kDefaultEdsServiceName));
+  // Removing the old resources is not sent to the client, which keeps
+  // using the new ones.
+  balancer_->ads_service()->UnsetResource(kCdsTypeUrl, kDefaultClusterName);
+  balancer_->ads_service()->UnsetResource(kEdsTypeUrl,
+                                          kDefaultEdsServiceName);
+  CheckRpcSendOk(DEBUG_LOCATION, 100);
+  EXPECT_EQ(0, backends_[0]->backend_service()->request_count());
+}
+
 //
 // GlobalXdsClientTest - tests that need to run with a global XdsClient
 // (this is the default in production)
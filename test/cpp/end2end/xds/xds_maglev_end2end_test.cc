@@ -0,0 +1,202 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/ext/filters/client_channel/backup_poller.h"
+#include "src/core/lib/gpr/env.h"
+#include "src/proto/grpc/testing/xds/v3/cluster.grpc.pb.h"
+#include "test/cpp/end2end/xds/xds_end2end_test_lib.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+class MaglevTest : public XdsEnd2endTest {
+ protected:
+  MaglevTest() : env_var_("GRPC_EXPERIMENTAL_XDS_MAGLEV_LB") {}
+
+  void SetUp() override {
+    InitClient();
+    ResetStub();
+  }
+
+  // Sets a MAGLEV cluster, with the given table size if non-zero, and a
+  // route that hashes on the "address_hash" header.
+  void SetMaglevClusterAndRoute(uint64_t table_size = 0) {
+    auto cluster = default_cluster_;
+    cluster.set_lb_policy(Cluster::MAGLEV);
+    if (table_size != 0) {
+      cluster.mutable_maglev_lb_config()->mutable_table_size()->set_value(
+          table_size);
+    }
+    balancer_->ads_service()->SetCdsResource(cluster);
+    auto new_route_config = default_route_config_;
+    auto* route = new_route_config.mutable_virtual_hosts(0)->mutable_routes(0);
+    auto* hash_policy = route->mutable_route()->add_hash_policy();
+    hash_policy->mutable_header()->set_header_name("address_hash");
+    SetListenerAndRouteConfiguration(balancer_.get(), default_listener_,
+                                     new_route_config);
+  }
+
+  static RpcOptions RpcOptionsWithHash(const std::string& value) {
+    return RpcOptions().set_metadata({{"address_hash", value}});
+  }
+
+  ScopedExperimentalEnvVar env_var_;
+};
+
+// Run both with and without load reporting, just for test coverage.
+INSTANTIATE_TEST_SUITE_P(
+    XdsTest, MaglevTest,
+    ::testing::Values(XdsTestType(), XdsTestType().set_enable_load_reporting()),
+    &XdsTestType::Name);
+
+// Tests that RPCs with the same header value always go to the same backend,
+// and that different header values are spread across all the backends.
+TEST_P(MaglevTest, HeaderHashing) {
+  CreateAndStartBackends(4);
+  SetMaglevClusterAndRoute();
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends()}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  // Unlike with ring hash, we cannot pick a header value that hashes to a
+  // given backend, so we use many of them until all the backends are used.
+  std::set<size_t> backends_used;
+  for (size_t i = 0; backends_used.size() < backends_.size(); ++i) {
+    ASSERT_LT(i, 1000) << "not all backends are used";
+    ResetBackendCounters();
+    CheckRpcSendOk(DEBUG_LOCATION, 10,
+                   RpcOptionsWithHash(absl::StrCat("value_", i)));
+    size_t num_backends_used = 0;
+    for (size_t j = 0; j < backends_.size(); ++j) {
+      const int count = backends_[j]->backend_service()->request_count();
+      if (count == 0) continue;
+      EXPECT_EQ(count, 10) << "value_" << i << ", backend " << j;
+      backends_used.insert(j);
+      ++num_backends_used;
+    }
+    EXPECT_EQ(num_backends_used, 1) << "value_" << i;
+  }
+}
+
+// Tests that a valid table size is accepted.
+TEST_P(MaglevTest, TableSize) {
+  CreateAndStartBackends(2);
+  SetMaglevClusterAndRoute(/*table_size=*/7);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends()}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  CheckRpcSendOk(DEBUG_LOCATION, 10, RpcOptionsWithHash("foo"));
+  auto response_state = balancer_->ads_service()->cds_response_state();
+  ASSERT_TRUE(response_state.has_value());
+  EXPECT_EQ(response_state->state, AdsServiceImpl::ResponseState::ACKED);
+}
+
+// Tests that when the backend a request hashes to is down, the request goes
+// to the next backend in the table.
+TEST_P(MaglevTest, TransientFailureCheckNextOne) {
+  CreateAndStartBackends(1);
+  SetMaglevClusterAndRoute();
+  std::vector<EdsResourceArgs::Endpoint> endpoints;
+  endpoints.emplace_back(grpc_pick_unused_port_or_die());
+  endpoints.emplace_back(backends_[0]->port());
+  EdsResourceArgs args({{"locality0", std::move(endpoints)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  // Some of these values hash to the unreachable endpoint, but all the RPCs
+  // end up on the backend.
+  for (size_t i = 0; i < 20; ++i) {
+    const auto rpc_options = RpcOptionsWithHash(absl::StrCat("value_", i));
+    WaitForBackend(DEBUG_LOCATION, 0, WaitForBackendOptions(), rpc_options);
+    ResetBackendCounters();
+    CheckRpcSendOk(DEBUG_LOCATION, 5, rpc_options);
+    EXPECT_EQ(backends_[0]->backend_service()->request_count(), 5);
+  }
+}
+
+// Tests that RPCs fail once all the backends are down, and go to the
+// backend that comes back up, whatever the request hashes to.  The largest
+// table is used, so that failing picks would walk millions of slots if they
+// did not stop once all the backends have been seen.
+TEST_P(MaglevTest, AllBackendsDownThenOneUp) {
+  CreateAndStartBackends(3);
+  const uint32_t kConnectionTimeoutMilliseconds = 5000;
+  SetMaglevClusterAndRoute(/*table_size=*/5000011);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends()}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  const auto rpc_options = RpcOptionsWithHash("foo");
+  CheckRpcSendOk(DEBUG_LOCATION, 1, rpc_options);
+  ShutdownAllBackends();
+  CheckRpcSendFailure(DEBUG_LOCATION, CheckRpcSendFailureOptions()
+                                          .set_rpc_options(rpc_options)
+                                          .set_times(10));
+  StartBackend(2);
+  EXPECT_TRUE(channel_->WaitForConnected(
+      grpc_timeout_milliseconds_to_deadline(kConnectionTimeoutMilliseconds)));
+  ResetBackendCounters();
+  CheckRpcSendOk(DEBUG_LOCATION, 10, rpc_options);
+  EXPECT_EQ(10, backends_[2]->backend_service()->request_count());
+}
+
+// Tests that we NACK a table size that is not a prime number.
+TEST_P(MaglevTest, TableSizeNotPrime) {
+  CreateAndStartBackends(1);
+  SetMaglevClusterAndRoute(/*table_size=*/65536);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends()}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  const auto response_state = WaitForCdsNack(DEBUG_LOCATION);
+  ASSERT_TRUE(response_state.has_value()) << "timed out waiting for NACK";
+  EXPECT_THAT(response_state->error_message,
+              ::testing::HasSubstr("maglev table_size is not a prime number "
+                                   "no larger than 5000011."));
+}
+
+// Tests that we NACK a prime table size that is too large.
+TEST_P(MaglevTest, TableSizeTooLarge) {
+  CreateAndStartBackends(1);
+  SetMaglevClusterAndRoute(/*table_size=*/5000077);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends()}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  const auto response_state = WaitForCdsNack(DEBUG_LOCATION);
+  ASSERT_TRUE(response_state.has_value()) << "timed out waiting for NACK";
+  EXPECT_THAT(response_state->error_message,
+              ::testing::HasSubstr("maglev table_size is not a prime number "
+                                   "no larger than 5000011."));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  // Make the backup poller poll very frequently in order to pick up
+  // updates from all the subchannels's FDs.
+  GPR_GLOBAL_CONFIG_SET(grpc_client_channel_backup_poll_interval_ms, 1);
+#if TARGET_OS_IPHONE
+  // Workaround Apple CFStream bug
+  gpr_setenv("grpc_cfstream", "0");
+#endif
+  grpc_init();
+  const auto result = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return result;
+}
@@ -25,6 +25,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "absl/strings/numbers.h"
 #include "absl/types/optional.h"
 
 #include <grpc/support/log.h>
@@ -140,6 +141,247 @@ void AdsServiceImpl::ProcessUnsubscriptions(
   }
 }
 
+Status AdsServiceImpl::HandleDeltaStream(ServerContext* context,
+                                         DeltaStream* stream) {
+  using ::envoy::service::discovery::v3::DeltaDiscoveryRequest;
+  using ::envoy::service::discovery::v3::DeltaDiscoveryResponse;
+  gpr_log(GPR_INFO, "ADS[%p]: DeltaAggregatedResources starts", this);
+  {
+    grpc_core::MutexLock lock(&ads_mu_);
+    if (forced_ads_failure_.has_value()) {
+      gpr_log(GPR_INFO,
+              "ADS[%p]: DeltaAggregatedResources forcing early failure "
+              "with status code: %d, message: %s",
+              this, forced_ads_failure_.value().error_code(),
+              forced_ads_failure_.value().error_message().c_str());
+      return forced_ads_failure_.value();
+    }
+  }
+  AddClient(context->peer());
+  seen_v3_client_ = true;
+  seen_delta_client_ = true;
+  // Take a reference of the AdsServiceImpl object, which will go
+  // out of scope when this request handler returns.  This ensures
+  // that the parent won't be destroyed until this stream is complete.
+  std::shared_ptr<AdsServiceImpl> ads_service_impl = shared_from_this();
+  // Resources (type/name pairs) that have changed since the client
+  // subscribed to them.
+  UpdateQueue update_queue;
+  // Resources that the client is subscribed to keyed by resource type url.
+  SubscriptionMap subscription_map;
+  // The versions the client has, and the last nonce sent, for each type.
+  std::map<std::string /* type_url */, ClientVersionMap> client_versions;
+  std::map<std::string /* type_url */, int> nonces;
+  // Spawn a thread to read requests from the stream.
+  std::deque<DeltaDiscoveryRequest> requests;
+  bool stream_closed = false;
+  std::thread reader([this, stream, &requests, &stream_closed]() {
+    DeltaDiscoveryRequest request;
+    bool seen_first_request = false;
+    while (stream->Read(&request)) {
+      if (!seen_first_request) {
+        EXPECT_TRUE(request.has_node());
+        EXPECT_THAT(request.node().client_features(),
+                    ::testing::UnorderedElementsAre(
+                        "envoy.lb.does_not_support_overprovisioning"));
+        seen_first_request = true;
+      }
+      grpc_core::MutexLock lock(&ads_mu_);
+      requests.emplace_back(std::move(request));
+    }
+    gpr_log(GPR_INFO, "ADS[%p]: Null read, delta stream closed", this);
+    grpc_core::MutexLock lock(&ads_mu_);
+    stream_closed = true;
+  });
+  // Main loop to process requests and updates.
+  while (true) {
+    bool did_work = false;
+    absl::optional<DeltaDiscoveryResponse> response;
+    {
+      grpc_core::MutexLock lock(&ads_mu_);
+      if (stream_closed || ads_done_) break;
+      if (!requests.empty()) {
+        DeltaDiscoveryRequest request = std::move(requests.front());
+        requests.pop_front();
+        did_work = true;
+        gpr_log(GPR_INFO,
+                "ADS[%p]: Received delta request for type %s with content %s",
+                this, request.type_url().c_str(),
+                request.DebugString().c_str());
+        ProcessDeltaRequest(request, &update_queue, &subscription_map,
+                            &client_versions, &nonces, &response);
+      }
+    }
+    if (response.has_value()) {
+      gpr_log(GPR_INFO, "ADS[%p]: Sending delta response: %s", this,
+              response->DebugString().c_str());
+      stream->Write(response.value());
+    }
+    response.reset();
+    {
+      grpc_core::MutexLock lock(&ads_mu_);
+      if (!update_queue.empty()) {
+        const std::string type_url = std::move(update_queue.front().first);
+        const std::string resource_name =
+            std::move(update_queue.front().second);
+        update_queue.pop_front();
+        did_work = true;
+        const SubscriptionNameMap& subscription_name_map =
+            subscription_map[type_url];
+        if (subscription_name_map.find(resource_name) !=
+            subscription_name_map.end()) {
+          BuildDeltaResponse(type_url, {resource_name},
+                             &client_versions[type_url], &nonces[type_url],
+                             &response);
+        }
+      }
+    }
+    if (response.has_value()) {
+      gpr_log(GPR_INFO, "ADS[%p]: Sending delta update response: %s", this,
+              response->DebugString().c_str());
+      stream->Write(response.value());
+    }
+    {
+      grpc_core::MutexLock lock(&ads_mu_);
+      if (ads_done_) break;
+    }
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(did_work ? 0 : 10));
+  }
+  reader.join();
+  // Clean up any subscriptions that were still active when the call
+  // finished.
+  {
+    grpc_core::MutexLock lock(&ads_mu_);
+    for (auto& p : subscription_map) {
+      const std::string& type_url = p.first;
+      for (auto& q : p.second) {
+        resource_map_[type_url]
+            .resource_name_map[q.first]
+            .subscriptions.erase(&q.second);
+      }
+    }
+  }
+  gpr_log(GPR_INFO, "ADS[%p]: DeltaAggregatedResources done", this);
+  RemoveClient(context->peer());
+  return Status::OK;
+}
+
+void AdsServiceImpl::ProcessDeltaRequest(
+    const ::envoy::service::discovery::v3::DeltaDiscoveryRequest& request,
+    UpdateQueue* update_queue, SubscriptionMap* subscription_map,
+    std::map<std::string /* type_url */, ClientVersionMap>* client_versions,
+    std::map<std::string /* type_url */, int>* nonces,
+    absl::optional<::envoy::service::discovery::v3::DeltaDiscoveryResponse>*
+        response) {
+  const std::string& type_url = request.type_url();
+  // Check for ACK or NACK.
+  if (!request.response_nonce().empty()) {
+    ResponseState response_state;
+    if (!request.has_error_detail()) {
+      response_state.state = ResponseState::ACKED;
+      gpr_log(GPR_INFO, "ADS[%p]: client ACKed resource_type=%s nonce=%s",
+              this, type_url.c_str(), request.response_nonce().c_str());
+    } else {
+      response_state.state = ResponseState::NACKED;
+      EXPECT_EQ(request.error_detail().code(), GRPC_STATUS_INVALID_ARGUMENT);
+      response_state.error_message = request.error_detail().message();
+      gpr_log(GPR_INFO, "ADS[%p]: client NACKed resource_type=%s nonce=%s: %s",
+              this, type_url.c_str(), request.response_nonce().c_str(),
+              response_state.error_message.c_str());
+    }
+    resource_type_response_state_[type_url].emplace_back(
+        std::move(response_state));
+  }
+  // Ignore resource types as requested by tests.
+  if (resource_types_to_ignore_.find(type_url) !=
+      resource_types_to_ignore_.end()) {
+    return;
+  }
+  auto& subscription_name_map = (*subscription_map)[type_url];
+  auto& resource_name_map = resource_map_[type_url].resource_name_map;
+  ClientVersionMap& type_client_versions = (*client_versions)[type_url];
+  if (!request.initial_resource_versions().empty()) {
+    delta_initial_resource_versions_[type_url] = {
+        request.initial_resource_versions().begin(),
+        request.initial_resource_versions().end()};
+  }
+  for (const auto& p : request.initial_resource_versions()) {
+    int version;
+    if (absl::SimpleAtoi(p.second, &version)) {
+      type_client_versions[p.first] = version;
+    }
+  }
+  std::set<std::string> resources_to_send;
+  for (const std::string& resource_name : request.resource_names_subscribe()) {
+    if (MaybeSubscribe(type_url, resource_name,
+                       &subscription_name_map[resource_name],
+                       &resource_name_map[resource_name], update_queue)) {
+      resources_to_send.insert(resource_name);
+    }
+  }
+  for (const std::string& resource_name :
+       request.resource_names_unsubscribe()) {
+    delta_unsubscribed_names_[type_url].insert(resource_name);
+    auto it = subscription_name_map.find(resource_name);
+    if (it == subscription_name_map.end()) continue;
+    gpr_log(GPR_INFO, "ADS[%p]: Unsubscribe to type=%s name=%s", this,
+            type_url.c_str(), resource_name.c_str());
+    auto resource_it = resource_name_map.find(resource_name);
+    GPR_ASSERT(resource_it != resource_name_map.end());
+    resource_it->second.subscriptions.erase(&it->second);
+    if (resource_it->second.subscriptions.empty() &&
+        !resource_it->second.resource.has_value()) {
+      resource_name_map.erase(resource_it);
+    }
+    subscription_name_map.erase(it);
+    type_client_versions.erase(resource_name);
+  }
+  if (!resources_to_send.empty()) {
+    BuildDeltaResponse(type_url, resources_to_send, &type_client_versions,
+                       &(*nonces)[type_url], response);
+  }
+}
+
+void AdsServiceImpl::BuildDeltaResponse(
+    const std::string& type_url, const std::set<std::string>& resource_names,
+    ClientVersionMap* client_versions, int* nonce,
+    absl::optional<::envoy::service::discovery::v3::DeltaDiscoveryResponse>*
+        response) {
+  ResourceTypeState& resource_type_state = resource_map_[type_url];
+  ::envoy::service::discovery::v3::DeltaDiscoveryResponse delta_response;
+  for (const std::string& resource_name : resource_names) {
+    const ResourceState& resource_state =
+        resource_type_state.resource_name_map[resource_name];
+    auto it = client_versions->find(resource_name);
+    if (resource_state.resource.has_value()) {
+      // Skip resources that the client already has.
+      if (it != client_versions->end() &&
+          it->second == resource_state.resource_type_version) {
+        continue;
+      }
+      auto* resource = delta_response.add_resources();
+      resource->set_name(resource_name);
+      resource->set_version(
+          std::to_string(resource_state.resource_type_version));
+      *resource->mutable_resource() = resource_state.resource.value();
+      (*client_versions)[resource_name] = resource_state.resource_type_version;
+    } else if (it != client_versions->end()) {
+      // The client has a resource that no longer exists.
+      delta_response.add_removed_resources(resource_name);
+      client_versions->erase(it);
+    }
+  }
+  if (delta_response.resources().empty() &&
+      delta_response.removed_resources().empty()) {
+    return;
+  }
+  delta_response.set_type_url(type_url);
+  delta_response.set_system_version_info(
+      std::to_string(resource_type_state.resource_type_version));
+  delta_response.set_nonce(std::to_string(++*nonce));
+  *response = std::move(delta_response);
+}
+
 void AdsServiceImpl::Start() {
   grpc_core::MutexLock lock(&ads_mu_);
   ads_done_ = false;
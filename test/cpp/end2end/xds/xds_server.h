@@ -78,11 +78,11 @@ class AdsServiceImpl : public std::enable_shared_from_this<AdsServiceImpl> {
   };
 
   AdsServiceImpl()
-      : v2_rpc_service_(this, /*is_v2=*/true),
-        v3_rpc_service_(this, /*is_v2=*/false) {}
+      : v2_rpc_service_(this, /*is_v2=*/true), v3_rpc_service_(this) {}
 
   bool seen_v2_client() const { return seen_v2_client_; }
   bool seen_v3_client() const { return seen_v3_client_; }
+  bool seen_delta_client() const { return seen_delta_client_; }
 
   ::envoy::service::discovery::v2::AggregatedDiscoveryService::Service*
   v2_rpc_service() {
@@ -170,6 +170,21 @@ class AdsServiceImpl : public std::enable_shared_from_this<AdsServiceImpl> {
     return GetResponseState(kEdsTypeUrl);
   }
 
+  // Returns the initial_resource_versions of the most recent Delta xDS
+  // request for the given resource type that carried any.
+  std::map<std::string, std::string> delta_initial_resource_versions(
+      const std::string& type_url) {
+    grpc_core::MutexLock lock(&ads_mu_);
+    return delta_initial_resource_versions_[type_url];
+  }
+
+  // Returns the names that Delta xDS clients have unsubscribed from for
+  // the given resource type.
+  std::set<std::string> delta_unsubscribed_names(const std::string& type_url) {
+    grpc_core::MutexLock lock(&ads_mu_);
+    return delta_unsubscribed_names_[type_url];
+  }
+
   // Starts the service.
   void Start();
 
@@ -188,6 +203,10 @@ class AdsServiceImpl : public std::enable_shared_from_this<AdsServiceImpl> {
   }
 
  private:
+  using DeltaStream = ServerReaderWriter<
+      ::envoy::service::discovery::v3::DeltaDiscoveryResponse,
+      ::envoy::service::discovery::v3::DeltaDiscoveryRequest>;
+
   // A queue of resource type/name pairs that have changed since the client
   // subscribed to them.
   using UpdateQueue = std::deque<
@@ -479,6 +498,7 @@ class AdsServiceImpl : public std::enable_shared_from_this<AdsServiceImpl> {
             }
             if (parent_->wrap_resources_) {
               envoy::service::discovery::v3::Resource resource_wrapper;
+              resource_wrapper.set_name(resource_name);
               *resource_wrapper.mutable_resource() = std::move(*resource);
               resource->PackFrom(resource_wrapper);
             }
@@ -629,6 +649,52 @@ class AdsServiceImpl : public std::enable_shared_from_this<AdsServiceImpl> {
     const bool is_v2_;
   };
 
+  // The v3 service, which also speaks the incremental (Delta) variant of
+  // ADS.
+  class V3RpcService
+      : public RpcService<
+            ::envoy::service::discovery::v3::AggregatedDiscoveryService,
+            ::envoy::service::discovery::v3::DiscoveryRequest,
+            ::envoy::service::discovery::v3::DiscoveryResponse> {
+   public:
+    explicit V3RpcService(AdsServiceImpl* parent)
+        : RpcService(parent, /*is_v2=*/false), ads_service_(parent) {}
+
+    Status DeltaAggregatedResources(ServerContext* context,
+                                    DeltaStream* stream) override {
+      return ads_service_->HandleDeltaStream(context, stream);
+    }
+
+   private:
+    AdsServiceImpl* ads_service_;
+  };
+
+  // The version of each resource of a given type that a Delta xDS
+  // client has, as far as the server knows.
+  using ClientVersionMap = std::map<std::string /* resource_name */, int>;
+
+  // Runs a Delta xDS stream.
+  Status HandleDeltaStream(ServerContext* context, DeltaStream* stream);
+
+  // Processes a request read from a Delta xDS client.
+  // Populates response if needed.
+  void ProcessDeltaRequest(
+      const ::envoy::service::discovery::v3::DeltaDiscoveryRequest& request,
+      UpdateQueue* update_queue, SubscriptionMap* subscription_map,
+      std::map<std::string /* type_url */, ClientVersionMap>* client_versions,
+      std::map<std::string /* type_url */, int>* nonces,
+      absl::optional<::envoy::service::discovery::v3::DeltaDiscoveryResponse>*
+          response) ABSL_EXCLUSIVE_LOCKS_REQUIRED(ads_mu_);
+
+  // Builds a Delta xDS response with the given resources that the client
+  // does not already have, and the ones it has that no longer exist.
+  // Leaves response unset if there is nothing to send.
+  void BuildDeltaResponse(
+      const std::string& type_url, const std::set<std::string>& resource_names,
+      ClientVersionMap* client_versions, int* nonce,
+      absl::optional<::envoy::service::discovery::v3::DeltaDiscoveryResponse>*
+          response) ABSL_EXCLUSIVE_LOCKS_REQUIRED(ads_mu_);
+
   // Checks whether the client needs to receive a newer version of
   // the resource.
   static bool ClientNeedsResourceUpdate(
@@ -665,13 +731,11 @@ class AdsServiceImpl : public std::enable_shared_from_this<AdsServiceImpl> {
              ::envoy::api::v2::DiscoveryRequest,
              ::envoy::api::v2::DiscoveryResponse>
       v2_rpc_service_;
-  RpcService<::envoy::service::discovery::v3::AggregatedDiscoveryService,
-             ::envoy::service::discovery::v3::DiscoveryRequest,
-             ::envoy::service::discovery::v3::DiscoveryResponse>
-      v3_rpc_service_;
+  V3RpcService v3_rpc_service_;
 
   std::atomic_bool seen_v2_client_{false};
   std::atomic_bool seen_v3_client_{false};
+  std::atomic_bool seen_delta_client_{false};
 
   grpc_core::CondVar ads_cond_;
   grpc_core::Mutex ads_mu_;
@@ -682,6 +746,10 @@ class AdsServiceImpl : public std::enable_shared_from_this<AdsServiceImpl> {
       ABSL_GUARDED_BY(ads_mu_);
   std::map<std::string /*resource_type*/, int> resource_type_min_versions_
       ABSL_GUARDED_BY(ads_mu_);
+  std::map<std::string /*resource_type*/, std::map<std::string, std::string>>
+      delta_initial_resource_versions_ ABSL_GUARDED_BY(ads_mu_);
+  std::map<std::string /*resource_type*/, std::set<std::string>>
+      delta_unsubscribed_names_ ABSL_GUARDED_BY(ads_mu_);
   // An instance data member containing the current state of all resources.
   // Note that an entry will exist whenever either of the following is true:
   // - The resource exists (i.e., has been created by SetResource() and has not
@@ -0,0 +1,131 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the rate at which a server can accept and close connections,
+   with channelz off, on, and on with sampled socket nodes. */
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_args_preconditioning.h"
+#include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/transport/transport.h"
+#include "test/core/util/passthru_endpoint.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+enum class ChannelzMode {
+  kOff,
+  kOn,
+  // One transport in 16 gets a socket node.
+  kSampled,
+};
+
+const grpc_channel_args* MakeServerArgs(ChannelzMode mode) {
+  grpc_arg args[] = {
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_ENABLE_CHANNELZ),
+          mode != ChannelzMode::kOff),
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_CHANNELZ_SOCKET_SAMPLING_INTERVAL),
+          mode == ChannelzMode::kSampled ? 16 : 1),
+  };
+  grpc_channel_args c_args = {GPR_ARRAY_SIZE(args), args};
+  return CoreConfiguration::Get()
+      .channel_args_preconditioning()
+      .PreconditionChannelArgs(&c_args)
+      .ToC();
+}
+
+// Each iteration accepts a connection as a server does: it creates a server
+// transport, adds its socket node (if any) to the server's channelz node,
+// and then closes the connection.  Run on several threads, this shows how
+// much the channelz bookkeeping of each connection contends.
+void BM_ConnectionChurn(benchmark::State& state, ChannelzMode mode) {
+  static channelz::ServerNode* server_node =
+      new channelz::ServerNode(/*channel_tracer_max_nodes=*/0);
+  ExecCtx exec_ctx;
+  const grpc_channel_args* args = MakeServerArgs(mode);
+  grpc_passthru_endpoint_stats* stats = grpc_passthru_endpoint_stats_create();
+  for (auto _ : state) {
+    grpc_endpoint* client_endpoint;
+    grpc_endpoint* server_endpoint;
+    grpc_passthru_endpoint_create(&client_endpoint, &server_endpoint, stats);
+    grpc_transport* transport = grpc_create_chttp2_transport(
+        args, server_endpoint, /*is_client=*/false);
+    RefCountedPtr<channelz::SocketNode> socket_node =
+        grpc_chttp2_transport_get_socket_node(transport);
+    if (socket_node != nullptr) server_node->AddChildSocket(socket_node);
+    grpc_chttp2_transport_start_reading(transport, nullptr, nullptr, nullptr);
+    exec_ctx.Flush();
+    if (socket_node != nullptr) {
+      server_node->RemoveChildSocket(socket_node->uuid());
+    }
+    socket_node.reset();
+    grpc_transport_destroy(transport);
+    grpc_endpoint_destroy(client_endpoint);
+    exec_ctx.Flush();
+  }
+  grpc_passthru_endpoint_stats_destroy(stats);
+  grpc_channel_args_destroy(args);
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ConnectionChurnChannelzOff(benchmark::State& state) {
+  BM_ConnectionChurn(state, ChannelzMode::kOff);
+}
+BENCHMARK(BM_ConnectionChurnChannelzOff)->ThreadRange(1, 16)->UseRealTime();
+
+void BM_ConnectionChurnChannelzOn(benchmark::State& state) {
+  BM_ConnectionChurn(state, ChannelzMode::kOn);
+}
+BENCHMARK(BM_ConnectionChurnChannelzOn)->ThreadRange(1, 16)->UseRealTime();
+
+void BM_ConnectionChurnChannelzSampled(benchmark::State& state) {
+  BM_ConnectionChurn(state, ChannelzMode::kSampled);
+}
+BENCHMARK(BM_ConnectionChurnChannelzSampled)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,128 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark streaming throughput over TLS, with and without kernel TLS
+   offload */
+
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+
+#include "test/core/end2end/data/ssl_test_data.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/fullstack_streaming_pump.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+/*******************************************************************************
+ * FIXTURES
+ */
+
+class TlsFixtureConfiguration : public FixtureConfiguration {
+ public:
+  explicit TlsFixtureConfiguration(bool kernel_tls_offload)
+      : kernel_tls_offload_(kernel_tls_offload) {}
+
+  void ApplyCommonChannelArguments(ChannelArguments* c) const override {
+    FixtureConfiguration::ApplyCommonChannelArguments(c);
+    c->SetSslTargetNameOverride("foo.test.google.fr");
+    c->SetInt(GRPC_ARG_TSI_KERNEL_TLS_OFFLOAD, kernel_tls_offload_);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+    b->AddChannelArgument(GRPC_ARG_TSI_KERNEL_TLS_OFFLOAD, kernel_tls_offload_);
+  }
+
+ private:
+  const bool kernel_tls_offload_;
+};
+
+class TLSFixture : public FullstackFixture {
+ public:
+  TLSFixture(Service* service, bool kernel_tls_offload)
+      : FullstackFixture(service, TlsFixtureConfiguration(kernel_tls_offload),
+                         MakeAddress(&port_), MakeServerCredentials(),
+                         MakeChannelCredentials()) {}
+
+  ~TLSFixture() override { grpc_recycle_unused_port(port_); }
+
+ private:
+  int port_;
+
+  static std::string MakeAddress(int* port) {
+    *port = grpc_pick_unused_port_or_die();
+    std::stringstream addr;
+    addr << "localhost:" << *port;
+    return addr.str();
+  }
+
+  static std::shared_ptr<ServerCredentials> MakeServerCredentials() {
+    SslServerCredentialsOptions options;
+    options.pem_key_cert_pairs.push_back({test_server1_key, test_server1_cert});
+    return SslServerCredentials(options);
+  }
+
+  static std::shared_ptr<ChannelCredentials> MakeChannelCredentials() {
+    SslCredentialsOptions options;
+    options.pem_root_certs = test_root_cert;
+    return SslCredentials(options);
+  }
+};
+
+class TLS : public TLSFixture {
+ public:
+  explicit TLS(Service* service) : TLSFixture(service, false) {}
+};
+
+class KernelTLS : public TLSFixture {
+ public:
+  explicit KernelTLS(Service* service) : TLSFixture(service, true) {}
+};
+
+/*******************************************************************************
+ * CONFIGURATIONS
+ */
+
+BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, TLS)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, KernelTLS)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, TLS)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, KernelTLS)
+    ->Range(0, 128 * 1024 * 1024);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
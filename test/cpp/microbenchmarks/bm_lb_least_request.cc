@@ -0,0 +1,178 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Simulate a fleet where one backend is much slower than the others and
+   compare the tail latency seen by concurrent clients under round_robin and
+   least_request. */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+
+#include <grpc/support/time.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+constexpr int kNumFastBackends = 3;
+constexpr int kSlowBackendDelayUs = 5000;
+constexpr int kFastBackendDelayUs = 100;
+
+static const char* LbPolicyName(int64_t index) {
+  return index == 0 ? "round_robin" : "least_request";
+}
+
+// Echo service that holds every call for a fixed time before responding.
+class DelayedEchoService : public EchoTestService::Service {
+ public:
+  explicit DelayedEchoService(int delay_us) : delay_us_(delay_us) {}
+
+  Status Echo(ServerContext* /*context*/, const EchoRequest* request,
+              EchoResponse* response) override {
+    gpr_sleep_until(gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                                 gpr_time_from_micros(delay_us_, GPR_TIMESPAN)));
+    response->set_message(request->message());
+    return Status::OK;
+  }
+
+ private:
+  const int delay_us_;
+};
+
+// One slow and kNumFastBackends fast backends shared by all benchmarks, and a
+// connected channel to them for each LB policy.
+class LeastRequestFixture {
+ public:
+  LeastRequestFixture() {
+    std::vector<std::string> addresses;
+    for (int i = 0; i <= kNumFastBackends; i++) {
+      const int port = grpc_pick_unused_port_or_die();
+      services_.push_back(absl::make_unique<DelayedEchoService>(
+          i == 0 ? kSlowBackendDelayUs : kFastBackendDelayUs));
+      ServerBuilder builder;
+      builder.AddListeningPort(absl::StrCat("localhost:", port),
+                               InsecureServerCredentials());
+      builder.RegisterService(services_.back().get());
+      servers_.push_back(builder.BuildAndStart());
+      addresses.push_back(absl::StrCat("127.0.0.1:", port));
+    }
+    const std::string target =
+        absl::StrCat("ipv4:", absl::StrJoin(addresses, ","));
+    for (int i = 0; i < 2; i++) {
+      ChannelArguments args;
+      args.SetServiceConfigJSON(absl::StrCat(
+          "{\"loadBalancingConfig\": [{\"", LbPolicyName(i), "\": {}}]}"));
+      channels_[i] =
+          CreateCustomChannel(target, InsecureChannelCredentials(), args);
+      GPR_ASSERT(
+          channels_[i]->WaitForConnected(grpc_timeout_seconds_to_deadline(30)));
+    }
+  }
+
+  ~LeastRequestFixture() {
+    for (auto& channel : channels_) channel.reset();
+    for (auto& server : servers_) server->Shutdown();
+  }
+
+  const std::shared_ptr<Channel>& channel(int64_t lb_policy) const {
+    return channels_[lb_policy];
+  }
+
+ private:
+  std::vector<std::unique_ptr<DelayedEchoService>> services_;
+  std::vector<std::unique_ptr<Server>> servers_;
+  std::shared_ptr<Channel> channels_[2];
+};
+
+static LeastRequestFixture* g_fixture;
+
+static void BM_LeastRequestMixedBackends(benchmark::State& state) {
+  std::unique_ptr<EchoTestService::Stub> stub =
+      EchoTestService::NewStub(g_fixture->channel(state.range(0)));
+  EchoRequest request;
+  request.set_message("hello");
+  EchoResponse response;
+  std::vector<int64_t> latencies_us;
+  int64_t failed = 0;
+  for (auto _ : state) {
+    ClientContext context;
+    const gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+    if (!stub->Echo(&context, request, &response).ok()) failed++;
+    const gpr_timespec elapsed =
+        gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start);
+    latencies_us.push_back(elapsed.tv_sec * GPR_US_PER_SEC +
+                           elapsed.tv_nsec / GPR_NS_PER_US);
+  }
+  std::sort(latencies_us.begin(), latencies_us.end());
+  // Each thread reports its own percentiles; the counters are averaged
+  // across threads.
+  state.counters["p50_us"] = benchmark::Counter(
+      static_cast<double>(latencies_us[latencies_us.size() / 2]),
+      benchmark::Counter::kAvgThreads);
+  state.counters["p99_us"] = benchmark::Counter(
+      static_cast<double>(latencies_us[latencies_us.size() * 99 / 100]),
+      benchmark::Counter::kAvgThreads);
+  state.counters["failed"] = static_cast<double>(failed);
+  state.SetItemsProcessed(state.iterations());
+}
+// Argument is the LB policy: round_robin or least_request.
+BENCHMARK(BM_LeastRequestMixedBackends)
+    ->Arg(0)
+    ->Arg(1)
+    ->ThreadRange(4, 64)
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  grpc::testing::g_fixture = new grpc::testing::LeastRequestFixture();
+  benchmark::RunTheBenchmarksNamespaced();
+  delete grpc::testing::g_fixture;
+  return 0;
+}
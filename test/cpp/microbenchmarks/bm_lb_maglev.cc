@@ -0,0 +1,197 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the request-hash lookup structures of ring_hash and maglev:
+   build time, memory and pick latency, for equal and for skewed endpoint
+   weights. */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#define XXH_INLINE_ALL
+#include "xxhash.h"
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/ext/filters/client_channel/lb_policy/maglev/maglev_table.h"
+#include "src/core/lib/gprpp/fast_random.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+struct Endpoints {
+  std::vector<std::string> addresses;
+  std::vector<uint32_t> weights;
+};
+
+// range(0) is the number of endpoints.  If range(1) is non-zero, weights
+// are spread between 1 and 100, as they are once EDS locality weights are
+// multiplied in; otherwise they are all 1.
+Endpoints MakeEndpoints(const benchmark::State& state) {
+  Endpoints endpoints;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    endpoints.addresses.push_back(absl::StrCat(
+        "10.", i / 65536, ".", i / 256 % 256, ".", i % 256, ":443"));
+    endpoints.weights.push_back(state.range(1) ? i % 100 + 1 : 1);
+  }
+  return endpoints;
+}
+
+// A copy of the ring built by RingHash::Ring, with the default
+// min_ring_size and max_ring_size.
+struct RingEntry {
+  uint64_t hash;
+  size_t index;
+};
+
+std::vector<RingEntry> BuildRing(const Endpoints& endpoints) {
+  constexpr size_t kMinRingSize = 1024;
+  constexpr size_t kMaxRingSize = 8388608;
+  uint64_t sum = 0;
+  uint32_t min_weight = UINT32_MAX;
+  for (uint32_t weight : endpoints.weights) {
+    sum += weight;
+    min_weight = std::min(min_weight, weight);
+  }
+  const double min_normalized_weight = static_cast<double>(min_weight) / sum;
+  const double scale = std::min(
+      std::ceil(min_normalized_weight * kMinRingSize) / min_normalized_weight,
+      static_cast<double>(kMaxRingSize));
+  std::vector<RingEntry> ring;
+  ring.reserve(std::ceil(scale));
+  double current_hashes = 0.0;
+  double target_hashes = 0.0;
+  for (size_t i = 0; i < endpoints.addresses.size(); ++i) {
+    target_hashes += scale * endpoints.weights[i] / static_cast<double>(sum);
+    for (size_t count = 0; current_hashes < target_hashes; ++count) {
+      const std::string key = absl::StrCat(endpoints.addresses[i], "_", count);
+      ring.push_back({XXH64(key.data(), key.size(), 0), i});
+      ++current_hashes;
+    }
+  }
+  std::sort(ring.begin(), ring.end(),
+            [](const RingEntry& lhs, const RingEntry& rhs) {
+              return lhs.hash < rhs.hash;
+            });
+  return ring;
+}
+
+size_t PickFromRing(const std::vector<RingEntry>& ring, uint64_t hash) {
+  auto it = std::lower_bound(
+      ring.begin(), ring.end(), hash,
+      [](const RingEntry& entry, uint64_t h) { return entry.hash < h; });
+  return it == ring.end() ? ring.front().index : it->index;
+}
+
+grpc_core::MaglevTable BuildMaglevTable(const Endpoints& endpoints) {
+  std::vector<grpc_core::MaglevTable::Endpoint> table_endpoints;
+  for (size_t i = 0; i < endpoints.addresses.size(); ++i) {
+    table_endpoints.push_back({endpoints.addresses[i], endpoints.weights[i]});
+  }
+  return grpc_core::MaglevTable(table_endpoints,
+                                grpc_core::MaglevTable::kDefaultTableSize);
+}
+
+// Request hashes, generated up front so that the pick benchmarks measure
+// only the lookup.
+std::vector<uint64_t> MakeHashes() {
+  std::vector<uint64_t> hashes(4096);
+  for (uint64_t& hash : hashes) hash = grpc_core::FastRandom64();
+  return hashes;
+}
+
+}  // namespace
+
+static void BM_RingHashBuild(benchmark::State& state) {
+  const Endpoints endpoints = MakeEndpoints(state);
+  size_t bytes = 0;
+  for (auto _ : state) {
+    std::vector<RingEntry> ring = BuildRing(endpoints);
+    bytes = ring.capacity() * sizeof(RingEntry);
+    benchmark::DoNotOptimize(ring.data());
+  }
+  state.counters["bytes"] = bytes;
+}
+
+static void BM_MaglevBuild(benchmark::State& state) {
+  const Endpoints endpoints = MakeEndpoints(state);
+  size_t bytes = 0;
+  for (auto _ : state) {
+    grpc_core::MaglevTable table = BuildMaglevTable(endpoints);
+    bytes = table.MemoryUsage();
+    benchmark::DoNotOptimize(table.size());
+  }
+  state.counters["bytes"] = bytes;
+}
+
+static void BM_RingHashPick(benchmark::State& state) {
+  const std::vector<RingEntry> ring = BuildRing(MakeEndpoints(state));
+  const std::vector<uint64_t> hashes = MakeHashes();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(PickFromRing(ring, hashes[i++ % hashes.size()]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_MaglevPick(benchmark::State& state) {
+  const grpc_core::MaglevTable table = BuildMaglevTable(MakeEndpoints(state));
+  const std::vector<uint64_t> hashes = MakeHashes();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        table.endpoint_index(table.Slot(hashes[i++ % hashes.size()])));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Replace "benchmark::internal::Benchmark" with "::testing::Benchmark" to use
+// internal microbenchmarking tooling
+static void EndpointArgs(benchmark::internal::Benchmark* b) {
+  for (int num_endpoints : {10, 1000, 10000}) {
+    b->Args({num_endpoints, 0});
+    b->Args({num_endpoints, 1});
+  }
+}
+
+BENCHMARK(BM_RingHashBuild)->Apply(EndpointArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MaglevBuild)->Apply(EndpointArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RingHashPick)->Apply(EndpointArgs);
+BENCHMARK(BM_MaglevPick)->Apply(EndpointArgs);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
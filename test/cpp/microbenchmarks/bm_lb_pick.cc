@@ -0,0 +1,139 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark unary RPCs issued by many threads on a single shared channel, so
+   that every call goes through the LB pick of the same channel. */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+
+#include <grpcpp/channel.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/callback_test_service.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+constexpr int kNumBackends = 4;
+
+static const char* LbPolicyName(int64_t index) {
+  return index == 0 ? "pick_first" : "round_robin";
+}
+
+// Backends shared by all benchmarks, and a connected channel to them for each
+// LB policy.
+class PickFixture {
+ public:
+  PickFixture() {
+    std::vector<std::string> addresses;
+    for (int i = 0; i < kNumBackends; i++) {
+      const int port = grpc_pick_unused_port_or_die();
+      services_.push_back(absl::make_unique<CallbackStreamingTestService>());
+      ServerBuilder builder;
+      builder.AddListeningPort(absl::StrCat("localhost:", port),
+                               InsecureServerCredentials());
+      builder.RegisterService(services_.back().get());
+      servers_.push_back(builder.BuildAndStart());
+      addresses.push_back(absl::StrCat("127.0.0.1:", port));
+    }
+    const std::string target =
+        absl::StrCat("ipv4:", absl::StrJoin(addresses, ","));
+    for (int i = 0; i < 2; i++) {
+      ChannelArguments args;
+      args.SetLoadBalancingPolicyName(LbPolicyName(i));
+      channels_[i] =
+          CreateCustomChannel(target, InsecureChannelCredentials(), args);
+      GPR_ASSERT(
+          channels_[i]->WaitForConnected(grpc_timeout_seconds_to_deadline(30)));
+    }
+  }
+
+  ~PickFixture() {
+    for (auto& channel : channels_) channel.reset();
+    for (auto& server : servers_) server->Shutdown();
+  }
+
+  const std::shared_ptr<Channel>& channel(int64_t lb_policy) const {
+    return channels_[lb_policy];
+  }
+
+ private:
+  std::vector<std::unique_ptr<CallbackStreamingTestService>> services_;
+  std::vector<std::unique_ptr<Server>> servers_;
+  std::shared_ptr<Channel> channels_[2];
+};
+
+static PickFixture* g_fixture;
+
+static void BM_LbPickSharedChannel(benchmark::State& state) {
+  std::unique_ptr<EchoTestService::Stub> stub =
+      EchoTestService::NewStub(g_fixture->channel(state.range(0)));
+  EchoRequest request;
+  EchoResponse response;
+  int64_t failed = 0;
+  for (auto _ : state) {
+    ClientContext context;
+    if (!stub->Echo(&context, request, &response).ok()) failed++;
+  }
+  state.counters["failed"] = static_cast<double>(failed);
+  state.SetItemsProcessed(state.iterations());
+}
+// Argument is the LB policy: pick_first or round_robin.
+BENCHMARK(BM_LbPickSharedChannel)
+    ->Arg(0)
+    ->Arg(1)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  grpc::testing::g_fixture = new grpc::testing::PickFixture();
+  benchmark::RunTheBenchmarksNamespaced();
+  delete grpc::testing::g_fixture;
+  return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark weighted child selection, as done by the weighted_target picker:
+   rand() plus a binary search over cumulative weights, against an alias table
+   with a thread-local PRNG. */
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/alias_table.h"
+#include "src/core/lib/gprpp/fast_random.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+// Weights between 1 and 100, the same for every run.
+static std::vector<uint32_t> MakeWeights(size_t num_children) {
+  std::vector<uint32_t> weights;
+  uint32_t x = 1;
+  for (size_t i = 0; i < num_children; ++i) {
+    x = x * 1103515245 + 12345;
+    weights.push_back((x >> 16) % 100 + 1);
+  }
+  return weights;
+}
+
+static void BM_CumulativeWeightsPick(benchmark::State& state) {
+  std::vector<uint32_t> ends;
+  uint32_t end = 0;
+  for (uint32_t weight : MakeWeights(state.range(0))) {
+    end += weight;
+    ends.push_back(end);
+  }
+  for (auto _ : state) {
+    const uint32_t key = rand() % ends.back();
+    benchmark::DoNotOptimize(std::upper_bound(ends.begin(), ends.end(), key));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CumulativeWeightsPick)->Range(2, 500);
+BENCHMARK(BM_CumulativeWeightsPick)->Arg(100)->ThreadRange(1, 32);
+
+static void BM_AliasTablePick(benchmark::State& state) {
+  const std::vector<uint32_t> weights = MakeWeights(state.range(0));
+  grpc_core::AliasTable table(weights);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.Pick(grpc_core::FastRandom64()));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AliasTablePick)->Range(2, 500);
+BENCHMARK(BM_AliasTablePick)->Arg(100)->ThreadRange(1, 32);
+
+static void BM_AliasTableBuild(benchmark::State& state) {
+  const std::vector<uint32_t> weights = MakeWeights(state.range(0));
+  for (auto _ : state) {
+    grpc_core::AliasTable table(weights);
+    benchmark::DoNotOptimize(table.size());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AliasTableBuild)->Range(2, 500);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,194 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Compare evaluating an RBAC policy with the compiled GrpcAuthorizationEngine
+   with walking its tree of AuthorizationMatchers for each policy in turn. */
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc_security_constants.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/security/authorization/grpc_authorization_engine.h"
+#include "src/core/lib/security/authorization/matchers.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "test/core/util/mock_authorization_endpoint.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+auto* g_memory_allocator = new MemoryAllocator(
+    ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator("test"));
+
+std::string MethodPath(size_t i) {
+  return absl::StrCat("/pkg.Service", i, "/Method");
+}
+
+// Policies like those of a mesh with many services: each allows some
+// methods of one service to a few workloads, identified by certificate or
+// by subnet, and every fourth also requires a tenant header.
+Rbac MakeRbac(size_t num_policies) {
+  std::map<std::string, Rbac::Policy> policies;
+  for (size_t i = 0; i < num_policies; ++i) {
+    std::vector<std::unique_ptr<Rbac::Permission>> paths;
+    paths.push_back(absl::make_unique<Rbac::Permission>(
+        Rbac::Permission::MakePathPermission(
+            *StringMatcher::Create(StringMatcher::Type::kExact,
+                                   MethodPath(i)))));
+    paths.push_back(absl::make_unique<Rbac::Permission>(
+        Rbac::Permission::MakePathPermission(*StringMatcher::Create(
+            StringMatcher::Type::kPrefix,
+            absl::StrCat("/pkg.Service", i, "/Admin")))));
+    std::vector<std::unique_ptr<Rbac::Permission>> permissions;
+    permissions.push_back(absl::make_unique<Rbac::Permission>(
+        Rbac::Permission::MakeOrPermission(std::move(paths))));
+    if (i % 4 == 0) {
+      permissions.push_back(absl::make_unique<Rbac::Permission>(
+          Rbac::Permission::MakeHeaderPermission(*HeaderMatcher::Create(
+              "x-tenant", HeaderMatcher::Type::kExact, "tenant"))));
+    }
+    std::vector<std::unique_ptr<Rbac::Principal>> principals;
+    for (size_t j = 0; j < 3; ++j) {
+      std::string spiffe_id =
+          absl::StrCat("spiffe://mesh/ns/ns", (i + j) % 16, "/sa/default");
+      principals.push_back(absl::make_unique<Rbac::Principal>(
+          Rbac::Principal::MakeAuthenticatedPrincipal(
+              *StringMatcher::Create(StringMatcher::Type::kExact, spiffe_id))));
+    }
+    principals.push_back(absl::make_unique<Rbac::Principal>(
+        Rbac::Principal::MakeSourceIpPrincipal(Rbac::CidrRange(
+            absl::StrCat("10.", i % 256, ".0.0"), /*prefix_len=*/16))));
+    policies[absl::StrCat("policy_", i)] = Rbac::Policy(
+        Rbac::Permission::MakeAndPermission(std::move(permissions)),
+        Rbac::Principal::MakeOrPrincipal(std::move(principals)));
+  }
+  return Rbac(Rbac::Action::kAllow, std::move(policies));
+}
+
+// Evaluates the policies as the engine did before it compiled them.
+class TreeEngine {
+ public:
+  explicit TreeEngine(Rbac rbac) {
+    for (auto& policy : rbac.policies) {
+      matchers_.push_back(absl::make_unique<PolicyAuthorizationMatcher>(
+          std::move(policy.second)));
+    }
+  }
+
+  bool Evaluate(const EvaluateArgs& args) const {
+    for (const auto& matcher : matchers_) {
+      if (matcher->Matches(args)) return true;
+    }
+    return false;
+  }
+
+ private:
+  std::vector<std::unique_ptr<AuthorizationMatcher>> matchers_;
+};
+
+void BM_RbacEngine(benchmark::State& state, bool compiled) {
+  const size_t num_policies = state.range(0);
+  GrpcAuthorizationEngine engine(MakeRbac(num_policies));
+  TreeEngine tree_engine(MakeRbac(num_policies));
+  ExecCtx exec_ctx;
+  // All calls arrive on one connection, from a workload that some policies
+  // allow by certificate.
+  grpc_auth_context auth_context(nullptr);
+  auth_context.add_cstring_property(GRPC_TRANSPORT_SECURITY_TYPE_PROPERTY_NAME,
+                                    GRPC_TLS_TRANSPORT_SECURITY_TYPE);
+  auth_context.add_cstring_property(GRPC_PEER_URI_PROPERTY_NAME,
+                                    "spiffe://mesh/ns/ns3/sa/default");
+  MockAuthorizationEndpoint endpoint("ipv4:10.255.0.1:443",
+                                     "ipv4:192.168.0.7:5678");
+  EvaluateArgs::PerChannelArgs channel_args(&auth_context, &endpoint);
+  // Calls spread over the whole policy list, including some for methods that
+  // no policy allows.
+  auto arena = MakeScopedArena(64 * 1024, g_memory_allocator);
+  std::vector<std::unique_ptr<grpc_metadata_batch>> calls;
+  for (size_t i = 0; i < 64; ++i) {
+    auto metadata = absl::make_unique<grpc_metadata_batch>(arena.get());
+    metadata->Set(HttpPathMetadata(),
+                  Slice::FromCopiedString(
+                      i % 8 == 7 ? "/other.Service/Method"
+                                 : MethodPath(i * num_policies / 64)));
+    metadata->Append(
+        "x-tenant", Slice::FromStaticString("tenant"),
+        [](absl::string_view, const Slice&) { GPR_ASSERT(false); });
+    calls.push_back(std::move(metadata));
+  }
+  // Both ways must reach the same decision.
+  for (const auto& metadata : calls) {
+    EvaluateArgs args(metadata.get(), &channel_args);
+    GPR_ASSERT(
+        (engine.Evaluate(args).type ==
+         AuthorizationEngine::Decision::Type::kAllow) ==
+        tree_engine.Evaluate(args));
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    EvaluateArgs args(calls[i++ % calls.size()].get(), &channel_args);
+    if (compiled) {
+      benchmark::DoNotOptimize(engine.Evaluate(args));
+    } else {
+      benchmark::DoNotOptimize(tree_engine.Evaluate(args));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_RbacEngineTree(benchmark::State& state) {
+  BM_RbacEngine(state, /*compiled=*/false);
+}
+BENCHMARK(BM_RbacEngineTree)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_RbacEngineCompiled(benchmark::State& state) {
+  BM_RbacEngine(state, /*compiled=*/true);
+}
+BENCHMARK(BM_RbacEngineCompiled)->Arg(10)->Arg(100)->Arg(1000);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
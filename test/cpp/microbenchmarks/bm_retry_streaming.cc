@@ -0,0 +1,181 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark replaying client streams on retry */
+
+#include <benchmark/benchmark.h>
+
+#include <grpcpp/resource_quota.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/fullstack_fixtures.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+// Bounds the memory the client may use, so that the bytes the client
+// holds can be read from its quota.  Retries every call to
+// EchoTestService once on UNAVAILABLE if enable_retries is set.
+class RetryFixtureConfiguration : public FixtureConfiguration {
+ public:
+  static constexpr size_t kQuotaSize = 1024 * 1024 * 1024;
+
+  explicit RetryFixtureConfiguration(bool enable_retries)
+      : enable_retries_(enable_retries) {
+    quota_.Resize(kQuotaSize);
+  }
+
+  void ApplyCommonChannelArguments(ChannelArguments* c) const override {
+    FixtureConfiguration::ApplyCommonChannelArguments(c);
+    c->SetResourceQuota(quota_);
+    if (!enable_retries_) {
+      c->SetInt(GRPC_ARG_ENABLE_RETRIES, 0);
+      return;
+    }
+    c->SetServiceConfigJSON(
+        "{\n"
+        "  \"methodConfig\": [ {\n"
+        "    \"name\": [\n"
+        "      { \"service\": \"grpc.testing.EchoTestService\" }\n"
+        "    ],\n"
+        "    \"retryPolicy\": {\n"
+        "      \"maxAttempts\": 2,\n"
+        "      \"initialBackoff\": \"0.001s\",\n"
+        "      \"maxBackoff\": \"0.001s\",\n"
+        "      \"backoffMultiplier\": 1.0,\n"
+        "      \"retryableStatusCodes\": [ \"UNAVAILABLE\" ]\n"
+        "    }\n"
+        "  } ]\n"
+        "}");
+  }
+
+  // Returns the bytes in use in the client's quota.
+  double QuotaBytesInUse() const {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_core::MemoryOwner owner =
+        grpc_core::ResourceQuota::FromC(quota_.c_resource_quota())
+            ->memory_quota()
+            ->CreateMemoryOwner("bm_retry_streaming");
+    return owner.InstantaneousPressure() * kQuotaSize;
+  }
+
+ private:
+  const bool enable_retries_;
+  grpc::ResourceQuota quota_;
+};
+
+// Reads the whole client stream, then fails the first attempt of each
+// call if fail_first_attempt is set, so that the client replays the stream.
+class ClientStreamService : public EchoTestService::Service {
+ public:
+  explicit ClientStreamService(bool fail_first_attempt)
+      : fail_first_attempt_(fail_first_attempt) {}
+
+  Status BidiStream(
+      ServerContext* context,
+      ServerReaderWriter<EchoResponse, EchoRequest>* stream) override {
+    EchoRequest request;
+    while (stream->Read(&request)) {
+    }
+    if (fail_first_attempt_ &&
+        context->client_metadata().count("grpc-previous-rpc-attempts") == 0) {
+      return Status(StatusCode::UNAVAILABLE, "first attempt");
+    }
+    return Status::OK;
+  }
+
+ private:
+  const bool fail_first_attempt_;
+};
+
+/*******************************************************************************
+ * BENCHMARKING KERNELS
+ */
+
+// Arguments are the size of each message and the number of messages on
+// each stream.  Reports the client's quota usage once the whole stream
+// has been written: with retries, that includes the messages buffered
+// for replay, which the no-retry baseline does not hold.
+static void RunClientStream(benchmark::State& state, bool retry) {
+  const size_t message_size = state.range(0);
+  const int64_t num_messages = state.range(1);
+  ClientStreamService service(/*fail_first_attempt=*/retry);
+  RetryFixtureConfiguration config(/*enable_retries=*/retry);
+  std::unique_ptr<TCP> fixture(new TCP(&service, config));
+  std::unique_ptr<EchoTestService::Stub> stub(
+      EchoTestService::NewStub(fixture->channel()));
+  EchoRequest send_request;
+  send_request.set_message(std::string(message_size, 'a'));
+  double quota_bytes_in_use = 0;
+  for (auto _ : state) {
+    ClientContext cli_ctx;
+    auto stream = stub->BidiStream(&cli_ctx);
+    for (int64_t i = 0; i < num_messages; ++i) {
+      GPR_ASSERT(stream->Write(send_request));
+    }
+    // The server only responds after the half-close, so the call has not
+    // committed yet.
+    quota_bytes_in_use += config.QuotaBytesInUse();
+    GPR_ASSERT(stream->WritesDone());
+    GPR_ASSERT(stream->Finish().ok());
+  }
+  fixture->Finish(state);
+  fixture.reset();
+  state.counters["quota_bytes_in_use_per_call"] =
+      benchmark::Counter(quota_bytes_in_use / state.iterations());
+  state.counters["message_bytes_per_call"] =
+      benchmark::Counter(message_size * num_messages);
+  state.SetBytesProcessed(message_size * num_messages * state.iterations());
+}
+
+// Baseline: the same streams with retries disabled.
+static void BM_ClientStreamNoRetry(benchmark::State& state) {
+  RunClientStream(state, /*retry=*/false);
+}
+BENCHMARK(BM_ClientStreamNoRetry)
+    ->ArgsProduct({{1024, 64 * 1024, 1024 * 1024}, {1, 4, 16}});
+
+// Each call fails its first attempt and replays the stream once.
+static void BM_RetryClientStream(benchmark::State& state) {
+  RunClientStream(state, /*retry=*/true);
+}
+BENCHMARK(BM_RetryClientStream)
+    ->ArgsProduct({{1024, 64 * 1024, 1024 * 1024}, {1, 4, 16}});
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
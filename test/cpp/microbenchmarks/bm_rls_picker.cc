@@ -0,0 +1,420 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark picks of the RLS LB policy issued by many threads at once, for
+   small and large sets of keys that are all in the RLS cache.  The child
+   policies complete every pick without a subchannel, so that only the RLS
+   picker is measured. */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+
+#include <grpc/grpc_security.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+
+#include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy_factory.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/iomgr/work_serializer.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/security/credentials/credentials.h"
+#include "src/proto/grpc/lookup/v1/rls.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+using grpc_core::LoadBalancingPolicy;
+
+constexpr char kChildPolicyName[] = "bm_rls_child";
+constexpr char kKeyHeader[] = "key1";
+constexpr char kPath[] = "/grpc.testing.EchoTestService/Echo";
+constexpr int kNumTargets = 16;
+constexpr int kMaxKeys = 100000;
+// Number of keys looked up at once while filling the cache.
+constexpr int kWarmBatchSize = 1000;
+
+//
+// Child policy
+//
+
+class ChildConfig : public LoadBalancingPolicy::Config {
+ public:
+  const char* name() const override { return kChildPolicyName; }
+};
+
+class CompletePicker : public LoadBalancingPolicy::SubchannelPicker {
+ public:
+  LoadBalancingPolicy::PickResult Pick(
+      LoadBalancingPolicy::PickArgs /*args*/) override {
+    return LoadBalancingPolicy::PickResult::Complete(nullptr);
+  }
+};
+
+// Reports READY with a picker that completes every pick.
+class ChildPolicy : public LoadBalancingPolicy {
+ public:
+  explicit ChildPolicy(Args args) : LoadBalancingPolicy(std::move(args)) {}
+
+  const char* name() const override { return kChildPolicyName; }
+
+  void UpdateLocked(UpdateArgs /*args*/) override {
+    channel_control_helper()->UpdateState(GRPC_CHANNEL_READY, absl::Status(),
+                                          absl::make_unique<CompletePicker>());
+  }
+
+  void ResetBackoffLocked() override {}
+
+ private:
+  void ShutdownLocked() override {}
+};
+
+class ChildPolicyFactory : public grpc_core::LoadBalancingPolicyFactory {
+ public:
+  grpc_core::OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return grpc_core::MakeOrphanable<ChildPolicy>(std::move(args));
+  }
+
+  const char* name() const override { return kChildPolicyName; }
+
+  grpc_core::RefCountedPtr<LoadBalancingPolicy::Config>
+  ParseLoadBalancingConfig(const grpc_core::Json& /*json*/,
+                           grpc_error_handle* /*error*/) const override {
+    return grpc_core::MakeRefCounted<ChildConfig>();
+  }
+};
+
+//
+// RLS server
+//
+
+// Routes each key to one of kNumTargets targets.
+class RouteLookupService
+    : public grpc::lookup::v1::RouteLookupService::Service {
+ public:
+  Status RouteLookup(
+      ServerContext* /*context*/,
+      const grpc::lookup::v1::RouteLookupRequest* request,
+      grpc::lookup::v1::RouteLookupResponse* response) override {
+    auto it = request->key_map().find(kKeyHeader);
+    const std::string key = it == request->key_map().end() ? "" : it->second;
+    response->add_targets(
+        absl::StrCat("target", std::hash<std::string>()(key) % kNumTargets));
+    return Status::OK;
+  }
+};
+
+//
+// Pick arguments
+//
+
+class KeyMetadata : public LoadBalancingPolicy::MetadataInterface {
+ public:
+  void set_key(absl::string_view key) { key_ = key; }
+
+  void Add(absl::string_view /*key*/, absl::string_view /*value*/) override {}
+
+  std::vector<std::pair<std::string, std::string>> TestOnlyCopyToVector()
+      override {
+    return {{kKeyHeader, std::string(key_)}};
+  }
+
+  absl::optional<absl::string_view> Lookup(
+      absl::string_view key, std::string* /*buffer*/) const override {
+    if (key != kKeyHeader) return absl::nullopt;
+    return key_;
+  }
+
+ private:
+  absl::string_view key_;
+};
+
+// The RLS server returns no header data, so the picker never allocates.
+class NoAllocCallState : public LoadBalancingPolicy::CallState {
+ public:
+  void* Alloc(size_t /*size*/) override {
+    GPR_ASSERT(false);
+    return nullptr;
+  }
+};
+
+//
+// Fixture
+//
+
+// An RLS policy whose cache holds kMaxKeys keys, and its RLS server.
+class RlsPickerFixture {
+ public:
+  RlsPickerFixture() {
+    const int port = grpc_pick_unused_port_or_die();
+    ServerBuilder builder;
+    builder.AddListeningPort(absl::StrCat("localhost:", port),
+                             InsecureServerCredentials());
+    builder.RegisterService(&rls_service_);
+    server_ = builder.BuildAndStart();
+    for (int i = 0; i < kMaxKeys; ++i) {
+      keys_.push_back(absl::StrCat("key", i));
+    }
+    grpc_core::ExecCtx exec_ctx;
+    pollset_ = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(pollset_, &pollset_mu_);
+    CreatePolicy(port);
+    for (size_t start = 0; start < keys_.size(); start += kWarmBatchSize) {
+      WarmCache(start, std::min(keys_.size(), start + kWarmBatchSize));
+    }
+  }
+
+  ~RlsPickerFixture() {
+    {
+      grpc_core::ExecCtx exec_ctx;
+      work_serializer_->Run([this]() { policy_.reset(); }, DEBUG_LOCATION);
+      {
+        grpc_core::MutexLock lock(&mu_);
+        picker_.reset();
+      }
+      grpc_core::ExecCtx::Get()->Flush();
+      grpc_closure destroyed;
+      GRPC_CLOSURE_INIT(
+          &destroyed,
+          [](void* pollset, grpc_error_handle /*error*/) {
+            grpc_pollset_destroy(static_cast<grpc_pollset*>(pollset));
+          },
+          pollset_, grpc_schedule_on_exec_ctx);
+      grpc_pollset_shutdown(pollset_, &destroyed);
+    }
+    gpr_free(pollset_);
+    server_->Shutdown();
+  }
+
+  const std::vector<std::string>& keys() const { return keys_; }
+
+  std::shared_ptr<LoadBalancingPolicy::SubchannelPicker> picker() {
+    grpc_core::MutexLock lock(&mu_);
+    return picker_;
+  }
+
+ private:
+  class Helper : public LoadBalancingPolicy::ChannelControlHelper {
+   public:
+    explicit Helper(RlsPickerFixture* fixture) : fixture_(fixture) {}
+
+    grpc_core::RefCountedPtr<grpc_core::SubchannelInterface> CreateSubchannel(
+        grpc_core::ServerAddress /*address*/,
+        const grpc_channel_args& /*args*/) override {
+      return nullptr;
+    }
+
+    void UpdateState(
+        grpc_connectivity_state /*state*/, const absl::Status& /*status*/,
+        std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker)
+        override {
+      grpc_core::MutexLock lock(&fixture_->mu_);
+      fixture_->picker_ = std::move(picker);
+    }
+
+    void RequestReresolution() override {}
+
+    absl::string_view GetAuthority() override { return "server.example.com"; }
+
+    void AddTraceEvent(TraceSeverity /*severity*/,
+                       absl::string_view /*message*/) override {}
+
+   private:
+    RlsPickerFixture* fixture_;
+  };
+
+  void CreatePolicy(int rls_server_port) {
+    grpc_channel_credentials* creds = grpc_insecure_credentials_create();
+    grpc_arg arg_array[] = {
+        grpc_channel_arg_string_create(
+            const_cast<char*>(GRPC_ARG_SERVER_URI),
+            const_cast<char*>("dns:///server.example.com")),
+        grpc_channel_credentials_to_arg(creds),
+    };
+    grpc_channel_args args = {GPR_ARRAY_SIZE(arg_array), arg_array};
+    LoadBalancingPolicy::Args lb_args;
+    lb_args.work_serializer = work_serializer_;
+    lb_args.channel_control_helper = absl::make_unique<Helper>(this);
+    lb_args.args = &args;
+    policy_ = grpc_core::LoadBalancingPolicyRegistry::CreateLoadBalancingPolicy(
+        "rls_experimental", std::move(lb_args));
+    GPR_ASSERT(policy_ != nullptr);
+    grpc_pollset_set_add_pollset(policy_->interested_parties(), pollset_);
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    grpc_core::Json json = grpc_core::Json::Parse(
+        absl::StrFormat(
+            "[{\"rls_experimental\":{"
+            "  \"routeLookupConfig\":{"
+            "    \"lookupService\":\"localhost:%d\","
+            "    \"cacheSizeBytes\":1000000000,"
+            "    \"grpcKeybuilders\":[{"
+            "      \"names\":[{\"service\":\"grpc.testing.EchoTestService\"}],"
+            "      \"headers\":[{\"key\":\"%s\",\"names\":[\"%s\"]}]"
+            "    }]"
+            "  },"
+            "  \"childPolicy\":[{\"%s\":{}}],"
+            "  \"childPolicyConfigTargetFieldName\":\"target\""
+            "}}]",
+            rls_server_port, kKeyHeader, kKeyHeader, kChildPolicyName),
+        &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    LoadBalancingPolicy::UpdateArgs update_args;
+    update_args.config =
+        grpc_core::LoadBalancingPolicyRegistry::ParseLoadBalancingConfig(
+            json, &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    update_args.addresses = grpc_core::ServerAddressList();
+    update_args.args = grpc_channel_args_copy(&args);
+    work_serializer_->Run(
+        [this, &update_args]() {
+          policy_->UpdateLocked(std::move(update_args));
+        },
+        DEBUG_LOCATION);
+    grpc_core::ExecCtx::Get()->Flush();
+    grpc_channel_credentials_release(creds);
+  }
+
+  // Picks each of keys_[start, end) until all picks complete, which they do
+  // once the RLS responses for them are in the cache.
+  void WarmCache(size_t start, size_t end) {
+    KeyMetadata metadata;
+    NoAllocCallState call_state;
+    while (true) {
+      size_t num_complete = 0;
+      std::shared_ptr<LoadBalancingPolicy::SubchannelPicker> current_picker =
+          picker();
+      if (current_picker != nullptr) {
+        for (size_t i = start; i < end; ++i) {
+          metadata.set_key(keys_[i]);
+          LoadBalancingPolicy::PickResult result =
+              current_picker->Pick({kPath, &metadata, &call_state});
+          if (absl::holds_alternative<
+                  LoadBalancingPolicy::PickResult::Complete>(result.result)) {
+            ++num_complete;
+          }
+        }
+      }
+      if (num_complete == end - start) return;
+      grpc_core::ExecCtx::Get()->Flush();
+      gpr_mu_lock(pollset_mu_);
+      GRPC_LOG_IF_ERROR(
+          "pollset_work",
+          grpc_pollset_work(pollset_, nullptr,
+                            grpc_core::ExecCtx::Get()->Now() +
+                                grpc_core::Duration::Milliseconds(10)));
+      gpr_mu_unlock(pollset_mu_);
+      grpc_core::ExecCtx::Get()->Flush();
+    }
+  }
+
+  RouteLookupService rls_service_;
+  std::unique_ptr<Server> server_;
+  std::vector<std::string> keys_;
+  gpr_mu* pollset_mu_;
+  grpc_pollset* pollset_;
+  std::shared_ptr<grpc_core::WorkSerializer> work_serializer_ =
+      std::make_shared<grpc_core::WorkSerializer>();
+  grpc_core::OrphanablePtr<LoadBalancingPolicy> policy_;
+  grpc_core::Mutex mu_;
+  std::shared_ptr<LoadBalancingPolicy::SubchannelPicker> picker_
+      ABSL_GUARDED_BY(mu_);
+};
+
+static RlsPickerFixture* g_fixture;
+
+/*******************************************************************************
+ * BENCHMARKING KERNELS
+ */
+
+// Argument is the number of distinct keys picked, in random order.
+static void BM_RlsPickCached(benchmark::State& state) {
+  const std::vector<std::string>& keys = g_fixture->keys();
+  const uint64_t num_keys = state.range(0);
+  grpc_core::ExecCtx exec_ctx;
+  std::shared_ptr<LoadBalancingPolicy::SubchannelPicker> picker =
+      g_fixture->picker();
+  KeyMetadata metadata;
+  NoAllocCallState call_state;
+  // A simple LCG, seeded differently in each thread.
+  uint64_t rand = state.thread_index() * 0x9e3779b97f4a7c15ull + 1;
+  int64_t not_complete = 0;
+  for (auto _ : state) {
+    rand = rand * 6364136223846793005ull + 1442695040888963407ull;
+    metadata.set_key(keys[(rand >> 33) % num_keys]);
+    LoadBalancingPolicy::PickResult result =
+        picker->Pick({kPath, &metadata, &call_state});
+    if (!absl::holds_alternative<LoadBalancingPolicy::PickResult::Complete>(
+            result.result)) {
+      ++not_complete;
+    }
+  }
+  state.counters["not_complete"] = static_cast<double>(not_complete);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RlsPickCached)
+    ->Arg(1000)
+    ->Arg(kMaxKeys)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  grpc_core::LoadBalancingPolicyRegistry::Builder::
+      RegisterLoadBalancingPolicyFactory(
+          absl::make_unique<grpc::testing::ChildPolicyFactory>());
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  grpc::testing::g_fixture = new grpc::testing::RlsPickerFixture();
+  benchmark::RunTheBenchmarksNamespaced();
+  delete grpc::testing::g_fixture;
+  return 0;
+}
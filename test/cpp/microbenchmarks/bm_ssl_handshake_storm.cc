@@ -0,0 +1,264 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark many concurrent TLS handshakes to the same server name, as seen
+   when all channels of a client reconnect at once, with and without a shared
+   session cache, and mutual TLS handshakes with and without a certificate
+   cache */
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/support/log.h>
+
+#include "src/core/tsi/ssl_transport_security.h"
+#include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_interface.h"
+#include "test/core/end2end/data/ssl_test_data.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+constexpr char kServerName[] = "foo.test.google.fr";
+
+class HandshakerFactories {
+ public:
+  HandshakerFactories(bool use_session_cache, tsi_tls_version tls_version,
+                      bool mutual_tls = false, size_t cert_cache_capacity = 0)
+      : mutual_tls_(mutual_tls) {
+    if (use_session_cache) {
+      session_cache_ = tsi_ssl_session_cache_create_lru(16);
+    }
+    tsi_ssl_pem_key_cert_pair client_key_cert_pair = {test_signed_client_key,
+                                                      test_signed_client_cert};
+    tsi_ssl_client_handshaker_options client_options;
+    client_options.pem_root_certs = test_root_cert;
+    client_options.session_cache = session_cache_;
+    client_options.min_tls_version = tls_version;
+    client_options.max_tls_version = tls_version;
+    client_options.cert_cache_capacity = cert_cache_capacity;
+    if (mutual_tls) client_options.pem_key_cert_pair = &client_key_cert_pair;
+    GPR_ASSERT(tsi_create_ssl_client_handshaker_factory_with_options(
+                   &client_options, &client_factory_) == TSI_OK);
+    tsi_ssl_pem_key_cert_pair key_cert_pair = {test_server1_key,
+                                               test_server1_cert};
+    tsi_ssl_server_handshaker_options server_options;
+    server_options.pem_key_cert_pairs = &key_cert_pair;
+    server_options.num_key_cert_pairs = 1;
+    server_options.min_tls_version = tls_version;
+    server_options.max_tls_version = tls_version;
+    server_options.cert_cache_capacity = cert_cache_capacity;
+    if (mutual_tls) {
+      server_options.pem_client_root_certs = test_root_cert;
+      server_options.client_certificate_request =
+          TSI_REQUEST_AND_REQUIRE_CLIENT_CERTIFICATE_AND_VERIFY;
+    }
+    GPR_ASSERT(tsi_create_ssl_server_handshaker_factory_with_options(
+                   &server_options, &server_factory_) == TSI_OK);
+  }
+
+  ~HandshakerFactories() {
+    tsi_ssl_client_handshaker_factory_unref(client_factory_);
+    tsi_ssl_server_handshaker_factory_unref(server_factory_);
+    if (session_cache_ != nullptr) {
+      tsi_ssl_session_cache_unref(session_cache_);
+    }
+  }
+
+  // Performs one in-memory handshake, including the delivery of session
+  // tickets to the client. Returns true if the session was resumed.
+  bool Handshake() {
+    tsi_handshaker* client = nullptr;
+    tsi_handshaker* server = nullptr;
+    GPR_ASSERT(tsi_ssl_client_handshaker_factory_create_handshaker(
+                   client_factory_, kServerName, 0, 0, &client) == TSI_OK);
+    GPR_ASSERT(tsi_ssl_server_handshaker_factory_create_handshaker(
+                   server_factory_, 0, 0, &server) == TSI_OK);
+    tsi_handshaker_result* client_result = nullptr;
+    tsi_handshaker_result* server_result = nullptr;
+    std::vector<unsigned char> to_server;
+    std::vector<unsigned char> to_client;
+    Next(client, &to_client, &to_server, &client_result);
+    while (client_result == nullptr || server_result == nullptr) {
+      if (server_result == nullptr) {
+        Next(server, &to_server, &to_client, &server_result);
+      }
+      if (client_result == nullptr) {
+        Next(client, &to_client, &to_server, &client_result);
+      }
+    }
+    // Feed the bytes the client has not consumed yet (e.g. TLS 1.3
+    // NewSessionTicket messages) through its frame protector, so that new
+    // sessions reach the cache.
+    const unsigned char* unused_bytes = nullptr;
+    size_t unused_bytes_size = 0;
+    GPR_ASSERT(tsi_handshaker_result_get_unused_bytes(
+                   client_result, &unused_bytes, &unused_bytes_size) ==
+               TSI_OK);
+    to_client.insert(to_client.begin(), unused_bytes,
+                     unused_bytes + unused_bytes_size);
+    tsi_frame_protector* protector = nullptr;
+    GPR_ASSERT(tsi_handshaker_result_create_frame_protector(
+                   client_result, nullptr, &protector) == TSI_OK);
+    size_t offset = 0;
+    while (offset < to_client.size()) {
+      unsigned char buffer[1024];
+      size_t consumed = to_client.size() - offset;
+      size_t buffer_size = sizeof(buffer);
+      GPR_ASSERT(tsi_frame_protector_unprotect(
+                     protector, to_client.data() + offset, &consumed, buffer,
+                     &buffer_size) == TSI_OK);
+      offset += consumed;
+    }
+    tsi_peer peer;
+    GPR_ASSERT(tsi_handshaker_result_extract_peer(client_result, &peer) ==
+               TSI_OK);
+    const tsi_peer_property* reused = tsi_peer_get_property_by_name(
+        &peer, TSI_SSL_SESSION_REUSED_PEER_PROPERTY);
+    bool resumed = reused != nullptr && reused->value.length == 4 &&
+                   memcmp(reused->value.data, "true", 4) == 0;
+    tsi_peer_destruct(&peer);
+    if (mutual_tls_) {
+      GPR_ASSERT(tsi_handshaker_result_extract_peer(server_result, &peer) ==
+                 TSI_OK);
+      tsi_peer_destruct(&peer);
+    }
+    tsi_frame_protector_destroy(protector);
+    tsi_handshaker_result_destroy(client_result);
+    tsi_handshaker_result_destroy(server_result);
+    tsi_handshaker_destroy(client);
+    tsi_handshaker_destroy(server);
+    return resumed;
+  }
+
+  tsi_ssl_session_cache* session_cache() { return session_cache_; }
+
+ private:
+  // Feeds \a input to \a handshaker and appends its output to \a output.
+  static void Next(tsi_handshaker* handshaker,
+                   std::vector<unsigned char>* input,
+                   std::vector<unsigned char>* output,
+                   tsi_handshaker_result** result) {
+    const unsigned char* bytes_to_send = nullptr;
+    size_t bytes_to_send_size = 0;
+    GPR_ASSERT(tsi_handshaker_next(handshaker, input->data(), input->size(),
+                                   &bytes_to_send, &bytes_to_send_size, result,
+                                   nullptr, nullptr) == TSI_OK);
+    input->clear();
+    output->insert(output->end(), bytes_to_send,
+                   bytes_to_send + bytes_to_send_size);
+  }
+
+  const bool mutual_tls_ = false;
+  tsi_ssl_session_cache* session_cache_ = nullptr;
+  tsi_ssl_client_handshaker_factory* client_factory_ = nullptr;
+  tsi_ssl_server_handshaker_factory* server_factory_ = nullptr;
+};
+
+static HandshakerFactories* GetFactories(bool use_session_cache,
+                                         tsi_tls_version tls_version) {
+  // Shared by all benchmark threads, like a session cache shared by all
+  // channels of a process.
+  static HandshakerFactories* factories[2][2] = {
+      {new HandshakerFactories(false, tsi_tls_version::TSI_TLS1_2),
+       new HandshakerFactories(false, tsi_tls_version::TSI_TLS1_3)},
+      {new HandshakerFactories(true, tsi_tls_version::TSI_TLS1_2),
+       new HandshakerFactories(true, tsi_tls_version::TSI_TLS1_3)}};
+  return factories[use_session_cache]
+                  [tls_version == tsi_tls_version::TSI_TLS1_3];
+}
+
+static void BM_SslHandshakeStorm(benchmark::State& state) {
+  HandshakerFactories* factories = GetFactories(
+      state.range(0) != 0, state.range(1) != 0 ? tsi_tls_version::TSI_TLS1_3
+                                               : tsi_tls_version::TSI_TLS1_2);
+  int64_t resumed = 0;
+  for (auto _ : state) {
+    if (factories->Handshake()) resumed++;
+  }
+  state.counters["resumed"] = benchmark::Counter(
+      static_cast<double>(resumed) /
+      static_cast<double>(std::max<int64_t>(state.iterations(), 1)));
+  if (state.thread_index() == 0 && factories->session_cache() != nullptr) {
+    tsi_ssl_session_cache_stats stats;
+    tsi_ssl_session_cache_get_stats(factories->session_cache(), &stats);
+    state.counters["cache_hits"] = static_cast<double>(stats.hits);
+    state.counters["cache_misses"] = static_cast<double>(stats.misses);
+    state.counters["cache_expired"] = static_cast<double>(stats.expired);
+  }
+}
+// Arguments are whether a session cache is used and whether TLS 1.3 (rather
+// than TLS 1.2) is negotiated.
+BENCHMARK(BM_SslHandshakeStorm)
+    ->ArgsProduct({{0, 1}, {0, 1}})
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+static HandshakerFactories* GetMutualTlsFactories(bool use_cert_cache,
+                                                  tsi_tls_version tls_version) {
+  static HandshakerFactories* factories[2][2] = {
+      {new HandshakerFactories(false, tsi_tls_version::TSI_TLS1_2, true),
+       new HandshakerFactories(false, tsi_tls_version::TSI_TLS1_3, true)},
+      {new HandshakerFactories(false, tsi_tls_version::TSI_TLS1_2, true, 1024),
+       new HandshakerFactories(false, tsi_tls_version::TSI_TLS1_3, true,
+                               1024)}};
+  return factories[use_cert_cache][tls_version == tsi_tls_version::TSI_TLS1_3];
+}
+
+// Full mutual TLS handshakes (no session resumption), in which both sides
+// verify and extract the properties of the same peer certificate chain every
+// time.
+static void BM_SslMutualTlsHandshake(benchmark::State& state) {
+  HandshakerFactories* factories = GetMutualTlsFactories(
+      state.range(0) != 0, state.range(1) != 0 ? tsi_tls_version::TSI_TLS1_3
+                                               : tsi_tls_version::TSI_TLS1_2);
+  for (auto _ : state) {
+    factories->Handshake();
+  }
+}
+// Arguments are whether a certificate cache is used and whether TLS 1.3
+// (rather than TLS 1.2) is negotiated.
+BENCHMARK(BM_SslMutualTlsHandshake)
+    ->ArgsProduct({{0, 1}, {0, 1}})
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Compare matching a value against many StringMatchers one at a time with
+   matching it against a StringMatcherSet. */
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/matchers/matchers.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Matchers of every type on the same header, as a policy that routes or
+// authorizes many services by path might have.
+std::vector<StringMatcher> MakeMatchers(size_t num_matchers) {
+  std::vector<StringMatcher> matchers;
+  for (size_t i = 0; i < num_matchers; ++i) {
+    const size_t service = i / 5;
+    switch (i % 5) {
+      case 0:
+        matchers.push_back(*StringMatcher::Create(
+            StringMatcher::Type::kExact,
+            absl::StrCat("/pkg.Service", service, "/Method")));
+        break;
+      case 1:
+        matchers.push_back(
+            *StringMatcher::Create(StringMatcher::Type::kPrefix,
+                                   absl::StrCat("/pkg.Service", service, "/"),
+                                   /*case_sensitive=*/false));
+        break;
+      case 2:
+        matchers.push_back(*StringMatcher::Create(
+            StringMatcher::Type::kSuffix, absl::StrCat("/Method", service)));
+        break;
+      case 3:
+        matchers.push_back(*StringMatcher::Create(
+            StringMatcher::Type::kContains, absl::StrCat("Tenant", service)));
+        break;
+      default:
+        matchers.push_back(*StringMatcher::Create(
+            StringMatcher::Type::kSafeRegex,
+            absl::StrCat("/pkg\\.Service", service, "/Get.*")));
+    }
+  }
+  return matchers;
+}
+
+std::vector<std::string> MakeValues(size_t num_matchers) {
+  std::vector<std::string> values;
+  for (size_t i = 0; i < 16; ++i) {
+    const size_t service = i * (num_matchers / 5 + 1) / 16;
+    values.push_back(absl::StrCat("/pkg.Service", service, "/Method"));
+    values.push_back(absl::StrCat("/pkg.Service", service, "/GetTenant", i));
+    values.push_back(absl::StrCat("/other.Service", service, "/Method", i));
+  }
+  return values;
+}
+
+std::vector<size_t> MatchOneByOne(const std::vector<StringMatcher>& matchers,
+                                  absl::string_view value) {
+  std::vector<size_t> result;
+  for (size_t i = 0; i < matchers.size(); ++i) {
+    if (matchers[i].Match(value)) result.push_back(i);
+  }
+  return result;
+}
+
+void BM_StringMatchers(benchmark::State& state, bool use_set) {
+  const size_t num_matchers = state.range(0);
+  std::vector<StringMatcher> matchers = MakeMatchers(num_matchers);
+  StringMatcherSet matcher_set(MakeMatchers(num_matchers));
+  std::vector<std::string> values = MakeValues(num_matchers);
+  // Both ways must find the same matchers.
+  for (const std::string& value : values) {
+    GPR_ASSERT(matcher_set.Match(value) == MatchOneByOne(matchers, value));
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    const std::string& value = values[i++ % values.size()];
+    if (use_set) {
+      benchmark::DoNotOptimize(matcher_set.Match(value));
+    } else {
+      benchmark::DoNotOptimize(MatchOneByOne(matchers, value));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_StringMatchersOneByOne(benchmark::State& state) {
+  BM_StringMatchers(state, /*use_set=*/false);
+}
+BENCHMARK(BM_StringMatchersOneByOne)->Arg(1)->Arg(10)->Arg(100)->Arg(500);
+
+void BM_StringMatcherSet(benchmark::State& state) {
+  BM_StringMatchers(state, /*use_set=*/true);
+}
+BENCHMARK(BM_StringMatcherSet)->Arg(1)->Arg(10)->Arg(100)->Arg(500);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
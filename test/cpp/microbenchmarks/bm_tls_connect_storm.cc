@@ -0,0 +1,124 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the time it takes for many channels that connect at once to the
+   same TLS server to become ready, with and without the handshake offload
+   pool on the server.
+   Each connection takes two file descriptors in this process, so the largest
+   configuration needs the file descriptor limit to be raised above 20000. */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpcpp/channel.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/core/lib/gprpp/host_port.h"
+#include "test/core/end2end/data/ssl_test_data.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+static std::unique_ptr<Server> BuildServer(int port, bool handshake_offload) {
+  SslServerCredentialsOptions options;
+  options.pem_key_cert_pairs.push_back({test_server1_key, test_server1_cert});
+  ServerBuilder builder;
+  builder.AddListeningPort(grpc_core::JoinHostPort("localhost", port),
+                           SslServerCredentials(options));
+  builder.AddChannelArgument(GRPC_ARG_TSI_HANDSHAKE_OFFLOAD, handshake_offload);
+  return builder.BuildAndStart();
+}
+
+static std::shared_ptr<Channel> CreateStormChannel(
+    const std::string& target) {
+  SslCredentialsOptions options;
+  options.pem_root_certs = test_root_cert;
+  ChannelArguments args;
+  args.SetSslTargetNameOverride("foo.test.google.fr");
+  // Give every channel its own connection.
+  args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+  return CreateCustomChannel(target, SslCredentials(options), args);
+}
+
+static void BM_TlsConnectStorm(benchmark::State& state) {
+  const bool handshake_offload = state.range(0) != 0;
+  const int num_channels = static_cast<int>(state.range(1));
+  int port = grpc_pick_unused_port_or_die();
+  std::unique_ptr<Server> server = BuildServer(port, handshake_offload);
+  const std::string target = grpc_core::JoinHostPort("localhost", port);
+  TrackCounters track_counters;
+  int64_t not_connected = 0;
+  for (auto _ : state) {
+    std::vector<std::shared_ptr<Channel>> channels;
+    channels.reserve(num_channels);
+    for (int i = 0; i < num_channels; i++) {
+      channels.push_back(CreateStormChannel(target));
+      channels.back()->GetState(/*try_to_connect=*/true);
+    }
+    // Connections are established concurrently, so waiting for them one by
+    // one measures the time until the last of them is ready.
+    gpr_timespec deadline = grpc_timeout_seconds_to_deadline(120);
+    for (const auto& channel : channels) {
+      if (!channel->WaitForConnected(deadline)) not_connected++;
+    }
+    state.PauseTiming();
+    channels.clear();
+    state.ResumeTiming();
+  }
+  state.counters["not_connected"] = static_cast<double>(not_connected);
+  track_counters.Finish(state);
+  server->Shutdown();
+  grpc_recycle_unused_port(port);
+}
+// Arguments are whether the server offloads handshakes and the number of
+// channels that connect at once.
+BENCHMARK(BM_TlsConnectStorm)
+    ->ArgsProduct({{0, 1}, {100, 1000, 10000}})
+    ->Iterations(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
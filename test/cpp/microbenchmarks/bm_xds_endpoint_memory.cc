@@ -0,0 +1,246 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the memory that a large decoded EDS resource holds, compared
+   with holding its endpoints as a ServerAddressList. */
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "upb/def.hpp"
+#include "upb/upb.hpp"
+
+#include <grpc/support/log.h>
+
+#include "src/core/ext/xds/upb_utils.h"
+#include "src/core/ext/xds/xds_bootstrap.h"
+#include "src/core/ext/xds/xds_endpoint.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/proto/grpc/testing/xds/v3/endpoint.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+std::atomic<int64_t> g_live_bytes{0};
+}  // namespace
+
+// Track the bytes live on the heap, so that the benchmark can report what
+// each endpoint costs to hold.  Only glibc lets us wrap its allocator this
+// way, and sanitizers replace the allocator themselves.
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && \
+    !defined(__SANITIZE_THREAD__)
+#include <malloc.h>
+#define GRPC_BM_COUNT_ALLOCATIONS 1
+extern "C" {
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t nmemb, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void __libc_free(void* ptr);
+
+void* malloc(size_t size) {
+  void* ptr = __libc_malloc(size);
+  if (ptr != nullptr) {
+    g_live_bytes.fetch_add(malloc_usable_size(ptr), std::memory_order_relaxed);
+  }
+  return ptr;
+}
+
+void* calloc(size_t nmemb, size_t size) {
+  void* ptr = __libc_calloc(nmemb, size);
+  if (ptr != nullptr) {
+    g_live_bytes.fetch_add(malloc_usable_size(ptr), std::memory_order_relaxed);
+  }
+  return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+  const size_t old_size = ptr == nullptr ? 0 : malloc_usable_size(ptr);
+  void* new_ptr = __libc_realloc(ptr, size);
+  if (new_ptr != nullptr) {
+    g_live_bytes.fetch_add(
+        static_cast<int64_t>(malloc_usable_size(new_ptr)) - old_size,
+        std::memory_order_relaxed);
+  } else if (size == 0) {
+    g_live_bytes.fetch_sub(old_size, std::memory_order_relaxed);
+  }
+  return new_ptr;
+}
+
+void free(void* ptr) {
+  if (ptr != nullptr) {
+    g_live_bytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+  }
+  __libc_free(ptr);
+}
+}
+#endif
+
+namespace grpc_core {
+namespace {
+
+using ::envoy::config::endpoint::v3::ClusterLoadAssignment;
+
+TraceFlag g_tracer(false, "bm_xds_endpoint_memory");
+
+constexpr size_t kEndpointsPerLocality = 100;
+
+std::string MakeClusterLoadAssignment(size_t num_endpoints) {
+  ClusterLoadAssignment assignment;
+  assignment.set_cluster_name("eds_service");
+  for (size_t i = 0; i < num_endpoints; i += kEndpointsPerLocality) {
+    auto* endpoints = assignment.add_endpoints();
+    endpoints->mutable_load_balancing_weight()->set_value(1);
+    endpoints->mutable_locality()->set_region("region");
+    endpoints->mutable_locality()->set_zone("zone");
+    endpoints->mutable_locality()->set_sub_zone(
+        absl::StrCat("sub_zone_", i / kEndpointsPerLocality));
+    for (size_t j = i; j < i + kEndpointsPerLocality && j < num_endpoints;
+         ++j) {
+      auto* socket_address = endpoints->add_lb_endpoints()
+                                 ->mutable_endpoint()
+                                 ->mutable_address()
+                                 ->mutable_socket_address();
+      socket_address->set_address(
+          absl::StrCat("10.", j / 65536, ".", j / 256 % 256, ".", j % 256));
+      socket_address->set_port_value(443);
+    }
+  }
+  return assignment.SerializeAsString();
+}
+
+std::unique_ptr<XdsResourceType::ResourceData> Decode(
+    const std::string& serialized) {
+  upb::SymbolTable symtab;
+  XdsEndpointResourceType::Get()->InitUpbSymtab(symtab.ptr());
+  upb::Arena arena;
+  XdsBootstrap::XdsServer server;
+  server.server_features.insert("xds_v3");
+  const XdsEncodingContext context = {
+      /*client=*/nullptr, server,       &g_tracer,
+      symtab.ptr(),       arena.ptr(), /*use_v3=*/true,
+      /*certificate_provider_definition_map=*/nullptr};
+  auto result =
+      XdsEndpointResourceType::Get()->Decode(context, serialized, false);
+  GPR_ASSERT(result.ok() && result->resource.ok());
+  return std::move(*result->resource);
+}
+
+void SetBytesPerEndpoint(benchmark::State& state, int64_t bytes,
+                         size_t num_endpoints) {
+#ifdef GRPC_BM_COUNT_ALLOCATIONS
+  state.counters["bytes_per_endpoint"] =
+      benchmark::Counter(static_cast<double>(bytes) / num_endpoints);
+#else
+  (void)state;
+  (void)bytes;
+  (void)num_endpoints;
+#endif
+}
+
+// Decodes the resource and reports the memory that the result holds.
+void BM_EdsResourceDecode(benchmark::State& state) {
+  const size_t num_endpoints = state.range(0);
+  const std::string serialized = MakeClusterLoadAssignment(num_endpoints);
+  int64_t bytes = 0;
+  for (auto _ : state) {
+    const int64_t live_bytes_before =
+        g_live_bytes.load(std::memory_order_relaxed);
+    auto resource = Decode(serialized);
+    bytes = g_live_bytes.load(std::memory_order_relaxed) - live_bytes_before;
+  }
+  SetBytesPerEndpoint(state, bytes, num_endpoints);
+  state.SetItemsProcessed(num_endpoints * state.iterations());
+}
+BENCHMARK(BM_EdsResourceDecode)->Arg(50000);
+
+// Copies the decoded resource, as XdsClient does for each watcher, and
+// reports the memory that the copy holds.
+void BM_EdsResourceCopy(benchmark::State& state) {
+  const size_t num_endpoints = state.range(0);
+  auto resource = Decode(MakeClusterLoadAssignment(num_endpoints));
+  int64_t bytes = 0;
+  for (auto _ : state) {
+    const int64_t live_bytes_before =
+        g_live_bytes.load(std::memory_order_relaxed);
+    auto copy = XdsEndpointResourceType::Get()->CopyResource(resource.get());
+    bytes = g_live_bytes.load(std::memory_order_relaxed) - live_bytes_before;
+  }
+  SetBytesPerEndpoint(state, bytes, num_endpoints);
+  state.SetItemsProcessed(num_endpoints * state.iterations());
+}
+BENCHMARK(BM_EdsResourceCopy)->Arg(50000);
+
+// For comparison, holds the same endpoints as a ServerAddressList with a
+// weight attribute on each address, as the resource used to.
+void BM_ServerAddressList(benchmark::State& state) {
+  const size_t num_endpoints = state.range(0);
+  int64_t bytes = 0;
+  for (auto _ : state) {
+    const int64_t live_bytes_before =
+        g_live_bytes.load(std::memory_order_relaxed);
+    ServerAddressList addresses;
+    for (size_t j = 0; j < num_endpoints; ++j) {
+      grpc_resolved_address address;
+      GPR_ASSERT(grpc_string_to_sockaddr(
+                     &address,
+                     absl::StrCat("10.", j / 65536, ".", j / 256 % 256, ".",
+                                  j % 256)
+                         .c_str(),
+                     443) == GRPC_ERROR_NONE);
+      std::map<const char*, std::unique_ptr<ServerAddress::AttributeInterface>>
+          attributes;
+      attributes[ServerAddressWeightAttribute::
+                     kServerAddressWeightAttributeKey] =
+          absl::make_unique<ServerAddressWeightAttribute>(500);
+      addresses.emplace_back(address, nullptr, std::move(attributes));
+    }
+    bytes = g_live_bytes.load(std::memory_order_relaxed) - live_bytes_before;
+  }
+  SetBytesPerEndpoint(state, bytes, num_endpoints);
+  state.SetItemsProcessed(num_endpoints * state.iterations());
+}
+BENCHMARK(BM_ServerAddressList)->Arg(50000);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,297 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark parsing large CDS and EDS responses, with and without the
+   checks that let XdsClient skip decoding resources it already has or that
+   no one watches. */
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <set>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
+#include "absl/strings/str_cat.h"
+#include "upb/def.hpp"
+
+#include <grpc/slice.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/xds/xds_api.h"
+#include "src/core/ext/xds/xds_bootstrap.h"
+#include "src/core/ext/xds/xds_cluster.h"
+#include "src/core/ext/xds/xds_endpoint.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/proto/grpc/testing/xds/v3/cluster.pb.h"
+#include "src/proto/grpc/testing/xds/v3/discovery.pb.h"
+#include "src/proto/grpc/testing/xds/v3/endpoint.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+std::atomic<size_t> g_allocations{0};
+std::atomic<size_t> g_bytes_allocated{0};
+}  // namespace
+
+// Count heap allocations, so that the benchmark can report what parsing
+// each resource costs in allocations as well as in CPU.  Only glibc lets
+// us wrap its allocator this way, and sanitizers replace the allocator
+// themselves.
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && \
+    !defined(__SANITIZE_THREAD__)
+#define GRPC_BM_COUNT_ALLOCATIONS 1
+extern "C" {
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t nmemb, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t nmemb, size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_bytes_allocated.fetch_add(nmemb * size, std::memory_order_relaxed);
+  return __libc_calloc(nmemb, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+  return __libc_realloc(ptr, size);
+}
+}
+#endif
+
+namespace grpc_core {
+namespace {
+
+using ::envoy::config::cluster::v3::Cluster;
+using ::envoy::config::endpoint::v3::ClusterLoadAssignment;
+using ::envoy::service::discovery::v3::DiscoveryResponse;
+
+TraceFlag g_tracer(false, "bm_xds_resource_parsing");
+
+enum class Mode {
+  // Every resource is decoded, as for the first response.
+  kDecodeAll,
+  // Every resource is the same as the one already cached.
+  kUnchanged,
+  // Resources are wrapped in named Resource messages, and none is watched.
+  kUnwatched,
+};
+
+// Makes the same checks as XdsClient's parser before decoding a resource.
+class Parser : public XdsApi::AdsResponseParserInterface {
+ public:
+  Parser(const XdsResourceType* type, Mode mode,
+         absl::flat_hash_map<size_t, std::string>* cache)
+      : type_(type), mode_(mode), cache_(cache) {}
+
+  absl::Status ProcessAdsResponseFields(AdsResponseFields fields) override {
+    GPR_ASSERT(fields.type_url == type_->type_url());
+    return absl::OkStatus();
+  }
+
+  void ParseResource(const XdsEncodingContext& context, size_t /*idx*/,
+                     absl::string_view /*type_url*/,
+                     absl::string_view resource_name,
+                     absl::string_view serialized_resource,
+                     absl::string_view /*resource_version*/) override {
+    if (mode_ == Mode::kUnwatched) {
+      GPR_ASSERT(!resource_name.empty());
+      return;
+    }
+    const size_t hash = absl::Hash<absl::string_view>()(serialized_resource);
+    if (mode_ == Mode::kUnchanged) {
+      auto it = cache_->find(hash);
+      if (it != cache_->end() && it->second == serialized_resource) return;
+    }
+    auto result = type_->Decode(context, serialized_resource, /*is_v2=*/false);
+    GPR_ASSERT(result.ok() && result->resource.ok());
+    (*cache_)[hash] = std::string(serialized_resource);
+  }
+
+  void RemoveResource(size_t /*idx*/,
+                      absl::string_view /*resource_name*/) override {}
+
+ private:
+  const XdsResourceType* type_;
+  const Mode mode_;
+  absl::flat_hash_map<size_t, std::string>* cache_;
+};
+
+void AddResource(const google::protobuf::Message& resource,
+                 const std::string& name, bool wrap,
+                 DiscoveryResponse* response) {
+  if (wrap) {
+    ::envoy::service::discovery::v3::Resource resource_wrapper;
+    resource_wrapper.set_name(name);
+    resource_wrapper.mutable_resource()->PackFrom(resource);
+    response->add_resources()->PackFrom(resource_wrapper);
+  } else {
+    response->add_resources()->PackFrom(resource);
+  }
+}
+
+std::string MakeCdsResponse(size_t num_resources, bool wrap) {
+  DiscoveryResponse response;
+  response.set_type_url(
+      "type.googleapis.com/envoy.config.cluster.v3.Cluster");
+  response.set_version_info("1");
+  response.set_nonce("A");
+  for (size_t i = 0; i < num_resources; ++i) {
+    Cluster cluster;
+    cluster.set_name(absl::StrCat("cluster_", i));
+    cluster.set_type(Cluster::EDS);
+    auto* eds_config = cluster.mutable_eds_cluster_config();
+    eds_config->mutable_eds_config()->mutable_self();
+    eds_config->set_service_name(absl::StrCat("eds_service_", i));
+    cluster.set_lb_policy(Cluster::ROUND_ROBIN);
+    AddResource(cluster, cluster.name(), wrap, &response);
+  }
+  return response.SerializeAsString();
+}
+
+std::string MakeEdsResponse(size_t num_resources, bool wrap) {
+  DiscoveryResponse response;
+  response.set_type_url(
+      "type.googleapis.com/envoy.config.endpoint.v3.ClusterLoadAssignment");
+  response.set_version_info("1");
+  response.set_nonce("A");
+  for (size_t i = 0; i < num_resources; ++i) {
+    ClusterLoadAssignment assignment;
+    assignment.set_cluster_name(absl::StrCat("eds_service_", i));
+    auto* endpoints = assignment.add_endpoints();
+    endpoints->mutable_load_balancing_weight()->set_value(1);
+    endpoints->mutable_locality()->set_region("region");
+    endpoints->mutable_locality()->set_zone("zone");
+    endpoints->mutable_locality()->set_sub_zone("sub_zone");
+    for (size_t j = 0; j < 4; ++j) {
+      auto* socket_address = endpoints->add_lb_endpoints()
+                                 ->mutable_endpoint()
+                                 ->mutable_address()
+                                 ->mutable_socket_address();
+      socket_address->set_address(
+          absl::StrCat("10.", i / 256 % 256, ".", i % 256, ".", j));
+      socket_address->set_port_value(443);
+    }
+    AddResource(assignment, assignment.cluster_name(), wrap, &response);
+  }
+  return response.SerializeAsString();
+}
+
+void BM_ParseAdsResponse(benchmark::State& state,
+                         const XdsResourceType* type, Mode mode) {
+  const size_t num_resources = state.range(0);
+  const bool wrap = mode == Mode::kUnwatched;
+  const bool is_cds = type == XdsClusterResourceType::Get();
+  const std::string serialized = is_cds
+                                     ? MakeCdsResponse(num_resources, wrap)
+                                     : MakeEdsResponse(num_resources, wrap);
+  grpc_slice encoded_response =
+      grpc_slice_from_copied_buffer(serialized.data(), serialized.size());
+  upb::SymbolTable symtab;
+  type->InitUpbSymtab(symtab.ptr());
+  XdsApi api(/*client=*/nullptr, &g_tracer, /*node=*/nullptr,
+             /*map=*/nullptr, &symtab);
+  XdsBootstrap::XdsServer server;
+  server.server_uri = "xds.example.com";
+  server.server_features.insert("xds_v3");
+  absl::flat_hash_map<size_t, std::string> cache;
+  // Warm the cache, as if the resources had been received before.
+  if (mode == Mode::kUnchanged) {
+    Parser parser(type, Mode::kDecodeAll, &cache);
+    GPR_ASSERT(api.ParseAdsResponse(server, encoded_response, &parser).ok());
+  }
+  const size_t allocations_before =
+      g_allocations.load(std::memory_order_relaxed);
+  const size_t bytes_allocated_before =
+      g_bytes_allocated.load(std::memory_order_relaxed);
+  for (auto _ : state) {
+    Parser parser(type, mode, &cache);
+    GPR_ASSERT(api.ParseAdsResponse(server, encoded_response, &parser).ok());
+    // Keep the cache from growing, so that each iteration does the same
+    // work.
+    if (mode == Mode::kDecodeAll) cache.clear();
+  }
+  const size_t allocations =
+      g_allocations.load(std::memory_order_relaxed) - allocations_before;
+  const size_t bytes_allocated =
+      g_bytes_allocated.load(std::memory_order_relaxed) -
+      bytes_allocated_before;
+  const double resources =
+      static_cast<double>(num_resources) * state.iterations();
+#ifdef GRPC_BM_COUNT_ALLOCATIONS
+  state.counters["allocations_per_resource"] =
+      benchmark::Counter(allocations / resources);
+  state.counters["bytes_allocated_per_resource"] =
+      benchmark::Counter(bytes_allocated / resources);
+#else
+  (void)allocations;
+  (void)bytes_allocated;
+  (void)resources;
+#endif
+  state.SetItemsProcessed(num_resources * state.iterations());
+  state.SetBytesProcessed(serialized.size() * state.iterations());
+  grpc_slice_unref(encoded_response);
+}
+
+BENCHMARK_CAPTURE(BM_ParseAdsResponse, CdsDecodeAll,
+                  XdsClusterResourceType::Get(), Mode::kDecodeAll)
+    ->Arg(10000);
+BENCHMARK_CAPTURE(BM_ParseAdsResponse, CdsUnchanged,
+                  XdsClusterResourceType::Get(), Mode::kUnchanged)
+    ->Arg(10000);
+BENCHMARK_CAPTURE(BM_ParseAdsResponse, CdsUnwatched,
+                  XdsClusterResourceType::Get(), Mode::kUnwatched)
+    ->Arg(10000);
+BENCHMARK_CAPTURE(BM_ParseAdsResponse, EdsDecodeAll,
+                  XdsEndpointResourceType::Get(), Mode::kDecodeAll)
+    ->Arg(10000);
+BENCHMARK_CAPTURE(BM_ParseAdsResponse, EdsUnchanged,
+                  XdsEndpointResourceType::Get(), Mode::kUnchanged)
+    ->Arg(10000);
+BENCHMARK_CAPTURE(BM_ParseAdsResponse, EdsUnwatched,
+                  XdsEndpointResourceType::Get(), Mode::kUnwatched)
+    ->Arg(10000);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Compare selecting an xDS route by scanning the route list with selecting
+   it through a compiled XdsRouting::RouteMatcher. */
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/ext/xds/xds_route_config.h"
+#include "src/core/ext/xds/xds_routing.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+auto* g_memory_allocator = new MemoryAllocator(
+    ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator("test"));
+
+class RouteListIterator : public XdsRouting::RouteListIterator {
+ public:
+  explicit RouteListIterator(
+      const std::vector<XdsRouteConfigResource::Route::Matchers>* routes)
+      : routes_(routes) {}
+
+  size_t Size() const override { return routes_->size(); }
+
+  const XdsRouteConfigResource::Route::Matchers& GetMatchersForRoute(
+      size_t index) const override {
+    return (*routes_)[index];
+  }
+
+ private:
+  const std::vector<XdsRouteConfigResource::Route::Matchers>* routes_;
+};
+
+// A route list like one generated for a mesh of many services: most routes
+// match a method or a service by path, some also match a header, a few use
+// a regex, and the last one is a catch-all.
+std::vector<XdsRouteConfigResource::Route::Matchers> MakeRoutes(
+    size_t num_routes) {
+  std::vector<XdsRouteConfigResource::Route::Matchers> routes;
+  for (size_t i = 0; i + 1 < num_routes; ++i) {
+    XdsRouteConfigResource::Route::Matchers matchers;
+    std::string service = absl::StrCat("/pkg.Service", i / 4, "/");
+    switch (i % 4) {
+      case 0:
+        matchers.path_matcher =
+            *StringMatcher::Create(StringMatcher::Type::kExact,
+                                   absl::StrCat(service, "Method", i));
+        break;
+      case 1:
+        matchers.path_matcher =
+            *StringMatcher::Create(StringMatcher::Type::kPrefix, service);
+        matchers.header_matchers.push_back(*HeaderMatcher::Create(
+            absl::StrCat("x-route-", i % 8), HeaderMatcher::Type::kExact,
+            "canary"));
+        break;
+      case 2:
+        matchers.path_matcher = *StringMatcher::Create(
+            StringMatcher::Type::kSafeRegex, absl::StrCat(service, "Get.*"));
+        break;
+      default:
+        matchers.path_matcher =
+            *StringMatcher::Create(StringMatcher::Type::kPrefix, service,
+                                   /*case_sensitive=*/false);
+    }
+    routes.push_back(std::move(matchers));
+  }
+  XdsRouteConfigResource::Route::Matchers default_route;
+  default_route.path_matcher =
+      *StringMatcher::Create(StringMatcher::Type::kPrefix, "");
+  routes.push_back(std::move(default_route));
+  return routes;
+}
+
+// Paths of calls spread over the whole route list, including some that
+// fall through to the catch-all route.
+std::vector<std::string> MakePaths(size_t num_routes) {
+  std::vector<std::string> paths;
+  for (size_t i = 0; i < num_routes; ++i) {
+    paths.push_back(absl::StrCat("/pkg.Service", i / 4, "/Method", i));
+  }
+  for (size_t i = 0; i < num_routes / 4; ++i) {
+    paths.push_back(absl::StrCat("/pkg.Service", i, "/GetThing"));
+    paths.push_back(absl::StrCat("/other.Service", i, "/Method"));
+  }
+  return paths;
+}
+
+void BM_XdsRouteMatching(benchmark::State& state, bool compiled) {
+  const size_t num_routes = state.range(0);
+  auto routes = MakeRoutes(num_routes);
+  auto paths = MakePaths(num_routes);
+  RouteListIterator iterator(&routes);
+  XdsRouting::RouteMatcher route_matcher(iterator);
+  ExecCtx exec_ctx;
+  auto arena = MakeScopedArena(1024, g_memory_allocator);
+  grpc_metadata_batch initial_metadata(arena.get());
+  initial_metadata.Append(
+      "x-route-1", Slice::FromStaticString("canary"),
+      [](absl::string_view, const Slice&) { GPR_ASSERT(false); });
+  // Both ways must select the same route.  No route has a fraction, so
+  // this does not depend on random draws.
+  for (const std::string& path : paths) {
+    GPR_ASSERT(route_matcher.GetRouteForRequest(path, &initial_metadata) ==
+               XdsRouting::GetRouteForRequest(iterator, path,
+                                              &initial_metadata));
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    const std::string& path = paths[i++ % paths.size()];
+    if (compiled) {
+      benchmark::DoNotOptimize(
+          route_matcher.GetRouteForRequest(path, &initial_metadata));
+    } else {
+      benchmark::DoNotOptimize(
+          XdsRouting::GetRouteForRequest(iterator, path, &initial_metadata));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_XdsRouteMatchingLinear(benchmark::State& state) {
+  BM_XdsRouteMatching(state, /*compiled=*/false);
+}
+BENCHMARK(BM_XdsRouteMatchingLinear)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_XdsRouteMatchingCompiled(benchmark::State& state) {
+  BM_XdsRouteMatching(state, /*compiled=*/true);
+}
+BENCHMARK(BM_XdsRouteMatchingCompiled)->Arg(10)->Arg(100)->Arg(1000);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -66,10 +66,17 @@ class BaseFixture : public TrackCounters {};
 class FullstackFixture : public BaseFixture {
  public:
   FullstackFixture(Service* service, const FixtureConfiguration& config,
-                   const std::string& address) {
+                   const std::string& address)
+      : FullstackFixture(service, config, address, InsecureServerCredentials(),
+                         InsecureChannelCredentials()) {}
+
+  FullstackFixture(Service* service, const FixtureConfiguration& config,
+                   const std::string& address,
+                   std::shared_ptr<ServerCredentials> server_creds,
+                   std::shared_ptr<ChannelCredentials> channel_creds) {
     ServerBuilder b;
     if (address.length() > 0) {
-      b.AddListeningPort(address, InsecureServerCredentials());
+      b.AddListeningPort(address, std::move(server_creds));
     }
     cq_ = b.AddCompletionQueue(true);
     b.RegisterService(service);
@@ -78,8 +85,8 @@ class FullstackFixture : public BaseFixture {
     ChannelArguments args;
     config.ApplyCommonChannelArguments(&args);
     if (address.length() > 0) {
-      channel_ = grpc::CreateCustomChannel(address,
-                                           InsecureChannelCredentials(), args);
+      channel_ =
+          grpc::CreateCustomChannel(address, std::move(channel_creds), args);
     } else {
       channel_ = server_->InProcessChannel(args);
     }
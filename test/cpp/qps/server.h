@@ -76,6 +76,8 @@ class Server {
     stats.set_idle_cpu_time(timer_result.idle_cpu_time);
     stats.set_cq_poll_count(poll_count);
     CoreStatsToProto(core_stats, stats.mutable_core_stats());
+    MethodLatencyToProto(grpc_core::CollectMethodLatency(),
+                         stats.mutable_core_stats());
     return stats;
   }
 
@@ -315,6 +315,15 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_cq_ev_queue_transient_pop_failures"] = massage_qps_stats_helpers.counter(
                     core_stats, "cq_ev_queue_transient_pop_failures")
+            stats[
+                "core_handshake_offload_scheduled"] = massage_qps_stats_helpers.counter(
+                    core_stats, "handshake_offload_scheduled")
+            stats[
+                "core_handshake_offload_resumed_scheduled"] = massage_qps_stats_helpers.counter(
+                    core_stats, "handshake_offload_resumed_scheduled")
+            stats[
+                "core_handshake_offload_rejected"] = massage_qps_stats_helpers.counter(
+                    core_stats, "handshake_offload_rejected")
             h = massage_qps_stats_helpers.histogram(core_stats,
                                                     "call_initial_size")
             stats["core_call_initial_size"] = ",".join(
@@ -492,6 +501,36 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_send_flowctl_per_write_99p"] = massage_qps_stats_helpers.percentile(
                     h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "http2_write_flush_delay_us")
+            stats["core_http2_write_flush_delay_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_http2_write_flush_delay_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_http2_write_flush_delay_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_http2_write_flush_delay_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_http2_write_flush_delay_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "combiner_wait_us")
+            stats["core_combiner_wait_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_combiner_wait_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_combiner_wait_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_combiner_wait_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_combiner_wait_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
             h = massage_qps_stats_helpers.histogram(core_stats,
                                                     "server_cqs_checked")
             stats["core_server_cqs_checked"] = ",".join(
@@ -507,3 +546,48 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_server_cqs_checked_99p"] = massage_qps_stats_helpers.percentile(
                     h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "server_queue_wait_us")
+            stats["core_server_queue_wait_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_server_queue_wait_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_server_queue_wait_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_server_queue_wait_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_server_queue_wait_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "server_call_latency_us")
+            stats["core_server_call_latency_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_server_call_latency_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_server_call_latency_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_server_call_latency_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_server_call_latency_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "handshake_offload_queue_delay_us")
+            stats["core_handshake_offload_queue_delay_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_handshake_offload_queue_delay_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_handshake_offload_queue_delay_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_handshake_offload_queue_delay_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_handshake_offload_queue_delay_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)